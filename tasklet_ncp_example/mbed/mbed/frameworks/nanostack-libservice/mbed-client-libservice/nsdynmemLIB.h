@@ -40,6 +40,26 @@ typedef size_t ns_mem_heap_size_t; //total heap size type.
 // Can be used to enable tracking of dynamic memory allocations
 #include "nsdynmem_tracker.h"
 
+/* Maximum number of fixed size slab classes per heap, 0 removes the slab layer */
+#ifndef NS_MEM_SLAB_CLASS_COUNT
+#define NS_MEM_SLAB_CLASS_COUNT 6
+#endif
+
+/* Number of hole size histogram buckets in mem_hole_stat_t */
+#ifndef NS_MEM_HOLE_HISTOGRAM_SIZE
+#define NS_MEM_HOLE_HISTOGRAM_SIZE 8
+#endif
+
+/* Free holes counted per critical section by ns_mem_hole_stat_get() */
+#ifndef NS_MEM_HOLE_STAT_WALK_STEP
+#define NS_MEM_HOLE_STAT_WALK_STEP 16
+#endif
+
+/* Walks ns_mem_hole_stat_get() restarts when the heap changes under it before giving up */
+#ifndef NS_MEM_HOLE_STAT_WALK_RETRIES
+#define NS_MEM_HOLE_STAT_WALK_RETRIES 3
+#endif
+
 /*!
  * \enum heap_fail_t
  * \brief Dynamically heap system failure call back event types.
@@ -53,6 +73,19 @@ typedef enum {
     NS_DYN_MEM_HEAP_SECTOR_UNITIALIZED /**< ns_dyn_mem_free(), ns_dyn_mem_temporary_alloc() or ns_dyn_mem_alloc() called before ns_dyn_mem_init() */
 } heap_fail_t;
 
+/**
+ * /struct mem_slab_stat_t
+ * /brief Struct for slab size class stats
+ */
+typedef struct mem_slab_stat_t {
+    ns_mem_block_size_t block_size;             /**< Slab block size in bytes, 0 when class is not in use. */
+    uint16_t block_count;                       /**< Number of blocks in slab. */
+    uint16_t blocks_in_use;                     /**< Reserved slab blocks. */
+    uint16_t blocks_in_use_max;                 /**< Reserved slab blocks max value. */
+    uint32_t alloc_cnt;                         /**< Allocations served from slab. */
+    uint32_t overflow_cnt;                      /**< Allocations passed to heap because slab was empty. */
+} mem_slab_stat_t;
+
 /**
  * /struct mem_stat_t
  * /brief Struct for Memory stats Buffer structure
@@ -60,13 +93,32 @@ typedef enum {
 typedef struct mem_stat_t {
     /*Heap stats*/
     ns_mem_heap_size_t heap_sector_size;                   /**< Heap total Sector len. */
-    ns_mem_heap_size_t heap_sector_alloc_cnt;              /**< Reserved Heap sector cnt. */
-    ns_mem_heap_size_t heap_sector_allocated_bytes;        /**< Reserved Heap data in bytes. */
+    ns_mem_heap_size_t heap_sector_alloc_cnt;              /**< Reserved Heap sector cnt, slab blocks included. */
+    ns_mem_heap_size_t heap_sector_allocated_bytes;        /**< Reserved Heap data in bytes, slab pools counted whole. */
     ns_mem_heap_size_t heap_sector_allocated_bytes_max;    /**< Reserved Heap data in bytes max value. */
-    uint32_t heap_alloc_total_bytes;            /**< Total Heap allocated bytes. */
+    uint32_t heap_alloc_total_bytes;            /**< Total Heap allocated bytes, slab blocks included. */
     uint32_t heap_alloc_fail_cnt;               /**< Counter for Heap allocation fail. */
+    uint32_t heap_alloc_fail_frag_cnt;          /**< Counter for Heap allocation fail while total free heap was large enough. */
+    uint32_t heap_alloc_walk_max;               /**< Longest free hole list walk done by one allocation. */
+#if NS_MEM_SLAB_CLASS_COUNT > 0
+    mem_slab_stat_t slab_stat[NS_MEM_SLAB_CLASS_COUNT]; /**< Slab class stats in ascending block size order. */
+#endif
 } mem_stat_t;
 
+/**
+ * /struct mem_hole_stat_t
+ * /brief Struct for free heap hole stats
+ *
+ * Histogram bucket n counts holes smaller than 32 << n bytes that did not fit a lower bucket,
+ * the last bucket counts all larger holes.
+ */
+typedef struct mem_hole_stat_t {
+    ns_mem_heap_size_t hole_cnt;                /**< Number of free holes. */
+    ns_mem_heap_size_t free_bytes;              /**< Free heap in holes in bytes. */
+    ns_mem_heap_size_t largest_free_block;      /**< Largest allocation that can currently succeed in bytes. */
+    uint16_t hole_size_histogram[NS_MEM_HOLE_HISTOGRAM_SIZE]; /**< Hole count by size. */
+} mem_hole_stat_t;
+
 typedef struct ns_mem_book ns_mem_book_t;
 
 /**
@@ -164,6 +216,38 @@ extern const mem_stat_t *ns_dyn_mem_get_mem_stat(void);
   */
 extern int ns_dyn_mem_set_temporary_alloc_free_heap_threshold(uint8_t free_heap_percentage, ns_mem_heap_size_t free_heap_amount);
 
+/**
+  * \brief Add fixed size slab class to default heap.
+  *
+  * Slab of block_count blocks is reserved from the heap. After this, allocations
+  * that use at least 3/4 of the block size are served from the slab in constant time
+  * and fall back to the heap when the slab is exhausted.
+  *
+  * \param block_size Size of slab blocks in bytes
+  * \param block_count Number of blocks in slab
+  *
+  * \return 0 on success
+  * \return -1 invalid parameters or all slab classes in use
+  * \return -2 slab class with same block size already exists
+  * \return -3 not enough heap for slab
+  */
+extern int ns_dyn_mem_slab_add(ns_mem_block_size_t block_size, uint16_t block_count);
+
+/**
+  * \brief Read free hole stats of default heap.
+  *
+  * Walks the free hole list so the cost grows with heap fragmentation. The walk
+  * leaves the critical section every NS_MEM_HOLE_STAT_WALK_STEP holes and starts
+  * again if the heap changed meanwhile.
+  *
+  * \param stat Pointer to structure where stats are written
+  *
+  * \return 0 on success
+  * \return -1 invalid parameters
+  * \return -2 heap kept changing during the walk, stats are not valid
+  */
+extern int ns_dyn_mem_hole_stat_get(mem_hole_stat_t *stat);
+
 /**
   * \brief Init and set Dynamical heap pointer and length.
   *
@@ -256,6 +340,27 @@ extern const mem_stat_t *ns_mem_get_mem_stat(ns_mem_book_t *book);
   */
 extern int ns_mem_set_temporary_alloc_free_heap_threshold(ns_mem_book_t *book, uint8_t free_heap_percentage, ns_mem_heap_size_t free_heap_amount);
 
+/**
+  * \brief Add fixed size slab class to heap.
+  *
+  * \param book Address of book keeping structure
+  * \param block_size Size of slab blocks in bytes
+  * \param block_count Number of blocks in slab
+  *
+  * \return 0 on success, <0 otherwise. See ns_dyn_mem_slab_add().
+  */
+extern int ns_mem_slab_add(ns_mem_book_t *book, ns_mem_block_size_t block_size, uint16_t block_count);
+
+/**
+  * \brief Read free hole stats of heap.
+  *
+  * \param book Address of book keeping structure
+  * \param stat Pointer to structure where stats are written
+  *
+  * \return 0 on success, <0 otherwise
+  */
+extern int ns_mem_hole_stat_get(ns_mem_book_t *book, mem_hole_stat_t *stat);
+
 #ifdef __cplusplus
 }
 #endif
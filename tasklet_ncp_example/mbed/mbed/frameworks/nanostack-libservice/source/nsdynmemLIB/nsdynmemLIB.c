@@ -30,6 +30,8 @@ typedef enum mem_stat_update_t {
     DEV_HEAP_ALLOC_OK,
     DEV_HEAP_ALLOC_FAIL,
     DEV_HEAP_FREE,
+    DEV_SLAB_ALLOC_OK,
+    DEV_SLAB_FREE,
 } mem_stat_update_t;
 
 typedef struct {
@@ -41,6 +43,19 @@ typedef int ns_mem_word_size_t; // internal signed heap block size type
 // Amount of memory regions
 #define REGION_COUNT 3
 
+#if NS_MEM_SLAB_CLASS_COUNT > 0
+#define SLAB_FREE_LIST_END 0xffff
+
+/* Fixed size block pool carved from a single heap block */
+typedef struct ns_mem_slab {
+    ns_mem_word_size_t     *pool_start;
+    ns_mem_word_size_t     *pool_end;
+    uint32_t               *in_use;         /* Bit per block, catches double frees */
+    ns_mem_word_size_t     block_words;
+    uint16_t               free_head;       /* Free blocks are chained by index stored in their first word */
+} ns_mem_slab_t;
+#endif
+
 /* struct for book keeping variables */
 struct ns_mem_book {
     ns_mem_word_size_t     *heap_main[REGION_COUNT];
@@ -50,6 +65,11 @@ struct ns_mem_book {
     NS_LIST_HEAD(hole_t, link) holes_list;
     ns_mem_heap_size_t heap_size;
     ns_mem_heap_size_t temporary_alloc_heap_limit;   /* Amount of reserved heap temporary alloc can't exceed */
+    uint32_t hole_list_changes;                      /* Bumped on every change to the holes, for ns_mem_hole_stat_get() */
+#if NS_MEM_SLAB_CLASS_COUNT > 0
+    ns_mem_slab_t slab[NS_MEM_SLAB_CLASS_COUNT];      /* Slab classes in ascending block size order */
+    uint8_t slab_count;
+#endif
 };
 
 #ifdef DBG_WISUN
@@ -125,6 +145,16 @@ int ns_dyn_mem_region_add(void *region_ptr, ns_mem_heap_size_t region_size)
     return ns_mem_region_add(default_book, region_ptr, region_size);
 }
 
+int ns_dyn_mem_slab_add(ns_mem_block_size_t block_size, uint16_t block_count)
+{
+    return ns_mem_slab_add(default_book, block_size, block_count);
+}
+
+int ns_dyn_mem_hole_stat_get(mem_hole_stat_t *stat)
+{
+    return ns_mem_hole_stat_get(default_book, stat);
+}
+
 const mem_stat_t *ns_dyn_mem_get_mem_stat(void)
 {
 #ifndef STANDARD_MALLOC
@@ -182,6 +212,10 @@ ns_mem_book_t *ns_mem_init(void *heap, ns_mem_heap_size_t h_size,
     memset(book->mem_stat_info_ptr, 0, sizeof(mem_stat_t));
     book->mem_stat_info_ptr->heap_sector_size = book->heap_size;
     book->temporary_alloc_heap_limit = book->heap_size / 100 * (100 - TEMPORARY_ALLOC_FREE_HEAP_THRESHOLD);
+    book->hole_list_changes = 0;
+#if NS_MEM_SLAB_CLASS_COUNT > 0
+    book->slab_count = 0;
+#endif
 #endif
     //There really is no support to standard malloc in this library anymore
     book->heap_failure_callback = passed_fptr;
@@ -244,6 +278,8 @@ int ns_mem_region_add(ns_mem_book_t *book, void *region_ptr, ns_mem_heap_size_t
         ns_list_add_to_start(&book->holes_list, hole_to_add);
     }
 
+    book->hole_list_changes++;
+
     // adjust total heap size with new hole
     book->heap_size += region_size;
 
@@ -332,6 +368,14 @@ static void dev_stat_update(mem_stat_t *mem_stat_info_ptr, mem_stat_update_t typ
             mem_stat_info_ptr->heap_sector_alloc_cnt--;
             mem_stat_info_ptr->heap_sector_allocated_bytes -= size;
             break;
+        // Slab pools are counted as allocated bytes when reserved, so blocks do not add to them again
+        case DEV_SLAB_ALLOC_OK:
+            mem_stat_info_ptr->heap_sector_alloc_cnt++;
+            mem_stat_info_ptr->heap_alloc_total_bytes += size;
+            break;
+        case DEV_SLAB_FREE:
+            mem_stat_info_ptr->heap_sector_alloc_cnt--;
+            break;
     }
 
 }
@@ -362,30 +406,12 @@ static int8_t ns_mem_block_validate(ns_mem_word_size_t *block_start)
     }
     return ret_val;
 }
-#endif
 
 // For direction, use 1 for direction up and -1 for down
-static void *ns_mem_internal_alloc(ns_mem_book_t *book, const ns_mem_block_size_t alloc_size, int direction)
+static void *ns_mem_heap_alloc(ns_mem_book_t *book, const ns_mem_block_size_t alloc_size, int direction)
 {
-#ifndef STANDARD_MALLOC
-    if (!book) {
-        /* We can not do anything except return NULL because we can't find book
-           keeping block */
-        return NULL;
-    }
-
-    if (direction == 1) {
-        if (book->mem_stat_info_ptr->heap_sector_allocated_bytes > book->temporary_alloc_heap_limit) {
-            /* Not enough heap for temporary memory allocation */
-            dev_stat_update(book->mem_stat_info_ptr, DEV_HEAP_ALLOC_FAIL, 0);
-#ifdef DBG_WISUN
-        wisunDbg.temp_mem_alloc_failures++;
-#endif
-            return NULL;
-        }
-    }
-
     ns_mem_word_size_t *block_ptr = NULL;
+    uint32_t walk_length = 0;
 
     platform_enter_critical();
 
@@ -402,6 +428,7 @@ static void *ns_mem_internal_alloc(ns_mem_book_t *book, const ns_mem_block_size_
                        : ns_list_get_previous(&book->holes_list, cur_hole)
         ) {
         ns_mem_word_size_t *p = block_start_from_hole(cur_hole);
+        walk_length++;
         if (ns_mem_block_validate(p) != 0 || *p >= 0) {
             //Validation failed, or this supposed hole has positive (allocated) size
             heap_failure(book, NS_DYN_MEM_HEAP_SECTOR_CORRUPTED);
@@ -453,9 +480,13 @@ static void *ns_mem_internal_alloc(ns_mem_book_t *book, const ns_mem_block_size_
     }
     block_ptr[0] = data_size;
     block_ptr[1 + data_size] = data_size;
+    book->hole_list_changes++;
 
 done:
 
+    if (book->mem_stat_info_ptr->heap_alloc_walk_max < walk_length) {
+        book->mem_stat_info_ptr->heap_alloc_walk_max = walk_length;
+    }
 
     if (block_ptr) {
         //Update Allocate OK
@@ -463,6 +494,11 @@ done:
     } else {
         //Update Allocate Fail, second parameter is used for stats
         dev_stat_update(book->mem_stat_info_ptr, DEV_HEAP_ALLOC_FAIL, 0);
+        if (data_size && (data_size + 2) * sizeof(ns_mem_word_size_t) <=
+                book->mem_stat_info_ptr->heap_sector_size - book->mem_stat_info_ptr->heap_sector_allocated_bytes) {
+            // Enough free heap in total, but not in one piece
+            book->mem_stat_info_ptr->heap_alloc_fail_frag_cnt++;
+        }
     }
     platform_exit_critical();
 
@@ -481,6 +517,113 @@ done:
 #endif
 
     return block_ptr ? block_ptr + 1 : NULL;
+}
+
+#if NS_MEM_SLAB_CLASS_COUNT > 0
+// Serve allocation from the smallest slab class that fits, if it wastes at most a quarter of the block
+static void *ns_mem_slab_alloc(ns_mem_book_t *book, const ns_mem_block_size_t alloc_size)
+{
+    ns_mem_word_size_t data_size = (alloc_size + sizeof(ns_mem_word_size_t) - 1) / sizeof(ns_mem_word_size_t);
+    ns_mem_word_size_t *block_ptr = NULL;
+
+    if (data_size < 1) {
+        return NULL;
+    }
+
+    platform_enter_critical();
+    for (uint_fast8_t i = 0; i < book->slab_count; i++) {
+        ns_mem_slab_t *slab = &book->slab[i];
+        if (slab->block_words < data_size) {
+            continue;
+        }
+        if (data_size * 4 < slab->block_words * 3) {
+            // Remaining classes are even larger
+            break;
+        }
+
+        mem_slab_stat_t *stat = &book->mem_stat_info_ptr->slab_stat[i];
+        if (slab->free_head == SLAB_FREE_LIST_END) {
+            stat->overflow_cnt++;
+            break;
+        }
+
+        uint16_t index = slab->free_head;
+        block_ptr = slab->pool_start + index * slab->block_words;
+        slab->free_head = *block_ptr;
+        slab->in_use[index / 32] |= 1u << (index % 32);
+        stat->alloc_cnt++;
+        stat->blocks_in_use++;
+        if (stat->blocks_in_use_max < stat->blocks_in_use) {
+            stat->blocks_in_use_max = stat->blocks_in_use;
+        }
+        dev_stat_update(book->mem_stat_info_ptr, DEV_SLAB_ALLOC_OK, slab->block_words * sizeof(ns_mem_word_size_t));
+        break;
+    }
+    platform_exit_critical();
+
+    return block_ptr;
+}
+
+// Returns true if block is inside a slab; the block is then either released or reported to heap failure callback
+static bool ns_mem_slab_free(ns_mem_book_t *book, ns_mem_word_size_t *block)
+{
+    for (uint_fast8_t i = 0; i < book->slab_count; i++) {
+        ns_mem_slab_t *slab = &book->slab[i];
+        if (block < slab->pool_start || block >= slab->pool_end) {
+            continue;
+        }
+
+        ns_mem_word_size_t offset = block - slab->pool_start;
+        uint16_t index = offset / slab->block_words;
+        uint32_t mask = 1u << (index % 32);
+        if (offset % slab->block_words) {
+            heap_failure(book, NS_DYN_MEM_POINTER_NOT_VALID);
+        } else if (!(slab->in_use[index / 32] & mask)) {
+            heap_failure(book, NS_DYN_MEM_DOUBLE_FREE);
+        } else {
+            slab->in_use[index / 32] &= ~mask;
+            *block = slab->free_head;
+            slab->free_head = index;
+            book->mem_stat_info_ptr->slab_stat[i].blocks_in_use--;
+            dev_stat_update(book->mem_stat_info_ptr, DEV_SLAB_FREE, 0);
+        }
+        return true;
+    }
+
+    return false;
+}
+#endif
+#endif
+
+// For direction, use 1 for direction up and -1 for down
+static void *ns_mem_internal_alloc(ns_mem_book_t *book, const ns_mem_block_size_t alloc_size, int direction)
+{
+#ifndef STANDARD_MALLOC
+    if (!book) {
+        /* We can not do anything except return NULL because we can't find book
+           keeping block */
+        return NULL;
+    }
+
+    if (direction == 1) {
+        if (book->mem_stat_info_ptr->heap_sector_allocated_bytes > book->temporary_alloc_heap_limit) {
+            /* Not enough heap for temporary memory allocation */
+            dev_stat_update(book->mem_stat_info_ptr, DEV_HEAP_ALLOC_FAIL, 0);
+#ifdef DBG_WISUN
+        wisunDbg.temp_mem_alloc_failures++;
+#endif
+            return NULL;
+        }
+    }
+
+#if NS_MEM_SLAB_CLASS_COUNT > 0
+    void *slab_block = ns_mem_slab_alloc(book, alloc_size);
+    if (slab_block) {
+        return slab_block;
+    }
+#endif
+
+    return ns_mem_heap_alloc(book, alloc_size, direction);
 #else
     void *retval = NULL;
     if (alloc_size) {
@@ -492,6 +635,131 @@ done:
 #endif
 }
 
+int ns_mem_slab_add(ns_mem_book_t *book, ns_mem_block_size_t block_size, uint16_t block_count)
+{
+#if !defined(STANDARD_MALLOC) && NS_MEM_SLAB_CLASS_COUNT > 0
+    if (!book || !block_size || !block_count || block_count == SLAB_FREE_LIST_END ||
+            book->slab_count >= NS_MEM_SLAB_CLASS_COUNT) {
+        return -1;
+    }
+
+    ns_mem_word_size_t block_words = (block_size + sizeof(ns_mem_word_size_t) - 1) / sizeof(ns_mem_word_size_t);
+    uint_fast8_t index;
+    for (index = 0; index < book->slab_count; index++) {
+        if (book->slab[index].block_words == block_words) {
+            return -2;
+        }
+        if (book->slab[index].block_words > block_words) {
+            break;
+        }
+    }
+
+    // Blocks followed by in use bitmap, reserved as one long period heap block
+    ns_mem_block_size_t map_size = (block_count + 31) / 32 * sizeof(uint32_t);
+    ns_mem_block_size_t pool_size = (ns_mem_block_size_t) block_words * block_count * sizeof(ns_mem_word_size_t) + map_size;
+    if (pool_size > book->heap_size / 2) {
+        return -3;
+    }
+    ns_mem_word_size_t *pool = ns_mem_heap_alloc(book, pool_size, -1);
+    if (!pool) {
+        return -3;
+    }
+
+    platform_enter_critical();
+    mem_slab_stat_t *stats = book->mem_stat_info_ptr->slab_stat;
+    memmove(&book->slab[index + 1], &book->slab[index], (book->slab_count - index) * sizeof(ns_mem_slab_t));
+    memmove(&stats[index + 1], &stats[index], (book->slab_count - index) * sizeof(mem_slab_stat_t));
+
+    ns_mem_slab_t *slab = &book->slab[index];
+    slab->pool_start = pool;
+    slab->pool_end = pool + block_words * block_count;
+    slab->in_use = (uint32_t *) slab->pool_end;
+    slab->block_words = block_words;
+    memset(slab->in_use, 0, map_size);
+    for (uint16_t i = 0; i < block_count; i++) {
+        pool[i * block_words] = i + 1 < block_count ? i + 1 : SLAB_FREE_LIST_END;
+    }
+    slab->free_head = 0;
+
+    memset(&stats[index], 0, sizeof(mem_slab_stat_t));
+    stats[index].block_size = block_words * sizeof(ns_mem_word_size_t);
+    stats[index].block_count = block_count;
+    book->slab_count++;
+    platform_exit_critical();
+
+    return 0;
+#else
+    (void) book;
+    (void) block_size;
+    (void) block_count;
+    return -1;
+#endif
+}
+
+#ifndef STANDARD_MALLOC
+// Walks the holes NS_MEM_HOLE_STAT_WALK_STEP at a time, returns false if the heap changed in between
+static bool ns_mem_hole_stat_walk(ns_mem_book_t *book, mem_hole_stat_t *stat)
+{
+    memset(stat, 0, sizeof(mem_hole_stat_t));
+
+    platform_enter_critical();
+    uint32_t changes = book->hole_list_changes;
+    hole_t *cur_hole = ns_list_get_first(&book->holes_list);
+    while (cur_hole) {
+        for (uint_fast16_t step = 0; cur_hole && step < NS_MEM_HOLE_STAT_WALK_STEP; step++) {
+            ns_mem_heap_size_t hole_bytes = -*block_start_from_hole(cur_hole) * sizeof(ns_mem_word_size_t);
+            uint_fast8_t bucket = 0;
+            while (bucket < NS_MEM_HOLE_HISTOGRAM_SIZE - 1 && hole_bytes >= ((ns_mem_heap_size_t) 32 << bucket)) {
+                bucket++;
+            }
+            stat->hole_size_histogram[bucket]++;
+            stat->hole_cnt++;
+            stat->free_bytes += hole_bytes;
+            if (stat->largest_free_block < hole_bytes) {
+                stat->largest_free_block = hole_bytes;
+            }
+            cur_hole = ns_list_get_next(&book->holes_list, cur_hole);
+        }
+        if (!cur_hole) {
+            break;
+        }
+
+        // Let pending interrupts in, the hole we stopped at is only valid if nothing changed
+        platform_exit_critical();
+        platform_enter_critical();
+        if (book->hole_list_changes != changes) {
+            platform_exit_critical();
+            return false;
+        }
+    }
+    platform_exit_critical();
+
+    return true;
+}
+#endif
+
+int ns_mem_hole_stat_get(ns_mem_book_t *book, mem_hole_stat_t *stat)
+{
+#ifndef STANDARD_MALLOC
+    if (!book || !stat) {
+        return -1;
+    }
+
+    for (uint_fast8_t retries = 0; !ns_mem_hole_stat_walk(book, stat); retries++) {
+        if (retries == NS_MEM_HOLE_STAT_WALK_RETRIES) {
+            memset(stat, 0, sizeof(mem_hole_stat_t));
+            return -2;
+        }
+    }
+
+    return 0;
+#else
+    (void) book;
+    (void) stat;
+    return -1;
+#endif
+}
+
 void *ns_mem_alloc(ns_mem_book_t *heap, ns_mem_block_size_t alloc_size)
 {
     return ns_mem_internal_alloc(heap, alloc_size, -1);
@@ -620,6 +888,7 @@ static void ns_mem_free_and_merge_with_adjacent_blocks(ns_mem_book_t *book, ns_m
     }
     *start = -merged_data_size;
     *end = -merged_data_size;
+    book->hole_list_changes++;
 }
 #endif
 
@@ -645,6 +914,12 @@ void ns_mem_free(ns_mem_book_t *book, void *block)
     ns_mem_word_size_t size;
 
     platform_enter_critical();
+#if NS_MEM_SLAB_CLASS_COUNT > 0
+    if (ns_mem_slab_free(book, ptr)) {
+        platform_exit_critical();
+        return;
+    }
+#endif
     ptr --;
     //Read Current Size
     size = *ptr;
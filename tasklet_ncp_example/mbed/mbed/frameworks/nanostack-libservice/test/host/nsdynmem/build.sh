@@ -0,0 +1,38 @@
+#!/bin/sh
+#
+# Builds and runs the host tests of the nsdynmemLIB slab classes and
+# fragmentation stats, and the benchmark of the slab classes, also as a
+# replay of its workload from a trace. Set CC and OUT to change the compiler and the build directory.
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+LIBSERVICE=$(cd "$HERE/../../.." && pwd)
+PLATFORM=$(cd "$LIBSERVICE/../../../../ti_wisunfan/ti_wisunfan/mbed_port/mbednanostack2tirtos/platform" && pwd)
+OUT=${OUT:-${TMPDIR:-/tmp}/nsdynmem_test}
+CC=${CC:-cc}
+
+INC="-I$LIBSERVICE/mbed-client-libservice -I$LIBSERVICE/mbed-client-libservice/platform -I$PLATFORM"
+SRC="$LIBSERVICE/source/nsdynmemLIB/nsdynmemLIB.c $LIBSERVICE/source/libList/ns_list.c"
+
+mkdir -p "$OUT"
+
+# nsdynmemLIB only aligns blocks to 4 bytes, which is enough for the 32-bit targets
+$CC -std=gnu99 -O1 -g -fsanitize=address,undefined -fno-sanitize=alignment $INC -o "$OUT/nsdynmem_slab_test" \
+    "$HERE/nsdynmem_slab_test.c" $SRC
+"$OUT/nsdynmem_slab_test"
+
+$CC -std=gnu99 -O1 -g -fsanitize=address,undefined -fno-sanitize=alignment $INC -o "$OUT/nsdynmem_stat_test" \
+    "$HERE/nsdynmem_stat_test.c" $SRC
+for seed in 1 2 3; do
+    "$OUT/nsdynmem_stat_test" $seed
+done
+
+$CC -std=gnu99 -O2 -DNDEBUG $INC -o "$OUT/nsdynmem_slab_bench" "$HERE/nsdynmem_slab_bench.c" $SRC
+"$OUT/nsdynmem_slab_bench"
+"$OUT/nsdynmem_slab_bench" slab
+
+# Free heap and largest free block over the same workload, replayed from a trace
+"$OUT/nsdynmem_slab_bench" trace "$OUT/churn.trace"
+"$OUT/nsdynmem_slab_bench" replay "$OUT/churn.trace"
+"$OUT/nsdynmem_slab_bench" slab replay "$OUT/churn.trace"
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Alloc/free cost of nsdynmemLIB with and without slab classes.
+ *
+ * 300 long-lived blocks are allocated first, then 2M random temporary
+ * allocs and frees of mixed sizes run over a 100 kB heap.
+ *
+ * The same workload can be written out as a trace, and a trace, e.g. one
+ * logged on a device, replayed instead of it. A trace has one operation
+ * per line: "a <slot> <size>" or "t <slot> <size>" for a long-lived or
+ * temporary alloc into a slot, "f <slot>" to free it. The replay prints
+ * the free bytes and the largest free block every BENCH_SERIES_STEP
+ * operations, to show how fragmentation develops over the trace. Free
+ * slab blocks are not part of either.
+ *
+ * Usage: nsdynmem_slab_bench [slab] [trace <file> | replay <file>]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "nsdynmemLIB.h"
+
+#define BENCH_OPS 2000000
+#define BENCH_SLOTS 4096
+#define BENCH_SERIES_STEP 100000
+
+static char bench_heap[100000];
+static void *bench_block[BENCH_SLOTS];
+
+void platform_enter_critical(void)
+{
+}
+
+void platform_exit_critical(void)
+{
+}
+
+static void bench_heap_fail(heap_fail_t reason)
+{
+    (void) reason;
+}
+
+static void bench_init(bool slab, mem_stat_t *stat)
+{
+    ns_dyn_mem_init(bench_heap, sizeof(bench_heap), bench_heap_fail, stat);
+    if (slab) {
+        ns_dyn_mem_slab_add(36, 48);
+        ns_dyn_mem_slab_add(56, 48);
+        ns_dyn_mem_slab_add(232, 24);
+        ns_dyn_mem_slab_add(96, 64);
+    }
+}
+
+static void bench_trace(FILE *trace)
+{
+    const size_t size[] = {36, 56, 232, 96, 40, 300, 700, 36, 56, 96};
+    bool used[600] = {false};
+
+    // A failed alloc leaves its slot empty in the replay, freeing it then does nothing
+    srand(1);
+    for (int i = 0; i < 300; i++) {
+        fprintf(trace, "a %d %u\n", i, (unsigned) size[rand() % 10]);
+        used[i] = true;
+    }
+    for (int k = 0; k < BENCH_OPS; k++) {
+        int i = rand() % 600;
+        if (used[i]) {
+            fprintf(trace, "f %d\n", i);
+        } else {
+            fprintf(trace, "t %d %u\n", i, (unsigned) size[rand() % 10]);
+        }
+        used[i] = !used[i];
+    }
+}
+
+static int bench_replay(FILE *trace, bool slab, const mem_stat_t *stat)
+{
+    mem_hole_stat_t hole_stat;
+    ns_mem_heap_size_t largest_min = sizeof(bench_heap);
+    unsigned long ops = 0;
+    char op;
+    int i;
+    unsigned size;
+
+    printf("%s: op free_bytes largest_free_block\n", slab ? "slab" : "heap");
+    while (fscanf(trace, " %c %d", &op, &i) == 2) {
+        if (i < 0 || i >= BENCH_SLOTS) {
+            printf("slot %d out of range\n", i);
+            return 1;
+        }
+        if (op == 'f') {
+            ns_dyn_mem_free(bench_block[i]);
+            bench_block[i] = NULL;
+        } else if (fscanf(trace, "%u", &size) == 1 && (op == 'a' || op == 't') && !bench_block[i]) {
+            bench_block[i] = op == 'a' ? ns_dyn_mem_alloc(size) : ns_dyn_mem_temporary_alloc(size);
+        } else {
+            printf("bad trace operation %lu\n", ops + 1);
+            return 1;
+        }
+
+        ns_dyn_mem_hole_stat_get(&hole_stat);
+        if (largest_min > hole_stat.largest_free_block) {
+            largest_min = hole_stat.largest_free_block;
+        }
+        if (++ops % BENCH_SERIES_STEP == 0) {
+            printf("%s: %lu %u %u\n", slab ? "slab" : "heap", ops,
+                   (unsigned) hole_stat.free_bytes, (unsigned) hole_stat.largest_free_block);
+        }
+    }
+
+    printf("%s: %lu ops replayed, smallest largest free block %u, %u failed allocs\n", slab ? "slab" : "heap",
+           ops, (unsigned) largest_min, (unsigned) stat->heap_alloc_fail_cnt);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    const size_t size[] = {36, 56, 232, 96, 40, 300, 700, 36, 56, 96};
+    bool slab = argc > 1 && strcmp(argv[1], "slab") == 0;
+    struct timespec begin, end;
+    mem_stat_t stat;
+
+    if (slab) {
+        argc--;
+        argv++;
+    }
+    if (argc > 2) {
+        bool replay = strcmp(argv[1], "replay") == 0;
+        FILE *trace = fopen(argv[2], replay ? "r" : "w");
+        if (!trace || (!replay && strcmp(argv[1], "trace") != 0)) {
+            printf("usage: nsdynmem_slab_bench [slab] [trace <file> | replay <file>]\n");
+            return 1;
+        }
+        if (!replay) {
+            bench_trace(trace);
+            return fclose(trace) != 0;
+        }
+
+        bench_init(slab, &stat);
+        int ret = bench_replay(trace, slab, &stat);
+        fclose(trace);
+        return ret;
+    }
+
+    bench_init(slab, &stat);
+
+    srand(1);
+    for (int i = 0; i < 300; i++) {
+        bench_block[i] = ns_dyn_mem_alloc(size[rand() % 10]);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &begin);
+    for (int k = 0; k < BENCH_OPS; k++) {
+        int i = rand() % 600;
+        if (bench_block[i]) {
+            ns_dyn_mem_free(bench_block[i]);
+            bench_block[i] = NULL;
+        } else {
+            bench_block[i] = ns_dyn_mem_temporary_alloc(size[rand() % 10]);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double ns = (end.tv_sec - begin.tv_sec) * 1e9 + (end.tv_nsec - begin.tv_nsec);
+    printf("%s: %.1f ns per op, %u failed allocs\n", slab ? "slab" : "heap", ns / BENCH_OPS,
+           (unsigned) stat.heap_alloc_fail_cnt);
+    return 0;
+}
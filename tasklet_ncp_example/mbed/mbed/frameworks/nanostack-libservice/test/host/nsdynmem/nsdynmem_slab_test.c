@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Host test of the nsdynmemLIB slab classes.
+ *
+ * Checks class registration and ordering, overflow to the heap when a
+ * class is empty, the 3/4 fill rule, double free and bad pointer
+ * detection, that slab blocks show in the heap sector count and total
+ * allocated bytes, and that random churn over slab and heap sizes leaves
+ * the heap with only the slab pools allocated.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "nsdynmemLIB.h"
+
+static int test_fails[8];
+static char test_heap[100000];
+
+void platform_enter_critical(void)
+{
+}
+
+void platform_exit_critical(void)
+{
+}
+
+static void test_heap_fail(heap_fail_t reason)
+{
+    test_fails[reason]++;
+}
+
+int main(void)
+{
+    mem_stat_t stat;
+    void *block[40];
+    void *churn[500] = {0};
+    const size_t churn_size[] = {36, 56, 232, 100, 40, 300};
+
+    ns_dyn_mem_init(test_heap, sizeof(test_heap), test_heap_fail, &stat);
+    ns_mem_heap_size_t heap_base = stat.heap_sector_allocated_bytes;
+
+    assert(ns_dyn_mem_slab_add(56, 16) == 0);
+    assert(ns_dyn_mem_slab_add(36, 16) == 0);
+    assert(ns_dyn_mem_slab_add(36, 4) == -2);
+    assert(ns_dyn_mem_slab_add(232, 8) == 0);
+    assert(stat.slab_stat[0].block_size == 36);
+    assert(stat.slab_stat[1].block_size == 56);
+    assert(stat.slab_stat[2].block_size == 232);
+
+    // Each pool is one heap block: the blocks plus the heap block overhead
+    ns_mem_heap_size_t pool = stat.heap_sector_allocated_bytes - heap_base;
+    assert(pool == 16 * 36 + 16 * 56 + 8 * 232 + 3 * 4 + 3 * 8);
+
+    // The 36-byte class holds 16, the rest overflow to the heap
+    ns_mem_heap_size_t sector_base = stat.heap_sector_alloc_cnt;
+    uint32_t total_base = stat.heap_alloc_total_bytes;
+    for (int i = 0; i < 20; i++) {
+        block[i] = ns_dyn_mem_temporary_alloc(33);
+    }
+    assert(stat.slab_stat[0].blocks_in_use == 16);
+    assert(stat.slab_stat[0].overflow_cnt == 4);
+
+    // Slab blocks are counted as sectors, their bytes only in the total as the pool is already allocated
+    assert(stat.heap_sector_alloc_cnt == sector_base + 20);
+    assert(stat.heap_alloc_total_bytes == total_base + 16 * 36 + 4 * (36 + 8));
+    assert(stat.heap_sector_allocated_bytes - heap_base == pool + 4 * (36 + 8));
+
+    // 20 bytes uses less than 3/4 of a 36-byte block, so it comes from the heap
+    void *small = ns_dyn_mem_alloc(20);
+    assert(stat.slab_stat[0].alloc_cnt == 16);
+
+    for (int i = 0; i < 20; i++) {
+        ns_dyn_mem_free(block[i]);
+    }
+    assert(stat.slab_stat[0].blocks_in_use == 0);
+    assert(stat.slab_stat[0].blocks_in_use_max == 16);
+    assert(stat.heap_sector_alloc_cnt == sector_base + 1);
+
+    ns_dyn_mem_free(block[3]);
+    assert(test_fails[NS_DYN_MEM_DOUBLE_FREE] == 1);
+
+    void *large = ns_dyn_mem_alloc(230);
+    ns_dyn_mem_free((char *) large + 4);
+    assert(test_fails[NS_DYN_MEM_POINTER_NOT_VALID] == 1);
+    ns_dyn_mem_free(large);
+    ns_dyn_mem_free(small);
+
+    srand(1);
+    for (int k = 0; k < 200000; k++) {
+        int i = rand() % 500;
+        if (churn[i]) {
+            ns_dyn_mem_free(churn[i]);
+            churn[i] = NULL;
+        } else {
+            size_t size = churn_size[rand() % 6];
+            churn[i] = ns_dyn_mem_alloc(size);
+            if (churn[i]) {
+                memset(churn[i], 0xaa, size);
+            }
+        }
+    }
+    for (int i = 0; i < 500; i++) {
+        ns_dyn_mem_free(churn[i]);
+    }
+
+    for (int i = 0; i < 8; i++) {
+        if (i != NS_DYN_MEM_DOUBLE_FREE && i != NS_DYN_MEM_POINTER_NOT_VALID) {
+            assert(test_fails[i] == 0);
+        }
+    }
+    assert(stat.heap_sector_allocated_bytes - heap_base == pool);
+    assert(stat.heap_sector_alloc_cnt == sector_base);
+
+    printf("OK\n");
+    return 0;
+}
@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Host test of the nsdynmemLIB fragmentation stats.
+ *
+ * Random allocs and frees of random sizes fragment the heap. After every
+ * step the hole stats must add up: the histogram to the hole count, and
+ * the free bytes plus the hole overhead to no more than the free heap. An alloc of the
+ * largest free block must succeed and one word more must fail. Each failed
+ * alloc walks every hole, and counts as a fragmentation failure exactly
+ * when the free heap in total would have been large enough. Holes on both
+ * sides of the histogram bucket edges must land in the right buckets.
+ *
+ * The hole walk must leave the critical section every
+ * NS_MEM_HOLE_STAT_WALK_STEP holes, start again when an alloc from an
+ * "interrupt" changes the heap in between, and give up when that keeps
+ * happening.
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "nsdynmemLIB.h"
+
+#define TEST_BLOCKS 300
+
+static char test_heap[20000];
+static int test_exits;
+static int test_interrupts;
+static bool test_in_interrupt;
+
+void platform_enter_critical(void)
+{
+}
+
+// Counts critical sections and, while test_interrupts is set, changes the heap as an interrupt would on leaving one
+void platform_exit_critical(void)
+{
+    if (test_in_interrupt) {
+        return;
+    }
+    test_exits++;
+    if (test_interrupts) {
+        test_interrupts--;
+        test_in_interrupt = true;
+        ns_dyn_mem_free(ns_dyn_mem_alloc(8));
+        test_in_interrupt = false;
+    }
+}
+
+static void test_fail(const char *what, int round)
+{
+    printf("FAIL: %s in round %d\n", what, round);
+    exit(1);
+}
+
+static void test_hole_stat_check(const mem_stat_t *stat, int round)
+{
+    mem_hole_stat_t hole_stat;
+    ns_mem_heap_size_t holes = 0;
+
+    if (ns_dyn_mem_hole_stat_get(&hole_stat) != 0) {
+        test_fail("hole stat read", round);
+    }
+    for (int i = 0; i < NS_MEM_HOLE_HISTOGRAM_SIZE; i++) {
+        holes += hole_stat.hole_size_histogram[i];
+    }
+    if (holes != hole_stat.hole_cnt) {
+        test_fail("histogram does not add up to the hole count", round);
+    }
+    // Each hole carries a start and an end word, like an allocated block. Free blocks too small for a hole
+    // descriptor are not on the hole list.
+    if (hole_stat.free_bytes + hole_stat.hole_cnt * 2 * sizeof(int) >
+            stat->heap_sector_size - stat->heap_sector_allocated_bytes) {
+        test_fail("free bytes past the free heap", round);
+    }
+    if (hole_stat.largest_free_block > hole_stat.free_bytes || (hole_stat.hole_cnt && !hole_stat.largest_free_block)) {
+        test_fail("largest free block", round);
+    }
+
+    uint32_t fail_cnt = stat->heap_alloc_fail_cnt;
+    uint32_t frag_cnt = stat->heap_alloc_fail_frag_cnt;
+    if (hole_stat.largest_free_block) {
+        void *largest = ns_dyn_mem_alloc(hole_stat.largest_free_block);
+        if (!largest) {
+            test_fail("largest free block cannot be allocated", round);
+        }
+        ns_dyn_mem_free(largest);
+    }
+    if (ns_dyn_mem_alloc(hole_stat.largest_free_block + sizeof(int))) {
+        test_fail("block past the largest free block allocated", round);
+    }
+    if (stat->heap_alloc_fail_cnt != fail_cnt + 1) {
+        test_fail("failure not counted", round);
+    }
+    if (stat->heap_alloc_walk_max < hole_stat.hole_cnt) {
+        test_fail("walk shorter than the hole list", round);
+    }
+    // The failed block, one word past the largest hole, and its two overhead words against the free heap
+    bool fits = hole_stat.largest_free_block + 3 * sizeof(int) <=
+                stat->heap_sector_size - stat->heap_sector_allocated_bytes;
+    if (stat->heap_alloc_fail_frag_cnt != frag_cnt + fits) {
+        test_fail("fragmentation failure count", round);
+    }
+}
+
+// Frees blocks between allocated ones, so each leaves a hole of its own size, on both sides of the bucket edges
+static void test_histogram_check(void)
+{
+    const ns_mem_block_size_t hole_size[] = {28, 32, 60, 64, 124, 128};
+    const uint16_t histogram[NS_MEM_HOLE_HISTOGRAM_SIZE] = {1, 2, 2, 1, 0, 0, 0, 1};
+    void *hole[6];
+    void *keep[6];
+    mem_stat_t stat;
+    mem_hole_stat_t hole_stat;
+
+    ns_dyn_mem_init(test_heap, sizeof(test_heap), NULL, &stat);
+    for (int i = 0; i < 6; i++) {
+        hole[i] = ns_dyn_mem_alloc(hole_size[i]);
+        keep[i] = ns_dyn_mem_alloc(16);
+    }
+    for (int i = 0; i < 6; i++) {
+        ns_dyn_mem_free(hole[i]);
+    }
+    ns_dyn_mem_hole_stat_get(&hole_stat);
+    if (hole_stat.hole_cnt != 7 || memcmp(hole_stat.hole_size_histogram, histogram, sizeof(histogram))) {
+        test_fail("hole size histogram", -1);
+    }
+    for (int i = 0; i < 6; i++) {
+        ns_dyn_mem_free(keep[i]);
+    }
+}
+
+// Leaves many holes behind, then reads the hole stats without and with heap changes during the walk
+static void test_walk_check(void)
+{
+    void *block[TEST_BLOCKS];
+    mem_stat_t stat;
+    mem_hole_stat_t hole_stat;
+    mem_hole_stat_t hole_stat_changed;
+
+    ns_dyn_mem_init(test_heap, sizeof(test_heap), NULL, &stat);
+    for (int i = 0; i < TEST_BLOCKS; i++) {
+        block[i] = ns_dyn_mem_alloc(24);
+    }
+    for (int i = 0; i < TEST_BLOCKS; i += 2) {
+        ns_dyn_mem_free(block[i]);
+    }
+
+    test_exits = 0;
+    if (ns_dyn_mem_hole_stat_get(&hole_stat) != 0 || hole_stat.hole_cnt <= 3 * NS_MEM_HOLE_STAT_WALK_STEP) {
+        test_fail("hole stat read", -1);
+    }
+    if (test_exits != (int)((hole_stat.hole_cnt + NS_MEM_HOLE_STAT_WALK_STEP - 1) / NS_MEM_HOLE_STAT_WALK_STEP)) {
+        test_fail("hole walk steps", -1);
+    }
+
+    // The change is undone right away, the walk started again must see the same holes. A walk that
+    // sees a change leaves the critical section twice, after its first step and when it gives up.
+    test_exits = 0;
+    test_interrupts = 1;
+    if (ns_dyn_mem_hole_stat_get(&hole_stat_changed) != 0 || memcmp(&hole_stat, &hole_stat_changed, sizeof(hole_stat))) {
+        test_fail("hole walk restart", -1);
+    }
+    if (test_exits != 2 + (int)((hole_stat.hole_cnt + NS_MEM_HOLE_STAT_WALK_STEP - 1) / NS_MEM_HOLE_STAT_WALK_STEP)) {
+        test_fail("hole walk not restarted", -1);
+    }
+
+    test_exits = 0;
+    test_interrupts = -1;
+    if (ns_dyn_mem_hole_stat_get(&hole_stat_changed) != -2 || hole_stat_changed.hole_cnt) {
+        test_fail("hole walk retries", -1);
+    }
+    if (test_exits != 2 * (NS_MEM_HOLE_STAT_WALK_RETRIES + 1)) {
+        test_fail("hole walk retry count", -1);
+    }
+    test_interrupts = 0;
+
+    for (int i = 1; i < TEST_BLOCKS; i += 2) {
+        ns_dyn_mem_free(block[i]);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned seed = argc > 1 ? strtoul(argv[1], NULL, 0) : 1;
+    int rounds = argc > 2 ? atoi(argv[2]) : 20000;
+    mem_stat_t stat;
+    mem_hole_stat_t hole_stat;
+    void *block[TEST_BLOCKS] = {0};
+
+    assert(ns_mem_hole_stat_get(NULL, &hole_stat) == -1);
+    assert(ns_dyn_mem_hole_stat_get(NULL) == -1);
+    test_histogram_check();
+    test_walk_check();
+
+    ns_dyn_mem_init(test_heap, sizeof(test_heap), NULL, &stat);
+    test_hole_stat_check(&stat, -1);
+
+    srand(seed);
+    for (int round = 0; round < rounds; round++) {
+        int i = rand() % TEST_BLOCKS;
+        if (block[i]) {
+            ns_dyn_mem_free(block[i]);
+            block[i] = NULL;
+        } else {
+            block[i] = rand() % 2 ? ns_dyn_mem_alloc(1 + rand() % 400) : ns_dyn_mem_temporary_alloc(1 + rand() % 100);
+        }
+        test_hole_stat_check(&stat, round);
+    }
+
+    printf("OK: seed %u, longest walk %lu\n", seed, (unsigned long) stat.heap_alloc_walk_max);
+    return 0;
+}
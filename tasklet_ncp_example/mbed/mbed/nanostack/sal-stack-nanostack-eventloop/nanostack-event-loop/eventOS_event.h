@@ -251,6 +251,7 @@ typedef struct arm_event_storage {
         ARM_LIB_EVENT_QUEUED,
         ARM_LIB_EVENT_RUNNING,
     } state;
+    uint32_t queued_ticks; /**< Event timer tick when queued, for dwell-time statistics */
     ns_list_link_t link;
 } arm_event_storage_t;
 
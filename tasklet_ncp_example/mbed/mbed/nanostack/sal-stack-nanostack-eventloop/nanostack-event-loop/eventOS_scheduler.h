@@ -26,6 +26,7 @@ extern "C" {
  */
 
 #include "ns_types.h"
+#include "eventOS_event.h"
 
 /* Compatibility with older ns_types.h */
 #ifndef NS_NORETURN
@@ -51,6 +52,35 @@ bool eventOS_scheduler_dispatch_event(void);
  */
 extern void eventOS_scheduler_run_until_idle(void);
 
+/**
+ * \struct eventOS_scheduler_queue_stats
+ * \brief Event queue statistics for one priority level.
+ */
+typedef struct eventOS_scheduler_queue_stats {
+    uint16_t depth;             /**< Events currently queued */
+    uint16_t max_depth;         /**< Highest queue depth seen */
+    uint32_t max_dwell_ticks;   /**< Longest wait from queueing to dispatch, in event timer ticks */
+    uint32_t enqueued;          /**< Events queued */
+} eventOS_scheduler_queue_stats_t;
+
+/**
+ * \brief Read event queue statistics for a priority level.
+ *
+ * \param priority priority level to read
+ * \param stats pointer where statistics are copied
+ *
+ * \return 0 OK
+ * \return -1 Invalid parameters
+ */
+extern int8_t eventOS_scheduler_queue_stats_get(arm_library_event_priority_e priority, eventOS_scheduler_queue_stats_t *stats);
+
+/**
+ * \brief Reset event queue statistics.
+ *
+ * Peak values restart from the current queue state.
+ */
+extern void eventOS_scheduler_queue_stats_reset(void);
+
 /**
  * \brief Start Event scheduler.
  * Loops forever processing events from the queue.
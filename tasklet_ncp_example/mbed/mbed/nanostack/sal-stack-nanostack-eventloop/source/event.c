@@ -18,6 +18,7 @@
 #include "ns_list.h"
 #include "eventOS_event.h"
 #include "eventOS_scheduler.h"
+#include "eventOS_event_timer.h"
 #include "timer_sys.h"
 #include "nsdynmemLIB.h"
 #include "ns_timer.h"
@@ -31,14 +32,33 @@ typedef struct arm_core_tasklet {
     ns_list_link_t link;
 } arm_core_tasklet_t;
 
+typedef NS_LIST_HEAD(arm_event_storage_t, link) event_queue_t;
+
+#define EVENT_PRIORITY_LEVELS (ARM_LIB_LOW_PRIORITY_EVENT + 1)
+NS_STATIC_ASSERT(EVENT_PRIORITY_LEVELS <= 8, "Event priority bitmap is 8 bits")
+
 static NS_LIST_DEFINE(arm_core_tasklet_list, arm_core_tasklet_t, link);
-static NS_LIST_DEFINE(event_queue_active, arm_event_storage_t, link);
+// Tasklets cannot be deleted, so ids are handed out densely from 0 and
+// index this table directly. It grows by doubling as tasklets are created.
+#define TASKLET_TABLE_INITIAL_SIZE 8
+static arm_core_tasklet_t **tasklet_table;
+static uint8_t tasklet_table_size;
+static uint8_t tasklet_count;
+// One FIFO per priority, plus a bitmap of the non-empty ones
+static event_queue_t event_queue_active[EVENT_PRIORITY_LEVELS];
+static uint8_t event_queue_active_map;
+static eventOS_scheduler_queue_stats_t event_queue_stats[EVENT_PRIORITY_LEVELS];
 static NS_LIST_DEFINE(free_event_entry, arm_event_storage_t, link);
 
 // Statically allocate initial pool of events.
 #define STARTUP_EVENT_POOL_SIZE 10
 static arm_event_storage_t startup_event_pool[STARTUP_EVENT_POOL_SIZE];
 
+// Dynamic events beyond the startup pool come from a heap slab class
+#ifndef EVENT_SLAB_BLOCK_COUNT
+#define EVENT_SLAB_BLOCK_COUNT 16
+#endif
+
 /** Curr_tasklet tell to core and platform which task_let is active, Core Update this automatic when switch Tasklet. */
 int8_t curr_tasklet = 0;
 
@@ -50,12 +70,11 @@ static void event_core_write(arm_event_storage_t *event);
 
 static arm_core_tasklet_t *event_tasklet_handler_get(uint8_t tasklet_id)
 {
-    ns_list_foreach(arm_core_tasklet_t, cur, &arm_core_tasklet_list) {
-        if (cur->id == tasklet_id) {
-            return cur;
-        }
+    // Negative ids come in as >= 128, so fail the bound check too
+    if (tasklet_id >= tasklet_count) {
+        return NULL;
     }
-    return NULL;
+    return tasklet_table[tasklet_id];
 }
 
 bool event_tasklet_handler_id_valid(uint8_t tasklet_id)
@@ -67,13 +86,34 @@ bool event_tasklet_handler_id_valid(uint8_t tasklet_id)
 // curr_tasklet is reset to 0 in various places.
 static int8_t tasklet_get_free_id(void)
 {
-    /*(Note use of uint8_t to avoid overflow if we reach 0x7F)*/
-    for (uint8_t i = 0; i <= INT8_MAX; i++) {
-        if (!event_tasklet_handler_get(i)) {
-            return i;
-        }
+    if (tasklet_count > INT8_MAX) {
+        return -1;
     }
-    return -1;
+    return tasklet_count;
+}
+
+static bool tasklet_table_reserve(void)
+{
+    if (tasklet_count < tasklet_table_size) {
+        return true;
+    }
+
+    /*(Note use of uint16_t to avoid overflow if we reach 0x80)*/
+    uint16_t new_size = tasklet_table_size ? tasklet_table_size * 2 : TASKLET_TABLE_INITIAL_SIZE;
+    if (new_size > INT8_MAX + 1) {
+        new_size = INT8_MAX + 1;
+    }
+    arm_core_tasklet_t **new_table = ns_dyn_mem_alloc(new_size * sizeof(arm_core_tasklet_t *));
+    if (!new_table) {
+        return false;
+    }
+    if (tasklet_table) {
+        memcpy(new_table, tasklet_table, tasklet_count * sizeof(arm_core_tasklet_t *));
+        ns_dyn_mem_free(tasklet_table);
+    }
+    tasklet_table = new_table;
+    tasklet_table_size = new_size;
+    return true;
 }
 
 
@@ -88,6 +128,10 @@ int8_t eventOS_event_handler_create(void (*handler_func_ptr)(arm_event_s *), uin
         }
     }
 
+    if (tasklet_get_free_id() < 0 || !tasklet_table_reserve()) {
+        return -2;
+    }
+
     //Allocate new
     arm_core_tasklet_t *new = tasklet_dynamically_allocate();
     if (!new) {
@@ -100,10 +144,11 @@ int8_t eventOS_event_handler_create(void (*handler_func_ptr)(arm_event_s *), uin
         return -2;
     }
 
-    //Fill in tasklet; add to list
+    //Fill in tasklet; add to list and table
     new->id = tasklet_get_free_id();
     new->func_ptr = handler_func_ptr;
     ns_list_add_to_end(&arm_core_tasklet_list, new);
+    tasklet_table[tasklet_count++] = new;
 
     //Queue "init" event for the new task
     event_tmp->data.receiver = new->id;
@@ -141,9 +186,28 @@ void eventOS_event_send_timer_allocated(arm_event_storage_t *event)
     event_core_write(event);
 }
 
+static uint_fast8_t event_queue_index(const arm_event_storage_t *event)
+{
+    // Anything outside the enum is treated as lowest priority
+    if ((unsigned) event->data.priority >= EVENT_PRIORITY_LEVELS) {
+        return EVENT_PRIORITY_LEVELS - 1;
+    }
+    return event->data.priority;
+}
+
+/* Called internally with lock held */
+static void event_queue_remove(arm_event_storage_t *event, uint_fast8_t index)
+{
+    ns_list_remove(&event_queue_active[index], event);
+    if (ns_list_is_empty(&event_queue_active[index])) {
+        event_queue_active_map &= ~(1u << index);
+    }
+    event_queue_stats[index].depth--;
+}
+
 void eventOS_event_cancel_critical(arm_event_storage_t *event)
 {
-    ns_list_remove(&event_queue_active, event);
+    event_queue_remove(event, event_queue_index(event));
 }
 
 static arm_event_storage_t *event_dynamically_allocate(void)
@@ -209,11 +273,24 @@ void event_core_free_push(arm_event_storage_t *free)
 
 static arm_event_storage_t *event_core_read(void)
 {
+    arm_event_storage_t *event = NULL;
+    // Read the tick count first, it takes the platform critical section of its own
+    uint32_t now = eventOS_event_timer_ticks();
     platform_enter_critical();
-    arm_event_storage_t *event = ns_list_get_first(&event_queue_active);
-    if (event) {
+    if (event_queue_active_map) {
+        // note enum ordering means the lowest set bit is the highest priority
+        uint_fast8_t index = 0;
+        while (!(event_queue_active_map & (1u << index))) {
+            index++;
+        }
+        event = ns_list_get_first(&event_queue_active[index]);
         event->state = ARM_LIB_EVENT_RUNNING;
-        ns_list_remove(&event_queue_active, event);
+        event_queue_remove(event, index);
+
+        uint32_t dwell = now - event->queued_ticks;
+        if (dwell > event_queue_stats[index].max_dwell_ticks) {
+            event_queue_stats[index].max_dwell_ticks = dwell;
+        }
     }
     platform_exit_critical();
     return event;
@@ -221,20 +298,20 @@ static arm_event_storage_t *event_core_read(void)
 
 void event_core_write(arm_event_storage_t *event)
 {
+    // Read the tick count first, it takes the platform critical section of its own
+    uint32_t now = eventOS_event_timer_ticks();
     platform_enter_critical();
-    bool added = false;
-    ns_list_foreach(arm_event_storage_t, event_tmp, &event_queue_active) {
-        // note enum ordering means we're checking if event_tmp is LOWER priority than event
-        if (event_tmp->data.priority > event->data.priority) {
-            ns_list_add_before(&event_queue_active, event_tmp, event);
-            added = true;
-            break;
-        }
-    }
-    if (!added) {
-        ns_list_add_to_end(&event_queue_active, event);
-    }
+    uint_fast8_t index = event_queue_index(event);
+    ns_list_add_to_end(&event_queue_active[index], event);
+    event_queue_active_map |= 1u << index;
     event->state = ARM_LIB_EVENT_QUEUED;
+    event->queued_ticks = now;
+
+    eventOS_scheduler_queue_stats_t *stats = &event_queue_stats[index];
+    stats->enqueued++;
+    if (++stats->depth > stats->max_depth) {
+        stats->max_depth = stats->depth;
+    }
 
     /* Wake From Idle */
     platform_exit_critical();
@@ -244,15 +321,41 @@ void event_core_write(arm_event_storage_t *event)
 // Requires lock to be held
 arm_event_storage_t *eventOS_event_find_by_id_critical(uint8_t tasklet_id, uint8_t event_id)
 {
-    ns_list_foreach(arm_event_storage_t, cur, &event_queue_active) {
-        if (cur->data.receiver == tasklet_id && cur->data.event_id == event_id) {
-            return cur;
+    for (uint_fast8_t index = 0; index < EVENT_PRIORITY_LEVELS; index++) {
+        ns_list_foreach(arm_event_storage_t, cur, &event_queue_active[index]) {
+            if (cur->data.receiver == tasklet_id && cur->data.event_id == event_id) {
+                return cur;
+            }
         }
     }
 
     return NULL;
 }
 
+int8_t eventOS_scheduler_queue_stats_get(arm_library_event_priority_e priority, eventOS_scheduler_queue_stats_t *stats)
+{
+    if ((unsigned) priority >= EVENT_PRIORITY_LEVELS || !stats) {
+        return -1;
+    }
+
+    platform_enter_critical();
+    *stats = event_queue_stats[priority];
+    platform_exit_critical();
+    return 0;
+}
+
+void eventOS_scheduler_queue_stats_reset(void)
+{
+    platform_enter_critical();
+    for (uint_fast8_t index = 0; index < EVENT_PRIORITY_LEVELS; index++) {
+        // Current depth is live state, not a statistic
+        event_queue_stats[index].max_depth = event_queue_stats[index].depth;
+        event_queue_stats[index].max_dwell_ticks = 0;
+        event_queue_stats[index].enqueued = 0;
+    }
+    platform_exit_critical();
+}
+
 /**
  *
  * \brief Initialize Nanostack Core.
@@ -264,14 +367,24 @@ void eventOS_scheduler_init(void)
 {
     /* Reset Event List variables */
     ns_list_init(&free_event_entry);
-    ns_list_init(&event_queue_active);
+    for (uint_fast8_t index = 0; index < EVENT_PRIORITY_LEVELS; index++) {
+        ns_list_init(&event_queue_active[index]);
+    }
+    event_queue_active_map = 0;
+    memset(event_queue_stats, 0, sizeof(event_queue_stats));
     ns_list_init(&arm_core_tasklet_list);
+    tasklet_table = NULL;
+    tasklet_table_size = 0;
+    tasklet_count = 0;
 
     //Add first 10 entries to "free" list
     for (unsigned i = 0; i < (sizeof(startup_event_pool) / sizeof(startup_event_pool[0])); i++) {
         startup_event_pool[i].allocator = ARM_LIB_EVENT_STARTUP_POOL;
         ns_list_add_to_start(&free_event_entry, &startup_event_pool[i]);
     }
+#if EVENT_SLAB_BLOCK_COUNT > 0
+    ns_dyn_mem_slab_add(sizeof(arm_event_storage_t), EVENT_SLAB_BLOCK_COUNT);
+#endif
 
     /* Init Generic timer module */
     timer_sys_init();               //initialize timer
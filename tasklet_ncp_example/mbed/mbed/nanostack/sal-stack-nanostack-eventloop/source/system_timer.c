@@ -15,6 +15,7 @@
  */
 #include "ns_types.h"
 #include "ns_list.h"
+#include "common_functions.h"
 #include "timer_sys.h"
 #include "platform/arm_hal_interrupt.h"
 #include "platform/arm_hal_timer.h"
@@ -32,6 +33,11 @@
 
 static sys_timer_struct_s startup_sys_timer_pool[ST_MAX];
 
+// Timers beyond the startup pool come from a heap slab class
+#ifndef ST_SLAB_BLOCK_COUNT
+#define ST_SLAB_BLOCK_COUNT 16
+#endif
+
 #define TIMER_SLOTS_PER_MS          20
 NS_STATIC_ASSERT(1000 % EVENTOS_EVENT_TIMER_HZ == 0, "Need whole number of ms per tick")
 #define TIMER_SYS_TICK_PERIOD       (1000 / EVENTOS_EVENT_TIMER_HZ) // milliseconds
@@ -40,13 +46,45 @@ NS_STATIC_ASSERT(1000 % EVENTOS_EVENT_TIMER_HZ == 0, "Need whole number of ms pe
 // atomicity on 16-bit platforms
 static volatile uint32_t timer_sys_ticks;
 
+/*
+ * Pending timers are kept in a hierarchical timing wheel. Level 0 has one
+ * slot per tick, and each higher level has one slot per revolution of the
+ * level below it. Insert and cancel touch a single slot; each tick expires
+ * one level 0 slot, and when level 0 wraps the next slot of the level above
+ * is cascaded down into it.
+ */
+#ifndef TIMER_WHEEL_BITS
+#define TIMER_WHEEL_BITS            6
+#endif
+NS_STATIC_ASSERT(TIMER_WHEEL_BITS >= 5 && TIMER_WHEEL_BITS <= 8, "Timer wheel levels must have 32-256 slots")
+#define TIMER_WHEEL_SLOTS           (1u << TIMER_WHEEL_BITS)
+#define TIMER_WHEEL_MASK            (TIMER_WHEEL_SLOTS - 1)
+#define TIMER_WHEEL_LEVELS          ((32 + TIMER_WHEEL_BITS - 1) / TIMER_WHEEL_BITS)
+
+#ifndef TIMER_ID_HASH_SIZE
+#define TIMER_ID_HASH_SIZE          16
+#endif
+NS_STATIC_ASSERT((TIMER_ID_HASH_SIZE & (TIMER_ID_HASH_SIZE - 1)) == 0, "Timer id hash size must be a power of 2")
+
+typedef NS_LIST_HEAD(sys_timer_struct_s, event.link) sys_timer_list_t;
+typedef NS_LIST_HEAD(sys_timer_struct_s, id_link) sys_timer_id_list_t;
+
 static NS_LIST_DEFINE(system_timer_free, sys_timer_struct_s, event.link);
-static NS_LIST_DEFINE(system_timer_list, sys_timer_struct_s, event.link);
+static sys_timer_list_t timer_wheel[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+// Occupancy bitmap of each level, so empty slots can be skipped a word at a time
+static uint32_t timer_wheel_map[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS / 32];
+// Pending timers indexed by (receiver, event_id) for eventOS_event_timer_cancel()
+static sys_timer_id_list_t timer_id_hash[TIMER_ID_HASH_SIZE];
+// Next tick to be processed by the wheel. Always timer_sys_ticks + 1 outside
+// system_timer_tick_update(), so every timer on the wheel is in the future.
+static uint32_t timer_wheel_clk = 1;
+static uint32_t timer_wheel_count;
 
 
 static sys_timer_struct_s *sys_timer_dynamically_allocate(void);
 static void timer_sys_interrupt(void);
 static void timer_sys_add(sys_timer_struct_s *timer);
+static void timer_sys_remove(sys_timer_struct_s *timer);
 
 #ifndef NS_EVENTLOOP_USE_TICK_TIMER
 static int8_t platform_tick_timer_start(uint32_t period_ms);
@@ -93,6 +131,18 @@ void timer_sys_init(void)
     for (uint8_t i = 0; i < ST_MAX; i++) {
         ns_list_add_to_start(&system_timer_free, &startup_sys_timer_pool[i]);
     }
+#if ST_SLAB_BLOCK_COUNT > 0
+    ns_dyn_mem_slab_add(sizeof(sys_timer_struct_s), ST_SLAB_BLOCK_COUNT);
+#endif
+
+    for (uint_fast8_t level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+        for (uint_fast16_t slot = 0; slot < TIMER_WHEEL_SLOTS; slot++) {
+            ns_list_init(&timer_wheel[level][slot]);
+        }
+    }
+    for (uint_fast8_t i = 0; i < TIMER_ID_HASH_SIZE; i++) {
+        ns_list_init(&timer_id_hash[i]);
+    }
 
     platform_tick_timer_register(timer_sys_interrupt);
     platform_tick_timer_start(TIMER_SYS_TICK_PERIOD);
@@ -168,9 +218,9 @@ void timer_sys_event_cancel_critical(struct arm_event_storage *event)
 {
     sys_timer_struct_s *timer = NS_CONTAINER_OF(event, sys_timer_struct_s, event);
     timer->period = 0;
-    // If its unqueued it is on my timer list, otherwise it is in event-loop.
+    // If its unqueued it is on my timer wheel, otherwise it is in event-loop.
     if (event->state == ARM_LIB_EVENT_UNQUEUED) {
-        ns_list_remove(&system_timer_list, timer);
+        timer_sys_remove(timer);
     }
 }
 
@@ -185,22 +235,140 @@ uint32_t eventOS_event_timer_ticks(void)
     return ret_val;
 }
 
+static sys_timer_id_list_t *timer_id_bucket(int8_t receiver, uint8_t event_id)
+{
+    return &timer_id_hash[((uint8_t) receiver * 31u + event_id) & (TIMER_ID_HASH_SIZE - 1)];
+}
+
+/* Called internally with lock held */
+static void timer_wheel_slot_add(sys_timer_struct_s *timer)
+{
+    uint32_t delta = timer->launch_time - timer_wheel_clk;
+    uint_fast8_t level = 0;
+
+    // Lowest level whose span covers the delay
+    while (level < TIMER_WHEEL_LEVELS - 1 && (delta >> ((level + 1) * TIMER_WHEEL_BITS))) {
+        level++;
+    }
+
+    uint_fast16_t slot = (timer->launch_time >> (level * TIMER_WHEEL_BITS)) & TIMER_WHEEL_MASK;
+    timer->wheel_slot = level * TIMER_WHEEL_SLOTS + slot;
+    ns_list_add_to_end(&timer_wheel[level][slot], timer);
+    timer_wheel_map[level][slot / 32] |= UINT32_C(1) << (slot % 32);
+}
+
+/* Called internally with lock held */
+static void timer_wheel_slot_remove(sys_timer_struct_s *timer)
+{
+    uint_fast8_t level = timer->wheel_slot / TIMER_WHEEL_SLOTS;
+    uint_fast16_t slot = timer->wheel_slot % TIMER_WHEEL_SLOTS;
+    sys_timer_list_t *list = &timer_wheel[level][slot];
+
+    ns_list_remove(list, timer);
+    if (ns_list_is_empty(list)) {
+        timer_wheel_map[level][slot / 32] &= ~(UINT32_C(1) << (slot % 32));
+    }
+}
+
 /* Called internally with lock held */
 static void timer_sys_add(sys_timer_struct_s *timer)
 {
-    uint32_t at = timer->launch_time;
-
-    // Find first timer scheduled to run after us, and insert before it.
-    // (This means timers scheduled for same time run in order of request)
-    ns_list_foreach(sys_timer_struct_s, t, &system_timer_list) {
-        if (TICKS_BEFORE(at, t->launch_time)) {
-            ns_list_add_before(&system_timer_list, t, timer);
-            return;
+    sys_timer_id_list_t *bucket = timer_id_bucket(timer->event.data.receiver, timer->event.data.event_id);
+
+    timer_wheel_slot_add(timer);
+    ns_list_add_to_end(bucket, timer);
+    timer_wheel_count++;
+}
+
+/* Called internally with lock held */
+static void timer_sys_remove(sys_timer_struct_s *timer)
+{
+    sys_timer_id_list_t *bucket = timer_id_bucket(timer->event.data.receiver, timer->event.data.event_id);
+
+    timer_wheel_slot_remove(timer);
+    ns_list_remove(bucket, timer);
+    timer_wheel_count--;
+}
+
+/* Called internally with lock held.
+ * Returns the distance from start to the next occupied slot of a level,
+ * wrapping round, or -1 if the level is empty.
+ */
+static int_fast16_t timer_wheel_next_slot(uint_fast8_t level, uint_fast16_t start)
+{
+    uint_fast16_t offset = 0;
+
+    while (offset < TIMER_WHEEL_SLOTS) {
+        uint_fast16_t slot = (start + offset) & TIMER_WHEEL_MASK;
+        uint32_t bits = timer_wheel_map[level][slot / 32] >> (slot % 32);
+        if (bits) {
+            // Count trailing zeros via the lowest set bit
+            return offset + 31 - common_count_leading_zeros_32(bits & -bits);
         }
+        offset += 32 - (slot % 32);
     }
 
-    // Didn't insert before another timer, so must be last.
-    ns_list_add_to_end(&system_timer_list, timer);
+    return -1;
+}
+
+/* Called internally with lock held.
+ * Moves the timers from the current slot of a higher level down the wheel,
+ * returning the slot index so the caller knows whether this level wrapped.
+ * Once cascaded, the current slot of a higher level can only hold timers
+ * a full revolution of that level ahead.
+ */
+static uint_fast16_t timer_wheel_cascade(uint_fast8_t level)
+{
+    uint_fast16_t slot = (timer_wheel_clk >> (level * TIMER_WHEEL_BITS)) & TIMER_WHEEL_MASK;
+    sys_timer_list_t *list = &timer_wheel[level][slot];
+
+    ns_list_foreach_safe(sys_timer_struct_s, cur, list) {
+        ns_list_remove(list, cur);
+        timer_wheel_slot_add(cur);
+    }
+    timer_wheel_map[level][slot / 32] &= ~(UINT32_C(1) << (slot % 32));
+
+    return slot;
+}
+
+/* Called internally with lock held.
+ * Returns ticks from timer_wheel_clk to the earliest pending timer; the wheel must not be empty.
+ */
+static uint32_t timer_wheel_next_expiry(void)
+{
+    uint32_t best = UINT32_MAX;
+
+    for (uint_fast8_t level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+        uint_fast8_t shift = level * TIMER_WHEEL_BITS;
+        uint_fast16_t slot = (timer_wheel_clk >> shift) & TIMER_WHEEL_MASK;
+        if (level == 0) {
+            // Everything in a level 0 slot expires on that exact tick
+            int_fast16_t offset = timer_wheel_next_slot(0, slot);
+            if (offset >= 0) {
+                best = offset;
+            }
+            continue;
+        }
+        // Higher levels have already cascaded their current slot, so search
+        // from the next one round to the current one a revolution later.
+        int_fast16_t offset = timer_wheel_next_slot(level, (slot + 1) & TIMER_WHEEL_MASK);
+        if (offset < 0) {
+            continue;
+        }
+        // Nothing in a higher level slot can expire before the start of its span
+        uint32_t earliest = (((timer_wheel_clk >> shift) + 1 + offset) << shift) - timer_wheel_clk;
+        if (earliest >= best) {
+            continue;
+        }
+        ns_list_foreach(sys_timer_struct_s, cur, &timer_wheel[level][(slot + 1 + offset) & TIMER_WHEEL_MASK]) {
+            uint32_t delta = cur->launch_time - timer_wheel_clk;
+            if (delta < best) {
+                best = delta;
+            }
+        }
+    }
+
+    return best;
 }
 
 /* Called internally with lock held */
@@ -306,13 +474,18 @@ int8_t eventOS_event_timer_cancel(uint8_t event_id, int8_t tasklet_id)
 {
     platform_enter_critical();
 
-    /* First check pending timers */
-    ns_list_foreach(sys_timer_struct_s, cur, &system_timer_list) {
-        if (cur->event.data.receiver == tasklet_id && cur->event.data.event_id == event_id) {
-            eventOS_cancel(&cur->event);
-            goto done;
+    /* First check pending timers - cancel the one due soonest */
+    sys_timer_struct_s *timer = NULL;
+    ns_list_foreach(sys_timer_struct_s, cur, timer_id_bucket(tasklet_id, event_id)) {
+        if (cur->event.data.receiver == tasklet_id && cur->event.data.event_id == event_id &&
+                (!timer || TICKS_BEFORE(cur->launch_time, timer->launch_time))) {
+            timer = cur;
         }
     }
+    if (timer) {
+        eventOS_cancel(&timer->event);
+        goto done;
+    }
 
     /* No pending timer, so check for already-pending event */
     arm_event_storage_t *event = eventOS_event_find_by_id_critical(tasklet_id, event_id);
@@ -335,15 +508,13 @@ uint32_t eventOS_event_timer_shortest_active_timer(void)
     uint32_t ret_val = 0;
 
     platform_enter_critical();
-    sys_timer_struct_s *first = ns_list_get_first(&system_timer_list);
-    if (first == NULL) {
+    if (timer_wheel_count == 0) {
         // Weird API has 0 for "no events"
         ret_val = 0;
-    } else if (TICKS_BEFORE_OR_AT(first->launch_time, timer_sys_ticks)) {
-        // Which means an immediate/overdue event has to be 1
-        ret_val = 1;
     } else {
-        ret_val = first->launch_time - timer_sys_ticks;
+        // Wheel only holds future timers, and timer_wheel_clk is one tick
+        // ahead, so this is at least 1 - as an immediate event has to be.
+        ret_val = timer_wheel_next_expiry() + 1;
     }
 
     platform_exit_critical();
@@ -355,18 +526,38 @@ void system_timer_tick_update(uint32_t ticks)
     platform_enter_critical();
     //Keep runtime time
     timer_sys_ticks += ticks;
-    ns_list_foreach_safe(sys_timer_struct_s, cur, &system_timer_list) {
-        if (TICKS_BEFORE_OR_AT(cur->launch_time, timer_sys_ticks)) {
-            // Unthread from our list
-            ns_list_remove(&system_timer_list, cur);
+    while (timer_wheel_count && TICKS_BEFORE_OR_AT(timer_wheel_clk, timer_sys_ticks)) {
+        uint_fast16_t slot = timer_wheel_clk & TIMER_WHEEL_MASK;
+        ns_list_foreach_safe(sys_timer_struct_s, cur, &timer_wheel[0][slot]) {
+            // Unthread from our wheel
+            timer_sys_remove(cur);
             // Make it an event (can't fail - no allocation)
             // event system will call our timer_sys_event_free on event delivery.
             eventOS_event_send_timer_allocated(&cur->event);
+        }
+
+        // Skip empty slots on a multi-tick update, but stop at the
+        // level 0 wrap so the next cascade is not missed.
+        uint32_t step = TIMER_WHEEL_SLOTS - slot;
+        int_fast16_t offset = timer_wheel_next_slot(0, (slot + 1) & TIMER_WHEEL_MASK);
+        if (offset >= 0 && slot + 1 + offset < TIMER_WHEEL_SLOTS) {
+            step = 1 + offset;
+        }
+        if (TICKS_BEFORE(timer_sys_ticks + 1, timer_wheel_clk + step)) {
+            timer_wheel_clk = timer_sys_ticks + 1;
         } else {
-            // List is ordered, so as soon as we see a later event, we're done.
-            break;
+            timer_wheel_clk += step;
+        }
+
+        if ((timer_wheel_clk & TIMER_WHEEL_MASK) == 0) {
+            // Level 0 wrapped - refill it from level 1, and so on up while levels wrap
+            for (uint_fast8_t level = 1; level < TIMER_WHEEL_LEVELS && timer_wheel_cascade(level) == 0; level++);
         }
     }
+    if (timer_wheel_count == 0) {
+        // Nothing to cascade or expire - catch straight up
+        timer_wheel_clk = timer_sys_ticks + 1;
+    }
 
     platform_exit_critical();
 }
@@ -27,6 +27,8 @@ typedef struct sys_timer_struct_s {
     arm_event_storage_t event;
     uint32_t launch_time; // tick value
     uint32_t period;
+    ns_list_link_t id_link; // (receiver, event_id) lookup chain while pending
+    uint16_t wheel_slot; // level * slots-per-level + slot index while pending
 } sys_timer_struct_s;
 
 
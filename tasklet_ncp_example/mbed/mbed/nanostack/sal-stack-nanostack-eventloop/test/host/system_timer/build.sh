@@ -0,0 +1,58 @@
+#!/bin/sh
+#
+# Builds and runs the host test and benchmark of the system timer wheel.
+#
+#   build.sh [git revision]
+#
+# With a git revision, the benchmark is also built against the event loop
+# and nsdynmemLIB of that revision, e.g. the list-based timers before the
+# wheel. Set CC and OUT to change the compiler and the build directory.
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+EVENTLOOP=$(cd "$HERE/../../.." && pwd)
+MBED=$(cd "$EVENTLOOP/../.." && pwd)
+PLATFORM=$(cd "$MBED/../../ti_wisunfan/ti_wisunfan/mbed_port/mbednanostack2tirtos/platform" && pwd)
+OUT=${OUT:-${TMPDIR:-/tmp}/system_timer_test}
+CC=${CC:-cc}
+
+# Sources and include paths of an event loop and libservice tree
+tree_flags()
+{
+    LIBSERVICE=$2/frameworks/nanostack-libservice
+    INC="-I$1/nanostack-event-loop -I$1/nanostack-event-loop/platform -I$1/source -I$1
+         -I$LIBSERVICE/mbed-client-libservice -I$LIBSERVICE/mbed-client-libservice/platform -I$PLATFORM"
+    SRC="$1/source/event.c $LIBSERVICE/source/libList/ns_list.c $LIBSERVICE/source/libBits/common_functions.c
+         $LIBSERVICE/source/nsdynmemLIB/nsdynmemLIB.c"
+}
+
+mkdir -p "$OUT"
+tree_flags "$EVENTLOOP" "$MBED"
+
+# nsdynmemLIB only aligns blocks to 4 bytes, which is enough for the 32-bit targets
+$CC -std=gnu99 -O1 -g -fsanitize=address,undefined -fno-sanitize=alignment $INC -o "$OUT/system_timer_test" \
+    "$HERE/system_timer_test.c" "$HERE/host_stubs.c" $SRC
+for start in 0 0x7fffff00 0xffff0000; do
+    "$OUT/system_timer_test" $start
+done
+
+$CC -std=gnu99 -O2 $INC -o "$OUT/system_timer_bench" \
+    "$HERE/system_timer_bench.c" "$HERE/host_stubs.c" "$EVENTLOOP/source/system_timer.c" $SRC
+printf "this tree: "
+"$OUT/system_timer_bench"
+
+if [ -n "$1" ]; then
+    TOP=$(git -C "$HERE" rev-parse --show-toplevel)
+    BASE=$OUT/$1
+    rm -rf "$BASE"
+    mkdir -p "$BASE"
+    git -C "$TOP" archive "$1" "$(git -C "$EVENTLOOP" rev-parse --show-prefix)" \
+        "$(git -C "$MBED/frameworks/nanostack-libservice" rev-parse --show-prefix)" | tar -x -C "$BASE"
+    BASE_MBED=$BASE/$(git -C "$MBED" rev-parse --show-prefix)
+    tree_flags "$BASE_MBED/nanostack/sal-stack-nanostack-eventloop" "$BASE_MBED"
+    $CC -std=gnu99 -O2 $INC -o "$OUT/system_timer_bench_$1" \
+        "$HERE/system_timer_bench.c" "$HERE/host_stubs.c" "$BASE_MBED/nanostack/sal-stack-nanostack-eventloop/source/system_timer.c" $SRC
+    printf "%s: " "$1"
+    "$OUT/system_timer_bench_$1"
+fi
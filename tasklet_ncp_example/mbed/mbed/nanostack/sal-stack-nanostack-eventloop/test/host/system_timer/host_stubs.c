@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Platform hooks for running the event loop on a host, single threaded.
+ *
+ * The critical section keeps count of how deep it is nested, so that tests
+ * can check the event core does not nest it.
+ */
+
+#include <stdarg.h>
+#include <stdint.h>
+#include "ns_types.h"
+
+int host_critical_depth;
+int host_critical_depth_max;
+
+void platform_enter_critical(void)
+{
+    if (++host_critical_depth > host_critical_depth_max) {
+        host_critical_depth_max = host_critical_depth;
+    }
+}
+
+void platform_exit_critical(void)
+{
+    host_critical_depth--;
+}
+
+int8_t eventOS_callback_timer_register(void (*timer_interrupt_handler)(int8_t, uint16_t))
+{
+    (void) timer_interrupt_handler;
+    return 0;
+}
+
+int8_t eventOS_callback_timer_start(int8_t ns_timer_id, uint16_t slots)
+{
+    (void) ns_timer_id;
+    (void) slots;
+    return 0;
+}
+
+int8_t eventOS_callback_timer_stop(int8_t ns_timer_id)
+{
+    (void) ns_timer_id;
+    return 0;
+}
+
+void eventOS_scheduler_signal(void)
+{
+}
+
+void eventOS_scheduler_idle(void)
+{
+}
+
+int ns_timer_sleep(void)
+{
+    return 0;
+}
+
+void ns_trace_printf(uint8_t dlevel, const char *grp, const char *fmt, ...)
+{
+    (void) dlevel;
+    (void) grp;
+    (void) fmt;
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Cost of starting and cancelling a system timer with many timers pending.
+ *
+ * Schedules 10000 timers with random 1-60000 tick delays, then cancels
+ * them all, five times over. Only uses the public API, so it also builds
+ * against older versions of system_timer.c (see build.sh).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "nsdynmemLIB.h"
+#include "eventOS_event.h"
+#include "eventOS_event_timer.h"
+#include "eventOS_scheduler.h"
+
+#define BENCH_TIMERS 10000
+#define BENCH_ROUNDS 5
+
+static char bench_heap[2 * 1024 * 1024];
+static arm_event_storage_t *bench_timer[BENCH_TIMERS];
+
+static void bench_handler(arm_event_t *event)
+{
+    (void) event;
+}
+
+int main(void)
+{
+    struct timespec begin, end;
+
+    ns_dyn_mem_init(bench_heap, sizeof(bench_heap), NULL, NULL);
+    eventOS_scheduler_init();
+    int8_t tasklet = eventOS_event_handler_create(bench_handler, 0);
+    eventOS_scheduler_run_until_idle();
+    srand(1);
+
+    clock_gettime(CLOCK_MONOTONIC, &begin);
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        for (int i = 0; i < BENCH_TIMERS; i++) {
+            arm_event_t event = {.receiver = tasklet, .event_type = 1, .event_id = i};
+            bench_timer[i] = eventOS_event_timer_request_in(&event, 1 + rand() % 60000);
+        }
+        for (int i = 0; i < BENCH_TIMERS; i++) {
+            eventOS_cancel(bench_timer[i]);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double ns = (end.tv_sec - begin.tv_sec) * 1e9 + (end.tv_nsec - begin.tv_nsec);
+    printf("%.1f ns per schedule+cancel with %d timers\n", ns / (BENCH_ROUNDS * BENCH_TIMERS), BENCH_TIMERS);
+    return 0;
+}
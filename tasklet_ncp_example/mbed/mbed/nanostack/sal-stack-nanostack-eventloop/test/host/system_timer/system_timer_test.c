@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Randomised test of the system timer wheel.
+ *
+ * Timers with delays from one tick to 2^30 ticks are started, cancelled
+ * and left to fire while the tick count moves forward by single ticks and
+ * by large jumps. Every timer must fire on its exact tick, cancelled
+ * timers must never fire, and eventOS_event_timer_shortest_active_timer()
+ * must match a brute force search. The wheel invariants are checked after
+ * every change.
+ *
+ * Usage: system_timer_test [start tick] [rounds]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* The wheel is static in system_timer.c */
+#include "../../../source/system_timer.c"
+
+#include "eventOS_scheduler.h"
+
+#define TEST_TIMERS 2000
+
+static char test_heap[1024 * 1024];
+static uint32_t test_now;
+static uint32_t test_due[TEST_TIMERS];
+static bool test_alive[TEST_TIMERS];
+static arm_event_storage_t *test_timer[TEST_TIMERS];
+
+static void test_fail(const char *what, int round)
+{
+    printf("FAIL: %s in round %d, now %u\n", what, round, (unsigned) test_now);
+    exit(1);
+}
+
+/* Every timer sits on the lowest level that can hold its distance from the wheel clock */
+static bool test_wheel_valid(void)
+{
+    for (uint_fast8_t level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+        for (uint_fast16_t slot = 0; slot < TIMER_WHEEL_SLOTS; slot++) {
+            ns_list_foreach(sys_timer_struct_s, cur, &timer_wheel[level][slot]) {
+                uint32_t distance = cur->launch_time - timer_wheel_clk;
+                uint_fast8_t lowest = 0;
+                while (lowest < TIMER_WHEEL_LEVELS - 1 && (distance >> ((lowest + 1) * TIMER_WHEEL_BITS))) {
+                    lowest++;
+                }
+                if ((int32_t) distance < 0 || lowest > level) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+static void test_handler(arm_event_t *event)
+{
+    if (event->event_type == 0) {
+        return;
+    }
+    int i = event->event_data;
+    if (!test_alive[i]) {
+        test_fail("cancelled timer fired", -1);
+    }
+    if (eventOS_event_timer_ticks() != test_due[i]) {
+        test_fail("timer fired on the wrong tick", -1);
+    }
+    test_alive[i] = false;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t start = argc > 1 ? strtoul(argv[1], NULL, 0) : 0;
+    int rounds = argc > 2 ? atoi(argv[2]) : 600000;
+
+    ns_dyn_mem_init(test_heap, sizeof(test_heap), NULL, NULL);
+    eventOS_scheduler_init();
+    int8_t tasklet = eventOS_event_handler_create(test_handler, 0);
+    eventOS_scheduler_run_until_idle();
+
+    srand(1);
+    system_timer_tick_update(start);
+    test_now = start;
+
+    for (int round = 0; round < rounds; round++) {
+        int i = rand() % TEST_TIMERS;
+        int op = rand() % 4;
+
+        if (op < 2 && !test_alive[i]) {
+            uint32_t delay;
+            if (rand() % 4 == 0) {
+                delay = (uint32_t) rand() % (rand() % 2 ? 300000u : 0x3fffffffu) + 1;
+            } else {
+                delay = rand() % 500 + 1;
+            }
+            arm_event_t event = {
+                .receiver = tasklet,
+                .event_type = 1,
+                .event_id = i & 255,
+                .event_data = i,
+                .priority = ARM_LIB_MED_PRIORITY_EVENT,
+            };
+            test_timer[i] = eventOS_event_timer_request_in(&event, delay);
+            if (!test_timer[i]) {
+                test_fail("timer allocation failed", round);
+            }
+            test_due[i] = test_now + delay;
+            test_alive[i] = true;
+            if (!test_wheel_valid()) {
+                test_fail("wheel invalid after add", round);
+            }
+        } else if (op == 2 && test_alive[i]) {
+            eventOS_cancel(test_timer[i]);
+            test_alive[i] = false;
+        } else {
+            uint32_t shortest = UINT32_MAX;
+            for (int k = 0; k < TEST_TIMERS; k++) {
+                if (test_alive[k] && test_due[k] - test_now < shortest) {
+                    shortest = test_due[k] - test_now;
+                }
+            }
+            uint32_t expected = shortest == UINT32_MAX ? 0 : eventOS_event_timer_ticks_to_ms(shortest);
+            if (eventOS_event_timer_shortest_active_timer() != expected) {
+                test_fail("wrong shortest active timer", round);
+            }
+
+            uint32_t advance = rand() % 10 == 0 ? rand() % 5000 : (rand() % 50 == 0 ? (uint32_t) rand() : 1);
+            if (shortest != UINT32_MAX && advance > shortest) {
+                // Stop on the tick the next timer is due, so it can be checked
+                advance = shortest;
+            }
+            system_timer_tick_update(advance);
+            test_now += advance;
+            if (!test_wheel_valid()) {
+                test_fail("wheel invalid after tick update", round);
+            }
+            eventOS_scheduler_run_until_idle();
+        }
+    }
+
+    int pending = 0;
+    for (int k = 0; k < TEST_TIMERS; k++) {
+        pending += test_alive[k];
+    }
+    printf("OK: start %u, %d rounds, %d timers pending\n", (unsigned) start, rounds, pending);
+    return 0;
+}
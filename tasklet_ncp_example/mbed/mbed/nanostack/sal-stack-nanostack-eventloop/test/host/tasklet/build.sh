@@ -0,0 +1,67 @@
+#!/bin/sh
+#
+# Builds and runs the host tests of the tasklet table and the event queues,
+# and the benchmark of the tasklet table.
+#
+#   build.sh [git revision]
+#
+# With a git revision, the benchmark is also built against the event loop
+# and nsdynmemLIB of that revision, e.g. the tasklet list walk before the
+# table. The platform hooks are shared with the system timer test. Set CC and OUT to change the compiler and the build directory.
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+EVENTLOOP=$(cd "$HERE/../../.." && pwd)
+MBED=$(cd "$EVENTLOOP/../.." && pwd)
+PLATFORM=$(cd "$MBED/../../ti_wisunfan/ti_wisunfan/mbed_port/mbednanostack2tirtos/platform" && pwd)
+OUT=${OUT:-${TMPDIR:-/tmp}/tasklet_test}
+CC=${CC:-cc}
+
+# Sources and include paths of an event loop and libservice tree
+tree_flags()
+{
+    LIBSERVICE=$2/frameworks/nanostack-libservice
+    INC="-I$1/nanostack-event-loop -I$1/nanostack-event-loop/platform -I$1/source -I$1
+         -I$LIBSERVICE/mbed-client-libservice -I$LIBSERVICE/mbed-client-libservice/platform -I$PLATFORM"
+    SRC="$1/source/event.c $LIBSERVICE/source/libList/ns_list.c $LIBSERVICE/source/libBits/common_functions.c
+         $LIBSERVICE/source/nsdynmemLIB/nsdynmemLIB.c"
+}
+
+mkdir -p "$OUT"
+tree_flags "$EVENTLOOP" "$MBED"
+
+STUBS=$HERE/../system_timer/host_stubs.c
+TIMER=$EVENTLOOP/source/system_timer.c
+
+# nsdynmemLIB only aligns blocks to 4 bytes, which is enough for the 32-bit targets
+$CC -std=gnu99 -O1 -g -fsanitize=address,undefined -fno-sanitize=alignment $INC -o "$OUT/tasklet_test" \
+    "$HERE/tasklet_test.c" "$STUBS" "$TIMER" $SRC
+for seed in 1 2 3; do
+    "$OUT/tasklet_test" $seed
+done
+
+$CC -std=gnu99 -O1 -g -fsanitize=address,undefined -fno-sanitize=alignment $INC -o "$OUT/event_queue_test" \
+    "$HERE/event_queue_test.c" "$STUBS" "$TIMER" $SRC
+for seed in 1 2 3; do
+    "$OUT/event_queue_test" $seed
+done
+
+$CC -std=gnu99 -O2 $INC -o "$OUT/tasklet_bench" "$HERE/tasklet_bench.c" "$STUBS" "$TIMER" $SRC
+printf "this tree: "
+"$OUT/tasklet_bench"
+
+if [ -n "$1" ]; then
+    TOP=$(git -C "$HERE" rev-parse --show-toplevel)
+    BASE=$OUT/$1
+    rm -rf "$BASE"
+    mkdir -p "$BASE"
+    git -C "$TOP" archive "$1" "$(git -C "$EVENTLOOP" rev-parse --show-prefix)" \
+        "$(git -C "$MBED/frameworks/nanostack-libservice" rev-parse --show-prefix)" | tar -x -C "$BASE"
+    BASE_MBED=$BASE/$(git -C "$MBED" rev-parse --show-prefix)
+    tree_flags "$BASE_MBED/nanostack/sal-stack-nanostack-eventloop" "$BASE_MBED"
+    $CC -std=gnu99 -O2 $INC -o "$OUT/tasklet_bench_$1" \
+        "$HERE/tasklet_bench.c" "$STUBS" "$BASE_MBED/nanostack/sal-stack-nanostack-eventloop/source/system_timer.c" $SRC
+    printf "%s: " "$1"
+    "$OUT/tasklet_bench_$1"
+fi
@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Randomised test of the per-priority event queues and their statistics.
+ *
+ * Events of every priority, and of priorities outside the enum, are sent
+ * and dispatched at random while the tick count moves on. User allocated
+ * events are also sent and some of them cancelled before dispatch. Each
+ * dispatch must take the oldest event of the highest priority that has
+ * one, as a model of one FIFO per priority predicts. After every step
+ * eventOS_scheduler_queue_stats_get() must match the depth, peak depth,
+ * events queued and longest dwell of the model, also across resets.
+ * Queueing and dispatching must never nest the platform critical section.
+ * Sends of user allocated events check this; other sends may fall back to
+ * the heap, and cancels free events, both inside it by design.
+ *
+ * Usage: event_queue_test [seed] [rounds]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "nsdynmemLIB.h"
+#include "eventOS_event.h"
+#include "eventOS_scheduler.h"
+#include "timer_sys.h"
+
+#define TEST_LEVELS 3
+#define TEST_EVENTS 64
+#define TEST_USER_EVENTS 16
+
+typedef struct test_event {
+    int seq;
+    uint32_t queued;
+    int user;
+} test_event_t;
+
+extern int host_critical_depth_max;
+
+static char test_heap[64 * 1024];
+static uint32_t test_now;
+static int test_dispatched;
+static test_event_t test_queue[TEST_LEVELS][TEST_EVENTS];
+static int test_queue_len[TEST_LEVELS];
+static eventOS_scheduler_queue_stats_t test_stats[TEST_LEVELS];
+static arm_event_storage_t test_user[TEST_USER_EVENTS];
+static int test_user_level[TEST_USER_EVENTS];   /* Level it is queued at, -1 when free */
+
+static void test_fail(const char *what, int round)
+{
+    printf("FAIL: %s in round %d\n", what, round);
+    exit(1);
+}
+
+static void test_nesting_check(int round)
+{
+    if (host_critical_depth_max > 1) {
+        test_fail("platform critical section nested", round);
+    }
+}
+
+static void test_handler(arm_event_t *event)
+{
+    if (event->event_type == 1) {
+        test_dispatched = event->event_data;
+    }
+}
+
+static void test_model_remove(int level, int index)
+{
+    for (int i = index; i < test_queue_len[level] - 1; i++) {
+        test_queue[level][i] = test_queue[level][i + 1];
+    }
+    test_queue_len[level]--;
+    test_stats[level].depth--;
+}
+
+static void test_send(int8_t tasklet, int seq, int round)
+{
+    int level = rand() % (TEST_LEVELS + 1);
+    /* Priorities outside the enum are queued at the lowest level */
+    arm_library_event_priority_e priority = level < TEST_LEVELS ? (arm_library_event_priority_e) level
+                                            : (arm_library_event_priority_e)(TEST_LEVELS + rand() % 100);
+    int user = -1;
+
+    if (level == TEST_LEVELS) {
+        level = TEST_LEVELS - 1;
+    }
+    if (test_queue_len[level] == TEST_EVENTS) {
+        return;
+    }
+
+    if (rand() % 4 == 0) {
+        for (int i = 0; i < TEST_USER_EVENTS && user < 0; i++) {
+            if (test_user_level[i] < 0) {
+                user = i;
+            }
+        }
+    }
+
+    arm_event_t event = {
+        .receiver = tasklet,
+        .event_type = 1,
+        .event_data = seq,
+        .priority = priority,
+    };
+    if (user >= 0) {
+        test_user[user].data = event;
+        test_user_level[user] = level;
+        host_critical_depth_max = 0;
+        eventOS_event_send_user_allocated(&test_user[user]);
+        test_nesting_check(round);
+    } else if (eventOS_event_send(&event) != 0) {
+        test_fail("event not sent", round);
+    }
+
+    test_queue[level][test_queue_len[level]++] = (test_event_t) {
+        .seq = seq, .queued = test_now, .user = user
+    };
+    test_stats[level].enqueued++;
+    if (++test_stats[level].depth > test_stats[level].max_depth) {
+        test_stats[level].max_depth = test_stats[level].depth;
+    }
+}
+
+static void test_dispatch(int round)
+{
+    int level = 0;
+
+    while (level < TEST_LEVELS && !test_queue_len[level]) {
+        level++;
+    }
+    test_dispatched = -1;
+    host_critical_depth_max = 0;
+    if (eventOS_scheduler_dispatch_event() != (level < TEST_LEVELS)) {
+        test_fail("dispatch with the queues in the wrong state", round);
+    }
+    test_nesting_check(round);
+    if (level == TEST_LEVELS) {
+        return;
+    }
+
+    test_event_t expected = test_queue[level][0];
+    if (test_dispatched != expected.seq) {
+        test_fail("event dispatched out of order", round);
+    }
+    if (expected.user >= 0) {
+        test_user_level[expected.user] = -1;
+    }
+    if (test_now - expected.queued > test_stats[level].max_dwell_ticks) {
+        test_stats[level].max_dwell_ticks = test_now - expected.queued;
+    }
+    test_model_remove(level, 0);
+}
+
+static void test_cancel(int round)
+{
+    int user = rand() % TEST_USER_EVENTS;
+    int level = test_user_level[user];
+
+    if (level < 0) {
+        return;
+    }
+    eventOS_cancel(&test_user[user]);
+    test_user_level[user] = -1;
+    for (int i = 0; i < test_queue_len[level]; i++) {
+        if (test_queue[level][i].user == user) {
+            test_model_remove(level, i);
+            return;
+        }
+    }
+    test_fail("cancelled event not in the model", round);
+}
+
+static void test_stats_check(int round)
+{
+    eventOS_scheduler_queue_stats_t stats;
+
+    for (int level = 0; level < TEST_LEVELS; level++) {
+        if (eventOS_scheduler_queue_stats_get((arm_library_event_priority_e) level, &stats) != 0) {
+            test_fail("stats not read", round);
+        }
+        if (stats.depth != test_stats[level].depth || stats.max_depth != test_stats[level].max_depth ||
+                stats.enqueued != test_stats[level].enqueued ||
+                stats.max_dwell_ticks != test_stats[level].max_dwell_ticks) {
+            test_fail("stats differ from the model", round);
+        }
+    }
+    if (eventOS_scheduler_queue_stats_get((arm_library_event_priority_e) TEST_LEVELS, &stats) != -1 ||
+            eventOS_scheduler_queue_stats_get(ARM_LIB_HIGH_PRIORITY_EVENT, NULL) != -1) {
+        test_fail("stats read with invalid parameters", round);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned seed = argc > 1 ? strtoul(argv[1], NULL, 0) : 1;
+    int rounds = argc > 2 ? atoi(argv[2]) : 200000;
+
+    ns_dyn_mem_init(test_heap, sizeof(test_heap), NULL, NULL);
+    eventOS_scheduler_init();
+    int8_t tasklet = eventOS_event_handler_create(test_handler, 0);
+    eventOS_scheduler_run_until_idle();
+    eventOS_scheduler_queue_stats_reset();
+    for (int i = 0; i < TEST_USER_EVENTS; i++) {
+        test_user_level[i] = -1;
+    }
+
+    srand(seed);
+    for (int round = 0; round < rounds; round++) {
+        int op = rand() % 16;
+
+        if (op < 7) {
+            test_send(tasklet, round, round);
+        } else if (op < 14) {
+            test_dispatch(round);
+        } else if (op == 14) {
+            test_cancel(round);
+        } else if (rand() % 8 == 0) {
+            eventOS_scheduler_queue_stats_reset();
+            for (int level = 0; level < TEST_LEVELS; level++) {
+                test_stats[level].max_depth = test_stats[level].depth;
+                test_stats[level].max_dwell_ticks = 0;
+                test_stats[level].enqueued = 0;
+            }
+        } else {
+            uint32_t ticks = rand() % 5;
+            system_timer_tick_update(ticks);
+            test_now += ticks;
+        }
+        test_stats_check(round);
+    }
+
+    printf("OK: seed %u, %d rounds\n", seed, rounds);
+    return 0;
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Cost of sending an event to a tasklet and dispatching it.
+ *
+ * Creates 20 tasklets and sends events to the last one, running the
+ * scheduler after each. Only uses the public API, so it also builds
+ * against older versions of event.c (see build.sh).
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "nsdynmemLIB.h"
+#include "eventOS_event.h"
+#include "eventOS_scheduler.h"
+
+#define BENCH_EVENTS 1000000
+
+static char bench_heap[64 * 1024];
+static unsigned bench_handled;
+
+static void bench_handler(arm_event_t *event)
+{
+    bench_handled += event->event_type;
+}
+
+#define BENCH_HANDLER(i) static void bench_handler_##i(arm_event_t *event) { (void) event; }
+BENCH_HANDLER(0) BENCH_HANDLER(1) BENCH_HANDLER(2) BENCH_HANDLER(3) BENCH_HANDLER(4) BENCH_HANDLER(5)
+BENCH_HANDLER(6) BENCH_HANDLER(7) BENCH_HANDLER(8) BENCH_HANDLER(9) BENCH_HANDLER(10) BENCH_HANDLER(11)
+BENCH_HANDLER(12) BENCH_HANDLER(13) BENCH_HANDLER(14) BENCH_HANDLER(15) BENCH_HANDLER(16) BENCH_HANDLER(17)
+BENCH_HANDLER(18)
+
+static void (*const bench_others[])(arm_event_t *) = {
+    bench_handler_0, bench_handler_1, bench_handler_2, bench_handler_3, bench_handler_4, bench_handler_5,
+    bench_handler_6, bench_handler_7, bench_handler_8, bench_handler_9, bench_handler_10, bench_handler_11,
+    bench_handler_12, bench_handler_13, bench_handler_14, bench_handler_15, bench_handler_16, bench_handler_17,
+    bench_handler_18,
+};
+
+int main(void)
+{
+    struct timespec begin, end;
+
+    ns_dyn_mem_init(bench_heap, sizeof(bench_heap), NULL, NULL);
+    eventOS_scheduler_init();
+    for (unsigned i = 0; i < sizeof(bench_others) / sizeof(bench_others[0]); i++) {
+        eventOS_event_handler_create(bench_others[i], 0);
+    }
+    int8_t tasklet = eventOS_event_handler_create(bench_handler, 0);
+    eventOS_scheduler_run_until_idle();
+
+    clock_gettime(CLOCK_MONOTONIC, &begin);
+    for (int i = 0; i < BENCH_EVENTS; i++) {
+        arm_event_t event = {.receiver = tasklet, .event_type = 1, .priority = ARM_LIB_MED_PRIORITY_EVENT};
+        eventOS_event_send(&event);
+        eventOS_scheduler_run_until_idle();
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if (bench_handled != BENCH_EVENTS) {
+        printf("FAIL: %u of %d events handled\n", bench_handled, BENCH_EVENTS);
+        return 1;
+    }
+    double ns = (end.tv_sec - begin.tv_sec) * 1e9 + (end.tv_nsec - begin.tv_nsec);
+    printf("%.1f ns per event to tasklet %d\n", ns / BENCH_EVENTS, tasklet);
+    return 0;
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Randomised test of the tasklet table.
+ *
+ * Each round starts the scheduler on a fresh heap and creates up to 136
+ * tasklets, one per handler. Ids must be handed out densely from 0, past
+ * id 127 creation must fail with -2, and a handler already registered must
+ * be refused with -1. A small heap also makes creation fail part way, and
+ * the tasklets created after that must still get the next free id. Every
+ * tasklet must get its init event once. Events sent to random receivers,
+ * including negative ids and ids past the last tasklet, must be accepted
+ * exactly for the tasklets that exist and reach the handler of that id.
+ *
+ * Usage: tasklet_test [seed] [rounds]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "nsdynmemLIB.h"
+#include "eventOS_event.h"
+#include "eventOS_scheduler.h"
+
+#define TEST_INIT_EVENT 0x42
+
+static char test_heap[64 * 1024];
+static int test_round;
+static int test_expected;
+static int test_handled;
+static int8_t test_id[136];
+static int test_inits[136];
+
+static void test_fail(const char *what, int round)
+{
+    printf("FAIL: %s in round %d\n", what, round);
+    exit(1);
+}
+
+static void test_handle(int handler, arm_event_t *event)
+{
+    if (test_id[handler] < 0 || event->receiver != test_id[handler] ||
+            eventOS_scheduler_get_active_tasklet() != test_id[handler]) {
+        test_fail("event given to the wrong tasklet", test_round);
+    }
+    if (event->event_type == TEST_INIT_EVENT) {
+        test_inits[handler]++;
+        return;
+    }
+    if (event->event_data != test_expected) {
+        test_fail("wrong event dispatched", test_round);
+    }
+    test_handled++;
+}
+
+/* Tasklets are told apart by their handler, so each needs its own function */
+#define TEST_HANDLER(i) static void test_handler_##i(arm_event_t *event) { test_handle(i, event); }
+#define TEST_HANDLERS(d) TEST_HANDLER(0##d##0) TEST_HANDLER(0##d##1) TEST_HANDLER(0##d##2) TEST_HANDLER(0##d##3) \
+                         TEST_HANDLER(0##d##4) TEST_HANDLER(0##d##5) TEST_HANDLER(0##d##6) TEST_HANDLER(0##d##7)
+#define TEST_HANDLER_LIST(d) test_handler_0##d##0, test_handler_0##d##1, test_handler_0##d##2, test_handler_0##d##3, \
+                             test_handler_0##d##4, test_handler_0##d##5, test_handler_0##d##6, test_handler_0##d##7,
+
+/* Handlers are numbered in octal, so handler n is test_handlers[n] */
+TEST_HANDLERS(0) TEST_HANDLERS(1) TEST_HANDLERS(2) TEST_HANDLERS(3) TEST_HANDLERS(4) TEST_HANDLERS(5)
+TEST_HANDLERS(6) TEST_HANDLERS(7) TEST_HANDLERS(10) TEST_HANDLERS(11) TEST_HANDLERS(12) TEST_HANDLERS(13)
+TEST_HANDLERS(14) TEST_HANDLERS(15) TEST_HANDLERS(16) TEST_HANDLERS(17) TEST_HANDLERS(20)
+
+static void (*const test_handlers[136])(arm_event_t *) = {
+    TEST_HANDLER_LIST(0) TEST_HANDLER_LIST(1) TEST_HANDLER_LIST(2) TEST_HANDLER_LIST(3) TEST_HANDLER_LIST(4)
+    TEST_HANDLER_LIST(5) TEST_HANDLER_LIST(6) TEST_HANDLER_LIST(7) TEST_HANDLER_LIST(10) TEST_HANDLER_LIST(11)
+    TEST_HANDLER_LIST(12) TEST_HANDLER_LIST(13) TEST_HANDLER_LIST(14) TEST_HANDLER_LIST(15) TEST_HANDLER_LIST(16)
+    TEST_HANDLER_LIST(17) TEST_HANDLER_LIST(20)
+};
+
+static void test_round_run(int round)
+{
+    /* Small heaps run out part way through the tasklets */
+    size_t heap_size = rand() % 2 ? sizeof(test_heap) : 2048 + rand() % 4096;
+    int handlers = 1 + rand() % 136;
+    int tasklets = 0;
+
+    ns_dyn_mem_init(test_heap, heap_size, NULL, NULL);
+    eventOS_scheduler_init();
+
+    for (int i = 0; i < handlers; i++) {
+        test_id[i] = eventOS_event_handler_create(test_handlers[i], TEST_INIT_EVENT);
+        test_inits[i] = 0;
+        if (test_id[i] == -2) {
+            if (tasklets <= INT8_MAX && heap_size == sizeof(test_heap)) {
+                test_fail("creation failed with free ids and heap", round);
+            }
+        } else if (test_id[i] != tasklets) {
+            test_fail("id not the next free one", round);
+        } else {
+            tasklets++;
+        }
+        int again = rand() % (i + 1);
+        if (test_id[again] >= 0 && eventOS_event_handler_create(test_handlers[again], TEST_INIT_EVENT) != -1) {
+            test_fail("handler registered twice", round);
+        }
+    }
+
+    eventOS_scheduler_run_until_idle();
+    for (int i = 0; i < handlers; i++) {
+        if (test_inits[i] != (test_id[i] >= 0)) {
+            test_fail("init event count", round);
+        }
+    }
+
+    for (int i = 0; i < 200; i++) {
+        int8_t receiver = (int8_t)(rand() % (tasklets + 4) - 2);
+        if (rand() % 8 == 0) {
+            receiver = (int8_t)(INT8_MIN + rand() % 256);
+        }
+        arm_event_t event = {
+            .receiver = receiver,
+            .event_type = 1,
+            .event_data = i,
+            .priority = ARM_LIB_MED_PRIORITY_EVENT,
+        };
+        bool exists = receiver >= 0 && receiver < tasklets;
+        int8_t sent = eventOS_event_send(&event);
+        if (exists ? sent != 0 && heap_size == sizeof(test_heap) : sent != -1) {
+            test_fail(exists ? "event to a tasklet refused" : "event to no tasklet accepted", round);
+        }
+        test_expected = i;
+        test_handled = 0;
+        eventOS_scheduler_run_until_idle();
+        if (test_handled != (sent == 0)) {
+            test_fail("event not dispatched once", round);
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned seed = argc > 1 ? strtoul(argv[1], NULL, 0) : 1;
+    int rounds = argc > 2 ? atoi(argv[2]) : 2000;
+
+    srand(seed);
+    for (test_round = 0; test_round < rounds; test_round++) {
+        test_round_run(test_round);
+    }
+    printf("OK: seed %u, %d rounds\n", seed, rounds);
+    return 0;
+}
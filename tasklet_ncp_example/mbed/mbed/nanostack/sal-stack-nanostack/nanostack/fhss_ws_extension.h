@@ -74,6 +74,7 @@ typedef struct fhss_ws_neighbor_timing_info {
     broadcast_timing_info_t bc_timing_info;     /**< Neighbor broadcast timing info */
     ws_channel_mask_t uc_channel_list;          /**< Neighbor Unicast channel list */
     uint32_t *excluded_channels;                /**< Neighbor excluded channels (bit mask) */
+    uint8_t tr51_cache_entry;                   /**< FHSS TR51 sequence cache entry plus one, 0 if none */
 } fhss_ws_neighbor_timing_info_t;
 
 /**
@@ -118,6 +119,14 @@ extern int ns_fhss_set_neighbor_info_fp(const fhss_api_t *fhss_api, fhss_get_nei
  */
 extern int ns_fhss_ws_set_hop_count(const fhss_api_t *fhss_api, const uint8_t hop_count);
 
+/**
+ * @brief Set neighbor table size. The TR51 unicast hopping sequences of TX destinations are cached for this many neighbors.
+ * @param fhss_api FHSS instance.
+ * @param table_size Number of neighbor table entries.
+ * @return 0 on success, -1 on fail.
+ */
+extern int ns_fhss_ws_set_neighbor_table_size(const fhss_api_t *fhss_api, const uint8_t table_size);
+
 /**
  * @brief WS TX allowance levels.
  */
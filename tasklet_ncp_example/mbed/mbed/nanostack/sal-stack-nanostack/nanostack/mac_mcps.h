@@ -77,6 +77,9 @@ typedef struct mcps_data_conf_payload_s {
 } mcps_data_conf_payload_t;
 
 
+/** Receive channel is not known */
+#define MCPS_CHANNEL_UNKNOWN 0xff
+
 /**
  * @brief struct mcps_data_ind_t Data indication structure
  *
@@ -92,6 +95,7 @@ typedef struct mcps_data_ind_s {
     uint8_t DstAddr[8];         /**< Destination address */
     uint8_t mpduLinkQuality;    /**< LQI value measured during reception of the MPDU */
     int8_t signal_dbm;          /**< This extension for normal IEEE 802.15.4 Data indication */
+    uint8_t channel;            /**< This extension for normal IEEE 802.15.4 Data indication, radio channel at reception, MCPS_CHANNEL_UNKNOWN if not reported by the MAC */
     uint32_t timestamp;         /**< The time, in symbols, at which the data were received */
     uint8_t DSN;                /**< Data sequence number */
     mlme_security_t Key;        /**< Security key */
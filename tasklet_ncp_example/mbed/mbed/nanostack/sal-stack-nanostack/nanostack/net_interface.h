@@ -481,6 +481,41 @@ extern int8_t arm_nwk_6lowpan_link_scan_parameter_set(int8_t interface_id, uint8
  */
 extern int8_t arm_nwk_6lowpan_link_panid_filter_for_nwk_scan(int8_t interface_id, uint16_t pan_id_filter);
 
+/**
+ * \brief Enable/disable 6LoWPAN fragment forwarding (RFC 8930).
+ *
+ * With forwarding enabled, a fragmented datagram that is only passing through
+ * this router is relabelled and sent on fragment by fragment, instead of
+ * being reassembled and fragmented again. Datagrams addressed to us, and ones
+ * that need routing header processing or tunnelling, are still reassembled.
+ *
+ * \param interface_id Network interface ID.
+ * \param flow_limit Maximum number of datagrams being forwarded at once. 0 disables forwarding.
+ *
+ * \return 0 On success.
+ * \return -1 Unknown network interface ID, or the interface has no 6LoWPAN reassembly.
+ * \return -2 Out of memory.
+ */
+extern int8_t arm_nwk_6lowpan_fragment_forwarding_set(int8_t interface_id, uint8_t flow_limit);
+
+/**
+ * \brief Configure 6LoWPAN fragment recovery and pacing.
+ *
+ * When the MAC gives up on a fragment of a unicast datagram, only that
+ * fragment is resent after a short randomised delay, instead of the whole
+ * datagram failing. Pacing inserts a gap after every window of fragments,
+ * giving a forwarding next hop time to pass them on.
+ *
+ * \param interface_id Network interface ID.
+ * \param retries Fragment resends allowed per datagram. 0 disables recovery.
+ * \param window Fragments sent back to back before a pacing gap. 0 disables pacing.
+ * \param pacing_ms Pacing gap in milliseconds. 0 disables pacing.
+ *
+ * \return 0 On success.
+ * \return -1 Unknown network interface ID.
+ */
+extern int8_t arm_nwk_6lowpan_fragment_recovery_set(int8_t interface_id, uint8_t retries, uint8_t window, uint16_t pacing_ms);
+
 /**
   * \brief Get current used channel.
   *
@@ -51,6 +51,8 @@ typedef struct nwk_stats_t {
     /* Fragments */
     uint32_t frag_rx_errors;        /**< Fragmentation RX error count. */
     uint32_t frag_tx_errors;        /**< Fragmentation TX error count. */
+    uint32_t frag_rx_evictions;     /**< Reassembly sessions dropped to make room for a new one. */
+    uint32_t frag_rx_timeouts;      /**< Reassembly sessions timed out. */
     /*RPL stats*/
     uint32_t rpl_route_routecost_better_change; /**< RPL parent change count. */
     uint32_t ip_routeloop_detect;               /**< RPL route loop detection count. */
@@ -81,6 +81,21 @@ extern void arm_aes_encrypt(
     const uint8_t src[__static 16],
     uint8_t dst[__static 16]);
 
+/**
+ * \brief This function performs ECB encryption of consecutive blocks.
+ *
+ * Same as calling arm_aes_encrypt() for each of the blocks, but lets the
+ * implementation process the blocks as one burst. CCM passes the CBC-MAC
+ * block and several counter blocks in one call.
+ * Note that src and dst pointers may be equal.
+ *
+ * \param aes_context Pointer for allocated
+ * \param src pointer to blocks * 128-bit plaintext in
+ * \param dst pointer for blocks * 128-bit ciphertext out
+ * \param blocks number of 128-bit blocks
+ */
+void arm_aes_encrypt_blocks(arm_aes_context_t *aes_context, const uint8_t *src, uint8_t *dst, uint_fast8_t blocks);
+
 /**
  * \brief Finish AES operations
  *
@@ -90,6 +105,41 @@ extern void arm_aes_encrypt(
  */
 void arm_aes_finish(arm_aes_context_t *aes_context);
 
+/**
+ * \brief Keep a key ready for use
+ *
+ * Tells that the key is in active use, for example as the current group or
+ * pairwise key, so that an implementation caching expanded keys keeps it
+ * until arm_aes_key_evict() is called. Implementations that have nothing
+ * to cache may do nothing and return 0.
+ *
+ * \param key pointer to 128-bit AES key
+ *
+ * \return 0 key kept
+ * \return -1 key could not be kept, it still works with arm_aes_start()
+ */
+int8_t arm_aes_key_pin(const uint8_t key[__static 16]);
+
+/**
+ * \brief Forget a key
+ *
+ * Drops any cached copy of the key and its pin. Called when the key is
+ * replaced or removed. Contexts started with the key stay usable until
+ * arm_aes_finish().
+ *
+ * \param key pointer to 128-bit AES key
+ */
+void arm_aes_key_evict(const uint8_t key[__static 16]);
+
+/**
+ * \brief Forget all idle keys
+ *
+ * Drops the cached copies and pins of all keys that have no started context,
+ * so that an implementation can release the AES hardware before the device
+ * sleeps. Keys pinned before need to be pinned again.
+ */
+void arm_aes_key_cache_flush(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -37,10 +37,33 @@
 #include "NWK_INTERFACE/Include/protocol_stats.h"
 #include "common_functions.h"
 #include "6LoWPAN/MAC/mac_helper.h"
+#include "6LoWPAN/lowpan_adaptation_interface.h"
+#include "Common_Protocols/ipv6.h"
 
 #define TRACE_GROUP "6frg"
 
-typedef struct {
+/* Largest datagram served from the per-session preallocated buffers - bigger
+ * ones allocate their buffer on demand. Each interface then holds one buffer
+ * of this size per reassembly session permanently (eg LOWPAN_MTU with 8
+ * sessions is about 11 KB), so it is off (0) by default, and no shipped
+ * configuration turns it on - the TI-RTOS border router heap is only 10 KB.
+ *
+ * Only with the pool configured does starting a session take its buffer
+ * without going to the heap, and so without failing. With it off, every
+ * first fragment allocates as before. Even with it on, the heap is still
+ * used once per datagram: its buffer goes up the stack, and
+ * reassembly_entry_free() allocates a replacement. That allocation can fail,
+ * and the pool then stays short until it runs dry and a session allocates on
+ * demand again.
+ */
+#ifndef CIPV6_REASSEMBLY_BUFFER_SIZE
+#define CIPV6_REASSEMBLY_BUFFER_SIZE 0
+#endif
+
+/* Reassembly buffer size for a datagram - see cipv6_frag_reassembly() */
+#define REASSEMBLY_BUFFER_SIZE(datagram_size) (1 + (((datagram_size) + 7) & ~7))
+
+typedef struct reassembly_entry {
     uint16_t ttl;   /*!< Reassembly timer (seconds) */
     uint16_t tag;   /*!< Fragmentation datagram TAG ID */
     uint16_t size;  /*!< Datagram Total Size (uncompressed) */
@@ -48,18 +71,48 @@ typedef struct {
     uint16_t frag_max;  /*!< Maximum fragment size (MAC payload) */
     uint16_t offset; /*!< Data offset from datagram start */
     int16_t pattern; /*!< Size of compressed LoWPAN headers */
+    uint16_t hash;  /*!< Session key hash */
     buffer_t *buf;
+    struct reassembly_entry *hash_next; /*!< Next entry in same hash bucket */
     ns_list_link_t      link; /*!< List link entry */
 } reassembly_entry_t;
 
 typedef NS_LIST_HEAD(reassembly_entry_t, link) reassembly_list_t;
 
+/* RFC 8930 fragment forwarding - a datagram passing through us is relabelled
+ * fragment by fragment instead of being reassembled.
+ */
+typedef struct {
+    uint16_t ttl;       /*!< Forwarding timer (seconds) */
+    uint16_t tag;       /*!< Datagram TAG from previous hop */
+    uint16_t size;      /*!< Datagram Total Size (uncompressed) */
+    uint16_t out_tag;   /*!< Datagram TAG towards next hop */
+    uint8_t traffic_class;
+    bool complete;      /*!< Last fragment has been forwarded */
+    buffer_priority_t priority;
+    buffer_link_ieee802_15_4_t link_info; /*!< Link metadata of forwarded first fragment */
+    sockaddr_t src_sa;  /*!< Previous hop */
+    sockaddr_t out_src_sa;
+    sockaddr_t out_dst_sa; /*!< Next hop */
+    ns_list_link_t      link; /*!< List link entry */
+} forward_entry_t;
+
+typedef NS_LIST_HEAD(forward_entry_t, link) forward_list_t;
+
 typedef struct {
     int8_t interface_id;
     uint16_t timeout;
     reassembly_list_t rx_list;
     reassembly_list_t free_list;
     reassembly_entry_t *entry_pointer_buffer;
+    reassembly_entry_t **hash_table; /*!< Sessions indexed by reassembly_hash() */
+    uint16_t hash_mask;
+    buffer_list_t buffer_pool; /*!< Preallocated reassembly buffers */
+    uint8_t buffer_pool_count;
+    uint8_t buffer_pool_limit;
+    forward_list_t forward_list;
+    forward_list_t forward_free_list;
+    forward_entry_t *forward_entry_buffer; /*!< NULL when fragment forwarding is disabled */
     ns_list_link_t      link; /*!< List link entry */
 } reassembly_interface_t;
 
@@ -210,13 +263,79 @@ static reassembly_interface_t *reassembly_interface_discover(int8_t interfaceId)
     return NULL;
 }
 
+static uint_fast16_t reassembly_hash_address(uint_fast16_t hash, const sockaddr_t *sa)
+{
+    /* Type will be either long or short 802.15.4 - we skip the PAN ID */
+    const uint8_t *ptr = sa->address + 2;
+    for (uint_fast8_t i = addr_len_from_type(sa->addr_type) - 2; i; i--) {
+        hash = hash * 31 + *ptr++;
+    }
+
+    return hash;
+}
+
+static uint16_t reassembly_hash(const buffer_t *buf, uint16_t tag, uint16_t size)
+{
+    uint_fast16_t hash = tag ^ (size << 5);
+    hash = reassembly_hash_address(hash, &buf->src_sa);
+    hash = reassembly_hash_address(hash, &buf->dst_sa);
+    return hash;
+}
+
+/* Put one buffer in the pool, if it is short of one */
+static void reassembly_buffer_pool_add(reassembly_interface_t *interface_ptr)
+{
+    if (interface_ptr->buffer_pool_count >= interface_ptr->buffer_pool_limit) {
+        return;
+    }
+
+    buffer_t *buf = buffer_get(REASSEMBLY_BUFFER_SIZE(CIPV6_REASSEMBLY_BUFFER_SIZE));
+    if (buf) {
+        ns_list_add_to_start(&interface_ptr->buffer_pool, buf);
+        interface_ptr->buffer_pool_count++;
+    }
+}
+
+static buffer_t *reassembly_buffer_get(reassembly_interface_t *interface_ptr, uint16_t datagram_size)
+{
+    if (datagram_size <= CIPV6_REASSEMBLY_BUFFER_SIZE) {
+        buffer_t *buf = ns_list_get_first(&interface_ptr->buffer_pool);
+        if (buf) {
+            ns_list_remove(&interface_ptr->buffer_pool, buf);
+            interface_ptr->buffer_pool_count--;
+            return buf;
+        }
+    }
+
+    return buffer_get(REASSEMBLY_BUFFER_SIZE(datagram_size));
+}
+
 static void reassembly_entry_free(reassembly_interface_t *interface_ptr, reassembly_entry_t *entry)
 {
+    reassembly_entry_t **prev_ptr = &interface_ptr->hash_table[entry->hash & interface_ptr->hash_mask];
+    while (*prev_ptr) {
+        if (*prev_ptr == entry) {
+            *prev_ptr = entry->hash_next;
+            break;
+        }
+        prev_ptr = &(*prev_ptr)->hash_next;
+    }
+
     ns_list_remove(&interface_ptr->rx_list, entry);
     ns_list_add_to_start(&interface_ptr->free_list, entry);
     if (entry->buf) {
         entry->buf = buffer_free(entry->buf);
     }
+
+    /* A session's buffer never goes back to the pool as such - it either went
+     * up the stack, or has picked up metadata from the first fragment. A
+     * session that fitted the pool replaces it with one fresh buffer; when the
+     * datagram was dropped that is the block just freed. Nothing else tops
+     * the pool up, so a pool left short by the heap stays short.
+     */
+    if (entry->size && entry->size <= CIPV6_REASSEMBLY_BUFFER_SIZE) {
+        reassembly_buffer_pool_add(interface_ptr);
+    }
 }
 
 static void reassembly_list_free(reassembly_interface_t *interface_ptr)
@@ -227,10 +346,10 @@ static void reassembly_list_free(reassembly_interface_t *interface_ptr)
 }
 
 
-static reassembly_entry_t *reassembly_already_action(reassembly_list_t *reassembly_list, buffer_t *buf, uint16_t tag, uint16_t size)
+static reassembly_entry_t *reassembly_already_action(reassembly_interface_t *interface_ptr, buffer_t *buf, uint16_t tag, uint16_t size, uint16_t hash)
 {
-    ns_list_foreach(reassembly_entry_t, reassembly_entry, reassembly_list) {
-        if ((reassembly_entry->tag == tag) && (reassembly_entry->size == size) &&
+    for (reassembly_entry_t *reassembly_entry = interface_ptr->hash_table[hash & interface_ptr->hash_mask]; reassembly_entry; reassembly_entry = reassembly_entry->hash_next) {
+        if ((reassembly_entry->hash == hash) && (reassembly_entry->tag == tag) && (reassembly_entry->size == size) &&
                 reassembly_entry->buf->src_sa.addr_type == buf->src_sa.addr_type &&
                 reassembly_entry->buf->dst_sa.addr_type == buf->dst_sa.addr_type) {
             /* Type will be either long or short 802.15.4 - we skip the PAN ID */
@@ -245,17 +364,206 @@ static reassembly_entry_t *reassembly_already_action(reassembly_list_t *reassemb
 
 }
 
-static reassembly_entry_t *lowpan_adaptation_reassembly_get(reassembly_interface_t *interface_ptr)
+static void forward_entry_free(reassembly_interface_t *interface_ptr, forward_entry_t *entry)
 {
-    reassembly_entry_t *entry = ns_list_get_first(&interface_ptr->free_list);
+    entry->complete = false;
+    ns_list_remove(&interface_ptr->forward_list, entry);
+    ns_list_add_to_start(&interface_ptr->forward_free_list, entry);
+}
+
+static void forward_list_free(reassembly_interface_t *interface_ptr)
+{
+    ns_list_foreach_safe(forward_entry_t, forward_entry, &interface_ptr->forward_list) {
+        forward_entry_free(interface_ptr, forward_entry);
+    }
+}
+
+static forward_entry_t *forward_entry_discover(forward_list_t *forward_list, const buffer_t *buf, uint16_t tag, uint16_t size)
+{
+    ns_list_foreach(forward_entry_t, forward_entry, forward_list) {
+        if (forward_entry->tag == tag && forward_entry->size == size &&
+                forward_entry->src_sa.addr_type == buf->src_sa.addr_type &&
+                memcmp(forward_entry->src_sa.address + 2, buf->src_sa.address + 2, addr_len_from_type(buf->src_sa.addr_type) - 2) == 0) {
+            return forward_entry;
+        }
+    }
+
+    return NULL;
+}
+
+/* Get a free flow entry, or failing that the oldest one whose last fragment
+ * has already gone. An entry still in use is never taken.
+ */
+static forward_entry_t *forward_entry_get(reassembly_interface_t *interface_ptr)
+{
+    forward_entry_t *entry = ns_list_get_first(&interface_ptr->forward_free_list);
+    if (entry) {
+        return entry;
+    }
+
+    ns_list_foreach_reverse(forward_entry_t, forward_entry, &interface_ptr->forward_list) {
+        if (forward_entry->complete) {
+            return forward_entry;
+        }
+    }
+
+    return NULL;
+}
+
+/* Try to forward a first fragment (header already consumed, buf pointing at
+ * the 6LoWPAN dispatch) without reassembling. Works on a clone, so buf is
+ * untouched; NULL means "not forwarding - reassemble it".
+ *
+ * The IP header is decompressed, run through the IPv6 forwarding decision,
+ * and recompressed for the next hop. Offsets in FRAGN headers are in terms
+ * of the uncompressed datagram, so the later fragments need only the tag
+ * changing, however different the compressed header size turns out to be.
+ */
+static buffer_t *fragment_forward_first(reassembly_interface_t *interface_ptr, buffer_t *buf, uint16_t datagram_tag, uint16_t datagram_size)
+{
+    protocol_interface_info_entry_t *cur = buf->interface;
+    const uint8_t *ip_hc = buffer_data_pointer(buf);
+
+    if (!cur || buffer_data_length(buf) < 2 || (ip_hc[0] & LOWPAN_DISPATCH_IPHC_MASK) != LOWPAN_DISPATCH_IPHC) {
+        return NULL;
+    }
+
+    forward_entry_t *entry = forward_entry_get(interface_ptr);
     if (!entry) {
         return NULL;
     }
 
+    buffer_t *fwd_buf = buffer_clone(buf);
+    if (!fwd_buf) {
+        return NULL;
+    }
+
+    fwd_buf = iphc_decompress(&cur->lowpan_contexts, fwd_buf);
+    if (!fwd_buf) {
+        return NULL;
+    }
+
+    fwd_buf = ipv6_forwarding_first_fragment(fwd_buf, datagram_size);
+    if (!fwd_buf) {
+        return NULL;
+    }
+
+    fwd_buf = lowpan_down(fwd_buf);
+    if (!fwd_buf) {
+        return NULL;
+    }
+
+    if ((fwd_buf->info & B_TO_MASK) != B_TO_MAC) {
+        /* Mesh header needed */
+        buffer_free(fwd_buf);
+        return NULL;
+    }
+
+    fwd_buf = buffer_headroom(fwd_buf, 4);
+    if (!fwd_buf) {
+        return NULL;
+    }
+
+    uint16_t out_tag = lowpan_adaptation_fragment_tag_allocate(cur->id);
+    uint8_t *ptr = buffer_data_reserve_header(fwd_buf, 4);
+    ptr = common_write_16_bit(((uint16_t) LOWPAN_FRAG1 << 8) | datagram_size, ptr);
+    common_write_16_bit(out_tag, ptr);
+
+    /* Recompression may not give back what we received - eg our MAC address
+     * differs from the previous hop's, so the source IID may now be inline.
+     * If it no longer fits one frame, fall back to reassembly.
+     */
+    if (!lowpan_adaptation_tx_fits_mtu(cur, fwd_buf)) {
+        tr_debug("Frag fwd: first fragment too big");
+        buffer_free(fwd_buf);
+        return NULL;
+    }
+
+    if (entry->complete) {
+        forward_entry_free(interface_ptr, entry);
+    }
+    ns_list_remove(&interface_ptr->forward_free_list, entry);
+    memset(entry, 0, sizeof(forward_entry_t));
+    ns_list_add_to_start(&interface_ptr->forward_list, entry);
+    entry->ttl = interface_ptr->timeout;
+    entry->tag = datagram_tag;
+    entry->size = datagram_size;
+    entry->out_tag = out_tag;
+    entry->traffic_class = fwd_buf->options.traffic_class;
+    entry->priority = fwd_buf->priority;
+    entry->link_info = fwd_buf->link_specific.ieee802_15_4;
+    entry->src_sa = buf->src_sa;
+    entry->out_src_sa = fwd_buf->src_sa;
+    entry->out_dst_sa = fwd_buf->dst_sa;
+
+    tr_debug("Frag fwd: %s tag %u -> %s tag %u", trace_sockaddr(&entry->src_sa, true), datagram_tag,
+             trace_sockaddr(&entry->out_dst_sa, true), out_tag);
+
+    /* Only now that it won't be reassembled and forwarded again */
+    if (cur->if_common_forwarding_out_cb) {
+        cur->if_common_forwarding_out_cb(cur, fwd_buf);
+    }
+
+    fwd_buf->info = (buffer_info_t)(B_DIR_DOWN | B_FROM_FRAGMENTATION | B_TO_MAC);
+    return fwd_buf;
+}
+
+/* Relabel a non-first fragment of a forwarded datagram for the next hop. buf
+ * still points at the FRAGN header.
+ */
+static buffer_t *fragment_forward_next(reassembly_interface_t *interface_ptr, forward_entry_t *entry, buffer_t *buf, uint16_t fragment_last)
+{
+    if (buf->options.ll_security_bypass_rx) {
+        protocol_stats_update(STATS_IP_RX_DROP, 1);
+        return buffer_free(buf);
+    }
+
+    common_write_16_bit(entry->out_tag, buffer_data_pointer(buf) + 2);
+    buf->src_sa = entry->out_src_sa;
+    buf->dst_sa = entry->out_dst_sa;
+    buf->link_specific.ieee802_15_4 = entry->link_info;
+    buf->options.traffic_class = entry->traffic_class;
+    buf->options.ll_security_bypass_tx = false;
+    buf->options.ll_broadcast_tx = false;
+    buf->priority = entry->priority;
+    buf->info = (buffer_info_t)(B_DIR_DOWN | B_FROM_FRAGMENTATION | B_TO_MAC);
+
+    /* Last fragment - the entry is kept until it times out, so that a
+     * reordered or retransmitted fragment arriving after this is still
+     * relabelled rather than starting a reassembly that can only time out.
+     * The slot can be reused for a new flow before that if none is free.
+     */
+    if (fragment_last == entry->size - 1) {
+        entry->complete = true;
+    }
+
+    return buf;
+}
+
+static reassembly_entry_t *lowpan_adaptation_reassembly_get(reassembly_interface_t *interface_ptr, uint16_t hash)
+{
+    reassembly_entry_t *entry = ns_list_get_first(&interface_ptr->free_list);
+    if (!entry) {
+        /* All sessions in use - give up on the oldest, it's the one most
+         * likely to have lost a fragment.
+         */
+        entry = ns_list_get_last(&interface_ptr->rx_list);
+        if (!entry) {
+            return NULL;
+        }
+        tr_debug("Reassembly evict: src %s size %u", trace_sockaddr(&entry->buf->src_sa, true), entry->size);
+        protocol_stats_update(STATS_FRAG_RX_EVICT, 1);
+        protocol_stats_update(STATS_FRAG_RX_ERROR, 1);
+        reassembly_entry_free(interface_ptr, entry);
+    }
+
     ns_list_remove(&interface_ptr->free_list, entry);
     memset(entry, 0, sizeof(reassembly_entry_t));
     //Add to first
     ns_list_add_to_start(&interface_ptr->rx_list, entry);
+    entry->hash = hash;
+    entry->hash_next = interface_ptr->hash_table[hash & interface_ptr->hash_mask];
+    interface_ptr->hash_table[hash & interface_ptr->hash_mask] = entry;
 
     return entry;
 }
@@ -290,32 +598,61 @@ buffer_t *cipv6_frag_reassembly(int8_t interface_id, buffer_t *buf)
         fragment_first = 0;
     }
 
+    /* Fragment of a datagram we're already forwarding? */
+    if (interface_ptr->forward_entry_buffer) {
+        forward_entry_t *forward_ptr = forward_entry_discover(&interface_ptr->forward_list, buf, datagram_tag, datagram_size);
+        if (forward_ptr) {
+            uint16_t fragment_length = buffer_data_end(buf) - ptr;
+            if (fragment_first == 0) {
+                /* Duplicate first fragment - we've already sent it on */
+                return buffer_free(buf);
+            }
+            if (fragment_length == 0 || fragment_first + fragment_length > datagram_size) {
+                tr_err("Frag fwd out-of-range: offset=%u, size=%u", fragment_first, datagram_size);
+                goto resassembly_error;
+            }
+            return fragment_forward_next(interface_ptr, forward_ptr, buf, fragment_first + fragment_length - 1);
+        }
+    }
+
     /* Consume the fragment header. We don't distinguish FRAG1/FRAGN after this
      * point (we treat FRAGN with offset 0 the same as FRAG1)
      */
     buffer_data_pointer_set(buf, ptr);
-    reassembly_entry_t *frag_ptr = reassembly_already_action(&interface_ptr->rx_list, buf, datagram_tag, datagram_size);
+    uint16_t hash = reassembly_hash(buf, datagram_tag, datagram_size);
+    reassembly_entry_t *frag_ptr = reassembly_already_action(interface_ptr, buf, datagram_tag, datagram_size, hash);
+
+    /* First fragment of a new datagram - forward it if it isn't for us. Any
+     * fragment seen before the first one (out of order) has already committed
+     * us to reassembly.
+     */
+    if (!frag_ptr && fragment_first == 0 && interface_ptr->forward_entry_buffer) {
+        buffer_t *fwd_buf = fragment_forward_first(interface_ptr, buf, datagram_tag, datagram_size);
+        if (fwd_buf) {
+            buffer_free(buf);
+            return fwd_buf;
+        }
+    }
 
     if (!frag_ptr) {
 
-        frag_ptr = lowpan_adaptation_reassembly_get(interface_ptr);
+        frag_ptr = lowpan_adaptation_reassembly_get(interface_ptr, hash);
         if (!frag_ptr) {
             goto resassembly_error;
         }
 
-        buffer_t *reassembly_buffer = buffer_get(1 + ((datagram_size + 7) & ~7));
-        if (!reassembly_buffer) {
-            //Put allocated back to free
-            reassembly_entry_free(interface_ptr, frag_ptr);
-            goto resassembly_error;
-        }
-
-        // Allocate the reassembly buffer.
+        // Get the reassembly buffer, preallocated if it fits.
         // Allow 1 byte extra for an "Uncompressed IPv6" dispatch byte - the
         // 6LoWPAN data can be 1 byte longer than the IPv6 data.
         // Also, round datagram size up to a multiple of 8 to ensure we have
         // room for a final hole descriptor (it can spill past the indicated
         // datagram size if the last fragment is smaller than 8 bytes).
+        buffer_t *reassembly_buffer = reassembly_buffer_get(interface_ptr, datagram_size);
+        if (!reassembly_buffer) {
+            //Put allocated back to free
+            reassembly_entry_free(interface_ptr, frag_ptr);
+            goto resassembly_error;
+        }
 
         reassembly_buffer->src_sa = buf->src_sa;
         reassembly_buffer->dst_sa = buf->dst_sa;
@@ -456,6 +793,7 @@ static void reassembly_entry_timer_update(reassembly_interface_t *interface_ptr,
         if (reassembly_entry->ttl > seconds) {
             reassembly_entry->ttl -= seconds;
         } else {
+            protocol_stats_update(STATS_FRAG_RX_TIMEOUT, 1);
             protocol_stats_update(STATS_FRAG_RX_ERROR, 1);
             tr_debug("Reassembly TO: src %s size %u",
                      trace_sockaddr(&reassembly_entry->buf->src_sa, true),
@@ -465,10 +803,25 @@ static void reassembly_entry_timer_update(reassembly_interface_t *interface_ptr,
     }
 }
 
+static void forward_entry_timer_update(reassembly_interface_t *interface_ptr, uint16_t seconds)
+{
+    ns_list_foreach_safe(forward_entry_t, forward_entry, &interface_ptr->forward_list) {
+        if (forward_entry->ttl > seconds) {
+            forward_entry->ttl -= seconds;
+        } else {
+            if (!forward_entry->complete) {
+                tr_debug("Frag fwd TO: src %s tag %u", trace_sockaddr(&forward_entry->src_sa, true), forward_entry->tag);
+            }
+            forward_entry_free(interface_ptr, forward_entry);
+        }
+    }
+}
+
 void cipv6_frag_timer(uint16_t seconds)
 {
     ns_list_foreach(reassembly_interface_t, interface_ptr, &reassembly_interface_list) {
         reassembly_entry_timer_update(interface_ptr, seconds);
+        forward_entry_timer_update(interface_ptr, seconds);
     }
 }
 
@@ -482,8 +835,15 @@ int8_t reassembly_interface_free(int8_t interface_id)
 
     ns_list_remove(&reassembly_interface_list, interface_ptr);
 
+    //Free reassembly buffers, without topping the pool up again
+    interface_ptr->buffer_pool_limit = 0;
+    reassembly_list_free(interface_ptr);
+    buffer_free_list(&interface_ptr->buffer_pool);
+
     //Free Dynamic allocated entry buffer
     ns_dyn_mem_free(interface_ptr->entry_pointer_buffer);
+    ns_dyn_mem_free(interface_ptr->hash_table);
+    ns_dyn_mem_free(interface_ptr->forward_entry_buffer);
     ns_dyn_mem_free(interface_ptr);
 
     return 0;
@@ -500,27 +860,46 @@ int8_t reassembly_interface_init(int8_t interface_id, uint8_t reassembly_session
     //Remove old interface
     reassembly_interface_free(interface_id);
 
+    //Hash buckets - at least twice the session count, to keep chains short
+    uint16_t hash_size = 1;
+    while (hash_size < 2 * reassembly_session_limit) {
+        hash_size <<= 1;
+    }
+
     //Allocate new
     reassembly_interface_t *interface_ptr = ns_dyn_mem_alloc(sizeof(reassembly_interface_t));
     reassembly_entry_t *reassemply_ptr = ns_dyn_mem_alloc(sizeof(reassembly_entry_t) * reassembly_session_limit);
-    if (!interface_ptr || !reassemply_ptr) {
+    reassembly_entry_t **hash_table = ns_dyn_mem_alloc(sizeof(reassembly_entry_t *) * hash_size);
+    if (!interface_ptr || !reassemply_ptr || !hash_table) {
         ns_dyn_mem_free(interface_ptr);
         ns_dyn_mem_free(reassemply_ptr);
+        ns_dyn_mem_free(hash_table);
         return -1;
     }
 
     memset(interface_ptr, 0, sizeof(reassembly_interface_t));
+    memset(hash_table, 0, sizeof(reassembly_entry_t *) * hash_size);
     interface_ptr->interface_id = interface_id;
     interface_ptr->timeout = reassembly_timeout;
     interface_ptr->entry_pointer_buffer = reassemply_ptr;
+    interface_ptr->hash_table = hash_table;
+    interface_ptr->hash_mask = hash_size - 1;
+    interface_ptr->buffer_pool_limit = CIPV6_REASSEMBLY_BUFFER_SIZE ? reassembly_session_limit : 0;
+    ns_list_init(&interface_ptr->buffer_pool);
     ns_list_init(&interface_ptr->free_list);
     ns_list_init(&interface_ptr->rx_list);
+    ns_list_init(&interface_ptr->forward_free_list);
+    ns_list_init(&interface_ptr->forward_list);
 
     for (uint8_t i = 0; i < reassembly_session_limit ; i++) {
         ns_list_add_to_end(&interface_ptr->free_list, reassemply_ptr);
         reassemply_ptr++;
     }
 
+    for (uint8_t i = 0; i < interface_ptr->buffer_pool_limit; i++) {
+        reassembly_buffer_pool_add(interface_ptr);
+    }
+
     ns_list_add_to_end(&reassembly_interface_list, interface_ptr);
 
     return 0;
@@ -536,6 +915,40 @@ int8_t reassembly_interface_reset(int8_t interface_id)
 
     //Free Reaasembled queue
     reassembly_list_free(interface_ptr);
+    forward_list_free(interface_ptr);
+    return 0;
+}
+
+int8_t reassembly_interface_forwarding_set(int8_t interface_id, uint8_t forward_session_limit)
+{
+    //Discover
+    reassembly_interface_t *interface_ptr = reassembly_interface_discover(interface_id);
+    if (!interface_ptr) {
+        return -1;
+    }
+
+    //Drop current flows, their fragments will go to reassembly
+    ns_list_init(&interface_ptr->forward_free_list);
+    ns_list_init(&interface_ptr->forward_list);
+    ns_dyn_mem_free(interface_ptr->forward_entry_buffer);
+    interface_ptr->forward_entry_buffer = NULL;
+
+    if (!forward_session_limit) {
+        return 0;
+    }
+
+    forward_entry_t *forward_ptr = ns_dyn_mem_alloc(sizeof(forward_entry_t) * forward_session_limit);
+    if (!forward_ptr) {
+        return -2;
+    }
+
+    memset(forward_ptr, 0, sizeof(forward_entry_t) * forward_session_limit);
+    interface_ptr->forward_entry_buffer = forward_ptr;
+    for (uint8_t i = 0; i < forward_session_limit ; i++) {
+        ns_list_add_to_end(&interface_ptr->forward_free_list, forward_ptr);
+        forward_ptr++;
+    }
+
     return 0;
 }
 
@@ -21,6 +21,7 @@ struct buffer;
 int8_t reassembly_interface_reset(int8_t interface_id);
 int8_t reassembly_interface_init(int8_t interface_id, uint8_t reassembly_session_limit, uint16_t reassembly_timeout);
 int8_t reassembly_interface_free(int8_t interface_id);
+int8_t reassembly_interface_forwarding_set(int8_t interface_id, uint8_t forward_session_limit);
 
 void cipv6_frag_timer(uint16_t seconds);
 struct buffer *cipv6_frag_reassembly(int8_t interface_id, struct buffer *buf);
@@ -18,6 +18,7 @@
 #include "nsconfig.h"
 #include "ns_types.h"
 #include "eventOS_event.h"
+#include "eventOS_event_timer.h"
 #include "string.h"
 #include "ns_trace.h"
 #include "ns_list.h"
@@ -66,6 +67,9 @@ typedef void (adaptation_etx_update_cb)(protocol_interface_info_entry_t *cur, bu
 
 #define ADAPTION_DIRECT_TX_QUEUE_SIZE_THRESHOLD_TRACE 20
 
+/* Minimum wait before resending a fragment the MAC gave up on (randomised up to 2x) */
+#define LOWPAN_FRAGMENT_RECOVERY_DELAY_MS 50
+
 typedef struct {
     uint16_t tag;   /*!< Fragmentation datagram TAG ID */
     uint16_t size;  /*!< Datagram Total Size (uncompressed) */
@@ -80,6 +84,9 @@ typedef struct {
     bool first_fragment: 1;
     bool indirect_data: 1;
     bool indirect_data_cached: 1; /*!< Data cached for delayed transmission as mac request is already active */
+    bool fragment_held: 1; /*!< Next fragment waiting for the pacing/recovery timer, not in MAC */
+    uint8_t fragment_retries_left; /*!< Fragment resends left for this datagram */
+    uint8_t fragment_window_left; /*!< Fragments left before the next pacing gap */
     buffer_t *buf;
     uint8_t *fragmenter_buf;
     ns_list_link_t      link; /*!< List link entry */
@@ -105,6 +112,10 @@ typedef struct {
     uint16_t max_indirect_small_packets_per_child;
     uint32_t last_rx_high_priority;
     bool fragmenter_active; /*!< Fragmenter state */
+    bool fragment_timer_running;
+    uint8_t fragment_recovery_retries; /*!< Resends per datagram after MAC failure, 0 drops the datagram */
+    uint8_t fragment_window; /*!< Fragments sent back to back before a pacing gap */
+    uint16_t fragment_pacing_ms; /*!< Pacing gap, 0 disables pacing */
     adaptation_etx_update_cb *etx_update_cb;
     mpx_api_t *mpx_api;
     uint16_t mpx_user_id;
@@ -352,6 +363,7 @@ static void lowpan_active_buffer_state_reset(fragmenter_tx_entry_t *tx_buffer)
     }
     tx_buffer->fragmented_data = false;
     tx_buffer->first_fragment = true;
+    tx_buffer->fragment_held = false;
 }
 
 static bool lowpan_active_tx_handle_verify(uint8_t handle, buffer_t *buf)
@@ -1401,6 +1413,8 @@ int8_t lowpan_adaptation_interface_tx(protocol_interface_info_entry_t *cur, buff
         }
 
         tx_ptr->tag = interface_ptr->local_frag_tag++;
+        tx_ptr->fragment_retries_left = interface_ptr->fragment_recovery_retries;
+        tx_ptr->fragment_window_left = interface_ptr->fragment_window;
         if (!indirect) {
             interface_ptr->fragmenter_active = true;
         }
@@ -1531,6 +1545,107 @@ static void lowpan_adaptation_data_process_clean(fragmenter_interface_t *interfa
 }
 
 
+/* Pacing and recovery for direct unicast fragmented datagrams. Every fragment
+ * is acknowledged by the MAC, so the sender always knows exactly which
+ * fragment is missing - it's the current one, as the tx entry only advances
+ * on success. Recovery resends just that fragment rather than failing the
+ * whole datagram; the receiver's RFC 4944 reassembly keeps what it has until
+ * its own timeout, so no negotiation with the neighbour is needed.
+ *
+ * Only one fragmented direct datagram is active at a time (fragmenter_active),
+ * so a single interface timer is enough.
+ */
+static void lowpan_adaptation_fragment_timer_cb(void *arg)
+{
+    int8_t interface_id = (int8_t)(intptr_t) arg;
+    fragmenter_interface_t *interface_ptr = lowpan_adaptation_interface_discover(interface_id);
+    protocol_interface_info_entry_t *cur = protocol_stack_interface_info_get_by_id(interface_id);
+    if (!interface_ptr) {
+        return;
+    }
+    interface_ptr->fragment_timer_running = false;
+    if (!cur) {
+        return;
+    }
+
+    ns_list_foreach(fragmenter_tx_entry_t, entry, &interface_ptr->activeUnicastList) {
+        if (entry->fragment_held) {
+            entry->fragment_held = false;
+            lowpan_data_request_to_mac(cur, entry->buf, entry, interface_ptr);
+            return;
+        }
+    }
+}
+
+static bool lowpan_adaptation_fragment_hold(fragmenter_interface_t *interface_ptr, fragmenter_tx_entry_t *tx_ptr, uint16_t delay_ms)
+{
+    if (!interface_ptr->fragment_timer_running) {
+        if (!eventOS_timeout_ms(lowpan_adaptation_fragment_timer_cb, delay_ms, (void *)(intptr_t) interface_ptr->interface_id)) {
+            return false;
+        }
+        interface_ptr->fragment_timer_running = true;
+    }
+    tx_ptr->fragment_held = true;
+    return true;
+}
+
+static bool lowpan_adaptation_fragment_pace(fragmenter_interface_t *interface_ptr, fragmenter_tx_entry_t *tx_ptr, bool active_direct_confirm)
+{
+    if (!active_direct_confirm || !tx_ptr->buf->link_specific.ieee802_15_4.requestAck ||
+            !interface_ptr->fragment_window || !interface_ptr->fragment_pacing_ms) {
+        return false;
+    }
+
+    if (--tx_ptr->fragment_window_left) {
+        return false;
+    }
+    tx_ptr->fragment_window_left = interface_ptr->fragment_window;
+
+    return lowpan_adaptation_fragment_hold(interface_ptr, tx_ptr, interface_ptr->fragment_pacing_ms);
+}
+
+static bool lowpan_adaptation_fragment_recover(fragmenter_interface_t *interface_ptr, fragmenter_tx_entry_t *tx_ptr, uint8_t status, bool active_direct_confirm)
+{
+    if (!active_direct_confirm || !tx_ptr->fragmented_data || !tx_ptr->buf->link_specific.ieee802_15_4.requestAck ||
+            !tx_ptr->fragment_retries_left) {
+        return false;
+    }
+
+    if (status != MLME_TX_NO_ACK && status != MLME_BUSY_CHAN) {
+        return false;
+    }
+
+    uint16_t delay_ms = interface_ptr->fragment_pacing_ms;
+    if (delay_ms < LOWPAN_FRAGMENT_RECOVERY_DELAY_MS) {
+        delay_ms = LOWPAN_FRAGMENT_RECOVERY_DELAY_MS;
+    }
+    delay_ms = randLIB_get_random_in_range(delay_ms, delay_ms < 0x8000 ? delay_ms * 2 : 0xffff);
+
+    if (!lowpan_adaptation_fragment_hold(interface_ptr, tx_ptr, delay_ms)) {
+        return false;
+    }
+
+    tx_ptr->fragment_retries_left--;
+    /* Restart the window after a gap */
+    tx_ptr->fragment_window_left = interface_ptr->fragment_window;
+    tr_debug("Frag tag %u: resend %s fragment in %u ms, status %u", tx_ptr->tag, tx_ptr->first_fragment ? "first" : "next", delay_ms, status);
+    return true;
+}
+
+int8_t lowpan_adaptation_fragment_recovery_set(int8_t interface_id, uint8_t retries, uint8_t window, uint16_t pacing_ms)
+{
+    fragmenter_interface_t *interface_ptr = lowpan_adaptation_interface_discover(interface_id);
+
+    if (!interface_ptr) {
+        return -1;
+    }
+
+    interface_ptr->fragment_recovery_retries = retries;
+    interface_ptr->fragment_window = window;
+    interface_ptr->fragment_pacing_ms = pacing_ms;
+    return 0;
+}
+
 int8_t lowpan_adaptation_interface_tx_confirm(protocol_interface_info_entry_t *cur, const mcps_data_conf_t *confirm)
 {
     if (!cur || !confirm) {
@@ -1604,11 +1719,13 @@ int8_t lowpan_adaptation_interface_tx_confirm(protocol_interface_info_entry_t *c
             if (triggered_from_indirect_cache) {
                 return 0;
             }
-        } else {
+        } else if (!lowpan_adaptation_fragment_pace(interface_ptr, tx_ptr, active_direct_confirm)) {
             lowpan_data_request_to_mac(cur, buf, tx_ptr, interface_ptr);
         }
     } else if ((confirm->status == MLME_BUSY_CHAN) && !ws_info(cur)) {
         lowpan_data_request_to_mac(cur, buf, tx_ptr, interface_ptr);
+    } else if (lowpan_adaptation_fragment_recover(interface_ptr, tx_ptr, confirm->status, active_direct_confirm)) {
+        protocol_stats_update(STATS_FRAG_TX_ERROR, 1);
     } else {
 
 
@@ -1694,6 +1811,7 @@ void lowpan_adaptation_interface_data_ind(protocol_interface_info_entry_t *cur,
     //tr_debug("MAC Paylod size %u %s",data_ind->msduLength, trace_array(data_ind->msdu_ptr, 8));
     buf->options.lqi = data_ind->mpduLinkQuality;
     buf->options.dbm = data_ind->signal_dbm;
+    buf->options.channel = data_ind->channel;
     buf->src_sa.addr_type = (addrtype_t)data_ind->SrcAddrMode;
     ptr = common_write_16_bit(data_ind->SrcPANId, buf->src_sa.address);
     memcpy(ptr, data_ind->SrcAddr, 8);
@@ -1746,6 +1864,27 @@ static uint8_t map_mlme_status_to_socket_event(uint8_t mlme_status)
     return (socket_event);
 }
 
+/* Used by fragment forwarding - a forwarded datagram needs a tag from the
+ * same space as our own, as the next hop keys reassembly on (our MAC, tag).
+ */
+uint16_t lowpan_adaptation_fragment_tag_allocate(int8_t interface_id)
+{
+    fragmenter_interface_t *interface_ptr = lowpan_adaptation_interface_discover(interface_id);
+    if (!interface_ptr) {
+        return randLIB_get_16bit();
+    }
+    return interface_ptr->local_frag_tag++;
+}
+
+bool lowpan_adaptation_tx_fits_mtu(protocol_interface_info_entry_t *cur, buffer_t *buf)
+{
+    fragmenter_interface_t *interface_ptr = lowpan_adaptation_interface_discover(cur->id);
+    if (!interface_ptr) {
+        return false;
+    }
+    return !lowpan_adaptation_request_longer_than_mtu(cur, buf, interface_ptr);
+}
+
 bool lowpan_adaptation_tx_active(int8_t interface_id)
 {
     fragmenter_interface_t *interface_ptr = lowpan_adaptation_interface_discover(interface_id);
@@ -1805,7 +1944,7 @@ static bool lowpan_adaptation_purge_from_mac(struct protocol_interface_info_entr
 static bool lowpan_adaptation_indirect_queue_free_message(struct protocol_interface_info_entry *cur, fragmenter_interface_t *interface_ptr, fragmenter_tx_entry_t *tx_ptr)
 {
     tr_debug("Purge from indirect handle %u, cached %d", tx_ptr->buf->seq, tx_ptr->indirect_data_cached);
-    if (tx_ptr->indirect_data_cached == false) {
+    if (tx_ptr->indirect_data_cached == false && tx_ptr->fragment_held == false) {
         if (lowpan_adaptation_purge_from_mac(cur, interface_ptr, tx_ptr->buf->seq) == false) {
             // MAC purge failed
             return false;
@@ -56,10 +56,26 @@ struct buffer *lowpan_adaptation_reassembly(struct protocol_interface_info_entry
 
 bool lowpan_adaptation_tx_active(int8_t interface_id);
 
+uint16_t lowpan_adaptation_fragment_tag_allocate(int8_t interface_id);
+
+/**
+ * \brief Check a ready-made 6LoWPAN frame can be sent without fragmentation (used for forwarded fragments)
+ */
+bool lowpan_adaptation_tx_fits_mtu(struct protocol_interface_info_entry *cur, struct buffer *buf);
+
 void lowpan_adaptation_neigh_remove_free_tx_tables(struct protocol_interface_info_entry *cur_interface, struct mac_neighbor_table_entry *entry_ptr);
 
 int8_t lowpan_adaptation_free_messages_from_queues_by_address(struct protocol_interface_info_entry *cur, uint8_t *address_ptr, addrtype_t adr_type);
 
+/**
+ * \brief Configure fragment recovery and pacing for direct unicast fragmented datagrams
+ *
+ * \param retries Fragment resends allowed per datagram after the MAC gives up, 0 fails the datagram
+ * \param window Fragments sent back to back before a pacing gap, 0 disables pacing
+ * \param pacing_ms Pacing gap length, 0 disables pacing
+ */
+int8_t lowpan_adaptation_fragment_recovery_set(int8_t interface_id, uint8_t retries, uint8_t window, uint16_t pacing_ms);
+
 int8_t lowpan_adaptation_indirect_queue_params_set(struct protocol_interface_info_entry *cur, uint16_t indirect_big_packet_threshold, uint16_t max_indirect_big_packets_total, uint16_t max_indirect_small_packets_per_child);
 
 void lowpan_adaptation_expedite_forward_enable(struct protocol_interface_info_entry *cur);
@@ -875,6 +875,8 @@ static int8_t ws_fhss_enable(protocol_interface_info_entry_t *cur)
     if (ns_fhss_set_neighbor_info_fp(cur->ws_info->fhss_api, &ws_get_neighbor_info)) {
         return -1;
     }
+    // Cache a TX hopping sequence for every neighbor
+    ns_fhss_ws_set_neighbor_table_size(cur->ws_info->fhss_api, mac_neighbor_info(cur)->list_total_size);
     if (cur->bootsrap_mode == ARM_NWK_BOOTSRAP_MODE_6LoWPAN_BORDER_ROUTER) {
         ns_fhss_ws_set_hop_count(cur->ws_info->fhss_api, 0);
 #ifdef FEATURE_TIMAC_SUPPORT
@@ -439,4 +439,19 @@ extern uint8_t DEVICE_MIN_SENS;
  */
 #define EAP_TLS_FRAGMENT_LEN_VALUE         600       // EAP-TLS fragment length
 
+/*
+ *  TLS session resumption on border router
+ *
+ *  Sessions established with full handshakes are cached by EUI-64 so that
+ *  re-authenticating supplicants skip certificate exchange and ECC operations.
+ *  Cache is stored to NVM, each session takes 95 bytes. Size zero disables.
+ */
+#ifdef NV_RESTORE
+#define TLS_SESSION_CACHE_SIZE             16                // Maximum number of cached sessions, keeps NV item small
+#else
+#define TLS_SESSION_CACHE_SIZE             32                // Maximum number of cached sessions
+#endif
+#define TLS_SESSION_CACHE_LIFETIME         (7 * 24 * 3600)   // Session lifetime, 7 days
+#define TLS_SESSION_CACHE_STORE_INTERVAL   600               // Cache is stored to NVM at most every 10 minutes
+
 #endif /* WS_CONFIG_H_ */
@@ -26,6 +26,7 @@
 #include "6LoWPAN/ws/ws_config.h"
 #include "6LoWPAN/ws/ws_neighbor_class.h"
 #include "6LoWPAN/ws/ws_common.h"
+#include "Service_Libs/fhss/channel_list.h"
 #include "ws_management_api.h"
 
 #ifdef HAVE_WS
@@ -155,8 +156,6 @@ void ws_neighbor_class_neighbor_unicast_time_info_update(ws_neighbor_class_entry
 static void ws_neighbour_excluded_mask_by_range(ws_channel_mask_t *channel_info, ws_excluded_channel_range_t *range_info, uint16_t number_of_channels)
 {
     uint16_t range_start, range_stop;
-    uint8_t mask_index = 0;
-    uint32_t compare_mask_bit;
     uint8_t *range_ptr = range_info->range_start;
     while (range_info->number_of_range) {
         range_start = common_read_16_bit_inverse(range_ptr);
@@ -164,33 +163,23 @@ static void ws_neighbour_excluded_mask_by_range(ws_channel_mask_t *channel_info,
         range_stop = common_read_16_bit_inverse(range_ptr);
         range_ptr += 2;
         range_info->number_of_range--;
-        for (uint16_t channel = 0; channel < number_of_channels; channel++) {
-
-            if (channel >= range_start && channel <= range_stop) {
-                //Cut channel
-                compare_mask_bit = 1 << (channel % 32);
-                mask_index = 0 + (channel / 32);
-
-                if (channel_info->channel_mask[mask_index] & compare_mask_bit) {
-                    channel_info->channel_mask[mask_index] ^= compare_mask_bit;
-                    channel_info->channel_count--;
-                }
-            } else if (channel > range_stop) {
-                break;
-            }
+        if (range_stop >= number_of_channels) {
+            range_stop = number_of_channels - 1;
+        }
+        if (number_of_channels && range_start <= range_stop) {
+            //Cut channels
+            channel_info->channel_count -= channel_list_clear_range(channel_info->channel_mask, range_start, range_stop);
         }
     }
 }
 
 static uint32_t ws_reserve_order_32_bit(uint32_t value)
 {
-    uint32_t ret_val = 0;
-    for (uint8_t i = 0; i < 32; i++) {
-        if ((value & (1 << i))) {
-            ret_val |= 1 << ((32 - 1) - i);
-        }
-    }
-    return ret_val;
+    value = ((value >> 1) & 0x55555555) | ((value & 0x55555555) << 1);
+    value = ((value >> 2) & 0x33333333) | ((value & 0x33333333) << 2);
+    value = ((value >> 4) & 0x0F0F0F0F) | ((value & 0x0F0F0F0F) << 4);
+    value = ((value >> 8) & 0x00FF00FF) | ((value & 0x00FF00FF) << 8);
+    return (value >> 16) | (value << 16);
 }
 
 static void ws_neighbour_excluded_mask_by_mask(ws_channel_mask_t *channel_info, ws_excluded_channel_mask_t *mask_info, uint16_t number_of_channels)
@@ -201,7 +190,7 @@ static void ws_neighbour_excluded_mask_by_mask(ws_channel_mask_t *channel_info,
 
     uint16_t channel_at_mask;
     uint8_t mask_index = 0;
-    uint32_t channel_compare_mask, compare_mask_bit;
+    uint32_t channel_compare_mask;
     uint8_t *mask_ptr =  mask_info->channel_mask;
 
     channel_at_mask = mask_info->mask_len_inline * 8;
@@ -222,22 +211,15 @@ static void ws_neighbour_excluded_mask_by_mask(ws_channel_mask_t *channel_info,
             uint8_t move_mask = 0;
             //Convert 8-24bit to 32-bit
             while (channel_at_mask) {
-                channel_compare_mask |= (uint32_t)(*mask_ptr++ << (24 - move_mask));
+                channel_compare_mask |= (uint32_t) *mask_ptr++ << (24 - move_mask);
                 channel_at_mask -= 8;
                 move_mask += 8;
             }
         }
         //Reserve bit order for compare
         channel_compare_mask = ws_reserve_order_32_bit(channel_compare_mask);
-        //Compare now 32-bit mask's bits one by one
-        for (uint8_t i = 0; i < 32; i++) {
-            //Start from MSB
-            compare_mask_bit = 1 << (i);
-            if ((channel_compare_mask & compare_mask_bit) && (channel_info->channel_mask[mask_index] & compare_mask_bit)) {
-                channel_info->channel_mask[mask_index] ^= compare_mask_bit;
-                channel_info->channel_count--;
-            }
-        }
+        //Cut all excluded channels of the word at once
+        channel_info->channel_count -= channel_list_clear_word(channel_info->channel_mask, mask_index, channel_compare_mask);
         //Stop compare if all bits in line are compared
         if (channel_at_mask == 0) {
             break;
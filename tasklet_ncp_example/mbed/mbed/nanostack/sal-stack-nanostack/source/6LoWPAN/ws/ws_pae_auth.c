@@ -41,6 +41,8 @@
 #include "Security/protocols/eap_tls_sec_prot/auth_eap_tls_sec_prot.h"
 #include "Security/protocols/eap_tls_sec_prot/radius_eap_tls_sec_prot.h"
 #include "Security/protocols/tls_sec_prot/tls_sec_prot.h"
+#include "Security/protocols/tls_sec_prot/tls_sec_prot_lib.h"
+#include "Security/protocols/tls_sec_prot/tls_sec_prot_session_cache.h"
 #include "Security/protocols/fwh_sec_prot/auth_fwh_sec_prot.h"
 #include "Security/protocols/gkh_sec_prot/auth_gkh_sec_prot.h"
 #include "Security/protocols/radius_sec_prot/radius_client_sec_prot.h"
@@ -452,6 +454,12 @@ int8_t ws_pae_auth_node_keys_remove(protocol_interface_info_entry_t *interface_p
         ret_value = 0;
     }
 
+    // Revoked supplicant must do full TLS handshake i.e. present its certificate again
+    if (tls_sec_prot_session_cache_supp_delete(eui_64)) {
+        tr_info("Access revoked; TLS session deleted, eui-64: %s", trace_array(eui_64, 8));
+        ret_value = 0;
+    }
+
     return ret_value;
 }
 
@@ -807,6 +815,9 @@ void ws_pae_auth_slow_timer(uint16_t seconds)
 
     // Update key storage timer
     ws_pae_key_storage_timer(seconds);
+
+    // Update TLS session lifetimes
+    tls_sec_prot_session_cache_timer(seconds);
 }
 
 static void ws_pae_auth_gtk_key_insert(pae_auth_t *pae_auth)
@@ -39,6 +39,8 @@
 #include "6LoWPAN/ws/ws_pae_nvm_data.h"
 #include "6LoWPAN/ws/ws_pae_time.h"
 #include "6LoWPAN/ws/ws_pae_key_storage.h"
+#include "Security/protocols/tls_sec_prot/tls_sec_prot_lib.h"
+#include "Security/protocols/tls_sec_prot/tls_sec_prot_session_cache.h"
 #include "mbedtls/sha256.h"
 #ifndef NV_RESTORE
 #include "Service_Libs/utils/ns_file.h"
@@ -77,6 +79,7 @@ typedef struct {
     nw_key_t nw_key[GTK_NUM];                                        /**< Currently active network keys (on MAC) */
     uint16_t frame_cnt_store_timer;                                  /**< Timer to check if storing of frame counter value is needed */
     uint32_t frame_cnt_store_force_timer;                            /**< Timer to force storing of frame counter, if no other updates */
+    uint16_t tls_session_store_timer;                                /**< Timer to check if storing of TLS session cache is needed */
     frame_counters_t frame_counters;                                 /**< Frame counters */
     sec_cfg_t sec_cfg;                                               /**< Security configuration (configuration set values) */
     uint32_t restart_cnt;                                            /**< Re-start counter */
@@ -127,6 +130,9 @@ static void ws_pae_controller_frame_counter_timer(uint16_t seconds, pae_controll
 static void ws_pae_controller_frame_counter_timer_trigger(uint16_t seconds, pae_controller_t *entry);
 static void ws_pae_controller_frame_counter_store(pae_controller_t *entry, bool use_threshold);
 static void ws_pae_controller_nvm_frame_counter_write(frame_cnt_nvm_tlv_t *tlv_entry);
+static void ws_pae_controller_tls_session_cache_timer(uint16_t seconds, pae_controller_t *entry);
+static void ws_pae_controller_tls_session_cache_store(void);
+static int8_t ws_pae_controller_nvm_tls_session_cache_read(void);
 static int8_t ws_pae_controller_nvm_frame_counter_read(uint32_t *restart_cnt, uint64_t *stored_time, uint16_t *pan_version, frame_counters_t *counters);
 static pae_controller_t *ws_pae_controller_get_or_create(int8_t interface_id);
 static void ws_pae_controller_gtk_hash_set(protocol_interface_info_entry_t *interface_ptr, uint8_t *gtkhash);
@@ -149,6 +155,7 @@ static int8_t ws_pae_controller_nvm_nw_info_read(protocol_interface_info_entry_t
 
 static const char *FRAME_COUNTER_FILE = FRAME_COUNTER_FILE_NAME;
 static const char *NW_INFO_FILE = NW_INFO_FILE_NAME;
+static const char *TLS_SESSION_CACHE_FILE = TLS_SESSION_CACHE_FILE_NAME;
 
 static NS_LIST_DEFINE(pae_controller_list, pae_controller_t, link);
 
@@ -789,6 +796,7 @@ static void ws_pae_controller_data_init(pae_controller_t *controller)
     controller->gtk_index = -1;
     controller->frame_cnt_store_timer = FRAME_COUNTER_STORE_INTERVAL;
     controller->frame_cnt_store_force_timer = FRAME_COUNTER_STORE_FORCE_INTERVAL;
+    controller->tls_session_store_timer = TLS_SESSION_CACHE_STORE_INTERVAL;
     controller->restart_cnt = 0;
     controller->auth_started = false;
     ws_pae_controller_frame_counter_reset(&controller->frame_counters);
@@ -1016,6 +1024,14 @@ int8_t ws_pae_controller_auth_init(protocol_interface_info_entry_t *interface_pt
         ws_pae_key_storage_remove();
     }
 
+    tls_sec_prot_session_cache_init(TLS_SESSION_CACHE_SIZE);
+    if (read_gtks_to) {
+        ws_pae_controller_nvm_tls_session_cache_read();
+    } else {
+        // Key material invalid, delete TLS sessions
+        ws_pae_nvm_store_tlv_file_remove(TLS_SESSION_CACHE_FILE);
+    }
+
     return 0;
 }
 
@@ -1038,6 +1054,10 @@ int8_t ws_pae_controller_stop(protocol_interface_info_entry_t *interface_ptr)
     // Delete key storage
     ws_pae_key_storage_delete();
 
+    // Store TLS session cache if it has been modified and delete it
+    ws_pae_controller_tls_session_cache_store();
+    tls_sec_prot_session_cache_delete();
+
     // If PAE has been initialized, deletes it
     if (controller->pae_delete) {
         controller->pae_delete(interface_ptr);
@@ -1104,6 +1124,9 @@ int8_t ws_pae_controller_certificate_chain_set(const arm_certificate_chain_entry
         entry->certs.own_cert_chain_len = sec_prot_certs_cert_chain_entry_len_get(&entry->certs.own_cert_chain);
     }
 
+    // Sessions established with previous trusted certificate must not be resumed
+    tls_sec_prot_session_cache_flush();
+
     return 0;
 }
 
@@ -1164,6 +1187,10 @@ int8_t ws_pae_controller_trusted_certificate_add(const arm_certificate_entry_s *
         ret = 0;
     }
 
+    if (ret == 0) {
+        tls_sec_prot_session_cache_flush();
+    }
+
     return ret;
 }
 
@@ -1188,6 +1215,10 @@ int8_t ws_pae_controller_trusted_certificate_remove(const arm_certificate_entry_
 
     sec_prot_certs_chain_entry_delete(trusted_cert);
 
+    if (ret == 0) {
+        tls_sec_prot_session_cache_flush();
+    }
+
     return ret;
 }
 
@@ -1197,6 +1228,8 @@ int8_t ws_pae_controller_trusted_certificates_remove(void)
         sec_prot_certs_chain_list_delete(&entry->certs.trusted_cert_chain_list);
     }
 
+    tls_sec_prot_session_cache_flush();
+
     return 0;
 }
 
@@ -1221,6 +1254,11 @@ int8_t ws_pae_controller_certificate_revocation_list_add(const arm_cert_revocati
         ret = 0;
     }
 
+    // Sessions of revoked certificates must not be resumed
+    if (ret == 0) {
+        tls_sec_prot_session_cache_flush();
+    }
+
     return ret;
 }
 
@@ -1245,6 +1283,10 @@ int8_t ws_pae_controller_certificate_revocation_list_remove(const arm_cert_revoc
 
     sec_prot_certs_revocat_list_entry_delete(cert_revoc_list);
 
+    if (ret == 0) {
+        tls_sec_prot_session_cache_flush();
+    }
+
     return ret;
 }
 
@@ -1623,6 +1665,8 @@ int8_t ws_pae_controller_ext_certificate_validation_set(int8_t interface_id, boo
 
     sec_prot_certs_ext_certificate_validation_set(&controller->certs, enabled);
 
+    tls_sec_prot_session_cache_flush();
+
     return 0;
 #else
     (void) interface_id;
@@ -1725,6 +1769,7 @@ void ws_pae_controller_slow_timer(uint16_t seconds)
             entry->pae_slow_timer(seconds);
         }
         ws_pae_controller_frame_counter_timer(seconds, entry);
+        ws_pae_controller_tls_session_cache_timer(seconds, entry);
     }
 
     ws_pae_current_time_update(seconds);
@@ -1747,6 +1792,16 @@ static void ws_pae_controller_frame_counter_timer(uint16_t seconds, pae_controll
     }
 }
 
+static void ws_pae_controller_tls_session_cache_timer(uint16_t seconds, pae_controller_t *entry)
+{
+    if (entry->tls_session_store_timer > seconds) {
+        entry->tls_session_store_timer -= seconds;
+    } else {
+        entry->tls_session_store_timer = TLS_SESSION_CACHE_STORE_INTERVAL;
+        ws_pae_controller_tls_session_cache_store();
+    }
+}
+
 static void ws_pae_controller_frame_counter_timer_trigger(uint16_t seconds, pae_controller_t *entry)
 {
     if (entry->frame_cnt_store_timer > seconds) {
@@ -1894,5 +1949,46 @@ static void ws_pae_controller_nvm_frame_counter_write(frame_cnt_nvm_tlv_t *tlv_e
 
 }
 
+static void ws_pae_controller_tls_session_cache_store(void)
+{
+    if (tls_sec_prot_session_cache_size_get() == 0 || !tls_sec_prot_session_cache_updated_get()) {
+        return;
+    }
+
+    nvm_tlv_t *tlv = ws_pae_nvm_store_generic_tlv_allocate_and_create(
+                         PAE_NVM_TLS_SESSION_CACHE_TAG, PAE_NVM_TLS_SESSION_CACHE_LEN);
+    if (!tlv) {
+        return;
+    }
+
+    ws_pae_nvm_store_tls_session_cache_tlv_create(tlv);
+    if (ws_pae_nvm_store_tlv_file_write(TLS_SESSION_CACHE_FILE, tlv) >= 0) {
+        tls_sec_prot_session_cache_updated_reset();
+    }
+
+    // Clears also the master secrets
+    memset(tlv, 0, sizeof(nvm_tlv_t) + PAE_NVM_TLS_SESSION_CACHE_LEN);
+    ws_pae_nvm_store_generic_tlv_free(tlv);
+}
+
+static int8_t ws_pae_controller_nvm_tls_session_cache_read(void)
+{
+    nvm_tlv_t *tlv = ws_pae_nvm_store_generic_tlv_allocate_and_create(
+                         PAE_NVM_TLS_SESSION_CACHE_TAG, PAE_NVM_TLS_SESSION_CACHE_LEN);
+    if (!tlv) {
+        return -1;
+    }
+
+    int8_t ret = -1;
+    if (ws_pae_nvm_store_tlv_file_read(TLS_SESSION_CACHE_FILE, tlv) >= 0) {
+        ret = ws_pae_nvm_store_tls_session_cache_tlv_read(tlv);
+    }
+
+    memset(tlv, 0, sizeof(nvm_tlv_t) + PAE_NVM_TLS_SESSION_CACHE_LEN);
+    ws_pae_nvm_store_generic_tlv_free(tlv);
+
+    return ret;
+}
+
 #endif /* HAVE_WS */
 
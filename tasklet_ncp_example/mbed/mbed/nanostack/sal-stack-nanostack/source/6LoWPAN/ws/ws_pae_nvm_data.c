@@ -30,6 +30,8 @@
 #include "6LoWPAN/ws/ws_pae_nvm_data.h"
 #include "6LoWPAN/ws/ws_pae_controller.h"
 #include "6LoWPAN/ws/ws_pae_time.h"
+#include "Security/protocols/tls_sec_prot/tls_sec_prot_lib.h"
+#include "Security/protocols/tls_sec_prot/tls_sec_prot_session_cache.h"
 #ifndef NV_RESTORE
 #include "Service_Libs/utils/ns_file.h"
 #include "ns_file_system.h"
@@ -416,5 +418,92 @@ int8_t ws_pae_nvm_store_key_storage_tlv_read(nvm_tlv_t *tlv_entry, uint16_t leng
     return 0;
 }
 
+void ws_pae_nvm_store_tls_session_cache_tlv_create(nvm_tlv_t *tlv_entry)
+{
+    tlv_entry->tag = PAE_NVM_TLS_SESSION_CACHE_TAG;
+    tlv_entry->len = PAE_NVM_TLS_SESSION_CACHE_LEN;
+
+    uint8_t *tlv = ((uint8_t *) &tlv_entry->tag) + NVM_TLV_FIXED_LEN;
+
+    uint64_t stored_time = ws_pae_current_time_get();
+    tlv = common_write_64_bit(stored_time, tlv);
+
+    for (uint16_t index = 0; index < TLS_SESSION_CACHE_SIZE; index++) {
+        uint8_t eui_64[8];
+        tls_sec_prot_lib_session_t session;
+        uint32_t lifetime;
+
+        // Entry not set
+        if (tls_sec_prot_session_cache_entry_get(index, eui_64, &session, &lifetime) < 0) {
+            memset(tlv, 0, PAE_NVM_TLS_SESSION_LEN);
+            tlv += PAE_NVM_TLS_SESSION_LEN;
+            continue;
+        }
+
+        memcpy(tlv, eui_64, 8);
+        tlv += 8;
+        *tlv++ = session.id_len;
+        memcpy(tlv, session.id, TLS_SESSION_ID_LEN);
+        tlv += TLS_SESSION_ID_LEN;
+        memcpy(tlv, session.master, TLS_MASTER_SECRET_LEN);
+        tlv += TLS_MASTER_SECRET_LEN;
+        tlv = common_write_16_bit(session.ciphersuite, tlv);
+        tlv = common_write_32_bit(lifetime, tlv);
+
+        memset(&session, 0, sizeof(tls_sec_prot_lib_session_t));
+    }
+
+    tr_debug("NVM TLS SESSION CACHE write");
+}
+
+int8_t ws_pae_nvm_store_tls_session_cache_tlv_read(nvm_tlv_t *tlv_entry)
+{
+    if (!tlv_entry) {
+        return -1;
+    }
+
+    if (tlv_entry->tag != PAE_NVM_TLS_SESSION_CACHE_TAG || tlv_entry->len != PAE_NVM_TLS_SESSION_CACHE_LEN) {
+        return -1;
+    }
+
+    uint8_t *tlv = ((uint8_t *) &tlv_entry->tag) + NVM_TLV_FIXED_LEN;
+
+    uint64_t stored_time = common_read_64_bit(tlv);
+    tlv += 8;
+
+    uint64_t current_time = ws_pae_current_time_get();
+    uint64_t elapsed_time = 0;
+    if (current_time > stored_time) {
+        elapsed_time = current_time - stored_time;
+    }
+
+    for (uint16_t index = 0; index < TLS_SESSION_CACHE_SIZE; index++) {
+        uint8_t *eui_64 = tlv;
+        tls_sec_prot_lib_session_t session;
+
+        session.id_len = tlv[8];
+        memcpy(session.id, &tlv[8 + 1], TLS_SESSION_ID_LEN);
+        memcpy(session.master, &tlv[8 + 1 + TLS_SESSION_ID_LEN], TLS_MASTER_SECRET_LEN);
+        session.ciphersuite = common_read_16_bit(&tlv[8 + 1 + TLS_SESSION_ID_LEN + TLS_MASTER_SECRET_LEN]);
+        uint32_t lifetime = common_read_32_bit(&tlv[8 + 1 + TLS_SESSION_ID_LEN + TLS_MASTER_SECRET_LEN + 2]);
+        tlv += PAE_NVM_TLS_SESSION_LEN;
+
+        // Entry not set, invalid or expired
+        if (session.id_len == 0 || session.id_len > TLS_SESSION_ID_LEN || lifetime <= elapsed_time) {
+            memset(&session, 0, sizeof(tls_sec_prot_lib_session_t));
+            continue;
+        }
+
+        tls_sec_prot_session_cache_write(eui_64, &session, lifetime - elapsed_time);
+        memset(&session, 0, sizeof(tls_sec_prot_lib_session_t));
+    }
+
+    tls_sec_prot_session_cache_updated_reset();
+
+    tr_debug("NVM TLS SESSION CACHE read");
+
+    return 0;
+}
+
 #endif /* HAVE_WS */
 
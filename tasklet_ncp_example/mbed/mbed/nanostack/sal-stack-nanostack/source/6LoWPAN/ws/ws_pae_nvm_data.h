@@ -28,6 +28,7 @@
 #define NW_INFO_FILE_NAME               "pae_nw_info"
 #define KEYS_FILE_NAME                  "pae_keys"
 #define FRAME_COUNTER_FILE_NAME         "pae_frame_counter"
+#define TLS_SESSION_CACHE_FILE_NAME     "pae_tls_sessions"
 
 // This tag will be used as item ID with TI NVS driver APIs
 #define PAE_NVM_NW_INFO_TAG              1
@@ -35,6 +36,8 @@
 #define PAE_NVM_FRAME_COUNTER_TAG        3
 #define PAE_NVM_KEY_STORAGE_INDEX_TAG    4
 #define PAE_NVM_KEY_STORAGE_TAG          5
+// Tag 6 is used by border router information (ws_bbr_api.c)
+#define PAE_NVM_TLS_SESSION_CACHE_TAG    7
 
 // pan_id (2) +  network name (33) + GTK EUI-64 (own EUI-64) (8) + (GTK set (1) + GTK expiry timestamp (8) + status (1) + install order (1) + GTK (16)) * 4
 #define PAE_NVM_NW_INFO_LEN              2 + 33 + 8 + (1 + 8 + 1 + 1 + GTK_LEN) * GTK_NUM
@@ -50,6 +53,10 @@
 // key storage index bitfield (8)
 #define PAE_NVM_KEY_STORAGE_INDEX_LEN    8
 
+// stored time (8) + (EUI-64 (8) + session id length (1) + session id (32) + master secret (48) + ciphersuite (2) + lifetime (4)) * cache size
+#define PAE_NVM_TLS_SESSION_LEN          (8 + 1 + TLS_SESSION_ID_LEN + TLS_MASTER_SECRET_LEN + 2 + 4)
+#define PAE_NVM_TLS_SESSION_CACHE_LEN    (8 + PAE_NVM_TLS_SESSION_LEN * TLS_SESSION_CACHE_SIZE)
+
 typedef struct nw_info_nvm_tlv {
     uint16_t tag;                             /**< Unique tag */
     uint16_t len;                             /**< Number of the bytes after the length field */
@@ -207,6 +214,27 @@ void ws_pae_nvm_store_key_storage_tlv_create(nvm_tlv_t *tlv_entry, uint16_t leng
  */
 int8_t ws_pae_nvm_store_key_storage_tlv_read(nvm_tlv_t *tlv_entry, uint16_t length);
 
+/**
+ * ws_pae_nvm_store_tls_session_cache_tlv_create create NVM TLS session cache TLV
+ *
+ * \param tlv_entry TLV entry, PAE_NVM_TLS_SESSION_CACHE_LEN data bytes
+ *
+ */
+void ws_pae_nvm_store_tls_session_cache_tlv_create(nvm_tlv_t *tlv_entry);
+
+/**
+ * ws_pae_nvm_store_tls_session_cache_tlv_read read NVM TLS session cache TLV to session cache
+ *
+ * Lifetimes of the sessions are decremented by the time elapsed since storing.
+ *
+ * \param tlv_entry TLV entry
+ *
+ * \return < 0 failure
+ * \return >= 0 success
+ *
+ */
+int8_t ws_pae_nvm_store_tls_session_cache_tlv_read(nvm_tlv_t *tlv_entry);
+
 nvm_tlv_t *ws_pae_buffer_allocate(void);
 
 #endif /* WS_PAE_NVM_DATA_H_ */
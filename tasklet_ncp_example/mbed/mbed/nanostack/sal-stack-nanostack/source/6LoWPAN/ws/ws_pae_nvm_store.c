@@ -168,6 +168,10 @@ int8_t ws_pae_nvm_store_tlv_file_remove(const char *file)
         tag = 6;
     }
 #endif
+    else if(0 == strcmp(file, TLS_SESSION_CACHE_FILE_NAME))
+    {
+        tag = 7;
+    }
 
     if(tag != 0)
     {
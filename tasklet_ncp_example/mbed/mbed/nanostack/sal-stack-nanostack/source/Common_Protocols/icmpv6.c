@@ -53,7 +53,7 @@
 static buffer_t *icmpv6_echo_request_handler(struct buffer *buf);
 
 #ifdef WISUN_NCP_ENABLE
-extern void nanostack_process_stream_net_from_stack(buffer_t* buf);
+extern buffer_t *nanostack_process_stream_net_from_stack(buffer_t *buf);
 #endif
 
 /* Check to see if a message is recognisable ICMPv6, and if so, fill in code/type */
@@ -134,9 +134,7 @@ buffer_t *icmpv6_error(buffer_t *buf, protocol_interface_info_entry_t *cur, uint
     if ((type == ICMPV6_TYPE_ERROR_DESTINATION_UNREACH) &&
         (addr_ipv6_scope(buf->dst_sa.address, buf->interface) > IPV6_SCOPE_REALM_LOCAL))
     {
-        nanostack_process_stream_net_from_stack(buf);
-        buffer_free(buf);
-        return NULL;
+        return nanostack_process_stream_net_from_stack(buf);
     }
 #endif
 
@@ -1128,9 +1126,7 @@ buffer_t *icmpv6_up(buffer_t *buf)
         num_icmp_packet_to_host++;
         tr_debug("ICMP echo reply to Host (%d)", num_icmp_packet_to_host);
 #endif
-        nanostack_process_stream_net_from_stack(buf);
-        buffer_free(buf);
-        return NULL;
+        return nanostack_process_stream_net_from_stack(buf);
     }
 #endif
 
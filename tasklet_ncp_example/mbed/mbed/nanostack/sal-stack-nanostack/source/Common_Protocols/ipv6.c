@@ -35,6 +35,7 @@
 #include "Common_Protocols/icmpv6.h"
 #include "Common_Protocols/ipv6_resolution.h"
 #include "Common_Protocols/ipv6_flow.h"
+#include "RPL/rpl_protocol.h"
 #include "RPL/rpl_data.h"
 #ifdef HAVE_MPL
 #include "MPL/mpl.h"
@@ -1045,6 +1046,164 @@ static buffer_t *ipv6_consider_forwarding_unicast_packet(buffer_t *buf, protocol
     return buf;
 }
 
+/* Input: the first fragment of a 6LoWPAN datagram, decompressed to IPv6 but
+ *        holding only the headers and the start of the payload (so Payload
+ *        Length describes this fragment, not the datagram).
+ *        Buffer source + destination = link-layer addresses.
+ * Output: The same forwarding decision and extension header update as
+ *        ipv6_consider_forwarding_unicast_packet() and ipv6_forwarding_down(),
+ *        with buf->route set, ready for lowpan_down().
+ *
+ * Anything we can't do to a partial datagram - it's for us, multicast, it
+ * carries a routing header, the routing code wants to tunnel it, next hop not
+ * yet resolved - frees the buffer and returns NULL without sending ICMP
+ * errors. The caller then reassembles the datagram so the normal path can
+ * deal with it. Checks that need nothing but the headers are made before the
+ * RPL option is processed, and the rest only touch this buffer, so a datagram
+ * that falls back is not acted on twice. The interface forwarding callback is
+ * left to the caller, once the fragment is sure to be sent.
+ */
+buffer_t *ipv6_forwarding_first_fragment(buffer_t *buf, uint16_t datagram_size)
+{
+    protocol_interface_info_entry_t *cur = buf->interface;
+    uint8_t *ptr = buffer_data_pointer(buf);
+    uint16_t len = buffer_data_length(buf);
+
+    if (!cur || !cur->ip_forwarding || cur->if_special_forwarding ||
+            len < IPV6_HDRLEN || (*ptr >> 4) != 6 ||
+            buf->options.ll_security_bypass_rx || buf->options.ll_not_ours_rx ||
+            buf->options.ll_multicast_rx || buf->options.ll_broadcast_rx) {
+        goto fallback;
+    }
+
+    buf->options.traffic_class = (ptr[0] << 4) | (ptr[1] >> 4);
+    buf->options.ip_extflags = 0;
+    uint8_t nh = ptr[IPV6_HDROFF_NH];
+    buf->options.type = nh;
+    buf->options.code = 0;
+    buf->options.hop_limit = ptr[IPV6_HDROFF_HOP_LIMIT];
+
+    sockaddr_t ll_src = buf->src_sa;
+    buf->src_sa.addr_type = ADDR_IPV6;
+    memcpy(buf->src_sa.address, ptr + IPV6_HDROFF_SRC_ADDR, 16);
+    buf->dst_sa.addr_type = ADDR_IPV6;
+    memcpy(buf->dst_sa.address, ptr + IPV6_HDROFF_DST_ADDR, 16);
+
+    if (addr_is_ipv6_multicast(buf->src_sa.address) ||
+            addr_is_ipv6_multicast(buf->dst_sa.address) ||
+            addr_is_ipv6_loopback(buf->src_sa.address) ||
+            addr_is_ipv6_loopback(buf->dst_sa.address) ||
+            addr_is_ipv6_unspecified(buf->src_sa.address) ||
+            ipv6_packet_is_for_us(buf)) {
+        goto fallback;
+    }
+
+    /* Only a RPL option (and padding) is allowed in a Hop-by-Hop header -
+     * we are not going to send Parameter Problems for a fragment. IPHC has
+     * already required the whole header to be in this fragment.
+     */
+    uint8_t *hdr = ptr + IPV6_HDRLEN;
+    uint8_t *rpl_opt = NULL;
+    if (nh == IPV6_NH_HOP_BY_HOP) {
+        if (len < IPV6_HDRLEN + 8 || len < IPV6_HDRLEN + (hdr[1] + 1) * 8) {
+            goto fallback;
+        }
+        uint8_t *opt = hdr + 2;
+        const uint8_t *const end = hdr + (hdr[1] + 1) * 8;
+        while (opt < end) {
+            if (opt[0] == IPV6_OPTION_PAD1) {
+                opt++;
+                continue;
+            }
+            if (opt + 2 > end || opt + 2 + opt[1] > end) {
+                goto fallback;
+            }
+            switch (opt[0]) {
+                case IPV6_OPTION_PADN:
+                    break;
+#ifdef HAVE_RPL
+                case IPV6_OPTION_RPL:
+                    /* A Forwarding-Error acts on the routing table, and a
+                     * second Rank-Error reports a loop - let the reassembled
+                     * packet do that, once.
+                     */
+                    if (!cur->rpl_domain || opt[1] < 4 || rpl_opt ||
+                            (opt[2] & (RPL_OPT_FWD_ERROR | RPL_OPT_RANK_ERROR))) {
+                        goto fallback;
+                    }
+                    rpl_opt = opt;
+                    break;
+#endif
+                default:
+                    goto fallback;
+            }
+            opt += 2 + opt[1];
+        }
+        nh = hdr[0];
+    }
+
+    /* Source routing rewrites the destination - leave it to reassembly */
+    if (nh == IPV6_NH_ROUTING) {
+        goto fallback;
+    }
+
+    /* Hop Limit expiry gets its ICMP error from the reassembled packet */
+    if (buf->options.hop_limit <= 1) {
+        goto fallback;
+    }
+
+#ifdef HAVE_RPL
+    /* Only sets up this buffer for the route lookup now */
+    if (rpl_opt && !rpl_data_process_hbh(buf, cur, rpl_opt + 2, &ll_src)) {
+        goto fallback;
+    }
+#endif
+
+    buffer_note_predecessor(buf, &ll_src);
+
+    buf->ip_routed_up = true;
+    ptr[IPV6_HDROFF_HOP_LIMIT] = --buf->options.hop_limit;
+
+    /* Stay on this interface - a different link has a different MTU and
+     * header compression contexts.
+     */
+    buffer_routing_info_t *routing = ipv6_buffer_route(buf);
+    if (!routing || buf->interface != cur || routing->route_info.pmtu < datagram_size) {
+        goto fallback;
+    }
+
+#ifdef HAVE_RPL
+    /* RPL tunnels a packet that lacks its option */
+    bool rpl_route = rpl_data_is_rpl_route(routing->route_info.source);
+    if ((buf->options.ip_extflags & IPEXT_HBH_RPL) ? !rpl_route : rpl_route) {
+        goto fallback;
+    }
+#endif
+
+    /* lowpan_down() would queue us behind address resolution */
+    addrtype_t ll_type;
+    const uint8_t *ll_addr;
+    if (!addr_is_ipv6_multicast(routing->route_info.next_hop_addr) &&
+            !ipv6_map_ip_to_ll(cur, NULL, routing->route_info.next_hop_addr, &ll_type, &ll_addr)) {
+        goto fallback;
+    }
+
+    int16_t exthdr_result;
+    buf = ipv6_get_exthdrs(buf, IPV6_EXTHDR_MODIFY, &exthdr_result);
+    if (!buf) {
+        return NULL;
+    }
+    if (exthdr_result != 0) {
+        goto fallback;
+    }
+
+    buf->info = (buffer_info_t)(B_DIR_DOWN | B_FROM_IPV6_FWD | B_TO_IPV6_TXRX);
+    return buf;
+
+fallback:
+    return buffer_free(buf);
+}
+
 void ipv6_transmit_multicast_on_interface(buffer_t *buf, protocol_interface_info_entry_t *cur)
 {
     /* Mess with routing to get this to go out the correct interface */
@@ -1211,6 +1370,12 @@ no_forward:
 #ifdef WISUN_FAN_DEBUG
 volatile uint_fast32_t num_ip_packet_from_host = 0;
 #endif
+/* Headroom for packets from host, so that the IPv6-in-IPv6 tunnel header,
+ * RPL source routing header (8 hops with elided prefix) and RPL hop-by-hop
+ * option added when routing down the DODAG fit without reallocating.
+ */
+#define NCP_HOST_PACKET_HEADROOM    (IPV6_HDRLEN + 8 * 8 + 8 + 8)
+
 otError nanostack_process_stream_net_from_host(uint8_t* framePtr, uint16_t payload_length)
 {
     buffer_t *buf = NULL;
@@ -1219,20 +1384,22 @@ otError nanostack_process_stream_net_from_host(uint8_t* framePtr, uint16_t paylo
 #ifdef WISUN_FAN_DEBUG
     num_ip_packet_from_host++;
 #endif
-    /* get the buffer allocated */
-    buf = buffer_get(payload_length);
-    if (!buf) {
-        return OT_ERROR_NO_BUFS;
+    if (payload_length < IPV6_HDRLEN || (*framePtr >> 4) != 6) {
+        return OT_ERROR_INVALID_ARGS;
     }
 
-    buf->interface = global_interface_ptr; //protocol_stack_interface_info_get_by_id(IF_6LoWPAN);
-    if(!buf->interface)
-    {
-        buffer_free(buf);
+    if (!global_interface_ptr) {
         /** Wi-SUN protocol interface is not up yet **/
         return OT_ERROR_INVALID_STATE;
     }
 
+    /* get the buffer allocated, packet is copied in once behind the headroom */
+    buf = buffer_get_specific(NCP_HOST_PACKET_HEADROOM, payload_length, 0);
+    if (!buf) {
+        return OT_ERROR_NO_BUFS;
+    }
+
+    buf->interface = global_interface_ptr; //protocol_stack_interface_info_get_by_id(IF_6LoWPAN);
     buffer_data_add(buf, framePtr, payload_length);
     buf->payload_length = payload_length;
     buf->ip_routed_up = true;
@@ -72,6 +72,7 @@ void ipv6_set_exthdr_provider(ipv6_route_src_t src, ipv6_exthdr_provider_fn_t *f
 extern buffer_t *ipv6_down(buffer_t *buf);
 extern buffer_t *ipv6_forwarding_down(buffer_t *buf);
 extern buffer_t *ipv6_forwarding_up(buffer_t *buf);
+extern buffer_t *ipv6_forwarding_first_fragment(buffer_t *buf, uint16_t datagram_size);
 
 void ipv6_transmit_multicast_on_interface(buffer_t *buf, struct protocol_interface_info_entry *cur);
 
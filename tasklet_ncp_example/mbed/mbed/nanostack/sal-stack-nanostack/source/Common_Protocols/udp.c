@@ -33,7 +33,7 @@
 #ifdef WISUN_NCP_ENABLE
 extern bool ncp_enabled;
 #include "6LoWPAN/ws/ws_common_defines.h"
-extern void nanostack_process_stream_net_from_stack(buffer_t* buf);
+extern buffer_t *nanostack_process_stream_net_from_stack(buffer_t *buf);
 /* IP Packets to these ports will be internally consumed and not sent to NCP */
 /* To add a port to list increment MAC_FILTER_PORTS and add the port to list */
 #ifndef WISUN_TEST_MPL_UDP
@@ -163,9 +163,7 @@ buffer_t *udp_up(buffer_t *buf)
 #ifdef WISUN_NCP_ENABLE
     if(!wisun_ncp_filter_udp_port(buf->dst_sa.port))
     {
-        nanostack_process_stream_net_from_stack(buf);
-        buffer_free(buf);
-        return NULL;
+        return nanostack_process_stream_net_from_stack(buf);
     }
 #endif
 
@@ -28,6 +28,7 @@
 #include "NWK_INTERFACE/Include/protocol_stats.h"
 #include "ip_fsc.h"
 #include "net_interface.h"
+#include "mac_mcps.h"
 
 #define TRACE_GROUP "buff"
 
@@ -114,6 +115,8 @@ buffer_t *buffer_get_specific(uint16_t headroom, uint16_t size, uint16_t minspac
         buf->options.flow_label = IPV6_FLOW_UNSPECIFIED;
         buf->options.hop_limit = 255;
         buf->options.mpl_permitted = true;
+        // Only set for frames received from the MAC, 0 is a valid channel
+        buf->options.channel = MCPS_CHANNEL_UNKNOWN;
         buf->link_specific.ieee802_15_4.useDefaultPanId = true;
 #ifndef NO_IPV6_PMTUD
         buf->options.ipv6_use_min_mtu = -1;
@@ -108,6 +108,7 @@ typedef union buffer_link_info {
 typedef struct buffer_options {
     uint8_t lqi;                        /*!< LQI from RF */
     int8_t  dbm;                        /*!< Signal level */
+    uint8_t channel;                    /*!< Radio channel the frame was received on, MCPS_CHANNEL_UNKNOWN if not received from the MAC */
     uint8_t hop_limit;                  /*!< IPv6 hop limit */
     uint8_t type;                       /*!< ICMP type, IP next header, MAC frame type... */
     uint8_t code;                       /*!< ICMP code, TCP flags, MAC ack request... */
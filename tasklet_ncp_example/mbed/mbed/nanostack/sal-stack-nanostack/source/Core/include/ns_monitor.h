@@ -27,6 +27,32 @@
 #ifndef _NS_MONITOR_H
 #define _NS_MONITOR_H
 
+#include "nsdynmemLIB.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Heap stats with fragmentation watermarks tracked by the monitor.
+ */
+typedef struct ns_monitor_heap_stat {
+    mem_stat_t mem_stat;                            /**< Heap usage, failure and slab counters. */
+    mem_hole_stat_t hole_stat;                      /**< Free hole stats of the last complete walk. */
+    ns_mem_heap_size_t largest_free_block_min;      /**< Smallest largest free block seen. */
+    ns_mem_heap_size_t hole_cnt_max;                /**< Largest free hole count seen. */
+} ns_monitor_heap_stat_t;
+
+/**
+ * Live heap usage of one allocation call site.
+ */
+typedef struct ns_monitor_heap_allocator {
+    const char *function;                           /**< Allocating function. */
+    uint16_t line;                                  /**< Line of the first tracked allocation. */
+    uint32_t alloc_count;                           /**< Allocations currently held. */
+    uint32_t total_memory;                          /**< Bytes currently held. */
+} ns_monitor_heap_allocator_t;
+
 int ns_monitor_init(void);
 
 int ns_monitor_clear(void);
@@ -39,6 +65,32 @@ int ns_monitor_packet_ingress_rate_limit_by_memory(uint32_t minimum_required, ui
 
 bool ns_monitor_packet_allocation_allowed(void);
 
+/**
+ * Read heap stats and fragmentation watermarks.
+ *
+ * Free hole stats are refreshed by walking the heap hole list.
+ *
+ * \param stat Pointer to structure where stats are written
+ * \return 0 on success, <0 if monitor is not running.
+ */
+int ns_monitor_heap_stat_get(ns_monitor_heap_stat_t *stat);
+
+/**
+ * Read call sites holding most heap allocations.
+ *
+ * Available when nsdynmem tracker is enabled (NSDYNMEM_TRACKER_ENABLED=1), the monitor
+ * then provides the tracker allocation hooks.
+ *
+ * \param list Array for call sites, ordered by allocation count
+ * \param count Number of entries in the array
+ * \return Number of entries written, <0 if not available.
+ */
+int ns_monitor_heap_allocators_get(ns_monitor_heap_allocator_t *list, uint8_t count);
+
+
+#ifdef __cplusplus
+}
+#endif
 
 #endif // _NS_MONITOR_H
 
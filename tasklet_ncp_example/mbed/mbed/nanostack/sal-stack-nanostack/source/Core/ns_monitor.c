@@ -24,9 +24,13 @@
  *  1. Heap usage is above HEAP_USAGE_HIGH
  *  2. Heap usage is above HEAP_USAGE_CRITICAL
  *  3. If nsdynmemLIB memory allocation has failed since last check
+ *
+ * It also keeps watermarks of heap fragmentation and, with nsdynmem tracker
+ * enabled, tracks heap usage per allocation call site.
  */
 #include "mbed_config.h"
 #include "nsconfig.h"
+#include <string.h>
 #include "ns_types.h"
 #define HAVE_DEBUG
 #include "ns_trace.h"
@@ -37,6 +41,18 @@
 #include "6LoWPAN/lowpan_adaptation_interface.h"
 #include "6LoWPAN/ws/ws_config.h"
 #include "NWK_INTERFACE/Include/protocol.h"
+#include "Core/include/ns_monitor.h"
+#include "platform/arm_hal_interrupt.h"
+#if NSDYNMEM_TRACKER_ENABLED==1
+#include "nsdynmem_tracker_lib.h"
+// Tracker hooks below forward to the heap itself
+#undef ns_dyn_mem_alloc
+#undef ns_dyn_mem_temporary_alloc
+#undef ns_dyn_mem_free
+void *ns_dyn_mem_alloc(ns_mem_block_size_t alloc_size);
+void *ns_dyn_mem_temporary_alloc(ns_mem_block_size_t alloc_size);
+void ns_dyn_mem_free(void *heap_ptr);
+#endif
 
 #define TRACE_GROUP "mntr"
 
@@ -57,6 +73,10 @@ typedef struct ns_monitor__s {
     ns_mem_heap_size_t heap_high_watermark;
     ns_mem_heap_size_t heap_critical_watermark;
     uint32_t prev_heap_alloc_fail_cnt;
+    uint32_t prev_heap_alloc_fail_frag_cnt;
+    ns_mem_heap_size_t largest_free_block_min;
+    ns_mem_heap_size_t hole_cnt_max;
+    mem_hole_stat_t hole_stat;      // Last complete walk of the free holes
     ns_monitor_state_e ns_monitor_heap_gc_state;
     const mem_stat_t *mem_stats;
     uint16_t ns_maintenance_timer;
@@ -118,8 +138,27 @@ static void ns_monitor_heap_gc(bool full_gc)
 #endif
 }
 
+// The walk runs in bounded critical sections and gives up if the heap keeps changing, the last stats are kept then
+static void ns_monitor_heap_hole_stat_update(void)
+{
+    mem_hole_stat_t hole_stat;
+    if (ns_dyn_mem_hole_stat_get(&hole_stat) != 0) {
+        return;
+    }
+
+    ns_monitor_ptr->hole_stat = hole_stat;
+    if (ns_monitor_ptr->largest_free_block_min > hole_stat.largest_free_block) {
+        ns_monitor_ptr->largest_free_block_min = hole_stat.largest_free_block;
+    }
+    if (ns_monitor_ptr->hole_cnt_max < hole_stat.hole_cnt) {
+        ns_monitor_ptr->hole_cnt_max = hole_stat.hole_cnt;
+    }
+}
+
 static void ns_monitor_periodic_heap_health_check(void)
 {
+    ns_monitor_heap_hole_stat_update();
+
     if (ns_monitor_ptr->mem_stats->heap_sector_allocated_bytes > ns_monitor_ptr->heap_critical_watermark) {
         // Heap usage above CRITICAL
         if (ns_monitor_ptr->ns_monitor_heap_gc_state != NS_MONITOR_STATE_GC_CRITICAL) {
@@ -152,6 +191,11 @@ void ns_monitor_timer(uint16_t seconds)
         if (ns_monitor_ptr->mem_stats->heap_alloc_fail_cnt > ns_monitor_ptr->prev_heap_alloc_fail_cnt) {
             // Heap allocation failure occurred since last check
             ns_monitor_ptr->prev_heap_alloc_fail_cnt = ns_monitor_ptr->mem_stats->heap_alloc_fail_cnt;
+            if (ns_monitor_ptr->mem_stats->heap_alloc_fail_frag_cnt > ns_monitor_ptr->prev_heap_alloc_fail_frag_cnt) {
+                // Failed although total free heap was large enough
+                ns_monitor_ptr->prev_heap_alloc_fail_frag_cnt = ns_monitor_ptr->mem_stats->heap_alloc_fail_frag_cnt;
+                tr_warn("heap fragmented %lu/%lu", (unsigned long)ns_monitor_ptr->mem_stats->heap_sector_allocated_bytes, (unsigned long)ns_monitor_ptr->mem_stats->heap_sector_size);
+            }
             if (ns_monitor_ptr->ns_monitor_heap_gc_state != NS_MONITOR_STATE_GC_CRITICAL) {
                 ns_monitor_ptr->ns_monitor_heap_gc_state = NS_MONITOR_STATE_GC_CRITICAL;
                 ns_monitor_heap_gc(true);
@@ -187,7 +231,11 @@ int ns_monitor_init(void)
                                                   );
         ns_monitor_ptr->ns_monitor_heap_gc_state = NS_MONITOR_STATE_HEAP_GC_IDLE;
         ns_monitor_ptr->ns_maintenance_timer = 0;
-        ns_monitor_ptr->prev_heap_alloc_fail_cnt = 0;
+        ns_monitor_ptr->prev_heap_alloc_fail_cnt = ns_monitor_ptr->mem_stats->heap_alloc_fail_cnt;
+        ns_monitor_ptr->prev_heap_alloc_fail_frag_cnt = ns_monitor_ptr->mem_stats->heap_alloc_fail_frag_cnt;
+        ns_monitor_ptr->largest_free_block_min = ns_monitor_ptr->mem_stats->heap_sector_size;
+        ns_monitor_ptr->hole_cnt_max = 0;
+        memset(&ns_monitor_ptr->hole_stat, 0, sizeof(mem_hole_stat_t));
         return 0;
     }
 
@@ -293,3 +341,138 @@ bool ns_monitor_packet_allocation_allowed(void)
     return true;
 }
 
+int ns_monitor_heap_stat_get(ns_monitor_heap_stat_t *stat)
+{
+    if (!ns_monitor_ptr || !stat) {
+        return -1;
+    }
+
+    platform_enter_critical();
+    stat->mem_stat = *ns_monitor_ptr->mem_stats;
+    platform_exit_critical();
+    ns_monitor_heap_hole_stat_update();
+    stat->hole_stat = ns_monitor_ptr->hole_stat;
+    stat->largest_free_block_min = ns_monitor_ptr->largest_free_block_min;
+    stat->hole_cnt_max = ns_monitor_ptr->hole_cnt_max;
+
+    return 0;
+}
+
+#if NSDYNMEM_TRACKER_ENABLED==1
+
+#define NS_MONITOR_TRACKER_BLOCKS_STEP  64
+#define NS_MONITOR_TOP_ALLOCATORS       8
+
+#if defined(__GNUC__)
+#define NS_MONITOR_CALLER_ADDR(function)    __builtin_return_address(0)
+#else
+#define NS_MONITOR_CALLER_ADDR(function)    ((void *) function)
+#endif
+
+static ns_dyn_mem_tracker_lib_mem_blocks_t *ns_monitor_tracker_mem_blocks_alloc(ns_dyn_mem_tracker_lib_mem_blocks_t *blocks, uint16_t *mem_blocks_count);
+static ns_dyn_mem_tracker_lib_mem_blocks_ext_t *ns_monitor_tracker_ext_mem_blocks_alloc(ns_dyn_mem_tracker_lib_mem_blocks_ext_t *blocks, uint32_t *mem_blocks_count);
+static uint32_t ns_monitor_tracker_block_index_hash(void *block, uint32_t ext_mem_blocks_count);
+
+static ns_dyn_mem_tracker_lib_allocators_t ns_monitor_top_allocators[NS_MONITOR_TOP_ALLOCATORS];
+
+static ns_dyn_mem_tracker_lib_conf_t ns_monitor_tracker_conf = {
+    .top_allocators = ns_monitor_top_allocators,
+    .top_allocators_count = NS_MONITOR_TOP_ALLOCATORS,
+    .alloc_mem_blocks = ns_monitor_tracker_mem_blocks_alloc,
+    .ext_alloc_mem_blocks = ns_monitor_tracker_ext_mem_blocks_alloc,
+    .block_index_hash = ns_monitor_tracker_block_index_hash,
+};
+
+// Grow tracker arrays in steps, on failure keep the old array so tracking of that allocation just fails
+static ns_dyn_mem_tracker_lib_mem_blocks_t *ns_monitor_tracker_mem_blocks_alloc(ns_dyn_mem_tracker_lib_mem_blocks_t *blocks, uint16_t *mem_blocks_count)
+{
+    uint16_t count = *mem_blocks_count + NS_MONITOR_TRACKER_BLOCKS_STEP;
+    ns_dyn_mem_tracker_lib_mem_blocks_t *new_blocks = ns_dyn_mem_alloc(count * sizeof(ns_dyn_mem_tracker_lib_mem_blocks_t));
+    if (!new_blocks) {
+        return blocks;
+    }
+
+    memset(new_blocks, 0, count * sizeof(ns_dyn_mem_tracker_lib_mem_blocks_t));
+    if (blocks) {
+        memcpy(new_blocks, blocks, *mem_blocks_count * sizeof(ns_dyn_mem_tracker_lib_mem_blocks_t));
+        ns_dyn_mem_free(blocks);
+    }
+    *mem_blocks_count = count;
+    return new_blocks;
+}
+
+static ns_dyn_mem_tracker_lib_mem_blocks_ext_t *ns_monitor_tracker_ext_mem_blocks_alloc(ns_dyn_mem_tracker_lib_mem_blocks_ext_t *blocks, uint32_t *mem_blocks_count)
+{
+    uint32_t count = *mem_blocks_count + NS_MONITOR_TRACKER_BLOCKS_STEP;
+    ns_dyn_mem_tracker_lib_mem_blocks_ext_t *new_blocks = ns_dyn_mem_alloc(count * sizeof(ns_dyn_mem_tracker_lib_mem_blocks_ext_t));
+    if (!new_blocks) {
+        return blocks;
+    }
+
+    memset(new_blocks, 0, count * sizeof(ns_dyn_mem_tracker_lib_mem_blocks_ext_t));
+    if (blocks) {
+        memcpy(new_blocks, blocks, *mem_blocks_count * sizeof(ns_dyn_mem_tracker_lib_mem_blocks_ext_t));
+        ns_dyn_mem_free(blocks);
+    }
+    *mem_blocks_count = count;
+    return new_blocks;
+}
+
+static uint32_t ns_monitor_tracker_block_index_hash(void *block, uint32_t ext_mem_blocks_count)
+{
+    return ((uintptr_t) block / sizeof(int)) % ext_mem_blocks_count;
+}
+
+void *ns_dyn_mem_tracker_dyn_mem_alloc(ns_mem_heap_size_t alloc_size, const char *function, uint32_t line)
+{
+    void *block = ns_dyn_mem_alloc(alloc_size);
+    ns_dyn_mem_tracker_lib_alloc(&ns_monitor_tracker_conf, NS_MONITOR_CALLER_ADDR(function), function, line, block, alloc_size);
+    return block;
+}
+
+void *ns_dyn_mem_tracker_dyn_mem_temporary_alloc(ns_mem_heap_size_t alloc_size, const char *function, uint32_t line)
+{
+    void *block = ns_dyn_mem_temporary_alloc(alloc_size);
+    ns_dyn_mem_tracker_lib_alloc(&ns_monitor_tracker_conf, NS_MONITOR_CALLER_ADDR(function), function, line, block, alloc_size);
+    return block;
+}
+
+void ns_dyn_mem_tracker_dyn_mem_free(void *block, const char *function, uint32_t line)
+{
+    ns_dyn_mem_tracker_lib_free(&ns_monitor_tracker_conf, NS_MONITOR_CALLER_ADDR(function), function, line, block);
+    ns_dyn_mem_free(block);
+}
+
+int ns_monitor_heap_allocators_get(ns_monitor_heap_allocator_t *list, uint8_t count)
+{
+    if (!list || !ns_monitor_tracker_conf.mem_blocks) {
+        return -1;
+    }
+
+    ns_dyn_mem_tracker_lib_allocator_lists_update(&ns_monitor_tracker_conf);
+
+    uint8_t written = 0;
+    for (uint8_t i = 0; i < NS_MONITOR_TOP_ALLOCATORS && written < count; i++) {
+        if (!ns_monitor_top_allocators[i].caller_addr) {
+            break;
+        }
+        list[written].function = ns_monitor_top_allocators[i].function;
+        list[written].line = ns_monitor_top_allocators[i].line;
+        list[written].alloc_count = ns_monitor_top_allocators[i].alloc_count;
+        list[written].total_memory = ns_monitor_top_allocators[i].total_memory;
+        written++;
+    }
+
+    return written;
+}
+
+#else
+
+int ns_monitor_heap_allocators_get(ns_monitor_heap_allocator_t *list, uint8_t count)
+{
+    (void) list;
+    (void) count;
+    return -1;
+}
+
+#endif
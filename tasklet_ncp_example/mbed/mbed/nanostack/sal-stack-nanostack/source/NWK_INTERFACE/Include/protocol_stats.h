@@ -26,6 +26,8 @@ typedef enum {
     STATS_IP_CKSUM_ERROR,
     STATS_FRAG_RX_ERROR,
     STATS_FRAG_TX_ERROR,
+    STATS_FRAG_RX_EVICT,
+    STATS_FRAG_RX_TIMEOUT,
     STATS_RPL_PARENT_CHANGE,
     STATS_RPL_ROUTELOOP,
     // RFC 6550 S18.5 stats
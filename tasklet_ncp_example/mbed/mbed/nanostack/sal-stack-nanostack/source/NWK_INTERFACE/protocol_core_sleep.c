@@ -30,6 +30,7 @@
 #include "NWK_INTERFACE/Include/protocol_timer.h"
 #include "common_functions.h"
 #include "platform/arm_hal_interrupt.h"
+#include "platform/arm_hal_aes.h"
 #include "6LoWPAN/ND/nd_router_object.h"
 #ifdef INCLUDE_THREAD_CODE
 #include "6LoWPAN/Thread/thread_common.h"
@@ -97,6 +98,8 @@ int arm_net_enter_sleep(void)
             platform_enter_critical();
             clear_power_state(SLEEP_MODE_REQ);
             platform_exit_critical();
+            // Let the AES hardware power down with the radio
+            arm_aes_key_cache_flush();
             ret_val = 0;
         }
     }
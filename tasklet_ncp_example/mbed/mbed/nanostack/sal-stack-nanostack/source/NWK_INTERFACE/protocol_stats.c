@@ -75,6 +75,14 @@ void protocol_stats_update(nwk_stats_type_t type, uint16_t update_val)
                 nwk_stats_ptr->frag_tx_errors++;
                 break;
 
+            case STATS_FRAG_RX_EVICT:
+                nwk_stats_ptr->frag_rx_evictions++;
+                break;
+
+            case STATS_FRAG_RX_TIMEOUT:
+                nwk_stats_ptr->frag_rx_timeouts++;
+                break;
+
             case STATS_RPL_PARENT_CHANGE:
                 nwk_stats_ptr->rpl_route_routecost_better_change++;
                 break;
@@ -452,7 +452,7 @@ static void rpl_control_etx_change_callback(int8_t  nwk_id, uint16_t previous_et
     ns_list_foreach(rpl_instance_t, instance, &domain->instances) {
 
         if (rpl_instance_am_root(instance)) {
-            rpl_downward_paths_invalidate(instance);
+            rpl_downward_root_neighbour_costs_changed(instance);
         } else {
 #ifndef FEATURE_TIMAC_SUPPORT
             if (better) {
@@ -102,11 +102,25 @@
 #include "RPL/rpl_control.h"
 #include "RPL/rpl_data.h"
 #include "RPL/rpl_structures.h"
+#include "Service_Libs/fnv_hash/fnv_hash.h"
 
 #define TRACE_GROUP "RPLd"
 
+/* DAO targets are indexed by prefix, so a root with a large network doesn't
+ * scan the whole target list for each DAO and transit match. The table
+ * doubles when chains average more than 2 entries. Without a table (or if it
+ * can't be allocated), look-ups fall back to the list.
+ */
+#ifndef RPL_DAO_TARGET_HASH_SIZE_MIN
+#define RPL_DAO_TARGET_HASH_SIZE_MIN 16
+#endif
+#ifndef RPL_DAO_TARGET_HASH_SIZE_MAX
+#define RPL_DAO_TARGET_HASH_SIZE_MAX 1024
+#endif
+
 #ifdef HAVE_RPL_ROOT
 static void rpl_downward_topo_sort_invalidate(rpl_instance_t *instance);
+static void rpl_downward_target_paths_update(rpl_dao_target_t *target);
 #endif
 
 #ifdef DBG_WISUN
@@ -282,6 +296,106 @@ uint16_t dbg_con_dev_list_size = 0;
 uint16_t dbg_num_dao_created = 0;
 uint16_t dbg_num_dao_deleted = 0;
 
+static uint_fast16_t rpl_dao_target_hash(const uint8_t *prefix, uint8_t prefix_len, uint16_t hash_size)
+{
+    uint8_t key[16] = { 0 };
+    bitcopy(key, prefix, prefix_len);
+    uint32_t hash = fnv_hash_1a_32_reverse_block(key, (prefix_len + 7u) / 8u) ^ prefix_len;
+    return (hash ^ (hash >> 16)) & (hash_size - 1);
+}
+
+static bool rpl_dao_target_hash_rebuild(rpl_instance_t *instance, uint16_t hash_size)
+{
+    rpl_dao_target_t **table = rpl_alloc(hash_size * sizeof(rpl_dao_target_t *));
+    if (!table) {
+        return false;
+    }
+    memset(table, 0, hash_size * sizeof(rpl_dao_target_t *));
+
+    /* Build in reverse so chains follow list order */
+    ns_list_foreach_reverse(rpl_dao_target_t, target, &instance->dao_targets) {
+        uint_fast16_t i = rpl_dao_target_hash(target->prefix, target->prefix_len, hash_size);
+        target->hash_next = table[i];
+        table[i] = target;
+    }
+
+    rpl_free(instance->dao_target_hash, instance->dao_target_hash_size * sizeof(rpl_dao_target_t *));
+    instance->dao_target_hash = table;
+    instance->dao_target_hash_size = hash_size;
+    return true;
+}
+
+/* Target must already be on the instance's list */
+static void rpl_dao_target_hash_add(rpl_instance_t *instance, rpl_dao_target_t *target)
+{
+    instance->dao_target_count++;
+    if (target->prefix_len < 128) {
+        instance->dao_target_short_count++;
+    }
+
+    uint16_t hash_size = 0;
+    if (instance->dao_target_hash_size == 0) {
+        hash_size = RPL_DAO_TARGET_HASH_SIZE_MIN;
+    } else if (instance->dao_target_count > 2u * instance->dao_target_hash_size && instance->dao_target_hash_size < RPL_DAO_TARGET_HASH_SIZE_MAX) {
+        hash_size = instance->dao_target_hash_size * 2;
+    }
+    if (hash_size && rpl_dao_target_hash_rebuild(instance, hash_size)) {
+        return;
+    }
+
+    if (instance->dao_target_hash) {
+        rpl_dao_target_t **next = &instance->dao_target_hash[rpl_dao_target_hash(target->prefix, target->prefix_len, instance->dao_target_hash_size)];
+        while (*next) {
+            next = &(*next)->hash_next;
+        }
+        target->hash_next = NULL;
+        *next = target;
+    }
+}
+
+static void rpl_dao_target_hash_remove(rpl_instance_t *instance, rpl_dao_target_t *target)
+{
+    instance->dao_target_count--;
+    if (target->prefix_len < 128) {
+        instance->dao_target_short_count--;
+    }
+
+    if (!instance->dao_target_hash) {
+        return;
+    }
+
+    if (instance->dao_target_count == 0) {
+        rpl_free(instance->dao_target_hash, instance->dao_target_hash_size * sizeof(rpl_dao_target_t *));
+        instance->dao_target_hash = NULL;
+        instance->dao_target_hash_size = 0;
+        return;
+    }
+
+    rpl_dao_target_t **prev = &instance->dao_target_hash[rpl_dao_target_hash(target->prefix, target->prefix_len, instance->dao_target_hash_size)];
+    while (*prev) {
+        if (*prev == target) {
+            *prev = target->hash_next;
+            break;
+        }
+        prev = &(*prev)->hash_next;
+    }
+}
+
+static rpl_dao_target_t *rpl_dao_target_hash_lookup(rpl_instance_t *instance, const uint8_t *prefix, uint8_t prefix_len, bool published_only)
+{
+    rpl_dao_target_t *target = instance->dao_target_hash[rpl_dao_target_hash(prefix, prefix_len, instance->dao_target_hash_size)];
+
+    for (; target; target = target->hash_next) {
+        if (published_only && !target->published) {
+            continue;
+        }
+        if (target->prefix_len == prefix_len && bitsequal(target->prefix, prefix, prefix_len)) {
+            return target;
+        }
+    }
+    return NULL;
+}
+
 rpl_dao_target_t *rpl_create_dao_target(rpl_instance_t *instance, const uint8_t *prefix, uint8_t prefix_len, bool root)
 {
     rpl_dao_target_t *target = rpl_alloc(sizeof(rpl_dao_target_t));
@@ -302,6 +416,8 @@ rpl_dao_target_t *rpl_create_dao_target(rpl_instance_t *instance, const uint8_t
     rpl_downward_topo_sort_invalidate(instance);
 #endif
     ns_list_add_to_end(&instance->dao_targets, target);
+    rpl_dao_target_hash_add(instance, target);
+    instance->dao_target_generation++;
 
 #ifdef DBG_WISUN
     wisunDbg.dao_create_cnt++;
@@ -315,6 +431,8 @@ void rpl_delete_dao_target(rpl_instance_t *instance, rpl_dao_target_t *target)
     /* For each notified parent, send a No-Path DAO */
 
     ns_list_remove(&instance->dao_targets, target);
+    rpl_dao_target_hash_remove(instance, target);
+    instance->dao_target_generation++;
 #ifdef DBG_WISUN
     wisunDbg.dao_deleted_cnt++;
     wisunDbg.dao_list_size = ns_list_count(&instance->dao_targets);
@@ -335,6 +453,10 @@ void rpl_delete_dao_target(rpl_instance_t *instance, rpl_dao_target_t *target)
 
 rpl_dao_target_t *rpl_instance_lookup_published_dao_target(rpl_instance_t *instance, const uint8_t *prefix, uint8_t prefix_len)
 {
+    if (instance->dao_target_hash) {
+        return rpl_dao_target_hash_lookup(instance, prefix, prefix_len, true);
+    }
+
     ns_list_foreach(rpl_dao_target_t, target, &instance->dao_targets) {
         if (target->published && target->prefix_len == prefix_len &&
                 bitsequal(target->prefix, prefix, prefix_len)) {
@@ -346,6 +468,10 @@ rpl_dao_target_t *rpl_instance_lookup_published_dao_target(rpl_instance_t *insta
 
 rpl_dao_target_t *rpl_instance_lookup_dao_target(rpl_instance_t *instance, const uint8_t *prefix, uint8_t prefix_len)
 {
+    if (instance->dao_target_hash) {
+        return rpl_dao_target_hash_lookup(instance, prefix, prefix_len, false);
+    }
+
     ns_list_foreach(rpl_dao_target_t, target, &instance->dao_targets) {
         if (target->prefix_len == prefix_len &&
                 bitsequal(target->prefix, prefix, prefix_len)) {
@@ -360,6 +486,11 @@ rpl_dao_target_t *rpl_instance_match_dao_target(rpl_instance_t *instance, const
     rpl_dao_target_t *longest = NULL;
     int_fast16_t longest_len = -1;
 
+    /* Normal case is all targets being /128 - then only an exact match can do */
+    if (instance->dao_target_hash && instance->dao_target_short_count == 0) {
+        return prefix_len == 128 ? rpl_dao_target_hash_lookup(instance, prefix, 128, false) : NULL;
+    }
+
     ns_list_foreach(rpl_dao_target_t, target, &instance->dao_targets) {
         if (target->prefix_len >= longest_len && target->prefix_len <= prefix_len &&
                 bitsequal(target->prefix, prefix, target->prefix_len)) {
@@ -995,8 +1126,6 @@ static rpl_dao_root_transit_t *rpl_downward_add_root_transit(rpl_dao_target_t *t
         if (addr_ipv6_equal(t->transit, parent)) {
             ns_list_remove(&target->info.root.transits, t);
             transit = t;
-            /* Updating existing transit - invalidates costs only */
-            rpl_downward_paths_invalidate(target->instance);
             break;
         }
     }
@@ -1008,6 +1137,7 @@ static rpl_dao_root_transit_t *rpl_downward_add_root_transit(rpl_dao_target_t *t
             goto out;
         }
         transit->path_control = 0;
+        transit->in_graph = false;
         /* A new transit invalidates the topo sort */
         rpl_downward_topo_sort_invalidate(target->instance);
     }
@@ -1024,6 +1154,9 @@ static rpl_dao_root_transit_t *rpl_downward_add_root_transit(rpl_dao_target_t *t
     memcpy(transit->transit, parent, 16);
     ns_list_add_to_end(&target->info.root.transits, transit);
 
+    /* Updating existing transit only changes costs - no need to redo the topo sort */
+    rpl_downward_target_paths_update(target);
+
     if (target->prefix_len == 128)
     {
         tr_info("Device %s uses %s as parent", trace_ipv6(target->prefix), parent);
@@ -1065,7 +1198,7 @@ void rpl_downward_transit_error(rpl_instance_t *instance, const uint8_t *target_
                 } else {
                     transit->cost = 0xFFFF;
                 }
-                rpl_downward_paths_invalidate(instance);
+                rpl_downward_target_paths_update(target);
                 instance->srh_error_count++;
                 if (rpl_policy_dao_trigger_after_srh_error(instance->domain, (protocol_core_monotonic_time - instance->last_dao_trigger_time) / 10, instance->srh_error_count, ns_list_count(&instance->dao_targets))) {
                     rpl_instance_increment_dtsn(instance);
@@ -1185,6 +1318,8 @@ static bool rpl_downward_process_targets_for_transit(rpl_dodag_t *dodag, bool st
                                 ns_list_remove(&target->info.root.transits, transit);
                                 rpl_free(transit, sizeof * transit);
                             }
+                            /* Freed transits may still be on children lists */
+                            rpl_downward_topo_sort_invalidate(target->instance);
                         }
                         if (storing) {
                             ipv6_route_table_remove_info(-1, ROUTE_RPL_DAO, target);
@@ -1290,11 +1425,13 @@ static void rpl_downward_link_transits_to_targets(rpl_instance_t *instance)
             if (protocol_interface_address_compare(transit->transit) == 0) {
                 /* It points to us (the DODAG root) - mark this with NULL */
                 transit->parent = NULL;
+                transit->in_graph = true;
                 target->connected = true;
                 /* Links to the root don't count as incoming transits */
                 ns_list_add_to_end(&instance->root_children, transit);
             } else {
                 transit->parent = rpl_instance_match_dao_target(instance, transit->transit, 128);
+                transit->in_graph = transit->parent != NULL;
                 if (transit->parent) {
                     target->info.root.cost++;
                     ns_list_add_to_end(&transit->parent->info.root.children, transit);
@@ -1396,6 +1533,7 @@ kill_candidate:
     if(kill_transit)
     {
         ns_list_remove(&kill_transit->parent->info.root.children, kill_transit);
+        kill_transit->in_graph = false;
         rpl_downward_topo_sort_edge_removed(kill_transit, graph, top_nodes);
     }
     else
@@ -1520,6 +1658,107 @@ void rpl_downward_paths_invalidate(rpl_instance_t *instance)
     instance->root_paths_valid = false;
     rpl_data_sr_invalidate();
 }
+
+/* Recompute a target's best cost from its transits in the current graph,
+ * moving the best transit to the front as rpl_downward_compute_paths does.
+ * Returns true if the cost or chosen transit changed.
+ */
+static bool rpl_downward_target_cost_recompute(rpl_dao_target_t *target)
+{
+    rpl_dao_root_transit_t *best = NULL;
+    uint32_t best_cost = 0xFFFFFFFF;
+
+    ns_list_foreach(rpl_dao_root_transit_t, transit, &target->info.root.transits) {
+        uint32_t cost;
+        if (!transit->in_graph) {
+            continue;
+        }
+        if (!transit->parent) {
+            /* Direct link to root - modify for ETX or similar */
+            cost = transit->cost;
+            if (target->prefix_len == 128) {
+                cost = rpl_policy_modify_downward_cost_to_root_neighbour(target->instance->domain, target->interface_id, target->prefix, transit->cost);
+            }
+        } else if (transit->parent->connected) {
+            cost = (uint16_t) transit->parent->info.root.cost + transit->cost;
+        } else {
+            continue;
+        }
+        if (cost < best_cost) {
+            best_cost = cost;
+            best = transit;
+        }
+    }
+
+    bool changed = best_cost != target->info.root.cost;
+    target->info.root.cost = best_cost;
+    target->connected = best_cost != 0xFFFFFFFF;
+    if (best && best != ns_list_get_first(&target->info.root.transits)) {
+        ns_list_remove(&target->info.root.transits, best);
+        ns_list_add_to_start(&target->info.root.transits, best);
+        changed = true;
+    }
+    return changed;
+}
+
+/* Process targets marked path_cost_dirty, starting from "first" in topo sort
+ * order. Children of any target whose cost changes are marked in turn - they
+ * always sort later, so only the affected subtrees get recomputed.
+ */
+static void rpl_downward_dirty_paths_update(rpl_instance_t *instance, rpl_dao_target_t *first, uint_fast16_t dirty_count)
+{
+    for (rpl_dao_target_t *target = first; target && dirty_count; target = ns_list_get_next(&instance->dao_targets, target)) {
+        if (!target->path_cost_dirty) {
+            continue;
+        }
+        target->path_cost_dirty = false;
+        dirty_count--;
+        if (!rpl_downward_target_cost_recompute(target)) {
+            continue;
+        }
+        ns_list_foreach(rpl_dao_root_transit_t, transit, &target->info.root.children) {
+            if (!transit->target->path_cost_dirty) {
+                transit->target->path_cost_dirty = true;
+                dirty_count++;
+            }
+        }
+    }
+}
+
+/* Called when a target's transit costs changed, but not the set of transits */
+static void rpl_downward_target_paths_update(rpl_dao_target_t *target)
+{
+    rpl_data_sr_invalidate();
+
+    /* If a full computation is pending anyway, nothing to do */
+    if (!target->instance->root_paths_valid) {
+        return;
+    }
+
+    target->path_cost_dirty = true;
+    rpl_downward_dirty_paths_update(target->instance, target, 1);
+}
+
+/* Called when costs of links to root neighbours may have changed (eg ETX) */
+void rpl_downward_root_neighbour_costs_changed(rpl_instance_t *instance)
+{
+    uint_fast16_t dirty_count = 0;
+
+    rpl_data_sr_invalidate();
+
+    if (!instance->root_paths_valid) {
+        return;
+    }
+
+    ns_list_foreach(rpl_dao_root_transit_t, transit, &instance->root_children) {
+        if (!transit->target->path_cost_dirty) {
+            transit->target->path_cost_dirty = true;
+            dirty_count++;
+        }
+    }
+
+    rpl_downward_dirty_paths_update(instance, ns_list_get_first(&instance->dao_targets), dirty_count);
+}
 #endif // HAVE_RPL_ROOT
 
 #ifdef HAVE_RPL_DAO_HANDLING
@@ -56,9 +56,11 @@ bool rpl_instance_dao_received(struct rpl_instance *instance, const uint8_t src[
 void rpl_downward_transit_error(rpl_instance_t *instance, const uint8_t *target_addr, const uint8_t *transit_addr);
 void rpl_downward_compute_paths(rpl_instance_t *instance);
 void rpl_downward_paths_invalidate(rpl_instance_t *instance);
+void rpl_downward_root_neighbour_costs_changed(rpl_instance_t *instance);
 #else
 #define rpl_downward_compute_paths(instance) ((void) 0)
 #define rpl_downward_paths_invalidate(instance) ((void) 0)
+#define rpl_downward_root_neighbour_costs_changed(instance) ((void) 0)
 #endif
 
 #endif /* RPL_DOWNWARD_H_ */
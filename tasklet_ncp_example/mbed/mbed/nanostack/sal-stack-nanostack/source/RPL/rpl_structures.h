@@ -105,6 +105,7 @@ typedef struct rpl_dao_root_transit {
     rpl_dao_target_t *target;
     uint8_t path_control;
     uint16_t cost;
+    bool in_graph;                      /* Linked into parent's children (or root_children) by the last topo sort */
     ns_list_link_t parent_link;
     ns_list_link_t target_link;
 } rpl_dao_root_transit_t;
@@ -149,12 +150,14 @@ struct rpl_dao_target {
     bool connected: 1;                  /* We know this target has a path to the root */
     bool trig_confirmation_state: 1;         /* Enable confirmation to parent's */
     bool active_confirmation_state: 1;
+    bool path_cost_dirty: 1;            /* Root cost needs recomputing (incremental path update) */
     union {
 #ifdef HAVE_RPL_ROOT
         rpl_dao_root_t root;            /* Info specific to a non-storing root */
 #endif
         rpl_dao_non_root_t non_root;    /* Info for other nodes (any in storing, non-root in non-storing) */
     } info;
+    struct rpl_dao_target *hash_next;   /* Prefix hash chain (see rpl_instance::dao_target_hash) */
     ns_list_link_t link;
 };
 
@@ -197,6 +200,11 @@ struct rpl_instance {
     trickle_t dio_timer;                            /* Trickle timer for DIO transmission */
     rpl_dao_root_transit_children_list_t root_children;
     rpl_dao_target_list_t dao_targets;              /* List of DAO targets */
+    rpl_dao_target_t **dao_target_hash;             /* DAO targets indexed by prefix (NULL if not allocated) */
+    uint16_t dao_target_hash_size;                  /* Buckets in dao_target_hash, power of 2 */
+    uint16_t dao_target_count;                      /* Number of DAO targets */
+    uint16_t dao_target_short_count;                /* Number of DAO targets shorter than /128 */
+    uint16_t dao_target_generation;                 /* Incremented when a DAO target is added or removed */
     uint8_t dao_sequence;                           /* Next DAO sequence to use */
     uint8_t dao_sequence_in_transit;                /* DAO sequence in transit (if dao_in_transit) */
     uint16_t delay_dao_timer;
@@ -332,6 +332,9 @@ static bool auth_eap_tls_sec_prot_tls_finished_indication(sec_prot_t *tls_prot,
     if (data->tls_result == EAP_TLS_RESULT_HANDSHAKE_FATAL_ERROR) {
         // On fatal error terminate right away
         prot->state_machine_call(prot);
+    } else if (data->tls_result == EAP_TLS_RESULT_HANDSHAKE_OVER && !data->send_pending) {
+        // On resumed session client sends the last flight, nothing to send so indicate success
+        prot->state_machine_call(prot);
     }
 
     return false;
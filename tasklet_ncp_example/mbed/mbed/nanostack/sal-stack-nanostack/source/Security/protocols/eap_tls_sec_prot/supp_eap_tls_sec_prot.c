@@ -320,8 +320,10 @@ static bool supp_eap_tls_sec_prot_tls_finished_indication(sec_prot_t *tls_prot,
 
     data->tls_ongoing = false;
 
-    if (data->tls_result == EAP_TLS_RESULT_HANDSHAKE_OVER || data->tls_result == EAP_TLS_RESULT_HANDSHAKE_FATAL_ERROR) {
+    if ((data->tls_result == EAP_TLS_RESULT_HANDSHAKE_OVER && !data->send_pending) ||
+            data->tls_result == EAP_TLS_RESULT_HANDSHAKE_FATAL_ERROR) {
         // On fatal error and on success calls state machine to sent empty EAP-TLS message
+        // (on resumed session the last flight is already waiting to be sent)
         prot->state_machine_call(prot);
     }
 
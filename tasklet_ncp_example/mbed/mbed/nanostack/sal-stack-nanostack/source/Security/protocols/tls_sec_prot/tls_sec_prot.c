@@ -37,6 +37,7 @@
 #include "Security/protocols/eap_tls_sec_prot/eap_tls_sec_prot_lib.h"
 #include "Security/protocols/tls_sec_prot/tls_sec_prot.h"
 #include "Security/protocols/tls_sec_prot/tls_sec_prot_lib.h"
+#include "Security/protocols/tls_sec_prot/tls_sec_prot_session_cache.h"
 
 #ifdef HAVE_WS
 
@@ -104,6 +105,14 @@ static int16_t tls_sec_prot_tls_receive(void *handle, unsigned char *buf, size_t
 static void tls_sec_prot_tls_export_keys(void *handle, const uint8_t *master_secret, const uint8_t *eap_tls_key_material);
 static void tls_sec_prot_tls_set_timer(void *handle, uint32_t inter, uint32_t fin);
 static int8_t tls_sec_prot_tls_get_timer(void *handle);
+#ifdef HAVE_PAE_SUPP
+static int8_t client_tls_sec_prot_tls_session_get(void *handle, tls_sec_prot_lib_session_t *session);
+static void client_tls_sec_prot_tls_session_set(void *handle, const tls_sec_prot_lib_session_t *session);
+#endif
+#ifdef HAVE_PAE_AUTH
+static int8_t server_tls_sec_prot_tls_session_get(void *handle, tls_sec_prot_lib_session_t *session);
+static void server_tls_sec_prot_tls_session_set(void *handle, const tls_sec_prot_lib_session_t *session);
+#endif
 
 static int8_t tls_sec_prot_tls_configure_and_connect(sec_prot_t *prot, bool is_server);
 
@@ -124,6 +133,11 @@ static uint16_t tls_sec_prot_send_buffer_size_get(sec_prot_t *prot);
 static NS_LIST_DEFINE(tls_sec_prot_queue, tls_sec_prot_queue_t, link);
 #endif
 
+#ifdef HAVE_PAE_SUPP
+// Session of the last successful handshake, offered to the authenticator on re-authentication
+static tls_sec_prot_lib_session_t client_tls_session;
+#endif
+
 int8_t client_tls_sec_prot_register(kmp_service_t *service)
 {
     if (!service) {
@@ -377,6 +391,12 @@ static void client_tls_sec_prot_state_machine(sec_prot_t *prot)
             if (sec_prot_result_ok_check(&data->common)) {
                 sec_prot_keys_pmk_write(prot->sec_keys, data->new_pmk, prot->sec_cfg->timer_cfg.pmk_lifetime);
             }
+#ifdef HAVE_PAE_SUPP
+            else {
+                // Next handshake is a full one
+                memset(&client_tls_session, 0, sizeof(tls_sec_prot_lib_session_t));
+            }
+#endif
 
             // KMP-FINISHED.indication,
             prot->finished_ind(prot, sec_prot_result_get(&data->common), prot->sec_keys);
@@ -639,6 +659,54 @@ static int8_t tls_sec_prot_tls_get_timer(void *handle)
     return TLS_SEC_PROT_LIB_TIMER_NO_EXPIRY;
 }
 
+#ifdef HAVE_PAE_SUPP
+static int8_t client_tls_sec_prot_tls_session_get(void *handle, tls_sec_prot_lib_session_t *session)
+{
+    (void) handle;
+
+    if (client_tls_session.id_len == 0) {
+        return -1;
+    }
+
+    memcpy(session, &client_tls_session, sizeof(tls_sec_prot_lib_session_t));
+    return 0;
+}
+
+static void client_tls_sec_prot_tls_session_set(void *handle, const tls_sec_prot_lib_session_t *session)
+{
+    (void) handle;
+
+    memcpy(&client_tls_session, session, sizeof(tls_sec_prot_lib_session_t));
+}
+#endif
+
+#ifdef HAVE_PAE_AUTH
+static int8_t server_tls_sec_prot_tls_session_get(void *handle, tls_sec_prot_lib_session_t *session)
+{
+    sec_prot_t *prot = handle;
+    uint8_t *remote_eui_64 = sec_prot_remote_eui_64_addr_get(prot);
+
+    if (tls_sec_prot_session_cache_read(remote_eui_64, session) < 0) {
+        return -1;
+    }
+
+    tr_info("TLS: session resumed, eui-64: %s", trace_array(remote_eui_64, 8));
+    return 0;
+}
+
+static void server_tls_sec_prot_tls_session_set(void *handle, const tls_sec_prot_lib_session_t *session)
+{
+    sec_prot_t *prot = handle;
+    uint8_t *remote_eui_64 = sec_prot_remote_eui_64_addr_get(prot);
+
+    if (tls_sec_prot_session_cache_write(remote_eui_64, session, TLS_SESSION_CACHE_LIFETIME) < 0) {
+        return;
+    }
+
+    tr_debug("TLS: session cached, eui-64: %s", trace_array(remote_eui_64, 8));
+}
+#endif
+
 static int8_t tls_sec_prot_tls_configure_and_connect(sec_prot_t *prot, bool is_server)
 {
     tls_sec_prot_int_t *data = tls_sec_prot_get(prot);
@@ -654,6 +722,19 @@ static int8_t tls_sec_prot_tls_configure_and_connect(sec_prot_t *prot, bool is_s
                                      tls_sec_prot_tls_send, tls_sec_prot_tls_receive, tls_sec_prot_tls_export_keys,
                                      tls_sec_prot_tls_set_timer, tls_sec_prot_tls_get_timer);
 
+#ifdef HAVE_PAE_AUTH
+    if (is_server) {
+        tls_sec_prot_lib_session_cb_register((tls_security_t *)&data->tls_sec_inst,
+                                             server_tls_sec_prot_tls_session_get, server_tls_sec_prot_tls_session_set);
+    }
+#endif
+#ifdef HAVE_PAE_SUPP
+    if (!is_server) {
+        tls_sec_prot_lib_session_cb_register((tls_security_t *)&data->tls_sec_inst,
+                                             client_tls_sec_prot_tls_session_get, client_tls_sec_prot_tls_session_set);
+    }
+#endif
+
     if (tls_sec_prot_lib_connect((tls_security_t *)&data->tls_sec_inst, is_server, prot->sec_keys->certs) < 0) {
         tr_error("TLS: library connect fail");
         return -1;
@@ -83,6 +83,9 @@ struct tls_security_s {
     tls_sec_prot_lib_export_keys   *export_keys;         /**< Export keys callback */
     tls_sec_prot_lib_set_timer     *set_timer;           /**< Set timer callback */
     tls_sec_prot_lib_get_timer     *get_timer;           /**< Get timer callback */
+    tls_sec_prot_lib_session_get   *session_get;         /**< Get session callback */
+    tls_sec_prot_lib_session_set   *session_set;         /**< Store session callback */
+    bool                           is_server : 1;        /**< TLS server */
 };
 
 static void tls_sec_prot_lib_ssl_set_timer(void *ctx, uint32_t int_ms, uint32_t fin_ms);
@@ -97,6 +100,14 @@ static int tls_sec_prot_lib_ssl_export_keys(void *p_expkey, const unsigned char
                                             mbedtls_tls_prf_types tls_prf_type);
 
 static int tls_sec_prot_lib_x509_crt_verify(void *ctx, mbedtls_x509_crt *crt, int certificate_depth, uint32_t *flags);
+#if defined(MBEDTLS_SSL_SRV_C) && defined(HAVE_PAE_AUTH)
+static int tls_sec_prot_lib_ssl_session_get(void *ctx, mbedtls_ssl_session *ssl_session);
+static int tls_sec_prot_lib_ssl_session_set(void *ctx, const mbedtls_ssl_session *ssl_session);
+#endif
+#if defined(MBEDTLS_SSL_CLI_C) && defined(HAVE_PAE_SUPP)
+static void tls_sec_prot_lib_session_resume_request(tls_security_t *sec);
+#endif
+static void tls_sec_prot_lib_session_export(const mbedtls_ssl_session *ssl_session, tls_sec_prot_lib_session_t *session);
 static int8_t tls_sec_prot_lib_subject_alternative_name_validate(mbedtls_x509_crt *crt);
 static int8_t tls_sec_prot_lib_extended_key_usage_validate(mbedtls_x509_crt *crt);
 #ifdef HAVE_PAE_AUTH
@@ -148,6 +159,9 @@ int8_t tls_sec_prot_lib_init(tls_security_t *sec)
 
     sec->crl = NULL;
 
+    sec->session_get = NULL;
+    sec->session_set = NULL;
+
     if (mbedtls_entropy_add_source(&sec->entropy, tls_sec_lib_entropy_poll, NULL,
                                    128, MBEDTLS_ENTROPY_SOURCE_WEAK) < 0) {
         tr_error("Entropy add fail");
@@ -185,6 +199,16 @@ void tls_sec_prot_lib_set_cb_register(tls_security_t *sec, void *handle,
     sec->get_timer = get_timer;
 }
 
+void tls_sec_prot_lib_session_cb_register(tls_security_t *sec, tls_sec_prot_lib_session_get *get, tls_sec_prot_lib_session_set *set)
+{
+    if (!sec) {
+        return;
+    }
+
+    sec->session_get = get;
+    sec->session_set = set;
+}
+
 void tls_sec_prot_lib_free(tls_security_t *sec)
 {
     mbedtls_x509_crt_free(&sec->cacert);
@@ -349,6 +373,8 @@ int8_t tls_sec_prot_lib_connect(tls_security_t *sec, bool is_server, const sec_p
         return -1;
     }
 
+    sec->is_server = is_server_is_set;
+
 #ifdef HAVE_PAE_SUPP
     if (is_server_is_not_set) {
         sec->crt_verify = tls_sec_prot_lib_x509_crt_server_verify;
@@ -436,6 +462,20 @@ int8_t tls_sec_prot_lib_connect(tls_security_t *sec, bool is_server, const sec_p
     // Set certificate verify callback
     mbedtls_ssl_set_verify(&sec->ssl, tls_sec_prot_lib_x509_crt_verify, sec);
 
+    // Session resumption, skips certificate exchange and ECC operations for known peers
+    if (sec->session_get && sec->session_set) {
+#if defined(MBEDTLS_SSL_SRV_C) && defined(HAVE_PAE_AUTH)
+        if (is_server_is_set) {
+            mbedtls_ssl_conf_session_cache(&sec->conf, sec, tls_sec_prot_lib_ssl_session_get, tls_sec_prot_lib_ssl_session_set);
+        }
+#endif
+#if defined(MBEDTLS_SSL_CLI_C) && defined(HAVE_PAE_SUPP)
+        if (is_server_is_not_set) {
+            tls_sec_prot_lib_session_resume_request(sec);
+        }
+#endif
+    }
+
     /* Currently assuming we are running fast enough HW that ECC calculations are not blocking any normal operation.
      *
      * If there is a problem with ECC calculations and those are taking too long in border router
@@ -472,6 +512,13 @@ int8_t tls_sec_prot_lib_process(tls_security_t *sec)
         }
 
         if (sec->ssl.state == MBEDTLS_SSL_HANDSHAKE_OVER) {
+            // Server stores new sessions using the session cache callback
+            if (!sec->is_server && sec->session_set) {
+                tls_sec_prot_lib_session_t session;
+                tls_sec_prot_lib_session_export(mbedtls_ssl_get_session_pointer(&sec->ssl), &session);
+                sec->session_set(sec->handle, &session);
+                memset(&session, 0, sizeof(tls_sec_prot_lib_session_t));
+            }
             return TLS_SEC_PROT_LIB_HANDSHAKE_OVER;
         }
     }
@@ -564,6 +611,97 @@ static int tls_sec_prot_lib_x509_crt_verify(void *ctx, mbedtls_x509_crt *crt, in
     return 0;
 }
 
+static void tls_sec_prot_lib_session_export(const mbedtls_ssl_session *ssl_session, tls_sec_prot_lib_session_t *session)
+{
+    memset(session, 0, sizeof(tls_sec_prot_lib_session_t));
+
+    if (!ssl_session || ssl_session->id_len > TLS_SESSION_ID_LEN) {
+        return;
+    }
+
+    session->id_len = ssl_session->id_len;
+    memcpy(session->id, ssl_session->id, ssl_session->id_len);
+    memcpy(session->master, ssl_session->master, TLS_MASTER_SECRET_LEN);
+    session->ciphersuite = ssl_session->ciphersuite;
+}
+
+#if defined(MBEDTLS_SSL_SRV_C) && defined(HAVE_PAE_AUTH)
+static int tls_sec_prot_lib_ssl_session_get(void *ctx, mbedtls_ssl_session *ssl_session)
+{
+    tls_security_t *sec = (tls_security_t *) ctx;
+
+    if (ssl_session->id_len == 0 || ssl_session->id_len > TLS_SESSION_ID_LEN) {
+        return 1;
+    }
+
+    tls_sec_prot_lib_session_t session;
+    memset(&session, 0, sizeof(tls_sec_prot_lib_session_t));
+    session.id_len = ssl_session->id_len;
+    memcpy(session.id, ssl_session->id, ssl_session->id_len);
+
+    if (sec->session_get(sec->handle, &session) < 0) {
+        return 1;
+    }
+
+    // Client must propose the same ciphersuite that was used on the cached session
+    if (session.ciphersuite != ssl_session->ciphersuite) {
+        memset(&session, 0, sizeof(tls_sec_prot_lib_session_t));
+        return 1;
+    }
+
+    memcpy(ssl_session->master, session.master, TLS_MASTER_SECRET_LEN);
+    // Peer certificate was verified on the full handshake
+    ssl_session->verify_result = 0;
+
+    memset(&session, 0, sizeof(tls_sec_prot_lib_session_t));
+    return 0;
+}
+
+static int tls_sec_prot_lib_ssl_session_set(void *ctx, const mbedtls_ssl_session *ssl_session)
+{
+    tls_security_t *sec = (tls_security_t *) ctx;
+
+    if (ssl_session->id_len == 0 || ssl_session->id_len > TLS_SESSION_ID_LEN) {
+        return 1;
+    }
+
+    tls_sec_prot_lib_session_t session;
+    tls_sec_prot_lib_session_export(ssl_session, &session);
+    sec->session_set(sec->handle, &session);
+    memset(&session, 0, sizeof(tls_sec_prot_lib_session_t));
+
+    return 0;
+}
+#endif
+
+#if defined(MBEDTLS_SSL_CLI_C) && defined(HAVE_PAE_SUPP)
+static void tls_sec_prot_lib_session_resume_request(tls_security_t *sec)
+{
+    tls_sec_prot_lib_session_t session;
+    memset(&session, 0, sizeof(tls_sec_prot_lib_session_t));
+
+    if (sec->session_get(sec->handle, &session) < 0 || session.id_len == 0 || session.id_len > TLS_SESSION_ID_LEN) {
+        return;
+    }
+
+    mbedtls_ssl_session ssl_session;
+    mbedtls_ssl_session_init(&ssl_session);
+    ssl_session.ciphersuite = session.ciphersuite;
+    ssl_session.id_len = session.id_len;
+    memcpy(ssl_session.id, session.id, session.id_len);
+    memcpy(ssl_session.master, session.master, TLS_MASTER_SECRET_LEN);
+    memset(&session, 0, sizeof(tls_sec_prot_lib_session_t));
+
+    // Offers the session on client hello, server falls back to full handshake if it does not know it
+    if (mbedtls_ssl_set_session(&sec->ssl, &ssl_session) != 0) {
+        tr_error("session set fail");
+    }
+
+    // Zeroes also the master secret
+    mbedtls_ssl_session_free(&ssl_session);
+}
+#endif
+
 static int8_t tls_sec_prot_lib_subject_alternative_name_validate(mbedtls_x509_crt *crt)
 {
     mbedtls_asn1_sequence *seq = &crt->subject_alt_names;
@@ -724,6 +862,13 @@ void tls_sec_prot_lib_set_cb_register(tls_security_t *sec, void *handle,
     (void)get_timer;
 }
 
+void tls_sec_prot_lib_session_cb_register(tls_security_t *sec, tls_sec_prot_lib_session_get *get, tls_sec_prot_lib_session_set *set)
+{
+    (void)sec;
+    (void)get;
+    (void)set;
+}
+
 uint16_t tls_sec_prot_lib_size(void)
 {
     return 0;
@@ -43,6 +43,16 @@ typedef enum {
 // Maximum operations made on one round of ECC calculation
 #define ECC_CALCULATION_MAX_OPS            200
 
+#define TLS_SESSION_ID_LEN                 32
+#define TLS_MASTER_SECRET_LEN              48
+
+typedef struct {
+    uint8_t id[TLS_SESSION_ID_LEN];           /**< Session identifier */
+    uint8_t id_len;                           /**< Session identifier length */
+    uint8_t master[TLS_MASTER_SECRET_LEN];    /**< Master secret */
+    uint16_t ciphersuite;                     /**< Ciphersuite of the session */
+} tls_sec_prot_lib_session_t;
+
 /**
  * tls_sec_prot_lib_init initialize security library
  *
@@ -133,6 +143,46 @@ void tls_sec_prot_lib_set_cb_register(tls_security_t *sec, void *handle,
                                       tls_sec_prot_lib_export_keys *export_keys, tls_sec_prot_lib_set_timer *set_timer,
                                       tls_sec_prot_lib_get_timer *get_timer);
 
+/**
+ * tls_sec_prot_lib_session_get get session for resumption callback
+ *
+ * On server session identifier is set to the one offered by the client, and
+ * callback fills in the master secret and the ciphersuite. On client callback
+ * fills in the whole session to be offered to the server.
+ *
+ * \param handle caller defined handle
+ * \param session session
+ *
+ * \return < 0 no session
+ * \return >= 0 session found
+ */
+typedef int8_t tls_sec_prot_lib_session_get(void *handle, tls_sec_prot_lib_session_t *session);
+
+/**
+ * tls_sec_prot_lib_session_set store session callback
+ *
+ * Called on server when a full handshake has established a new session, and
+ * on client after every successful handshake.
+ *
+ * \param handle caller defined handle
+ * \param session session
+ *
+ */
+typedef void tls_sec_prot_lib_session_set(void *handle, const tls_sec_prot_lib_session_t *session);
+
+/**
+ * tls_sec_prot_lib_session_cb_register register session resumption callbacks to library
+ *
+ * Must be called before tls_sec_prot_lib_connect(). If not called, sessions
+ * are not resumed.
+ *
+ * \param sec security library instance
+ * \param get get session callback
+ * \param set store session callback
+ *
+ */
+void tls_sec_prot_lib_session_cb_register(tls_security_t *sec, tls_sec_prot_lib_session_get *get, tls_sec_prot_lib_session_set *set);
+
 /**
  * tls_sec_prot_lib_free free security library internal data (e.g. TLS data)
  *
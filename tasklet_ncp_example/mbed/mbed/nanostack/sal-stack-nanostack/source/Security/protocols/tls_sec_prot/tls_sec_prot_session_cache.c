@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nsconfig.h"
+#include <string.h>
+#include "ns_types.h"
+#include "ns_list.h"
+#include "ns_trace.h"
+#include "nsdynmemLIB.h"
+#include "Security/protocols/sec_prot_certs.h"
+#include "Security/protocols/tls_sec_prot/tls_sec_prot_lib.h"
+#include "Security/protocols/tls_sec_prot/tls_sec_prot_session_cache.h"
+
+#ifdef HAVE_WS
+
+#define TRACE_GROUP "tlsc"
+
+typedef struct {
+    uint8_t eui_64[8];                       /**< EUI-64 of the supplicant */
+    tls_sec_prot_lib_session_t session;      /**< Session */
+    uint32_t lifetime;                       /**< Remaining lifetime in seconds, zero when entry is not in use */
+} tls_session_cache_entry_t;
+
+typedef struct {
+    tls_session_cache_entry_t *entries;      /**< Entries, allocated on first write */
+    uint16_t size;                           /**< Maximum number of entries */
+    bool updated : 1;                        /**< Cache has been updated */
+} tls_session_cache_t;
+
+static tls_session_cache_entry_t *tls_sec_prot_session_cache_eui_64_entry_get(const uint8_t *eui_64);
+static void tls_sec_prot_session_cache_entry_clear(tls_session_cache_entry_t *entry);
+
+static tls_session_cache_t session_cache = {
+    .entries = NULL,
+    .size = 0,
+    .updated = false
+};
+
+void tls_sec_prot_session_cache_init(uint16_t size)
+{
+    tls_sec_prot_session_cache_delete();
+    session_cache.size = size;
+}
+
+void tls_sec_prot_session_cache_delete(void)
+{
+    if (session_cache.entries) {
+        memset(session_cache.entries, 0, sizeof(tls_session_cache_entry_t) * session_cache.size);
+        ns_dyn_mem_free(session_cache.entries);
+    }
+    session_cache.entries = NULL;
+    session_cache.size = 0;
+    session_cache.updated = false;
+}
+
+uint16_t tls_sec_prot_session_cache_size_get(void)
+{
+    return session_cache.size;
+}
+
+int8_t tls_sec_prot_session_cache_read(const uint8_t *eui_64, tls_sec_prot_lib_session_t *session)
+{
+    if (!session_cache.entries || !eui_64 || session->id_len == 0) {
+        return -1;
+    }
+
+    for (uint16_t index = 0; index < session_cache.size; index++) {
+        tls_session_cache_entry_t *entry = &session_cache.entries[index];
+        if (entry->lifetime == 0 || entry->session.id_len != session->id_len ||
+                memcmp(entry->session.id, session->id, session->id_len) != 0) {
+            continue;
+        }
+        // Session can be resumed only by the supplicant that established it
+        if (memcmp(entry->eui_64, eui_64, 8) != 0) {
+            tr_warn("session of other supplicant, eui-64: %s", trace_array(eui_64, 8));
+            return -1;
+        }
+        memcpy(session, &entry->session, sizeof(tls_sec_prot_lib_session_t));
+        return 0;
+    }
+
+    return -1;
+}
+
+int8_t tls_sec_prot_session_cache_write(const uint8_t *eui_64, const tls_sec_prot_lib_session_t *session, uint32_t lifetime)
+{
+    if (session_cache.size == 0 || !eui_64 || session->id_len == 0 || lifetime == 0) {
+        return -1;
+    }
+
+    if (!session_cache.entries) {
+        session_cache.entries = ns_dyn_mem_alloc(sizeof(tls_session_cache_entry_t) * session_cache.size);
+        if (!session_cache.entries) {
+            tr_error("session cache allocate fail");
+            return -1;
+        }
+        memset(session_cache.entries, 0, sizeof(tls_session_cache_entry_t) * session_cache.size);
+    }
+
+    tls_session_cache_entry_t *entry = tls_sec_prot_session_cache_eui_64_entry_get(eui_64);
+
+    if (!entry) {
+        // Uses free entry or replaces the one closest to expiry
+        entry = &session_cache.entries[0];
+        for (uint16_t index = 1; index < session_cache.size && entry->lifetime > 0; index++) {
+            if (session_cache.entries[index].lifetime < entry->lifetime) {
+                entry = &session_cache.entries[index];
+            }
+        }
+    }
+
+    memcpy(entry->eui_64, eui_64, 8);
+    memcpy(&entry->session, session, sizeof(tls_sec_prot_lib_session_t));
+    entry->lifetime = lifetime;
+    session_cache.updated = true;
+
+    return 0;
+}
+
+int8_t tls_sec_prot_session_cache_entry_get(uint16_t index, uint8_t *eui_64, tls_sec_prot_lib_session_t *session, uint32_t *lifetime)
+{
+    if (!session_cache.entries || index >= session_cache.size) {
+        return -1;
+    }
+
+    tls_session_cache_entry_t *entry = &session_cache.entries[index];
+    if (entry->lifetime == 0) {
+        return -1;
+    }
+
+    memcpy(eui_64, entry->eui_64, 8);
+    memcpy(session, &entry->session, sizeof(tls_sec_prot_lib_session_t));
+    *lifetime = entry->lifetime;
+
+    return 0;
+}
+
+bool tls_sec_prot_session_cache_supp_delete(const uint8_t *eui_64)
+{
+    tls_session_cache_entry_t *entry = tls_sec_prot_session_cache_eui_64_entry_get(eui_64);
+    if (!entry) {
+        return false;
+    }
+
+    tls_sec_prot_session_cache_entry_clear(entry);
+    session_cache.updated = true;
+
+    return true;
+}
+
+void tls_sec_prot_session_cache_flush(void)
+{
+    if (!session_cache.entries) {
+        return;
+    }
+
+    for (uint16_t index = 0; index < session_cache.size; index++) {
+        tls_session_cache_entry_t *entry = &session_cache.entries[index];
+        if (entry->lifetime > 0) {
+            tls_sec_prot_session_cache_entry_clear(entry);
+            session_cache.updated = true;
+        }
+    }
+
+    tr_info("session cache flushed");
+}
+
+void tls_sec_prot_session_cache_timer(uint16_t seconds)
+{
+    if (!session_cache.entries) {
+        return;
+    }
+
+    for (uint16_t index = 0; index < session_cache.size; index++) {
+        tls_session_cache_entry_t *entry = &session_cache.entries[index];
+        if (entry->lifetime == 0) {
+            continue;
+        }
+        if (entry->lifetime > seconds) {
+            entry->lifetime -= seconds;
+        } else {
+            tls_sec_prot_session_cache_entry_clear(entry);
+        }
+    }
+}
+
+bool tls_sec_prot_session_cache_updated_get(void)
+{
+    return session_cache.updated;
+}
+
+void tls_sec_prot_session_cache_updated_reset(void)
+{
+    session_cache.updated = false;
+}
+
+static tls_session_cache_entry_t *tls_sec_prot_session_cache_eui_64_entry_get(const uint8_t *eui_64)
+{
+    if (!session_cache.entries || !eui_64) {
+        return NULL;
+    }
+
+    for (uint16_t index = 0; index < session_cache.size; index++) {
+        tls_session_cache_entry_t *entry = &session_cache.entries[index];
+        if (entry->lifetime > 0 && memcmp(entry->eui_64, eui_64, 8) == 0) {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+static void tls_sec_prot_session_cache_entry_clear(tls_session_cache_entry_t *entry)
+{
+    // Clears also the master secret
+    memset(entry, 0, sizeof(tls_session_cache_entry_t));
+}
+
+#endif /* HAVE_WS */
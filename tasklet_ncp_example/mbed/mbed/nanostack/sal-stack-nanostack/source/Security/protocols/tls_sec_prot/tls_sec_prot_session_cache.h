@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TLS_SEC_PROT_SESSION_CACHE_H_
+#define TLS_SEC_PROT_SESSION_CACHE_H_
+
+/*
+ * TLS server session cache. Stores the sessions established with full
+ * handshakes so that supplicants can resume them on re-authentication.
+ *
+ * Cache is bounded; each supplicant (EUI-64) has at most one session and
+ * when the cache is full the session closest to expiry is replaced.
+ *
+ */
+
+/**
+ * tls_sec_prot_session_cache_init initializes session cache
+ *
+ * Memory for the entries is allocated when the first session is written.
+ *
+ * \param size maximum number of sessions, zero disables the cache
+ *
+ */
+void tls_sec_prot_session_cache_init(uint16_t size);
+
+/**
+ * tls_sec_prot_session_cache_delete deletes session cache and frees memory
+ *
+ */
+void tls_sec_prot_session_cache_delete(void);
+
+/**
+ * tls_sec_prot_session_cache_size_get gets maximum number of sessions
+ *
+ * \return maximum number of sessions
+ *
+ */
+uint16_t tls_sec_prot_session_cache_size_get(void);
+
+/**
+ * tls_sec_prot_session_cache_read reads session for a supplicant
+ *
+ * \param eui_64 EUI-64 of the supplicant
+ * \param session session, identifier must be set, master secret and ciphersuite are filled in
+ *
+ * \return < 0 session not found or it belongs to another supplicant
+ * \return >= 0 success
+ *
+ */
+int8_t tls_sec_prot_session_cache_read(const uint8_t *eui_64, tls_sec_prot_lib_session_t *session);
+
+/**
+ * tls_sec_prot_session_cache_write writes session of a supplicant
+ *
+ * Replaces earlier session of the supplicant.
+ *
+ * \param eui_64 EUI-64 of the supplicant
+ * \param session session
+ * \param lifetime lifetime in seconds
+ *
+ * \return < 0 failure
+ * \return >= 0 success
+ *
+ */
+int8_t tls_sec_prot_session_cache_write(const uint8_t *eui_64, const tls_sec_prot_lib_session_t *session, uint32_t lifetime);
+
+/**
+ * tls_sec_prot_session_cache_entry_get gets session cache entry by index
+ *
+ * \param index index, from zero to cache size - 1
+ * \param eui_64 EUI-64 of the supplicant
+ * \param session session
+ * \param lifetime remaining lifetime in seconds
+ *
+ * \return < 0 entry is not in use
+ * \return >= 0 success
+ *
+ */
+int8_t tls_sec_prot_session_cache_entry_get(uint16_t index, uint8_t *eui_64, tls_sec_prot_lib_session_t *session, uint32_t *lifetime);
+
+/**
+ * tls_sec_prot_session_cache_supp_delete deletes session of a supplicant
+ *
+ * \param eui_64 EUI-64 of the supplicant
+ *
+ * \return true session was deleted
+ * \return false supplicant did not have a session
+ *
+ */
+bool tls_sec_prot_session_cache_supp_delete(const uint8_t *eui_64);
+
+/**
+ * tls_sec_prot_session_cache_flush deletes all sessions
+ *
+ * Must be called when trust anchors or revocation lists change so that
+ * sessions established with old configuration are not resumed.
+ *
+ */
+void tls_sec_prot_session_cache_flush(void);
+
+/**
+ * tls_sec_prot_session_cache_timer session cache timer
+ *
+ * \param seconds seconds passed
+ *
+ */
+void tls_sec_prot_session_cache_timer(uint16_t seconds);
+
+/**
+ * tls_sec_prot_session_cache_updated_get checks whether cache has been updated since last reset
+ *
+ * Expiry of sessions does not mark the cache updated.
+ *
+ * \return true cache has been updated
+ * \return false cache has not been updated
+ *
+ */
+bool tls_sec_prot_session_cache_updated_get(void);
+
+/**
+ * tls_sec_prot_session_cache_updated_reset resets cache updated status
+ *
+ */
+void tls_sec_prot_session_cache_updated_reset(void);
+
+#endif /* TLS_SEC_PROT_SESSION_CACHE_H_ */
@@ -43,12 +43,34 @@
 #include "ccmLIB.h"
 #include "platform/arm_hal_aes.h"
 
+/* Counter blocks encrypted per AES burst, each burst also carries the
+ * pending CBC-MAC block */
+#ifndef CCM_KEYSTREAM_BLOCKS
+#define CCM_KEYSTREAM_BLOCKS 4
+#endif
+
+/* A burst is passed to arm_aes_encrypt_blocks() as an 8-bit block count */
+#if CCM_KEYSTREAM_BLOCKS < 1 || CCM_KEYSTREAM_BLOCKS > 254
+#error "CCM_KEYSTREAM_BLOCKS must be between 1 and 254"
+#endif
+
+/* Buffer of one AES burst: CBC-MAC state followed by keystream blocks */
+typedef struct {
+    uint32_t blocks[(1 + CCM_KEYSTREAM_BLOCKS) * 4];
+    arm_aes_context_t *aes_context;
+    uint8_t counter[16];        /* Next A[i] */
+    uint16_t keystream_pos;     /* Next unused keystream byte */
+    uint16_t keystream_end;     /* End of valid keystream bytes */
+    bool mac_pending;           /* MAC state must still be encrypted */
+} ccm_burst_t;
+
+#define CCM_BURST_MAC(b)        ((uint8_t *) (b)->blocks)
+#define CCM_BURST_KEYSTREAM(b)  ((uint8_t *) (b)->blocks + 16)
+
 static void ccm_generate_A0(uint8_t *ptr, ccm_globals_t *ccm_pramters);
 static void ccm_auth_generate_B0(uint8_t *ptr, ccm_globals_t *ccm_params);
-static void ccm_auth_calc_Xi(void *aes_context, uint8_t X[static 16], uint8_t Blen, const uint8_t B[static Blen]);
 static uint8_t ccm_mic_len_calc(uint8_t sec_level);
-static void ccm_encode(ccm_globals_t *ccm_params);
-static int8_t ccm_calc_auth_MIC(ccm_globals_t *ccm_params);
+static int8_t ccm_process_data(ccm_globals_t *ccm_params);
 
 /**
  * \brief A function to init CCM library.
@@ -115,29 +137,7 @@ int8_t ccm_process_run(ccm_globals_t *ccm_params)
         goto END;
     }
 
-    if (ccm_params->ccm_encode_mode == AES_CCM_ENCRYPT) {
-        if (ccm_params->mic_len) {
-            //Calc
-            if (ccm_calc_auth_MIC(ccm_params)) {
-                goto END;
-            }
-        }
-        if (ccm_params->data_len) {
-            ccm_encode(ccm_params);
-        }
-        ret_val = 0;
-    } else {
-        if (ccm_params->data_len) {
-            ccm_encode(ccm_params);
-        }
-        if (ccm_params->mic_len) {
-            if (ccm_calc_auth_MIC(ccm_params) == 0) {
-                ret_val = 0;
-            }
-        } else {
-            ret_val = 0;
-        }
-    }
+    ret_val = ccm_process_data(ccm_params);
 
 END:
     ccm_free(ccm_params);
@@ -152,68 +152,129 @@ void ccm_free(ccm_globals_t *ccm_params)
 }
 
 
-/* Counter-mode encryption/decryption
- *  Ci := E(Key, Ai) ^ Mi
- */
-static void ccm_encode(ccm_globals_t *ccm_params)
+/* dst ^= src, a word at a time */
+static void ccm_xor(uint8_t *dst, const uint8_t *src, uint_fast8_t len)
 {
-    if (!ccm_params->key_ptr || ccm_params->ccm_sec_level < AES_SECURITY_LEVEL_ENC) {
-        return;
+    while (len >= 4) {
+        uint32_t d, s;
+        memcpy(&d, dst, 4);
+        memcpy(&s, src, 4);
+        d ^= s;
+        memcpy(dst, &d, 4);
+        dst += 4;
+        src += 4;
+        len -= 4;
     }
-    uint16_t len = ccm_params->data_len;
-    uint8_t *ptr = ccm_params->data_ptr;
-    uint8_t Ai[16], Si[16];
+    while (len--) {
+        *dst++ ^= *src++;
+    }
+}
 
-    //first, generate A0
-    ccm_generate_A0(Ai, ccm_params);
+/* Encrypt pending MAC state and the next keystream_blocks counter blocks in one burst */
+static void ccm_burst_run(ccm_burst_t *burst, uint_fast8_t keystream_blocks)
+{
+    uint8_t *ptr = CCM_BURST_KEYSTREAM(burst);
 
-    while (len) {
+    for (uint_fast8_t i = 0; i < keystream_blocks; i++, ptr += 16) {
+        memcpy(ptr, burst->counter, 16);
         //increment counter in Ai - 16-bit increment enough; len is 16-bit
-        if (++Ai[15] == 0) {
-            ++Ai[14];
+        if (++burst->counter[15] == 0) {
+            ++burst->counter[14];
         }
+    }
+    if (keystream_blocks) {
+        burst->keystream_pos = 0;
+        burst->keystream_end = keystream_blocks * 16;
+    }
 
-        // Si := E(Key, Ai)
-        arm_aes_encrypt(ccm_params->aes_context, Ai, Si);
+    if (burst->mac_pending) {
+        arm_aes_encrypt_blocks(burst->aes_context, CCM_BURST_MAC(burst), CCM_BURST_MAC(burst), 1 + keystream_blocks);
+        burst->mac_pending = false;
+    } else if (keystream_blocks) {
+        arm_aes_encrypt_blocks(burst->aes_context, CCM_BURST_KEYSTREAM(burst), CCM_BURST_KEYSTREAM(burst), keystream_blocks);
+    }
+}
 
-        // output := Si ^ input
-        for (int_fast8_t i = 0; i < 16 && len; i++, len--) {
-            *ptr++ ^= Si[i];
-        }
+/* X[i+1] := E(Key, X[i] ^ B[i]), zero-padding B when Blen is < 16.
+ * The encryption is left pending so it can share a burst with keystream blocks.
+ */
+static void ccm_burst_mac(ccm_burst_t *burst, const uint8_t *B, uint_fast8_t Blen)
+{
+    if (burst->mac_pending) {
+        ccm_burst_run(burst, 0);
     }
+    ccm_xor(CCM_BURST_MAC(burst), B, Blen);
+    burst->mac_pending = true;
 }
 
+/* Ci := E(Key, Ai) ^ Mi for the next len <= 16 bytes */
+static void ccm_burst_ctr(ccm_burst_t *burst, uint8_t *ptr, uint_fast8_t len, uint16_t data_left)
+{
+    if (burst->keystream_pos == burst->keystream_end) {
+        uint_fast16_t blocks = (data_left + 15) / 16;
+        ccm_burst_run(burst, blocks < CCM_KEYSTREAM_BLOCKS ? blocks : CCM_KEYSTREAM_BLOCKS);
+    }
+    ccm_xor(ptr, CCM_BURST_KEYSTREAM(burst) + burst->keystream_pos, len);
+    burst->keystream_pos += 16;
+}
 
-static int8_t ccm_calc_auth_MIC(ccm_globals_t *ccm_params)
+/* CBC-MAC and counter-mode encryption/decryption in a single pass over the data.
+ * CBC-MAC is computed over the plaintext, so it runs before the block is
+ * encrypted and after it is decrypted.
+ */
+static int8_t ccm_process_data(ccm_globals_t *ccm_params)
 {
-    const uint8_t *data_ptr = ccm_params->data_ptr;
+    uint8_t *data_ptr = ccm_params->data_ptr;
     uint16_t data_len = ccm_params->data_len;
     const uint8_t *adata_ptr = ccm_params->adata_ptr;
     uint16_t adata_len = ccm_params->adata_len;
-    uint8_t Xi[16];
-
-    // As a convenience, treat "data" as "adata", reflecting that "Private
-    // Payload" is part of "a data" not "m data" for unencrypted modes.
-    // The distinction matters because there's an "align to block" between
-    // "a" and "m", which we don't do when it's all in "a".
-    if (ccm_params->ccm_sec_level < AES_SECURITY_LEVEL_ENC && data_len != 0) {
-        // This trick only works if data follows adata
-        if (data_ptr == adata_ptr + adata_len) {
-            adata_len += data_len;
-            data_len = 0;
-        } else {
-            return -1;
+    bool mac = ccm_params->mic_len != 0;
+    bool encrypt = ccm_params->key_ptr && ccm_params->ccm_sec_level >= AES_SECURITY_LEVEL_ENC;
+    bool decode = ccm_params->ccm_encode_mode == AES_CCM_DECRYPT;
+    ccm_burst_t burst;
+    uint8_t S0[16];
+
+    if (mac) {
+        // As a convenience, treat "data" as "adata", reflecting that "Private
+        // Payload" is part of "a data" not "m data" for unencrypted modes.
+        // The distinction matters because there's an "align to block" between
+        // "a" and "m", which we don't do when it's all in "a".
+        if (ccm_params->ccm_sec_level < AES_SECURITY_LEVEL_ENC && data_len != 0) {
+            // This trick only works if data follows adata
+            if (data_ptr == adata_ptr + adata_len) {
+                adata_len += data_len;
+                data_len = 0;
+            } else {
+                return -1;
+            }
         }
+    } else if (!encrypt) {
+        return 0;
+    }
+    if (!encrypt) {
+        data_len = 0;
     }
 
-    ccm_auth_generate_B0(Xi, ccm_params);  //Set B0
-
-    // Calculate X1: E(key, B0)
-    // [Could use ccm_auth_calc_Xi - it's formally X1 := E(key, B0 ^ X0), where X0 = 0]
-    arm_aes_encrypt(ccm_params->aes_context, Xi, Xi);
+    burst.aes_context = ccm_params->aes_context;
+    burst.keystream_pos = burst.keystream_end = 0;
+    burst.mac_pending = false;
+    ccm_generate_A0(burst.counter, ccm_params);
+
+    if (mac) {
+        // X1 := E(key, B0) shares the first burst with S0 := E(Key, A0)
+        ccm_auth_generate_B0(CCM_BURST_MAC(&burst), ccm_params);
+        burst.mac_pending = true;
+        uint_fast16_t blocks = 1 + (data_len + 15) / 16;
+        ccm_burst_run(&burst, blocks < CCM_KEYSTREAM_BLOCKS ? blocks : CCM_KEYSTREAM_BLOCKS);
+        memcpy(S0, CCM_BURST_KEYSTREAM(&burst), 16);
+        burst.keystream_pos = 16;
+    } else {
+        // Skip A0
+        burst.counter[15] = 1;
+    }
 
     //First authentication block has 2-byte length field concatenated
-    if (adata_len) {
+    if (mac && adata_len) {
         uint8_t B1[16];
         uint_fast8_t t_len = adata_len > 14 ? 14 : adata_len;
 
@@ -221,36 +282,46 @@ static int8_t ccm_calc_auth_MIC(ccm_globals_t *ccm_params)
         B1[1] = adata_len;
         memcpy(&B1[2], adata_ptr, t_len);
 
-        ccm_auth_calc_Xi(ccm_params->aes_context, Xi, 2 + t_len, B1);
+        ccm_burst_mac(&burst, B1, 2 + t_len);
         adata_ptr += t_len;
         adata_len -= t_len;
-    }
 
-    while (adata_len) {
-        uint_fast8_t t_len = adata_len > 16 ? 16 : adata_len;
+        while (adata_len) {
+            t_len = adata_len > 16 ? 16 : adata_len;
 
-        ccm_auth_calc_Xi(ccm_params->aes_context, Xi, t_len, adata_ptr);
-        adata_ptr += t_len;
-        adata_len -= t_len;
+            ccm_burst_mac(&burst, adata_ptr, t_len);
+            adata_ptr += t_len;
+            adata_len -= t_len;
+        }
     }
 
     while (data_len) {
         uint_fast8_t t_len = data_len > 16 ? 16 : data_len;
 
-        ccm_auth_calc_Xi(ccm_params->aes_context, Xi, t_len, data_ptr);
+        if (decode) {
+            ccm_burst_ctr(&burst, data_ptr, t_len, data_len);
+        }
+        if (mac) {
+            ccm_burst_mac(&burst, data_ptr, t_len);
+        }
+        if (!decode) {
+            ccm_burst_ctr(&burst, data_ptr, t_len, data_len);
+        }
         data_ptr += t_len;
         data_len -= t_len;
     }
 
-    // Authentication tag T is leftmost M octets of X[t+1]
-
-    // Encryption block S0 is E(Key, A0)
-    uint8_t S0[16];
-    ccm_generate_A0(S0, ccm_params);
-    arm_aes_encrypt(ccm_params->aes_context, S0, S0);
+    if (!mac) {
+        return 0;
+    }
+    if (burst.mac_pending) {
+        ccm_burst_run(&burst, 0);
+    }
 
+    // Authentication tag T is leftmost M octets of X[t+1]
     // Encrypted authentication tag U is S0^T (leftmost M octets)
-    if (ccm_params->ccm_encode_mode == AES_CCM_ENCRYPT) {
+    const uint8_t *Xi = CCM_BURST_MAC(&burst);
+    if (!decode) {
         for (uint_fast8_t i = 0; i < ccm_params->mic_len; i++) {
             ccm_params->mic[i] = Xi[i] ^ S0[i];
         }
@@ -283,16 +354,6 @@ static void ccm_generate_A0(uint8_t *ptr, ccm_globals_t *ccm_pramters)
     memset(ptr, 0, ccm_pramters->ccm_l_param);
 }
 
-/* Calculate X[i+1]: X[i+1] := E(Key, X[i] ^ B[i]) */
-/* Blen is <= 16; this handles zero-padding B when it is < 16 */
-static void ccm_auth_calc_Xi(void *aes_context, uint8_t X[static 16], uint8_t Blen, const uint8_t B[static Blen])
-{
-    for (uint_fast8_t i = 0; i < Blen; i++) {
-        X[i] ^= B[i];
-    }
-    arm_aes_encrypt(aes_context, X, X);
-}
-
 /* flags = reserved(1) || Adata(1) || M (3) || L (3)
  *         where M = 0 or (ccm_mic_len-2)/2
  *               L = CCM_L_PARAM - 1
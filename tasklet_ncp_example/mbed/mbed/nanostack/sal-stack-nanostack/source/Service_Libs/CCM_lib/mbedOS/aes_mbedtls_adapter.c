@@ -42,6 +42,8 @@
  *     of arm_hal_aes.h, and other users of mbed TLS.
  */
 
+#include <string.h>
+
 /* Get the API we are implementing from libService */
 #include "platform/arm_hal_aes.h"
 #include "platform/arm_hal_interrupt.h"
@@ -60,50 +62,263 @@
 #include "aes_mbedtls.c"
 #endif /* NS_USE_EXTERNAL_MBED_TLS */
 
+/* Expanded keys kept after arm_aes_finish(), so that the next operation with
+ * the same key skips the key expansion. Started contexts always have their
+ * own ARM_AES_MBEDTLS_CONTEXT_MIN entries on top of the cached ones.
+ *
+ * A cached key is an mbed TLS context that has not been freed, and with
+ * MBEDTLS_AES_ALT that may keep the AES hardware open and powered until
+ * arm_aes_key_cache_flush(). Battery powered configurations that do not
+ * flush before sleeping should define ARM_AES_KEY_CACHE_SIZE as 0.
+ */
+#ifndef ARM_AES_KEY_CACHE_SIZE
+#define ARM_AES_KEY_CACHE_SIZE 4
+#endif
+
+#define ARM_AES_CONTEXT_COUNT (ARM_AES_MBEDTLS_CONTEXT_MIN + ARM_AES_KEY_CACHE_SIZE)
+
 struct arm_aes_context {
     mbedtls_aes_context ctx;
-    bool reserved;
+    uint8_t key[16];
+    uint32_t last_used;
+    uint8_t users;          /* Started contexts using the entry, entry reserved while non-zero */
+    bool initialized;       /* ctx holds an expanded key or is being set up */
+    bool key_valid;         /* ctx holds the expanded key, entry can be shared */
+    bool pinned;
 };
 
-static arm_aes_context_t context_list[ARM_AES_MBEDTLS_CONTEXT_MIN];
+static arm_aes_context_t context_list[ARM_AES_CONTEXT_COUNT];
+static uint32_t aes_context_clock;
 
-static arm_aes_context_t *mbed_tls_context_get(void)
+/* Called in critical section */
+static uint_fast8_t aes_context_idle_count(void)
 {
-    platform_enter_critical();
-    for (int i = 0; i < ARM_AES_MBEDTLS_CONTEXT_MIN; i++) {
-        if (!context_list[i].reserved) {
-            //Reserve context
-            context_list[i].reserved = true;
-            platform_exit_critical();
-            return &context_list[i];
+    uint_fast8_t count = 0;
+    for (int i = 0; i < ARM_AES_CONTEXT_COUNT; i++) {
+        if (context_list[i].initialized && !context_list[i].users) {
+            count++;
         }
     }
+    return count;
+}
 
-    platform_exit_critical();
+/* Called in critical section */
+static arm_aes_context_t *aes_context_cached_get(const uint8_t key[static 16])
+{
+    for (int i = 0; i < ARM_AES_CONTEXT_COUNT; i++) {
+        if (context_list[i].key_valid && memcmp(context_list[i].key, key, 16) == 0) {
+            return &context_list[i];
+        }
+    }
     return NULL;
 }
 
-arm_aes_context_t *arm_aes_start(const uint8_t key[static 16])
+/* Called in critical section */
+static arm_aes_context_t *aes_context_least_recently_used(void)
 {
-    arm_aes_context_t *context = mbed_tls_context_get();
-    if (context) {
-        mbedtls_aes_init(&context->ctx);
-        if (0 != mbedtls_aes_setkey_enc(&context->ctx, key, 128)) {
+    arm_aes_context_t *lru = NULL;
+    for (int i = 0; i < ARM_AES_CONTEXT_COUNT; i++) {
+        arm_aes_context_t *context = &context_list[i];
+        if (!context->initialized || context->users || context->pinned) {
+            continue;
+        }
+        if (!lru || (int32_t)(context->last_used - lru->last_used) < 0) {
+            lru = context;
+        }
+    }
+    return lru;
+}
+
+/* Called in critical section. Reserves an unused entry, or the least recently
+ * used cached key whose context the caller must free before reuse.
+ */
+static arm_aes_context_t *aes_context_reserve(bool *free_old)
+{
+    arm_aes_context_t *context = NULL;
+
+    *free_old = false;
+    for (int i = 0; i < ARM_AES_CONTEXT_COUNT; i++) {
+        if (!context_list[i].initialized) {
+            context = &context_list[i];
+            break;
+        }
+    }
+    if (!context) {
+        context = aes_context_least_recently_used();
+        if (!context) {
             return NULL;
         }
+        *free_old = true;
+    }
+    context->users = 1;
+    context->initialized = true;
+    context->key_valid = false;
+    context->pinned = false;
+    memset(context->key, 0, 16);
+    return context;
+}
+
+/* Entry must be reserved by the caller */
+static void aes_context_release(arm_aes_context_t *context)
+{
+    mbedtls_aes_free(&context->ctx);
+    platform_enter_critical();
+    memset(context->key, 0, 16);
+    context->key_valid = false;
+    context->pinned = false;
+    context->initialized = false;
+    context->users = 0;
+    platform_exit_critical();
+}
+
+static arm_aes_context_t *aes_context_start(const uint8_t key[static 16], bool pin)
+{
+    bool free_old;
+
+    platform_enter_critical();
+    arm_aes_context_t *context = aes_context_cached_get(key);
+    if (context) {
+        context->users++;
+        context->last_used = ++aes_context_clock;
+        context->pinned |= pin;
+        platform_exit_critical();
+        return context;
+    }
+    context = aes_context_reserve(&free_old);
+    platform_exit_critical();
+    if (!context) {
+        return NULL;
+    }
+
+    if (free_old) {
+        mbedtls_aes_free(&context->ctx);
+    }
+    mbedtls_aes_init(&context->ctx);
+    if (0 != mbedtls_aes_setkey_enc(&context->ctx, key, 128)) {
+        aes_context_release(context);
+        return NULL;
     }
+
+    platform_enter_critical();
+    memcpy(context->key, key, 16);
+    context->key_valid = true;
+    context->pinned = pin;
+    context->last_used = ++aes_context_clock;
+    platform_exit_critical();
     return context;
 }
 
+static void aes_context_stop(arm_aes_context_t *context)
+{
+    platform_enter_critical();
+    if (--context->users) {
+        platform_exit_critical();
+        return;
+    }
+    if (context->key_valid && aes_context_idle_count() <= ARM_AES_KEY_CACHE_SIZE) {
+        platform_exit_critical();
+        return;
+    }
+    if (context->key_valid) {
+        // Cache is full, drop the least recently used key which may be this one
+        context = aes_context_least_recently_used();
+        if (!context) {
+            platform_exit_critical();
+            return;
+        }
+    }
+    context->users = 1;
+    platform_exit_critical();
+    aes_context_release(context);
+}
+
+arm_aes_context_t *arm_aes_start(const uint8_t key[static 16])
+{
+    return aes_context_start(key, false);
+}
+
 void arm_aes_encrypt(arm_aes_context_t *aes_context, const uint8_t src[static 16], uint8_t dst[static 16])
 {
     mbedtls_aes_crypt_ecb(&aes_context->ctx, MBEDTLS_AES_ENCRYPT, src, dst);
 }
 
+void arm_aes_encrypt_blocks(arm_aes_context_t *aes_context, const uint8_t *src, uint8_t *dst, uint_fast8_t blocks)
+{
+    while (blocks--) {
+        mbedtls_aes_crypt_ecb(&aes_context->ctx, MBEDTLS_AES_ENCRYPT, src, dst);
+        src += 16;
+        dst += 16;
+    }
+}
+
 void arm_aes_finish(arm_aes_context_t *aes_context)
 {
-    mbedtls_aes_free(&aes_context->ctx);
+    aes_context_stop(aes_context);
+}
+
+int8_t arm_aes_key_pin(const uint8_t key[static 16])
+{
+    uint_fast8_t pinned = 0;
+
+    platform_enter_critical();
+    for (int i = 0; i < ARM_AES_CONTEXT_COUNT; i++) {
+        if (context_list[i].pinned) {
+            if (memcmp(context_list[i].key, key, 16) == 0) {
+                platform_exit_critical();
+                return 0;
+            }
+            pinned++;
+        }
+    }
+    platform_exit_critical();
+
+    // Leave room for unpinned keys so that started contexts can always be served
+    if (pinned >= ARM_AES_KEY_CACHE_SIZE) {
+        return -1;
+    }
+
+    arm_aes_context_t *context = aes_context_start(key, true);
+    if (!context) {
+        return -1;
+    }
+    aes_context_stop(context);
+    return 0;
+}
+
+void arm_aes_key_evict(const uint8_t key[static 16])
+{
     platform_enter_critical();
-    aes_context->reserved = false;
+    arm_aes_context_t *context = aes_context_cached_get(key);
+    while (context) {
+        context->pinned = false;
+        context->key_valid = false;
+        memset(context->key, 0, 16);
+        if (context->users) {
+            // Freed by arm_aes_finish() of the last user
+            context = aes_context_cached_get(key);
+            continue;
+        }
+        context->users = 1;
+        platform_exit_critical();
+        aes_context_release(context);
+        platform_enter_critical();
+        context = aes_context_cached_get(key);
+    }
+    platform_exit_critical();
+}
+
+void arm_aes_key_cache_flush(void)
+{
+    platform_enter_critical();
+    for (int i = 0; i < ARM_AES_CONTEXT_COUNT; i++) {
+        arm_aes_context_t *context = &context_list[i];
+        if (!context->initialized || context->users) {
+            continue;
+        }
+        context->users = 1;
+        platform_exit_critical();
+        aes_context_release(context);
+        platform_enter_critical();
+    }
     platform_exit_critical();
 }
@@ -104,7 +104,7 @@ static void tr51_calculate_channel_table(uint16_t number_of_channels, uint16_t n
     }
 }
 
-static void tr51_compute_cfd(uint8_t *mac, uint8_t *first_element, uint8_t *step_size, uint16_t channel_table_length)
+static void tr51_compute_cfd(const uint8_t *mac, uint8_t *first_element, uint8_t *step_size, uint16_t channel_table_length)
 {
     *first_element = (mac[5] ^ mac[6] ^ mac[7]) % channel_table_length;
     *step_size = (mac[7] % (channel_table_length - 1)) + 1;
@@ -208,13 +208,18 @@ int tr51_init_channel_table(int16_t *channel_table, int16_t number_of_channels)
     return 0;
 }
 
-int32_t tr51_get_uc_channel_index(int16_t *channel_table, uint8_t *output_table, uint16_t slot_number, uint8_t *mac, int16_t number_of_channels, uint32_t *excluded_channels)
+uint16_t tr51_get_uc_hopping_sequence(int16_t *channel_table, uint8_t *output_table, const uint8_t *mac, int16_t number_of_channels, uint32_t *excluded_channels)
 {
     uint16_t nearest_prime = tr51_calc_nearest_prime_number(number_of_channels);
     uint8_t first_element;
     uint8_t step_size;
     tr51_compute_cfd(mac, &first_element, &step_size, nearest_prime);
-    tr51_calculate_hopping_sequence(channel_table, nearest_prime, first_element, step_size, output_table, excluded_channels);
+    return tr51_calculate_hopping_sequence(channel_table, nearest_prime, first_element, step_size, output_table, excluded_channels);
+}
+
+int32_t tr51_get_uc_channel_index(int16_t *channel_table, uint8_t *output_table, uint16_t slot_number, uint8_t *mac, int16_t number_of_channels, uint32_t *excluded_channels)
+{
+    tr51_get_uc_hopping_sequence(channel_table, output_table, mac, number_of_channels, excluded_channels);
     return output_table[slot_number];
 }
 
@@ -27,63 +27,74 @@
 
 const int CHANNEL_LIST_SIZE_IN_BITS = 8 * 32;
 
-static bool channel_list_bit_test32(uint32_t word, int_fast8_t bit_number);
-static bool channel_list_bit_test(const uint32_t *list, int bit_number);
-
-// test bit by number
-static bool channel_list_bit_test32(uint32_t word, int_fast8_t bit_number)
+// number of bits set in a word
+static uint_fast8_t channel_list_count_bits32(uint32_t word)
 {
-    bool bitSet;
-
-    if (word & ((uint32_t) 1 << bit_number)) {
-        bitSet = true;
-    } else {
-        bitSet = false;
-    }
-    return bitSet;
+    word = word - ((word >> 1) & 0x55555555);
+    word = (word & 0x33333333) + ((word >> 2) & 0x33333333);
+    word = (word + (word >> 4)) & 0x0F0F0F0F;
+    return (word * 0x01010101) >> 24;
 }
 
-static bool channel_list_bit_test(const uint32_t *list, int bit_number)
+// bit number of the (index + 1)th set bit, word must have more than index bits set
+static uint_fast8_t channel_list_select32(uint32_t word, uint_fast8_t index)
 {
-    const int_fast8_t word_index = bit_number / 32;
-    const int_fast8_t bit_index = bit_number % 32;
-
-    return channel_list_bit_test32(list[word_index], bit_index);
+    uint_fast8_t bit_number = 0;
+
+    // narrow down to a byte, then step through its set bits
+    for (uint_fast8_t width = 16; width >= 8; width /= 2) {
+        uint_fast8_t low_count = channel_list_count_bits32(word & (((uint32_t) 1 << width) - 1));
+        if (index >= low_count) {
+            index -= low_count;
+            word >>= width;
+            bit_number += width;
+        }
+    }
+    while (index--) {
+        word &= word - 1;
+    }
+    // trailing zeros below the remaining lowest bit
+    return bit_number + channel_list_count_bits32((word & (~word + 1)) - 1);
 }
 
-static uint8_t channel_list_search(const uint32_t *list, int index)
+int channel_list_select(const uint32_t *list, int index, int number_of_channels)
 {
-    uint8_t channel = 0;
-    int enabled_channels = 0;
-    int i, j;
-
-    for (j = 0; j < 8; j++) {
-        for (i = 0; i < 32; i++) {
-            if (list[j] & ((uint32_t)1 << i)) {
-                enabled_channels++;
-                if (enabled_channels == (index + 1)) {
-                    goto exit;
-                }
-            }
-            channel++;
-        }
+    if (index < 0) {
+        return -1;
+    }
+    if (number_of_channels > CHANNEL_LIST_SIZE_IN_BITS) {
+        number_of_channels = CHANNEL_LIST_SIZE_IN_BITS;
     }
-exit:
-    return channel;
 
+    for (int word_index = 0; word_index * 32 < number_of_channels; word_index++) {
+        uint32_t word = list[word_index];
+        int channels_left = number_of_channels - word_index * 32;
+        if (channels_left < 32) {
+            word &= ((uint32_t) 1 << channels_left) - 1;
+        }
+        int enabled_channels = channel_list_count_bits32(word);
+        if (index < enabled_channels) {
+            return word_index * 32 + channel_list_select32(word, index);
+        }
+        index -= enabled_channels;
+    }
+    return -1;
 }
 
 uint8_t channel_list_get_channel(const uint32_t *list, int current_index)
 {
-    uint8_t found_index;
+    int channel;
 
     if (current_index >= CHANNEL_LIST_SIZE_IN_BITS) {
         current_index = 0;
     }
 
-    found_index = channel_list_search(list, current_index);
-
-    return found_index;
+    channel = channel_list_select(list, current_index, CHANNEL_LIST_SIZE_IN_BITS);
+    if (channel < 0) {
+        // Index past the enabled channels
+        return 0;
+    }
+    return channel;
 }
 
 void channel_list_set_channel(uint32_t *list, int channel, bool active)
@@ -99,17 +110,45 @@ void channel_list_set_channel(uint32_t *list, int channel, bool active)
     return;
 }
 
-// count the amount of channels enabled in a list
-int channel_list_count_channels(const uint32_t *list)
+int channel_list_clear_word(uint32_t *list, int word_index, uint32_t clear_mask)
 {
+    uint32_t cleared = list[word_index] & clear_mask;
 
-    int channel_count = 0;
+    list[word_index] ^= cleared;
+    return channel_list_count_bits32(cleared);
+}
 
-    for (int index = 0; index < CHANNEL_LIST_SIZE_IN_BITS; index++) {
+int channel_list_clear_range(uint32_t *list, int range_start, int range_stop)
+{
+    int cleared = 0;
 
-        if (channel_list_bit_test(list, index)) {
-            channel_count++;
+    if (range_start < 0) {
+        range_start = 0;
+    }
+    if (range_stop >= CHANNEL_LIST_SIZE_IN_BITS) {
+        range_stop = CHANNEL_LIST_SIZE_IN_BITS - 1;
+    }
+
+    for (int word_index = range_start / 32; word_index * 32 <= range_stop; word_index++) {
+        uint32_t clear_mask = 0xffffffff;
+        if (range_start > word_index * 32) {
+            clear_mask <<= range_start % 32;
+        }
+        if (range_stop < word_index * 32 + 31) {
+            clear_mask &= 0xffffffff >> (31 - range_stop % 32);
         }
+        cleared += channel_list_clear_word(list, word_index, clear_mask);
+    }
+    return cleared;
+}
+
+// count the amount of channels enabled in a list
+int channel_list_count_channels(const uint32_t *list)
+{
+    int channel_count = 0;
+
+    for (int word_index = 0; word_index < CHANNEL_LIST_SIZE_IN_BITS / 32; word_index++) {
+        channel_count += channel_list_count_bits32(list[word_index]);
     }
 
     return channel_count;
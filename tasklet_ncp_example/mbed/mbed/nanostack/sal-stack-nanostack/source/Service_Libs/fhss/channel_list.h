@@ -31,6 +31,20 @@ extern "C" {
  * @return channel number
  */
 uint8_t channel_list_get_channel(const uint32_t *list, int current_index);
+
+/**
+ * Find the channel with given index among the enabled channels.
+ *
+ * Channels are counted a word at a time, so the cost depends on the number
+ * of words scanned instead of the number of channels.
+ *
+ * @param list to scan
+ * @param index index among the enabled channels, 0 is the lowest enabled channel
+ * @param number_of_channels only channels below this are counted
+ *
+ * @return channel number, -1 if there are no more than index enabled channels
+ */
+int channel_list_select(const uint32_t *list, int index, int number_of_channels);
 /**
  * set matching bit on in in channel mask.
  *
@@ -50,6 +64,28 @@ void channel_list_set_channel(uint32_t *list, int channel, bool active);
  */
 int channel_list_count_channels(const uint32_t *list);
 
+/**
+ * Disable channels of one word of channel mask.
+ *
+ * @param list channel mask
+ * @param word_index index of the 32-bit word, channels word_index * 32 and up
+ * @param clear_mask bits of the channels to disable
+ *
+ * @return amount of channels that were enabled and got disabled
+ */
+int channel_list_clear_word(uint32_t *list, int word_index, uint32_t clear_mask);
+
+/**
+ * Disable a range of channels.
+ *
+ * @param list channel mask
+ * @param range_start first channel to disable
+ * @param range_stop last channel to disable
+ *
+ * @return amount of channels that were enabled and got disabled
+ */
+int channel_list_clear_range(uint32_t *list, int range_start, int range_stop);
+
 
 #ifdef __cplusplus
 }
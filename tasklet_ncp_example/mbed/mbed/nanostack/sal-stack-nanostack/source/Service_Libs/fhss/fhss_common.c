@@ -115,6 +115,7 @@ int8_t fhss_disable(fhss_structure_t *fhss_structure)
     ns_dyn_mem_free(fhss_structure->bs);
     ns_dyn_mem_free(fhss_structure->ws->tr51_channel_table);
     ns_dyn_mem_free(fhss_structure->ws->tr51_output_table);
+    ns_dyn_mem_free(fhss_structure->ws->tr51_cache);
     ns_dyn_mem_free(fhss_structure->ws);
     fhss_failed_list_free(fhss_structure);
     ns_dyn_mem_free(fhss_structure);
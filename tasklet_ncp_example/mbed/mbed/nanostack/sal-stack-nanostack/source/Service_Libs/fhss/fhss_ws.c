@@ -177,6 +177,28 @@ fhss_structure_t *fhss_ws_enable(fhss_api_t *fhss_api, const fhss_ws_configurati
     return fhss_struct;
 }
 
+/* Sequence cache is optional - TX falls back to computing the channel if not available.
+ * There is an entry for each neighbour once the neighbour table size is known, and
+ * a sequence can be as long as the nearest prime, so entries are sized for that.
+ */
+static void fhss_ws_tr51_cache_allocate(fhss_ws_t *ws, uint16_t cache_channels)
+{
+    uint8_t cache_size = ws->tr51_cache_neighbours ? ws->tr51_cache_neighbours : FHSS_WS_TR51_CACHE_SIZE;
+
+    ns_dyn_mem_free(ws->tr51_cache);
+    ws->tr51_cache = ns_dyn_mem_alloc(cache_size * (sizeof(fhss_ws_tr51_cache_entry_t) + cache_channels));
+    if (!ws->tr51_cache) {
+        ws->tr51_cache_sequences = NULL;
+        ws->tr51_cache_channels = 0;
+        ws->tr51_cache_size = 0;
+        return;
+    }
+    memset(ws->tr51_cache, 0, cache_size * sizeof(fhss_ws_tr51_cache_entry_t));
+    ws->tr51_cache_sequences = (uint8_t *)(ws->tr51_cache + cache_size);
+    ws->tr51_cache_channels = cache_channels;
+    ws->tr51_cache_size = cache_size;
+}
+
 static int fhss_ws_manage_channel_table_allocation(fhss_structure_t *fhss_structure, uint16_t channel_count)
 {
     // Must allocate channel table for TR51
@@ -188,9 +210,11 @@ static int fhss_ws_manage_channel_table_allocation(fhss_structure_t *fhss_struct
         fhss_structure->ws->tr51_output_table = ns_dyn_mem_alloc(sizeof(int16_t) * channel_count);
         if (!fhss_structure->ws->tr51_output_table) {
             ns_dyn_mem_free(fhss_structure->ws->tr51_channel_table);
+            fhss_structure->ws->tr51_channel_table = NULL;
             return -1;
         }
         tr51_init_channel_table(fhss_structure->ws->tr51_channel_table, channel_count);
+        fhss_ws_tr51_cache_allocate(fhss_structure->ws, tr51_calc_nearest_prime_number(channel_count));
     }
     return 0;
 }
@@ -287,17 +311,84 @@ static uint8_t calc_own_tx_trig_slot(uint8_t own_hop)
 static int32_t fhss_channel_index_from_mask(const uint32_t *channel_mask, int32_t channel_index, uint16_t number_of_channels)
 {
     //Function will return real active channel index at list
-    int32_t active_channels = 0;
-    // Set channel maks outside excluded channels
-    for (int32_t i = 0; i < number_of_channels; i++) {
-        if (channel_mask[0 + (i / 32)] & (1 << (i % 32))) {
-            if (channel_index == active_channels) {
-                return i;
-            }
-            active_channels++;
+    int channel = channel_list_select(channel_mask, channel_index, number_of_channels);
+    if (channel < 0) {
+        return 0;
+    }
+    return channel;
+}
+
+static bool fhss_ws_tr51_cache_entry_match(const fhss_ws_tr51_cache_entry_t *entry, const uint8_t eui64[8], uint16_t number_of_channels, const uint32_t *channel_mask)
+{
+    return entry->number_of_channels == number_of_channels && !memcmp(entry->eui64, eui64, 8) &&
+           !memcmp(entry->channel_mask, channel_mask, sizeof(entry->channel_mask));
+}
+
+/* TR51 unicast sequences of TX destinations, already mapped through the
+ * destination's channel mask, so choosing the TX channel is a single index.
+ * Entries are keyed on everything the sequence depends on, so a changed
+ * schedule IE simply misses and refills the entry of the destination, or the
+ * least recently used one. With an entry per neighbour, no neighbour then
+ * takes the entry of another. The neighbour keeps the number of its entry,
+ * plus one, in cache_entry, so a hit does not look through the cache.
+ */
+static const uint8_t *fhss_ws_tr51_cached_sequence(fhss_structure_t *fhss_structure, const uint8_t eui64[8], uint16_t number_of_channels, const uint32_t *channel_mask, uint8_t *cache_entry)
+{
+    fhss_ws_t *ws = fhss_structure->ws;
+    if (!ws->tr51_cache_sequences || number_of_channels > ws->tr51_cache_channels) {
+        return NULL;
+    }
+
+    if (*cache_entry && *cache_entry <= ws->tr51_cache_size &&
+            fhss_ws_tr51_cache_entry_match(&ws->tr51_cache[*cache_entry - 1], eui64, number_of_channels, channel_mask)) {
+        ws->tr51_cache[*cache_entry - 1].last_used = ++ws->tr51_cache_clock;
+        return ws->tr51_cache_sequences + (*cache_entry - 1) * ws->tr51_cache_channels;
+    }
+
+    fhss_ws_tr51_cache_entry_t *entry = &ws->tr51_cache[0];
+    fhss_ws_tr51_cache_entry_t *own = NULL;
+    for (uint_fast8_t i = 0; i < ws->tr51_cache_size; i++) {
+        fhss_ws_tr51_cache_entry_t *cur = &ws->tr51_cache[i];
+        if (fhss_ws_tr51_cache_entry_match(cur, eui64, number_of_channels, channel_mask)) {
+            cur->last_used = ++ws->tr51_cache_clock;
+            *cache_entry = i + 1;
+            return ws->tr51_cache_sequences + i * ws->tr51_cache_channels;
+        }
+        if (cur->number_of_channels && !memcmp(cur->eui64, eui64, 8)) {
+            own = cur;
+        }
+        if (cur->last_used < entry->last_used) {
+            entry = cur;
         }
     }
-    return 0;
+    if (own) {
+        entry = own;
+    }
+
+    uint8_t *sequence = ws->tr51_cache_sequences + (entry - ws->tr51_cache) * ws->tr51_cache_channels;
+    uint16_t length = tr51_get_uc_hopping_sequence(ws->tr51_channel_table, sequence, eui64, number_of_channels, NULL);
+
+    /* Map through the mask in one pass, as fhss_channel_index_from_mask() would
+     * for each slot. The enabled channels go in the output table, which only the
+     * uncached computation uses. Sequence values are below tr51_cache_channels,
+     * which is no more than the output table holds.
+     */
+    uint8_t *enabled = ws->tr51_output_table;
+    uint16_t enabled_count = 0;
+    for (uint16_t channel = 0; channel < fhss_structure->number_of_channels && channel < sizeof(entry->channel_mask) * 8 && enabled_count < ws->tr51_cache_channels; channel++) {
+        if (channel_mask[channel / 32] & ((uint32_t) 1 << (channel % 32))) {
+            enabled[enabled_count++] = channel;
+        }
+    }
+    for (uint16_t slot = 0; slot < number_of_channels; slot++) {
+        sequence[slot] = slot < length && sequence[slot] < enabled_count ? enabled[sequence[slot]] : 0;
+    }
+    memcpy(entry->eui64, eui64, 8);
+    memcpy(entry->channel_mask, channel_mask, sizeof(entry->channel_mask));
+    entry->number_of_channels = number_of_channels;
+    entry->last_used = ++ws->tr51_cache_clock;
+    *cache_entry = entry - ws->tr51_cache + 1;
+    return sequence;
 }
 
 static void fhss_broadcast_handler(const fhss_api_t *fhss_api, uint16_t delay)
@@ -680,8 +771,13 @@ static int fhss_ws_tx_handle_callback(const fhss_api_t *api, bool is_broadcast_a
         uint16_t destination_slot = fhss_ws_calculate_destination_slot(neighbor_timing_info, tx_time);
         int32_t tx_channel = neighbor_timing_info->uc_timing_info.fixed_channel;
         if (neighbor_timing_info->uc_timing_info.unicast_channel_function == WS_TR51CF) {
-            tx_channel = tr51_get_uc_channel_index(fhss_structure->ws->tr51_channel_table, fhss_structure->ws->tr51_output_table, destination_slot, destination_address, neighbor_timing_info->uc_timing_info.unicast_number_of_channels, NULL);
-            tx_channel = fhss_channel_index_from_mask(neighbor_timing_info->uc_channel_list.channel_mask, tx_channel, fhss_structure->number_of_channels);
+            const uint8_t *sequence = fhss_ws_tr51_cached_sequence(fhss_structure, destination_address, neighbor_timing_info->uc_timing_info.unicast_number_of_channels, neighbor_timing_info->uc_channel_list.channel_mask, &neighbor_timing_info->tr51_cache_entry);
+            if (sequence) {
+                tx_channel = sequence[destination_slot];
+            } else {
+                tx_channel = tr51_get_uc_channel_index(fhss_structure->ws->tr51_channel_table, fhss_structure->ws->tr51_output_table, destination_slot, destination_address, neighbor_timing_info->uc_timing_info.unicast_number_of_channels, NULL);
+                tx_channel = fhss_channel_index_from_mask(neighbor_timing_info->uc_channel_list.channel_mask, tx_channel, fhss_structure->number_of_channels);
+            }
         } else if (neighbor_timing_info->uc_timing_info.unicast_channel_function == WS_DH1CF) {
             tx_channel = dh1cf_get_uc_channel_index(destination_slot, destination_address, neighbor_timing_info->uc_channel_list.channel_count);
             tx_channel = fhss_channel_index_from_mask(neighbor_timing_info->uc_channel_list.channel_mask, tx_channel, fhss_structure->number_of_channels);
@@ -1176,6 +1272,9 @@ int fhss_ws_configuration_set(fhss_structure_t *fhss_structure, const fhss_ws_co
         fhss_structure->ws->tr51_channel_table = NULL;
         ns_dyn_mem_free(fhss_structure->ws->tr51_output_table);
         fhss_structure->ws->tr51_output_table = NULL;
+        ns_dyn_mem_free(fhss_structure->ws->tr51_cache);
+        fhss_structure->ws->tr51_cache = NULL;
+        fhss_structure->ws->tr51_cache_sequences = NULL;
 
         if (fhss_ws_manage_channel_table_allocation(fhss_structure, channel_count_uc > channel_count_bc ? channel_count_uc : channel_count_bc)) {
             return -1;
@@ -1209,6 +1308,10 @@ int fhss_ws_configuration_set(fhss_structure_t *fhss_structure, const fhss_ws_co
     }
 
     fhss_structure->number_of_channels = fhss_configuration->channel_mask_size;
+    // Cached TX sequences are mapped using number_of_channels
+    if (fhss_structure->ws->tr51_cache) {
+        memset(fhss_structure->ws->tr51_cache, 0, fhss_structure->ws->tr51_cache_size * sizeof(fhss_ws_tr51_cache_entry_t));
+    }
     fhss_structure->number_of_bc_channels = channel_count_bc;
     fhss_structure->number_of_uc_channels = channel_count_uc;
     if (fhss_configuration->ws_uc_channel_function == WS_FIXED_CHANNEL) {
@@ -1238,6 +1341,20 @@ int fhss_ws_set_hop_count(fhss_structure_t *fhss_structure, const uint8_t hop_co
     return 0;
 }
 
+int fhss_ws_set_neighbor_table_size(fhss_structure_t *fhss_structure, const uint8_t table_size)
+{
+    fhss_ws_t *ws = fhss_structure->ws;
+    // Neighbours keep their entry number plus one in a byte
+    ws->tr51_cache_neighbours = table_size < UINT8_MAX ? table_size : UINT8_MAX - 1;
+    // Without a cache now, the next channel table allocation sizes it
+    if (ws->tr51_cache && ws->tr51_cache_size != ws->tr51_cache_neighbours) {
+        platform_enter_critical();
+        fhss_ws_tr51_cache_allocate(ws, ws->tr51_cache_channels);
+        platform_exit_critical();
+    }
+    return 0;
+}
+
 int fhss_ws_set_tx_allowance_level(fhss_structure_t *fhss_structure, const fhss_ws_tx_allow_level global_level, const fhss_ws_tx_allow_level ef_level)
 {
     fhss_structure->ws->tx_level = global_level;
@@ -35,8 +35,19 @@
 #define EXPEDITED_FORWARDING_POLL_PERIOD    (5000 / 50)
 // TX poll interval used when channel schedules are not yet started (50us slots)
 #define DEFAULT_POLL_PERIOD    (10000 / 50)
+// Number of TR51 unicast hopping sequences cached for TX destinations, until the neighbour table size is set
+#ifndef FHSS_WS_TR51_CACHE_SIZE
+#define FHSS_WS_TR51_CACHE_SIZE 4
+#endif
 typedef struct fhss_ws fhss_ws_t;
 
+typedef struct fhss_ws_tr51_cache_entry {
+    uint8_t eui64[8];
+    uint16_t number_of_channels;    // 0 when entry is unused
+    uint32_t channel_mask[8];
+    uint32_t last_used;
+} fhss_ws_tr51_cache_entry_t;
+
 struct fhss_ws {
     uint8_t bc_channel;
     uint16_t uc_slot;
@@ -48,6 +59,12 @@ struct fhss_ws {
     int32_t drift_per_millisecond_ns;
     int16_t *tr51_channel_table;
     uint8_t *tr51_output_table;
+    fhss_ws_tr51_cache_entry_t *tr51_cache;  // tr51_cache_size entries, followed by their sequences
+    uint8_t *tr51_cache_sequences;      // Sequences of tr51_cache_channels each, inside the tr51_cache block
+    uint16_t tr51_cache_channels;       // Nearest prime of the channel count, 0 if no cache
+    uint8_t tr51_cache_size;
+    uint8_t tr51_cache_neighbours;      // Neighbour table size the cache is sized for, 0 until set
+    uint32_t tr51_cache_clock;
     uint32_t next_uc_timeout;
     uint32_t next_bc_timeout;
     uint32_t expedited_forwarding_enabled_us;
@@ -67,6 +84,7 @@ int fhss_ws_set_parent(fhss_structure_t *fhss_structure, const uint8_t eui64[8],
 int fhss_ws_remove_parent(fhss_structure_t *fhss_structure, const uint8_t eui64[8]);
 int fhss_ws_configuration_set(fhss_structure_t *fhss_structure, const fhss_ws_configuration_t *fhss_configuration);
 int fhss_ws_set_hop_count(fhss_structure_t *fhss_structure, const uint8_t hop_count);
+int fhss_ws_set_neighbor_table_size(fhss_structure_t *fhss_structure, const uint8_t table_size);
 int fhss_ws_set_tx_allowance_level(fhss_structure_t *fhss_structure, const fhss_ws_tx_allow_level global_level, const fhss_ws_tx_allow_level ef_level);
 void fhss_set_txrx_slot_length(fhss_structure_t *fhss_structure);
 
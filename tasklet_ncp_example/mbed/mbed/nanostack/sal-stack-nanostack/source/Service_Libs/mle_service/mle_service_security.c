@@ -94,6 +94,11 @@ int mle_service_security_instance_delete(int8_t interface_id)
 {
     ns_list_foreach(mle_service_security_isntance_list_t, cur_ptr, &srv_security_instance_list) {
         if (cur_ptr->interface_id == interface_id) {
+            for (uint8_t i = 0; i < MLE_MAX_KEY_TABLE_SIZE; i++) {
+                if (cur_ptr->security_params.mle_security_key_table[i].key_valid) {
+                    arm_aes_key_evict(cur_ptr->security_params.mle_security_key_table[i].aes_key);
+                }
+            }
             ns_list_remove(&srv_security_instance_list, cur_ptr);
             ns_dyn_mem_free(cur_ptr);
             return 0;
@@ -307,6 +312,8 @@ bool mle_service_security_key_set(mle_security_components_t *sec_ptr, const uint
 
     if (memcmp(key_entry->aes_key, key, 16) != 0) {
         key_changed = true;
+        arm_aes_key_evict(key_entry->aes_key);
+        arm_aes_key_pin(key);
     }
 
     key_entry->key_id = keyId;
@@ -319,6 +326,7 @@ bool mle_service_security_key_set(mle_security_components_t *sec_ptr, const uint
         key_entry = mle_service_security_key_entry_get(sec_ptr, !set_primary);
         if (key_entry) {
             key_entry->key_valid = false;
+            arm_aes_key_evict(key_entry->aes_key);
         }
     }
 
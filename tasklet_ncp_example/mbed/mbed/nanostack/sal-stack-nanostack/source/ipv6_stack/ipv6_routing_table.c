@@ -44,6 +44,7 @@
 #include "nsdynmemLIB.h"
 #include "Service_Libs/etx/etx.h"
 #include "Common_Protocols/ipv6_resolution.h"
+#include "Service_Libs/fnv_hash/fnv_hash.h"
 #include <stdarg.h>
 #include <stdio.h>
 
@@ -90,7 +91,22 @@ static neighbour_cache_config_t neighbour_cache_config = {NCACHE_MAX_ABSOLUTE, N
 /* For probable routers, consider them unreachable if ETX is greater than this */
 #define ETX_REACHABILITY_THRESHOLD 0x200    /* 8.8 fixed-point, so 2 */
 
+/* Neighbour and Destination Cache look-ups go through hash tables keyed on
+ * the IPv6 address; the lists are still kept for LRU order and GC. Tables
+ * start small and double when chains average more than 2 entries. If a table
+ * can't be allocated, look-ups fall back to walking the list.
+ */
+#ifndef IPV6_ADDR_HASH_SIZE_MIN
+#define IPV6_ADDR_HASH_SIZE_MIN 16
+#endif
+#ifndef IPV6_ADDR_HASH_SIZE_MAX
+#define IPV6_ADDR_HASH_SIZE_MAX 1024
+#endif
+
 static NS_LIST_DEFINE(ipv6_destination_cache, ipv6_destination_t, link);
+static ipv6_destination_t **ipv6_destination_hash_table;
+static uint16_t ipv6_destination_hash_size;
+static uint16_t ipv6_destination_cache_count;
 static NS_LIST_DEFINE(ipv6_routing_table, ipv6_route_t, link);
 
 static ipv6_destination_t *ipv6_destination_lookup(const uint8_t *address, int8_t interface_id);
@@ -101,14 +117,36 @@ static void ipv6_route_table_remove_router(int8_t interface_id, const uint8_t *a
 static uint16_t total_metric(const ipv6_route_t *route);
 static uint8_t ipv6_route_table_count_source(int8_t interface_id, ipv6_route_src_t source);
 static void ipv6_route_table_remove_last_one_from_source(int8_t interface_id, ipv6_route_src_t source);
+static void ipv6_route_move_to_end(ipv6_route_t *route);
 static uint8_t ipv6_route_table_get_max_entries(int8_t interface_id, ipv6_route_src_t source);
 
 static uint16_t dcache_gc_timer;
 
 #ifdef WISUN_NCP_ENABLE
 extern void nanostack_process_routing_table_update_from_stack(uint8_t changed_info, uint8_t* prefix, uint8_t len_prefix, uint8_t* addr_nexthop, uint32_t lifetime);
+/* Next route to look at in the NCP host snapshot, NULL past the end */
+static ipv6_route_t *ipv6_route_host_cursor;
 #endif //WISUN_NCP_ENABLE
 
+static uint_fast16_t ipv6_addr_hash(const uint8_t address[static 16], uint16_t hash_size)
+{
+    uint32_t hash = fnv_hash_1a_32_reverse_block(address, 16);
+    /* Fold the top half in - low FNV bits alone spread poorly over small tables */
+    return (hash ^ (hash >> 16)) & (hash_size - 1);
+}
+
+/* Returns the table size to move to when holding "count" entries, or 0 to keep the current one */
+static uint16_t ipv6_addr_hash_resize_needed(uint16_t hash_size, uint_fast16_t count)
+{
+    if (hash_size == 0) {
+        return IPV6_ADDR_HASH_SIZE_MIN;
+    }
+    if (count > 2u * hash_size && hash_size < IPV6_ADDR_HASH_SIZE_MAX) {
+        return hash_size * 2;
+    }
+    return 0;
+}
+
 static uint32_t next_probe_time(ipv6_neighbour_cache_t *cache, uint_fast8_t retrans_num)
 {
     uint32_t t = cache->retrans_timer;
@@ -218,12 +256,72 @@ static void ipv6_neighbour_gone(ipv6_neighbour_cache_t *cache, uint8_t address[s
     ipv6_destination_cache_forget_router(cache, address);
 }
 
+/* Rebuild the hash table from the list with a new size. Existing table is kept on failure. */
+static bool ipv6_neighbour_hash_rebuild(ipv6_neighbour_cache_t *cache, uint16_t hash_size)
+{
+    ipv6_neighbour_t **table = ns_dyn_mem_alloc(hash_size * sizeof(ipv6_neighbour_t *));
+    if (!table) {
+        return false;
+    }
+    memset(table, 0, hash_size * sizeof(ipv6_neighbour_t *));
+
+    ns_list_foreach(ipv6_neighbour_t, cur, &cache->list) {
+        uint_fast16_t i = ipv6_addr_hash(cur->ip_address, hash_size);
+        cur->hash_next = table[i];
+        table[i] = cur;
+    }
+
+    ns_dyn_mem_free(cache->hash_table);
+    cache->hash_table = table;
+    cache->hash_size = hash_size;
+    return true;
+}
+
+/* Entry must already be on the list */
+static void ipv6_neighbour_hash_add(ipv6_neighbour_cache_t *cache, ipv6_neighbour_t *entry)
+{
+    cache->num_entries++;
+
+    uint16_t hash_size = ipv6_addr_hash_resize_needed(cache->hash_size, cache->num_entries);
+    if (hash_size && ipv6_neighbour_hash_rebuild(cache, hash_size)) {
+        return;
+    }
+
+    if (cache->hash_table) {
+        uint_fast16_t i = ipv6_addr_hash(entry->ip_address, cache->hash_size);
+        entry->hash_next = cache->hash_table[i];
+        cache->hash_table[i] = entry;
+    }
+}
+
+static void ipv6_neighbour_hash_remove(ipv6_neighbour_cache_t *cache, ipv6_neighbour_t *entry)
+{
+    cache->num_entries--;
+
+    if (!cache->hash_table) {
+        return;
+    }
+
+    ipv6_neighbour_t **prev = &cache->hash_table[ipv6_addr_hash(entry->ip_address, cache->hash_size)];
+    while (*prev) {
+        if (*prev == entry) {
+            *prev = entry->hash_next;
+            break;
+        }
+        prev = &(*prev)->hash_next;
+    }
+}
+
 void ipv6_neighbour_cache_init(ipv6_neighbour_cache_t *cache, int8_t interface_id)
 {
     /* Init Double linked Routing Table */
     ns_list_foreach_safe(ipv6_neighbour_t, cur, &cache->list) {
         ipv6_neighbour_entry_remove(cache, cur);
     }
+    ns_dyn_mem_free(cache->hash_table);
+    cache->hash_table = NULL;
+    cache->hash_size = 0;
+    cache->num_entries = 0;
     cache->gc_timer = NCACHE_GC_PERIOD;
     cache->retrans_timer = 1000;
     cache->max_ll_len = 0;
@@ -251,6 +349,15 @@ void ipv6_neighbour_cache_flush(ipv6_neighbour_cache_t *cache)
 
 ipv6_neighbour_t *ipv6_neighbour_lookup(ipv6_neighbour_cache_t *cache, const uint8_t *address)
 {
+    if (cache->hash_table) {
+        for (ipv6_neighbour_t *cur = cache->hash_table[ipv6_addr_hash(address, cache->hash_size)]; cur; cur = cur->hash_next) {
+            if (addr_ipv6_equal(cur->ip_address, address)) {
+                return cur;
+            }
+        }
+        return NULL;
+    }
+
     ns_list_foreach(ipv6_neighbour_t, cur, &cache->list) {
         if (addr_ipv6_equal(cur->ip_address, address)) {
             return cur;
@@ -278,6 +385,7 @@ void ipv6_neighbour_entry_remove(ipv6_neighbour_cache_t *cache, ipv6_neighbour_t
      * the entry.
      */
     ns_list_remove(&cache->list, entry);
+    ipv6_neighbour_hash_remove(cache, entry);
     switch (entry->state) {
         case IP_NEIGHBOUR_NEW:
             break;
@@ -305,29 +413,32 @@ void ipv6_neighbour_entry_remove(ipv6_neighbour_cache_t *cache, ipv6_neighbour_t
 
 ipv6_neighbour_t *ipv6_neighbour_lookup_or_create(ipv6_neighbour_cache_t *cache, const uint8_t *address/*, bool tentative*/)
 {
-    uint_fast16_t count = 0;
-    ipv6_neighbour_t *entry = NULL;
-    ipv6_neighbour_t *garbage_possible_entry = NULL;
-
-    ns_list_foreach(ipv6_neighbour_t, cur, &cache->list) {
+    ipv6_neighbour_t *entry = ipv6_neighbour_lookup(cache, address);
 
-        if (cur->type == IP_NEIGHBOUR_GARBAGE_COLLECTIBLE) {
-            garbage_possible_entry = cur;
-            count++;
+    if (entry) {
+        if (entry != ns_list_get_first(&cache->list)) {
+            ns_list_remove(&cache->list, entry);
+            ns_list_add_to_start(&cache->list, entry);
         }
+        return entry;
+    }
 
-        if (addr_ipv6_equal(cur->ip_address, address)) {
-            if (cur != ns_list_get_first(&cache->list)) {
-                ns_list_remove(&cache->list, cur);
-                ns_list_add_to_start(&cache->list, cur);
+    /* Only need to count garbage-collectible entries if the cache could be full */
+    if (cache->num_entries >= neighbour_cache_config.max_entries) {
+        uint_fast16_t count = 0;
+        ipv6_neighbour_t *garbage_possible_entry = NULL;
+
+        ns_list_foreach(ipv6_neighbour_t, cur, &cache->list) {
+            if (cur->type == IP_NEIGHBOUR_GARBAGE_COLLECTIBLE) {
+                garbage_possible_entry = cur;
+                count++;
             }
-            return cur;
         }
-    }
 
-    if (count >= neighbour_cache_config.max_entries && garbage_possible_entry) {
-        //Remove Last storaged IP_NEIGHBOUR_GARBAGE_COLLECTIBLE type entry
-        ipv6_neighbour_entry_remove(cache, garbage_possible_entry);
+        if (count >= neighbour_cache_config.max_entries && garbage_possible_entry) {
+            //Remove Last storaged IP_NEIGHBOUR_GARBAGE_COLLECTIBLE type entry
+            ipv6_neighbour_entry_remove(cache, garbage_possible_entry);
+        }
     }
 
     // Allocate new - note we have a basic size, plus enough for the LL address,
@@ -358,6 +469,7 @@ ipv6_neighbour_t *ipv6_neighbour_lookup_or_create(ipv6_neighbour_cache_t *cache,
     }
 
     ns_list_add_to_start(&cache->list, entry);
+    ipv6_neighbour_hash_add(cache, entry);
 
     return entry;
 }
@@ -889,11 +1001,75 @@ void ipv6_destination_cache_print(route_print_fn_t *print_fn)
     }
 }
 
-static ipv6_destination_t *ipv6_destination_lookup(const uint8_t *address, int8_t interface_id)
+static bool ipv6_destination_hash_rebuild(uint16_t hash_size)
 {
-    bool is_ll = addr_is_ipv6_link_local(address);
+    ipv6_destination_t **table = ns_dyn_mem_alloc(hash_size * sizeof(ipv6_destination_t *));
+    if (!table) {
+        return false;
+    }
+    memset(table, 0, hash_size * sizeof(ipv6_destination_t *));
 
-    if (is_ll && interface_id == -1) {
+    ns_list_foreach(ipv6_destination_t, cur, &ipv6_destination_cache) {
+        uint_fast16_t i = ipv6_addr_hash(cur->destination, hash_size);
+        cur->hash_next = table[i];
+        table[i] = cur;
+    }
+
+    ns_dyn_mem_free(ipv6_destination_hash_table);
+    ipv6_destination_hash_table = table;
+    ipv6_destination_hash_size = hash_size;
+    return true;
+}
+
+/* Entry must already be on the list */
+static void ipv6_destination_hash_add(ipv6_destination_t *entry)
+{
+    ipv6_destination_cache_count++;
+
+    uint16_t hash_size = ipv6_addr_hash_resize_needed(ipv6_destination_hash_size, ipv6_destination_cache_count);
+    if (hash_size && ipv6_destination_hash_rebuild(hash_size)) {
+        return;
+    }
+
+    if (ipv6_destination_hash_table) {
+        uint_fast16_t i = ipv6_addr_hash(entry->destination, ipv6_destination_hash_size);
+        entry->hash_next = ipv6_destination_hash_table[i];
+        ipv6_destination_hash_table[i] = entry;
+    }
+}
+
+static void ipv6_destination_hash_remove(ipv6_destination_t *entry)
+{
+    ipv6_destination_cache_count--;
+
+    if (!ipv6_destination_hash_table) {
+        return;
+    }
+
+    ipv6_destination_t **prev = &ipv6_destination_hash_table[ipv6_addr_hash(entry->destination, ipv6_destination_hash_size)];
+    while (*prev) {
+        if (*prev == entry) {
+            *prev = entry->hash_next;
+            break;
+        }
+        prev = &(*prev)->hash_next;
+    }
+}
+
+static ipv6_destination_t *ipv6_destination_find(const uint8_t *address, int8_t interface_id, bool interface_specific)
+{
+    if (ipv6_destination_hash_table) {
+        for (ipv6_destination_t *cur = ipv6_destination_hash_table[ipv6_addr_hash(address, ipv6_destination_hash_size)]; cur; cur = cur->hash_next) {
+            if (!addr_ipv6_equal(cur->destination, address)) {
+                continue;
+            }
+            /* For LL addresses, interface ID must also be compared */
+            if (interface_specific && cur->interface_id != interface_id) {
+                continue;
+            }
+
+            return cur;
+        }
         return NULL;
     }
 
@@ -902,7 +1078,7 @@ static ipv6_destination_t *ipv6_destination_lookup(const uint8_t *address, int8_
             continue;
         }
         /* For LL addresses, interface ID must also be compared */
-        if (is_ll && cur->interface_id != interface_id) {
+        if (interface_specific && cur->interface_id != interface_id) {
             continue;
         }
 
@@ -912,6 +1088,17 @@ static ipv6_destination_t *ipv6_destination_lookup(const uint8_t *address, int8_
     return NULL;
 }
 
+static ipv6_destination_t *ipv6_destination_lookup(const uint8_t *address, int8_t interface_id)
+{
+    bool is_ll = addr_is_ipv6_link_local(address);
+
+    if (is_ll && interface_id == -1) {
+        return NULL;
+    }
+
+    return ipv6_destination_find(address, interface_id, is_ll);
+}
+
 /* Unlike original version, this does NOT perform routing check - it's pure destination cache look-up
  *
  * We no longer attempt to cache route lookups in the destination cache, as
@@ -926,8 +1113,7 @@ static ipv6_destination_t *ipv6_destination_lookup(const uint8_t *address, int8_
  */
 ipv6_destination_t *ipv6_destination_lookup_or_create(const uint8_t *address, int8_t interface_id)
 {
-    uint_fast16_t count = 0;
-    ipv6_destination_t *entry = NULL;
+    ipv6_destination_t *entry;
     bool interface_specific = addr_ipv6_scope(address, NULL) <= IPV6_SCOPE_REALM_LOCAL;
 
     if (interface_specific && interface_id == -1) {
@@ -935,23 +1121,10 @@ ipv6_destination_t *ipv6_destination_lookup_or_create(const uint8_t *address, in
     }
 
     /* Find any existing entry */
-    ns_list_foreach(ipv6_destination_t, cur, &ipv6_destination_cache) {
-        count++;
-        if (!addr_ipv6_equal(cur->destination, address)) {
-            continue;
-        }
-        /* For LL addresses, interface ID must also be compared */
-        if (interface_specific && cur->interface_id != interface_id) {
-            continue;
-        }
-
-        entry = cur;
-        break;
-    }
-
+    entry = ipv6_destination_find(address, interface_id, interface_specific);
 
     if (!entry) {
-        if (count > destination_cache_config.max_entries) {
+        if (ipv6_destination_cache_count > destination_cache_config.max_entries) {
             entry = ns_list_get_last(&ipv6_destination_cache);
             ipv6_destination_release(entry);
         }
@@ -980,6 +1153,7 @@ ipv6_destination_t *ipv6_destination_lookup_or_create(const uint8_t *address, in
             entry->interface_id = -1;
         }
         ns_list_add_to_start(&ipv6_destination_cache, entry);
+        ipv6_destination_hash_add(entry);
     } else if (entry != ns_list_get_first(&ipv6_destination_cache)) {
         /* If there was an entry, and it wasn't at the start, move it */
         ns_list_remove(&ipv6_destination_cache, entry);
@@ -1115,6 +1289,7 @@ static bool ipv6_destination_release(ipv6_destination_t *dest)
 {
     if (--dest->refcount == 0) {
         ns_list_remove(&ipv6_destination_cache, dest);
+        ipv6_destination_hash_remove(dest);
         tr_debug("Destination cache remove: %s", trace_ipv6(dest->destination));
         ns_dyn_mem_free(dest);
         return true;
@@ -1246,6 +1421,169 @@ void ipv6_route_table_set_next_hop_fn(ipv6_route_src_t src, ipv6_route_next_hop_
     ipv6_route_next_hop_computation[src] = fn;
 }
 
+/* Routes are also indexed by a path-compressed binary trie on their prefix,
+ * so look-ups only visit the prefixes that match the destination rather than
+ * the whole table. Each node holds the routes for exactly one prefix, kept in
+ * the same relative order as ipv6_routing_table so round-robin and tiebreak
+ * behaviour is unchanged. Nodes without routes only exist as branch points.
+ */
+typedef struct ipv6_route_node {
+    struct ipv6_route_node *child[2];
+    uint8_t prefix_len;
+    uint8_t prefix[16];
+    NS_LIST_HEAD(ipv6_route_t, node_link) routes;
+} ipv6_route_node_t;
+
+static ipv6_route_node_t *ipv6_route_trie;
+
+static uint_fast8_t ipv6_route_trie_bit(const uint8_t *addr, uint_fast8_t bit)
+{
+    return (addr[bit >> 3] >> (7 - (bit & 7))) & 1;
+}
+
+/* Number of leading bits in common, looking at no more than max_bits */
+static uint_fast8_t ipv6_route_trie_common_bits(const uint8_t *a, const uint8_t *b, uint_fast8_t max_bits)
+{
+    uint_fast8_t bits = 0;
+
+    while (bits < max_bits) {
+        uint8_t diff = a[bits >> 3] ^ b[bits >> 3];
+        if (diff) {
+            while (!(diff & 0x80)) {
+                diff <<= 1;
+                bits++;
+            }
+            break;
+        }
+        bits += 8;
+    }
+
+    return bits < max_bits ? bits : max_bits;
+}
+
+static ipv6_route_node_t *ipv6_route_trie_node_create(const uint8_t *prefix, uint_fast8_t prefix_len)
+{
+    ipv6_route_node_t *node = ns_dyn_mem_alloc(sizeof(ipv6_route_node_t));
+    if (!node) {
+        return NULL;
+    }
+    node->child[0] = node->child[1] = NULL;
+    node->prefix_len = prefix_len;
+    memset(node->prefix, 0, sizeof node->prefix);
+    bitcopy(node->prefix, prefix, prefix_len);
+    ns_list_init(&node->routes);
+    return node;
+}
+
+/* Step to the next node on the path to addr that matches it - NULL node to start from the root */
+static ipv6_route_node_t *ipv6_route_trie_match_next(const ipv6_route_node_t *node, const uint8_t addr[static 16])
+{
+    ipv6_route_node_t *next;
+
+    if (!node) {
+        next = ipv6_route_trie;
+    } else if (node->prefix_len < 128) {
+        next = node->child[ipv6_route_trie_bit(addr, node->prefix_len)];
+    } else {
+        return NULL;
+    }
+
+    if (next && !bitsequal(addr, next->prefix, next->prefix_len)) {
+        return NULL;
+    }
+
+    return next;
+}
+
+static ipv6_route_node_t *ipv6_route_trie_find(const uint8_t *prefix, uint_fast8_t prefix_len)
+{
+    ipv6_route_node_t *node = ipv6_route_trie;
+
+    while (node && node->prefix_len <= prefix_len) {
+        if (ipv6_route_trie_common_bits(prefix, node->prefix, node->prefix_len) != node->prefix_len) {
+            return NULL;
+        }
+        if (node->prefix_len == prefix_len) {
+            return node;
+        }
+        node = node->child[ipv6_route_trie_bit(prefix, node->prefix_len)];
+    }
+
+    return NULL;
+}
+
+static ipv6_route_node_t *ipv6_route_trie_insert(const uint8_t *prefix, uint_fast8_t prefix_len)
+{
+    ipv6_route_node_t **link = &ipv6_route_trie;
+
+    for (;;) {
+        ipv6_route_node_t *node = *link;
+        if (!node) {
+            return *link = ipv6_route_trie_node_create(prefix, prefix_len);
+        }
+
+        uint_fast8_t common = ipv6_route_trie_common_bits(prefix, node->prefix, prefix_len < node->prefix_len ? prefix_len : node->prefix_len);
+        if (common == node->prefix_len) {
+            if (common == prefix_len) {
+                return node;
+            }
+            link = &node->child[ipv6_route_trie_bit(prefix, common)];
+            continue;
+        }
+
+        /* Diverges within this node's prefix - new node goes above it */
+        if (common == prefix_len) {
+            ipv6_route_node_t *new_node = ipv6_route_trie_node_create(prefix, prefix_len);
+            if (new_node) {
+                new_node->child[ipv6_route_trie_bit(node->prefix, common)] = node;
+                *link = new_node;
+            }
+            return new_node;
+        }
+
+        /* Or alongside it, under a new branch point */
+        ipv6_route_node_t *branch = ipv6_route_trie_node_create(prefix, common);
+        ipv6_route_node_t *new_node = ipv6_route_trie_node_create(prefix, prefix_len);
+        if (!branch || !new_node) {
+            ns_dyn_mem_free(branch);
+            ns_dyn_mem_free(new_node);
+            return NULL;
+        }
+        branch->child[ipv6_route_trie_bit(node->prefix, common)] = node;
+        branch->child[ipv6_route_trie_bit(prefix, common)] = new_node;
+        *link = branch;
+        return new_node;
+    }
+}
+
+/* Remove a node that no longer has routes, if it isn't needed as a branch point */
+static void ipv6_route_trie_prune(ipv6_route_node_t *node)
+{
+    ipv6_route_node_t **link = &ipv6_route_trie;
+    ipv6_route_node_t **parent_link = NULL;
+
+    if (!ns_list_is_empty(&node->routes) || (node->child[0] && node->child[1])) {
+        return;
+    }
+
+    while (*link != node) {
+        parent_link = link;
+        link = &(*link)->child[ipv6_route_trie_bit(node->prefix, (*link)->prefix_len)];
+    }
+
+    *link = node->child[0] ? node->child[0] : node->child[1];
+    ns_dyn_mem_free(node);
+
+    /* Parent may now be a branch point with only one branch */
+    if (parent_link) {
+        ipv6_route_node_t *parent = *parent_link;
+        if (ns_list_is_empty(&parent->routes) && !(parent->child[0] && parent->child[1])) {
+            *parent_link = parent->child[0] ? parent->child[0] : parent->child[1];
+            ns_dyn_mem_free(parent);
+        }
+    }
+}
+
 static void ipv6_route_print(const ipv6_route_t *route, route_print_fn_t *print_fn)
 {
     // Route prefix is variable-length, so need to zero pad for ip6tos
@@ -1286,6 +1624,49 @@ void ipv6_route_table_print(route_print_fn_t *print_fn)
     }
 }
 
+#ifdef WISUN_NCP_ENABLE
+void ipv6_route_table_host_snapshot_start(void)
+{
+    ns_list_foreach(ipv6_route_t, route, &ipv6_routing_table) {
+        route->host_snapshot = route->info.source == ROUTE_RPL_DAO_SR;
+    }
+    ipv6_route_host_cursor = ns_list_get_first(&ipv6_routing_table);
+}
+
+uint16_t ipv6_route_table_get_host_routes(ipv6_route_host_info_t *routes, uint16_t max_routes)
+{
+    uint16_t count = 0;
+
+    for (ipv6_route_t *route = ipv6_route_host_cursor; route && count < max_routes; route = ns_list_get_next(&ipv6_routing_table, route)) {
+        if (!route->host_snapshot) {
+            continue;
+        }
+        ipv6_route_host_info_t *entry = &routes[count++];
+        memset(entry->prefix, 0, sizeof(entry->prefix));
+        bitcopy(entry->prefix, route->prefix, route->prefix_len);
+        memcpy(entry->next_hop, route->info.next_hop_addr, sizeof(entry->next_hop));
+        entry->lifetime = route->lifetime;
+        entry->prefix_len = route->prefix_len;
+    }
+
+    return count;
+}
+
+void ipv6_route_table_host_routes_sent(uint16_t count)
+{
+    ipv6_route_t *route = ipv6_route_host_cursor;
+
+    while (route && count) {
+        if (route->host_snapshot) {
+            route->host_snapshot = false;
+            count--;
+        }
+        route = ns_list_get_next(&ipv6_routing_table, route);
+    }
+    ipv6_route_host_cursor = route;
+}
+#endif //WISUN_NCP_ENABLE
+
 /*
  * This function returns total effective metric, which is a combination
  * of 1) route metric, and 2) interface metric. Can be extended to include
@@ -1336,10 +1717,31 @@ static void ipv6_route_entry_remove(ipv6_route_t *route)
         // Alert any buffers in the queue already routed by this source
         ipv6_route_source_invalidated[route->info.source] = true;
     }
+#ifdef WISUN_NCP_ENABLE
+    if (route == ipv6_route_host_cursor) {
+        ipv6_route_host_cursor = ns_list_get_next(&ipv6_routing_table, route);
+    }
+#endif
     ns_list_remove(&ipv6_routing_table, route);
+    ns_list_remove(&route->node->routes, route);
+    ipv6_route_trie_prune(route->node);
     ns_dyn_mem_free(route);
 }
 
+static void ipv6_route_move_to_end(ipv6_route_t *route)
+{
+#ifdef WISUN_NCP_ENABLE
+    /* Routes still to be sent must stay after the host snapshot cursor */
+    if (route == ipv6_route_host_cursor && ns_list_get_next(&ipv6_routing_table, route)) {
+        ipv6_route_host_cursor = ns_list_get_next(&ipv6_routing_table, route);
+    }
+#endif
+    ns_list_remove(&ipv6_routing_table, route);
+    ns_list_add_to_end(&ipv6_routing_table, route);
+    ns_list_remove(&route->node->routes, route);
+    ns_list_add_to_end(&route->node->routes, route);
+}
+
 static bool ipv6_route_same_router(const ipv6_route_t *a, const ipv6_route_t *b)
 {
     if (a == b) {
@@ -1403,44 +1805,50 @@ static bool ipv6_route_is_better(const ipv6_route_t *a, const ipv6_route_t *b)
 static ipv6_route_t *ipv6_route_find_best(const uint8_t *addr, int8_t interface_id, ipv6_route_predicate_fn_t *predicate)
 {
     ipv6_route_t *best = NULL;
-    ns_list_foreach(ipv6_route_t, route, &ipv6_routing_table) {
-        /* We mustn't be skipping this route */
-        if (route->search_skip) {
-            continue;
-        }
 
-        /* Interface must match, if caller specified */
-        if (interface_id != -1 && interface_id != route->info.interface_id) {
-            continue;
-        }
+    /* Visit matching prefixes shortest first - any valid route for a longer
+     * prefix beats all those for a shorter one, so best is only compared
+     * within a node.
+     */
+    for (ipv6_route_node_t *node = ipv6_route_trie_match_next(NULL, addr); node; node = ipv6_route_trie_match_next(node, addr)) {
+        ipv6_route_t *node_best = NULL;
+        ns_list_foreach(ipv6_route_t, route, &node->routes) {
+            /* We mustn't be skipping this route */
+            if (route->search_skip) {
+                continue;
+            }
 
-        /* Prefix must match */
-        if (!bitsequal(addr, route->prefix, route->prefix_len)) {
-            continue;
-        }
+            /* Interface must match, if caller specified */
+            if (interface_id != -1 && interface_id != route->info.interface_id) {
+                continue;
+            }
 
-        /* Check the predicate for the route itself. This allows,
-         * RPL "root" routes (the instance defaults) to be ignored in normal
-         * lookup. Note that for caching to work properly, we require
-         * the route predicate to produce "constant" results.
-         */
-        bool valid = true;
-        if (ipv6_route_predicate[route->info.source]) {
-            valid = ipv6_route_predicate[route->info.source](&route->info, valid);
-        }
+            /* Check the predicate for the route itself. This allows,
+             * RPL "root" routes (the instance defaults) to be ignored in normal
+             * lookup. Note that for caching to work properly, we require
+             * the route predicate to produce "constant" results.
+             */
+            bool valid = true;
+            if (ipv6_route_predicate[route->info.source]) {
+                valid = ipv6_route_predicate[route->info.source](&route->info, valid);
+            }
 
-        /* Then the supplied search-specific predicate can override */
-        if (predicate) {
-            valid = predicate(&route->info, valid);
-        }
+            /* Then the supplied search-specific predicate can override */
+            if (predicate) {
+                valid = predicate(&route->info, valid);
+            }
 
-        /* If blocked by either predicate, skip */
-        if (!valid) {
-            continue;
-        }
+            /* If blocked by either predicate, skip */
+            if (!valid) {
+                continue;
+            }
 
-        if (!best || ipv6_route_is_better(route, best)) {
-            best = route;
+            if (!node_best || ipv6_route_is_better(route, node_best)) {
+                node_best = route;
+            }
+        }
+        if (node_best) {
+            best = node_best;
         }
     }
     return best;
@@ -1452,8 +1860,11 @@ ipv6_route_t *ipv6_route_choose_next_hop(const uint8_t *dest, int8_t interface_i
     bool reachable = false;
     bool need_to_probe = false;
 
-    ns_list_foreach(ipv6_route_t, route, &ipv6_routing_table) {
-        route->search_skip = false;
+    /* Only routes matching dest are looked at by the search */
+    for (ipv6_route_node_t *node = ipv6_route_trie_match_next(NULL, dest); node; node = ipv6_route_trie_match_next(node, dest)) {
+        ns_list_foreach(ipv6_route_t, route, &node->routes) {
+            route->search_skip = false;
+        }
     }
 
     /* Search algorithm from RFC 4191, S3.2:
@@ -1539,15 +1950,17 @@ ipv6_route_t *ipv6_route_choose_next_hop(const uint8_t *dest, int8_t interface_i
      * but we don't want to probe the router we actually chose.
      */
     if (need_to_probe) {
-        ns_list_foreach(ipv6_route_t, r, &ipv6_routing_table) {
-            if (!r->probe) {
-                continue;
-            }
-            r->probe = false;
+        for (ipv6_route_node_t *node = ipv6_route_trie_match_next(NULL, dest); node; node = ipv6_route_trie_match_next(node, dest)) {
+            ns_list_foreach(ipv6_route_t, r, &node->routes) {
+                if (!r->probe) {
+                    continue;
+                }
+                r->probe = false;
 
-            /* Note that best must be set if need_to_probe is */
-            if (!ipv6_route_same_router(r, best) && ipv6_route_is_better(r, best)) {
-                ipv6_route_probe(r);
+                /* Note that best must be set if need_to_probe is */
+                if (!ipv6_route_same_router(r, best) && ipv6_route_is_better(r, best)) {
+                    ipv6_route_probe(r);
+                }
             }
         }
     }
@@ -1559,8 +1972,7 @@ ipv6_route_t *ipv6_route_choose_next_hop(const uint8_t *dest, int8_t interface_i
          * otherwise we'll never make progress. This satisfies the
          * round-robin requirement in RFC 4861 6.3.6.2, enhanced for RFC 4191.
          */
-        ns_list_remove(&ipv6_routing_table, best);
-        ns_list_add_to_end(&ipv6_routing_table, best);
+        ipv6_route_move_to_end(best);
     }
 
     return best;
@@ -1568,8 +1980,13 @@ ipv6_route_t *ipv6_route_choose_next_hop(const uint8_t *dest, int8_t interface_i
 
 ipv6_route_t *ipv6_route_lookup_with_info(const uint8_t *prefix, uint8_t prefix_len, int8_t interface_id, const uint8_t *next_hop, ipv6_route_src_t source, void *info, int_fast16_t src_id)
 {
-    ns_list_foreach(ipv6_route_t, r, &ipv6_routing_table) {
-        if (interface_id == r->info.interface_id && prefix_len == r->prefix_len && bitsequal(prefix, r->prefix, prefix_len)) {
+    ipv6_route_node_t *node = ipv6_route_trie_find(prefix, prefix_len);
+    if (!node) {
+        return NULL;
+    }
+
+    ns_list_foreach(ipv6_route_t, r, &node->routes) {
+        if (interface_id == r->info.interface_id) {
             if (source != ROUTE_ANY) {
                 if (source != r->info.source) {
                     continue;
@@ -1677,6 +2094,7 @@ ipv6_route_t *ipv6_route_add_metric(const uint8_t *prefix, uint8_t prefix_len, i
         route->prefix_len = prefix_len;
         route->search_skip = false;
         route->probe = false;
+        route->host_snapshot = false;
         route->probe_timer = 0;
         route->lifetime = lifetime;
         route->metric = metric;
@@ -1706,10 +2124,17 @@ ipv6_route_t *ipv6_route_add_metric(const uint8_t *prefix, uint8_t prefix_len, i
             }
         }
 
+        route->node = ipv6_route_trie_insert(route->prefix, prefix_len);
+        if (!route->node) {
+            ns_dyn_mem_free(route);
+            return NULL;
+        }
+
         /* Routing table will be resorted during use, thanks to probing. */
         /* Doesn't matter much where they start off, but put them at the */
         /* beginning so new routes tend to get tried first. */
         ns_list_add_to_start(&ipv6_routing_table, route);
+        ns_list_add_to_start(&route->node->routes, route);
         changed_info = NEW;
     } else { /* updating a route - only lifetime and metric can be changing */
         route->lifetime = lifetime;
@@ -108,6 +108,7 @@ typedef struct ipv6_neighbour {
     uint32_t                        timer;                      /* 100ms ticks */
     uint32_t                        lifetime;                   /* seconds */
     ns_list_link_t                  link;                       /*!< List link */
+    struct ipv6_neighbour           *hash_next;                 /*!< Address hash chain */
     NS_LIST_HEAD_INCOMPLETE(struct buffer) queue;
     uint8_t                         ll_address[];
 } ipv6_neighbour_t;
@@ -140,7 +141,9 @@ typedef struct ipv6_neighbour_cache {
     uint32_t                                reachable_time;
     // Interface specific information for route
     ipv6_route_interface_info_t             route_if_info;
-    //uint8_t                                   num_entries;
+    uint16_t                                num_entries;
+    uint16_t                                hash_size;  // buckets in hash_table, power of 2 (0 if none)
+    ipv6_neighbour_t                        **hash_table;
     NS_LIST_HEAD(ipv6_neighbour_t, link)    list;
 } ipv6_neighbour_cache_t;
 
@@ -214,6 +217,7 @@ typedef struct ipv6_destination {
     uint32_t                        fragment_id;
 #endif
     ipv6_neighbour_t                *last_neighbour;    // last neighbour used (only for reachability confirmation)
+    struct ipv6_destination         *hash_next;         // destination address hash chain
     ns_list_link_t                  link;
 } ipv6_destination_t;
 
@@ -241,11 +245,14 @@ typedef struct ipv6_route {
     bool                search_skip: 1;
     bool                probe: 1;
     bool                info_autofree: 1;
+    bool                host_snapshot: 1;   // still to be sent in the NCP host snapshot
     uint8_t             metric;             // 0x40 = RFC 4191 pref high, 0x80 = default, 0xC0 = RFC 4191 pref low
     ipv6_route_info_t   info;
     uint32_t            lifetime;           // (seconds); 0xFFFFFFFF means permanent
     uint16_t            probe_timer;
     ns_list_link_t      link;
+    ns_list_link_t      node_link;          // link in prefix trie node's route list
+    struct ipv6_route_node *node;           // prefix trie node holding this route
     uint8_t             prefix[];           // variable length
 } ipv6_route_t;
 
@@ -276,4 +283,26 @@ void ipv6_route_table_set_max_entries(int8_t interface_id, ipv6_route_src_t sour
 bool ipv6_route_table_source_was_invalidated(ipv6_route_src_t src);
 void ipv6_route_table_source_invalidated_reset(void);
 
+#ifdef WISUN_NCP_ENABLE
+/* RPL DAO source route as reported to the NCP host, prefix zero padded */
+typedef struct ipv6_route_host_info {
+    uint8_t             prefix[16];
+    uint8_t             next_hop[16];
+    uint32_t            lifetime;
+    uint8_t             prefix_len;
+} ipv6_route_host_info_t;
+
+/*
+ * Snapshot of the RPL DAO source routes for the NCP host, read a page at a
+ * time in table list order. Start marks the routes in the table, get copies
+ * up to max_routes of the marked routes from the stored position without
+ * consuming them, and sent moves past the first count of those, so a page
+ * that could not be sent is read again. Each route that stays in the table
+ * is returned once, routes added after the start are not.
+ */
+void ipv6_route_table_host_snapshot_start(void);
+uint16_t ipv6_route_table_get_host_routes(ipv6_route_host_info_t *routes, uint16_t max_routes);
+void ipv6_route_table_host_routes_sent(uint16_t count);
+#endif
+
 #endif /* IPV6_ROUTING_TABLE_H_ */
@@ -35,9 +35,14 @@
 #include "RPL/rpl_mrhof.h"
 #include "RPL/rpl_control.h"
 #include "RPL/rpl_data.h"
+#include "RPL/rpl_protocol.h"
+#include "RPL/rpl_upward.h"
+#include "RPL/rpl_downward.h"
+#include "RPL/rpl_structures.h"
 #endif
 #include "ccmLIB.h"
 #include "6LoWPAN/lowpan_adaptation_interface.h"
+#include "6LoWPAN/Fragmentation/cipv6_fragmenter.h"
 #include "6LoWPAN/Bootstraps/network_lib.h"
 #include "6LoWPAN/Bootstraps/protocol_6lowpan.h"
 #include "6LoWPAN/Bootstraps/protocol_6lowpan_bootstrap.h"
@@ -85,6 +90,25 @@
 
 
 #define TRACE_GROUP "lNet"
+
+/* Heap slab classes for the most common fixed size allocations, 0 disables a class */
+#ifndef NET_SLAB_BUFFER_COUNT
+#define NET_SLAB_BUFFER_COUNT 8
+#endif
+#ifndef NET_SLAB_NEIGHBOUR_COUNT
+#define NET_SLAB_NEIGHBOUR_COUNT 8
+#endif
+#ifndef NET_SLAB_ROUTE_COUNT
+#define NET_SLAB_ROUTE_COUNT 8
+#endif
+#ifndef NET_SLAB_DAO_TARGET_COUNT
+#ifdef HAVE_RPL_ROOT
+#define NET_SLAB_DAO_TARGET_COUNT 32
+#else
+#define NET_SLAB_DAO_TARGET_COUNT 0
+#endif
+#endif
+
 /**
  * \brief A function checks that the channel list is not empty. Channel pages 9 and 10 can have eight 32-bit channel masks.
  * \param scan_list is a pointer to the channel list structure given by the application.
@@ -1380,6 +1404,26 @@ int8_t arm_nwk_6lowpan_link_panid_filter_for_nwk_scan(int8_t interface_id, uint1
     return ret_val;
 }
 
+int8_t arm_nwk_6lowpan_fragment_forwarding_set(int8_t interface_id, uint8_t flow_limit)
+{
+    protocol_interface_info_entry_t *cur = protocol_stack_interface_info_get_by_id(interface_id);
+    if (!cur || cur->nwk_id != IF_6LoWPAN) {
+        return -1;
+    }
+
+    return reassembly_interface_forwarding_set(interface_id, flow_limit);
+}
+
+int8_t arm_nwk_6lowpan_fragment_recovery_set(int8_t interface_id, uint8_t retries, uint8_t window, uint16_t pacing_ms)
+{
+    protocol_interface_info_entry_t *cur = protocol_stack_interface_info_get_by_id(interface_id);
+    if (!cur || cur->nwk_id != IF_6LoWPAN) {
+        return -1;
+    }
+
+    return lowpan_adaptation_fragment_recovery_set(interface_id, retries, window, pacing_ms);
+}
+
 int8_t arm_nwk_6lowpan_link_nwk_id_filter_for_nwk_scan(int8_t interface_id, const uint8_t *nwk_id_filter)
 {
     int8_t ret_val = -1;
@@ -1449,6 +1493,25 @@ int8_t arm_nwk_6lowpan_beacon_compare_rx_callback_set(int8_t interface_id,
     return (mac_beacon_link_beacon_compare_rx_callback_set(interface_id, beacon_compare_rx_cb_ptr));
 }
 
+static void net_init_core_mem_slabs(void)
+{
+    // Default size buffer with minimum data area, see buffer_get()
+#if NET_SLAB_BUFFER_COUNT > 0
+    ns_dyn_mem_slab_add(sizeof(buffer_t) + ((BUFFER_DEFAULT_MIN_SIZE + 3) & ~3), NET_SLAB_BUFFER_COUNT);
+#endif
+    // Neighbour with 6LoWPAN link-layer address and registered EUI-64, see ipv6_neighbour_create()
+#if NET_SLAB_NEIGHBOUR_COUNT > 0
+    ns_dyn_mem_slab_add(sizeof(ipv6_neighbour_t) + 2 + 8 + 8, NET_SLAB_NEIGHBOUR_COUNT);
+#endif
+    // Route with full length prefix, shorter prefixes fit within the class waste limit
+#if NET_SLAB_ROUTE_COUNT > 0
+    ns_dyn_mem_slab_add(sizeof(ipv6_route_t) + 16, NET_SLAB_ROUTE_COUNT);
+#endif
+#if defined(HAVE_RPL) && NET_SLAB_DAO_TARGET_COUNT > 0
+    ns_dyn_mem_slab_add(sizeof(rpl_dao_target_t), NET_SLAB_DAO_TARGET_COUNT);
+#endif
+}
+
 /**
   * \brief A function to initialize core elements of NanoStack library.
   *
@@ -1458,6 +1521,7 @@ int8_t arm_nwk_6lowpan_beacon_compare_rx_callback_set(int8_t interface_id,
   */
 int8_t net_init_core(void)
 {
+    net_init_core_mem_slabs();
     /* Reset Protocol_stats */
     protocol_stats_init();
     protocol_core_init();
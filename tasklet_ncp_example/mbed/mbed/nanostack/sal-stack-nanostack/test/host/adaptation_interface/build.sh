@@ -0,0 +1,43 @@
+#!/bin/sh
+#
+# Builds and runs the host test of fragment recovery and pacing in the
+# adaptation layer, with the goodput table of recovery against failing the
+# whole datagram on a lossy link.
+#
+#   build.sh
+#
+# Set CC and OUT to change the compiler and the build directory.
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+STACK=$(cd "$HERE/../../.." && pwd)
+MBED=$(cd "$STACK/../.." && pwd)
+TI=$(cd "$MBED/../../ti_wisunfan/ti_wisunfan" && pwd)
+LIBSERVICE=$MBED/frameworks/nanostack-libservice
+OUT=${OUT:-${TMPDIR:-/tmp}/adaptation_interface_test}
+CC=${CC:-cc}
+
+INC="-I$HERE -I$STACK/source -I$STACK/nanostack -I$STACK/nanostack/platform
+     -I$LIBSERVICE/mbed-client-libservice -I$LIBSERVICE/mbed-client-libservice/platform
+     -I$MBED/frameworks/mbed-client-randlib/mbed-client-randlib
+     -I$MBED/nanostack/sal-stack-nanostack-eventloop/nanostack-event-loop
+     -I$TI/mbed_port/mbednanostack2tirtos/platform -I$TI/mbed_config/ws_border_router"
+SRC="$STACK/source/Core/buffer_dyn.c $LIBSERVICE/source/libList/ns_list.c
+     $LIBSERVICE/source/libBits/common_functions.c $LIBSERVICE/source/IPv6_fcf_lib/ip_fsc.c"
+
+mkdir -p "$OUT"
+
+# With the TI MAC, as the Wi-SUN build of the stack
+$CC -std=gnu99 -O1 -g -fsanitize=address,undefined -DFEATURE_TIMAC_SUPPORT $INC \
+    -o "$OUT/fragment_recovery_test" "$HERE/fragment_recovery_test.c" "$HERE/host_stubs.c" $SRC
+"$OUT/fragment_recovery_test" 20 2 3 100 5000
+"$OUT/fragment_recovery_test" 60 4 2 30 5000
+"$OUT/fragment_recovery_test" 5 1 4 20 5000
+
+# Goodput without recovery, and with 2 and 4 resends per datagram
+for loss in 40 50 60; do
+    for resends in 0 2 4; do
+        "$OUT/fragment_recovery_test" $loss $resends
+    done
+done
@@ -0,0 +1,419 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Randomised test of fragment recovery and pacing in the adaptation layer,
+ * and the goodput they give on a lossy link.
+ *
+ * Datagrams of 1280 bytes go out as direct unicast through a MAC that loses
+ * each frame with the given probability and gives up after 3 retries. A
+ * datagram that fails is sent again up to 3 more times, as CoAP would.
+ * Every frame the adaptation layer hands to the MAC is checked:
+ *  - a fragment the MAC gave up on is resent unchanged after the recovery
+ *    delay, at most the given number of times per datagram, after which the
+ *    datagram fails;
+ *  - after every window of fragments the next one waits for the pacing gap;
+ *  - nothing else is sent while a datagram is being fragmented, so small
+ *    packets sent meanwhile wait in the queue;
+ *  - the fragments that got through rebuild the datagram.
+ * Goodput is the delivered datagram bytes over the air time of every frame
+ * attempt, so it doesn't depend on the host.
+ *
+ * Usage: fragment_recovery_test [frame loss %] [resends] [window] [pacing ms] [datagrams]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* The tx entries and their recovery state are static in adaptation_interface.c */
+#include "../../../source/6LoWPAN/adaptation_interface.c"
+
+#include "host_stubs.h"
+
+#define TEST_INTERFACE_ID   1
+#define TEST_DATAGRAM_SIZE  1280    /* Uncompressed, behind a 40 byte IPv6 header */
+#define TEST_HEADER_SAVING  (40 - HOST_IPHC_SIZE)
+#define TEST_ATTEMPTS       4       /* Sends of a datagram by the upper layer */
+#define TEST_MAC_RETRIES    3
+#define TEST_FRAME_OVERHEAD 40      /* PHY and MAC bytes around the MAC payload */
+#define TEST_RATE_BPS       50000.0
+#define TEST_SMALL_MAX      6       /* Small packets sent during one datagram */
+#define TEST_MAC_QUEUE      8
+
+typedef struct {
+    uint8_t handle;
+    uint16_t length;
+    uint8_t msdu[256];
+} test_frame_t;
+
+static int test_round;
+static int test_resends;
+static int test_window;
+static int test_pacing_ms;
+
+static protocol_interface_info_entry_t test_interface;
+static arm_15_4_mac_parameters_t test_mac_parameters;
+static mac_api_t test_mac_api;
+static mpx_api_t test_mpx_api;
+static uint8_t test_ws_info;
+static mpx_data_confirm *test_mpx_confirm;
+
+static test_frame_t test_mac_queue[TEST_MAC_QUEUE];
+static int test_mac_queued;
+
+static uint8_t test_datagram[TEST_DATAGRAM_SIZE];
+static const uint16_t test_datagram_length = TEST_DATAGRAM_SIZE - TEST_HEADER_SAVING;
+static buffer_t *test_datagram_buf;
+static uint8_t test_datagram_handle;
+static int test_datagram_event;
+static uint8_t test_received[TEST_DATAGRAM_SIZE];
+static uint16_t test_received_length;
+static uint16_t test_tag;
+
+static test_frame_t test_failed_frame;
+static bool test_resend_due;
+static int test_resends_left;
+static int test_window_sent;
+static uint32_t test_timer_min;
+static uint32_t test_timer_max;
+
+static int test_small_sent;
+static int test_small_pending;
+
+static double test_airtime;
+static uint32_t test_fragment_resends;
+
+static void test_fail(const char *what, int round)
+{
+    printf("FAIL: %s in round %d\n", what, round);
+    exit(1);
+}
+
+static void test_mcps_data_req(const mac_api_t *api, const mcps_data_req_t *data)
+{
+    (void) api;
+    (void) data;
+    test_fail("MAC called around MPX", test_round);
+}
+
+static void test_mpx_data_request(const mpx_api_t *api, const struct mcps_data_req_s *data, uint16_t user_id, mac_data_priority_t priority)
+{
+    (void) api;
+    (void) user_id;
+    (void) priority;
+    if (test_mac_queued == TEST_MAC_QUEUE || data->msduLength > sizeof(test_mac_queue[0].msdu)) {
+        test_fail("MAC queue overflow", test_round);
+    }
+    test_frame_t *frame = &test_mac_queue[test_mac_queued++];
+    frame->handle = data->msduHandle;
+    frame->length = data->msduLength;
+    memcpy(frame->msdu, data->msdu, data->msduLength);
+}
+
+static uint8_t test_mpx_data_purge(const mpx_api_t *api, struct mcps_purge_s *purge, uint16_t user_id)
+{
+    (void) api;
+    (void) purge;
+    (void) user_id;
+    return 1;
+}
+
+static uint16_t test_mpx_headroom_size_get(const mpx_api_t *api, uint16_t user_id)
+{
+    (void) api;
+    (void) user_id;
+    return 0;
+}
+
+static int8_t test_mpx_user_registration(const mpx_api_t *api, mpx_data_confirm *confirm_cb, mpx_data_indication *indication_cb, uint16_t user_id)
+{
+    (void) api;
+    (void) indication_cb;
+    (void) user_id;
+    test_mpx_confirm = confirm_cb;
+    return 0;
+}
+
+static void test_mpx_priority_mode_set(const mpx_api_t *api, bool enable_mode)
+{
+    (void) api;
+    (void) enable_mode;
+}
+
+static void test_tx_event(buffer_t *buf, uint8_t status)
+{
+    if (buf == test_datagram_buf) {
+        test_datagram_buf = NULL;
+        test_datagram_event = status;
+    } else if (test_small_pending-- == 0) {
+        test_fail("unknown buffer freed", test_round);
+    }
+}
+
+static void test_interface_init(void)
+{
+    test_interface.id = TEST_INTERFACE_ID;
+    test_interface.mac_api = &test_mac_api;
+    test_interface.mac_parameters = &test_mac_parameters;
+    test_interface.ws_info = (struct ws_info_s *) &test_ws_info;
+    test_mac_api.mcps_data_req = test_mcps_data_req;
+    test_mac_api.phyMTU = 255;
+    test_mpx_api.mpx_data_request = test_mpx_data_request;
+    test_mpx_api.mpx_data_purge = test_mpx_data_purge;
+    test_mpx_api.mpx_headroom_size_get = test_mpx_headroom_size_get;
+    test_mpx_api.mpx_user_registration = test_mpx_user_registration;
+    test_mpx_api.mpx_priority_mode_set = test_mpx_priority_mode_set;
+    host_interface = &test_interface;
+    host_tx_event = test_tx_event;
+
+    if (lowpan_adaptation_interface_init(TEST_INTERFACE_ID, test_mac_api.phyMTU) ||
+            lowpan_adaptation_interface_mpx_register(TEST_INTERFACE_ID, &test_mpx_api, 0) ||
+            lowpan_adaptation_fragment_recovery_set(TEST_INTERFACE_ID, test_resends, test_window, test_pacing_ms)) {
+        test_fail("interface set-up failed", 0);
+    }
+}
+
+static buffer_t *test_buffer(const uint8_t *data, uint16_t length)
+{
+    buffer_t *buf = buffer_get(length);
+
+    buffer_data_add(buf, data, length);
+    buf->src_sa.addr_type = ADDR_802_15_4_SHORT;
+    common_write_16_bit(0xabcd, buf->src_sa.address);
+    common_write_16_bit(0x0001, buf->src_sa.address + 2);
+    buf->dst_sa.addr_type = ADDR_802_15_4_SHORT;
+    common_write_16_bit(0xabcd, buf->dst_sa.address);
+    common_write_16_bit(0x0002, buf->dst_sa.address + 2);
+    buf->link_specific.ieee802_15_4.requestAck = true;
+    buf->link_specific.ieee802_15_4.useDefaultPanId = true;
+    return buf;
+}
+
+static void test_small_send(void)
+{
+    static const uint8_t small[50] = {LOWPAN_DISPATCH_IPHC};
+    int queued = test_mac_queued;
+
+    test_small_sent++;
+    test_small_pending++;
+    lowpan_adaptation_interface_tx(&test_interface, test_buffer(small, sizeof(small)));
+    if (test_mac_queued != queued) {
+        test_fail("packet sent between fragments", test_round);
+    }
+}
+
+/* Offset of the fragment's payload in the compressed datagram */
+static uint16_t test_fragment_offset(const test_frame_t *frame)
+{
+    if ((frame->msdu[0] & LOWPAN_FRAG1_MASK) == LOWPAN_FRAG1) {
+        return 0;
+    }
+    return frame->msdu[4] * 8 - TEST_HEADER_SAVING;
+}
+
+static uint16_t test_fragment_header(const test_frame_t *frame)
+{
+    return (frame->msdu[0] & LOWPAN_FRAG1_MASK) == LOWPAN_FRAG1 ? 4 : 5;
+}
+
+/* Fragments go out in order, and a resend is the failed frame again */
+static void test_fragment_check(const test_frame_t *frame)
+{
+    if (test_resend_due) {
+        if (frame->length != test_failed_frame.length || frame->handle != test_failed_frame.handle ||
+                memcmp(frame->msdu, test_failed_frame.msdu, frame->length)) {
+            test_fail("resend differs from failed fragment", test_round);
+        }
+        test_resend_due = false;
+    }
+    if ((frame->msdu[0] & LOWPAN_FRAG1_MASK) != LOWPAN_FRAG1 && (frame->msdu[0] & LOWPAN_FRAGN_MASK) != LOWPAN_FRAGN) {
+        test_fail("datagram frame without FRAG header", test_round);
+    }
+    if ((common_read_16_bit(frame->msdu) & 0x07ff) != TEST_DATAGRAM_SIZE) {
+        test_fail("wrong datagram size in fragment", test_round);
+    }
+    if (test_received_length == 0) {
+        test_tag = common_read_16_bit(frame->msdu + 2);
+    } else if (common_read_16_bit(frame->msdu + 2) != test_tag) {
+        test_fail("tag changed within datagram", test_round);
+    }
+    if (test_fragment_offset(frame) != test_received_length) {
+        test_fail("fragment out of order", test_round);
+    }
+}
+
+static void test_fragment_receive(const test_frame_t *frame)
+{
+    uint16_t header = test_fragment_header(frame);
+
+    memcpy(test_received + test_received_length, frame->msdu + header, frame->length - header);
+    test_received_length += frame->length - header;
+}
+
+/* The MAC sends the frame, retrying a few times on loss */
+static uint8_t test_mac_send(const test_frame_t *frame, int loss)
+{
+    for (int i = 0; i <= TEST_MAC_RETRIES; i++) {
+        test_airtime += (frame->length + TEST_FRAME_OVERHEAD) * 8 / TEST_RATE_BPS;
+        if (rand() % 100 >= loss) {
+            return MLME_SUCCESS;
+        }
+    }
+    return rand() % 4 ? MLME_TX_NO_ACK : MLME_BUSY_CHAN;
+}
+
+static void test_timer_expect(uint32_t min, uint32_t max)
+{
+    if (!host_timer_callback || host_timer_ms < min || host_timer_ms > max) {
+        test_fail("timer not set as expected", test_round);
+    }
+    if (test_mac_queued) {
+        test_fail("held fragment sent to MAC", test_round);
+    }
+    test_timer_min = min;
+    test_timer_max = max;
+}
+
+/* What must follow the MAC confirmation of a fragment */
+static void test_fragment_confirmed(const test_frame_t *frame, uint8_t status)
+{
+    bool last = test_fragment_offset(frame) + frame->length - test_fragment_header(frame) == test_datagram_length;
+
+    if (status == MLME_SUCCESS && last) {
+        if (test_datagram_buf || test_datagram_event != SOCKET_TX_DONE) {
+            test_fail("datagram not done after last fragment", test_round);
+        }
+        if (test_received_length != test_datagram_length || memcmp(test_received, test_datagram, test_datagram_length)) {
+            test_fail("fragments don't rebuild the datagram", test_round);
+        }
+    } else if (status == MLME_SUCCESS) {
+        if (test_window && test_pacing_ms && ++test_window_sent == test_window) {
+            test_window_sent = 0;
+            test_timer_expect(test_pacing_ms, test_pacing_ms);
+        } else if (test_mac_queued != 1 || host_timer_callback) {
+            test_fail("next fragment not sent", test_round);
+        }
+    } else if (test_resends_left) {
+        uint32_t delay = test_pacing_ms > LOWPAN_FRAGMENT_RECOVERY_DELAY_MS ? test_pacing_ms : LOWPAN_FRAGMENT_RECOVERY_DELAY_MS;
+        test_timer_expect(delay, delay * 2);
+        test_resends_left--;
+        test_window_sent = 0;
+        test_failed_frame = *frame;
+        test_resend_due = true;
+        test_fragment_resends++;
+    } else if (test_datagram_buf || test_datagram_event != SOCKET_TX_FAIL || host_timer_callback) {
+        test_fail("datagram not failed after last resend", test_round);
+    }
+}
+
+/* Sends the datagram once, returns true if it got through */
+static bool test_datagram_send(int loss)
+{
+    test_datagram_buf = test_buffer(test_datagram, test_datagram_length);
+    test_datagram_event = -1;
+    test_received_length = 0;
+    test_resends_left = test_resends;
+    test_window_sent = 0;
+    lowpan_adaptation_interface_tx(&test_interface, test_datagram_buf);
+    if (!test_datagram_buf || test_mac_queued != 1) {
+        test_fail("first fragment not sent", test_round);
+    }
+    test_datagram_handle = test_datagram_buf->seq;
+
+    while (test_mac_queued || host_timer_callback) {
+        if (test_datagram_buf && test_small_sent < TEST_SMALL_MAX && rand() % 8 == 0) {
+            test_small_send();
+        }
+        if (test_mac_queued) {
+            test_frame_t frame = test_mac_queue[0];
+            memmove(test_mac_queue, test_mac_queue + 1, --test_mac_queued * sizeof(test_frame_t));
+            bool fragment = frame.handle == test_datagram_handle && test_datagram_buf;
+            if (fragment) {
+                test_fragment_check(&frame);
+            } else if (test_datagram_buf) {
+                test_fail("packet sent between fragments", test_round);
+            }
+            uint8_t status = test_mac_send(&frame, loss);
+            if (fragment && status == MLME_SUCCESS) {
+                test_fragment_receive(&frame);
+            }
+            mcps_data_conf_t confirm = {.msduHandle = frame.handle, .status = status};
+            test_mpx_confirm(&test_mpx_api, &confirm);
+            if (fragment) {
+                test_fragment_confirmed(&frame, status);
+            }
+        } else {
+            void (*callback)(void *) = host_timer_callback;
+            if (!test_timer_max) {
+                test_fail("unexpected timer", test_round);
+            }
+            test_timer_min = test_timer_max = 0;
+            host_timer_callback = NULL;
+            callback(host_timer_arg);
+            if (test_mac_queued != 1) {
+                test_fail("held fragment not sent on timer", test_round);
+            }
+        }
+    }
+
+    if (test_datagram_buf) {
+        test_fail("datagram stuck", test_round);
+    }
+    return test_datagram_event == SOCKET_TX_DONE;
+}
+
+int main(int argc, char *argv[])
+{
+    int loss = argc > 1 ? atoi(argv[1]) : 40;
+    test_resends = argc > 2 ? atoi(argv[2]) : 2;
+    test_window = argc > 3 ? atoi(argv[3]) : 0;
+    test_pacing_ms = argc > 4 ? atoi(argv[4]) : 0;
+    int datagrams = argc > 5 ? atoi(argv[5]) : 20000;
+    int delivered = 0;
+
+    srand(1);
+    test_interface_init();
+    test_datagram[0] = LOWPAN_DISPATCH_IPHC;
+    test_datagram[2] = TEST_HEADER_SAVING;
+    for (int i = HOST_IPHC_SIZE; i < test_datagram_length; i++) {
+        test_datagram[i] = rand();
+    }
+
+    for (test_round = 0; test_round < datagrams; test_round++) {
+        test_small_sent = 0;
+        for (int attempt = 0; attempt < TEST_ATTEMPTS; attempt++) {
+            if (test_datagram_send(loss)) {
+                delivered++;
+                break;
+            }
+        }
+        if (test_small_pending) {
+            test_fail("small packet not sent after datagram", test_round);
+        }
+    }
+
+    if (host_stats[STATS_FRAG_TX_ERROR] != test_fragment_resends) {
+        test_fail("resends not counted", test_round);
+    }
+    lowpan_adaptation_interface_free(TEST_INTERFACE_ID);
+
+    printf("OK: %d%% frame loss, %d resends, window %d, pacing %d ms: %d of %d datagrams delivered, "
+           "%u fragments resent, goodput %.1f kbit/s\n", loss, test_resends, test_window, test_pacing_ms,
+           delivered, datagrams, (unsigned) test_fragment_resends,
+           delivered * TEST_DATAGRAM_SIZE * 8 / test_airtime / 1000);
+    return 0;
+}
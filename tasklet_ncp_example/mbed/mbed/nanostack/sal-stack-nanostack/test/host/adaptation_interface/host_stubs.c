@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * The parts of the stack that adaptation_interface.c and buffer_dyn.c call
+ * out to, reduced to one Wi-SUN interface whose MAC sits behind MPX. There
+ * are no neighbours, no security and no congestion control. The heap is
+ * the host malloc so that the sanitizers see every buffer, filled with
+ * garbage as the stack's own heap would be.
+ */
+
+#include "nsconfig.h"
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ns_types.h"
+#include "nsdynmemLIB.h"
+#include "randLIB.h"
+#include "eventOS_event_timer.h"
+#include "Core/include/ns_address_internal.h"
+#include "Core/include/ns_buffer.h"
+#include "Core/include/ns_socket.h"
+#include "NWK_INTERFACE/Include/protocol.h"
+#include "NWK_INTERFACE/Include/protocol_stats.h"
+#include "6LoWPAN/IPHC_Decode/cipv6.h"
+#include "6LoWPAN/MAC/mac_helper.h"
+#include "Service_Libs/etx/etx.h"
+#include "Service_Libs/mac_neighbor_table/mac_neighbor_table.h"
+#include "Service_Libs/random_early_detection/random_early_detection_api.h"
+#include "RPL/rpl_data.h"
+#include "host_stubs.h"
+
+uint32_t host_stats[64];
+
+uint16_t host_frame_payload = 210;
+
+protocol_interface_info_entry_t *host_interface;
+
+void (*host_timer_callback)(void *);
+void *host_timer_arg;
+uint32_t host_timer_ms;
+
+void (*host_tx_event)(buffer_t *buf, uint8_t status);
+
+uint32_t protocol_core_monotonic_time;
+
+void *ns_dyn_mem_alloc(ns_mem_block_size_t alloc_size)
+{
+    void *block = malloc(alloc_size);
+    if (block) {
+        memset(block, 0xa5, alloc_size);
+    }
+    return block;
+}
+
+void *ns_dyn_mem_temporary_alloc(ns_mem_block_size_t alloc_size)
+{
+    return ns_dyn_mem_alloc(alloc_size);
+}
+
+void ns_dyn_mem_free(void *block)
+{
+    free(block);
+}
+
+void platform_enter_critical(void)
+{
+}
+
+void platform_exit_critical(void)
+{
+}
+
+void protocol_stats_update(nwk_stats_type_t type, uint16_t update_val)
+{
+    host_stats[type] += update_val;
+}
+
+void protocol_push(buffer_t *buf)
+{
+    buffer_free(buf);
+}
+
+protocol_interface_info_entry_t *protocol_stack_interface_info_get_by_id(int8_t nwk_id)
+{
+    if (host_interface && host_interface->id == nwk_id) {
+        return host_interface;
+    }
+    return NULL;
+}
+
+socket_t *socket_reference(socket_t *socket)
+{
+    return socket;
+}
+
+socket_t *socket_dereference(socket_t *socket)
+{
+    (void) socket;
+    return NULL;
+}
+
+void socket_tx_buffer_event_and_free(buffer_t *buf, uint8_t status)
+{
+    if (host_tx_event) {
+        host_tx_event(buf, status);
+    }
+    buffer_free(buf);
+}
+
+/* Only one timer is needed, as the adaptation layer keeps one per interface */
+timeout_t *eventOS_timeout_ms(void (*callback)(void *), uint32_t ms, void *arg)
+{
+    static uint8_t timeout;
+
+    if (host_timer_callback) {
+        return NULL;
+    }
+    host_timer_callback = callback;
+    host_timer_arg = arg;
+    host_timer_ms = ms;
+    return (timeout_t *) &timeout;
+}
+
+uint8_t randLIB_get_8bit(void)
+{
+    return rand();
+}
+
+uint16_t randLIB_get_16bit(void)
+{
+    return rand();
+}
+
+uint16_t randLIB_get_random_in_range(uint16_t min, uint16_t max)
+{
+    return min + rand() % (max - min + 1);
+}
+
+uint8_t addr_len_from_type(addrtype_t addr_type)
+{
+    switch (addr_type) {
+        case ADDR_802_15_4_SHORT:
+            return 2 + 2;
+        case ADDR_802_15_4_LONG:
+            return 2 + 8;
+        case ADDR_EUI_48:
+            return 6;
+        case ADDR_IPV6:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+uint8_t addr_check_broadcast(const address_t addr, addrtype_t addr_type)
+{
+    if (addr_type == ADDR_802_15_4_SHORT && addr[2] == 0xff && addr[3] == 0xff) {
+        return 0;
+    }
+    return 1;
+}
+
+bool addr_ipv6_equal(const uint8_t a[16], const uint8_t b[16])
+{
+    return memcmp(a, b, 16) == 0;
+}
+
+uint16_t iphc_header_scan(buffer_t *buf, uint16_t *uncompressed_size)
+{
+    *uncompressed_size = HOST_IPHC_SIZE + buffer_data_pointer(buf)[2];
+    return HOST_IPHC_SIZE;
+}
+
+uint_fast8_t mac_helper_frame_overhead(struct protocol_interface_info_entry *cur, const struct buffer *buf)
+{
+    (void) cur;
+    (void) buf;
+    return 0;
+}
+
+uint_fast16_t mac_helper_max_payload_size(struct protocol_interface_info_entry *cur, uint_fast16_t frame_overhead)
+{
+    (void) cur;
+    return host_frame_payload - frame_overhead;
+}
+
+int8_t mac_helper_mac_channel_set(struct protocol_interface_info_entry *interface, uint8_t new_channel)
+{
+    interface->mac_parameters->mac_channel = new_channel;
+    return 0;
+}
+
+uint16_t mac_helper_panid_get(const struct protocol_interface_info_entry *interface)
+{
+    (void) interface;
+    return 0xabcd;
+}
+
+uint8_t mac_helper_default_security_level_get(struct protocol_interface_info_entry *interface)
+{
+    (void) interface;
+    return 0;
+}
+
+uint8_t mac_helper_default_security_key_id_mode_get(struct protocol_interface_info_entry *interface)
+{
+    (void) interface;
+    return 0;
+}
+
+uint8_t mac_helper_default_key_index_get(struct protocol_interface_info_entry *interface)
+{
+    (void) interface;
+    return 0;
+}
+
+mac_neighbor_table_entry_t *mac_neighbor_table_address_discover(mac_neighbor_table_t *table_class, const uint8_t *address, uint8_t address_type)
+{
+    (void) table_class;
+    (void) address;
+    (void) address_type;
+    return NULL;
+}
+
+void etx_transm_attempts_update(int8_t interface_id, uint8_t attempts, bool success, uint8_t attribute_index, const uint8_t *mac64_addr_ptr)
+{
+    (void) interface_id;
+    (void) attempts;
+    (void) success;
+    (void) attribute_index;
+    (void) mac64_addr_ptr;
+}
+
+etx_storage_t *etx_storage_entry_get(int8_t interface_id, uint8_t attribute_index)
+{
+    (void) interface_id;
+    (void) attribute_index;
+    return NULL;
+}
+
+bool random_early_detection_congestion_check(struct red_info_s *red_info)
+{
+    (void) red_info;
+    return false;
+}
+
+uint16_t random_early_detetction_aq_calc(struct red_info_s *red_info, uint16_t sampleLen)
+{
+    (void) red_info;
+    return sampleLen;
+}
+
+bool rpl_data_is_rpl_parent_route(ipv6_route_src_t source)
+{
+    (void) source;
+    return false;
+}
+
+char *trace_sockaddr(const sockaddr_t *addr, bool panid_prefix)
+{
+    (void) addr;
+    (void) panid_prefix;
+    return "";
+}
+
+void ns_trace_printf(uint8_t dlevel, const char *grp, const char *fmt, ...)
+{
+    (void) dlevel;
+    (void) grp;
+    (void) fmt;
+}
+
+char *ns_trace_array(const uint8_t *buf, uint16_t len)
+{
+    (void) buf;
+    (void) len;
+    return "";
+}
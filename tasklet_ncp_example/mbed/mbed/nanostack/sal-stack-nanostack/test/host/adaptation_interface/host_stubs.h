@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOST_STUBS_H_
+#define HOST_STUBS_H_
+
+/* There is no header compression on the host. A datagram's 6LoWPAN form
+ * starts with a 3 byte stand-in for an IPHC header:
+ *
+ *   [0] LOWPAN_DISPATCH_IPHC
+ *   [1] unused
+ *   [2] bytes the IPv6 header is longer than this one, ie the "pattern"
+ */
+#define HOST_IPHC_SIZE      3
+
+/* Indexed by nwk_stats_type_t */
+extern uint32_t host_stats[64];
+
+/* MAC payload left for 6LoWPAN in every frame */
+extern uint16_t host_frame_payload;
+
+/* The interface protocol_stack_interface_info_get_by_id() finds */
+extern protocol_interface_info_entry_t *host_interface;
+
+/* The single event timer, set by eventOS_timeout_ms() until it is run */
+extern void (*host_timer_callback)(void *);
+extern void *host_timer_arg;
+extern uint32_t host_timer_ms;
+
+/* Called with every buffer the adaptation layer hands back to the socket */
+extern void (*host_tx_event)(buffer_t *buf, uint8_t status);
+
+#endif /* HOST_STUBS_H_ */
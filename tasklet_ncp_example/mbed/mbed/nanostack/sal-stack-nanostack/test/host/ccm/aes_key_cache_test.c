@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Randomised test of the expanded key cache of the mbed TLS AES adapter.
+ *
+ * Contexts are started, used, finished, and keys pinned and evicted, with
+ * never more than ARM_AES_MBEDTLS_CONTEXT_MIN contexts started at once. Each
+ * encryption must match a separately expanded key. Starting a context must
+ * always succeed, pinning must succeed until ARM_AES_KEY_CACHE_SIZE keys are
+ * pinned, and a pinned key must be served from the cache. Flushing the cache
+ * must free every entry without a started context. After every step
+ * the idle entries must fit in the cache, the use counts must match the
+ * started contexts, and no entry may keep a copy of an evicted key.
+ *
+ * Build with -DARM_AES_KEY_CACHE_SIZE=n to test other cache sizes, 0 being
+ * the behaviour without a cache.
+ *
+ * Usage: aes_key_cache_test [rounds]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* The context table is static in aes_mbedtls_adapter.c */
+#include "../../../source/Service_Libs/CCM_lib/mbedOS/aes_mbedtls_adapter.c"
+
+#define TEST_KEYS 12
+
+typedef struct test_started {
+    arm_aes_context_t *context;
+    int key;
+} test_started_t;
+
+static uint8_t test_key[TEST_KEYS][16];
+static uint8_t test_ciphertext[TEST_KEYS][2][16];
+static bool test_pinned[TEST_KEYS];
+static test_started_t test_started[ARM_AES_MBEDTLS_CONTEXT_MIN];
+static int test_started_count;
+
+static const uint8_t test_plaintext[2][16] = {
+    {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff},
+    {0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a},
+};
+
+static void test_fail(const char *what, int round)
+{
+    printf("FAIL: %s in round %d\n", what, round);
+    exit(1);
+}
+
+/* Random keys, encrypted with a key expansion of their own */
+static void test_keys_init(void)
+{
+    for (int key = 0; key < TEST_KEYS; key++) {
+        mbedtls_aes_context ctx;
+        for (int i = 0; i < 16; i++) {
+            test_key[key][i] = rand();
+        }
+        mbedtls_aes_init(&ctx);
+        mbedtls_aes_setkey_enc(&ctx, test_key[key], 128);
+        for (int block = 0; block < 2; block++) {
+            mbedtls_aes_crypt_ecb(&ctx, MBEDTLS_AES_ENCRYPT, test_plaintext[block], test_ciphertext[key][block]);
+        }
+        mbedtls_aes_free(&ctx);
+    }
+}
+
+static int test_pinned_count(void)
+{
+    int count = 0;
+    for (int key = 0; key < TEST_KEYS; key++) {
+        count += test_pinned[key];
+    }
+    return count;
+}
+
+static void test_check_table(int round)
+{
+    int pinned = 0;
+
+    if (aes_context_idle_count() > ARM_AES_KEY_CACHE_SIZE) {
+        test_fail("more idle keys than the cache holds", round);
+    }
+    for (int i = 0; i < ARM_AES_CONTEXT_COUNT; i++) {
+        arm_aes_context_t *entry = &context_list[i];
+        int users = 0;
+        for (int started = 0; started < test_started_count; started++) {
+            users += test_started[started].context == entry;
+        }
+        if (entry->users != users) {
+            test_fail("use count does not match the started contexts", round);
+        }
+        if (!entry->initialized && (entry->key_valid || entry->pinned || entry->users)) {
+            test_fail("free entry in use", round);
+        }
+        if (entry->pinned) {
+            if (!entry->key_valid) {
+                test_fail("pinned entry has no key", round);
+            }
+            pinned++;
+        }
+        for (int key = 0; key < TEST_KEYS; key++) {
+            if (memcmp(entry->key, test_key[key], 16) == 0) {
+                if (!entry->key_valid) {
+                    test_fail("key copy left in an entry without a valid key", round);
+                }
+                if (entry->pinned != test_pinned[key]) {
+                    test_fail("pin does not match", round);
+                }
+            }
+        }
+        for (int other = 0; other < i; other++) {
+            if (entry->key_valid && context_list[other].key_valid && memcmp(entry->key, context_list[other].key, 16) == 0) {
+                test_fail("key cached twice", round);
+            }
+        }
+    }
+    if (pinned != test_pinned_count()) {
+        test_fail("pinned entries do not match the pinned keys", round);
+    }
+}
+
+static void test_round(int round)
+{
+    int key = rand() % TEST_KEYS;
+    uint8_t block[32];
+
+    switch (rand() % 9) {
+        case 0:
+        case 1:
+            if (test_started_count == ARM_AES_MBEDTLS_CONTEXT_MIN) {
+                break;
+            }
+            arm_aes_context_t *context = arm_aes_start(test_key[key]);
+            if (!context) {
+                test_fail("start failed", round);
+            }
+            if (test_pinned[key] && !context->pinned) {
+                test_fail("pinned key not served from the cache", round);
+            }
+            test_started[test_started_count].context = context;
+            test_started[test_started_count].key = key;
+            test_started_count++;
+            break;
+        case 2:
+        case 3:
+            if (test_started_count) {
+                test_started_t *started = &test_started[rand() % test_started_count];
+                if (rand() % 2) {
+                    arm_aes_encrypt(started->context, test_plaintext[0], block);
+                    if (memcmp(block, test_ciphertext[started->key][0], 16)) {
+                        test_fail("encryption differs", round);
+                    }
+                } else {
+                    arm_aes_encrypt_blocks(started->context, test_plaintext[0], block, 2);
+                    if (memcmp(block, test_ciphertext[started->key], 32)) {
+                        test_fail("encryption of two blocks differs", round);
+                    }
+                }
+            }
+            break;
+        case 4:
+            if (test_started_count) {
+                int started = rand() % test_started_count;
+                arm_aes_finish(test_started[started].context);
+                test_started[started] = test_started[--test_started_count];
+            }
+            break;
+        case 5:
+        case 6: {
+            bool expected = test_pinned[key] || test_pinned_count() < ARM_AES_KEY_CACHE_SIZE;
+            if ((arm_aes_key_pin(test_key[key]) == 0) != expected) {
+                test_fail(expected ? "pin failed" : "pinned more keys than the cache holds", round);
+            }
+            test_pinned[key] = expected;
+            break;
+        }
+        case 7:
+            arm_aes_key_cache_flush();
+            // keys cached in started contexts keep their pins
+            for (key = 0; key < TEST_KEYS; key++) {
+                bool started_key = false;
+                for (int started = 0; started < test_started_count; started++) {
+                    started_key |= test_started[started].key == key && test_started[started].context->key_valid;
+                }
+                test_pinned[key] &= started_key;
+            }
+            if (aes_context_idle_count()) {
+                test_fail("idle entry left after flush", round);
+            }
+            break;
+        default:
+            arm_aes_key_evict(test_key[key]);
+            test_pinned[key] = false;
+            // contexts already started with the key stay usable
+            for (int started = 0; started < test_started_count; started++) {
+                if (test_started[started].key == key) {
+                    arm_aes_encrypt(test_started[started].context, test_plaintext[1], block);
+                    if (memcmp(block, test_ciphertext[key][1], 16)) {
+                        test_fail("encryption differs after evict", round);
+                    }
+                }
+            }
+            break;
+    }
+
+    test_check_table(round);
+}
+
+int main(int argc, char *argv[])
+{
+    int rounds = argc > 1 ? atoi(argv[1]) : 500000;
+
+    srand(1);
+    test_keys_init();
+    for (int round = 0; round < rounds; round++) {
+        test_round(round);
+    }
+
+    while (test_started_count) {
+        arm_aes_finish(test_started[--test_started_count].context);
+    }
+    for (int key = 0; key < TEST_KEYS; key++) {
+        arm_aes_key_evict(test_key[key]);
+        test_pinned[key] = false;
+    }
+    test_check_table(rounds);
+
+    printf("OK: %d rounds, cache size %d, %d contexts\n", rounds, ARM_AES_KEY_CACHE_SIZE, ARM_AES_CONTEXT_COUNT);
+    return 0;
+}
@@ -0,0 +1,73 @@
+#!/bin/sh
+#
+# Builds and runs the host tests and benchmark of the CCM library and the
+# expanded key cache of the mbed TLS AES adapter.
+#
+#   build.sh [git revision]
+#
+# With a git revision, the benchmark is also built against the stack of that
+# revision, e.g. the key expansion per frame before the key cache, or the two
+# pass CCM before the batched one. The AES is the software AES the adapter
+# bundles. Set CC and OUT to change the compiler and the build directory.
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+STACK=$(cd "$HERE/../../.." && pwd)
+MBED=$(cd "$STACK/../.." && pwd)
+TI=$(cd "$MBED/../../ti_wisunfan/ti_wisunfan" && pwd)
+OUT=${OUT:-${TMPDIR:-/tmp}/ccm_test}
+CC=${CC:-cc}
+
+# Sources and include paths of a stack tree
+tree_flags()
+{
+    LIBSERVICE=$MBED/frameworks/nanostack-libservice
+    INC="-I$HERE -I$1/source -I$1/nanostack -I$1/nanostack/platform
+         -I$LIBSERVICE/mbed-client-libservice -I$LIBSERVICE/mbed-client-libservice/platform
+         -I$TI/mbed_port/mbednanostack2tirtos/platform -I$TI/mbed_config/ws_border_router"
+    SRC="$1/source/Service_Libs/CCM_lib/ccm_security.c $1/source/Service_Libs/CCM_lib/mbedOS/aes_mbedtls_adapter.c"
+}
+
+# Builds the benchmark against a stack tree and runs it
+run_benches()
+{
+    $CC -std=gnu99 -O2 $INC -o "$OUT/ccm_bench$1" "$HERE/ccm_bench.c" "$HERE/host_stubs.c" $SRC
+    for length in 16 96; do
+        "$OUT/ccm_bench$1" $length 5
+    done
+    "$OUT/ccm_bench$1" 1280 6 20000
+}
+
+mkdir -p "$OUT"
+tree_flags "$STACK"
+
+for size in 0 1 4; do
+    $CC -std=gnu99 -O1 -g -fsanitize=address,undefined -DARM_AES_KEY_CACHE_SIZE=$size $INC \
+        -o "$OUT/aes_key_cache_test_$size" "$HERE/aes_key_cache_test.c" "$HERE/host_stubs.c"
+    "$OUT/aes_key_cache_test_$size"
+done
+
+for blocks in 1 4 7 20; do
+    $CC -std=gnu99 -O1 -g -fsanitize=address,undefined -DCCM_KEYSTREAM_BLOCKS=$blocks $INC \
+        -o "$OUT/ccm_test_$blocks" "$HERE/ccm_test.c" "$HERE/host_stubs.c" $SRC
+done
+"$OUT/ccm_test_4"
+"$OUT/ccm_test_1" 20000
+"$OUT/ccm_test_7" 20000
+"$OUT/ccm_test_20" 20000
+
+echo "this tree:"
+run_benches
+
+if [ -n "$1" ]; then
+    TOP=$(git -C "$HERE" rev-parse --show-toplevel)
+    BASE=$OUT/$1
+    rm -rf "$BASE"
+    mkdir -p "$BASE"
+    git -C "$TOP" archive "$1" "$(git -C "$STACK" rev-parse --show-prefix)" | tar -x -C "$BASE"
+    BASE_STACK=$BASE/$(git -C "$STACK" rev-parse --show-prefix)
+    tree_flags "$BASE_STACK"
+    echo "$1:"
+    run_benches "_$1"
+fi
@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Test of the CCM library against published vectors and a reference CCM.
+ *
+ * NIST SP 800-38C example 3 and RFC 3610 packets 1 and 2 are encrypted,
+ * decrypted, and rejected with a corrupted MIC. NIST examples 1, 2 and 4 use
+ * nonce lengths or adata sizes that ccm_sec_init() does not accept.
+ *
+ * Random cases then run ccm_process_run() and a block at a time reference
+ * CCM on copies of the same memory, over all security levels, both L values,
+ * both modes, adata only MICs and payloads up to 5000 bytes, past the 16-bit
+ * counter carry. The return codes and the whole memory must be equal, and
+ * each encrypted frame must decrypt back unless its MIC is corrupted.
+ *
+ * Build with -DCCM_KEYSTREAM_BLOCKS=n to test other burst sizes.
+ *
+ * Usage: ccm_test [cases]
+ */
+
+#include "nsconfig.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ns_types.h"
+#include "ccmLIB.h"
+#include "platform/arm_hal_aes.h"
+
+#define TEST_MEMORY 6000
+#define TEST_MIC_OFFSET (TEST_MEMORY - 16)
+
+static void test_fail(const char *what, int round)
+{
+    printf("FAIL: %s in round %d\n", what, round);
+    exit(1);
+}
+
+static int test_hex(const char *hex, uint8_t *out)
+{
+    int len = 0;
+    while (hex[0] && hex[1]) {
+        sscanf(hex, "%2hhx", &out[len++]);
+        hex += 2;
+    }
+    return len;
+}
+
+static int test_mic_len(uint8_t sec_level)
+{
+    static const uint8_t mic_len[4] = {0, 4, 8, 16};
+    return mic_len[sec_level & 3];
+}
+
+/* X := E(Key, X ^ B), B zero padded to a block */
+static void test_ref_mac(arm_aes_context_t *aes, uint8_t X[16], const uint8_t *B, int len)
+{
+    for (int i = 0; i < len; i++) {
+        X[i] ^= B[i];
+    }
+    arm_aes_encrypt(aes, X, X);
+}
+
+/*
+ * CCM as RFC 3610 describes it, one block per AES call, with the conventions
+ * of ccmLIB.h: levels below AES_SECURITY_LEVEL_ENC authenticate the payload
+ * as part of the adata, which it must follow, while B0 still carries the
+ * payload length.
+ */
+static int8_t test_ref_ccm(uint8_t sec_level, const uint8_t *key, uint8_t mode, uint8_t l, const uint8_t *nonce,
+                           const uint8_t *adata, uint16_t adata_len, uint8_t *data, uint16_t data_len, uint8_t *mic)
+{
+    int mic_len = test_mic_len(sec_level);
+    bool encrypt = sec_level >= AES_SECURITY_LEVEL_ENC;
+    uint16_t message_len = encrypt ? data_len : 0;
+    uint8_t X[16], A[16], S[16], S0[16];
+
+    if (mic_len && adata_len == 0) {
+        return -1;
+    }
+    if (mic_len && !encrypt && data_len) {
+        if (data != adata + adata_len) {
+            return -1;
+        }
+        adata_len += data_len;
+    }
+    if (!mic_len && !encrypt) {
+        return 0;
+    }
+
+    arm_aes_context_t *aes = arm_aes_start(key);
+    if (!aes) {
+        return -3;
+    }
+
+    A[0] = l - 1;
+    memcpy(A + 1, nonce, 15 - l);
+    memset(A + 16 - l, 0, l);
+    arm_aes_encrypt(aes, A, S0);
+
+    if (encrypt && mode == AES_CCM_DECRYPT) {
+        for (int block = 0; block * 16 < message_len; block++) {
+            A[15] = block + 1;
+            A[14] = (block + 1) >> 8;
+            arm_aes_encrypt(aes, A, S);
+            for (int i = 0; i < 16 && block * 16 + i < message_len; i++) {
+                data[block * 16 + i] ^= S[i];
+            }
+        }
+    }
+
+    if (mic_len) {
+        uint8_t B[16];
+        B[0] = 0x40 | ((mic_len - 2) / 2) << 3 | (l - 1);
+        memcpy(B + 1, nonce, 15 - l);
+        memset(B + 16 - l, 0, l);
+        B[14] = data_len >> 8;
+        B[15] = data_len;
+        memset(X, 0, 16);
+        test_ref_mac(aes, X, B, 16);
+
+        // adata with its length in front, then the message, each padded
+        uint8_t *a = malloc(2 + adata_len);
+        a[0] = adata_len >> 8;
+        a[1] = adata_len;
+        memcpy(a + 2, adata, adata_len);
+        for (int offset = 0; offset < 2 + adata_len; offset += 16) {
+            test_ref_mac(aes, X, a + offset, 2 + adata_len - offset < 16 ? 2 + adata_len - offset : 16);
+        }
+        free(a);
+        for (int offset = 0; offset < message_len; offset += 16) {
+            test_ref_mac(aes, X, data + offset, message_len - offset < 16 ? message_len - offset : 16);
+        }
+    }
+
+    if (encrypt && mode == AES_CCM_ENCRYPT) {
+        for (int block = 0; block * 16 < message_len; block++) {
+            A[15] = block + 1;
+            A[14] = (block + 1) >> 8;
+            arm_aes_encrypt(aes, A, S);
+            for (int i = 0; i < 16 && block * 16 + i < message_len; i++) {
+                data[block * 16 + i] ^= S[i];
+            }
+        }
+    }
+    arm_aes_finish(aes);
+
+    for (int i = 0; i < mic_len; i++) {
+        if (mode == AES_CCM_ENCRYPT) {
+            mic[i] = X[i] ^ S0[i];
+        } else if (mic[i] != (X[i] ^ S0[i])) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int8_t test_ccm(uint8_t sec_level, const uint8_t *key, uint8_t mode, uint8_t l, const uint8_t *nonce,
+                       const uint8_t *adata, uint16_t adata_len, uint8_t *data, uint16_t data_len, uint8_t *mic)
+{
+    ccm_globals_t ccm;
+
+    if (!ccm_sec_init(&ccm, sec_level, key, mode, l)) {
+        return -3;
+    }
+    memcpy(ccm.exp_nonce, nonce, 15 - l);
+    ccm.adata_ptr = adata;
+    ccm.adata_len = adata_len;
+    ccm.data_ptr = data;
+    ccm.data_len = data_len;
+    ccm.mic = mic;
+    return ccm_process_run(&ccm);
+}
+
+static void test_vector(const char *name, uint8_t sec_level, uint8_t l, const char *key_hex, const char *nonce_hex,
+                        const char *adata_hex, const char *plaintext_hex, const char *ciphertext_hex)
+{
+    uint8_t key[16], nonce[15], adata[64], plaintext[64], ciphertext[80], data[64], mic[16];
+    test_hex(key_hex, key);
+    test_hex(nonce_hex, nonce);
+    int adata_len = test_hex(adata_hex, adata);
+    int data_len = test_hex(plaintext_hex, plaintext);
+    int mic_len = test_hex(ciphertext_hex, ciphertext) - data_len;
+
+    memcpy(data, plaintext, data_len);
+    if (test_ccm(sec_level, key, AES_CCM_ENCRYPT, l, nonce, adata, adata_len, data, data_len, mic) != 0 ||
+            memcmp(data, ciphertext, data_len) || memcmp(mic, ciphertext + data_len, mic_len)) {
+        printf("FAIL: %s encryption\n", name);
+        exit(1);
+    }
+    if (test_ccm(sec_level, key, AES_CCM_DECRYPT, l, nonce, adata, adata_len, data, data_len, mic) != 0 ||
+            memcmp(data, plaintext, data_len)) {
+        printf("FAIL: %s decryption\n", name);
+        exit(1);
+    }
+    memcpy(data, ciphertext, data_len);
+    mic[mic_len - 1] ^= 1;
+    if (test_ccm(sec_level, key, AES_CCM_DECRYPT, l, nonce, adata, adata_len, data, data_len, mic) != -1) {
+        printf("FAIL: %s corrupted MIC accepted\n", name);
+        exit(1);
+    }
+}
+
+static void test_vectors(void)
+{
+    test_vector("SP 800-38C example 3", AES_SECURITY_LEVEL_ENC_MIC64, 3,
+                "404142434445464748494a4b4c4d4e4f", "101112131415161718191a1b",
+                "000102030405060708090a0b0c0d0e0f10111213",
+                "202122232425262728292a2b2c2d2e2f3031323334353637",
+                "e3b201a9f5b71a7a9b1ceaeccd97e70b6176aad9a4428aa5484392fbc1b09951");
+    test_vector("RFC 3610 packet 1", AES_SECURITY_LEVEL_ENC_MIC64, 2,
+                "c0c1c2c3c4c5c6c7c8c9cacbcccdcecf", "00000003020100a0a1a2a3a4a5", "0001020304050607",
+                "08090a0b0c0d0e0f101112131415161718191a1b1c1d1e",
+                "588c979a61c663d2f066d0c2c0f989806d5f6b61dac38417e8d12cfdf926e0");
+    test_vector("RFC 3610 packet 2", AES_SECURITY_LEVEL_ENC_MIC64, 2,
+                "c0c1c2c3c4c5c6c7c8c9cacbcccdcecf", "00000004030201a0a1a2a3a4a5", "0001020304050607",
+                "08090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f",
+                "72c91a36e135f8cf291ca894085c87e3cc15c439c9e43a3ba091d56e10400916");
+}
+
+static void test_case(int round)
+{
+    static uint8_t memory[2][TEST_MEMORY];
+    static uint8_t original[TEST_MEMORY];
+    uint8_t key[16], nonce[15];
+    uint8_t sec_level = rand() % 8;
+    uint8_t l = 2 + rand() % 2;
+    uint8_t mode = rand() % 2;
+    uint16_t adata_len = rand() % (round % 7 ? 60 : 300);
+    uint16_t data_len = rand() % (round % 50 ? round % 10 ? 200 : 1150 : 5000);
+    bool follows_adata = rand() % 3 == 0;
+    int data_offset = follows_adata ? adata_len : 400 + rand() % 4;
+
+    for (int i = 0; i < 16; i++) {
+        key[i] = rand();
+    }
+    for (int i = 0; i < 15; i++) {
+        nonce[i] = rand();
+    }
+    for (int i = 0; i < TEST_MEMORY; i++) {
+        original[i] = rand();
+    }
+    memcpy(memory[0], original, TEST_MEMORY);
+    memcpy(memory[1], original, TEST_MEMORY);
+
+    int8_t ret = test_ccm(sec_level, key, mode, l, nonce, memory[0], adata_len,
+                          memory[0] + data_offset, data_len, memory[0] + TEST_MIC_OFFSET);
+    int8_t ref_ret = test_ref_ccm(sec_level, key, mode, l, nonce, memory[1], adata_len,
+                                  memory[1] + data_offset, data_len, memory[1] + TEST_MIC_OFFSET);
+    if (ret != ref_ret) {
+        test_fail("return code differs from the reference", round);
+    }
+    if (memcmp(memory[0], memory[1], TEST_MEMORY)) {
+        test_fail("output differs from the reference", round);
+    }
+    if (ret != 0 || mode != AES_CCM_ENCRYPT) {
+        return;
+    }
+
+    // decrypt what was encrypted, then with a corrupted MIC
+    int mic_len = test_mic_len(sec_level);
+    memcpy(memory[1], memory[0], TEST_MEMORY);
+    if (test_ccm(sec_level, key, AES_CCM_DECRYPT, l, nonce, memory[0], adata_len,
+                 memory[0] + data_offset, data_len, memory[0] + TEST_MIC_OFFSET) != 0 ||
+            memcmp(memory[0], original, TEST_MIC_OFFSET)) {
+        test_fail("decryption of an encrypted frame failed", round);
+    }
+    if (mic_len) {
+        memory[1][TEST_MIC_OFFSET + rand() % mic_len] ^= 1 << rand() % 8;
+        if (test_ccm(sec_level, key, AES_CCM_DECRYPT, l, nonce, memory[1], adata_len,
+                     memory[1] + data_offset, data_len, memory[1] + TEST_MIC_OFFSET) != -1) {
+            test_fail("corrupted MIC accepted", round);
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int cases = argc > 1 ? atoi(argv[1]) : 100000;
+
+    test_vectors();
+    srand(1);
+    for (int round = 0; round < cases; round++) {
+        test_case(round);
+    }
+
+    printf("OK: 3 vectors, %d random cases\n", cases);
+    return 0;
+}
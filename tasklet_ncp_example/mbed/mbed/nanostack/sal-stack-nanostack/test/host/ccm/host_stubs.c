@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * The platform calls the CCM library and the mbed TLS AES adapter make. The
+ * host tests are single threaded, so critical sections do nothing.
+ */
+
+#include "nsconfig.h"
+#include "ns_types.h"
+#include "platform/arm_hal_interrupt.h"
+
+void platform_enter_critical(void)
+{
+}
+
+void platform_exit_critical(void)
+{
+}
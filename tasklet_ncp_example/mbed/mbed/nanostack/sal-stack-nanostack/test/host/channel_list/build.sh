@@ -0,0 +1,65 @@
+#!/bin/sh
+#
+# Builds and runs the host test and benchmark of the channel list helpers and
+# the Wi-SUN neighbour channel exclusions built on them.
+#
+#   build.sh [git revision]
+#
+# With a git revision, the benchmark is also built against the stack and
+# libservice of that revision, e.g. the bit loops before the word at a time
+# helpers. Set CC and OUT to change the compiler and the build directory.
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+STACK=$(cd "$HERE/../../.." && pwd)
+MBED=$(cd "$STACK/../.." && pwd)
+TI=$(cd "$MBED/../../ti_wisunfan/ti_wisunfan" && pwd)
+OUT=${OUT:-${TMPDIR:-/tmp}/channel_list_test}
+CC=${CC:-cc}
+
+# Sources and include paths of a stack and libservice tree
+tree_flags()
+{
+    LIBSERVICE=$2/frameworks/nanostack-libservice
+    INC="-I$HERE -I$1/source -I$1/nanostack -I$1/nanostack/platform
+         -I$LIBSERVICE/mbed-client-libservice -I$LIBSERVICE/mbed-client-libservice/platform
+         -I$MBED/frameworks/mbed-client-randlib/mbed-client-randlib
+         -I$MBED/nanostack/sal-stack-nanostack-eventloop/nanostack-event-loop
+         -I$TI/mbed_port/mbednanostack2tirtos/platform -I$TI/mbed_config/ws_border_router"
+    SRC="$1/source/Service_Libs/fhss/channel_list.c $LIBSERVICE/source/libBits/common_functions.c"
+}
+
+# Builds the benchmark against a stack tree and runs it
+run_benches()
+{
+    $CC -std=gnu99 -O2 $INC -o "$OUT/channel_list_bench$1" \
+        "$HERE/channel_list_bench.c" "$HERE/host_stubs.c" $SRC
+    for channels in 35 69 129; do
+        "$OUT/channel_list_bench$1" $channels
+    done
+}
+
+mkdir -p "$OUT"
+tree_flags "$STACK" "$MBED"
+
+$CC -std=gnu99 -O1 -g -fsanitize=address,undefined $INC -o "$OUT/channel_list_test" \
+    "$HERE/channel_list_test.c" "$HERE/host_stubs.c" $SRC
+"$OUT/channel_list_test"
+
+echo "this tree:"
+run_benches
+
+if [ -n "$1" ]; then
+    TOP=$(git -C "$HERE" rev-parse --show-toplevel)
+    BASE=$OUT/$1
+    rm -rf "$BASE"
+    mkdir -p "$BASE"
+    git -C "$TOP" archive "$1" "$(git -C "$STACK" rev-parse --show-prefix)" \
+        "$(git -C "$MBED/frameworks/nanostack-libservice" rev-parse --show-prefix)" | tar -x -C "$BASE"
+    BASE_MBED=$BASE/$(git -C "$MBED" rev-parse --show-prefix)
+    BASE_STACK=$BASE_MBED/nanostack/sal-stack-nanostack
+    tree_flags "$BASE_STACK" "$BASE_MBED"
+    echo "$1:"
+    run_benches "_$1"
+fi
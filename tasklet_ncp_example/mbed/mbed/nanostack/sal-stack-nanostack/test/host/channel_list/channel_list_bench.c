@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Benchmark of channel look-ups, channel counts and channel exclusions.
+ *
+ * The mask has the given number of channels with two of them disabled, like
+ * a North American plan with a few channels excluded. Look-ups step through
+ * the enabled channels as the hopping sequence does. The exclusions cut an
+ * excluded range and an excluded mask IE from a neighbour's channel mask.
+ * Only functions that older revisions also have are used, and the exclusion
+ * handling is included through the include path, so this also builds against
+ * the bit loops of older revisions.
+ *
+ * Usage: channel_list_bench [channels] [rounds]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* The exclusion handling is static in ws_neighbor_class.c */
+#include "6LoWPAN/ws/ws_neighbor_class.c"
+#include "Service_Libs/fhss/channel_list.h"
+
+static double bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main(int argc, char *argv[])
+{
+    int channels = argc > 1 ? atoi(argv[1]) : 129;
+    int rounds = argc > 2 ? atoi(argv[2]) : 2000000;
+    static uint8_t range[8];
+    static uint8_t mask[17];
+    uint32_t list[8] = {0};
+    ws_channel_mask_t neighbour;
+
+    for (int channel = 0; channel < channels && channel < 256; channel++) {
+        list[channel / 32] |= (uint32_t) 1 << (channel % 32);
+    }
+    list[0] &= ~((uint32_t) 1 << 16);
+    list[2] &= ~((uint32_t) 1 << 23);
+    int enabled = channel_list_count_channels(list);
+
+    // channels 20-29 and 100-104 by range, every eighth one by mask
+    common_write_16_bit_inverse(20, range);
+    common_write_16_bit_inverse(29, range + 2);
+    common_write_16_bit_inverse(100, range + 4);
+    common_write_16_bit_inverse(104, range + 6);
+    memset(mask, 0x80, sizeof(mask));
+
+    volatile long sink = 0;
+    double t0 = bench_now_ns();
+    for (int i = 0; i < rounds; i++) {
+        sink += channel_list_get_channel(list, (i * 7) % enabled);
+    }
+    double t1 = bench_now_ns();
+    for (int i = 0; i < rounds; i++) {
+        list[7] ^= i & 1;
+        sink += channel_list_count_channels(list);
+    }
+    double t2 = bench_now_ns();
+    for (int i = 0; i < rounds; i++) {
+        ws_excluded_channel_range_t range_info = {2, range};
+        memcpy(neighbour.channel_mask, list, sizeof(list));
+        neighbour.channel_count = enabled;
+        ws_neighbour_excluded_mask_by_range(&neighbour, &range_info, channels);
+        sink += neighbour.channel_count;
+    }
+    double t3 = bench_now_ns();
+    for (int i = 0; i < rounds; i++) {
+        ws_excluded_channel_mask_t mask_info = {mask, (channels + 7) / 8};
+        memcpy(neighbour.channel_mask, list, sizeof(list));
+        neighbour.channel_count = enabled;
+        ws_neighbour_excluded_mask_by_mask(&neighbour, &mask_info, channels);
+        sink += neighbour.channel_count;
+    }
+    double t4 = bench_now_ns();
+
+    printf("%d channels: look-up %.1f ns, count %.1f ns, exclusion by range %.1f ns, by mask %.1f ns\n",
+           channels, (t1 - t0) / rounds, (t2 - t1) / rounds, (t3 - t2) / rounds, (t4 - t3) / rounds);
+    return 0;
+}
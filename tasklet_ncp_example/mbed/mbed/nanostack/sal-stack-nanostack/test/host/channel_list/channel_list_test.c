@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Comparison of the word at a time channel list helpers with the bit loops
+ * they replaced.
+ *
+ * Masks of varying density, from empty through sparse and dense to full, are
+ * counted, indexed and cut with channel exclusions both ways. Channel look-ups
+ * cover every index and channel limit, including indexes past the enabled
+ * channels, which must keep giving channel 0. Exclusions by range and by mask
+ * go through the Wi-SUN neighbour code and must leave the same mask and the
+ * same channel count. Last, every range is cut from a full mask for every
+ * channel limit.
+ *
+ * Usage: channel_list_test [masks]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* The exclusion handling is static in ws_neighbor_class.c */
+#include "../../../source/6LoWPAN/ws/ws_neighbor_class.c"
+
+/* Size of a channel list, the limit of channel_list.c */
+#define TEST_CHANNELS 256
+
+static long test_checks;
+
+static void test_fail(const char *what, int round)
+{
+    printf("FAIL: %s in round %d\n", what, round);
+    exit(1);
+}
+
+static uint32_t test_random32(void)
+{
+    return ((uint32_t) rand() << 16) ^ (uint32_t) rand();
+}
+
+/* The reference versions below are the bit loops of the earlier revision */
+
+static uint8_t test_ref_get_channel(const uint32_t *list, int current_index)
+{
+    uint8_t channel = 0;
+    int enabled_channels = 0;
+
+    if (current_index >= TEST_CHANNELS) {
+        current_index = 0;
+    }
+    for (int j = 0; j < 8; j++) {
+        for (int i = 0; i < 32; i++) {
+            if (list[j] & ((uint32_t) 1 << i)) {
+                enabled_channels++;
+                if (enabled_channels == current_index + 1) {
+                    return channel;
+                }
+            }
+            channel++;
+        }
+    }
+    return channel;
+}
+
+static int32_t test_ref_index_from_mask(const uint32_t *channel_mask, int32_t channel_index, uint16_t number_of_channels)
+{
+    int32_t active_channels = 0;
+
+    for (int32_t i = 0; i < number_of_channels; i++) {
+        if (channel_mask[i / 32] & ((uint32_t) 1 << (i % 32))) {
+            if (channel_index == active_channels) {
+                return i;
+            }
+            active_channels++;
+        }
+    }
+    return 0;
+}
+
+static int test_ref_count_channels(const uint32_t *list)
+{
+    int channel_count = 0;
+
+    for (int i = 0; i < TEST_CHANNELS; i++) {
+        if (list[i / 32] & ((uint32_t) 1 << (i % 32))) {
+            channel_count++;
+        }
+    }
+    return channel_count;
+}
+
+static void test_ref_excluded_mask_by_range(ws_channel_mask_t *channel_info, const uint8_t *range_ptr, uint8_t number_of_range, uint16_t number_of_channels)
+{
+    while (number_of_range--) {
+        uint16_t range_start = common_read_16_bit_inverse(range_ptr);
+        uint16_t range_stop = common_read_16_bit_inverse(range_ptr + 2);
+        range_ptr += 4;
+        for (uint16_t channel = 0; channel < number_of_channels; channel++) {
+            if (channel >= range_start && channel <= range_stop) {
+                uint32_t compare_mask_bit = (uint32_t) 1 << (channel % 32);
+                if (channel_info->channel_mask[channel / 32] & compare_mask_bit) {
+                    channel_info->channel_mask[channel / 32] ^= compare_mask_bit;
+                    channel_info->channel_count--;
+                }
+            } else if (channel > range_stop) {
+                break;
+            }
+        }
+    }
+}
+
+static uint32_t test_ref_reverse_order(uint32_t value)
+{
+    uint32_t ret_val = 0;
+
+    for (uint8_t i = 0; i < 32; i++) {
+        if (value & ((uint32_t) 1 << i)) {
+            ret_val |= (uint32_t) 1 << (31 - i);
+        }
+    }
+    return ret_val;
+}
+
+static void test_ref_excluded_mask_by_mask(ws_channel_mask_t *channel_info, const uint8_t *mask_ptr, uint8_t mask_len_inline, uint16_t number_of_channels)
+{
+    uint16_t channel_at_mask = mask_len_inline * 8;
+    uint8_t mask_index = 0;
+
+    if (mask_len_inline == 0) {
+        return;
+    }
+    for (uint16_t channel = 0; channel < number_of_channels; channel += 32) {
+        uint32_t channel_compare_mask = 0;
+        if (channel) {
+            mask_index++;
+            mask_ptr += 4;
+        }
+        if (channel_at_mask >= 32) {
+            channel_compare_mask = common_read_32_bit(mask_ptr);
+            channel_at_mask -= 32;
+        } else {
+            uint8_t move_mask = 0;
+            while (channel_at_mask) {
+                channel_compare_mask |= (uint32_t) *mask_ptr++ << (24 - move_mask);
+                channel_at_mask -= 8;
+                move_mask += 8;
+            }
+        }
+        channel_compare_mask = test_ref_reverse_order(channel_compare_mask);
+        for (uint8_t i = 0; i < 32; i++) {
+            uint32_t compare_mask_bit = (uint32_t) 1 << i;
+            if ((channel_compare_mask & compare_mask_bit) && (channel_info->channel_mask[mask_index] & compare_mask_bit)) {
+                channel_info->channel_mask[mask_index] ^= compare_mask_bit;
+                channel_info->channel_count--;
+            }
+        }
+        if (channel_at_mask == 0) {
+            break;
+        }
+    }
+}
+
+/* Empty, sparse, dense, half full and random masks in turn */
+static void test_mask_init(uint32_t *list, int round)
+{
+    for (int word = 0; word < 8; word++) {
+        uint32_t value = test_random32();
+        switch (round % 5) {
+            case 0:
+                value &= test_random32() & test_random32();
+                break;
+            case 1:
+                value |= test_random32() | test_random32();
+                break;
+            case 2:
+                value = 0;
+                break;
+            case 3:
+                if (word % 2) {
+                    value = 0xffffffff;
+                }
+                break;
+        }
+        list[word] = value;
+    }
+}
+
+static void test_lookups(const uint32_t *list, int round)
+{
+    if (channel_list_count_channels(list) != test_ref_count_channels(list)) {
+        test_fail("channel count differs", round);
+    }
+    for (int index = -2; index <= TEST_CHANNELS + 4; index++) {
+        if (channel_list_get_channel(list, index) != test_ref_get_channel(list, index)) {
+            test_fail("channel_list_get_channel differs", round);
+        }
+        test_checks++;
+    }
+    // every channel limit for the first masks, a spread of them after that
+    for (int limit = 0; limit <= TEST_CHANNELS; limit += round < 200 ? 1 : 37) {
+        for (int index = -1; index <= limit + 1; index++) {
+            int channel = channel_list_select(list, index, limit);
+            if (channel < -1 || (channel < 0 ? 0 : channel) != test_ref_index_from_mask(list, index, limit)) {
+                test_fail("channel_list_select differs", round);
+            }
+            test_checks++;
+        }
+    }
+}
+
+static void test_exclusions(const uint32_t *list, int round)
+{
+    uint8_t buffer[4 * 8];
+    ws_channel_mask_t test, ref;
+    uint16_t number_of_channels = 1 + rand() % TEST_CHANNELS;
+
+    // clear_word against a per-bit clear
+    for (int word = 0; word < 8; word++) {
+        uint32_t clear_mask = test_random32();
+        memcpy(test.channel_mask, list, sizeof(test.channel_mask));
+        memcpy(ref.channel_mask, list, sizeof(ref.channel_mask));
+        int cleared = 0;
+        for (int i = 0; i < 32; i++) {
+            uint32_t bit = (uint32_t) 1 << i;
+            if ((clear_mask & bit) && (ref.channel_mask[word] & bit)) {
+                ref.channel_mask[word] ^= bit;
+                cleared++;
+            }
+        }
+        if (channel_list_clear_word(test.channel_mask, word, clear_mask) != cleared ||
+                memcmp(test.channel_mask, ref.channel_mask, sizeof(test.channel_mask))) {
+            test_fail("channel_list_clear_word differs", round);
+        }
+        test_checks++;
+    }
+
+    uint32_t value = test_random32();
+    if (ws_reserve_order_32_bit(value) != test_ref_reverse_order(value)) {
+        test_fail("bit reversal differs", round);
+    }
+
+    // up to eight ranges, some past the channel limit or reversed
+    for (int k = 0; k < 20; k++) {
+        ws_excluded_channel_range_t range_info;
+        uint8_t number_of_range = 1 + rand() % 8;
+        for (int i = 0; i < number_of_range * 2; i++) {
+            common_write_16_bit_inverse(rand() % 300, buffer + i * 2);
+        }
+        memcpy(test.channel_mask, list, sizeof(test.channel_mask));
+        memcpy(ref.channel_mask, list, sizeof(ref.channel_mask));
+        test.channel_count = ref.channel_count = channel_list_count_channels(list);
+        range_info.number_of_range = number_of_range;
+        range_info.range_start = buffer;
+        ws_neighbour_excluded_mask_by_range(&test, &range_info, number_of_channels);
+        test_ref_excluded_mask_by_range(&ref, buffer, number_of_range, number_of_channels);
+        if (test.channel_count != ref.channel_count ||
+                memcmp(test.channel_mask, ref.channel_mask, sizeof(test.channel_mask))) {
+            test_fail("exclusion by range differs", round);
+        }
+        if (test.channel_count != channel_list_count_channels(test.channel_mask)) {
+            test_fail("channel count not exact after exclusion by range", round);
+        }
+        test_checks++;
+    }
+
+    // masks of every inline length, not necessarily covering all channels
+    for (int k = 0; k < 20; k++) {
+        ws_excluded_channel_mask_t mask_info;
+        uint8_t mask_len_inline = rand() % (sizeof(buffer) + 1);
+        for (unsigned i = 0; i < sizeof(buffer); i++) {
+            buffer[i] = rand();
+        }
+        memcpy(test.channel_mask, list, sizeof(test.channel_mask));
+        memcpy(ref.channel_mask, list, sizeof(ref.channel_mask));
+        test.channel_count = ref.channel_count = channel_list_count_channels(list);
+        mask_info.channel_mask = buffer;
+        mask_info.mask_len_inline = mask_len_inline;
+        ws_neighbour_excluded_mask_by_mask(&test, &mask_info, number_of_channels);
+        test_ref_excluded_mask_by_mask(&ref, buffer, mask_len_inline, number_of_channels);
+        if (test.channel_count != ref.channel_count ||
+                memcmp(test.channel_mask, ref.channel_mask, sizeof(test.channel_mask))) {
+            test_fail("exclusion by mask differs", round);
+        }
+        if (test.channel_count != channel_list_count_channels(test.channel_mask)) {
+            test_fail("channel count not exact after exclusion by mask", round);
+        }
+        test_checks++;
+    }
+}
+
+/* Every range, including reversed and out of limit ones, on a full mask */
+static void test_full_mask_ranges(void)
+{
+    uint8_t buffer[4];
+
+    for (int limit = 0; limit <= TEST_CHANNELS; limit++) {
+        for (int start = 0; start < TEST_CHANNELS + 4; start++) {
+            for (int stop = start > 4 ? start - 3 : 0; stop < TEST_CHANNELS + 4; stop += stop > start + 40 ? 8 : 1) {
+                ws_excluded_channel_range_t range_info = {1, buffer};
+                ws_channel_mask_t test, ref;
+                memset(test.channel_mask, 0xff, sizeof(test.channel_mask));
+                memset(ref.channel_mask, 0xff, sizeof(ref.channel_mask));
+                test.channel_count = ref.channel_count = TEST_CHANNELS;
+                common_write_16_bit_inverse(start, buffer);
+                common_write_16_bit_inverse(stop, buffer + 2);
+                ws_neighbour_excluded_mask_by_range(&test, &range_info, limit);
+                test_ref_excluded_mask_by_range(&ref, buffer, 1, limit);
+                if (test.channel_count != ref.channel_count ||
+                        memcmp(test.channel_mask, ref.channel_mask, sizeof(test.channel_mask))) {
+                    test_fail("exclusion by range of a full mask differs", limit);
+                }
+                test_checks++;
+            }
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int masks = argc > 1 ? atoi(argv[1]) : 20000;
+    uint32_t list[8];
+
+    srand(1);
+    for (int round = 0; round < masks; round++) {
+        test_mask_init(list, round);
+        test_lookups(list, round);
+        test_exclusions(list, round);
+    }
+    test_full_mask_ranges();
+
+    printf("OK: %d masks, %ld checks\n", masks, test_checks);
+    return 0;
+}
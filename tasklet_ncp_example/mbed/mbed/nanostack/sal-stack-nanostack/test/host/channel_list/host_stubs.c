@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * The parts of the stack that ws_neighbor_class.c calls out to. Only the
+ * excluded channel handling is exercised, so these are never called with
+ * anything that matters.
+ */
+
+#include "nsconfig.h"
+#include <stdarg.h>
+#include <stdlib.h>
+#include "ns_types.h"
+#include "nsdynmemLIB.h"
+#include "6LoWPAN/ws/ws_config.h"
+#include "6LoWPAN/ws/ws_common.h"
+
+uint8_t DEVICE_MIN_SENS;
+
+void *ns_dyn_mem_alloc(ns_mem_block_size_t alloc_size)
+{
+    return malloc(alloc_size);
+}
+
+void ns_dyn_mem_free(void *block)
+{
+    free(block);
+}
+
+int8_t ws_generate_channel_list(uint32_t *channel_mask, uint16_t number_of_channels, uint8_t regulatory_domain, uint8_t operating_class, uint8_t channel_plan_id)
+{
+    (void) channel_mask;
+    (void) number_of_channels;
+    (void) regulatory_domain;
+    (void) operating_class;
+    (void) channel_plan_id;
+    return 0;
+}
+
+uint16_t ws_active_channel_count(uint32_t *channel_mask, uint16_t number_of_channels)
+{
+    (void) channel_mask;
+    (void) number_of_channels;
+    return 0;
+}
+
+uint16_t ws_common_channel_number_calc(uint8_t regulatory_domain, uint8_t operating_class, uint8_t channel_plan_id)
+{
+    (void) regulatory_domain;
+    (void) operating_class;
+    (void) channel_plan_id;
+    return 0;
+}
+
+void ns_trace_printf(uint8_t dlevel, const char *grp, const char *fmt, ...)
+{
+    (void) dlevel;
+    (void) grp;
+    (void) fmt;
+}
+
+char *ns_trace_array(const uint8_t *buf, uint16_t len)
+{
+    (void) buf;
+    (void) len;
+    return "";
+}
@@ -0,0 +1,42 @@
+#!/bin/sh
+#
+# Builds and runs the host test and benchmark of the TR51 unicast sequence
+# cache of fhss_ws.
+#
+#   build.sh
+#
+# The benchmark compares the cache with the per-frame computation, which the
+# tree still has as the fallback, so no older revision is needed. Set CC and
+# OUT to change the compiler and the build directory.
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+STACK=$(cd "$HERE/../../.." && pwd)
+MBED=$(cd "$STACK/../.." && pwd)
+TI=$(cd "$MBED/../../ti_wisunfan/ti_wisunfan" && pwd)
+OUT=${OUT:-${TMPDIR:-/tmp}/fhss_ws_test}
+CC=${CC:-cc}
+
+LIBSERVICE=$MBED/frameworks/nanostack-libservice
+INC="-I$HERE -I$STACK/source -I$STACK/nanostack -I$STACK/nanostack/platform
+     -I$LIBSERVICE/mbed-client-libservice -I$LIBSERVICE/mbed-client-libservice/platform
+     -I$MBED/frameworks/mbed-client-randlib/mbed-client-randlib
+     -I$MBED/nanostack/sal-stack-nanostack-eventloop/nanostack-event-loop
+     -I$TI/mbed_port/mbednanostack2tirtos/platform -I$TI/mbed_config/ws_border_router"
+SRC="$STACK/source/Service_Libs/fhss/channel_functions.c $STACK/source/Service_Libs/fhss/channel_list.c
+     $LIBSERVICE/source/libBits/common_functions.c"
+
+mkdir -p "$OUT"
+
+$CC -std=gnu99 -O1 -g -fsanitize=address,undefined $INC -o "$OUT/tr51_cache_test" \
+    "$HERE/tr51_cache_test.c" "$HERE/host_stubs.c" $SRC
+"$OUT/tr51_cache_test"
+"$OUT/tr51_cache_test" 200000 3
+"$OUT/tr51_cache_test" 100000 7
+
+$CC -std=gnu99 -O2 $INC -o "$OUT/tr51_cache_bench" \
+    "$HERE/tr51_cache_bench.c" "$HERE/host_stubs.c" $SRC
+for channels in 35 69 129; do
+    "$OUT/tr51_cache_bench" $channels
+done
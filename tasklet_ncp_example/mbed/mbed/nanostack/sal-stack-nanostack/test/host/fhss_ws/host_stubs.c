@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * The parts of the stack that fhss_ws.c calls out to, reduced to what
+ * configuring the channel plan and picking TX channels needs. No timer ever
+ * fires. The heap is the host malloc so that the sanitizers see the channel
+ * tables and the sequence cache.
+ */
+
+#include "nsconfig.h"
+#include <stdarg.h>
+#include <stdlib.h>
+#include "ns_types.h"
+#include "fhss_api.h"
+#include "fhss_config.h"
+#include "nsdynmemLIB.h"
+#include "randLIB.h"
+#include "eventOS_callback_timer.h"
+#include "platform/arm_hal_interrupt.h"
+#include "Service_Libs/fhss/fhss.h"
+#include "Service_Libs/fhss/fhss_common.h"
+#include "Service_Libs/fhss/fhss_statistics.h"
+#include "host_stubs.h"
+
+unsigned host_alloc_fail_every;
+
+static unsigned host_alloc_count;
+
+void *ns_dyn_mem_alloc(ns_mem_block_size_t alloc_size)
+{
+    if (host_alloc_fail_every && ++host_alloc_count % host_alloc_fail_every == 0) {
+        return NULL;
+    }
+    return malloc(alloc_size);
+}
+
+void ns_dyn_mem_free(void *block)
+{
+    free(block);
+}
+
+uint16_t randLIB_get_random_in_range(uint16_t min, uint16_t max)
+{
+    return min + rand() % (max - min + 1);
+}
+
+void platform_enter_critical(void)
+{
+}
+
+void platform_exit_critical(void)
+{
+}
+
+int8_t eventOS_callback_timer_register(void (*timer_interrupt_handler)(int8_t, uint16_t))
+{
+    (void) timer_interrupt_handler;
+    return 0;
+}
+
+int8_t eventOS_callback_timer_start(int8_t ns_timer_id, uint16_t slots)
+{
+    (void) ns_timer_id;
+    (void) slots;
+    return 0;
+}
+
+int8_t eventOS_callback_timer_stop(int8_t ns_timer_id)
+{
+    (void) ns_timer_id;
+    return 0;
+}
+
+fhss_structure_t *fhss_allocate_instance(fhss_api_t *fhss_api, const fhss_timer_t *fhss_timer)
+{
+    (void) fhss_api;
+    (void) fhss_timer;
+    return NULL;
+}
+
+int8_t fhss_free_instance(fhss_api_t *fhss_api)
+{
+    (void) fhss_api;
+    return 0;
+}
+
+fhss_structure_t *fhss_get_object_with_api(const fhss_api_t *fhss_api)
+{
+    (void) fhss_api;
+    return NULL;
+}
+
+fhss_structure_t *fhss_get_object_with_timer_id(const int8_t timer_id)
+{
+    (void) timer_id;
+    return NULL;
+}
+
+int fhss_init_callbacks_cb(const fhss_api_t *api, fhss_callback_t *callbacks)
+{
+    (void) api;
+    (void) callbacks;
+    return 0;
+}
+
+void fhss_start_timer(fhss_structure_t *fhss_structure, uint32_t time, void (*callback)(const fhss_api_t *fhss_api, uint16_t))
+{
+    (void) fhss_structure;
+    (void) time;
+    (void) callback;
+}
+
+void fhss_stop_timer(fhss_structure_t *fhss_structure, void (*callback)(const fhss_api_t *fhss_api, uint16_t))
+{
+    (void) fhss_structure;
+    (void) callback;
+}
+
+int fhss_failed_handle_add(fhss_structure_t *fhss_structure, uint8_t handle, uint8_t bad_channel)
+{
+    (void) fhss_structure;
+    (void) handle;
+    (void) bad_channel;
+    return -1;
+}
+
+fhss_failed_tx_t *fhss_failed_handle_find(fhss_structure_t *fhss_structure, uint8_t handle)
+{
+    (void) fhss_structure;
+    (void) handle;
+    return NULL;
+}
+
+int fhss_failed_handle_remove(fhss_structure_t *fhss_structure, uint8_t handle)
+{
+    (void) fhss_structure;
+    (void) handle;
+    return -1;
+}
+
+void fhss_stats_update(fhss_structure_t *fhss_structure, fhss_stats_type_t type, uint32_t update_val)
+{
+    (void) fhss_structure;
+    (void) type;
+    (void) update_val;
+}
+
+void ns_trace_printf(uint8_t dlevel, const char *grp, const char *fmt, ...)
+{
+    (void) dlevel;
+    (void) grp;
+    (void) fmt;
+}
+
+char *ns_trace_array(const uint8_t *buf, uint16_t len)
+{
+    (void) buf;
+    (void) len;
+    return "";
+}
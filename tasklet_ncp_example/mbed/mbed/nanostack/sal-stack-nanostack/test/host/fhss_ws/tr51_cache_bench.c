@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Benchmark of picking the TR51 unicast TX channel.
+ *
+ * With the given channel count, TX channels are picked for random slots of
+ * a rotating set of destinations: by the per-frame computation that
+ * fhss_ws_tx_handle_callback() falls back to, and through the sequence
+ * cache. With more destinations than the default cache holds, every TX
+ * misses and refills an entry, which is the worst case of the cache. Sized
+ * for the neighbour table, as the bootstrap does, the cache holds them all.
+ *
+ * Usage: tr51_cache_bench [channels] [channel picks]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* The cache and the channel mapping are static in fhss_ws.c */
+#include "../../../source/Service_Libs/fhss/fhss_ws.c"
+
+#include "host_stubs.h"
+
+static double bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main(int argc, char *argv[])
+{
+    static fhss_structure_t fhss;
+    static fhss_ws_t ws;
+    static const int destinations[] = {1, FHSS_WS_TR51_CACHE_SIZE, 16, 16};
+    fhss_ws_configuration_t configuration = {0};
+    uint16_t channels = argc > 1 ? atoi(argv[1]) : 129;
+    int picks = argc > 2 ? atoi(argv[2]) : 200000;
+    uint8_t eui64[16][8];
+    uint32_t channel_mask[8] = {0};
+    uint16_t *slot = malloc(picks * sizeof(uint16_t));
+
+    configuration.ws_uc_channel_function = WS_TR51CF;
+    configuration.ws_bc_channel_function = WS_TR51CF;
+    configuration.channel_mask_size = channels;
+    for (uint16_t i = 0; i < channels; i++) {
+        configuration.channel_mask[i / 32] |= 1u << (i % 32);
+        /* Destinations exclude a few channels */
+        if (i % 16) {
+            channel_mask[i / 32] |= 1u << (i % 32);
+        }
+    }
+    fhss.ws = &ws;
+    if (fhss_ws_configuration_set(&fhss, &configuration) < 0 || !ws.tr51_cache_sequences) {
+        printf("configuration failed\n");
+        return 1;
+    }
+
+    srand(1);
+    for (int i = 0; i < 16; i++) {
+        eui64[i][0] = 0x00;
+        eui64[i][1] = 0x12;
+        eui64[i][2] = 0x4b;
+        for (int j = 3; j < 8; j++) {
+            eui64[i][j] = rand();
+        }
+    }
+    for (int i = 0; i < picks; i++) {
+        slot[i] = rand() % channels;
+    }
+
+    volatile int32_t sink = 0;
+    double t0 = bench_now_ns();
+    for (int i = 0; i < picks; i++) {
+        int32_t channel = tr51_get_uc_channel_index(ws.tr51_channel_table, ws.tr51_output_table, slot[i], eui64[i % 16], channels, NULL);
+        sink += fhss_channel_index_from_mask(channel_mask, channel, fhss.number_of_channels);
+    }
+    double t1 = bench_now_ns();
+    printf("%u channels: computed %.0f ns", channels, (t1 - t0) / picks);
+
+    for (int d = 0; d < 4; d++) {
+        uint8_t cache_entry[16] = {0};
+        if (d == 3) {
+            fhss_ws_set_neighbor_table_size(&fhss, 16);
+        }
+        t0 = bench_now_ns();
+        for (int i = 0; i < picks; i++) {
+            int n = i % destinations[d];
+            sink += fhss_ws_tr51_cached_sequence(&fhss, eui64[n], channels, channel_mask, &cache_entry[n])[slot[i]];
+        }
+        t1 = bench_now_ns();
+        printf(", cached %s %d destinations %.0f ns", d == 3 ? "for all" : "with", destinations[d], (t1 - t0) / picks);
+    }
+    printf("\n");
+
+    ns_dyn_mem_free(ws.tr51_channel_table);
+    ns_dyn_mem_free(ws.tr51_output_table);
+    ns_dyn_mem_free(ws.tr51_cache);
+    free(slot);
+    return 0;
+}
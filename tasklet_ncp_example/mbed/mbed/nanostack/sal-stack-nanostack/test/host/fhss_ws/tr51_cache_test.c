@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Randomised test of the TR51 unicast sequence cache of fhss_ws.
+ *
+ * A pool of neighbours, more than the default cache holds, get random channel
+ * counts and channel masks, which now and then change as a new schedule IE
+ * would. Each TX picks the channel of a random slot from the cache and from
+ * the per-frame computation the cache replaced, and the two must agree. Now
+ * and then the channel plan is reconfigured, which changes the channel count
+ * the sequences are mapped through and may reallocate the tables. With a
+ * failing heap, TX must fall back to the computation whenever the cache is
+ * missing.
+ *
+ * The cache is also sized for the whole neighbour table now and then, and
+ * then a neighbour must keep its entry until its schedule or the channel
+ * plan changes. The entry number a neighbour keeps is now and then garbled,
+ * which must only cost a lookup.
+ *
+ * Above 128 channels, the 8-bit index of tr51_calculate_hopping_sequence()
+ * wraps and the sequence comes out shorter than the channel count. The
+ * per-frame computation then picked stale entries of the output table for
+ * the last slots, so only slots within the sequence are compared.
+ *
+ * Usage: tr51_cache_test [rounds] [fail every nth alloc]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* The cache and the channel mapping are static in fhss_ws.c */
+#include "../../../source/Service_Libs/fhss/fhss_ws.c"
+
+#include "host_stubs.h"
+
+#define TEST_NEIGHBOURS (FHSS_WS_TR51_CACHE_SIZE * 3)
+
+typedef struct test_neighbour {
+    uint8_t eui64[8];
+    uint16_t number_of_channels;
+    uint32_t channel_mask[8];
+    uint8_t cache_entry;
+    bool cached;                /* Has had an entry since the last change */
+} test_neighbour_t;
+
+static fhss_structure_t test_fhss;
+static fhss_ws_t test_ws;
+static test_neighbour_t test_neighbour[TEST_NEIGHBOURS];
+static bool test_configured;
+static bool test_sized;
+
+static void test_fail(const char *what, int round)
+{
+    printf("FAIL: %s in round %d\n", what, round);
+    exit(1);
+}
+
+static void test_mask_set(uint32_t mask[8], uint16_t channels, bool holes)
+{
+    memset(mask, 0, 8 * sizeof(uint32_t));
+    for (uint16_t i = 0; i < channels; i++) {
+        if (!holes || rand() % 8) {
+            mask[i / 32] |= 1u << (i % 32);
+        }
+    }
+}
+
+/* A new channel plan, as fhss_ws_configuration_set() gets from the bootstrap */
+static void test_configure(int round)
+{
+    static const uint16_t channels[] = {35, 69, 129, 129, 136, 256};
+    fhss_ws_configuration_t configuration = {0};
+
+    configuration.ws_uc_channel_function = WS_TR51CF;
+    configuration.ws_bc_channel_function = WS_TR51CF;
+    configuration.channel_mask_size = channels[rand() % 6];
+    test_mask_set(configuration.channel_mask, configuration.channel_mask_size, rand() % 2);
+    if (rand() % 2) {
+        test_mask_set(configuration.unicast_channel_mask, configuration.channel_mask_size, true);
+    }
+
+    test_configured = fhss_ws_configuration_set(&test_fhss, &configuration) == 0;
+    if (!test_configured && !host_alloc_fail_every) {
+        test_fail("configuration failed", round);
+    }
+    for (int i = 0; i < TEST_NEIGHBOURS; i++) {
+        test_neighbour[i].cached = false;
+    }
+}
+
+/* Sizes the cache for the neighbour table, or back to the default */
+static void test_size(int round)
+{
+    test_sized = !test_sized;
+    fhss_ws_set_neighbor_table_size(&test_fhss, test_sized ? TEST_NEIGHBOURS : 0);
+    if (test_ws.tr51_cache && test_ws.tr51_cache_size != (test_sized ? TEST_NEIGHBOURS : FHSS_WS_TR51_CACHE_SIZE)) {
+        test_fail("cache size", round);
+    }
+    for (int i = 0; i < TEST_NEIGHBOURS; i++) {
+        test_neighbour[i].cached = false;
+    }
+}
+
+static void test_neighbour_schedule(test_neighbour_t *neighbour)
+{
+    uint16_t max = test_fhss.number_of_bc_channels;
+
+    /* The TR51 step size is undefined for a single channel */
+    neighbour->number_of_channels = rand() % 4 ? max : rand() % (max - 1) + 2;
+    test_mask_set(neighbour->channel_mask, test_fhss.number_of_channels, rand() % 2);
+    neighbour->cached = false;
+}
+
+/* The per-frame computation of fhss_ws_tx_handle_callback() before the cache,
+ * or -1 if the slot is beyond the sequence.
+ */
+static int32_t test_channel_computed(const test_neighbour_t *neighbour, uint16_t slot)
+{
+    static uint8_t output_table[512];
+
+    if (slot >= tr51_get_uc_hopping_sequence(test_ws.tr51_channel_table, output_table, neighbour->eui64, neighbour->number_of_channels, NULL)) {
+        return -1;
+    }
+    int32_t channel = tr51_get_uc_channel_index(test_ws.tr51_channel_table, output_table, slot, (uint8_t *) neighbour->eui64, neighbour->number_of_channels, NULL);
+    return fhss_channel_index_from_mask(neighbour->channel_mask, channel, test_fhss.number_of_channels);
+}
+
+static bool test_channel_valid(uint8_t channel, const test_neighbour_t *neighbour, uint16_t slot)
+{
+    int32_t computed = test_channel_computed(neighbour, slot);
+    return computed < 0 || channel == computed;
+}
+
+static void test_tx(int round)
+{
+    test_neighbour_t *neighbour = &test_neighbour[rand() % TEST_NEIGHBOURS];
+    uint8_t cache_entry = neighbour->cache_entry;
+
+    if (rand() % 100 == 0) {
+        neighbour->cache_entry = rand();
+        neighbour->cached = false;
+    }
+    const uint8_t *sequence = fhss_ws_tr51_cached_sequence(&test_fhss, neighbour->eui64, neighbour->number_of_channels, neighbour->channel_mask, &neighbour->cache_entry);
+
+    if (!sequence) {
+        if (!host_alloc_fail_every) {
+            test_fail("no cached sequence", round);
+        }
+        neighbour->cached = false;
+        return;
+    }
+    if (test_sized && test_ws.tr51_cache_size == TEST_NEIGHBOURS && neighbour->cached && neighbour->cache_entry != cache_entry) {
+        test_fail("neighbour lost its entry in a cache sized for all", round);
+    }
+    neighbour->cached = true;
+    if (rand() % 64 == 0) {
+        for (uint16_t slot = 0; slot < neighbour->number_of_channels; slot++) {
+            if (!test_channel_valid(sequence[slot], neighbour, slot)) {
+                test_fail("cached sequence differs from computation", round);
+            }
+        }
+    } else {
+        uint16_t slot = rand() % neighbour->number_of_channels;
+        if (!test_channel_valid(sequence[slot], neighbour, slot)) {
+            test_fail("cached channel differs from computation", round);
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int rounds = argc > 1 ? atoi(argv[1]) : 200000;
+    host_alloc_fail_every = argc > 2 ? atoi(argv[2]) : 0;
+
+    srand(1);
+    test_fhss.ws = &test_ws;
+    do {
+        test_configure(-1);
+    } while (!test_configured);
+    for (int i = 0; i < TEST_NEIGHBOURS; i++) {
+        test_neighbour[i].eui64[0] = 0x00;
+        test_neighbour[i].eui64[1] = 0x12;
+        test_neighbour[i].eui64[2] = 0x4b;
+        for (int j = 3; j < 8; j++) {
+            test_neighbour[i].eui64[j] = rand();
+        }
+        test_neighbour_schedule(&test_neighbour[i]);
+    }
+
+    int configurations = 0;
+    for (int round = 0; round < rounds; round++) {
+        if (!test_configured || rand() % 2000 == 0) {
+            test_configure(round);
+            configurations++;
+            /* Neighbours that still fit keep their schedule half of the time */
+            for (int i = 0; test_configured && i < TEST_NEIGHBOURS; i++) {
+                if (test_neighbour[i].number_of_channels > test_fhss.number_of_bc_channels || rand() % 2) {
+                    test_neighbour_schedule(&test_neighbour[i]);
+                }
+            }
+            continue;
+        }
+        if (rand() % 500 == 0) {
+            test_neighbour_schedule(&test_neighbour[rand() % TEST_NEIGHBOURS]);
+        }
+        if (rand() % 5000 == 0) {
+            test_size(round);
+        }
+        test_tx(round);
+    }
+
+    ns_dyn_mem_free(test_ws.tr51_channel_table);
+    ns_dyn_mem_free(test_ws.tr51_output_table);
+    ns_dyn_mem_free(test_ws.tr51_cache);
+
+    printf("OK: %d rounds, failing alloc %u, %d configurations\n", rounds, host_alloc_fail_every, configurations);
+    return 0;
+}
@@ -0,0 +1,81 @@
+#!/bin/sh
+#
+# Builds and runs the host test of 6LoWPAN fragment forwarding and
+# reassembly, the reassembly benchmark, and the multi-hop model of
+# forwarding against reassembly at every relay.
+#
+#   build.sh [git revision]
+#
+# With a git revision, the benchmark is also built against the stack of that
+# revision, e.g. the session list walk before the hash. Set CC and OUT to
+# change the compiler and the build directory.
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+STACK=$(cd "$HERE/../../.." && pwd)
+MBED=$(cd "$STACK/../.." && pwd)
+TI=$(cd "$MBED/../../ti_wisunfan/ti_wisunfan" && pwd)
+OUT=${OUT:-${TMPDIR:-/tmp}/fragmentation_test}
+CC=${CC:-cc}
+
+# Sources and include paths of a stack and libservice tree
+tree_flags()
+{
+    LIBSERVICE=$2/frameworks/nanostack-libservice
+    INC="-I$HERE -I$1/source -I$1/nanostack -I$1/nanostack/platform
+         -I$LIBSERVICE/mbed-client-libservice -I$LIBSERVICE/mbed-client-libservice/platform
+         -I$MBED/frameworks/mbed-client-randlib/mbed-client-randlib
+         -I$MBED/nanostack/sal-stack-nanostack-eventloop/nanostack-event-loop
+         -I$TI/mbed_port/mbednanostack2tirtos/platform -I$TI/mbed_config/ws_border_router"
+    SRC="$1/source/Core/buffer_dyn.c $LIBSERVICE/source/libList/ns_list.c
+         $LIBSERVICE/source/libBits/common_functions.c $LIBSERVICE/source/IPv6_fcf_lib/ip_fsc.c"
+}
+
+# Builds the benchmark against a stack tree and runs it
+run_bench()
+{
+    $CC -std=gnu99 -O2 $INC -o "$OUT/reassembly_bench$2" \
+        "$HERE/reassembly_bench.c" "$HERE/host_stubs.c" "$1/source/6LoWPAN/Fragmentation/cipv6_fragmenter.c" $SRC
+    for sessions in 8 32 128; do
+        "$OUT/reassembly_bench$2" $sessions
+    done
+}
+
+mkdir -p "$OUT"
+tree_flags "$STACK" "$MBED"
+
+$CC -std=gnu99 -O1 -g -fsanitize=address,undefined $INC -o "$OUT/cipv6_fragmenter_test" \
+    "$HERE/cipv6_fragmenter_test.c" "$HERE/host_stubs.c" $SRC
+"$OUT/cipv6_fragmenter_test"
+"$OUT/cipv6_fragmenter_test" 32 32 8
+"$OUT/cipv6_fragmenter_test" 8 8 1
+"$OUT/cipv6_fragmenter_test" 4 12 4
+"$OUT/cipv6_fragmenter_test" 8 8 4 20000 7
+
+# With the preallocated reassembly buffers
+$CC -std=gnu99 -O1 -g -fsanitize=address,undefined -DCIPV6_REASSEMBLY_BUFFER_SIZE=1280 $INC \
+    -o "$OUT/cipv6_fragmenter_pool_test" "$HERE/cipv6_fragmenter_test.c" "$HERE/host_stubs.c" $SRC
+"$OUT/cipv6_fragmenter_pool_test"
+"$OUT/cipv6_fragmenter_pool_test" 4 12 4
+"$OUT/cipv6_fragmenter_pool_test" 8 8 4 20000 7
+
+$CC -std=gnu99 -O2 -o "$OUT/fragment_forwarding_model" "$HERE/fragment_forwarding_model.c"
+"$OUT/fragment_forwarding_model" 1280 200
+
+echo "this tree:"
+run_bench "$STACK"
+
+if [ -n "$1" ]; then
+    TOP=$(git -C "$HERE" rev-parse --show-toplevel)
+    BASE=$OUT/$1
+    rm -rf "$BASE"
+    mkdir -p "$BASE"
+    git -C "$TOP" archive "$1" "$(git -C "$STACK" rev-parse --show-prefix)" \
+        "$(git -C "$MBED/frameworks/nanostack-libservice" rev-parse --show-prefix)" | tar -x -C "$BASE"
+    BASE_MBED=$BASE/$(git -C "$MBED" rev-parse --show-prefix)
+    BASE_STACK=$BASE_MBED/nanostack/sal-stack-nanostack
+    tree_flags "$BASE_STACK" "$BASE_MBED"
+    echo "$1:"
+    run_bench "$BASE_STACK" "_$1"
+fi
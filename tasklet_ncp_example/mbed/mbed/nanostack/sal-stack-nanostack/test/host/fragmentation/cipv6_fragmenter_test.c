@@ -0,0 +1,518 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Randomised test of 6LoWPAN fragment forwarding and reassembly.
+ *
+ * Datagrams from a set of neighbours are fragmented and the fragments fed to
+ * cipv6_frag_reassembly(), several datagrams interleaved. Each datagram's
+ * fragments come mostly in order, with the odd swap and duplicate, and the
+ * last one last. A datagram routes either to us or to a next hop, following
+ * the stand-in IPHC header of host_stubs.h.
+ *
+ * Whatever comes out must be right: a reassembled datagram intact, a
+ * forwarded first fragment under a new tag for the next hop, and the other
+ * fragments of that datagram under the same tag with their payload
+ * untouched. With no more datagrams in flight than reassembly sessions and a
+ * heap that doesn't fail, each datagram must also come out exactly once,
+ * either way. It must be forwarded if its first fragment arrives first, it
+ * routes to a next hop and fewer flows than the limit are in progress, and a
+ * duplicate arriving after its last fragment must still be relabelled.
+ *
+ * After every step each session must be in the hash bucket of its key, and a
+ * look-up must agree with a walk of the session list. A fragment that goes
+ * to reassembly must leave a session for its datagram behind, evicting the
+ * oldest session if they are all busy. With CIPV6_REASSEMBLY_BUFFER_SIZE set,
+ * the pool and the sessions that took from it must add up to the session
+ * limit.
+ *
+ * Usage: cipv6_fragmenter_test [sessions] [datagrams in flight] [flow limit] [datagrams] [fail every nth alloc]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* The session and flow tables are static in cipv6_fragmenter.c */
+#include "../../../source/6LoWPAN/Fragmentation/cipv6_fragmenter.c"
+
+#include "host_stubs.h"
+
+#define TEST_INTERFACE 1
+#define TEST_TIMEOUT 60
+#define TEST_NEIGHBOURS 24
+#define TEST_MAX_FLIGHT 64
+#define TEST_MAX_FRAGMENTS 96
+
+typedef struct {
+    sockaddr_t src_sa;
+    uint16_t next_tag;
+    uint16_t last_size;
+    bool tag_reused;
+} test_neighbour_t;
+
+typedef struct {
+    bool active;
+    bool reassembling;      /* A fragment has gone to reassembly */
+    bool forwarded;         /* The first fragment has been forwarded */
+    bool delivered;
+    test_neighbour_t *neighbour;
+    sockaddr_t dst_sa;
+    uint16_t tag;
+    uint16_t out_tag;
+    uint16_t size;          /* Uncompressed, as in the fragment headers */
+    uint8_t pattern;
+    uint8_t fragments;
+    uint8_t sent;           /* Fragments of order[] sent so far */
+    uint16_t offset[TEST_MAX_FRAGMENTS + 1]; /* Uncompressed start of each fragment, and size */
+    uint8_t order[TEST_MAX_FRAGMENTS];
+    uint8_t data[2048];     /* 6LoWPAN form */
+} test_datagram_t;
+
+static protocol_interface_info_entry_t test_interface;
+static test_neighbour_t test_neighbour[TEST_NEIGHBOURS];
+static test_datagram_t test_flight[TEST_MAX_FLIGHT];
+static bool test_strict;
+static int test_sessions;
+static int test_flow_limit;
+static int test_forwarding;     /* Forwarded datagrams whose last fragment is still to come */
+static int test_forwarded;
+static int test_forwarded_cb;   /* Calls of the interface forwarding callback */
+static int test_reassembled;
+
+static void test_fail(const char *what, int round)
+{
+    printf("FAIL: %s in round %d\n", what, round);
+    exit(1);
+}
+
+static void test_forwarding_out_cb(protocol_interface_info_entry_t *cur, buffer_t *buf)
+{
+    (void) buf;
+    if (cur != &test_interface) {
+        test_fail("forwarding callback for another interface", test_forwarded);
+    }
+    test_forwarded_cb++;
+}
+
+static void test_address(sockaddr_t *sa, int i, bool long_address)
+{
+    memset(sa, 0, sizeof(sockaddr_t));
+    sa->addr_type = long_address ? ADDR_802_15_4_LONG : ADDR_802_15_4_SHORT;
+    if (long_address) {
+        sa->address[2] = 0x02;
+        sa->address[3] = 0x12;
+        sa->address[4] = 0x4b;
+        sa->address[8] = i >> 8;
+        sa->address[9] = i;
+    } else {
+        sa->address[2] = i >> 8;
+        sa->address[3] = i;
+    }
+}
+
+/* The same link may be heard under either PAN ID - the sessions ignore it */
+static void test_pan_id(sockaddr_t *sa)
+{
+    uint16_t pan_id = rand() % 2 ? 0xabcd : 0x1234;
+    sa->address[0] = pan_id >> 8;
+    sa->address[1] = pan_id;
+}
+
+static void test_neighbours_init(void)
+{
+    for (int i = 0; i < TEST_NEIGHBOURS; i++) {
+        test_address(&test_neighbour[i].src_sa, 0x100 + i, i % 2);
+        test_neighbour[i].next_tag = rand();
+    }
+}
+
+static uint16_t test_lowpan_offset(const test_datagram_t *d, int fragment)
+{
+    return fragment ? d->offset[fragment] - d->pattern : 0;
+}
+
+static uint16_t test_lowpan_length(const test_datagram_t *d, int fragment)
+{
+    return d->offset[fragment + 1] - d->pattern - test_lowpan_offset(d, fragment);
+}
+
+static void test_datagram_start(test_datagram_t *d)
+{
+    int route = rand() % 20;
+
+    memset(d, 0, sizeof(test_datagram_t));
+    d->active = true;
+    d->neighbour = &test_neighbour[rand() % TEST_NEIGHBOURS];
+    test_address(&d->dst_sa, HOST_OWN_SHORT, rand() % 2);
+    d->pattern = rand() % 41;
+    d->size = d->pattern + HOST_IPHC_SIZE + 1 + rand() % (rand() % 16 ? 1280 : 2047);
+
+    /* Every fragment but the last ends on a multiple of 8, and the first
+     * holds at least the header.
+     */
+    uint16_t end = 8 * (3 + rand() % 23);
+    if (end < d->pattern + HOST_IPHC_SIZE) {
+        end = (d->pattern + HOST_IPHC_SIZE + 7) & ~7;
+    }
+    if (d->size > 2047) {
+        d->size = 2047;
+    }
+    if (end >= d->size) {
+        d->size = end + 1 + rand() % 64;
+    }
+
+    /* Now and then a neighbour uses its last tag again, as after a reset.
+     * Only the size then tells the datagrams apart.
+     */
+    test_neighbour_t *neighbour = d->neighbour;
+    if (!neighbour->tag_reused && rand() % 8 == 0) {
+        if (d->size == neighbour->last_size) {
+            d->size += d->size < 2047 ? 1 : -1;
+        }
+        d->tag = neighbour->next_tag - 1;
+        neighbour->tag_reused = true;
+    } else {
+        d->tag = neighbour->next_tag++;
+        neighbour->tag_reused = false;
+    }
+    neighbour->last_size = d->size;
+    while (end < d->size) {
+        d->offset[++d->fragments] = end;
+        end += 8 * (3 + rand() % 23);
+    }
+    d->offset[++d->fragments] = d->size;
+
+    for (int i = 0; i < d->fragments; i++) {
+        d->order[i] = i;
+    }
+    if (d->fragments > 2 && rand() % 4 == 0) {
+        int i = rand() % (d->fragments - 2);
+        d->order[i] = i + 1;
+        d->order[i + 1] = i;
+    }
+
+    for (int i = 0; i < d->size - d->pattern; i++) {
+        d->data[i] = rand();
+    }
+    d->data[0] = LOWPAN_DISPATCH_IPHC | (d->data[0] & ~LOWPAN_DISPATCH_IPHC_MASK);
+    d->data[1] = route < 6 ? HOST_ROUTE_LOCAL : route == 6 ? HOST_ROUTE_MESH : route == 7 ? HOST_ROUTE_TOO_BIG : 1 + rand() % 200;
+    d->data[2] = d->pattern;
+}
+
+static buffer_t *test_fragment(const test_datagram_t *d, int fragment)
+{
+    unsigned fail_every = host_alloc_fail_every;
+    uint16_t length = test_lowpan_length(d, fragment);
+
+    host_alloc_fail_every = 0;
+    buffer_t *buf = buffer_get(5 + length);
+    host_alloc_fail_every = fail_every;
+
+    uint8_t *ptr = buffer_data_pointer(buf);
+    *ptr++ = (fragment ? LOWPAN_FRAGN : LOWPAN_FRAG1) | d->size >> 8;
+    *ptr++ = d->size;
+    ptr = common_write_16_bit(d->tag, ptr);
+    if (fragment) {
+        *ptr++ = d->offset[fragment] >> 3;
+    }
+    memcpy(ptr, d->data + test_lowpan_offset(d, fragment), length);
+    buffer_data_end_set(buf, ptr + length);
+
+    buf->src_sa = d->neighbour->src_sa;
+    buf->dst_sa = d->dst_sa;
+    test_pan_id(&buf->src_sa);
+    test_pan_id(&buf->dst_sa);
+    buf->interface = &test_interface;
+    buf->info = (buffer_info_t)(B_DIR_UP | B_FROM_MAC | B_TO_FRAGMENTATION);
+    return buf;
+}
+
+static bool test_forwardable(const test_datagram_t *d)
+{
+    return d->data[1] != HOST_ROUTE_LOCAL && d->data[1] != HOST_ROUTE_MESH && d->data[1] != HOST_ROUTE_TOO_BIG;
+}
+
+static void test_relabelled(const test_datagram_t *d, int fragment, buffer_t *buf, int round)
+{
+    const uint8_t *ptr = buffer_data_pointer(buf);
+    uint16_t header = fragment ? 5 : 4;
+    uint16_t length = test_lowpan_length(d, fragment);
+
+    if (buf->info != (buffer_info_t)(B_DIR_DOWN | B_FROM_FRAGMENTATION | B_TO_MAC)) {
+        test_fail("forwarded fragment not for the MAC", round);
+    }
+    if (buf->dst_sa.addr_type != ADDR_802_15_4_SHORT || buf->dst_sa.address[2] || buf->dst_sa.address[3] != d->data[1] ||
+            buf->src_sa.addr_type != ADDR_802_15_4_SHORT || common_read_16_bit(buf->src_sa.address + 2) != HOST_OWN_SHORT) {
+        test_fail("forwarded fragment has wrong link addresses", round);
+    }
+    if (buffer_data_length(buf) != header + length ||
+            ptr[0] != ((fragment ? LOWPAN_FRAGN : LOWPAN_FRAG1) | d->size >> 8) || ptr[1] != (d->size & 0xff) ||
+            common_read_16_bit(ptr + 2) != d->out_tag || (fragment && ptr[4] != d->offset[fragment] >> 3)) {
+        test_fail("forwarded fragment has wrong header", round);
+    }
+    if (memcmp(ptr + header, d->data + test_lowpan_offset(d, fragment), length)) {
+        test_fail("forwarded fragment payload changed", round);
+    }
+}
+
+static bool test_address_equal(const sockaddr_t *a, const sockaddr_t *b)
+{
+    return a->addr_type == b->addr_type && !memcmp(a->address + 2, b->address + 2, addr_len_from_type(a->addr_type) - 2);
+}
+
+static reassembly_entry_t *test_session_walk(const buffer_t *key, uint16_t tag, uint16_t size)
+{
+    reassembly_interface_t *interface_ptr = reassembly_interface_discover(TEST_INTERFACE);
+
+    ns_list_foreach(reassembly_entry_t, entry, &interface_ptr->rx_list) {
+        if (entry->tag == tag && entry->size == size &&
+                test_address_equal(&entry->buf->src_sa, &key->src_sa) && test_address_equal(&entry->buf->dst_sa, &key->dst_sa)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+/* Hash look-up of a session, from either PAN ID */
+static reassembly_entry_t *test_session_find(const sockaddr_t *src_sa, const sockaddr_t *dst_sa, uint16_t tag, uint16_t size, int round)
+{
+    static buffer_t key;
+    reassembly_interface_t *interface_ptr = reassembly_interface_discover(TEST_INTERFACE);
+
+    key.src_sa = *src_sa;
+    key.dst_sa = *dst_sa;
+    test_pan_id(&key.src_sa);
+    test_pan_id(&key.dst_sa);
+    reassembly_entry_t *entry = reassembly_already_action(interface_ptr, &key, tag, size, reassembly_hash(&key, tag, size));
+    if (entry != test_session_walk(&key, tag, size)) {
+        test_fail("session look-up differs from list walk", round);
+    }
+    return entry;
+}
+
+static void test_send(test_datagram_t *d, int fragment, int round)
+{
+    reassembly_interface_t *interface_ptr = reassembly_interface_discover(TEST_INTERFACE);
+    bool must_forward = test_strict && !fragment && !d->reassembling && !d->forwarded &&
+                        test_forwardable(d) && test_forwarding < test_flow_limit;
+
+    /* The session a new one would evict */
+    reassembly_entry_t *oldest = NULL;
+    sockaddr_t oldest_src_sa, oldest_dst_sa;
+    uint16_t oldest_tag, oldest_size;
+    if (!test_session_find(&d->neighbour->src_sa, &d->dst_sa, d->tag, d->size, round) &&
+            ns_list_is_empty(&interface_ptr->free_list)) {
+        oldest = ns_list_get_last(&interface_ptr->rx_list);
+        oldest_src_sa = oldest->buf->src_sa;
+        oldest_dst_sa = oldest->buf->dst_sa;
+        oldest_tag = oldest->tag;
+        oldest_size = oldest->size;
+    }
+
+    buffer_t *buf = cipv6_frag_reassembly(TEST_INTERFACE, test_fragment(d, fragment));
+    if (!buf && !d->forwarded && !host_alloc_fail_every) {
+        if (!test_session_find(&d->neighbour->src_sa, &d->dst_sa, d->tag, d->size, round)) {
+            test_fail("fragment left no session", round);
+        }
+        if (oldest && test_session_find(&oldest_src_sa, &oldest_dst_sa, oldest_tag, oldest_size, round)) {
+            test_fail("oldest session not evicted", round);
+        }
+    }
+    if (!buf) {
+        if (must_forward) {
+            test_fail("first fragment not forwarded", round);
+        }
+        if (d->forwarded && fragment) {
+            test_fail("fragment of forwarded datagram not relabelled", round);
+        }
+        if (!d->forwarded) {
+            d->reassembling = true;
+        }
+        return;
+    }
+
+    if ((buf->info & B_DIR_MASK) == B_DIR_UP) {
+        if (d->forwarded || d->delivered || (test_strict && d->sent + 1 < d->fragments)) {
+            test_fail("datagram reassembled unexpectedly", round);
+        }
+        if (buffer_data_length(buf) != d->size - d->pattern || memcmp(buffer_data_pointer(buf), d->data, d->size - d->pattern)) {
+            test_fail("reassembled datagram differs", round);
+        }
+        d->delivered = true;
+        test_reassembled++;
+    } else if (!fragment) {
+        if (d->forwarded || !test_forwardable(d) || (test_strict && d->reassembling)) {
+            test_fail("first fragment forwarded unexpectedly", round);
+        }
+        d->forwarded = true;
+        d->out_tag = common_read_16_bit(buffer_data_pointer(buf) + 2);
+        test_relabelled(d, fragment, buf, round);
+        test_forwarding++;
+        test_forwarded++;
+        if (test_forwarded_cb != test_forwarded) {
+            test_fail("forwarding callback not called once per forwarded datagram", round);
+        }
+    } else {
+        if (!d->forwarded) {
+            test_fail("fragment relabelled without a flow", round);
+        }
+        test_relabelled(d, fragment, buf, round);
+    }
+    buffer_free(buf);
+}
+
+static void test_tables_valid(int round)
+{
+    reassembly_interface_t *interface_ptr = reassembly_interface_discover(TEST_INTERFACE);
+
+    if (ns_list_count(&interface_ptr->rx_list) + ns_list_count(&interface_ptr->free_list) != test_sessions) {
+        test_fail("reassembly session lost", round);
+    }
+
+    uint_fast16_t hashed = 0;
+    for (uint_fast16_t i = 0; i <= interface_ptr->hash_mask; i++) {
+        for (reassembly_entry_t *entry = interface_ptr->hash_table[i]; entry; entry = entry->hash_next) {
+            if (entry->hash != reassembly_hash(entry->buf, entry->tag, entry->size) || (entry->hash & interface_ptr->hash_mask) != i) {
+                test_fail("session in wrong hash bucket", round);
+            }
+            hashed++;
+        }
+    }
+    if (hashed != ns_list_count(&interface_ptr->rx_list)) {
+        test_fail("hash does not match session list", round);
+    }
+    ns_list_foreach(reassembly_entry_t, entry, &interface_ptr->rx_list) {
+        if (test_session_find(&entry->buf->src_sa, &entry->buf->dst_sa, entry->tag, entry->size, round) != entry) {
+            test_fail("session not found", round);
+        }
+    }
+
+    int pooled = ns_list_count(&interface_ptr->buffer_pool);
+    if (pooled != interface_ptr->buffer_pool_count || pooled > interface_ptr->buffer_pool_limit) {
+        test_fail("buffer pool count wrong", round);
+    }
+    if (CIPV6_REASSEMBLY_BUFFER_SIZE && !host_alloc_fail_every) {
+        ns_list_foreach(reassembly_entry_t, entry, &interface_ptr->rx_list) {
+            pooled += entry->size <= CIPV6_REASSEMBLY_BUFFER_SIZE;
+        }
+        if (pooled != test_sessions) {
+            test_fail("buffer pool not topped up", round);
+        }
+    }
+
+    if (ns_list_count(&interface_ptr->forward_list) + ns_list_count(&interface_ptr->forward_free_list) != test_flow_limit) {
+        test_fail("forwarding flow lost", round);
+    }
+
+    int forwarding = 0;
+    ns_list_foreach(forward_entry_t, entry, &interface_ptr->forward_list) {
+        forwarding += !entry->complete;
+        ns_list_foreach(forward_entry_t, other, &interface_ptr->forward_list) {
+            if (other != entry && other->out_tag == entry->out_tag) {
+                test_fail("forwarding flows share a tag", round);
+            }
+        }
+    }
+    if (forwarding != test_forwarding) {
+        test_fail("forwarding flows in progress differ", round);
+    }
+}
+
+/* Send the next fragment of a datagram, or a duplicate of one already sent */
+static void test_step(test_datagram_t *d, int round)
+{
+    if (d->sent && rand() % 16 == 0) {
+        test_send(d, d->order[rand() % d->sent], round);
+        return;
+    }
+
+    test_send(d, d->order[d->sent++], round);
+    if (d->sent < d->fragments) {
+        return;
+    }
+
+    if (d->forwarded) {
+        test_forwarding--;
+    }
+    if (test_strict && !d->forwarded && !d->delivered) {
+        test_fail("datagram lost", round);
+    }
+    if (d->forwarded && rand() % 4 == 0) {
+        test_send(d, 1 + rand() % (d->fragments - 1), round);
+    }
+    d->active = false;
+}
+
+int main(int argc, char *argv[])
+{
+    test_sessions = argc > 1 ? atoi(argv[1]) : 8;
+    int flight = argc > 2 ? atoi(argv[2]) : test_sessions;
+    test_flow_limit = argc > 3 ? atoi(argv[3]) : 4;
+    int datagrams = argc > 4 ? atoi(argv[4]) : 20000;
+    unsigned fail_every = argc > 5 ? atoi(argv[5]) : 0;
+
+    if (flight < 1 || flight > TEST_MAX_FLIGHT) {
+        printf("FAIL: %d datagrams in flight, at most %d\n", flight, TEST_MAX_FLIGHT);
+        return 1;
+    }
+    if (reassembly_interface_init(TEST_INTERFACE, test_sessions, TEST_TIMEOUT) < 0 ||
+            reassembly_interface_forwarding_set(TEST_INTERFACE, test_flow_limit) < 0) {
+        printf("FAIL: %d sessions and %d flows rejected\n", test_sessions, test_flow_limit);
+        return 1;
+    }
+
+    srand(1);
+    test_interface.id = TEST_INTERFACE;
+    test_interface.if_common_forwarding_out_cb = test_forwarding_out_cb;
+    test_neighbours_init();
+    test_strict = flight <= test_sessions && !fail_every;
+    host_alloc_fail_every = fail_every;
+
+    int started = 0;
+    int done = 0;
+    for (int round = 0; done < datagrams; round++) {
+        test_datagram_t *d = &test_flight[rand() % flight];
+        if (!d->active) {
+            if (started < datagrams) {
+                test_datagram_start(d);
+                started++;
+            }
+            continue;
+        }
+        test_step(d, round);
+        done += !d->active;
+        test_tables_valid(round);
+    }
+
+    reassembly_interface_t *interface_ptr = reassembly_interface_discover(TEST_INTERFACE);
+    cipv6_frag_timer(TEST_TIMEOUT);
+    if (ns_list_count(&interface_ptr->rx_list) || ns_list_count(&interface_ptr->forward_list)) {
+        test_fail("sessions left after the timeout", datagrams);
+    }
+    if (test_strict && (test_forwarded + test_reassembled != datagrams || host_stats[STATS_FRAG_RX_EVICT])) {
+        test_fail("datagrams lost", datagrams);
+    }
+    if (host_stats[STATS_FRAG_RX_EVICT] + host_stats[STATS_FRAG_RX_TIMEOUT] > host_stats[STATS_FRAG_RX_ERROR]) {
+        test_fail("evictions and timeouts not counted as errors", datagrams);
+    }
+    reassembly_interface_free(TEST_INTERFACE);
+
+    printf("OK: %d sessions, %d in flight, %d flows, failing alloc %u, pool %u: %d datagrams forwarded, %d reassembled, "
+           "%u evictions, %u timeouts\n", test_sessions, flight, test_flow_limit, fail_every, CIPV6_REASSEMBLY_BUFFER_SIZE,
+           test_forwarded, test_reassembled, (unsigned) host_stats[STATS_FRAG_RX_EVICT], (unsigned) host_stats[STATS_FRAG_RX_TIMEOUT]);
+    return 0;
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Timing and heap model of a datagram crossing a chain of relays, either
+ * reassembled and fragmented again at every relay, or forwarded fragment by
+ * fragment.
+ *
+ * Links run at 50 kbit/s with 40 bytes of MAC and PHY overhead a frame, and
+ * lose nothing. A relay is half duplex: it doesn't receive while it sends.
+ * Wi-SUN unicast goes out on the receiver's channel, so links further apart
+ * carry frames at the same time. The heap is what one relay holds for the
+ * datagram: a reassembly buffer, its session and a frame, or a flow entry
+ * and a frame, with the entries estimated for the 32-bit target.
+ *
+ * Usage: fragment_forwarding_model [datagram size] [fragment size]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MODEL_RATE_BPS      50000.0
+#define MODEL_FRAME_OVERHEAD 40
+#define MODEL_MAX_HOPS      8
+#define MODEL_MAX_FRAGMENTS 256
+#define MODEL_SESSION_SIZE  24      /* reassembly_entry_t */
+#define MODEL_FLOW_SIZE     64      /* forward_entry_t */
+
+static double model_frame_time(int payload)
+{
+    return (payload + MODEL_FRAME_OVERHEAD) * 8.0 / MODEL_RATE_BPS;
+}
+
+/* 6LoWPAN payload of a fragment: FRAG1 has a 4 byte header, FRAGN 5 */
+static int model_fragment_length(int datagram, int fragment_size, int fragment)
+{
+    int fragments = (datagram + fragment_size - 1) / fragment_size;
+    int length = fragment == fragments - 1 ? datagram - fragment * fragment_size : fragment_size;
+    return length + (fragment ? 5 : 4);
+}
+
+/* Every relay receives the whole datagram before sending any of it */
+static double model_reassembly_time(int datagram, int fragment_size, int hops)
+{
+    int fragments = (datagram + fragment_size - 1) / fragment_size;
+    double t = 0;
+
+    for (int hop = 0; hop < hops; hop++) {
+        for (int fragment = 0; fragment < fragments; fragment++) {
+            t += model_frame_time(model_fragment_length(datagram, fragment_size, fragment));
+        }
+    }
+    return t;
+}
+
+/* A relay sends a fragment once it has it, and neither it nor the next node
+ * is busy with another frame.
+ */
+static double model_forwarding_time(int datagram, int fragment_size, int hops)
+{
+    int fragments = (datagram + fragment_size - 1) / fragment_size;
+    double arrived[MODEL_MAX_HOPS][MODEL_MAX_FRAGMENTS];
+    double busy[MODEL_MAX_HOPS + 1] = {0};
+
+    for (int fragment = 0; fragment < fragments; fragment++) {
+        for (int hop = 0; hop < hops; hop++) {
+            double start = hop ? arrived[hop - 1][fragment] : 0;
+            if (start < busy[hop]) {
+                start = busy[hop];
+            }
+            if (start < busy[hop + 1]) {
+                start = busy[hop + 1];
+            }
+            double end = start + model_frame_time(model_fragment_length(datagram, fragment_size, fragment));
+            busy[hop] = busy[hop + 1] = end;
+            arrived[hop][fragment] = end;
+        }
+    }
+    return arrived[hops - 1][fragments - 1];
+}
+
+int main(int argc, char *argv[])
+{
+    int datagram = argc > 1 ? atoi(argv[1]) : 1280;
+    int fragment_size = argc > 2 ? atoi(argv[2]) : 200;
+
+    if (datagram < 1 || datagram > 2047 || fragment_size < 8 ||
+            (datagram + fragment_size - 1) / fragment_size > MODEL_MAX_FRAGMENTS) {
+        printf("datagram %d with fragments of %d not modelled\n", datagram, fragment_size);
+        return 1;
+    }
+
+    int reassembly_heap = 1 + ((datagram + 7) & ~7) + MODEL_SESSION_SIZE + fragment_size;
+    int forwarding_heap = MODEL_FLOW_SIZE + fragment_size + MODEL_FRAME_OVERHEAD;
+
+    printf("%d byte datagram, %d byte fragments, %.0f kbit/s\n", datagram, fragment_size, MODEL_RATE_BPS / 1000);
+    printf("hops  reassembly ms  forwarding ms  reassembly heap  forwarding heap\n");
+    for (int hops = 1; hops <= MODEL_MAX_HOPS; hops++) {
+        printf("%4d  %13.1f  %13.1f  %15d  %15d\n", hops,
+               model_reassembly_time(datagram, fragment_size, hops) * 1000,
+               model_forwarding_time(datagram, fragment_size, hops) * 1000,
+               hops > 1 ? reassembly_heap : 0, hops > 1 ? forwarding_heap : 0);
+    }
+    return 0;
+}
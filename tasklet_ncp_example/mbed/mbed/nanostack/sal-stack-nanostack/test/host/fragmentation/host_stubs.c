@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * The parts of the stack that cipv6_fragmenter.c and buffer_dyn.c call out
+ * to, reduced to one 6LoWPAN interface without a MAC. The IP forwarding
+ * decision and header compression follow the stand-in header described in
+ * host_stubs.h. The heap is the host malloc so that the sanitizers see
+ * every buffer, filled with garbage as the stack's own heap would be.
+ */
+
+#include "nsconfig.h"
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ns_types.h"
+#include "nsdynmemLIB.h"
+#include "Core/include/ns_address_internal.h"
+#include "Core/include/ns_buffer.h"
+#include "Core/include/ns_socket.h"
+#include "NWK_INTERFACE/Include/protocol.h"
+#include "NWK_INTERFACE/Include/protocol_stats.h"
+#include "6LoWPAN/IPHC_Decode/cipv6.h"
+#include "6LoWPAN/IPHC_Decode/iphc_decompress.h"
+#include "host_stubs.h"
+
+uint32_t host_stats[64];
+
+unsigned host_alloc_fail_every;
+
+static unsigned host_alloc_count;
+
+static uint16_t host_fragment_tag;
+
+void *ns_dyn_mem_alloc(ns_mem_block_size_t alloc_size)
+{
+    if (host_alloc_fail_every && ++host_alloc_count % host_alloc_fail_every == 0) {
+        return NULL;
+    }
+    void *block = malloc(alloc_size);
+    if (block) {
+        memset(block, 0xa5, alloc_size);
+    }
+    return block;
+}
+
+void *ns_dyn_mem_temporary_alloc(ns_mem_block_size_t alloc_size)
+{
+    return ns_dyn_mem_alloc(alloc_size);
+}
+
+void ns_dyn_mem_free(void *block)
+{
+    free(block);
+}
+
+void platform_enter_critical(void)
+{
+}
+
+void platform_exit_critical(void)
+{
+}
+
+void protocol_stats_update(nwk_stats_type_t type, uint16_t update_val)
+{
+    host_stats[type] += update_val;
+}
+
+socket_t *socket_reference(socket_t *socket)
+{
+    return socket;
+}
+
+socket_t *socket_dereference(socket_t *socket)
+{
+    (void) socket;
+    return NULL;
+}
+
+void socket_tx_buffer_event_and_free(buffer_t *buf, uint8_t status)
+{
+    (void) status;
+    buffer_free(buf);
+}
+
+uint8_t addr_len_from_type(addrtype_t addr_type)
+{
+    switch (addr_type) {
+        case ADDR_802_15_4_SHORT:
+            return 2 + 2;
+        case ADDR_802_15_4_LONG:
+            return 2 + 8;
+        case ADDR_EUI_48:
+            return 6;
+        case ADDR_IPV6:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+char *trace_sockaddr(const sockaddr_t *addr, bool panid_prefix)
+{
+    (void) addr;
+    (void) panid_prefix;
+    return "";
+}
+
+uint16_t iphc_header_scan(buffer_t *buf, uint16_t *uncompressed_size)
+{
+    *uncompressed_size = HOST_IPHC_SIZE + buffer_data_pointer(buf)[2];
+    return HOST_IPHC_SIZE;
+}
+
+buffer_t *iphc_decompress(const lowpan_context_list_t *context_list, buffer_t *buf)
+{
+    (void) context_list;
+    return buf;
+}
+
+buffer_t *ipv6_forwarding_first_fragment(buffer_t *buf, uint16_t datagram_size)
+{
+    (void) datagram_size;
+    if (buffer_data_pointer(buf)[1] == HOST_ROUTE_LOCAL) {
+        return buffer_free(buf);
+    }
+    buf->info = (buffer_info_t)(B_DIR_DOWN | B_FROM_IPV6_FWD | B_TO_IPV6_TXRX);
+    return buf;
+}
+
+buffer_t *lowpan_down(buffer_t *buf)
+{
+    uint8_t route = buffer_data_pointer(buf)[1];
+
+    buf->src_sa.addr_type = ADDR_802_15_4_SHORT;
+    buf->src_sa.address[0] = 0xab;
+    buf->src_sa.address[1] = 0xcd;
+    buf->src_sa.address[2] = HOST_OWN_SHORT >> 8;
+    buf->src_sa.address[3] = HOST_OWN_SHORT & 0xff;
+    buf->dst_sa.addr_type = ADDR_802_15_4_SHORT;
+    buf->dst_sa.address[0] = 0xab;
+    buf->dst_sa.address[1] = 0xcd;
+    buf->dst_sa.address[2] = 0;
+    buf->dst_sa.address[3] = route;
+    buf->info = (buffer_info_t)(B_DIR_DOWN | B_FROM_IPV6_TXRX | (route == HOST_ROUTE_MESH ? B_TO_MESH_ROUTING : B_TO_MAC));
+    return buf;
+}
+
+uint16_t lowpan_adaptation_fragment_tag_allocate(int8_t interface_id)
+{
+    (void) interface_id;
+    return host_fragment_tag++;
+}
+
+/* buf starts with the FRAG1 header */
+bool lowpan_adaptation_tx_fits_mtu(protocol_interface_info_entry_t *cur, buffer_t *buf)
+{
+    (void) cur;
+    return buffer_data_pointer(buf)[4 + 1] != HOST_ROUTE_TOO_BIG;
+}
+
+void ns_trace_printf(uint8_t dlevel, const char *grp, const char *fmt, ...)
+{
+    (void) dlevel;
+    (void) grp;
+    (void) fmt;
+}
+
+char *ns_trace_array(const uint8_t *buf, uint16_t len)
+{
+    (void) buf;
+    (void) len;
+    return "";
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOST_STUBS_H_
+#define HOST_STUBS_H_
+
+/* There is no header compression on the host. A datagram's 6LoWPAN form
+ * starts with a 3 byte stand-in for an IPHC header:
+ *
+ *   [0] LOWPAN_DISPATCH_IPHC
+ *   [1] route: HOST_ROUTE_LOCAL, HOST_ROUTE_MESH, HOST_ROUTE_TOO_BIG, or the
+ *       short address of the next hop
+ *   [2] bytes the IPv6 header is longer than this one, ie the "pattern"
+ *
+ * Decompression and recompression leave it as it is.
+ */
+#define HOST_IPHC_SIZE      3
+
+#define HOST_ROUTE_LOCAL    0x00    /* For us - reassembled */
+#define HOST_ROUTE_MESH     0xfe    /* Next hop needs a mesh header */
+#define HOST_ROUTE_TOO_BIG  0xff    /* Recompressed first fragment doesn't fit a frame */
+
+/* Our own link-layer address, as lowpan_down() uses it */
+#define HOST_OWN_SHORT      0x0001
+
+/* Indexed by nwk_stats_type_t */
+extern uint32_t host_stats[64];
+
+/* If set, every this many heap allocations fails */
+extern unsigned host_alloc_fail_every;
+
+#endif /* HOST_STUBS_H_ */
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Benchmark of reassembly with many datagrams in progress.
+ *
+ * The given number of neighbours each send a 1280 byte datagram in 200 byte
+ * fragments to an interface with as many reassembly sessions, all of their
+ * fragments interleaved, so that every fragment has to find its session
+ * among the others. The time per fragment includes making its buffer and
+ * freeing the reassembled datagrams. Only the public API is used, so this
+ * also builds against the list walk of older revisions.
+ *
+ * Usage: reassembly_bench [sessions] [rounds]
+ */
+
+#include "nsconfig.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ns_types.h"
+#include "common_functions.h"
+#include "Core/include/ns_address_internal.h"
+#include "Core/include/ns_buffer.h"
+#include "6LoWPAN/IPHC_Decode/cipv6.h"
+#include "6LoWPAN/Fragmentation/cipv6_fragmenter.h"
+#include "host_stubs.h"
+
+#define BENCH_INTERFACE 1
+#define BENCH_DATAGRAM 1280
+#define BENCH_FRAGMENT 200
+
+static double bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static buffer_t *bench_fragment(const sockaddr_t *src_sa, const sockaddr_t *dst_sa, const uint8_t *data, uint16_t tag, uint16_t offset)
+{
+    uint16_t length = offset + BENCH_FRAGMENT < BENCH_DATAGRAM ? BENCH_FRAGMENT : BENCH_DATAGRAM - offset;
+    buffer_t *buf = buffer_get(5 + length);
+    uint8_t *ptr = buffer_data_pointer(buf);
+
+    *ptr++ = (offset ? LOWPAN_FRAGN : LOWPAN_FRAG1) | BENCH_DATAGRAM >> 8;
+    *ptr++ = BENCH_DATAGRAM & 0xff;
+    ptr = common_write_16_bit(tag, ptr);
+    if (offset) {
+        *ptr++ = offset >> 3;
+    }
+    memcpy(ptr, data + offset, length);
+    buffer_data_end_set(buf, ptr + length);
+    buf->src_sa = *src_sa;
+    buf->dst_sa = *dst_sa;
+    buf->info = (buffer_info_t)(B_DIR_UP | B_FROM_MAC | B_TO_FRAGMENTATION);
+    return buf;
+}
+
+int main(int argc, char *argv[])
+{
+    static uint8_t data[BENCH_DATAGRAM];
+    int sessions = argc > 1 ? atoi(argv[1]) : 32;
+    int rounds = argc > 2 ? atoi(argv[2]) : 2000;
+    sockaddr_t *src_sa = calloc(sessions, sizeof(sockaddr_t));
+    sockaddr_t dst_sa = {.addr_type = ADDR_802_15_4_SHORT, .address = {0xab, 0xcd, HOST_OWN_SHORT >> 8, HOST_OWN_SHORT & 0xff}};
+
+    if (sessions < 1 || sessions > 255 || reassembly_interface_init(BENCH_INTERFACE, sessions, 60) < 0) {
+        printf("%d sessions rejected\n", sessions);
+        return 1;
+    }
+
+    srand(1);
+    for (int i = 0; i < BENCH_DATAGRAM; i++) {
+        data[i] = rand();
+    }
+    data[0] = LOWPAN_DISPATCH_IPHC;
+    data[1] = HOST_ROUTE_LOCAL;
+    data[2] = 0;
+    for (int i = 0; i < sessions; i++) {
+        src_sa[i].addr_type = ADDR_802_15_4_LONG;
+        src_sa[i].address[0] = 0xab;
+        src_sa[i].address[1] = 0xcd;
+        src_sa[i].address[2] = 0x02;
+        src_sa[i].address[3] = 0x12;
+        src_sa[i].address[4] = 0x4b;
+        src_sa[i].address[8] = rand();
+        src_sa[i].address[9] = rand();
+    }
+
+    long fragments = 0;
+    long reassembled = 0;
+    double t0 = bench_now_ns();
+    for (int round = 0; round < rounds; round++) {
+        for (uint16_t offset = 0; offset < BENCH_DATAGRAM; offset += BENCH_FRAGMENT) {
+            for (int i = 0; i < sessions; i++) {
+                buffer_t *buf = cipv6_frag_reassembly(BENCH_INTERFACE, bench_fragment(&src_sa[i], &dst_sa, data, round, offset));
+                if (buf) {
+                    buffer_free(buf);
+                    reassembled++;
+                }
+                fragments++;
+            }
+        }
+    }
+    double t1 = bench_now_ns();
+
+    if (reassembled != (long) rounds * sessions) {
+        printf("%ld of %ld datagrams reassembled\n", reassembled, (long) rounds * sessions);
+        return 1;
+    }
+    printf("%d sessions: %.1f ns per fragment\n", sessions, (t1 - t0) / fragments);
+
+    reassembly_interface_free(BENCH_INTERFACE);
+    free(src_sa);
+    return 0;
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Benchmark of Neighbour and Destination Cache look-ups on a full cache.
+ *
+ * The caches are filled with the given number of global addresses, then
+ * looked up in random order, as the forwarding path does for each packet.
+ * Only the public API is used, so this also builds against the list-only
+ * caches of older revisions.
+ *
+ * Usage: address_cache_bench [entries] [look-ups]
+ */
+
+#include "nsconfig.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ns_types.h"
+#include "ns_list.h"
+#include "Core/include/ns_address_internal.h"
+#include "ipv6_stack/ipv6_routing_table.h"
+#include "host_stubs.h"
+
+static double bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void bench_address(uint8_t address[16], int i)
+{
+    static const uint8_t prefix[8] = {0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01, 0x00, 0x00};
+
+    memcpy(address, prefix, 8);
+    address[8] = 0x02;
+    address[9] = 0x12;
+    address[10] = 0x4b;
+    address[11] = 0x00;
+    address[12] = 0x14;
+    address[13] = (i >> 16) & 0xff;
+    address[14] = (i >> 8) & 0xff;
+    address[15] = i & 0xff;
+}
+
+int main(int argc, char *argv[])
+{
+    static ipv6_neighbour_cache_t cache;
+    int entries = argc > 1 ? atoi(argv[1]) : 64;
+    int lookups = argc > 2 ? atoi(argv[2]) : 2000000;
+    uint8_t (*address)[16] = malloc(entries * sizeof(*address));
+    int *order = malloc(lookups * sizeof(int));
+
+    if (ipv6_neighbour_cache_configure(entries, entries - 1, entries - 2, 120) < 0 ||
+            ipv6_destination_cache_configure(entries, entries - 1, entries - 2, 120) < 0) {
+        printf("cache size %d rejected\n", entries);
+        return 1;
+    }
+
+    ns_list_init(&cache.list);
+    ipv6_neighbour_cache_init(&cache, 1);
+    host_neighbour_cache = &cache;
+
+    srand(1);
+    for (int i = 0; i < entries; i++) {
+        bench_address(address[i], i);
+        ipv6_neighbour_lookup_or_create(&cache, address[i]);
+        ipv6_destination_lookup_or_create(address[i], 1);
+    }
+    for (int i = 0; i < lookups; i++) {
+        order[i] = rand() % entries;
+    }
+
+    volatile uintptr_t sink = 0;
+    double t0 = bench_now_ns();
+    for (int i = 0; i < lookups; i++) {
+        sink += (uintptr_t) ipv6_neighbour_lookup(&cache, address[order[i]]);
+    }
+    double t1 = bench_now_ns();
+    for (int i = 0; i < lookups; i++) {
+        sink += (uintptr_t) ipv6_destination_lookup_or_create(address[order[i]], 1);
+    }
+    double t2 = bench_now_ns();
+
+    printf("%d entries: neighbour look-up %.1f ns, destination look-up %.1f ns\n", entries,
+           (t1 - t0) / lookups, (t2 - t1) / lookups);
+
+    free(order);
+    free(address);
+    return 0;
+}
@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Randomised test of the Neighbour and Destination Cache address hashes.
+ *
+ * Entries are created, looked up, registered, removed, flushed and garbage
+ * collected with the cache limits set to the given size. After every step
+ * each table must hold exactly the entries on its list, each in the bucket
+ * of its address, and a look-up must agree with a walk of the list. With a
+ * failing heap, tables that can't be allocated or grown must leave the
+ * look-ups working.
+ *
+ * Usage: address_cache_test [cache size] [rounds] [fail every nth alloc]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* The Destination Cache and its hash are static in ipv6_routing_table.c */
+#include "../../../source/ipv6_stack/ipv6_routing_table.c"
+
+#include "host_stubs.h"
+
+#define TEST_ADDRESSES 3000
+
+static uint8_t test_address[TEST_ADDRESSES][16];
+static ipv6_neighbour_cache_t test_cache;
+
+static void test_fail(const char *what, int round)
+{
+    printf("FAIL: %s in round %d\n", what, round);
+    exit(1);
+}
+
+/* Global addresses under a few prefixes, and some link-local ones */
+static void test_addresses_init(void)
+{
+    static const uint8_t prefix[][8] = {
+        {0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01, 0x00, 0x00},
+        {0x20, 0x01, 0x0d, 0xb8, 0x00, 0x02, 0x00, 0x00},
+        {0xfd, 0x00, 0x61, 0x6d, 0x00, 0x00, 0x00, 0x00},
+        {0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    };
+
+    for (int i = 0; i < TEST_ADDRESSES; i++) {
+        memcpy(test_address[i], prefix[i % 4], 8);
+        test_address[i][8] = 0x02;
+        test_address[i][9] = 0x12;
+        test_address[i][10] = 0x4b;
+        test_address[i][11] = 0x00;
+        test_address[i][12] = 0x14;
+        test_address[i][13] = (i >> 16) & 0xff;
+        test_address[i][14] = (i >> 8) & 0xff;
+        test_address[i][15] = i & 0xff;
+    }
+}
+
+static ipv6_neighbour_t *test_neighbour_walk(const uint8_t *address)
+{
+    ns_list_foreach(ipv6_neighbour_t, cur, &test_cache.list) {
+        if (addr_ipv6_equal(cur->ip_address, address)) {
+            return cur;
+        }
+    }
+    return NULL;
+}
+
+static bool test_neighbour_hash_valid(void)
+{
+    uint_fast16_t hashed = 0;
+
+    if (test_cache.num_entries != ns_list_count(&test_cache.list)) {
+        return false;
+    }
+    if (!test_cache.hash_table) {
+        return test_cache.hash_size == 0;
+    }
+    for (uint_fast16_t i = 0; i < test_cache.hash_size; i++) {
+        for (ipv6_neighbour_t *cur = test_cache.hash_table[i]; cur; cur = cur->hash_next) {
+            if (ipv6_addr_hash(cur->ip_address, test_cache.hash_size) != i) {
+                return false;
+            }
+            hashed++;
+        }
+    }
+    if (hashed != test_cache.num_entries) {
+        return false;
+    }
+    ns_list_foreach(ipv6_neighbour_t, cur, &test_cache.list) {
+        if (ipv6_neighbour_lookup(&test_cache, cur->ip_address) != cur) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static ipv6_destination_t *test_destination_walk(const uint8_t *address, int8_t interface_id)
+{
+    bool interface_specific = addr_ipv6_scope(address, NULL) <= IPV6_SCOPE_REALM_LOCAL;
+
+    ns_list_foreach(ipv6_destination_t, cur, &ipv6_destination_cache) {
+        if (addr_ipv6_equal(cur->destination, address) && (!interface_specific || cur->interface_id == interface_id)) {
+            return cur;
+        }
+    }
+    return NULL;
+}
+
+static bool test_destination_hash_valid(void)
+{
+    uint_fast16_t hashed = 0;
+
+    if (ipv6_destination_cache_count != ns_list_count(&ipv6_destination_cache)) {
+        return false;
+    }
+    if (!ipv6_destination_hash_table) {
+        return ipv6_destination_hash_size == 0;
+    }
+    for (uint_fast16_t i = 0; i < ipv6_destination_hash_size; i++) {
+        for (ipv6_destination_t *cur = ipv6_destination_hash_table[i]; cur; cur = cur->hash_next) {
+            if (ipv6_addr_hash(cur->destination, ipv6_destination_hash_size) != i) {
+                return false;
+            }
+            hashed++;
+        }
+    }
+    if (hashed != ipv6_destination_cache_count) {
+        return false;
+    }
+    ns_list_foreach(ipv6_destination_t, cur, &ipv6_destination_cache) {
+        if (ipv6_destination_find(cur->destination, cur->interface_id, cur->interface_id != -1) != cur) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void test_neighbour_round(int round)
+{
+    const uint8_t *address = test_address[rand() % TEST_ADDRESSES];
+    ipv6_neighbour_t *entry;
+
+    switch (rand() % 8) {
+        case 0:
+        case 1:
+        case 2:
+            entry = ipv6_neighbour_lookup_or_create(&test_cache, address);
+            if (!entry && host_alloc_fail_every) {
+                break;
+            }
+            if (!entry || !addr_ipv6_equal(entry->ip_address, address)) {
+                test_fail("neighbour create failed", round);
+            }
+            if (ns_list_get_first(&test_cache.list) != entry) {
+                test_fail("neighbour not moved to the front", round);
+            }
+            if (rand() % 4 == 0) {
+                ipv6_neighbour_set_state(&test_cache, entry, IP_NEIGHBOUR_STALE);
+            }
+            if (rand() % 16 == 0) {
+                entry->type = IP_NEIGHBOUR_REGISTERED;
+                entry->lifetime = rand() % 100 + 1;
+            }
+            break;
+        case 3:
+            entry = test_neighbour_walk(address);
+            if (entry) {
+                ipv6_neighbour_entry_remove(&test_cache, entry);
+            }
+            break;
+        case 4:
+            if (rand() % 200 == 0) {
+                ipv6_neighbour_cache_flush(&test_cache);
+            } else {
+                ipv6_neighbour_cache_slow_timer(&test_cache, rand() % 10);
+            }
+            break;
+        default:
+            if (ipv6_neighbour_lookup(&test_cache, address) != test_neighbour_walk(address)) {
+                test_fail("neighbour look-up differs from list walk", round);
+            }
+            break;
+    }
+
+    if (!test_neighbour_hash_valid()) {
+        test_fail("neighbour hash does not match list", round);
+    }
+}
+
+static void test_destination_round(int round)
+{
+    const uint8_t *address = test_address[rand() % TEST_ADDRESSES];
+    int8_t interface_id = rand() % 2 + 1;
+    ipv6_destination_t *entry;
+
+    switch (rand() % 8) {
+        case 0:
+        case 1:
+        case 2:
+            entry = ipv6_destination_lookup_or_create(address, interface_id);
+            if (!entry && host_alloc_fail_every) {
+                break;
+            }
+            if (!entry || !addr_ipv6_equal(entry->destination, address)) {
+                test_fail("destination create failed", round);
+            }
+            if (ns_list_get_first(&ipv6_destination_cache) != entry) {
+                test_fail("destination not moved to the front", round);
+            }
+            break;
+        case 3:
+            if (rand() % 100 == 0) {
+                ipv6_destination_cache_forced_gc(rand() % 4 == 0);
+            } else if (rand() % 50 == 0) {
+                ipv6_destination_cache_clean(interface_id);
+            } else {
+                ipv6_destination_cache_timer(rand() % 30);
+            }
+            break;
+        default:
+            if (ipv6_destination_lookup(address, interface_id) != test_destination_walk(address, interface_id)) {
+                test_fail("destination look-up differs from list walk", round);
+            }
+            break;
+    }
+
+    if (!test_destination_hash_valid()) {
+        test_fail("destination hash does not match list", round);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int size = argc > 1 ? atoi(argv[1]) : 64;
+    int rounds = argc > 2 ? atoi(argv[2]) : 500000;
+    host_alloc_fail_every = argc > 3 ? atoi(argv[3]) : 0;
+
+    if (ipv6_neighbour_cache_configure(size, size / 2, size / 4, 120) < 0 ||
+            ipv6_destination_cache_configure(size, size / 2, size / 4, 120) < 0) {
+        printf("FAIL: cache size %d rejected\n", size);
+        return 1;
+    }
+
+    srand(1);
+    test_addresses_init();
+    ns_list_init(&test_cache.list);
+    ipv6_neighbour_cache_init(&test_cache, 1);
+    host_neighbour_cache = &test_cache;
+
+    uint16_t neighbour_hash_max = 0;
+    uint16_t destination_hash_max = 0;
+    for (int round = 0; round < rounds; round++) {
+        test_neighbour_round(round);
+        test_destination_round(round);
+        if (test_cache.hash_size > neighbour_hash_max) {
+            neighbour_hash_max = test_cache.hash_size;
+        }
+        if (ipv6_destination_hash_size > destination_hash_max) {
+            destination_hash_max = ipv6_destination_hash_size;
+        }
+    }
+
+    ipv6_neighbour_cache_init(&test_cache, 1);
+    ipv6_destination_cache_forced_gc(true);
+    ns_dyn_mem_free(test_cache.hash_table);
+    ns_dyn_mem_free(ipv6_destination_hash_table);
+
+    printf("OK: cache size %d, %d rounds, failing alloc %u, hash sizes up to %u and %u\n", size, rounds,
+           host_alloc_fail_every, (unsigned) neighbour_hash_max, (unsigned) destination_hash_max);
+    return 0;
+}
@@ -0,0 +1,83 @@
+#!/bin/sh
+#
+# Builds and runs the host tests and benchmarks of the IPv6 routing table,
+# Neighbour Cache and Destination Cache, and the test of the DAO source route
+# paging of the NCP snapshot.
+#
+#   build.sh [git revision]
+#
+# With a git revision, the benchmarks are also built against the stack and
+# libservice of that revision, e.g. the list scans before the address hashes
+# and the prefix trie. Set CC and OUT to change the compiler and the build
+# directory.
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+STACK=$(cd "$HERE/../../.." && pwd)
+MBED=$(cd "$STACK/../.." && pwd)
+TI=$(cd "$MBED/../../ti_wisunfan/ti_wisunfan" && pwd)
+OUT=${OUT:-${TMPDIR:-/tmp}/ipv6_routing_table_test}
+CC=${CC:-cc}
+
+# Sources and include paths of a stack and libservice tree
+tree_flags()
+{
+    LIBSERVICE=$2/frameworks/nanostack-libservice
+    INC="-I$HERE -I$1/source -I$1/nanostack -I$1/nanostack/platform
+         -I$LIBSERVICE/mbed-client-libservice -I$LIBSERVICE/mbed-client-libservice/platform
+         -I$MBED/frameworks/mbed-client-randlib/mbed-client-randlib
+         -I$TI/mbed_port/mbednanostack2tirtos/platform -I$TI/mbed_config/ws_border_router"
+    SRC="$1/source/Service_Libs/fnv_hash/fnv_hash.c $LIBSERVICE/source/libList/ns_list.c
+         $LIBSERVICE/source/libBits/common_functions.c $LIBSERVICE/source/libip6string/ip6tos.c"
+}
+
+# Builds the benchmarks against a stack tree and runs them
+run_benches()
+{
+    $CC -std=gnu99 -O2 $INC -o "$OUT/address_cache_bench$2" \
+        "$HERE/address_cache_bench.c" "$HERE/host_stubs.c" "$1/source/ipv6_stack/ipv6_routing_table.c" $SRC
+    $CC -std=gnu99 -O2 $INC -o "$OUT/route_lookup_bench$2" \
+        "$HERE/route_lookup_bench.c" "$HERE/host_stubs.c" "$1/source/ipv6_stack/ipv6_routing_table.c" $SRC
+    for entries in 64 256 1024; do
+        "$OUT/address_cache_bench$2" $entries
+    done
+    for hosts in 100 2000; do
+        "$OUT/route_lookup_bench$2" $hosts
+    done
+}
+
+mkdir -p "$OUT"
+tree_flags "$STACK" "$MBED"
+
+$CC -std=gnu99 -O1 -g -fsanitize=address,undefined $INC -o "$OUT/address_cache_test" \
+    "$HERE/address_cache_test.c" "$HERE/host_stubs.c" $SRC
+"$OUT/address_cache_test" 64
+"$OUT/address_cache_test" 600 200000
+"$OUT/address_cache_test" 64 200000 3
+
+$CC -std=gnu99 -O1 -g -fsanitize=address,undefined $INC -o "$OUT/route_trie_test" \
+    "$HERE/route_trie_test.c" "$HERE/host_stubs.c" $SRC
+"$OUT/route_trie_test"
+
+# The DAO source route paging is only built for the NCP
+$CC -std=gnu99 -O1 -g -fsanitize=address,undefined -DWISUN_NCP_ENABLE $INC -o "$OUT/host_routes_test" \
+    "$HERE/host_routes_test.c" "$HERE/host_stubs.c" $SRC
+"$OUT/host_routes_test"
+
+echo "this tree:"
+run_benches "$STACK"
+
+if [ -n "$1" ]; then
+    TOP=$(git -C "$HERE" rev-parse --show-toplevel)
+    BASE=$OUT/$1
+    rm -rf "$BASE"
+    mkdir -p "$BASE"
+    git -C "$TOP" archive "$1" "$(git -C "$STACK" rev-parse --show-prefix)" \
+        "$(git -C "$MBED/frameworks/nanostack-libservice" rev-parse --show-prefix)" | tar -x -C "$BASE"
+    BASE_MBED=$BASE/$(git -C "$MBED" rev-parse --show-prefix)
+    BASE_STACK=$BASE_MBED/nanostack/sal-stack-nanostack
+    tree_flags "$BASE_STACK" "$BASE_MBED"
+    echo "$1:"
+    run_benches "$BASE_STACK" "_$1"
+fi
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Randomised test of the DAO source route snapshot the NCP sends to host.
+ *
+ * A border router table of DAO source routes, with routes of other sources
+ * mixed in, is read a page at a time with ipv6_route_table_get_host_routes().
+ * Between pages routes are added, refreshed and deleted, and routes are
+ * moved to the end of the table list as look-ups move them. Some pages are
+ * not confirmed as sent and must be read again. Every page must be as full
+ * as the routes still to be sent allow, and hold only routes that were in
+ * the table at the start and are still there, with their current lifetime,
+ * so a snapshot returns each route that stays in the table exactly once.
+ *
+ * Usage: host_routes_test [snapshots]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* The routing table is static in ipv6_routing_table.c */
+#include "../../../source/ipv6_stack/ipv6_routing_table.c"
+
+#include "host_stubs.h"
+
+#define TEST_TARGETS 40
+#define TEST_ROUTERS 3
+#define TEST_MAX_PAGE 16
+#define TEST_MAX_ROUTES (TEST_TARGETS * TEST_ROUTERS * 2)
+
+static ipv6_neighbour_cache_t test_cache;
+/* Routes of the snapshot still to be sent */
+static ipv6_route_host_info_t test_pending[TEST_MAX_ROUTES];
+static int test_pending_count;
+
+static void test_fail(const char *what, int round)
+{
+    printf("FAIL: %s in round %d\n", what, round);
+    exit(1);
+}
+
+static void test_route_key(const ipv6_route_t *route, ipv6_route_host_info_t *key)
+{
+    memset(key, 0, sizeof(*key));
+    bitcopy(key->prefix, route->prefix, route->prefix_len);
+    memcpy(key->next_hop, route->info.next_hop_addr, sizeof(key->next_hop));
+    key->prefix_len = route->prefix_len;
+    key->lifetime = route->lifetime;
+}
+
+static bool test_same_route(const ipv6_route_host_info_t *a, const ipv6_route_host_info_t *b)
+{
+    return a->prefix_len == b->prefix_len && memcmp(a->prefix, b->prefix, 16) == 0 &&
+           memcmp(a->next_hop, b->next_hop, 16) == 0;
+}
+
+/* DAO source route of the table with the key, or NULL */
+static ipv6_route_t *test_table_route(const ipv6_route_host_info_t *key)
+{
+    ipv6_route_node_t *node = ipv6_route_trie_find(key->prefix, key->prefix_len);
+
+    if (!node) {
+        return NULL;
+    }
+    ns_list_foreach(ipv6_route_t, route, &node->routes) {
+        if (route->info.source == ROUTE_RPL_DAO_SR && route->prefix_len == key->prefix_len &&
+                memcmp(route->info.next_hop_addr, key->next_hop, 16) == 0) {
+            return route;
+        }
+    }
+    return NULL;
+}
+
+static int test_pending_find(const ipv6_route_host_info_t *key)
+{
+    for (int i = 0; i < test_pending_count; i++) {
+        if (test_same_route(&test_pending[i], key)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void test_pending_remove(int i)
+{
+    test_pending[i] = test_pending[--test_pending_count];
+}
+
+/* /128 targets and a few /64s behind three parents, and other routes to the same prefixes */
+static void test_table_change(void)
+{
+    uint8_t prefix[16] = {0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01};
+    uint8_t next_hop[16] = {0xfe, 0x80, 0, 0, 0, 0, 0, 0, 0x02, 0x12, 0x4b};
+    uint8_t prefix_len = rand() % 8 ? 128 : 64;
+    ipv6_route_src_t source = rand() % 8 ? ROUTE_RPL_DAO_SR : ROUTE_STATIC;
+    int target = rand() % TEST_TARGETS;
+
+    next_hop[15] = 1 + rand() % TEST_ROUTERS;
+    if (prefix_len == 64) {
+        prefix[7] = target;
+    } else {
+        prefix[14] = target >> 4;
+        prefix[15] = target;
+    }
+
+    switch (rand() % 4) {
+        case 0:
+            ipv6_route_delete(prefix, prefix_len, 1, next_hop, source);
+            break;
+        case 1: {
+            // look-ups move routes to the end of the table list, the one at the snapshot position included
+            if (ipv6_route_host_cursor && rand() % 2) {
+                ipv6_route_move_to_end(ipv6_route_host_cursor);
+                break;
+            }
+            int skip = ns_list_count(&ipv6_routing_table) ? rand() % ns_list_count(&ipv6_routing_table) : 0;
+            ns_list_foreach(ipv6_route_t, route, &ipv6_routing_table) {
+                if (skip-- == 0) {
+                    ipv6_route_move_to_end(route);
+                    break;
+                }
+            }
+            break;
+        }
+        default:
+            ipv6_route_add(prefix, prefix_len, 1, next_hop, source, 1 + rand() % 10000, 0);
+            break;
+    }
+
+    // a route deleted from the table is not sent, not even if it is added again
+    for (int i = test_pending_count - 1; i >= 0; i--) {
+        if (!test_table_route(&test_pending[i])) {
+            test_pending_remove(i);
+        }
+    }
+}
+
+static void test_snapshot(int round, long *pages)
+{
+    static ipv6_route_host_info_t page[TEST_MAX_PAGE + 1];
+
+    test_pending_count = 0;
+    ns_list_foreach(ipv6_route_t, route, &ipv6_routing_table) {
+        if (route->info.source == ROUTE_RPL_DAO_SR) {
+            test_route_key(route, &test_pending[test_pending_count++]);
+        }
+    }
+    ipv6_route_table_host_snapshot_start();
+
+    for (;;) {
+        uint16_t max_routes = 1 + rand() % TEST_MAX_PAGE;
+        uint16_t expected = test_pending_count < max_routes ? test_pending_count : max_routes;
+        bool sent = rand() % 4;
+
+        // guard entry past the page must be left alone
+        memset(&page[max_routes], 0xa5, sizeof(page[0]));
+        uint16_t count = ipv6_route_table_get_host_routes(page, max_routes);
+        if (count != expected) {
+            test_fail("page has the wrong number of routes", round);
+        }
+        for (uint16_t i = 0; i < count; i++) {
+            if (test_pending_find(&page[i]) < 0) {
+                test_fail("page has a route not to be sent", round);
+            }
+            if (page[i].lifetime != test_table_route(&page[i])->lifetime) {
+                test_fail("page has an old lifetime", round);
+            }
+            for (uint16_t other = 0; other < i; other++) {
+                if (test_same_route(&page[i], &page[other])) {
+                    test_fail("route twice in a page", round);
+                }
+            }
+        }
+        for (unsigned i = 0; i < sizeof(page[0]); i++) {
+            if (((uint8_t *) &page[max_routes])[i] != 0xa5) {
+                test_fail("write past the page", round);
+            }
+        }
+        (*pages)++;
+
+        if (sent) {
+            ipv6_route_table_host_routes_sent(count);
+            for (uint16_t i = 0; i < count; i++) {
+                test_pending_remove(test_pending_find(&page[i]));
+            }
+            if (count < max_routes) {
+                return;
+            }
+        }
+
+        for (int changes = rand() % 4; changes > 0; changes--) {
+            test_table_change();
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int snapshots = argc > 1 ? atoi(argv[1]) : 3000;
+    long pages = 0;
+    int max_routes = 0;
+
+    ns_list_init(&test_cache.list);
+    ipv6_neighbour_cache_init(&test_cache, 1);
+    host_neighbour_cache = &test_cache;
+
+    srand(1);
+    for (int round = 0; round < snapshots; round++) {
+        for (int changes = rand() % 20; changes > 0; changes--) {
+            test_table_change();
+        }
+        ipv6_route_table_host_snapshot_start();
+        if (ipv6_route_table_get_host_routes(test_pending, 0) != 0) {
+            test_fail("routes returned for an empty page", round);
+        }
+        test_snapshot(round, &pages);
+        if ((int) ns_list_count(&ipv6_routing_table) > max_routes) {
+            max_routes = ns_list_count(&ipv6_routing_table);
+        }
+    }
+
+    ipv6_route_table_remove_interface(1);
+    ipv6_neighbour_cache_init(&test_cache, 1);
+
+    printf("OK: %d snapshots, %ld pages, up to %d routes\n", snapshots, pages, max_routes);
+    return 0;
+}
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * The parts of the stack that ipv6_routing_table.c calls out to, reduced to
+ * what a single interface with no link layer needs. The heap is the host
+ * malloc so that the sanitizers see every entry.
+ */
+
+#include "nsconfig.h"
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ns_types.h"
+#include "nsdynmemLIB.h"
+#include "randLIB.h"
+#include "Core/include/ns_address_internal.h"
+#include "ipv6_stack/ipv6_routing_table.h"
+#include "Common_Protocols/ipv6_constants.h"
+#include "Common_Protocols/ipv6_resolution.h"
+#include "Service_Libs/etx/etx.h"
+#include "host_stubs.h"
+
+const uint8_t ADDR_UNSPECIFIED[16];
+
+int protocol_core_buffers_in_event_queue;
+
+ipv6_neighbour_cache_t *host_neighbour_cache;
+
+unsigned host_alloc_fail_every;
+
+static unsigned host_alloc_count;
+
+void *ns_dyn_mem_alloc(ns_mem_block_size_t alloc_size)
+{
+    if (host_alloc_fail_every && ++host_alloc_count % host_alloc_fail_every == 0) {
+        return NULL;
+    }
+    return malloc(alloc_size);
+}
+
+void *ns_dyn_mem_temporary_alloc(ns_mem_block_size_t alloc_size)
+{
+    return ns_dyn_mem_alloc(alloc_size);
+}
+
+void ns_dyn_mem_free(void *block)
+{
+    free(block);
+}
+
+uint32_t randLIB_get_32bit(void)
+{
+    return ((uint32_t) rand() << 16) ^ (uint32_t) rand();
+}
+
+uint32_t randLIB_randomise_base(uint32_t base, uint16_t min_factor, uint16_t max_factor)
+{
+    (void) min_factor;
+    (void) max_factor;
+    return base;
+}
+
+uint8_t addr_len_from_type(addrtype_t addr_type)
+{
+    switch (addr_type) {
+        case ADDR_802_15_4_SHORT:
+            return 2 + 2;
+        case ADDR_802_15_4_LONG:
+            return 2 + 8;
+        case ADDR_EUI_48:
+            return 6;
+        case ADDR_IPV6:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+bool addr_is_ipv6_link_local(const uint8_t addr[static 16])
+{
+    return addr[0] == 0xfe && (addr[1] & 0xc0) == 0x80;
+}
+
+uint_fast8_t addr_ipv6_scope(const uint8_t addr[static 16], const struct protocol_interface_info_entry *interface)
+{
+    (void) interface;
+    if (addr[0] == 0xff) {
+        return addr[1] & 0x0f;
+    }
+    if (addr_is_ipv6_link_local(addr)) {
+        return IPV6_SCOPE_LINK_LOCAL;
+    }
+    return IPV6_SCOPE_GLOBAL;
+}
+
+bool addr_ipv6_equal(const uint8_t a[static 16], const uint8_t b[static 16])
+{
+    return memcmp(a, b, 16) == 0;
+}
+
+ipv6_neighbour_cache_t *ipv6_neighbour_cache_by_interface_id(int8_t interface_id)
+{
+    if (host_neighbour_cache && host_neighbour_cache->interface_id == interface_id) {
+        return host_neighbour_cache;
+    }
+    return NULL;
+}
+
+void ipv6_interface_resolve_send_ns(ipv6_neighbour_cache_t *cache, ipv6_neighbour_t *entry, bool unicast, uint_fast8_t seq)
+{
+    (void) cache;
+    (void) entry;
+    (void) unicast;
+    (void) seq;
+}
+
+void ipv6_interface_resolution_failed(ipv6_neighbour_cache_t *cache, ipv6_neighbour_t *entry)
+{
+    (void) cache;
+    (void) entry;
+}
+
+void ipv6_send_queued(ipv6_neighbour_t *neighbour)
+{
+    (void) neighbour;
+}
+
+uint16_t ipv6_map_ip_to_ll_and_call_ll_addr_handler(struct protocol_interface_info_entry *cur, int8_t interface_id, ipv6_neighbour_t *n, const uint8_t ipaddr[16], ll_addr_handler_t *ll_addr_handler_ptr)
+{
+    (void) cur;
+    (void) interface_id;
+    (void) n;
+    (void) ipaddr;
+    (void) ll_addr_handler_ptr;
+    return 0;
+}
+
+uint16_t etx_read(int8_t interface_id, addrtype_t addr_type, const uint8_t *addr_ptr)
+{
+    (void) interface_id;
+    (void) addr_type;
+    (void) addr_ptr;
+    return 0;
+}
+
+void ns_trace_printf(uint8_t dlevel, const char *grp, const char *fmt, ...)
+{
+    (void) dlevel;
+    (void) grp;
+    (void) fmt;
+}
+
+void ns_trace_vprintf(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
+{
+    (void) dlevel;
+    (void) grp;
+    (void) fmt;
+    (void) ap;
+}
+
+char *ns_trace_ipv6(const void *addr_ptr)
+{
+    (void) addr_ptr;
+    return "";
+}
+
+#ifdef WISUN_NCP_ENABLE
+void nanostack_process_routing_table_update_from_stack(uint8_t changed_info, uint8_t *prefix, uint8_t len_prefix, uint8_t *addr_nexthop, uint32_t lifetime)
+{
+    (void) changed_info;
+    (void) prefix;
+    (void) len_prefix;
+    (void) addr_nexthop;
+    (void) lifetime;
+}
+#endif
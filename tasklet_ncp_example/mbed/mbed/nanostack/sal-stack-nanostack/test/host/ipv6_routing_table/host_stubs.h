@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOST_STUBS_H_
+#define HOST_STUBS_H_
+
+/* Returned by ipv6_neighbour_cache_by_interface_id() for its interface_id */
+extern struct ipv6_neighbour_cache *host_neighbour_cache;
+
+/* If set, every this many heap allocations fails */
+extern unsigned host_alloc_fail_every;
+
+#endif /* HOST_STUBS_H_ */
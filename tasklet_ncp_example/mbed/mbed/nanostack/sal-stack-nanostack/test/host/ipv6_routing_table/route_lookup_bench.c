@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Benchmark of routing table look-ups on a border router sized table.
+ *
+ * The table holds a default route, an on-link /64 and the given number of
+ * /128 host routes, as DAOs leave it on a root. Next hop look-ups go to
+ * random hosts, and exact look-ups are the ones a DAO refresh makes. Only
+ * the public API is used, so this also builds against the list scan of
+ * older revisions.
+ *
+ * Usage: route_lookup_bench [host routes] [look-ups]
+ */
+
+#include "nsconfig.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ns_types.h"
+#include "ns_list.h"
+#include "Core/include/ns_address_internal.h"
+#include "ipv6_stack/ipv6_routing_table.h"
+#include "host_stubs.h"
+
+static double bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main(int argc, char *argv[])
+{
+    static ipv6_neighbour_cache_t cache;
+    static const uint8_t prefix[16] = {0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01};
+    static const uint8_t router[16] = {0xfe, 0x80, 0, 0, 0, 0, 0, 0, 0x02, 0x12, 0x4b, 0, 0, 0, 0, 1};
+    int hosts = argc > 1 ? atoi(argv[1]) : 2000;
+    int lookups = argc > 2 ? atoi(argv[2]) : 200000;
+    uint8_t (*host)[16] = malloc(hosts * sizeof(*host));
+    int *order = malloc(lookups * sizeof(int));
+
+    ns_list_init(&cache.list);
+    ipv6_neighbour_cache_init(&cache, 1);
+    host_neighbour_cache = &cache;
+
+    srand(1);
+    ipv6_route_add(ADDR_UNSPECIFIED, 0, 1, router, ROUTE_STATIC, 0xffffffff, 0);
+    ipv6_route_add(prefix, 64, 1, NULL, ROUTE_STATIC, 0xffffffff, 0);
+    for (int i = 0; i < hosts; i++) {
+        memcpy(host[i], prefix, 16);
+        host[i][8] = 0x02;
+        host[i][9] = 0x12;
+        host[i][10] = 0x4b;
+        host[i][13] = (i >> 16) & 0xff;
+        host[i][14] = (i >> 8) & 0xff;
+        host[i][15] = i & 0xff;
+        if (!ipv6_route_add(host[i], 128, 1, router, ROUTE_STATIC, 0xffffffff, 0)) {
+            printf("route add failed\n");
+            return 1;
+        }
+    }
+    for (int i = 0; i < lookups; i++) {
+        order[i] = rand() % hosts;
+    }
+
+    volatile uintptr_t sink = 0;
+    double t0 = bench_now_ns();
+    for (int i = 0; i < lookups; i++) {
+        sink += (uintptr_t) ipv6_route_choose_next_hop(host[order[i]], -1, NULL);
+    }
+    double t1 = bench_now_ns();
+    for (int i = 0; i < lookups; i++) {
+        sink += (uintptr_t) ipv6_route_lookup_with_info(host[order[i]], 128, 1, router, ROUTE_STATIC, NULL, -1);
+    }
+    double t2 = bench_now_ns();
+
+    printf("%d host routes: next hop look-up %.1f ns, exact look-up %.1f ns\n", hosts,
+           (t1 - t0) / lookups, (t2 - t1) / lookups);
+
+    ipv6_route_table_remove_interface(1);
+    free(order);
+    free(host);
+    return 0;
+}
@@ -0,0 +1,389 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Randomised test of the routing table prefix trie.
+ *
+ * Routes of several sources, prefix lengths, next hops and metrics are added
+ * and deleted, and routers change reachability. After every change the trie
+ * must hold exactly the routes on ipv6_routing_table, each on the node of its
+ * prefix and in table order, with no node left that is neither a route nor a
+ * branch point. Look-ups for random destinations must pick the same route as
+ * the full table scan that the trie replaced, with and without predicates and
+ * skipped routes.
+ *
+ * Usage: route_trie_test [rounds]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* The routing table and its trie are static in ipv6_routing_table.c */
+#include "../../../source/ipv6_stack/ipv6_routing_table.c"
+
+#include "host_stubs.h"
+
+#define TEST_ROUTERS 8
+#define TEST_MAX_ROUTES 300
+
+static ipv6_neighbour_cache_t test_cache;
+static uint8_t test_router[TEST_ROUTERS][16];
+
+static const ipv6_route_src_t test_sources[] = {ROUTE_STATIC, ROUTE_RADV, ROUTE_USER, ROUTE_RPL_DAO};
+static const uint8_t test_prefix_lens[] = {0, 3, 16, 32, 48, 56, 64, 64, 64, 65, 96, 120, 127, 128, 128, 128};
+
+static void test_fail(const char *what, int round)
+{
+    printf("FAIL: %s in round %d\n", what, round);
+    exit(1);
+}
+
+/* ROUTE_USER routes with an odd source ID are never valid */
+static bool test_source_predicate(const ipv6_route_info_t *route, bool valid)
+{
+    return valid && !(route->source_id & 1);
+}
+
+/* Search-specific predicate that avoids one router */
+static bool test_search_predicate(const ipv6_route_info_t *route, bool valid)
+{
+    return valid && route->next_hop_addr[15] != 3;
+}
+
+/* Addresses cluster under a few prefixes so that routes nest and share branch points */
+static void test_random_address(uint8_t address[16])
+{
+    static const uint8_t base[][4] = {
+        {0x20, 0x01, 0x0d, 0xb8},
+        {0x20, 0x01, 0x0d, 0xb9},
+        {0xfd, 0x00, 0x00, 0x00},
+    };
+
+    memset(address, 0, 16);
+    memcpy(address, base[rand() % 3], 4);
+    for (int i = 4; i < 16; i++) {
+        if (rand() % 4 == 0) {
+            address[i] = rand() % 4 == 0 ? rand() : rand() % 4;
+        }
+    }
+}
+
+/* The look-up before the trie: a scan of the whole table */
+static ipv6_route_t *test_find_best_scan(const uint8_t *addr, int8_t interface_id, ipv6_route_predicate_fn_t *predicate)
+{
+    ipv6_route_t *best = NULL;
+
+    ns_list_foreach(ipv6_route_t, route, &ipv6_routing_table) {
+        if (route->search_skip) {
+            continue;
+        }
+        if (interface_id != -1 && interface_id != route->info.interface_id) {
+            continue;
+        }
+        if (!bitsequal(addr, route->prefix, route->prefix_len)) {
+            continue;
+        }
+        bool valid = true;
+        if (ipv6_route_predicate[route->info.source]) {
+            valid = ipv6_route_predicate[route->info.source](&route->info, valid);
+        }
+        if (predicate) {
+            valid = predicate(&route->info, valid);
+        }
+        if (!valid) {
+            continue;
+        }
+        if (!best || ipv6_route_is_better(route, best)) {
+            best = route;
+        }
+    }
+    return best;
+}
+
+/* The route ipv6_route_choose_next_hop() must return, using the table scan. Leaves search_skip set. */
+static ipv6_route_t *test_choose_next_hop_scan(const uint8_t *dest, int8_t interface_id, ipv6_route_predicate_fn_t *predicate)
+{
+    ipv6_route_t *best = NULL;
+
+    ns_list_foreach(ipv6_route_t, route, &ipv6_routing_table) {
+        if (bitsequal(dest, route->prefix, route->prefix_len)) {
+            route->search_skip = false;
+        }
+    }
+
+    for (;;) {
+        ipv6_route_t *route = test_find_best_scan(dest, interface_id, predicate);
+        bool reachable = true;
+        if (!route) {
+            break;
+        }
+        if (!route->on_link) {
+            ipv6_neighbour_cache_t *ncache = ipv6_neighbour_cache_by_interface_id(route->info.interface_id);
+            if (!ncache) {
+                route->search_skip = true;
+                continue;
+            }
+            if (ncache->probe_avoided_routers && ipv6_route_probing[route->info.source]) {
+                reachable = ipv6_neighbour_addr_is_probably_reachable(ncache, route->info.next_hop_addr);
+            }
+        }
+        if (reachable) {
+            return route;
+        }
+        route->search_skip = true;
+        if (!best) {
+            best = route;
+        }
+    }
+    return best;
+}
+
+/* Table routes sorted by address, with their table position, to check node order quickly */
+typedef struct test_route_pos {
+    const ipv6_route_t *route;
+    int pos;
+} test_route_pos_t;
+
+static test_route_pos_t test_table_pos[TEST_MAX_ROUTES];
+static int test_table_count;
+
+static int test_route_pos_compare(const void *a, const void *b)
+{
+    const ipv6_route_t *ra = ((const test_route_pos_t *) a)->route;
+    const ipv6_route_t *rb = ((const test_route_pos_t *) b)->route;
+    return ra < rb ? -1 : ra > rb;
+}
+
+static int test_route_pos(const ipv6_route_t *route)
+{
+    test_route_pos_t key = {route, 0};
+    test_route_pos_t *found = bsearch(&key, test_table_pos, test_table_count, sizeof key, test_route_pos_compare);
+    return found ? found->pos : -1;
+}
+
+/* Checks a subtree and returns the number of routes in it, or -1 if it is invalid */
+static int test_trie_check(const ipv6_route_node_t *node, const ipv6_route_node_t *parent, uint_fast8_t branch)
+{
+    if (!node) {
+        return 0;
+    }
+    if (parent && (node->prefix_len <= parent->prefix_len ||
+                   !bitsequal(node->prefix, parent->prefix, parent->prefix_len) ||
+                   ipv6_route_trie_bit(node->prefix, parent->prefix_len) != branch)) {
+        return -1;
+    }
+    for (uint_fast8_t bit = node->prefix_len; bit < 128; bit++) {
+        if (ipv6_route_trie_bit(node->prefix, bit)) {
+            return -1;
+        }
+    }
+    if (ns_list_is_empty(&node->routes) && !(node->child[0] && node->child[1])) {
+        return -1;
+    }
+
+    /* Node routes must be in the same order as in the table */
+    int count = 0;
+    int last_pos = -1;
+    ns_list_foreach(ipv6_route_t, route, &node->routes) {
+        int pos = test_route_pos(route);
+        if (route->node != node || route->prefix_len != node->prefix_len || pos <= last_pos) {
+            return -1;
+        }
+        last_pos = pos;
+        count++;
+    }
+
+    int left = test_trie_check(node->child[0], node, 0);
+    int right = test_trie_check(node->child[1], node, 1);
+    if (left < 0 || right < 0) {
+        return -1;
+    }
+    return count + left + right;
+}
+
+static bool test_trie_valid(void)
+{
+    test_table_count = 0;
+    ns_list_foreach(ipv6_route_t, route, &ipv6_routing_table) {
+        if (ipv6_route_trie_find(route->prefix, route->prefix_len) != route->node ||
+                !bitsequal(route->prefix, route->node->prefix, route->prefix_len)) {
+            return false;
+        }
+        test_table_pos[test_table_count].route = route;
+        test_table_pos[test_table_count].pos = test_table_count;
+        test_table_count++;
+    }
+    qsort(test_table_pos, test_table_count, sizeof test_table_pos[0], test_route_pos_compare);
+    return test_trie_check(ipv6_route_trie, NULL, 0) == test_table_count;
+}
+
+static void test_routers_init(void)
+{
+    ns_list_init(&test_cache.list);
+    ipv6_neighbour_cache_init(&test_cache, 1);
+    test_cache.probe_avoided_routers = true;
+    host_neighbour_cache = &test_cache;
+
+    for (int i = 0; i < TEST_ROUTERS; i++) {
+        static const uint8_t link_local[8] = {0xfe, 0x80};
+        memcpy(test_router[i], link_local, 8);
+        test_router[i][8] = 0x02;
+        test_router[i][15] = i;
+    }
+}
+
+static void test_router_change(void)
+{
+    static const ip_neighbour_cache_state_t states[] = {
+        IP_NEIGHBOUR_REACHABLE, IP_NEIGHBOUR_STALE, IP_NEIGHBOUR_PROBE, IP_NEIGHBOUR_UNREACHABLE,
+    };
+    const uint8_t *router = test_router[rand() % TEST_ROUTERS];
+
+    if (rand() % 3 == 0) {
+        ipv6_neighbour_t *entry = ipv6_neighbour_lookup(&test_cache, router);
+        if (entry) {
+            ipv6_neighbour_entry_remove(&test_cache, entry);
+        }
+    } else {
+        ipv6_neighbour_t *entry = ipv6_neighbour_lookup_or_create(&test_cache, router);
+        if (entry) {
+            ipv6_neighbour_set_state(&test_cache, entry, states[rand() % 4]);
+        }
+    }
+}
+
+static ipv6_route_t *test_random_route(void)
+{
+    ipv6_route_t *route = ns_list_get_first(&ipv6_routing_table);
+    for (int skip = rand() % 32; skip && ns_list_get_next(&ipv6_routing_table, route); skip--) {
+        route = ns_list_get_next(&ipv6_routing_table, route);
+    }
+    return route;
+}
+
+static void test_route_change(int round)
+{
+    uint8_t prefix[16];
+    uint8_t prefix_len = test_prefix_lens[rand() % sizeof(test_prefix_lens)];
+    ipv6_route_src_t source = test_sources[rand() % 4];
+    int8_t interface_id = rand() % 8 ? 1 : 2;
+    const uint8_t *next_hop = rand() % 4 ? test_router[rand() % TEST_ROUTERS] : NULL;
+    int routes = ns_list_count(&ipv6_routing_table);
+
+    test_random_address(prefix);
+    if (routes && rand() % 2) {
+        /* Reuse an existing prefix so that nodes collect several routes */
+        ipv6_route_t *route = test_random_route();
+        memset(prefix, 0, 16);
+        bitcopy(prefix, route->prefix, route->prefix_len);
+        prefix_len = route->prefix_len;
+    }
+
+    if (routes < TEST_MAX_ROUTES && rand() % (routes < TEST_MAX_ROUTES / 2 ? 4 : 2)) {
+        ipv6_route_t *route = ipv6_route_add_metric(prefix, prefix_len, interface_id, next_hop, source, NULL, rand() % 4,
+                                                    0xffffffff, rand() % 4 * 0x40);
+        if (!route) {
+            test_fail("route add failed", round);
+        }
+    } else if (routes) {
+        ipv6_route_t *route = test_random_route();
+        memset(prefix, 0, 16);
+        bitcopy(prefix, route->prefix, route->prefix_len);
+        if (ipv6_route_delete_with_info(prefix, route->prefix_len, route->info.interface_id,
+                                        route->on_link ? NULL : route->info.next_hop_addr, route->info.source,
+                                        NULL, route->info.source_id) < 0) {
+            test_fail("route delete failed", round);
+        }
+    }
+
+    if (!test_trie_valid()) {
+        test_fail("trie does not match routing table", round);
+    }
+}
+
+static void test_lookup(int round)
+{
+    uint8_t dest[16];
+    int8_t interface_id = rand() % 4 ? -1 : 1;
+    ipv6_route_predicate_fn_t *predicate = rand() % 4 ? NULL : test_search_predicate;
+
+    test_random_address(dest);
+    if (rand() % 2 && !ns_list_is_empty(&ipv6_routing_table)) {
+        /* Land inside an existing route, or just beside it */
+        ipv6_route_t *route = test_random_route();
+        bitcopy(dest, route->prefix, route->prefix_len);
+        if (route->prefix_len && rand() % 4 == 0) {
+            uint_fast8_t bit = rand() % route->prefix_len;
+            dest[bit >> 3] ^= 0x80 >> (bit & 7);
+        }
+    }
+
+    /* Random skip flags, as left by an earlier next hop search */
+    ns_list_foreach(ipv6_route_t, route, &ipv6_routing_table) {
+        route->search_skip = rand() % 8 == 0;
+    }
+    if (ipv6_route_find_best(dest, interface_id, predicate) != test_find_best_scan(dest, interface_id, predicate)) {
+        test_fail("best route differs from table scan", round);
+    }
+
+    ipv6_route_t *expected = test_choose_next_hop_scan(dest, interface_id, predicate);
+    if (ipv6_route_choose_next_hop(dest, interface_id, predicate) != expected) {
+        test_fail("next hop differs from table scan", round);
+    }
+    if (!test_trie_valid()) {
+        test_fail("trie out of table order after next hop search", round);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int rounds = argc > 1 ? atoi(argv[1]) : 100000;
+    int max_routes = 0;
+
+    srand(1);
+    test_routers_init();
+    ipv6_route_table_set_predicate_fn(ROUTE_USER, test_source_predicate);
+
+    for (int round = 0; round < rounds; round++) {
+        switch (rand() % 8) {
+            case 0:
+                test_router_change();
+                break;
+            case 1:
+            case 2:
+            case 3:
+                test_route_change(round);
+                break;
+            default:
+                test_lookup(round);
+                break;
+        }
+        if ((int) ns_list_count(&ipv6_routing_table) > max_routes) {
+            max_routes = ns_list_count(&ipv6_routing_table);
+        }
+    }
+
+    ipv6_route_table_remove_interface(1);
+    ipv6_route_table_remove_interface(2);
+    if (ipv6_route_trie) {
+        test_fail("trie not empty after removing all routes", rounds);
+    }
+    ipv6_neighbour_cache_init(&test_cache, 1);
+
+    printf("OK: %d rounds, up to %d routes\n", rounds, max_routes);
+    return 0;
+}
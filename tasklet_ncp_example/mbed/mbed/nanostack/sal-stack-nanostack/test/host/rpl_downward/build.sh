@@ -0,0 +1,69 @@
+#!/bin/sh
+#
+# Builds and runs the host test and benchmark of the DAO target index and the
+# incremental root path costs.
+#
+#   build.sh [git revision]
+#
+# With a git revision, the benchmark is also built against the stack and
+# libservice of that revision, e.g. the list scans and full path
+# recomputation before the index. Set CC and OUT to change the compiler and
+# the build directory.
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+STACK=$(cd "$HERE/../../.." && pwd)
+MBED=$(cd "$STACK/../.." && pwd)
+TI=$(cd "$MBED/../../ti_wisunfan/ti_wisunfan" && pwd)
+OUT=${OUT:-${TMPDIR:-/tmp}/rpl_downward_test}
+CC=${CC:-cc}
+
+# Sources and include paths of a stack and libservice tree
+tree_flags()
+{
+    LIBSERVICE=$2/frameworks/nanostack-libservice
+    INC="-I$HERE -I$1/source -I$1/nanostack -I$1/nanostack/platform
+         -I$LIBSERVICE/mbed-client-libservice -I$LIBSERVICE/mbed-client-libservice/platform
+         -I$MBED/frameworks/mbed-client-randlib/mbed-client-randlib
+         -I$MBED/nanostack/sal-stack-nanostack-eventloop/nanostack-event-loop
+         -I$TI/mbed_port/mbednanostack2tirtos/platform -I$TI/mbed_config/ws_border_router"
+    SRC="$1/source/Service_Libs/fnv_hash/fnv_hash.c $LIBSERVICE/source/libList/ns_list.c
+         $LIBSERVICE/source/libBits/common_functions.c $LIBSERVICE/source/libip6string/ip6tos.c"
+}
+
+# Builds the benchmark against a stack tree and runs it
+run_bench()
+{
+    $CC -std=gnu99 -O2 $INC -o "$OUT/rpl_downward_bench$2" \
+        "$HERE/rpl_downward_bench.c" "$HERE/host_stubs.c" $SRC
+    for nodes in 100 500 1000; do
+        "$OUT/rpl_downward_bench$2" $nodes
+    done
+}
+
+mkdir -p "$OUT"
+tree_flags "$STACK" "$MBED"
+
+$CC -std=gnu99 -O1 -g -fsanitize=address,undefined $INC -o "$OUT/rpl_downward_test" \
+    "$HERE/rpl_downward_test.c" "$HERE/host_stubs.c" $SRC
+"$OUT/rpl_downward_test" 20
+"$OUT/rpl_downward_test" 300
+"$OUT/rpl_downward_test" 300 100000 5
+
+echo "this tree:"
+run_bench "$STACK"
+
+if [ -n "$1" ]; then
+    TOP=$(git -C "$HERE" rev-parse --show-toplevel)
+    BASE=$OUT/$1
+    rm -rf "$BASE"
+    mkdir -p "$BASE"
+    git -C "$TOP" archive "$1" "$(git -C "$STACK" rev-parse --show-prefix)" \
+        "$(git -C "$MBED/frameworks/nanostack-libservice" rev-parse --show-prefix)" | tar -x -C "$BASE"
+    BASE_MBED=$BASE/$(git -C "$MBED" rev-parse --show-prefix)
+    BASE_STACK=$BASE_MBED/nanostack/sal-stack-nanostack
+    tree_flags "$BASE_STACK" "$BASE_MBED"
+    echo "$1:"
+    run_bench "$BASE_STACK" "_$1"
+fi
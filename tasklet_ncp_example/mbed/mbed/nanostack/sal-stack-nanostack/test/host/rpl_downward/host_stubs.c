@@ -0,0 +1,355 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * The parts of the stack that rpl_downward.c calls out to, reduced to what a
+ * non-storing DODAG root needs to keep its DAO targets and path costs. The
+ * heap is the host malloc so that the sanitizers see every target and
+ * transit. Nothing is transmitted and the routing table is not touched.
+ */
+
+#include "nsconfig.h"
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ns_types.h"
+#include "nsdynmemLIB.h"
+#include "randLIB.h"
+#include "Core/include/ns_address_internal.h"
+#include "NWK_INTERFACE/Include/protocol.h"
+#include "ipv6_stack/ipv6_routing_table.h"
+#include "Common_Protocols/icmpv6.h"
+#include "6LoWPAN/ws/ws_config.h"
+#include "net_rpl.h"
+#include "RPL/rpl_protocol.h"
+#include "RPL/rpl_policy.h"
+#include "RPL/rpl_upward.h"
+#include "RPL/rpl_control.h"
+#include "RPL/rpl_data.h"
+#include "host_stubs.h"
+
+const uint8_t ADDR_UNSPECIFIED[16];
+
+uint32_t protocol_core_monotonic_time;
+
+ti_wisun_config_t ti_wisun_config;
+
+uint8_t host_root_address[16];
+
+uint16_t host_root_neighbour_etx[256];
+
+unsigned host_alloc_fail_every;
+
+static unsigned host_alloc_count;
+
+void *ns_dyn_mem_alloc(ns_mem_block_size_t alloc_size)
+{
+    if (host_alloc_fail_every && ++host_alloc_count % host_alloc_fail_every == 0) {
+        return NULL;
+    }
+    return malloc(alloc_size);
+}
+
+void *ns_dyn_mem_temporary_alloc(ns_mem_block_size_t alloc_size)
+{
+    return ns_dyn_mem_alloc(alloc_size);
+}
+
+void ns_dyn_mem_free(void *block)
+{
+    free(block);
+}
+
+void *rpl_alloc(uint16_t size)
+{
+    return ns_dyn_mem_alloc(size);
+}
+
+void rpl_free(void *p, uint16_t size)
+{
+    (void) size;
+    ns_dyn_mem_free(p);
+}
+
+uint16_t randLIB_get_random_in_range(uint16_t min, uint16_t max)
+{
+    return min + rand() % (max - min + 1);
+}
+
+uint32_t randLIB_randomise_base(uint32_t base, uint16_t min_factor, uint16_t max_factor)
+{
+    (void) min_factor;
+    (void) max_factor;
+    return base;
+}
+
+bool addr_is_ipv6_link_local(const uint8_t addr[static 16])
+{
+    return addr[0] == 0xfe && (addr[1] & 0xc0) == 0x80;
+}
+
+bool addr_ipv6_equal(const uint8_t a[static 16], const uint8_t b[static 16])
+{
+    return memcmp(a, b, 16) == 0;
+}
+
+int8_t protocol_interface_address_compare(const uint8_t *addr)
+{
+    return addr_ipv6_equal(addr, host_root_address) ? 0 : -1;
+}
+
+protocol_interface_info_entry_t *protocol_stack_interface_info_get_by_id(int8_t nwk_id)
+{
+    (void) nwk_id;
+    return NULL;
+}
+
+protocol_interface_info_entry_t *protocol_stack_interface_info_get_by_rpl_domain(const struct rpl_domain *domain, int8_t last_id)
+{
+    (void) domain;
+    (void) last_id;
+    return NULL;
+}
+
+void protocol_push(buffer_t *buf)
+{
+    (void) buf;
+}
+
+buffer_t *icmpv6_build_ns(struct protocol_interface_info_entry *cur, const uint8_t target_addr[static 16], const uint8_t *prompting_src_addr, bool unicast, bool unspecified_source, const struct aro *aro)
+{
+    (void) cur;
+    (void) target_addr;
+    (void) prompting_src_addr;
+    (void) unicast;
+    (void) unspecified_source;
+    (void) aro;
+    return NULL;
+}
+
+void ipv6_neighbour_reachability_confirmation(const uint8_t ip_address[static 16], int8_t interface_id)
+{
+    (void) ip_address;
+    (void) interface_id;
+}
+
+void ipv6_neighbour_reachability_problem(const uint8_t ip_address[static 16], int8_t interface_id)
+{
+    (void) ip_address;
+    (void) interface_id;
+}
+
+ipv6_route_t *ipv6_route_add_with_info(const uint8_t *prefix, uint8_t prefix_len, int8_t interface_id, const uint8_t *next_hop, ipv6_route_src_t source, void *info, uint8_t source_id, uint32_t lifetime, int_fast8_t pref)
+{
+    (void) prefix;
+    (void) prefix_len;
+    (void) interface_id;
+    (void) next_hop;
+    (void) source;
+    (void) info;
+    (void) source_id;
+    (void) lifetime;
+    (void) pref;
+    return NULL;
+}
+
+ipv6_route_t *ipv6_route_lookup_with_info(const uint8_t *prefix, uint8_t prefix_len, int8_t interface_id, const uint8_t *next_hop, ipv6_route_src_t source, void *info, int_fast16_t source_id)
+{
+    (void) prefix;
+    (void) prefix_len;
+    (void) interface_id;
+    (void) next_hop;
+    (void) source;
+    (void) info;
+    (void) source_id;
+    return NULL;
+}
+
+int_fast8_t ipv6_route_delete_with_info(const uint8_t *prefix, uint8_t prefix_len, int8_t interface_id, const uint8_t *next_hop, ipv6_route_src_t source, void *info, int_fast16_t source_id)
+{
+    (void) prefix;
+    (void) prefix_len;
+    (void) interface_id;
+    (void) next_hop;
+    (void) source;
+    (void) info;
+    (void) source_id;
+    return -1;
+}
+
+void ipv6_route_table_remove_info(int8_t interface_id, ipv6_route_src_t source, void *info)
+{
+    (void) interface_id;
+    (void) source;
+    (void) info;
+}
+
+void rpl_control_event(struct rpl_domain *domain, rpl_event_t event)
+{
+    (void) domain;
+    (void) event;
+}
+
+bool rpl_control_transmit_dao(struct rpl_domain *domain, struct protocol_interface_info_entry *cur, struct rpl_instance *instance, uint8_t instance_id, uint8_t dao_sequence, const uint8_t dodagid[16], const uint8_t *opts, uint16_t opts_size, const uint8_t *dst)
+{
+    (void) domain;
+    (void) cur;
+    (void) instance;
+    (void) instance_id;
+    (void) dao_sequence;
+    (void) dodagid;
+    (void) opts;
+    (void) opts_size;
+    (void) dst;
+    return false;
+}
+
+void rpl_data_sr_invalidate(void)
+{
+}
+
+void rpl_delete_neighbour(rpl_instance_t *instance, rpl_neighbour_t *neighbour)
+{
+    (void) instance;
+    (void) neighbour;
+}
+
+bool rpl_dodag_am_root(const rpl_dodag_t *dodag)
+{
+    (void) dodag;
+    return true;
+}
+
+const rpl_dodag_conf_t *rpl_dodag_get_config(const rpl_dodag_t *dodag)
+{
+    (void) dodag;
+    return NULL;
+}
+
+uint8_t rpl_dodag_mop(const rpl_dodag_t *dodag)
+{
+    (void) dodag;
+    return RPL_MODE_NON_STORING;
+}
+
+bool rpl_instance_am_root(const rpl_instance_t *instance)
+{
+    (void) instance;
+    return true;
+}
+
+rpl_dodag_t *rpl_instance_current_dodag(const rpl_instance_t *instance)
+{
+    (void) instance;
+    return NULL;
+}
+
+void rpl_instance_increment_dtsn(rpl_instance_t *instance)
+{
+    (void) instance;
+}
+
+uint8_t rpl_instance_mop(const rpl_instance_t *instance)
+{
+    (void) instance;
+    return RPL_MODE_NON_STORING;
+}
+
+rpl_neighbour_t *rpl_instance_preferred_parent(const rpl_instance_t *instance)
+{
+    (void) instance;
+    return NULL;
+}
+
+uint16_t rpl_policy_address_registration_timeout()
+{
+    return 0;
+}
+
+int8_t rpl_policy_dao_retry_count()
+{
+    return 0;
+}
+
+bool rpl_policy_dao_trigger_after_srh_error(rpl_domain_t *domain, uint32_t seconds_since_last_dao_trigger, uint16_t errors_since_last_dao_trigger, uint_fast16_t targets)
+{
+    (void) domain;
+    (void) seconds_since_last_dao_trigger;
+    (void) errors_since_last_dao_trigger;
+    (void) targets;
+    return false;
+}
+
+uint16_t rpl_policy_initial_dao_ack_wait(const rpl_domain_t *domain, uint8_t mop)
+{
+    (void) domain;
+    (void) mop;
+    return 0;
+}
+
+uint16_t rpl_policy_minimum_dao_target_refresh(void)
+{
+    return 0;
+}
+
+uint16_t rpl_policy_modify_downward_cost_to_root_neighbour(rpl_domain_t *domain, int8_t if_id, const uint8_t *next_hop, uint16_t cost)
+{
+    (void) domain;
+    (void) if_id;
+    return cost + host_root_neighbour_etx[next_hop[15]];
+}
+
+bool rpl_policy_parent_confirmation_requested(void)
+{
+    return false;
+}
+
+/* DAO sequence numbers aren't exercised - these just keep their shape */
+uint8_t rpl_seq_init(void)
+{
+    return 256 - 16;
+}
+
+uint8_t rpl_seq_inc(uint8_t seq)
+{
+    return seq == 127 ? 0 : (uint8_t)(seq + 1);
+}
+
+rpl_cmp_t rpl_seq_compare(uint8_t a, uint8_t b)
+{
+    return a == b ? RPL_CMP_EQUAL : a > b ? RPL_CMP_GREATER : RPL_CMP_LESS;
+}
+
+void ns_trace_printf(uint8_t dlevel, const char *grp, const char *fmt, ...)
+{
+    (void) dlevel;
+    (void) grp;
+    (void) fmt;
+}
+
+char *ns_trace_ipv6(const void *addr_ptr)
+{
+    (void) addr_ptr;
+    return "";
+}
+
+char *ns_trace_ipv6_prefix(const uint8_t *prefix, uint8_t prefix_len)
+{
+    (void) prefix;
+    (void) prefix_len;
+    return "";
+}
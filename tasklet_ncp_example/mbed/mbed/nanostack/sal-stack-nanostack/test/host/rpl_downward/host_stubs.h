@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOST_STUBS_H_
+#define HOST_STUBS_H_
+
+/* Address that protocol_interface_address_compare() takes as our own - the DODAG root */
+extern uint8_t host_root_address[16];
+
+/* Added by the policy to the cost of a link from the root, by last byte of the neighbour address */
+extern uint16_t host_root_neighbour_etx[256];
+
+/* If set, every this many heap allocations fails */
+extern unsigned host_alloc_fail_every;
+
+#endif /* HOST_STUBS_H_ */
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Benchmark of the DAO handling of a non-storing DODAG root.
+ *
+ * The root holds a /128 target for each node of a tree with 16 nodes below
+ * the root and 4 children per node. Timed are target look-ups as each DAO
+ * makes, DAO refreshes of an existing transit followed by the path
+ * computation that the next source routed packet needs, and the full topo
+ * sort and path computation after a new transit. Only functions that older
+ * revisions also have are used, so this also builds against the list scans
+ * and full recomputation before the target index.
+ *
+ * Usage: rpl_downward_bench [nodes] [operations]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Transits are added with the static rpl_downward_add_root_transit(). This
+ * is found through the include path, so that of the tree being measured.
+ */
+#include "RPL/rpl_downward.c"
+
+#include "host_stubs.h"
+
+static double bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void bench_address(uint8_t address[16], int i)
+{
+    static const uint8_t prefix[8] = {0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x01};
+
+    memcpy(address, prefix, 8);
+    memset(address + 8, 0, 8);
+    address[13] = 0x02;
+    address[14] = (i >> 8) & 0xff;
+    address[15] = i & 0xff;
+}
+
+static const uint8_t *bench_parent(uint8_t (*address)[16], int i)
+{
+    return i < 16 ? host_root_address : address[i / 4];
+}
+
+int main(int argc, char *argv[])
+{
+    static rpl_instance_t instance;
+    int nodes = argc > 1 ? atoi(argv[1]) : 1000;
+    int operations = argc > 2 ? atoi(argv[2]) : 20000;
+    uint8_t (*address)[16] = malloc(nodes * sizeof(*address));
+    int *order = malloc(operations * sizeof(int));
+
+    ns_list_init(&instance.dao_targets);
+    ns_list_init(&instance.root_children);
+    bench_address(host_root_address, 0);
+    host_root_address[13] = 0x01;
+
+    srand(1);
+    for (int i = 0; i < nodes; i++) {
+        bench_address(address[i], i);
+        rpl_dao_target_t *target = rpl_create_dao_target(&instance, address[i], 128, true);
+        if (!target || !rpl_downward_add_root_transit(target, bench_parent(address, i), 0x80)) {
+            printf("target add failed\n");
+            return 1;
+        }
+    }
+    for (int i = 0; i < operations; i++) {
+        order[i] = rand() % nodes;
+    }
+    rpl_downward_compute_paths(&instance);
+
+    volatile uintptr_t sink = 0;
+    double t0 = bench_now_ns();
+    for (int i = 0; i < operations; i++) {
+        sink += (uintptr_t) rpl_instance_lookup_dao_target(&instance, address[order[i]], 128);
+    }
+    double t1 = bench_now_ns();
+    for (int i = 0; i < operations; i++) {
+        rpl_dao_target_t *target = rpl_instance_lookup_dao_target(&instance, address[order[i]], 128);
+        rpl_downward_add_root_transit(target, bench_parent(address, order[i]), 0x80 >> (i % 2));
+        rpl_downward_compute_paths(&instance);
+    }
+    double t2 = bench_now_ns();
+    int sorts = operations / 100 + 1;
+    for (int i = 0; i < sorts; i++) {
+        rpl_downward_topo_sort_invalidate(&instance);
+        rpl_downward_compute_paths(&instance);
+    }
+    double t3 = bench_now_ns();
+
+    printf("%d nodes: target look-up %.1f ns, DAO refresh %.2f us, topo sort and paths %.1f us\n", nodes,
+           (t1 - t0) / operations, (t2 - t1) / operations / 1e3, (t3 - t2) / sorts / 1e3);
+
+    ns_list_foreach_safe(rpl_dao_target_t, target, &instance.dao_targets) {
+        rpl_delete_dao_target(&instance, target);
+    }
+    free(order);
+    free(address);
+    return 0;
+}
@@ -0,0 +1,400 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Randomised test of the DAO target index and the incremental root path
+ * costs of a non-storing DODAG root.
+ *
+ * Targets and transits are added, refreshed, errored and deleted, and the
+ * costs of links to root neighbours changed, in random order. Parents are
+ * picked at random, so the graph has loops for the topo sort to break, and
+ * some targets are shorter prefixes covering others. After every step:
+ *
+ *  - the prefix hash must hold exactly the instance's targets, each in the
+ *    bucket of its prefix, and look-ups and matches must agree with a scan
+ *    of the target list;
+ *  - if the root paths are valid, each target's cost and connected flag must
+ *    equal those of a full rpl_downward_compute_paths();
+ *  - the target generation must have advanced at least once per target added
+ *    or removed, and may only stay put if the target list is unchanged.
+ *
+ * With a failing heap, targets and tables that can't be allocated must leave
+ * the look-ups working.
+ *
+ * Usage: rpl_downward_test [nodes] [rounds] [fail every nth alloc]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* The target hash and the path updates are static in rpl_downward.c */
+#include "../../../source/RPL/rpl_downward.c"
+
+#include "host_stubs.h"
+
+#define TEST_MAX_NODES 1000
+
+static int test_nodes;
+static uint8_t test_address[TEST_MAX_NODES][16];
+static rpl_instance_t test_instance;
+
+static void test_fail(const char *what, int round)
+{
+    printf("FAIL: %s in round %d\n", what, round);
+    exit(1);
+}
+
+/* Nodes are 2001:db8:0:1::2:<n>, the root is 2001:db8:0:1::1:0 */
+static void test_addresses_init(void)
+{
+    static const uint8_t prefix[8] = {0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x01};
+
+    memcpy(host_root_address, prefix, 8);
+    host_root_address[13] = 0x01;
+    for (int i = 0; i < test_nodes; i++) {
+        memcpy(test_address[i], prefix, 8);
+        test_address[i][13] = 0x02;
+        test_address[i][14] = i >> 8;
+        test_address[i][15] = i & 0xff;
+    }
+}
+
+static rpl_dao_target_t *test_lookup_scan(const uint8_t *prefix, uint8_t prefix_len, bool published_only)
+{
+    ns_list_foreach(rpl_dao_target_t, target, &test_instance.dao_targets) {
+        if ((!published_only || target->published) && target->prefix_len == prefix_len &&
+                bitsequal(target->prefix, prefix, prefix_len)) {
+            return target;
+        }
+    }
+    return NULL;
+}
+
+static rpl_dao_target_t *test_match_scan(const uint8_t *prefix, uint8_t prefix_len)
+{
+    rpl_dao_target_t *longest = NULL;
+    int_fast16_t longest_len = -1;
+
+    ns_list_foreach(rpl_dao_target_t, target, &test_instance.dao_targets) {
+        if (target->prefix_len >= longest_len && target->prefix_len <= prefix_len &&
+                bitsequal(target->prefix, prefix, target->prefix_len)) {
+            longest = target;
+            longest_len = target->prefix_len;
+        }
+    }
+    return longest;
+}
+
+static rpl_dao_target_t *test_random_target(void)
+{
+    uint_fast16_t count = ns_list_count(&test_instance.dao_targets);
+    if (count == 0) {
+        return NULL;
+    }
+    uint_fast16_t n = rand() % count;
+    ns_list_foreach(rpl_dao_target_t, target, &test_instance.dao_targets) {
+        if (n-- == 0) {
+            return target;
+        }
+    }
+    return NULL;
+}
+
+static rpl_dao_root_transit_t *test_random_transit(rpl_dao_target_t *target)
+{
+    uint_fast16_t n = rand() % ns_list_count(&target->info.root.transits);
+    ns_list_foreach(rpl_dao_root_transit_t, transit, &target->info.root.transits) {
+        if (n-- == 0) {
+            return transit;
+        }
+    }
+    return NULL;
+}
+
+/* Mostly /128 nodes, some shorter prefixes covering a few nodes or all */
+static void test_random_prefix(const uint8_t **prefix, uint8_t *prefix_len)
+{
+    static const uint8_t short_len[] = {64, 112, 120, 124};
+
+    *prefix = test_address[rand() % test_nodes];
+    *prefix_len = rand() % 16 ? 128 : short_len[rand() % 4];
+}
+
+/* Parents are mostly the root or a lower numbered node, sometimes any node */
+static const uint8_t *test_random_parent(const uint8_t *prefix)
+{
+    int n = (prefix[14] << 8) | prefix[15];
+
+    if (n < 8 || rand() % 4 == 0) {
+        return host_root_address;
+    }
+    return test_address[rand() % 8 ? rand() % n : rand() % test_nodes];
+}
+
+static bool test_hash_valid(void)
+{
+    uint_fast16_t hashed = 0;
+    uint_fast16_t count = 0;
+    uint_fast16_t short_count = 0;
+
+    ns_list_foreach(rpl_dao_target_t, target, &test_instance.dao_targets) {
+        count++;
+        if (target->prefix_len < 128) {
+            short_count++;
+        }
+    }
+    if (test_instance.dao_target_count != count || test_instance.dao_target_short_count != short_count) {
+        return false;
+    }
+    if (!test_instance.dao_target_hash) {
+        return test_instance.dao_target_hash_size == 0;
+    }
+    if (test_instance.dao_target_hash_size < RPL_DAO_TARGET_HASH_SIZE_MIN ||
+            test_instance.dao_target_hash_size > RPL_DAO_TARGET_HASH_SIZE_MAX ||
+            (test_instance.dao_target_hash_size & (test_instance.dao_target_hash_size - 1))) {
+        return false;
+    }
+    for (uint_fast16_t i = 0; i < test_instance.dao_target_hash_size; i++) {
+        for (rpl_dao_target_t *target = test_instance.dao_target_hash[i]; target; target = target->hash_next) {
+            if (rpl_dao_target_hash(target->prefix, target->prefix_len, test_instance.dao_target_hash_size) != i) {
+                return false;
+            }
+            if (++hashed > count) {
+                return false;
+            }
+        }
+    }
+    return hashed == count;
+}
+
+static void test_lookups(int round)
+{
+    const uint8_t *prefix;
+    uint8_t prefix_len;
+
+    for (int i = 0; i < 4; i++) {
+        test_random_prefix(&prefix, &prefix_len);
+        if (rpl_instance_lookup_dao_target(&test_instance, prefix, prefix_len) != test_lookup_scan(prefix, prefix_len, false)) {
+            test_fail("look-up differs from list scan", round);
+        }
+        if (rpl_instance_lookup_published_dao_target(&test_instance, prefix, prefix_len) != test_lookup_scan(prefix, prefix_len, true)) {
+            test_fail("published look-up differs from list scan", round);
+        }
+        if (rpl_instance_match_dao_target(&test_instance, prefix, 128) != test_match_scan(prefix, 128)) {
+            test_fail("match differs from list scan", round);
+        }
+        if (rpl_instance_match_dao_target(&test_instance, prefix, prefix_len) != test_match_scan(prefix, prefix_len)) {
+            test_fail("short match differs from list scan", round);
+        }
+    }
+}
+
+/* Compare the costs kept up to date incrementally with a full computation */
+static void test_costs(int round)
+{
+    static uint32_t cost[TEST_MAX_NODES * 2];
+    static bool connected[TEST_MAX_NODES * 2];
+    uint_fast16_t i = 0;
+
+    if (!test_instance.root_paths_valid) {
+        return;
+    }
+    ns_list_foreach(rpl_dao_target_t, target, &test_instance.dao_targets) {
+        cost[i] = target->info.root.cost;
+        connected[i++] = target->connected;
+    }
+    rpl_downward_paths_invalidate(&test_instance);
+    rpl_downward_compute_paths(&test_instance);
+    i = 0;
+    ns_list_foreach(rpl_dao_target_t, target, &test_instance.dao_targets) {
+        if (target->info.root.cost != cost[i] || target->connected != connected[i]) {
+            test_fail("incremental cost differs from full computation", round);
+        }
+        i++;
+    }
+}
+
+static int test_pointer_compare(const void *a, const void *b)
+{
+    uintptr_t pa = (uintptr_t) *(const void *const *) a;
+    uintptr_t pb = (uintptr_t) *(const void *const *) b;
+    return (pa > pb) - (pa < pb);
+}
+
+/* A host listing connected devices relies on the generation to see changes.
+ * The topological sort reorders the list, so only the set of targets counts.
+ */
+static void test_generation(const rpl_dao_target_t **before, int count, uint16_t generation, int round)
+{
+    static const rpl_dao_target_t *after[TEST_MAX_NODES * 2];
+    int now = 0;
+    uint16_t step = test_instance.dao_target_generation - generation;
+
+    ns_list_foreach(rpl_dao_target_t, target, &test_instance.dao_targets) {
+        after[now++] = target;
+    }
+    if (step < abs(now - count)) {
+        test_fail("generation not advanced for each target added or removed", round);
+    }
+    if (step) {
+        return;
+    }
+    qsort(before, count, sizeof(*before), test_pointer_compare);
+    qsort(after, now, sizeof(*after), test_pointer_compare);
+    if (memcmp(before, after, count * sizeof(*before))) {
+        test_fail("targets changed within a generation", round);
+    }
+}
+
+static void test_round(int round)
+{
+    static const rpl_dao_target_t *before[TEST_MAX_NODES * 2];
+    uint16_t generation = test_instance.dao_target_generation;
+    int count = 0;
+    const uint8_t *prefix;
+    uint8_t prefix_len;
+    rpl_dao_target_t *target;
+    rpl_dao_root_transit_t *transit;
+
+    ns_list_foreach(rpl_dao_target_t, t, &test_instance.dao_targets) {
+        before[count++] = t;
+    }
+
+    switch (rand() % 16) {
+        case 0:
+        case 1:
+        case 2:
+            /* New target, as a first DAO makes */
+            test_random_prefix(&prefix, &prefix_len);
+            if (test_lookup_scan(prefix, prefix_len, false)) {
+                break;
+            }
+            target = rpl_create_dao_target(&test_instance, prefix, prefix_len, true);
+            if (!target) {
+                if (!host_alloc_fail_every) {
+                    test_fail("target create failed", round);
+                }
+                break;
+            }
+            target->published = rand() % 2;
+            if (!rpl_downward_add_root_transit(target, test_random_parent(prefix), 0x80 >> (rand() % 8))) {
+                rpl_delete_dao_target(&test_instance, target);
+            }
+            break;
+        case 3:
+        case 4:
+        case 5:
+        case 6:
+            /* DAO refresh - mostly of an existing transit, so only costs change */
+            target = test_random_target();
+            if (!target) {
+                break;
+            }
+            if (rand() % 4) {
+                transit = test_random_transit(target);
+                rpl_downward_add_root_transit(target, transit->transit, 0x80 >> (rand() % 8));
+            } else if (ns_list_count(&target->info.root.transits) < 4) {
+                rpl_downward_add_root_transit(target, test_random_parent(target->prefix), 0x80 >> (rand() % 8));
+            }
+            break;
+        case 7:
+        case 8:
+            /* Source routing error on a transit */
+            target = test_random_target();
+            if (target) {
+                transit = test_random_transit(target);
+                rpl_downward_transit_error(&test_instance, target->prefix, transit->transit);
+            }
+            break;
+        case 9:
+            /* ETX change of a root neighbour */
+            host_root_neighbour_etx[rand() % 256] = rand() % 8;
+            rpl_downward_root_neighbour_costs_changed(&test_instance);
+            break;
+        case 10:
+            target = test_random_target();
+            if (target) {
+                rpl_downward_delete_root_transit(target, test_random_transit(target));
+            }
+            break;
+        case 11:
+            target = test_random_target();
+            if (!target) {
+                break;
+            }
+            if (rand() % 500 == 0) {
+                ns_list_foreach_safe(rpl_dao_target_t, t, &test_instance.dao_targets) {
+                    rpl_delete_dao_target(&test_instance, t);
+                }
+            } else {
+                rpl_delete_dao_target(&test_instance, target);
+            }
+            break;
+        default:
+            /* Forwarding needs the paths */
+            rpl_downward_compute_paths(&test_instance);
+            break;
+    }
+
+    if (!test_hash_valid()) {
+        test_fail("target hash does not match list", round);
+    }
+    test_generation(before, count, generation, round);
+    test_lookups(round);
+    test_costs(round);
+}
+
+int main(int argc, char *argv[])
+{
+    test_nodes = argc > 1 ? atoi(argv[1]) : 300;
+    int rounds = argc > 2 ? atoi(argv[2]) : 100000;
+    host_alloc_fail_every = argc > 3 ? atoi(argv[3]) : 0;
+
+    if (test_nodes < 8 || test_nodes > TEST_MAX_NODES) {
+        printf("FAIL: %d nodes not supported\n", test_nodes);
+        return 1;
+    }
+
+    srand(1);
+    test_addresses_init();
+    ns_list_init(&test_instance.dao_targets);
+    ns_list_init(&test_instance.root_children);
+
+    uint16_t hash_max = 0;
+    uint_fast16_t targets_max = 0;
+    for (int round = 0; round < rounds; round++) {
+        test_round(round);
+        if (test_instance.dao_target_hash_size > hash_max) {
+            hash_max = test_instance.dao_target_hash_size;
+        }
+        if (test_instance.dao_target_count > targets_max) {
+            targets_max = test_instance.dao_target_count;
+        }
+    }
+
+    ns_list_foreach_safe(rpl_dao_target_t, target, &test_instance.dao_targets) {
+        rpl_delete_dao_target(&test_instance, target);
+    }
+    if (test_instance.dao_target_hash) {
+        printf("FAIL: target hash not freed with the last target\n");
+        return 1;
+    }
+
+    printf("OK: %d nodes, %d rounds, failing alloc %u, up to %u targets, hash size up to %u\n", test_nodes, rounds,
+           host_alloc_fail_every, (unsigned) targets_max, (unsigned) hash_max);
+    return 0;
+}
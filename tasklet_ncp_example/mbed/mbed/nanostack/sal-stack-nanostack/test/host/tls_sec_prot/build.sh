@@ -0,0 +1,60 @@
+#!/bin/sh
+#
+# Builds and runs the host tests of EAP-TLS session resumption and the
+# session cache, the full and resumed handshake benchmark, and the join storm
+# model fed with the benchmark's results.
+#
+#   build.sh [cached sessions]
+#
+# The mbed TLS is the border router's configuration with the software AES,
+# built once into the build directory. The model runs with the given number
+# of cached sessions, by default the session cache size. Set CC and OUT to
+# change the compiler and the build directory.
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+STACK=$(cd "$HERE/../../.." && pwd)
+MBED=$(cd "$STACK/../.." && pwd)
+TI=$(cd "$MBED/../../ti_wisunfan/ti_wisunfan" && pwd)
+MBEDTLS=$(cd "$MBED/../../ti_wisunfan_third_party/ti_wisunfan/mbedtls" && pwd)
+OUT=${OUT:-${TMPDIR:-/tmp}/tls_sec_prot_test}
+CC=${CC:-cc}
+
+LIBSERVICE=$MBED/frameworks/nanostack-libservice
+INC="-I$HERE -I$STACK/source -I$STACK/nanostack -I$STACK/nanostack/platform
+     -I$LIBSERVICE/mbed-client-libservice -I$LIBSERVICE/mbed-client-libservice/platform
+     -I$MBED/frameworks/mbed-client-randlib/mbed-client-randlib
+     -I$TI/mbed_port/mbednanostack2tirtos/platform -I$TI/mbed_config/ws_border_router
+     -I$MBEDTLS/inc -I$MBEDTLS -I$TI/apps/border_router_nanostack_tirf"
+DEF='-DMBEDTLS_CONFIG_FILE="mbedtls_host_config.h"'
+PROT=$STACK/source/Security/protocols
+TLS_SRC="$HERE/host_tls.c $PROT/tls_sec_prot/tls_sec_prot_lib.c $PROT/tls_sec_prot/tls_sec_prot_session_cache.c
+         $PROT/sec_prot_certs.c"
+NVM_SRC="$PROT/sec_prot_keys.c $STACK/source/6LoWPAN/ws/ws_pae_nvm_data.c $STACK/source/6LoWPAN/ws/ws_pae_time.c
+         $LIBSERVICE/source/libBits/common_functions.c"
+# The NVM data writes the TLVs from the tag member on, which GCC takes for an overflow
+NVM_WARN="-Wno-stringop-overflow -Wno-stringop-overread"
+
+mkdir -p "$OUT/mbedtls"
+if [ ! -f "$OUT/libmbedtls.a" ]; then
+    for src in "$MBEDTLS"/src/*.c; do
+        $CC -std=gnu99 -O2 $INC "$DEF" -c -o "$OUT/mbedtls/$(basename "$src" .c).o" "$src"
+    done
+    ar rcs "$OUT/libmbedtls.a" "$OUT"/mbedtls/*.o
+fi
+
+$CC -std=gnu99 -O1 -g -fsanitize=address,undefined $NVM_WARN $INC -o "$OUT/tls_session_cache_test" \
+    "$HERE/tls_session_cache_test.c" "$HERE/host_stubs.c" $PROT/tls_sec_prot/tls_sec_prot_session_cache.c \
+    $PROT/sec_prot_certs.c $NVM_SRC
+"$OUT/tls_session_cache_test"
+
+$CC -std=gnu99 -O1 -g -fsanitize=address,undefined $NVM_WARN $INC "$DEF" -o "$OUT/tls_resumption_test" \
+    "$HERE/tls_resumption_test.c" "$HERE/host_stubs.c" $TLS_SRC $NVM_SRC "$OUT/libmbedtls.a"
+"$OUT/tls_resumption_test"
+
+$CC -std=gnu99 -O2 $INC "$DEF" -o "$OUT/tls_resumption_bench" \
+    "$HERE/tls_resumption_bench.c" "$HERE/host_stubs.c" $TLS_SRC "$OUT/libmbedtls.a"
+$CC -std=gnu99 -O2 -o "$OUT/tls_join_storm_model" "$HERE/tls_join_storm_model.c"
+"$OUT/tls_resumption_bench" | tee "$OUT/tls_resumption_bench.out"
+"$OUT/tls_join_storm_model" ${1:-32} < "$OUT/tls_resumption_bench.out"
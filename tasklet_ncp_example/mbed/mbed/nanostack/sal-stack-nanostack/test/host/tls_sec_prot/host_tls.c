@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nsconfig.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ns_types.h"
+#include "ns_list.h"
+#include "6LoWPAN/ws/ws_config.h"
+#include "Security/protocols/sec_prot_certs.h"
+#include "Security/protocols/tls_sec_prot/tls_sec_prot_lib.h"
+#include "Security/protocols/tls_sec_prot/tls_sec_prot_session_cache.h"
+#include "host_tls.h"
+
+#include MBEDTLS_CONFIG_FILE
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/entropy.h"
+#include "mbedtls/pk.h"
+#include "mbedtls/x509_crt.h"
+
+#define HOST_TLS_PIPE_SIZE      4096
+#define HOST_TLS_CERT_SIZE      1024
+#define HOST_TLS_KEY_SIZE       256
+#define HOST_TLS_ROUNDS_MAX     32
+
+typedef struct {
+    uint8_t data[HOST_TLS_PIPE_SIZE];
+    uint16_t len;
+} host_tls_pipe_t;
+
+typedef struct {
+    uint8_t cert[HOST_TLS_CERT_SIZE];
+    uint16_t cert_len;
+    uint8_t key[HOST_TLS_KEY_SIZE];
+    uint8_t key_len;
+} host_tls_credentials_t;
+
+typedef struct {
+    tls_security_t *sec;
+    host_tls_side_e side;
+    host_tls_pipe_t *in;
+    host_tls_pipe_t *out;
+    host_tls_node_t *node;
+    host_tls_result_t *result;
+} host_tls_peer_t;
+
+uint32_t host_tls_session_lifetime = TLS_SESSION_CACHE_LIFETIME;
+
+static host_tls_credentials_t host_tls_ca;
+static host_tls_credentials_t host_tls_own[2];
+static sec_prot_certs_t host_tls_certs[2];
+static cert_chain_entry_t host_tls_trusted;
+static int host_tls_last_sender = -1;
+
+static mbedtls_ctr_drbg_context host_tls_drbg;
+
+static void host_tls_fail(const char *what)
+{
+    printf("FAIL: %s\n", what);
+    exit(1);
+}
+
+/* DER certificate of subject's key, signed by issuer's */
+static void host_tls_cert_create(host_tls_credentials_t *subject, mbedtls_pk_context *subject_key, const char *subject_name,
+                                 mbedtls_pk_context *issuer_key, const char *issuer_name, int serial, bool ca)
+{
+    mbedtls_x509write_cert crt;
+    mbedtls_mpi mpi;
+    uint8_t buf[HOST_TLS_CERT_SIZE];
+    int len;
+
+    mbedtls_x509write_crt_init(&crt);
+    mbedtls_mpi_init(&mpi);
+    mbedtls_mpi_lset(&mpi, serial);
+    mbedtls_x509write_crt_set_subject_key(&crt, subject_key);
+    mbedtls_x509write_crt_set_issuer_key(&crt, issuer_key);
+    mbedtls_x509write_crt_set_md_alg(&crt, MBEDTLS_MD_SHA256);
+    if (mbedtls_x509write_crt_set_subject_name(&crt, subject_name) || mbedtls_x509write_crt_set_issuer_name(&crt, issuer_name) ||
+            mbedtls_x509write_crt_set_serial(&crt, &mpi) ||
+            mbedtls_x509write_crt_set_validity(&crt, "20200101000000", "20991231235959") ||
+            mbedtls_x509write_crt_set_basic_constraints(&crt, ca, -1)) {
+        host_tls_fail("certificate fields");
+    }
+    len = mbedtls_x509write_crt_der(&crt, buf, sizeof(buf), mbedtls_ctr_drbg_random, &host_tls_drbg);
+    if (len <= 0) {
+        host_tls_fail("certificate write");
+    }
+    /* Written to the end of the buffer */
+    memcpy(subject->cert, buf + sizeof(buf) - len, len);
+    subject->cert_len = len;
+
+    len = mbedtls_pk_write_key_der(subject_key, buf, sizeof(buf));
+    if (len <= 0 || len > HOST_TLS_KEY_SIZE) {
+        host_tls_fail("key write");
+    }
+    memcpy(subject->key, buf + sizeof(buf) - len, len);
+    subject->key_len = len;
+
+    mbedtls_mpi_free(&mpi);
+    mbedtls_x509write_crt_free(&crt);
+}
+
+static void host_tls_key_create(mbedtls_pk_context *key)
+{
+    mbedtls_pk_init(key);
+    if (mbedtls_pk_setup(key, mbedtls_pk_info_from_type(MBEDTLS_PK_ECKEY)) ||
+            mbedtls_ecp_gen_key(MBEDTLS_ECP_DP_SECP256R1, mbedtls_pk_ec(*key), mbedtls_ctr_drbg_random, &host_tls_drbg)) {
+        host_tls_fail("key generation");
+    }
+}
+
+void host_tls_init(void)
+{
+    static const char *const names[2] = {"CN=Border Router", "CN=Node"};
+    mbedtls_entropy_context entropy;
+    mbedtls_pk_context ca_key;
+
+    mbedtls_entropy_init(&entropy);
+    mbedtls_ctr_drbg_init(&host_tls_drbg);
+    if (mbedtls_ctr_drbg_seed(&host_tls_drbg, mbedtls_entropy_func, &entropy, NULL, 0)) {
+        host_tls_fail("drbg seed");
+    }
+
+    host_tls_key_create(&ca_key);
+    host_tls_cert_create(&host_tls_ca, &ca_key, "CN=Wi-SUN CA", &ca_key, "CN=Wi-SUN CA", 1, true);
+    sec_prot_certs_chain_entry_init(&host_tls_trusted);
+    sec_prot_certs_cert_set(&host_tls_trusted, 0, host_tls_ca.cert, host_tls_ca.cert_len);
+
+    for (int side = HOST_TLS_SERVER; side <= HOST_TLS_CLIENT; side++) {
+        mbedtls_pk_context key;
+        host_tls_key_create(&key);
+        host_tls_cert_create(&host_tls_own[side], &key, names[side], &ca_key, "CN=Wi-SUN CA", side + 2, false);
+        mbedtls_pk_free(&key);
+
+        sec_prot_certs_init(&host_tls_certs[side]);
+        sec_prot_certs_cert_set(&host_tls_certs[side].own_cert_chain, 0, host_tls_own[side].cert, host_tls_own[side].cert_len);
+        sec_prot_certs_priv_key_set(&host_tls_certs[side].own_cert_chain, host_tls_own[side].key, host_tls_own[side].key_len);
+        sec_prot_certs_chain_list_add(&host_tls_certs[side].trusted_cert_chain_list, &host_tls_trusted);
+    }
+
+    mbedtls_pk_free(&ca_key);
+    mbedtls_entropy_free(&entropy);
+}
+
+static int16_t host_tls_send(void *handle, const void *buf, size_t len)
+{
+    host_tls_peer_t *peer = handle;
+    host_tls_result_t *result = peer->result;
+
+    if (peer->out->len + len > HOST_TLS_PIPE_SIZE) {
+        host_tls_fail("flight does not fit pipe");
+    }
+    memcpy(peer->out->data + peer->out->len, buf, len);
+    peer->out->len += len;
+
+    if (host_tls_last_sender != (int) peer->side) {
+        host_tls_last_sender = peer->side;
+        if (result->flights == HOST_TLS_FLIGHTS_MAX) {
+            host_tls_fail("too many flights");
+        }
+        result->flight_bytes[result->flights++] = 0;
+    }
+    result->flight_bytes[result->flights - 1] += len;
+    result->bytes[peer->side] += len;
+    return len;
+}
+
+static int16_t host_tls_receive(void *handle, unsigned char *buf, size_t len)
+{
+    host_tls_peer_t *peer = handle;
+
+    if (peer->in->len == 0) {
+        return TLS_SEC_PROT_LIB_NO_DATA;
+    }
+    if (len > peer->in->len) {
+        len = peer->in->len;
+    }
+    memcpy(buf, peer->in->data, len);
+    memmove(peer->in->data, peer->in->data + len, peer->in->len - len);
+    peer->in->len -= len;
+    return len;
+}
+
+static void host_tls_export_keys(void *handle, const uint8_t *master_secret, const uint8_t *eap_tls_key_material)
+{
+    host_tls_peer_t *peer = handle;
+
+    memcpy(peer->result->master_secret[peer->side], master_secret, 48);
+    memcpy(peer->result->key_material[peer->side], eap_tls_key_material, 128);
+    peer->result->keys_exported[peer->side] = true;
+}
+
+static void host_tls_set_timer(void *handle, uint32_t inter, uint32_t fin)
+{
+    (void) handle;
+    (void) inter;
+    (void) fin;
+}
+
+static int8_t host_tls_get_timer(void *handle)
+{
+    (void) handle;
+    return TLS_SEC_PROT_LIB_TIMER_NO_EXPIRY;
+}
+
+/* As server_tls_sec_prot_tls_session_get/set of tls_sec_prot.c */
+static int8_t host_tls_server_session_get(void *handle, tls_sec_prot_lib_session_t *session)
+{
+    host_tls_peer_t *peer = handle;
+
+    if (tls_sec_prot_session_cache_read(peer->node->eui_64, session) < 0) {
+        return -1;
+    }
+    peer->result->resumed = true;
+    return 0;
+}
+
+static void host_tls_server_session_set(void *handle, const tls_sec_prot_lib_session_t *session)
+{
+    host_tls_peer_t *peer = handle;
+
+    tls_sec_prot_session_cache_write(peer->node->eui_64, session, host_tls_session_lifetime);
+}
+
+/* As client_tls_sec_prot_tls_session_get/set of tls_sec_prot.c */
+static int8_t host_tls_client_session_get(void *handle, tls_sec_prot_lib_session_t *session)
+{
+    host_tls_peer_t *peer = handle;
+
+    if (peer->node->session.id_len == 0) {
+        return -1;
+    }
+    memcpy(session, &peer->node->session, sizeof(tls_sec_prot_lib_session_t));
+    return 0;
+}
+
+static void host_tls_client_session_set(void *handle, const tls_sec_prot_lib_session_t *session)
+{
+    host_tls_peer_t *peer = handle;
+
+    memcpy(&peer->node->session, session, sizeof(tls_sec_prot_lib_session_t));
+}
+
+static double host_tls_cpu_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int host_tls_handshake(host_tls_node_t *node, host_tls_result_t *result)
+{
+    host_tls_pipe_t *pipe = calloc(2, sizeof(host_tls_pipe_t));
+    host_tls_peer_t peer[2];
+    bool over[2] = {false, false};
+    int ret = -1;
+
+    memset(result, 0, sizeof(host_tls_result_t));
+    host_tls_last_sender = -1;
+
+    for (int side = HOST_TLS_SERVER; side <= HOST_TLS_CLIENT; side++) {
+        peer[side].sec = calloc(1, tls_sec_prot_lib_size());
+        peer[side].side = side;
+        peer[side].in = &pipe[side];
+        peer[side].out = &pipe[!side];
+        peer[side].node = node;
+        peer[side].result = result;
+        if (tls_sec_prot_lib_init(peer[side].sec) < 0) {
+            host_tls_fail("library init");
+        }
+        tls_sec_prot_lib_set_cb_register(peer[side].sec, &peer[side], host_tls_send, host_tls_receive, host_tls_export_keys,
+                                         host_tls_set_timer, host_tls_get_timer);
+        if (side == HOST_TLS_SERVER) {
+            tls_sec_prot_lib_session_cb_register(peer[side].sec, host_tls_server_session_get, host_tls_server_session_set);
+        } else {
+            tls_sec_prot_lib_session_cb_register(peer[side].sec, host_tls_client_session_get, host_tls_client_session_set);
+        }
+        if (tls_sec_prot_lib_connect(peer[side].sec, side == HOST_TLS_SERVER, &host_tls_certs[side]) < 0) {
+            host_tls_fail("library connect");
+        }
+    }
+
+    /* Client starts; each end runs until it waits for the other */
+    for (int round = 0; round < HOST_TLS_ROUNDS_MAX && !(over[0] && over[1]); round++) {
+        for (int side = HOST_TLS_CLIENT; side >= HOST_TLS_SERVER; side--) {
+            if (over[side]) {
+                continue;
+            }
+            double t0 = host_tls_cpu_ns();
+            int8_t status = tls_sec_prot_lib_process(peer[side].sec);
+            result->cpu_ns[side] += host_tls_cpu_ns() - t0;
+            if (status == TLS_SEC_PROT_LIB_ERROR) {
+                goto out;
+            }
+            over[side] = status == TLS_SEC_PROT_LIB_HANDSHAKE_OVER;
+        }
+    }
+    ret = over[0] && over[1] && !pipe[0].len && !pipe[1].len ? 0 : -1;
+
+out:
+    if (ret < 0) {
+        /* Next handshake is a full one */
+        memset(&node->session, 0, sizeof(tls_sec_prot_lib_session_t));
+    }
+    for (int side = HOST_TLS_SERVER; side <= HOST_TLS_CLIENT; side++) {
+        tls_sec_prot_lib_free(peer[side].sec);
+        free(peer[side].sec);
+    }
+    free(pipe);
+    return ret;
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOST_TLS_H_
+#define HOST_TLS_H_
+
+/*
+ * Runs EAP-TLS handshakes between a border router and nodes on the host,
+ * with tls_sec_prot_lib.c on both ends and the records going through memory.
+ * The ends keep their sessions as tls_sec_prot.c does: the border router in
+ * the session cache by the node's EUI-64, a node in RAM until a handshake
+ * fails. The CA, border router and node certificates are made on init.
+ */
+
+#define HOST_TLS_FLIGHTS_MAX    16
+
+typedef enum {
+    HOST_TLS_SERVER = 0,
+    HOST_TLS_CLIENT = 1,
+} host_tls_side_e;
+
+typedef struct {
+    uint8_t eui_64[8];
+    tls_sec_prot_lib_session_t session;                 /**< Session offered on the next handshake */
+} host_tls_node_t;
+
+typedef struct {
+    bool resumed;                                       /**< Border router resumed a cached session */
+    uint8_t flights;                                    /**< Number of flights, both ways */
+    uint16_t flight_bytes[HOST_TLS_FLIGHTS_MAX];        /**< TLS record bytes of each flight */
+    uint32_t bytes[2];                                  /**< Bytes sent, by side */
+    double cpu_ns[2];                                   /**< Processor time, by side */
+    bool keys_exported[2];
+    uint8_t master_secret[2][48];
+    uint8_t key_material[2][128];
+} host_tls_result_t;
+
+/* Session lifetime the border router caches sessions with */
+extern uint32_t host_tls_session_lifetime;
+
+void host_tls_init(void);
+
+/*
+ * One handshake of a node with the border router. On failure the node
+ * forgets its session, as the supplicant does.
+ *
+ * Returns < 0 if the handshake failed.
+ */
+int host_tls_handshake(host_tls_node_t *node, host_tls_result_t *result);
+
+#endif /* HOST_TLS_H_ */
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Host configuration of mbed TLS: the border router's, with the software
+ * AES in place of the TI crypto driver. The entropy is the one of
+ * host_stubs.c, as DEVICE_TRNG selects MBEDTLS_ENTROPY_HARDWARE_ALT.
+ */
+
+#ifndef MBEDTLS_HOST_CONFIG_H
+#define MBEDTLS_HOST_CONFIG_H
+
+#include "mbedtls/config.h"
+
+#undef MBEDTLS_AES_ALT
+
+#endif /* MBEDTLS_HOST_CONFIG_H */
@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Model of a join storm: N nodes authenticate to one border router at the
+ * same instant, as after a border router restart, some of them resuming a
+ * cached session and the rest doing full handshakes.
+ *
+ * The border router runs at most MAX_SIMULTANEOUS_SECURITY_NEGOTIATIONS
+ * handshakes at once. Each EAP exchange is lock-step: the border router
+ * processes the node's last message and sends the next one, EAP-TLS
+ * fragmented, the node answers. The border router's processor and the
+ * medium around it are shared by all nodes; forwarding over the hops adds
+ * a fixed latency. The processor times and the flights come from the
+ * output of tls_resumption_bench, the processor times scaled from the host
+ * to the device.
+ *
+ * Usage: tls_resumption_bench | tls_join_storm_model [cached sessions]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MODEL_CPU_SCALE         150             /* Host processor time to the device's */
+#define MODEL_RATE              (15000 / 8.0)   /* Medium around the border router, bytes/s */
+#define MODEL_FRAME_OVERHEAD    60              /* MAC, 6LoWPAN and EAPOL bytes of a frame */
+#define MODEL_FRAGMENT          600             /* EAP-TLS fragment */
+#define MODEL_HOP_LATENCY       0.15            /* Forwarding latency one way, s */
+#define MODEL_EAP_HEADER        10              /* EAP and EAP-TLS header */
+#define MODEL_NEGOTIATIONS      64              /* Simultaneous negotiations on the border router */
+#define MODEL_NODES_MAX         1000
+#define MODEL_EXCHANGES_MAX     64
+
+typedef struct {
+    int down;                   /* Bytes border router to node */
+    int up;                     /* Bytes node to border router */
+    double br_cpu;              /* Border router processor time, s */
+    double node_cpu;            /* Node processor time, s */
+} model_exchange_t;
+
+typedef struct {
+    double br_cpu;
+    double node_cpu;
+    int flights;
+    int flight_bytes[16];
+    model_exchange_t exchange[MODEL_EXCHANGES_MAX];
+    int exchanges;
+} model_handshake_t;
+
+typedef struct {
+    double time;
+    int node;
+    int exchange;
+} model_event_t;
+
+static model_handshake_t model_full;
+static model_handshake_t model_resumed;
+
+static model_event_t model_heap[MODEL_NODES_MAX];
+static int model_heap_len;
+
+static int model_event_before(const model_event_t *a, const model_event_t *b)
+{
+    if (a->time != b->time) {
+        return a->time < b->time;
+    }
+    if (a->node != b->node) {
+        return a->node < b->node;
+    }
+    return a->exchange < b->exchange;
+}
+
+static void model_event_push(double time, int node, int exchange)
+{
+    int i = model_heap_len++;
+
+    model_heap[i] = (model_event_t) {time, node, exchange};
+    while (i > 0 && model_event_before(&model_heap[i], &model_heap[(i - 1) / 2])) {
+        model_event_t tmp = model_heap[i];
+        model_heap[i] = model_heap[(i - 1) / 2];
+        model_heap[(i - 1) / 2] = tmp;
+        i = (i - 1) / 2;
+    }
+}
+
+static model_event_t model_event_pop(void)
+{
+    model_event_t top = model_heap[0];
+    int i = 0;
+
+    model_heap[0] = model_heap[--model_heap_len];
+    for (;;) {
+        int min = i;
+        for (int child = 2 * i + 1; child <= 2 * i + 2 && child < model_heap_len; child++) {
+            if (model_event_before(&model_heap[child], &model_heap[min])) {
+                min = child;
+            }
+        }
+        if (min == i) {
+            break;
+        }
+        model_event_t tmp = model_heap[i];
+        model_heap[i] = model_heap[min];
+        model_heap[min] = tmp;
+        i = min;
+    }
+    return top;
+}
+
+static void model_exchange_add(model_handshake_t *hs, int down, int up, double br_cpu, double node_cpu)
+{
+    if (hs->exchanges == MODEL_EXCHANGES_MAX) {
+        printf("FAIL: too many exchanges\n");
+        exit(1);
+    }
+    hs->exchange[hs->exchanges++] = (model_exchange_t) {down, up, br_cpu, node_cpu};
+}
+
+/* Lock-step EAP exchanges of a handshake: the node's flights go up, the border router's down */
+static void model_exchanges_build(model_handshake_t *hs)
+{
+    int node_flights = (hs->flights + 1) / 2;
+
+    hs->exchanges = 0;
+    model_exchange_add(hs, MODEL_EAP_HEADER, MODEL_EAP_HEADER + 8, 0, 0);  /* Identity */
+    model_exchange_add(hs, MODEL_EAP_HEADER, MODEL_EAP_HEADER, 0, 0);      /* EAP-TLS start */
+    for (int i = 0; i < node_flights; i++) {
+        int up = hs->flight_bytes[2 * i];
+        int down = 2 * i + 1 < hs->flights ? hs->flight_bytes[2 * i + 1] : 0;
+        int fragments = down ? (down + MODEL_FRAGMENT - 1) / MODEL_FRAGMENT : 1;
+
+        for (int k = 0; k < fragments; k++) {
+            int fragment = down - k * MODEL_FRAGMENT < MODEL_FRAGMENT ? down - k * MODEL_FRAGMENT : MODEL_FRAGMENT;
+            model_exchange_add(hs, MODEL_EAP_HEADER + fragment, MODEL_EAP_HEADER + (k == 0 ? up : 0),
+                               k == 0 ? hs->br_cpu * MODEL_CPU_SCALE / node_flights : 0,
+                               k == 0 ? hs->node_cpu * MODEL_CPU_SCALE / node_flights : 0);
+        }
+    }
+    model_exchange_add(hs, MODEL_EAP_HEADER, 0, 0, 0);                     /* Success */
+}
+
+static void model_run(int nodes, int resuming, double *makespan, double *mean, double *br_cpu, double *airtime)
+{
+    double cpu_free = 0;
+    double air_free = 0;
+    double done_sum = 0;
+    int waiting = 0;
+
+    *makespan = *br_cpu = *airtime = 0;
+    model_heap_len = 0;
+    while (waiting < nodes && waiting < MODEL_NEGOTIATIONS) {
+        model_event_push(0, waiting++, 0);
+    }
+
+    while (model_heap_len) {
+        model_event_t ev = model_event_pop();
+        const model_handshake_t *hs = ev.node < resuming ? &model_resumed : &model_full;
+
+        if (ev.exchange == hs->exchanges) {
+            done_sum += ev.time;
+            if (ev.time > *makespan) {
+                *makespan = ev.time;
+            }
+            if (waiting < nodes) {
+                model_event_push(ev.time, waiting++, 0);
+            }
+            continue;
+        }
+
+        const model_exchange_t *ex = &hs->exchange[ev.exchange];
+        // Border router processes the node's message, then sends the next one
+        cpu_free = (cpu_free > ev.time ? cpu_free : ev.time) + ex->br_cpu;
+        *br_cpu += ex->br_cpu;
+        if (ex->down) {
+            double air = (ex->down + MODEL_FRAME_OVERHEAD) / MODEL_RATE;
+            air_free = (air_free > cpu_free ? air_free : cpu_free) + air;
+            *airtime += air;
+        }
+        if (ex->up) {
+            double air = (ex->up + MODEL_FRAME_OVERHEAD) / MODEL_RATE;
+            air_free += air;
+            *airtime += air;
+        }
+        model_event_push((air_free > cpu_free ? air_free : cpu_free) + 2 * MODEL_HOP_LATENCY + ex->node_cpu,
+                         ev.node, ev.exchange + 1);
+    }
+
+    *mean = done_sum / nodes;
+}
+
+static void model_bench_read(void)
+{
+    char line[256];
+    int read = 0;
+
+    while (fgets(line, sizeof(line), stdin)) {
+        model_handshake_t *hs;
+        char kind[16];
+        int pos;
+
+        if (sscanf(line, "%15s%n", kind, &pos) != 1 || kind[0] == '#') {
+            continue;
+        }
+        if (strcmp(kind, "full") == 0) {
+            hs = &model_full;
+        } else if (strcmp(kind, "resumed") == 0) {
+            hs = &model_resumed;
+        } else {
+            continue;
+        }
+        char *p = line + pos;
+        int n;
+        if (sscanf(p, "%lf %lf %d%n", &hs->br_cpu, &hs->node_cpu, &hs->flights, &n) != 3 ||
+                hs->flights < 1 || hs->flights > 16) {
+            printf("FAIL: benchmark line: %s", line);
+            exit(1);
+        }
+        p += n;
+        for (int i = 0; i < hs->flights; i++) {
+            if (sscanf(p, "%d%n", &hs->flight_bytes[i], &n) != 1) {
+                printf("FAIL: benchmark line: %s", line);
+                exit(1);
+            }
+            p += n;
+        }
+        model_exchanges_build(hs);
+        read++;
+    }
+
+    if (read < 2) {
+        printf("FAIL: benchmark output has no full and resumed lines\n");
+        exit(1);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    static const int nodes[] = {50, 200, 500, 1000};
+    int cached = argc > 1 ? atoi(argv[1]) : 32;
+
+    model_bench_read();
+
+    printf("nodes resumed makespan[s] mean[s] br-cpu[s] airtime[s]\n");
+    for (unsigned int i = 0; i < sizeof(nodes) / sizeof(nodes[0]); i++) {
+        int resuming[3] = {0, cached < nodes[i] ? cached : nodes[i], nodes[i]};
+        for (int j = 0; j < 3; j++) {
+            double makespan, mean, br_cpu, airtime;
+            model_run(nodes[i], resuming[j], &makespan, &mean, &br_cpu, &airtime);
+            printf("%-5d %-7d %11.1f %7.1f %9.1f %10.1f\n", nodes[i], resuming[j], makespan, mean, br_cpu, airtime);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Benchmark of full and resumed EAP-TLS handshakes.
+ *
+ * Times the processor time each end spends in tls_sec_prot_lib.c, and
+ * counts the flights and TLS record bytes of each kind of handshake. The
+ * lines after the header are the input of tls_join_storm_model:
+ *
+ *     <kind> <border router s> <node s> <flights> <bytes of each flight>
+ *
+ * Usage: tls_resumption_bench [handshakes]
+ */
+
+#include "nsconfig.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ns_types.h"
+#include "ns_list.h"
+#include "Security/protocols/sec_prot_certs.h"
+#include "Security/protocols/tls_sec_prot/tls_sec_prot_lib.h"
+#include "Security/protocols/tls_sec_prot/tls_sec_prot_session_cache.h"
+#include "host_tls.h"
+
+static void bench_run(const char *kind, bool resume, int handshakes)
+{
+    host_tls_node_t node = {.eui_64 = {0x00, 0x12, 0x4b, 0x00, 0x1a, 0x2b, 0x3c, 0x4d}};
+    host_tls_result_t result;
+    double cpu_ns[2] = {0, 0};
+
+    tls_sec_prot_session_cache_init(1);
+    if (host_tls_handshake(&node, &result) < 0) {
+        printf("FAIL: handshake\n");
+        exit(1);
+    }
+    for (int i = 0; i < handshakes; i++) {
+        if (!resume) {
+            tls_sec_prot_session_cache_flush();
+            memset(&node.session, 0, sizeof(node.session));
+        }
+        if (host_tls_handshake(&node, &result) < 0 || result.resumed != resume) {
+            printf("FAIL: %s handshake\n", kind);
+            exit(1);
+        }
+        cpu_ns[HOST_TLS_SERVER] += result.cpu_ns[HOST_TLS_SERVER];
+        cpu_ns[HOST_TLS_CLIENT] += result.cpu_ns[HOST_TLS_CLIENT];
+    }
+
+    printf("%-8s %.6f %.6f %d", kind, cpu_ns[HOST_TLS_SERVER] / handshakes / 1e9,
+           cpu_ns[HOST_TLS_CLIENT] / handshakes / 1e9, result.flights);
+    for (int i = 0; i < result.flights; i++) {
+        printf(" %d", result.flight_bytes[i]);
+    }
+    printf("\n");
+}
+
+int main(int argc, char *argv[])
+{
+    int handshakes = argc > 1 ? atoi(argv[1]) : 50;
+
+    srand(1);
+    host_tls_init();
+
+    printf("# kind   border-router[s] node[s] flights bytes\n");
+    bench_run("full", false, handshakes);
+    bench_run("resumed", true, handshakes * 10);
+    tls_sec_prot_session_cache_delete();
+
+    return 0;
+}
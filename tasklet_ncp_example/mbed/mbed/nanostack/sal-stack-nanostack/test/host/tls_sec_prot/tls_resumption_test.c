@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Test of EAP-TLS session resumption between the border router and nodes.
+ *
+ * A node's first handshake is a full one and the border router caches its
+ * session. The next one must resume it, with the same master secret and
+ * new key material on both ends. A session must not resume for another
+ * node, after the cache is flushed or the node's entry deleted, after it
+ * expires, or once a fuller cache has replaced it. A session whose master
+ * secret doesn't match must fail the handshake, and the node's next one be
+ * a full one. Sessions stored to NVM must resume after a restart.
+ *
+ * Usage: tls_resumption_test
+ */
+
+#include "nsconfig.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ns_types.h"
+#include "ns_list.h"
+#include "6LoWPAN/ws/ws_config.h"
+#include "Security/protocols/sec_prot_certs.h"
+#include "Security/protocols/sec_prot_keys.h"
+#include "6LoWPAN/ws/ws_pae_nvm_store.h"
+#include "6LoWPAN/ws/ws_pae_nvm_data.h"
+#include "6LoWPAN/ws/ws_pae_time.h"
+#include "Security/protocols/tls_sec_prot/tls_sec_prot_lib.h"
+#include "Security/protocols/tls_sec_prot/tls_sec_prot_session_cache.h"
+#include "host_tls.h"
+
+#define TEST_NODES 4
+
+static host_tls_node_t test_node[TEST_NODES];
+static int test_step;
+
+static void test_fail(const char *what, int step)
+{
+    printf("FAIL: %s in step %d\n", what, step);
+    exit(1);
+}
+
+/* A successful handshake, full or resumed as expected */
+static void test_handshake(host_tls_node_t *node, bool resumed, host_tls_result_t *result)
+{
+    tls_sec_prot_lib_session_t offered = node->session;
+
+    test_step++;
+    if (host_tls_handshake(node, result) < 0) {
+        test_fail("handshake failed", test_step);
+    }
+    if (result->resumed != resumed) {
+        test_fail(resumed ? "session not resumed" : "session resumed", test_step);
+    }
+    if (!result->keys_exported[HOST_TLS_SERVER] || !result->keys_exported[HOST_TLS_CLIENT] ||
+            memcmp(result->master_secret[HOST_TLS_SERVER], result->master_secret[HOST_TLS_CLIENT], 48) ||
+            memcmp(result->key_material[HOST_TLS_SERVER], result->key_material[HOST_TLS_CLIENT], 128)) {
+        test_fail("keys differ between the ends", test_step);
+    }
+    if (resumed && (memcmp(node->session.id, offered.id, offered.id_len) ||
+                    memcmp(result->master_secret[HOST_TLS_CLIENT], offered.master, 48))) {
+        test_fail("resumed session differs from the offered one", test_step);
+    }
+    if (!resumed && offered.id_len && !memcmp(node->session.id, offered.id, offered.id_len)) {
+        test_fail("full handshake kept the session", test_step);
+    }
+
+    /* The border router has the node's new session */
+    tls_sec_prot_lib_session_t cached;
+    memset(&cached, 0, sizeof(cached));
+    cached.id_len = node->session.id_len;
+    memcpy(cached.id, node->session.id, node->session.id_len);
+    if (tls_sec_prot_session_cache_read(node->eui_64, &cached) < 0 || memcmp(cached.master, node->session.master, 48) ||
+            cached.ciphersuite != node->session.ciphersuite) {
+        test_fail("session not cached", test_step);
+    }
+}
+
+static void test_resumption(void)
+{
+    host_tls_result_t full;
+    host_tls_result_t resumed;
+
+    tls_sec_prot_session_cache_init(TEST_NODES);
+
+    test_handshake(&test_node[0], false, &full);
+    test_handshake(&test_node[0], true, &resumed);
+    if (!memcmp(full.key_material[0], resumed.key_material[0], 128)) {
+        test_fail("key material repeated", test_step);
+    }
+    if (resumed.flights != 3 || full.flights != 4 || resumed.bytes[0] >= full.bytes[0] || resumed.bytes[1] >= full.bytes[1]) {
+        test_fail("resumed handshake not abbreviated", test_step);
+    }
+
+    /* Another node offering the session gets a full handshake */
+    test_handshake(&test_node[1], false, &full);
+    test_node[2].session = test_node[0].session;
+    test_handshake(&test_node[2], false, &full);
+    test_handshake(&test_node[0], true, &resumed);
+
+    tls_sec_prot_session_cache_flush();
+    test_handshake(&test_node[0], false, &full);
+    test_handshake(&test_node[1], false, &full);
+
+    if (!tls_sec_prot_session_cache_supp_delete(test_node[1].eui_64)) {
+        test_fail("session not deleted", test_step);
+    }
+    test_handshake(&test_node[1], false, &full);
+    test_handshake(&test_node[0], true, &resumed);
+
+    /* Sessions expire */
+    tls_sec_prot_session_cache_timer(60000);
+    test_handshake(&test_node[0], true, &resumed);
+    for (uint32_t left = host_tls_session_lifetime - 60000; left; left -= left > 60000 ? 60000 : left) {
+        tls_sec_prot_session_cache_timer(left > 60000 ? 60000 : left);
+    }
+    test_handshake(&test_node[0], false, &full);
+
+    /* With a cache of two, the third node replaces the session closest to expiry */
+    tls_sec_prot_session_cache_init(2);
+    test_handshake(&test_node[0], false, &full);
+    tls_sec_prot_session_cache_timer(10);
+    test_handshake(&test_node[1], false, &full);
+    test_handshake(&test_node[2], false, &full);
+    test_handshake(&test_node[1], true, &resumed);
+    test_handshake(&test_node[0], false, &full);
+    test_handshake(&test_node[2], false, &full);
+
+    /* A session the border router knows with another master secret */
+    tls_sec_prot_session_cache_init(TEST_NODES);
+    test_handshake(&test_node[3], false, &full);
+    test_node[3].session.master[0] ^= 1;
+    test_step++;
+    if (host_tls_handshake(&test_node[3], &full) == 0) {
+        test_fail("handshake with wrong master secret succeeded", test_step);
+    }
+    if (test_node[3].session.id_len) {
+        test_fail("failed session kept", test_step);
+    }
+    test_handshake(&test_node[3], false, &full);
+}
+
+static void test_nvm_restart(void)
+{
+    nvm_tlv_t *tlv = calloc(1, sizeof(nvm_tlv_t) + PAE_NVM_TLS_SESSION_CACHE_LEN);
+    host_tls_result_t result;
+
+    tls_sec_prot_session_cache_init(TLS_SESSION_CACHE_SIZE);
+    for (int i = 0; i < TEST_NODES; i++) {
+        test_handshake(&test_node[i], false, &result);
+    }
+    tls_sec_prot_session_cache_timer(100);
+    test_handshake(&test_node[1], true, &result);
+    ws_pae_nvm_store_tls_session_cache_tlv_create(tlv);
+
+    /* Restart after a day: the node that resumed last has the most lifetime left */
+    tls_sec_prot_session_cache_init(TLS_SESSION_CACHE_SIZE);
+    ws_pae_current_time_update(24 * 3600 / 2);
+    ws_pae_current_time_update(24 * 3600 / 2);
+    if (ws_pae_nvm_store_tls_session_cache_tlv_read(tlv) < 0 || tls_sec_prot_session_cache_updated_get()) {
+        test_fail("NVM read", test_step);
+    }
+    for (int i = 0; i < TEST_NODES; i++) {
+        test_handshake(&test_node[i], true, &result);
+    }
+
+    /* Lifetimes count from when the cache was stored */
+    ws_pae_nvm_store_tls_session_cache_tlv_create(tlv);
+    tls_sec_prot_session_cache_init(TLS_SESSION_CACHE_SIZE);
+    for (uint32_t left = host_tls_session_lifetime; left; left -= left > 60000 ? 60000 : left) {
+        ws_pae_current_time_update(left > 60000 ? 60000 : left);
+    }
+    if (ws_pae_nvm_store_tls_session_cache_tlv_read(tlv) < 0) {
+        test_fail("NVM read", test_step);
+    }
+    test_handshake(&test_node[0], false, &result);
+
+    free(tlv);
+}
+
+int main(void)
+{
+    srand(1);
+    host_tls_init();
+    for (int i = 0; i < TEST_NODES; i++) {
+        static const uint8_t eui_64[8] = {0x00, 0x12, 0x4b, 0x00, 0x1a, 0x2b, 0x3c, 0x00};
+        memcpy(test_node[i].eui_64, eui_64, 8);
+        test_node[i].eui_64[7] = i;
+    }
+
+    test_resumption();
+    test_nvm_restart();
+    tls_sec_prot_session_cache_delete();
+
+    printf("OK: %d handshakes\n", test_step);
+    return 0;
+}
@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Randomised test of the TLS session cache against a model of its slots.
+ *
+ * Each round sizes the cache anew and applies random writes, reads,
+ * deletes, flushes and timer ticks from a few supplicants that share a
+ * small pool of session identifiers. After each operation the cache must
+ * match the model: the same sessions in the same slots with the same
+ * lifetimes, the same read results and the same updated flag. Each round
+ * ends with a store to the NVM TLV and a read back after a random time,
+ * which must keep the sessions with lifetime left and nothing else.
+ *
+ * Usage: tls_session_cache_test [rounds]
+ */
+
+#include "nsconfig.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ns_types.h"
+#include "ns_list.h"
+#include "6LoWPAN/ws/ws_config.h"
+#include "Security/protocols/sec_prot_certs.h"
+#include "Security/protocols/sec_prot_keys.h"
+#include "6LoWPAN/ws/ws_pae_nvm_store.h"
+#include "6LoWPAN/ws/ws_pae_nvm_data.h"
+#include "6LoWPAN/ws/ws_pae_time.h"
+#include "Security/protocols/tls_sec_prot/tls_sec_prot_lib.h"
+#include "Security/protocols/tls_sec_prot/tls_sec_prot_session_cache.h"
+
+#define TEST_SUPPLICANTS    6
+#define TEST_SESSION_IDS    8
+#define TEST_OPERATIONS     200
+
+typedef struct {
+    uint8_t eui_64[8];
+    tls_sec_prot_lib_session_t session;
+    uint32_t lifetime;
+} model_entry_t;
+
+static model_entry_t model[TLS_SESSION_CACHE_SIZE];
+static uint16_t model_size;
+static bool model_updated;
+
+static uint8_t test_eui_64[TEST_SUPPLICANTS][8];
+static tls_sec_prot_lib_session_t test_session[TEST_SESSION_IDS];
+
+static void test_fail(const char *what, int round)
+{
+    printf("FAIL: %s in round %d\n", what, round);
+    exit(1);
+}
+
+static model_entry_t *model_eui_64_entry_get(const uint8_t *eui_64)
+{
+    for (uint16_t index = 0; index < model_size; index++) {
+        if (model[index].lifetime > 0 && memcmp(model[index].eui_64, eui_64, 8) == 0) {
+            return &model[index];
+        }
+    }
+    return NULL;
+}
+
+static void model_write(const uint8_t *eui_64, const tls_sec_prot_lib_session_t *session, uint32_t lifetime)
+{
+    model_entry_t *entry = model_eui_64_entry_get(eui_64);
+
+    if (!entry) {
+        // First free slot, otherwise the first one with the least lifetime
+        entry = &model[0];
+        for (uint16_t index = 0; index < model_size; index++) {
+            if (model[index].lifetime == 0) {
+                entry = &model[index];
+                break;
+            }
+            if (model[index].lifetime < entry->lifetime) {
+                entry = &model[index];
+            }
+        }
+    }
+    memcpy(entry->eui_64, eui_64, 8);
+    entry->session = *session;
+    entry->lifetime = lifetime;
+    model_updated = true;
+}
+
+static int8_t model_read(const uint8_t *eui_64, tls_sec_prot_lib_session_t *session)
+{
+    for (uint16_t index = 0; index < model_size; index++) {
+        model_entry_t *entry = &model[index];
+        if (entry->lifetime == 0 || entry->session.id_len != session->id_len ||
+                memcmp(entry->session.id, session->id, session->id_len) != 0) {
+            continue;
+        }
+        if (memcmp(entry->eui_64, eui_64, 8) != 0) {
+            return -1;
+        }
+        *session = entry->session;
+        return 0;
+    }
+    return -1;
+}
+
+static void model_timer(uint16_t seconds)
+{
+    for (uint16_t index = 0; index < model_size; index++) {
+        if (model[index].lifetime > seconds) {
+            model[index].lifetime -= seconds;
+        } else {
+            memset(&model[index], 0, sizeof(model_entry_t));
+        }
+    }
+}
+
+static bool test_session_equal(const tls_sec_prot_lib_session_t *a, const tls_sec_prot_lib_session_t *b)
+{
+    return a->id_len == b->id_len && memcmp(a->id, b->id, TLS_SESSION_ID_LEN) == 0 &&
+           memcmp(a->master, b->master, TLS_MASTER_SECRET_LEN) == 0 && a->ciphersuite == b->ciphersuite;
+}
+
+static void test_compare(int round)
+{
+    if (tls_sec_prot_session_cache_size_get() != model_size) {
+        test_fail("cache size", round);
+    }
+    if (tls_sec_prot_session_cache_updated_get() != model_updated) {
+        test_fail("updated flag", round);
+    }
+    for (uint16_t index = 0; index < model_size; index++) {
+        uint8_t eui_64[8];
+        tls_sec_prot_lib_session_t session;
+        uint32_t lifetime;
+
+        if (tls_sec_prot_session_cache_entry_get(index, eui_64, &session, &lifetime) < 0) {
+            if (model[index].lifetime) {
+                test_fail("entry missing", round);
+            }
+            continue;
+        }
+        if (lifetime != model[index].lifetime || memcmp(eui_64, model[index].eui_64, 8) ||
+                !test_session_equal(&session, &model[index].session)) {
+            test_fail("entry differs", round);
+        }
+    }
+}
+
+static void test_nvm(int round)
+{
+    static uint8_t buffer[sizeof(nvm_tlv_t) + PAE_NVM_TLS_SESSION_CACHE_LEN];
+    nvm_tlv_t *tlv = (nvm_tlv_t *) buffer;
+    model_entry_t stored[TLS_SESSION_CACHE_SIZE];
+
+    ws_pae_nvm_store_tls_session_cache_tlv_create(tlv);
+    memcpy(stored, model, sizeof(stored));
+
+    uint32_t elapsed = rand() % 4 == 0 ? 0 : rand() % 2000;
+    ws_pae_current_time_update(elapsed);
+
+    tls_sec_prot_session_cache_init(model_size);
+    memset(model, 0, sizeof(model));
+    if (ws_pae_nvm_store_tls_session_cache_tlv_read(tlv) < 0) {
+        test_fail("NVM read", round);
+    }
+    for (uint16_t index = 0; index < model_size; index++) {
+        if (stored[index].lifetime > elapsed) {
+            model_write(stored[index].eui_64, &stored[index].session, stored[index].lifetime - elapsed);
+        }
+    }
+    model_updated = false;
+    test_compare(round);
+
+    tlv->tag++;
+    if (ws_pae_nvm_store_tls_session_cache_tlv_read(tlv) == 0) {
+        test_fail("NVM read of other tag", round);
+    }
+}
+
+static void test_round(int round)
+{
+    model_size = 1 + rand() % TLS_SESSION_CACHE_SIZE;
+    model_updated = false;
+    memset(model, 0, sizeof(model));
+    tls_sec_prot_session_cache_init(model_size);
+
+    for (int op = 0; op < TEST_OPERATIONS; op++) {
+        const uint8_t *eui_64 = test_eui_64[rand() % TEST_SUPPLICANTS];
+        tls_sec_prot_lib_session_t session = test_session[rand() % TEST_SESSION_IDS];
+        tls_sec_prot_lib_session_t model_session = session;
+
+        switch (rand() % 8) {
+            case 0:
+            case 1:
+            case 2: {
+                uint32_t lifetime = rand() % 8 == 0 ? 0 : 1 + rand() % 1000;
+                session.master[0] = rand();
+                if (lifetime == 0) {
+                    if (tls_sec_prot_session_cache_write(eui_64, &session, lifetime) == 0) {
+                        test_fail("write with no lifetime", round);
+                    }
+                    break;
+                }
+                if (tls_sec_prot_session_cache_write(eui_64, &session, lifetime) < 0) {
+                    test_fail("write", round);
+                }
+                model_write(eui_64, &session, lifetime);
+                break;
+            }
+            case 3:
+            case 4: {
+                memset(session.master, 0, sizeof(session.master));
+                session.ciphersuite = 0;
+                memset(model_session.master, 0, sizeof(model_session.master));
+                model_session.ciphersuite = 0;
+                int8_t ret = tls_sec_prot_session_cache_read(eui_64, &session);
+                if (ret != model_read(eui_64, &model_session) || !test_session_equal(&session, &model_session)) {
+                    test_fail("read", round);
+                }
+                break;
+            }
+            case 5: {
+                model_entry_t *entry = model_eui_64_entry_get(eui_64);
+                if (tls_sec_prot_session_cache_supp_delete(eui_64) != (entry != NULL)) {
+                    test_fail("delete", round);
+                }
+                if (entry) {
+                    memset(entry, 0, sizeof(model_entry_t));
+                    model_updated = true;
+                }
+                break;
+            }
+            case 6:
+                if (rand() % 4 == 0) {
+                    tls_sec_prot_session_cache_flush();
+                    for (uint16_t index = 0; index < model_size; index++) {
+                        if (model[index].lifetime) {
+                            memset(&model[index], 0, sizeof(model_entry_t));
+                            model_updated = true;
+                        }
+                    }
+                } else {
+                    tls_sec_prot_session_cache_updated_reset();
+                    model_updated = false;
+                }
+                break;
+            default: {
+                uint16_t seconds = rand() % 200;
+                tls_sec_prot_session_cache_timer(seconds);
+                model_timer(seconds);
+                break;
+            }
+        }
+        test_compare(round);
+    }
+
+    test_nvm(round);
+}
+
+int main(int argc, char *argv[])
+{
+    int rounds = argc > 1 ? atoi(argv[1]) : 1000;
+
+    srand(1);
+    for (int i = 0; i < TEST_SUPPLICANTS; i++) {
+        for (int j = 0; j < 8; j++) {
+            test_eui_64[i][j] = rand();
+        }
+    }
+    for (int i = 0; i < TEST_SESSION_IDS; i++) {
+        test_session[i].id_len = 1 + rand() % TLS_SESSION_ID_LEN;
+        for (int j = 0; j < TLS_SESSION_ID_LEN; j++) {
+            test_session[i].id[j] = j < test_session[i].id_len ? rand() : 0;
+        }
+        for (int j = 0; j < TLS_MASTER_SECRET_LEN; j++) {
+            test_session[i].master[j] = rand();
+        }
+        test_session[i].ciphersuite = rand();
+    }
+    ws_pae_current_time_set(1700000000);
+
+    for (int round = 0; round < rounds; round++) {
+        test_round(round);
+    }
+    tls_sec_prot_session_cache_delete();
+
+    printf("OK: %d rounds of %d operations\n", rounds, TEST_OPERATIONS);
+    return 0;
+}
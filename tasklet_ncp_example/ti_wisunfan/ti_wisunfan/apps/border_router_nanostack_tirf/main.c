@@ -247,6 +247,11 @@ int main(void)
     // Initialize mesh system and start the event loop thread
     mesh_system_init();
 
+#ifdef NS_TRACE_DEFERRED
+    // Traces are drained to ITM by a tasklet, on NCP they go to host instead
+    ns_trace_deferred_tasklet_start();
+#endif
+
 #else // WISUN_NCP_ENABLE
     ncp_enabled = true;
 
@@ -71,6 +71,7 @@
  *****************************************************************************/
 
 #include <ti/drivers/dpl/SystemP.h>
+#include <ti/drivers/dpl/ClockP.h>
 
 #include <semaphore.h>
 
@@ -89,6 +90,12 @@
 
 #include <ioc.h>
 
+#ifdef NS_TRACE_DEFERRED
+#include "eventOS_event.h"
+#include "eventOS_event_timer.h"
+#include "net_interface.h"
+#endif
+
 #define ITM_STIM_PORT_8(x)    (*(volatile uint8_t *) ITM_STIM_PORT((x)))
 #define ITM_STIM_PORT_32(x)   (*(volatile uint32_t *) ITM_STIM_PORT((x)))
 
@@ -102,6 +109,63 @@
 
 #define DEFAULT_TRACE_TMP_LINE_LEN  128
 
+#ifdef NS_TRACE_DEFERRED
+/*
+ * Deferred binary trace: ns_trace_vprintf() does no formatting or output, it
+ * stores the format string address, group address, level, a timestamp and
+ * the raw arguments in a ring buffer, from any context. The ring is drained
+ * by a low priority tasklet to ITM_DEFERRED_PORT or, on the NCP, to the host
+ * as SPINEL_PROP_STREAM_LOG_BINARY; tools/ns_trace_decode.py turns the
+ * records back into text using the format strings in the ELF file.
+ *
+ * Record (32-bit little endian words):
+ *   header    : length in words (bits 0-15), level (16-23), type (24-31)
+ *   fmt       : address of format string
+ *   grp       : address of trace group string
+ *   timestamp : ClockP system ticks
+ *   arguments : one word per int/pointer, two per 64-bit integer or
+ *               double, strings inline as a length word + bytes padded to
+ *               a word. '*' width/precision are stored as int arguments.
+ *
+ * Arguments that don't fit NS_TRACE_DEFERRED_RECORD_WORDS are left out.
+ */
+#ifndef NS_TRACE_DEFERRED_RING_WORDS
+#define NS_TRACE_DEFERRED_RING_WORDS    512     // Must be power of two
+#endif
+#ifndef NS_TRACE_DEFERRED_RECORD_WORDS
+#define NS_TRACE_DEFERRED_RECORD_WORDS  32
+#endif
+#ifndef NS_TRACE_DEFERRED_STRING_MAX
+#define NS_TRACE_DEFERRED_STRING_MAX    48
+#endif
+#ifndef NS_TRACE_DEFERRED_DRAIN_MS
+#define NS_TRACE_DEFERRED_DRAIN_MS      100
+#endif
+
+#define ITM_DEFERRED_PORT 1
+
+#define NS_TRACE_REC_TYPE_TRACE     0xA5u   // Trace record
+#define NS_TRACE_REC_TYPE_PAD       0xA6u   // Unused ring space up to wrap, never drained
+#define NS_TRACE_REC_TYPE_DROPPED   0xA7u   // Records lost to a full ring, count as argument
+#define NS_TRACE_REC_HEADER(words, level, type) \
+    ((uint32_t)(words) | ((uint32_t)(level) << 16) | ((uint32_t)(type) << 24))
+#define NS_TRACE_REC_WORDS(header)  ((header) & 0xFFFF)
+#define NS_TRACE_REC_TYPE(header)   ((header) >> 24)
+#define NS_TRACE_REC_FIXED_WORDS    4
+
+#define NS_TRACE_DEFERRED_DRAIN_EVENT 1
+
+static uint32_t ns_trace_ring[NS_TRACE_DEFERRED_RING_WORDS];
+static uint32_t ns_trace_ring_head;     // Words reserved by writers
+static uint32_t ns_trace_ring_tail;     // Words drained
+static uint32_t ns_trace_dropped;
+static uint32_t ns_trace_dropped_reported;
+static uint32_t ns_trace_peek_tail;     // Ring position after the last peeked record
+static uint32_t ns_trace_peek_dropped;  // Drop count reported by the last peek
+static int8_t ns_trace_tasklet_id = -1;
+static bool ns_trace_drain_pending;
+#endif // NS_TRACE_DEFERRED
+
 typedef enum
 {
     ITM_9600 = 9600,
@@ -235,8 +299,303 @@ void ns_trace_printf(uint8_t dlevel, const char *grp, const char *fmt, ...)
     va_end(ap);
 }
 
+#ifdef NS_TRACE_DEFERRED
+static uint_fast16_t ns_trace_deferred_args(uint32_t *rec, uint_fast16_t words, const char *fmt, va_list ap)
+{
+    while (*fmt) {
+        if (*fmt++ != '%') {
+            continue;
+        }
+
+        while (*fmt == '-' || *fmt == '+' || *fmt == ' ' || *fmt == '#' || *fmt == '0') {
+            fmt++;
+        }
+
+        // '*' width and precision are arguments in their own right
+        int precision = -1;
+        for (uint_fast8_t field = 0; field < 2; field++) {
+            if (field == 1) {
+                if (*fmt != '.') {
+                    break;
+                }
+                fmt++;
+                precision = 0;
+            }
+            if (*fmt == '*') {
+                int value = va_arg(ap, int);
+                if (words >= NS_TRACE_DEFERRED_RECORD_WORDS) {
+                    return words;
+                }
+                rec[words++] = value;
+                precision = field ? value : precision;
+                fmt++;
+            } else {
+                while (*fmt >= '0' && *fmt <= '9') {
+                    precision = field ? precision * 10 + (*fmt - '0') : precision;
+                    fmt++;
+                }
+            }
+        }
+
+        uint_fast8_t longs = 0;
+        bool size_t_arg = false;
+        while (*fmt == 'h' || *fmt == 'l' || *fmt == 'j' || *fmt == 'z' || *fmt == 't' || *fmt == 'L') {
+            if (*fmt == 'l') {
+                longs++;
+            } else if (*fmt == 'j') {
+                longs = 2;
+            } else if (*fmt == 'z' || *fmt == 't') {
+                size_t_arg = true;
+            }
+            fmt++;
+        }
+
+        uint64_t value;
+        uint_fast8_t value_words = 1;
+        switch (*fmt++) {
+            case 'd':
+            case 'i':
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X':
+            case 'c':
+                if (longs >= 2) {
+                    value = va_arg(ap, unsigned long long);
+                    value_words = 2;
+                } else if (longs) {
+                    value = va_arg(ap, unsigned long);
+                } else if (size_t_arg) {
+                    value = va_arg(ap, size_t);
+                } else {
+                    value = va_arg(ap, unsigned int);
+                }
+                break;
+            case 'p':
+                value = (uintptr_t) va_arg(ap, void *);
+                break;
+            case 'e':
+            case 'E':
+            case 'f':
+            case 'F':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A': {
+                double d = va_arg(ap, double);
+                memcpy(&value, &d, sizeof(value));
+                value_words = 2;
+                break;
+            }
+            case 's': {
+                const char *str = va_arg(ap, const char *);
+                if (!str) {
+                    str = "(null)";
+                }
+                size_t len = strlen(str);
+                if (len > NS_TRACE_DEFERRED_STRING_MAX) {
+                    len = NS_TRACE_DEFERRED_STRING_MAX;
+                }
+                if (precision >= 0 && len > (size_t) precision) {
+                    len = precision;
+                }
+                uint_fast16_t str_words = 1 + (len + 3) / 4;
+                if (words + str_words > NS_TRACE_DEFERRED_RECORD_WORDS) {
+                    return words;
+                }
+                rec[words] = len;
+                rec[words + str_words - 1] = 0;
+                memcpy(&rec[words + 1], str, len);
+                words += str_words;
+                continue;
+            }
+            case 'n':
+                (void) va_arg(ap, void *);
+                continue;
+            case '%':
+                continue;
+            default:
+                // Unknown conversion, can't tell what the rest of the arguments are
+                return words;
+        }
+
+        if (words + value_words > NS_TRACE_DEFERRED_RECORD_WORDS) {
+            return words;
+        }
+        rec[words++] = (uint32_t) value;
+        if (value_words == 2) {
+            rec[words++] = (uint32_t)(value >> 32);
+        }
+    }
+
+    return words;
+}
+
+/* Reserve ring space and copy the record in. Any number of writers, no locks:
+ * space is claimed by moving the head, and the header word is written last
+ * so the reader takes the record only once it is complete.
+ */
+static void ns_trace_deferred_put(const uint32_t *rec, uint_fast16_t words)
+{
+    uint32_t head = __atomic_load_n(&ns_trace_ring_head, __ATOMIC_RELAXED);
+    uint32_t offset, pad;
+
+    do {
+        // A record never wraps, skip what is left to the end of the ring
+        offset = head & (NS_TRACE_DEFERRED_RING_WORDS - 1);
+        pad = NS_TRACE_DEFERRED_RING_WORDS - offset;
+        if (pad >= words) {
+            pad = 0;
+        }
+        if (head + pad + words - __atomic_load_n(&ns_trace_ring_tail, __ATOMIC_ACQUIRE) > NS_TRACE_DEFERRED_RING_WORDS) {
+            __atomic_fetch_add(&ns_trace_dropped, 1, __ATOMIC_RELAXED);
+            return;
+        }
+    } while (!__atomic_compare_exchange_n(&ns_trace_ring_head, &head, head + pad + words, true, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED));
+
+    if (pad) {
+        __atomic_store_n(&ns_trace_ring[offset], NS_TRACE_REC_HEADER(pad, 0, NS_TRACE_REC_TYPE_PAD), __ATOMIC_RELEASE);
+        offset = 0;
+    }
+
+    memcpy(&ns_trace_ring[offset + 1], &rec[1], (words - 1) * sizeof(uint32_t));
+    __atomic_store_n(&ns_trace_ring[offset], rec[0], __ATOMIC_RELEASE);
+}
+
+static void ns_trace_deferred_vprintf(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
+{
+    uint32_t rec[NS_TRACE_DEFERRED_RECORD_WORDS];
+    uint_fast16_t words;
+
+    rec[1] = (uintptr_t) fmt;
+    rec[2] = (uintptr_t) grp;
+    rec[3] = ClockP_getSystemTicks();
+    words = ns_trace_deferred_args(rec, NS_TRACE_REC_FIXED_WORDS, fmt, ap);
+    rec[0] = NS_TRACE_REC_HEADER(words, dlevel, NS_TRACE_REC_TYPE_TRACE);
+
+    ns_trace_deferred_put(rec, words);
+}
+
+uint16_t ns_trace_deferred_peek(uint8_t *buf, uint16_t len)
+{
+    uint32_t tail = ns_trace_ring_tail;
+    uint16_t used = 0;
+
+    uint32_t dropped = __atomic_load_n(&ns_trace_dropped, __ATOMIC_RELAXED);
+    ns_trace_peek_dropped = ns_trace_dropped_reported;
+    if (dropped != ns_trace_dropped_reported && len >= (NS_TRACE_REC_FIXED_WORDS + 1) * sizeof(uint32_t)) {
+        uint32_t rec[NS_TRACE_REC_FIXED_WORDS + 1] = {
+            NS_TRACE_REC_HEADER(NS_TRACE_REC_FIXED_WORDS + 1, 0, NS_TRACE_REC_TYPE_DROPPED),
+            0,
+            0,
+            ClockP_getSystemTicks(),
+            dropped - ns_trace_dropped_reported
+        };
+        memcpy(buf, rec, sizeof(rec));
+        used = sizeof(rec);
+        ns_trace_peek_dropped = dropped;
+    }
+
+    for (;;) {
+        uint32_t offset = tail & (NS_TRACE_DEFERRED_RING_WORDS - 1);
+        uint32_t header = __atomic_load_n(&ns_trace_ring[offset], __ATOMIC_ACQUIRE);
+        if (!header || tail - ns_trace_ring_tail >= NS_TRACE_DEFERRED_RING_WORDS) {
+            // Empty, the next record is still being written, or the whole ring has been peeked
+            break;
+        }
+
+        uint_fast16_t words = NS_TRACE_REC_WORDS(header);
+        if (NS_TRACE_REC_TYPE(header) != NS_TRACE_REC_TYPE_PAD) {
+            if (used + words * sizeof(uint32_t) > len) {
+                break;
+            }
+            memcpy(buf + used, &ns_trace_ring[offset], words * sizeof(uint32_t));
+            used += words * sizeof(uint32_t);
+        }
+        tail += words;
+    }
+
+    ns_trace_peek_tail = tail;
+    return used;
+}
+
+void ns_trace_deferred_commit(void)
+{
+    uint32_t tail = ns_trace_ring_tail;
+
+    while (tail != ns_trace_peek_tail) {
+        uint32_t offset = tail & (NS_TRACE_DEFERRED_RING_WORDS - 1);
+        uint_fast16_t words = NS_TRACE_REC_WORDS(ns_trace_ring[offset]);
+
+        // Ring is kept zeroed, so a stale word is never taken for a header
+        memset(&ns_trace_ring[offset], 0, words * sizeof(uint32_t));
+        tail += words;
+        __atomic_store_n(&ns_trace_ring_tail, tail, __ATOMIC_RELEASE);
+    }
+
+    ns_trace_dropped_reported = ns_trace_peek_dropped;
+}
+
+uint16_t ns_trace_deferred_read(uint8_t *buf, uint16_t len)
+{
+    uint16_t used = ns_trace_deferred_peek(buf, len);
+    ns_trace_deferred_commit();
+    return used;
+}
+
+static void ns_trace_deferred_tasklet(arm_event_s *event)
+{
+    uint32_t rec[NS_TRACE_DEFERRED_RECORD_WORDS];
+    uint16_t len;
+
+    if (event->event_type == ARM_LIB_TASKLET_INIT_EVENT) {
+        ns_trace_tasklet_id = event->receiver;
+        arm_event_s drain_event = {
+            .receiver = ns_trace_tasklet_id,
+            .sender = ns_trace_tasklet_id,
+            .event_type = NS_TRACE_DEFERRED_DRAIN_EVENT,
+            .priority = ARM_LIB_LOW_PRIORITY_EVENT,
+        };
+        eventOS_event_timer_request_every(&drain_event, eventOS_event_timer_ms_to_ticks(NS_TRACE_DEFERRED_DRAIN_MS));
+        return;
+    }
+
+    if (ns_trace_drain_pending && event->event_id == 0) {
+        // Periodic tick while a drain is already queued
+        return;
+    }
+    ns_trace_drain_pending = false;
+
+    // One record buffer per event, so other events get a turn in between
+    len = ns_trace_deferred_read((uint8_t *) rec, sizeof(rec));
+    for (uint16_t i = 0; i < len / sizeof(uint32_t); i++) {
+        while (0 == ITM_STIM_PORT_32(ITM_DEFERRED_PORT));
+        ITM_STIM_PORT_32(ITM_DEFERRED_PORT) = rec[i];
+    }
+
+    if (len) {
+        arm_event_s drain_event = {
+            .receiver = ns_trace_tasklet_id,
+            .sender = ns_trace_tasklet_id,
+            .event_type = NS_TRACE_DEFERRED_DRAIN_EVENT,
+            .event_id = 1,
+            .priority = ARM_LIB_LOW_PRIORITY_EVENT,
+        };
+        ns_trace_drain_pending = eventOS_event_send(&drain_event) == 0;
+    }
+}
+
+void ns_trace_deferred_tasklet_start(void)
+{
+    eventOS_event_handler_create(&ns_trace_deferred_tasklet, ARM_LIB_TASKLET_INIT_EVENT);
+}
+#endif // NS_TRACE_DEFERRED
+
 void ns_trace_vprintf(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
 {
+#ifdef NS_TRACE_DEFERRED
+    ns_trace_deferred_vprintf(dlevel, grp, fmt, ap);
+#else
     sem_wait(&ns_trace_mutex_handle);
     int len_written = 0, total_len =0, remaining_len;
     uint8_t *pBuf;
@@ -293,6 +652,7 @@ void ns_trace_vprintf(uint8_t dlevel, const char *grp, const char *fmt, va_list
         ns_put_char_blocking(ns_buf[x]);
     }
     sem_post(&ns_trace_mutex_handle);
+#endif // NS_TRACE_DEFERRED
 }
 
 void ns_enable_module(void)
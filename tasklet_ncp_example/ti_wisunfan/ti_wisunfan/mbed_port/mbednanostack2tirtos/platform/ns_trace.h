@@ -138,5 +138,15 @@ char *ns_trace_array16(const uint16_t *buf, uint16_t len);
 void ns_enable_module();
 void ns_disable_module(void);
 void ns_trace_vprintf(uint8_t dlevel, const char *grp, const char *fmt, va_list ap);
+#ifdef NS_TRACE_DEFERRED
+/** Move whole deferred trace records (see ns_trace.c) to buf, return bytes written */
+uint16_t ns_trace_deferred_read(uint8_t *buf, uint16_t len);
+/** Copy whole deferred trace records to buf like ns_trace_deferred_read(), but leave them in the ring */
+uint16_t ns_trace_deferred_peek(uint8_t *buf, uint16_t len);
+/** Remove the records returned by the last ns_trace_deferred_peek() from the ring */
+void ns_trace_deferred_commit(void);
+/** Drain deferred trace records to ITM from a low priority tasklet - not for NCP builds */
+void ns_trace_deferred_tasklet_start(void);
+#endif
 
 #endif /* NS_TRACE_H_ */
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * The parts of the TI drivers and the event loop that ns_trace.c calls out
+ * to. The deferred drain tasklet is never started, the tests and the
+ * benchmark read the ring as the NCP does.
+ */
+
+#include <stdint.h>
+#include "eventOS_event.h"
+#include "eventOS_event_timer.h"
+#include "ti/drivers/dpl/ClockP.h"
+#include "itm_private.h"
+
+volatile uint32_t host_itm_stimulus[32] = {
+    0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+    0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+    0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+    0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+};
+
+volatile uint32_t host_itm_register;
+
+uint32_t host_clock_ticks;
+
+uint32_t ClockP_getSystemTicks(void)
+{
+    return host_clock_ticks;
+}
+
+int8_t eventOS_event_handler_create(void (*handler_func_ptr)(arm_event_t *), uint8_t init_event_type)
+{
+    (void) handler_func_ptr;
+    (void) init_event_type;
+    return -1;
+}
+
+int8_t eventOS_event_send(const arm_event_t *event)
+{
+    (void) event;
+    return -1;
+}
+
+arm_event_storage_t *eventOS_event_timer_request_every(const struct arm_event_s *event, int32_t period)
+{
+    (void) event;
+    (void) period;
+    return NULL;
+}
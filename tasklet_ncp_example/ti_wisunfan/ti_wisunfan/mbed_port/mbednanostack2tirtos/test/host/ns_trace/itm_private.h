@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Host stand-in for the ITM, TPIU and DWT registers. The stimulus ports are
+ * words of host_itm_stimulus[], which read as ready until a zero is written,
+ * and every other register is the one word host_itm_register.
+ */
+
+#ifndef ITM_PRIVATE_H_
+#define ITM_PRIVATE_H_
+
+#include <stdint.h>
+
+extern volatile uint32_t host_itm_stimulus[32];
+extern volatile uint32_t host_itm_register;
+
+#define SCS_DEMCR               host_itm_register
+#define SCS_DEMCR_TRCEN         (0x01000000)
+
+#define CS_LAR_UNLOCK           (0xC5ACCE55)
+
+#define ITM_STIM_PORT(x)        ((uintptr_t) &host_itm_stimulus[(x)])
+
+#define ITM_TER                 host_itm_register
+#define ITM_TER_ENABLE_ALL      (0xFFFFFFFF)
+
+#define ITM_TCR                 host_itm_register
+#define ITM_TCR_ENABLE_ITM      (0x00000001)
+#define ITM_TCR_ENABLE_TS       (0x00000002)
+#define ITM_TCR_ENABLE_SYNC     (0x00000004)
+#define ITM_TCR_ENABLE_DWT_TX   (0x00000008)
+#define ITM_TCR_ENABLE_SWO      (0x00000010)
+#define ITM_TCR_BUSY            (0x00800000)
+#define ITM_TCR_TS_PRESCALE_SHIFT  (8)
+#define ITM_TCR_TS_PRESCALE_MASK   (0x00000300)
+
+#define ITM_TPR                 host_itm_register
+#define ITM_TPR_ENABLE_USER_ALL (0x0000000F)
+
+#define ITM_LAR                 host_itm_register
+
+#define TPIU_ACPR               host_itm_register
+#define TPIU_SPPR               host_itm_register
+#define TPIU_SPPR_SWO_UART      (0x00000002)
+#define TPIU_FFCR               host_itm_register
+#define TPIU_LAR                host_itm_register
+#define TPIU_CSPSR              host_itm_register
+#define TPIU_CSPSR_PIN_1        (0x00000001)
+
+#define DWT_CTRL                 host_itm_register
+#define DWT_CTRL_MASK_NUM_COMP   (0xF0000000)
+#define DWT_CTRL_SHIFT_NUM_COMP  (28)
+#define DWT_CTRL_ENABLE_PC_SAMP  (0x00001000)
+#define DWT_CTRL_ENABLE_EXC_TRC  (0x00010000)
+#define DWT_CTRL_ENABLE_CYC_EVT  (0x00400000)
+#define DWT_CTRL_ENABLE_CYC_CNT  (0x00000001)
+#define DWT_CTRL_CYC_CNT_1024    (0x0000001E)
+#define DWT_CTRL_MASK_SYNCTAP    (0x00000C00)
+#define DWT_CTRL_SHIFT_SYNCTAP   (10)
+
+#define DWT_LAR                  host_itm_register
+#define DWT_COMP(x)              host_itm_register
+#define DWT_MASK(x)              host_itm_register
+#define DWT_FUNC(x)              host_itm_register
+#define DWT_FUNC_DATA_SIZE_32       (0x00000800)
+#define DWT_FUNC_ENABLE_DATA_MATCH  (0x00000100)
+#define DWT_FUNC_ENABLE_ADDR_OFFSET (0x00000020)
+#define DWT_FUNC_ENABLE_COMP_RW     (0x00000002)
+
+#endif /* ITM_PRIVATE_H_ */
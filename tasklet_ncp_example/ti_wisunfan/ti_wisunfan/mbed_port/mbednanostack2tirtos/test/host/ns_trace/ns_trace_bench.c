@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Benchmark of the cost of a trace to the caller.
+ *
+ * Built as is, a trace is formatted with vsnprintf and written out a
+ * character at a time to the ITM stimulus port, which is always ready
+ * here. Built with NS_TRACE_DEFERRED, it is packed into the ring, which is
+ * drained every eight traces as the NCP does. Only the public API is used,
+ * so this also builds against older revisions without the ring.
+ *
+ * Usage: ns_trace_bench [traces]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "ns_types.h"
+#include "ns_trace.h"
+
+#define TRACE_GROUP "mMCP"
+
+static double bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void bench_drain(int i)
+{
+#ifdef NS_TRACE_DEFERRED
+    static uint8_t buf[512];
+
+    if ((i & 7) == 7) {
+        while (ns_trace_deferred_read(buf, sizeof(buf)));
+    }
+#else
+    (void) i;
+#endif
+}
+
+int main(int argc, char *argv[])
+{
+    static const uint8_t address[8] = {0x00, 0x12, 0x4b, 0x00, 0x1a, 0x2b, 0x3c, 0x4d};
+    int traces = argc > 1 ? atoi(argv[1]) : 200000;
+
+    ns_trace_init();
+
+    double t0 = bench_now_ns();
+    for (int i = 0; i < traces; i++) {
+        tr_debug("MCPS Data Req: handle %u, status %u", i & 0xff, 0);
+        bench_drain(i);
+    }
+    double t1 = bench_now_ns();
+    for (int i = 0; i < traces; i++) {
+        tr_debug("MCPS Data Req: handle %u, len %u, dst %s", i & 0xff, 100 + (i & 63), trace_array(address, 8));
+        bench_drain(i);
+    }
+    double t2 = bench_now_ns();
+    for (int i = 0; i < traces; i++) {
+        tr_info("int %d hex %08x ll %lld str %.3s", -i, (unsigned) i * 2654435761u, (long long) i << 33, "abcdef");
+        bench_drain(i);
+    }
+    double t3 = bench_now_ns();
+
+    printf("%s: two integers %.0f ns, trace_array %.0f ns, mixed %.0f ns per trace\n",
+#ifdef NS_TRACE_DEFERRED
+           "deferred",
+#else
+           "text",
+#endif
+           (t1 - t0) / traces, (t2 - t1) / traces, (t3 - t2) / traces);
+    return 0;
+}
@@ -0,0 +1,379 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Test of the deferred binary trace ring and its decoder.
+ *
+ * Traces with the conversions the stack uses and random arguments go into
+ * the ring, which is drained at random points into a capture file as the
+ * NCP drains it: some peeks are repeated before the commit, as when the TX
+ * buffer is full, and now and then the ring is left to fill up so that
+ * traces are dropped. The text each trace should decode to goes to a
+ * second file, and build.sh decodes the capture with
+ * tools/ns_trace_decode.py and compares the two. After every drain the ring
+ * must be zero outside the records still in it.
+ *
+ * Then writer threads trace at once against one reader. Every record must
+ * come out whole and in order per writer, or be counted as dropped.
+ *
+ * Usage: ns_trace_test <capture> <expected text> [writer threads] [traces per writer]
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/* The ring and the record layout are static in ns_trace.c */
+#include "../../../platform/ns_trace.c"
+
+#define TEST_TRACES         20000
+#define TEST_LINE_MAX       512
+#define TEST_PENDING_MAX    NS_TRACE_DEFERRED_RING_WORDS
+#define TEST_WRITERS_MAX    16
+
+static const uint8_t test_levels[] = {TRACE_LEVEL_DEBUG, TRACE_LEVEL_INFO, TRACE_LEVEL_WARN, TRACE_LEVEL_ERROR, TRACE_LEVEL_CMD};
+static const char *const test_groups[] = {"mMCP", "6lAd", "x"};
+
+static FILE *test_capture;
+static FILE *test_expected;
+
+/* Expected lines of the records in the ring, oldest first */
+static char test_pending[TEST_PENDING_MAX][TEST_LINE_MAX];
+static int test_pending_first;
+static int test_pending_count;
+static uint32_t test_dropped;
+
+static void test_fail(const char *what, int round)
+{
+    printf("FAIL: %s in round %d\n", what, round);
+    exit(1);
+}
+
+/* As the decoder names the levels */
+static const char *test_level_name(uint8_t level)
+{
+    switch (level) {
+        case TRACE_LEVEL_DEBUG:
+            return "DBG ";
+        case TRACE_LEVEL_INFO:
+            return "INFO";
+        case TRACE_LEVEL_WARN:
+            return "WARN";
+        case TRACE_LEVEL_ERROR:
+            return "ERR ";
+        default:
+            return "CMD ";
+    }
+}
+
+static void test_trace_va(const char *text, uint8_t level, const char *grp, const char *fmt, va_list ap)
+{
+    uint32_t dropped = ns_trace_dropped;
+
+    if ((uintptr_t) fmt > UINT32_MAX || (uintptr_t) grp > UINT32_MAX) {
+        test_fail("strings above 4 GB, build with -no-pie", 0);
+    }
+
+    ns_trace_vprintf(level, grp, fmt, ap);
+    if (ns_trace_dropped != dropped) {
+        test_dropped++;
+    } else {
+        if (test_pending_count == TEST_PENDING_MAX) {
+            test_fail("more records than the ring holds", 0);
+        }
+        snprintf(test_pending[(test_pending_first + test_pending_count++) % TEST_PENDING_MAX], TEST_LINE_MAX,
+                 "%10u [%s][%-4s]: %s\n", (unsigned) host_clock_ticks, test_level_name(level), grp, text);
+    }
+    host_clock_ticks += rand() % 1000;
+}
+
+/* A trace that decodes to what the C library formats */
+static void test_trace(uint8_t level, const char *grp, const char *fmt, ...)
+{
+    char text[TEST_LINE_MAX];
+    va_list ap;
+    va_list copy;
+
+    va_start(ap, fmt);
+    va_copy(copy, ap);
+    vsnprintf(text, sizeof(text), fmt, copy);
+    va_end(copy);
+    test_trace_va(text, level, grp, fmt, ap);
+    va_end(ap);
+}
+
+/* A trace that the ring cuts short */
+static void test_trace_expect(const char *text, uint8_t level, const char *grp, const char *fmt, ...)
+{
+    va_list ap;
+
+    va_start(ap, fmt);
+    test_trace_va(text, level, grp, fmt, ap);
+    va_end(ap);
+}
+
+static void test_random_string(char *str, int max)
+{
+    int len = rand() % (max + 1);
+
+    for (int i = 0; i < len; i++) {
+        str[i] = 'a' + rand() % 26;
+    }
+    str[len] = 0;
+}
+
+static void test_random_trace(void)
+{
+    static const char long_string[] = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    uint8_t level = test_levels[rand() % sizeof(test_levels)];
+    const char *grp = test_groups[rand() % 3];
+    uint8_t address[8];
+    char str[2][24];
+    char text[TEST_LINE_MAX];
+    unsigned r = rand();
+    unsigned s = rand();
+
+    for (int i = 0; i < 8; i++) {
+        address[i] = rand();
+    }
+    test_random_string(str[0], 20);
+    test_random_string(str[1], 20);
+
+    switch (rand() % 10) {
+        case 0:
+            test_trace(level, grp, "MCPS Data Req: handle %u, len %u, dst %s", r & 0xff, s % 1280, trace_array(address, 8));
+            break;
+        case 1:
+            test_trace(level, grp, "int %d hex %08x ll %lld str %.3s", -(int) r, r * 2654435761u, (long long)((unsigned long long) s << 33) - r, str[0]);
+            break;
+        case 2:
+            test_trace(level, grp, "%-6s|%6s|%c|%%|%#x|%02u|%i", str[0], str[1], 'a' + r % 26, s, r % 100, (int) s - (int) r);
+            break;
+        case 3:
+            test_trace(level, grp, "%*d|%-*.*s|%.*s", (int)(r % 10), (int) s, (int)(s % 12), (int)(r % 8), str[0], (int)(s % 30), str[1]);
+            break;
+        case 4:
+            test_trace(level, grp, "%.2f %g %e", r / 7.0, -(double) s / 1024, (double) r * s);
+            break;
+        case 5:
+            test_trace(level, grp, "%zu %lu %ld %hu %hhx %2.2x %2.0d", (size_t) r, (unsigned long) s, -(long) r, r, s, r & 0xff, r % 3 + 1);
+            break;
+        case 6:
+            /* Strings are cut to NS_TRACE_DEFERRED_STRING_MAX */
+            snprintf(text, sizeof(text), "name %.*s end", NS_TRACE_DEFERRED_STRING_MAX, long_string + r % 10);
+            test_trace_expect(text, level, grp, "name %s end", long_string + r % 10);
+            break;
+        case 7:
+            /* Arguments past NS_TRACE_DEFERRED_RECORD_WORDS are left out */
+            snprintf(text, sizeof(text), "%u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u <?>...",
+                     r, r + 1, r + 2, r + 3, r + 4, r + 5, r + 6, r + 7, r + 8, r + 9, r + 10, r + 11, r + 12, r + 13,
+                     r + 14, r + 15, r + 16, r + 17, r + 18, r + 19, r + 20, r + 21, r + 22, r + 23, r + 24, r + 25, r + 26, r + 27);
+            test_trace_expect(text, level, grp, "%u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u",
+                              r, r + 1, r + 2, r + 3, r + 4, r + 5, r + 6, r + 7, r + 8, r + 9, r + 10, r + 11, r + 12, r + 13, r + 14,
+                              r + 15, r + 16, r + 17, r + 18, r + 19, r + 20, r + 21, r + 22, r + 23, r + 24, r + 25, r + 26, r + 27,
+                              r + 28, r + 29);
+            break;
+        case 8:
+            snprintf(text, sizeof(text), "(null)|%u", r);
+            test_trace_expect(text, level, grp, "%s|%u", (const char *) NULL, r);
+            break;
+        default:
+            test_trace(level, grp, "plain text, 100%%");
+            break;
+    }
+}
+
+/* Outside the records still in it, the ring must be zero */
+static bool test_ring_zeroed(void)
+{
+    for (uint32_t i = ns_trace_ring_head; i != ns_trace_ring_tail + NS_TRACE_DEFERRED_RING_WORDS; i++) {
+        if (ns_trace_ring[i & (NS_TRACE_DEFERRED_RING_WORDS - 1)]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Drains what fits in len bytes to the capture, as the NCP does */
+static uint16_t test_drain(uint16_t len, int round)
+{
+    static uint32_t buf[1024];
+    static uint32_t again[1024];
+    uint16_t used = ns_trace_deferred_peek((uint8_t *) buf, len);
+
+    if (rand() % 4 == 0) {
+        /* Couldn't be sent, so it is peeked again later */
+        if (ns_trace_deferred_peek((uint8_t *) again, len) != used || memcmp(buf, again, used)) {
+            test_fail("repeated peek differs", round);
+        }
+    }
+    ns_trace_deferred_commit();
+    fwrite(buf, 1, used, test_capture);
+
+    for (uint16_t p = 0; p < used / 4; p += NS_TRACE_REC_WORDS(buf[p])) {
+        if (NS_TRACE_REC_TYPE(buf[p]) == NS_TRACE_REC_TYPE_DROPPED) {
+            if (p || buf[p + 4] != test_dropped) {
+                test_fail("dropped traces miscounted", round);
+            }
+            fprintf(test_expected, "%10u [%u traces dropped]\n", (unsigned) host_clock_ticks, (unsigned) test_dropped);
+            test_dropped = 0;
+        } else if (NS_TRACE_REC_TYPE(buf[p]) == NS_TRACE_REC_TYPE_TRACE && test_pending_count) {
+            fputs(test_pending[test_pending_first], test_expected);
+            test_pending_first = (test_pending_first + 1) % TEST_PENDING_MAX;
+            test_pending_count--;
+        } else {
+            test_fail("unexpected record", round);
+        }
+    }
+    if (test_dropped && len >= (NS_TRACE_REC_FIXED_WORDS + 1) * 4) {
+        test_fail("dropped traces not reported", round);
+    }
+    if (!test_ring_zeroed()) {
+        test_fail("ring not zeroed after drain", round);
+    }
+    return used;
+}
+
+static void test_decode(int traces)
+{
+    for (int round = 0; round < traces; round++) {
+        test_random_trace();
+        /* Every thousand traces, a while without draining */
+        if (round % 1000 < 900 && rand() % 6 == 0) {
+            test_drain(rand() % 600, round);
+        }
+    }
+    while (test_drain(sizeof(uint32_t) * 1024, traces));
+    if (test_pending_count || test_dropped) {
+        test_fail("records left in ring", traces);
+    }
+}
+
+static const char test_writer_fmt[] = "writer %u seq %u %s";
+static int test_writers;
+static int test_writer_traces;
+static int test_writers_done;
+
+static void *test_writer(void *arg)
+{
+    unsigned id = (uintptr_t) arg;
+    char str[20];
+
+    for (int i = 0; i < test_writer_traces; i++) {
+        int len = i % 17;
+        memset(str, 'a' + id, len);
+        str[len] = 0;
+        ns_trace_printf(TRACE_LEVEL_DEBUG, "mMCP", test_writer_fmt, id, i, str);
+        if (i % 64 == 63) {
+            usleep(1);
+        }
+    }
+    __atomic_fetch_add(&test_writers_done, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+/* One record of a writer thread, at the sequence number after last */
+static bool test_writer_record(const uint32_t *rec, long last[])
+{
+    uint32_t id = rec[4];
+    uint32_t seq = rec[5];
+    uint32_t len = rec[6];
+
+    if (rec[1] != (uint32_t)(uintptr_t) test_writer_fmt || id >= (uint32_t) test_writers || (long) seq <= last[id] ||
+            len != seq % 17 || NS_TRACE_REC_WORDS(rec[0]) != 7 + (len + 3) / 4) {
+        return false;
+    }
+    for (uint32_t i = 0; i < len; i++) {
+        if (((const char *) &rec[7])[i] != 'a' + (char) id) {
+            return false;
+        }
+    }
+    last[id] = seq;
+    return true;
+}
+
+static void test_concurrent(void)
+{
+    pthread_t thread[TEST_WRITERS_MAX];
+    long last[TEST_WRITERS_MAX];
+    long records = 0;
+    long dropped = 0;
+    uint32_t buf[128];
+
+    for (int i = 0; i < test_writers; i++) {
+        last[i] = -1;
+        pthread_create(&thread[i], NULL, test_writer, (void *)(uintptr_t) i);
+    }
+
+    for (;;) {
+        bool done = __atomic_load_n(&test_writers_done, __ATOMIC_ACQUIRE) == test_writers;
+        uint16_t len = ns_trace_deferred_peek((uint8_t *) buf, sizeof(buf));
+        if (len && rand() % 3 == 0) {
+            continue;
+        }
+        ns_trace_deferred_commit();
+        for (uint16_t p = 0; p < len / 4; p += NS_TRACE_REC_WORDS(buf[p])) {
+            if (NS_TRACE_REC_TYPE(buf[p]) == NS_TRACE_REC_TYPE_DROPPED) {
+                dropped += buf[p + 4];
+            } else if (NS_TRACE_REC_TYPE(buf[p]) != NS_TRACE_REC_TYPE_TRACE || !test_writer_record(&buf[p], last)) {
+                test_fail("record broken or out of order", (int) records);
+            } else {
+                records++;
+            }
+        }
+        if (done && !len) {
+            break;
+        }
+    }
+
+    for (int i = 0; i < test_writers; i++) {
+        pthread_join(thread[i], NULL);
+    }
+    if (records + dropped != (long) test_writers * test_writer_traces) {
+        test_fail("records lost", (int) records);
+    }
+    if (!test_ring_zeroed()) {
+        test_fail("ring not zeroed after drain", (int) records);
+    }
+    printf("OK: %d writers, %ld records, %ld dropped\n", test_writers, records, dropped);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3) {
+        printf("Usage: %s <capture> <expected text> [writer threads] [traces per writer]\n", argv[0]);
+        return 1;
+    }
+    test_capture = fopen(argv[1], "wb");
+    test_expected = fopen(argv[2], "w");
+    test_writers = argc > 3 ? atoi(argv[3]) : 4;
+    test_writer_traces = argc > 4 ? atoi(argv[4]) : 200000;
+    if (!test_capture || !test_expected || test_writers > TEST_WRITERS_MAX) {
+        printf("FAIL: can't open %s or %s\n", argv[1], argv[2]);
+        return 1;
+    }
+
+    srand(1);
+    test_decode(TEST_TRACES);
+    fclose(test_capture);
+    fclose(test_expected);
+    printf("OK: %d traces written for decoding\n", TEST_TRACES);
+
+    test_concurrent();
+    return 0;
+}
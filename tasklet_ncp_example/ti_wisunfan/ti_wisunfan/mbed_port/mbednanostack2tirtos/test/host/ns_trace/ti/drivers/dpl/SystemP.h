@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Host stand-in for the SystemP driver porting layer, formatting with the
+ * host C library.
+ */
+
+#ifndef ti_dpl_SystemP__include
+#define ti_dpl_SystemP__include
+
+#include <stdio.h>
+
+#define SystemP_snprintf    snprintf
+#define SystemP_vsnprintf   vsnprintf
+
+#endif /* ti_dpl_SystemP__include */
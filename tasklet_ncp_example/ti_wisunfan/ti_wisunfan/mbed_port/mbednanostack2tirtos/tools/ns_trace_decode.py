@@ -0,0 +1,202 @@
+#!/usr/bin/env python3
+#
+# Decode deferred binary traces (NS_TRACE_DEFERRED, see
+# platform/ns_trace.c) back to text.
+#
+# The records hold the addresses of the format and group strings, not the
+# strings themselves, so the ELF file of the exact image that produced the
+# capture is needed to look them up.
+#
+# Input is the raw record stream: either the bytes captured from ITM
+# stimulus port 1, or the values of SPINEL_PROP_STREAM_LOG_BINARY frames
+# concatenated in the order received.
+#
+# Usage: ns_trace_decode.py <image.out> <capture.bin> [--tick-us N]
+#
+
+import argparse
+import re
+import struct
+import sys
+
+REC_TYPE_TRACE = 0xA5
+REC_TYPE_DROPPED = 0xA7
+REC_FIXED_WORDS = 4
+
+LEVELS = {
+    0x10: "DBG ",
+    0x08: "INFO",
+    0x04: "WARN",
+    0x02: "ERR ",
+    0x01: "CMD ",
+}
+
+# Must match the parsing in ns_trace_deferred_args()
+CONVERSION = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d*))?(hh|h|ll|l|j|z|t|L)?(.)", re.S)
+
+
+class Elf:
+    """Just enough ELF to read strings from loadable sections."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        if self.data[:4] != b"\x7fELF":
+            raise ValueError("%s: not an ELF file" % path)
+        if self.data[5] != 1:
+            raise ValueError("%s: only little endian images are supported" % path)
+
+        self.regions = []
+        if self.data[4] == 1:
+            shoff, = struct.unpack_from("<I", self.data, 0x20)
+            shentsize, shnum = struct.unpack_from("<HH", self.data, 0x2E)
+            for i in range(shnum):
+                _, sh_type, sh_flags, sh_addr, sh_offset, sh_size = \
+                    struct.unpack_from("<IIIIII", self.data, shoff + i * shentsize)
+                self._add(sh_type, sh_flags, sh_addr, sh_offset, sh_size)
+        else:
+            shoff, = struct.unpack_from("<Q", self.data, 0x28)
+            shentsize, shnum = struct.unpack_from("<HH", self.data, 0x3A)
+            for i in range(shnum):
+                _, sh_type, sh_flags, sh_addr, sh_offset, sh_size = \
+                    struct.unpack_from("<IIQQQQ", self.data, shoff + i * shentsize)
+                self._add(sh_type, sh_flags, sh_addr, sh_offset, sh_size)
+
+    def _add(self, sh_type, sh_flags, sh_addr, sh_offset, sh_size):
+        SHT_NOBITS = 8
+        SHF_ALLOC = 2
+        if sh_type != SHT_NOBITS and sh_flags & SHF_ALLOC and sh_size:
+            self.regions.append((sh_addr, sh_offset, sh_size))
+
+    def string(self, address):
+        for start, offset, size in self.regions:
+            if start <= address < start + size:
+                begin = offset + address - start
+                end = self.data.find(b"\0", begin, offset + size)
+                if end < 0:
+                    end = offset + size
+                return self.data[begin:end].decode("utf-8", "replace")
+        return None
+
+
+class Args:
+    def __init__(self, words):
+        self.words = words
+        self.pos = 0
+
+    def word(self):
+        if self.pos >= len(self.words):
+            raise IndexError
+        self.pos += 1
+        return self.words[self.pos - 1]
+
+    def long(self):
+        low = self.word()
+        return low | self.word() << 32
+
+    def string(self):
+        length = self.word()
+        count = (length + 3) // 4
+        if self.pos + count > len(self.words):
+            raise IndexError
+        raw = struct.pack("<%dI" % count, *self.words[self.pos:self.pos + count])
+        self.pos += count
+        return raw[:length].decode("utf-8", "replace")
+
+
+def signed(value, bits):
+    return value - (1 << bits) if value & (1 << (bits - 1)) else value
+
+
+def render(fmt, args):
+    out = []
+    last = 0
+    for m in CONVERSION.finditer(fmt):
+        out.append(fmt[last:m.start()])
+        last = m.end()
+        flags, width, precision, length, conv = m.groups()
+        try:
+            if width == "*":
+                width = str(signed(args.word(), 32))
+            if precision == "*":
+                precision = str(signed(args.word(), 32))
+            spec = "%" + flags + (width or "") + ("." + precision if precision is not None else "")
+            wide = length in ("ll", "j")
+            # Arguments are promoted to int in the record, h and hh cut them back
+            bits = 64 if wide else 16 if length == "h" else 8 if length == "hh" else 32
+            if conv == "%":
+                out.append("%")
+            elif conv in "di":
+                value = args.long() if wide else args.word()
+                out.append((spec + "d") % signed(value & ((1 << bits) - 1), bits))
+            elif conv in "uoxX":
+                value = args.long() if wide else args.word()
+                out.append((spec + ("d" if conv == "u" else conv)) % (value & ((1 << bits) - 1)))
+            elif conv == "c":
+                out.append((spec + "c") % chr(args.word() & 0xFF))
+            elif conv == "p":
+                out.append("0x%08x" % args.word())
+            elif conv == "s":
+                out.append((spec + "s") % args.string())
+            elif conv in "eEfFgGaA":
+                value, = struct.unpack("<d", struct.pack("<Q", args.long()))
+                out.append((spec + (conv if conv not in "aA" else "e")) % value)
+            elif conv == "n":
+                pass
+            else:
+                out.append(m.group(0) + fmt[last:])
+                return "".join(out)
+        except IndexError:
+            # Record was truncated on the device
+            out.append("<?>")
+            return "".join(out) + "..."
+    out.append(fmt[last:])
+    return "".join(out)
+
+
+def decode(elf, data, tick_us, output):
+    pos = 0
+    while pos + REC_FIXED_WORDS * 4 <= len(data):
+        header, fmt_addr, grp_addr, timestamp = struct.unpack_from("<IIII", data, pos)
+        words = header & 0xFFFF
+        level = (header >> 16) & 0xFF
+        rec_type = header >> 24
+        if rec_type not in (REC_TYPE_TRACE, REC_TYPE_DROPPED) or words < REC_FIXED_WORDS or \
+                pos + words * 4 > len(data):
+            # Capture started mid-record, or bytes were lost - resynchronise
+            pos += 4
+            continue
+
+        args = Args(list(struct.unpack_from("<%dI" % (words - REC_FIXED_WORDS), data, pos + REC_FIXED_WORDS * 4)))
+        pos += words * 4
+        stamp = "%12.3f" % (timestamp * tick_us / 1000.0) if tick_us else "%10u" % timestamp
+
+        if rec_type == REC_TYPE_DROPPED:
+            output.write("%s [%d traces dropped]\n" % (stamp, args.word()))
+            continue
+
+        fmt = elf.string(fmt_addr)
+        grp = elf.string(grp_addr) or "?"
+        if fmt is None:
+            text = "<format 0x%08x not in image>" % fmt_addr
+        else:
+            text = render(fmt, args)
+        output.write("%s [%s][%-4s]: %s\n" % (stamp, LEVELS.get(level, "    "), grp, text))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode NS_TRACE_DEFERRED binary traces")
+    parser.add_argument("elf", help="ELF image that produced the traces")
+    parser.add_argument("capture", help="raw record stream")
+    parser.add_argument("--tick-us", type=float, default=0,
+                        help="ClockP tick period in microseconds, to print timestamps in ms")
+    args = parser.parse_args()
+
+    elf = Elf(args.elf)
+    with open(args.capture, "rb") as f:
+        data = f.read()
+    decode(elf, data, args.tick_us, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
@@ -98,6 +98,26 @@ public:
                                          : OT_ERROR_NO_BUFS;
     }
 
+    /**
+     * This method writes as many bytes of a given block as there is space for and updates the write pointer.
+     *
+     * @param[in]  aData     A pointer to the bytes to write.
+     * @param[in]  aLength   The number of bytes in @p aData.
+     *
+     * @returns The number of bytes written, less than @p aLength if the buffer got full.
+     *
+     */
+    uint16_t WriteBytes(const uint8_t *aData, uint16_t aLength)
+    {
+        uint16_t length = (aLength < mRemainingLength) ? aLength : mRemainingLength;
+
+        memcpy(mWritePointer, aData, length);
+        mWritePointer += length;
+        mRemainingLength -= length;
+
+        return length;
+    }
+
     /**
      * This method undoes the last @p aUndoLength writes, removing them from frame.
      *
@@ -505,6 +525,22 @@ public:
      */
     otError Encode(const uint8_t *aData, uint16_t aLength);
 
+    /**
+     * This method encodes as much of a given block of data into current frame as there is space for.
+     *
+     * Unlike `Encode(const uint8_t *, uint16_t)`, the bytes that fit are kept in the frame buffer when the buffer gets
+     * full, so that a caller can continue with the rest of the block once there is space again.
+     *
+     * @param[in]    aData          A pointer to a buffer containing the data to encode.
+     * @param[in]    aLength        The number of bytes in @p aData.
+     * @param[out]   aEncodedLength The number of bytes from @p aData encoded and added to frame.
+     *
+     * @retval OT_ERROR_NONE     Successfully encoded and added all the data to frame.
+     * @retval OT_ERROR_NO_BUFS  Insufficient buffer space available to add all the data.
+     *
+     */
+    otError Encode(const uint8_t *aData, uint16_t aLength, uint16_t &aEncodedLength);
+
     /**
      * This method ends/finalizes the HDLC frame.
      *
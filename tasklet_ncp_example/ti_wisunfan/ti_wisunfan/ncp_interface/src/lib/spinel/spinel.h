@@ -485,6 +485,13 @@ enum
     SPINEL_NCP_LOG_REGION_OT_BBR      = 17,
 };
 
+enum
+{
+    SPINEL_ROUTING_TABLE_BATCH_FLAG_SNAPSHOT       = (1 << 0), ///< Frame is part of a resync snapshot.
+    SPINEL_ROUTING_TABLE_BATCH_FLAG_SNAPSHOT_START = (1 << 1), ///< First frame of a snapshot.
+    SPINEL_ROUTING_TABLE_BATCH_FLAG_SNAPSHOT_END   = (1 << 2), ///< Last frame of a snapshot.
+};
+
 typedef struct
 {
     uint8_t bytes[8];
@@ -842,6 +849,46 @@ enum
 
 
     SPINEL_PROP_BASE_EXT__BEGIN = 0x1000,
+
+    /// Heap usage and fragmentation statistics
+    /** Format: `t(LLLLLL)t(LLLLL)t(A(S))A(t(SSSSLL))` - Read only
+     *
+     * Heap usage:
+     *  `L`: Heap size in bytes
+     *  `L`: Allocated bytes
+     *  `L`: Allocated bytes maximum
+     *  `L`: Allocation failures
+     *  `L`: Allocation failures with enough free heap in total (fragmentation)
+     *  `L`: Longest free hole list walk of a single allocation
+     *
+     * Free holes:
+     *  `L`: Hole count
+     *  `L`: Hole count maximum
+     *  `L`: Free bytes
+     *  `L`: Largest free block in bytes
+     *  `L`: Largest free block minimum
+     *
+     * Hole size histogram, entry n counts holes below 32 << n bytes,
+     * last entry counts larger holes.
+     *
+     * Slab classes:
+     *  `S`: Block size, `S`: Block count, `S`: Blocks in use,
+     *  `S`: Blocks in use maximum, `L`: Allocations, `L`: Overflows to heap
+     */
+    SPINEL_PROP_HEAP_STATS = SPINEL_PROP_BASE_EXT__BEGIN + 0,
+
+    /// Heap allocation call sites
+    /** Format: `A(t(USLL))` - Read only
+     *
+     * Call sites holding most heap allocations, available when the
+     * NCP is built with NSDYNMEM_TRACKER_ENABLED=1:
+     *  `U`: Function name
+     *  `S`: Line
+     *  `L`: Allocations held
+     *  `L`: Bytes held
+     */
+    SPINEL_PROP_HEAP_ALLOCATORS = SPINEL_PROP_BASE_EXT__BEGIN + 1,
+
     SPINEL_PROP_BASE_EXT__END = 0x1200,
 
     SPINEL_PROP_PHY__BEGIN         = 0x20,
@@ -964,6 +1011,61 @@ enum
     SPINEL_PROP_WISUN_EXT_NET__BEGIN = 0x15AB,
     // TI Wi-SUN specific NET properties
     SPINEL_PROP_REVOKE_GTK_HWADDR = SPINEL_PROP_WISUN_EXT_NET__BEGIN,
+
+    /// Batched routing table updates
+    /** Format: `S C A(t(C6C6L))` (unsolicited)
+     *
+     *  `S`: Sequence number, incremented by one for every frame. A gap
+     *       means updates were lost and the host should request
+     *       `SPINEL_PROP_ROUTING_TABLE_RESYNC`.
+     *  `C`: Flags (`SPINEL_ROUTING_TABLE_BATCH_FLAG_*`).
+     *  `A(t(C6C6L))`: Route changes, each formatted as the value of
+     *       `SPINEL_PROP_ROUTING_TABLE_UPDATE` (change type, prefix,
+     *       prefix length, next hop, lifetime).
+     *
+     * Sent instead of `SPINEL_PROP_ROUTING_TABLE_UPDATE` while
+     * `SPINEL_PROP_ROUTING_TABLE_UPDATE_WINDOW` is not zero. Route changes
+     * are collected over the window on the NCP. A route added and removed
+     * within the window is not reported at all.
+     *
+     */
+    SPINEL_PROP_ROUTING_TABLE_UPDATE_BATCH = SPINEL_PROP_WISUN_EXT_NET__BEGIN + 1,
+
+    /// Routing table resync
+    /** Format: Empty (write only)
+     *
+     * Requests a full snapshot of the routing table. The NCP sends it as
+     * `SPINEL_PROP_ROUTING_TABLE_UPDATE_BATCH` frames with the
+     * `SNAPSHOT` flag set, all routes reported as new. The host drops its
+     * copy of the table on the frame flagged `SNAPSHOT_START`; the frame
+     * flagged `SNAPSHOT_END` is the last one. Changes made while the
+     * snapshot is being sent are reported as regular batches.
+     *
+     */
+    SPINEL_PROP_ROUTING_TABLE_RESYNC = SPINEL_PROP_WISUN_EXT_NET__BEGIN + 2,
+
+    /// Connected devices generation
+    /** Format: `S` (read only)
+     *
+     * Counter incremented whenever a device joins or leaves the DODAG. The
+     * host reads it before the first and after the last block of
+     * `SPINEL_PROP_CONNECTED_DEVICES`; if it changed, the device list was
+     * modified while being read and the host should read it again.
+     *
+     */
+    SPINEL_PROP_CONNECTED_DEVICES_GENERATION = SPINEL_PROP_WISUN_EXT_NET__BEGIN + 3,
+
+    /// Routing table update window
+    /** Format: `S` (read-write)
+     *
+     * Time in milliseconds the NCP collects routing table changes before
+     * sending them in one `SPINEL_PROP_ROUTING_TABLE_UPDATE_BATCH` frame.
+     * Zero, the default, sends every change right away in its own
+     * `SPINEL_PROP_ROUTING_TABLE_UPDATE` frame, so a host that knows the
+     * batch frame writes a non-zero window to turn batching on.
+     *
+     */
+    SPINEL_PROP_ROUTING_TABLE_UPDATE_WINDOW = SPINEL_PROP_WISUN_EXT_NET__BEGIN + 4,
     SPINEL_PROP_WISUN_EXT_NET__END = 0x1600,
 
     SPINEL_PROP_WISUN_EXT__END = SPINEL_PROP_WISUN_EXT_NET__END, // 0x15FF
@@ -1006,6 +1108,54 @@ enum
     SPINEL_PROP_STREAM__END = 0x80,
 
     SPINEL_PROP_STREAM_EXT__BEGIN = 0x1700,
+
+    /// (IPv6) Network Stream, multiple packets
+    /** Format: `A(d)` (stream, write only)
+     *
+     * Same as `SPINEL_PROP_STREAM_NET` for sending network packets, but the
+     * value carries several packets so that a burst of downlink traffic
+     * (e.g. multicast firmware update) can be sent in a single spinel frame.
+     *
+     * The NCP handles each packet independently, a packet that cannot be
+     * sent is counted as dropped and does not affect the others.
+     *
+     * The general format of this property is:
+     *
+     *    `A(d)` : array of packet data
+     */
+    SPINEL_PROP_STREAM_NET_MULTI = SPINEL_PROP_STREAM_EXT__BEGIN + 0,
+
+    /// NCP TX buffer flow control
+    /** Format: `A(S)` (read only)
+     *
+     * Number of free bytes in the NCP TX buffer for each frame priority
+     * level, lowest priority first. The number of entries is the number of
+     * priority levels the NCP is built with.
+     *
+     * Responses to host commands use priority level 1, IPv6 packets sent
+     * by the NCP (`SPINEL_PROP_STREAM_NET`) use a priority level configured
+     * on the NCP (0 by default). The host can use the free space to pace
+     * its `SPINEL_PROP_STREAM_NET` writes, whose responses and forwarded
+     * packets need space in the NCP TX buffer.
+     *
+     */
+    SPINEL_PROP_STREAM_FLOW_CONTROL = SPINEL_PROP_STREAM_EXT__BEGIN + 1,
+
+    /// Binary Log Stream
+    /** Format: `D` (stream, read only)
+     *
+     * Deferred trace records from the Wi-SUN stack (NCP built with
+     * `NS_TRACE_DEFERRED`). Each record holds the addresses of its format
+     * and group strings in the NCP image, level, timestamp and raw
+     * arguments; the host decodes them offline against the NCP ELF file
+     * (`mbed_port/mbednanostack2tirtos/tools/ns_trace_decode.py`).
+     *
+     * A frame carries one or more whole records. Lost records are reported
+     * by a record of their own.
+     *
+     */
+    SPINEL_PROP_STREAM_LOG_BINARY = SPINEL_PROP_STREAM_EXT__BEGIN + 2,
+
     SPINEL_PROP_STREAM_EXT__END   = 0x1800,
 
 };
@@ -48,19 +48,25 @@ otError Encoder::BeginFrame(Spinel::Buffer::Priority aPriority)
 
 otError Encoder::BeginFrame(uint8_t aHeader, unsigned int aCommand)
 {
-    otError error = OT_ERROR_NONE;
-
     // Non-zero TID indicates this is a response to a spinel command.
 
-    if (SPINEL_HEADER_GET_TID(aHeader) != 0)
-    {
-        SuccessOrExit(error = BeginFrame(Spinel::Buffer::kPriorityHigh));
-    }
-    else
-    {
-        SuccessOrExit(error = BeginFrame(Spinel::Buffer::kPriorityLow));
-    }
+    return BeginFrame((SPINEL_HEADER_GET_TID(aHeader) != 0) ? Spinel::Buffer::kPriorityHigh
+                                                             : Spinel::Buffer::kPriorityLow,
+                      aHeader, aCommand);
+}
 
+otError Encoder::BeginFrame(uint8_t aHeader, unsigned int aCommand, spinel_prop_key_t aKey)
+{
+    return BeginFrame((SPINEL_HEADER_GET_TID(aHeader) != 0) ? Spinel::Buffer::kPriorityHigh
+                                                             : Spinel::Buffer::kPriorityLow,
+                      aHeader, aCommand, aKey);
+}
+
+otError Encoder::BeginFrame(Spinel::Buffer::Priority aPriority, uint8_t aHeader, unsigned int aCommand)
+{
+    otError error = OT_ERROR_NONE;
+
+    SuccessOrExit(error = BeginFrame(aPriority));
     SuccessOrExit(error = WriteUint8(aHeader));
     SuccessOrExit(error = WriteUintPacked(aCommand));
 
@@ -68,11 +74,14 @@ exit:
     return error;
 }
 
-otError Encoder::BeginFrame(uint8_t aHeader, unsigned int aCommand, spinel_prop_key_t aKey)
+otError Encoder::BeginFrame(Spinel::Buffer::Priority aPriority,
+                            uint8_t                  aHeader,
+                            unsigned int             aCommand,
+                            spinel_prop_key_t        aKey)
 {
     otError error = OT_ERROR_NONE;
 
-    SuccessOrExit(error = BeginFrame(aHeader, aCommand));
+    SuccessOrExit(error = BeginFrame(aPriority, aHeader, aCommand));
 
     // The write position is saved before writing the property key,
     // so that if fetching the property fails and we need to
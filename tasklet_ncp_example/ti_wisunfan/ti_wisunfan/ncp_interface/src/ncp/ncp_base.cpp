@@ -51,6 +51,10 @@
 #include "nvocmp.h"
 #endif
 
+#ifdef NS_TRACE_DEFERRED
+#include "eventOS_event_timer.h"
+#endif
+
 
 namespace ot {
 namespace Ncp {
@@ -178,6 +182,14 @@ static spinel_status_t ResetReasonToSpinelStatus(otPlatResetReason aReason)
 // MARK: Class Boilerplate
 // ----------------------------------------------------------------------------
 
+OT_STATIC_ASSERT((CONFIG_NCP_STREAM_NET_PRIORITY < OPENTHREAD_SPINEL_CONFIG_BUFFER_NUM_PRIORITIES) &&
+                     (CONFIG_NCP_STREAM_LOG_PRIORITY < OPENTHREAD_SPINEL_CONFIG_BUFFER_NUM_PRIORITIES) &&
+                     (CONFIG_NCP_ROUTE_UPDATE_PRIORITY < OPENTHREAD_SPINEL_CONFIG_BUFFER_NUM_PRIORITIES),
+                 "NCP stream priority levels must be less than the number of NCP buffer priority levels");
+
+OT_STATIC_ASSERT((CONFIG_NCP_ROUTE_UPDATE_BATCH_SIZE > 0) && (CONFIG_NCP_ROUTE_UPDATE_BATCH_SIZE <= 255),
+                 "NCP routing table batch size must be in 1-255");
+
 NcpBase *NcpBase::sNcpInstance = NULL;
 
 NcpBase::NcpBase(Instance *aInstance)
@@ -230,6 +242,14 @@ NcpBase::NcpBase(Instance *aInstance)
     , mRxSpinelFrameCounter(0)
     , mRxSpinelOutOfOrderTidCounter(0)
     , mTxSpinelFrameCounter(0)
+    , mStackDatagramQueueHead(0)
+    , mStackDatagramQueueCount(0)
+    , mRouteUpdateCount(0)
+    , mRouteUpdateSequence(0)
+    , mRouteUpdateTimer(NULL)
+    , mRouteUpdateWindow(CONFIG_NCP_ROUTE_UPDATE_WINDOW_MS)
+    , mRouteSnapshotActive(false)
+    , mRouteSnapshotStarted(false)
     , mDidInitialUpdates(false)
     , mLogTimestampBase(0)
 {
@@ -267,6 +287,11 @@ NcpBase::NcpBase(Instance *aInstance)
     //mv mUpdateChangedPropsTask.Post();
     platformNcpSendAsyncRspSignal();
 
+#ifdef NS_TRACE_DEFERRED
+    // Deferred traces are otherwise only sent when a frame leaves the NCP buffer.
+    IgnoreReturnValue(eventOS_timeout_every_ms(&NcpBase::HandleTraceDrainTimer, CONFIG_NCP_TRACE_DRAIN_INTERVAL_MS, this));
+#endif
+
 }
 
 NcpBase *NcpBase::GetNcpInstance(void)
@@ -421,10 +446,26 @@ void NcpBase::HandleFrameRemovedFromNcpBuffer(Spinel::Buffer::FrameTag aFrameTag
     SuccessOrExit(SendQueuedDatagramMessages());
 #endif
 
+#ifdef WISUN_NCP_ENABLE
+    // Send any queued IPv6 datagram from the Wi-SUN stack.
+
+    SuccessOrExit(SendQueuedStackDatagrams());
+
+    // Send any routing table changes whose window has ended, or the rest of a snapshot.
+
+    SuccessOrExit(SendQueuedRouteUpdates());
+#endif
+
     // Send any unsolicited event-triggered property updates.
 
     UpdateChangedProps();
 
+#ifdef NS_TRACE_DEFERRED
+    // Send deferred trace records with whatever buffer space is left.
+
+    IgnoreReturnValue(SendQueuedTraceRecords());
+#endif
+
 exit:
     return;
 }
@@ -468,7 +509,8 @@ otError NcpBase::StreamWrite(int aStreamId, const uint8_t *aDataPtr, int aDataLe
 
     VerifyOrExit(IsResponseQueueEmpty(), error = OT_ERROR_NO_BUFS);
 
-    SuccessOrExit(error = mEncoder.BeginFrame(header, SPINEL_CMD_PROP_VALUE_IS, streamPropKey));
+    SuccessOrExit(error = mEncoder.BeginFrame(static_cast<Spinel::Buffer::Priority>(CONFIG_NCP_STREAM_LOG_PRIORITY),
+                                              header, SPINEL_CMD_PROP_VALUE_IS, streamPropKey));
     SuccessOrExit(error = mEncoder.WriteData(aDataPtr, static_cast<uint16_t>(aDataLen)));
     SuccessOrExit(error = mEncoder.EndFrame());
 
@@ -609,7 +651,8 @@ void NcpBase::Log(otLogLevel aLogLevel, otLogRegion aLogRegion, const char *aLog
 
     VerifyOrExit(IsResponseQueueEmpty(), error = OT_ERROR_NO_BUFS);
 
-    SuccessOrExit(error = mEncoder.BeginFrame(header, SPINEL_CMD_PROP_VALUE_IS, SPINEL_PROP_STREAM_LOG));
+    SuccessOrExit(error = mEncoder.BeginFrame(static_cast<Spinel::Buffer::Priority>(CONFIG_NCP_STREAM_LOG_PRIORITY),
+                                              header, SPINEL_CMD_PROP_VALUE_IS, SPINEL_PROP_STREAM_LOG));
     SuccessOrExit(error = mEncoder.WriteUtf8(aLogString));
     SuccessOrExit(error = mEncoder.WriteUint8(ConvertLogLevel(aLogLevel)));
     SuccessOrExit(error = mEncoder.WriteUintPacked(ConvertLogRegion(aLogRegion)));
@@ -58,6 +58,9 @@
 #include "lib/spinel/spinel_encoder.hpp"
 #include "utils/static_assert.hpp"
 
+struct buffer;          // Wi-SUN stack buffer (`buffer_t`).
+struct timeout_entry_t; // Event loop timeout (`timeout_t`).
+
 namespace ot {
 namespace Ncp {
 
@@ -157,8 +160,39 @@ public:
 
     void HandleDatagramFromStack(otMessage *aMessage);
 
+    /**
+     * This method queues an IPv6 datagram from the Wi-SUN stack to be sent to host.
+     *
+     * The datagram is sent from the stack buffer without copying it. The ownership of the buffer passes to NCP, it is
+     * freed once the frame carrying it has been sent (or the datagram is dropped).
+     *
+     * @param[in] aBuffer  The stack buffer holding the IPv6 datagram.
+     *
+     */
+    void HandleDatagramFromStack(struct buffer *aBuffer);
+
     otError SendRouteTableUpdate(uint8_t changed_info, uint8_t* addr_self, uint8_t len_prefix, uint8_t* addr_nexthop, uint32_t lifetime);
 
+    /**
+     * This method queues a routing table change from the Wi-SUN stack to be reported to host.
+     *
+     * Changes are collected for the window host sets with `SPINEL_PROP_ROUTING_TABLE_UPDATE_WINDOW` and sent
+     * together. Changes to the same route within the window are merged, and a route added and deleted within it is
+     * not reported. With no window each change is sent right away.
+     *
+     * @param[in] aChangedInfo  The change type (`NEW`, `UPDATED` or `DELETED`).
+     * @param[in] aPrefix       The route prefix, zero padded to 16 bytes.
+     * @param[in] aPrefixLen    The route prefix length in bits.
+     * @param[in] aNextHop      The next hop address.
+     * @param[in] aLifetime     The route lifetime in seconds.
+     *
+     */
+    void HandleRouteTableUpdate(uint8_t        aChangedInfo,
+                                const uint8_t *aPrefix,
+                                uint8_t        aPrefixLen,
+                                const uint8_t *aNextHop,
+                                uint32_t       aLifetime);
+
     /**
     * This method sends async responses from NCP
     */
@@ -190,6 +224,19 @@ protected:
         uint32_t     mPropKeyOrStatus : 24; ///< 3 bytes for either property key or spinel status.
     };
 
+    /**
+     * This struct represents a routing table change waiting to be sent to host.
+     *
+     */
+    struct RouteUpdate
+    {
+        uint8_t  mChangedInfo; ///< Change type (`NEW`, `UPDATED` or `DELETED`).
+        uint8_t  mPrefixLen;   ///< Prefix length in bits.
+        uint8_t  mPrefix[16];  ///< Prefix, zero padded.
+        uint8_t  mNextHop[16]; ///< Next hop address.
+        uint32_t mLifetime;    ///< Lifetime in seconds.
+    };
+
     struct HandlerEntry
     {
         spinel_prop_key_t        mKey;
@@ -258,6 +305,28 @@ protected:
     otError SendQueuedDatagramMessages(void);
     otError SendDatagramMessage(otMessage *aMessage);
 
+    otError     SendQueuedStackDatagrams(void);
+    otError     SendStackDatagram(struct buffer *aBuffer);
+    static void HandleStackDatagramRemoved(void *aContext);
+
+    otError     SendQueuedRouteUpdates(void);
+    otError     SendRouteUpdateBatch(void);
+    otError     SendRouteSnapshotPage(void);
+    void        RemoveRouteUpdate(const uint8_t *aPrefix, uint8_t aPrefixLen, const uint8_t *aNextHop);
+    otError     WriteRouteUpdate(uint8_t        aChangedInfo,
+                                 const uint8_t *aPrefix,
+                                 uint8_t        aPrefixLen,
+                                 const uint8_t *aNextHop,
+                                 uint32_t       aLifetime);
+    static void HandleRouteUpdateTimer(void *aContext);
+
+#ifdef NS_TRACE_DEFERRED
+    otError     SendQueuedTraceRecords(void);
+    static void HandleTraceDrainTimer(void *aContext);
+#endif
+
+    otError HandleDatagramFromHost(const uint8_t *aFrame, uint16_t aLength);
+
 #if OPENTHREAD_RADIO || OPENTHREAD_CONFIG_LINK_RAW_ENABLE
 
     static void LinkRawReceiveDone(otInstance *aInstance, otRadioFrame *aFrame, otError aError);
@@ -447,9 +516,11 @@ protected:
 
     enum
     {
-        kTxBufferSize       = CONFIG_NCP_TX_BUFFER_SIZE, // Tx Buffer size (used by mTxFrameBuffer).
-        kResponseQueueSize  = CONFIG_NCP_SPINEL_RESPONSE_QUEUE_SIZE,
-        kInvalidScanChannel = -1, // Invalid scan channel.
+        kTxBufferSize           = CONFIG_NCP_TX_BUFFER_SIZE, // Tx Buffer size (used by mTxFrameBuffer).
+        kResponseQueueSize      = CONFIG_NCP_SPINEL_RESPONSE_QUEUE_SIZE,
+        kStackDatagramQueueSize = CONFIG_NCP_STACK_DATAGRAM_QUEUE_SIZE,
+        kRouteUpdateBatchSize   = CONFIG_NCP_ROUTE_UPDATE_BATCH_SIZE,
+        kInvalidScanChannel     = -1, // Invalid scan channel.
     };
 
     spinel_status_t mLastStatus;
@@ -519,6 +590,18 @@ protected:
     uint32_t mRxSpinelOutOfOrderTidCounter; // Number of out of order received spinel frames (tid increase > 1).
     uint32_t mTxSpinelFrameCounter;         // Number of sent (outbound) spinel frames.
 
+    struct buffer *mStackDatagramQueue[kStackDatagramQueueSize]; // Datagrams from Wi-SUN stack waiting for buffer space.
+    uint8_t        mStackDatagramQueueHead;                      // Index of the oldest queued datagram.
+    uint8_t        mStackDatagramQueueCount;                     // Number of queued datagrams.
+
+    RouteUpdate             mRouteUpdates[kRouteUpdateBatchSize]; // Routing table changes waiting to be sent to host.
+    uint8_t                 mRouteUpdateCount;                    // Number of waiting routing table changes.
+    uint16_t                mRouteUpdateSequence;                 // Sequence number of the next batch frame.
+    struct timeout_entry_t *mRouteUpdateTimer;                    // Running collection window, or NULL.
+    uint16_t                mRouteUpdateWindow;                   // Collection window in ms, 0 to send right away.
+    bool                    mRouteSnapshotActive;                 // A routing table snapshot is being sent.
+    bool                    mRouteSnapshotStarted;                // The first snapshot frame has been sent.
+
     bool mDidInitialUpdates;
 
     uint64_t mLogTimestampBase; // Timestamp base used for logging
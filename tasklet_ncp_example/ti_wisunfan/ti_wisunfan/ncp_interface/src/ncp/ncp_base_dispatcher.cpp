@@ -93,6 +93,9 @@ NcpBase::PropertyHandler NcpBase::FindGetPropertyHandler(spinel_prop_key_t aKey)
         OT_NCP_GET_HANDLER_ENTRY(SPINEL_PROP_NUM_CONNECTED_DEVICES),
         OT_NCP_GET_HANDLER_ENTRY(SPINEL_PROP_CONNECTED_DEVICES),
         /* Stream Properties */
+        /* Core Extended properties */
+        OT_NCP_GET_HANDLER_ENTRY(SPINEL_PROP_HEAP_STATS),
+        OT_NCP_GET_HANDLER_ENTRY(SPINEL_PROP_HEAP_ALLOCATORS),
         /* Tech specific: PHY Extended properties */
         OT_NCP_GET_HANDLER_ENTRY(SPINEL_PROP_PHY_CH_SPACING),
         OT_NCP_GET_HANDLER_ENTRY(SPINEL_PROP_PHY_CHO_CENTER_FREQ),
@@ -110,6 +113,10 @@ NcpBase::PropertyHandler NcpBase::FindGetPropertyHandler(spinel_prop_key_t aKey)
         OT_NCP_GET_HANDLER_ENTRY(SPINEL_PROP_MACMPL_COMMAND),
 #endif
         /* Tech specific: NET Extended properties */
+        OT_NCP_GET_HANDLER_ENTRY(SPINEL_PROP_CONNECTED_DEVICES_GENERATION),
+        OT_NCP_GET_HANDLER_ENTRY(SPINEL_PROP_ROUTING_TABLE_UPDATE_WINDOW),
+        /* Stream Extended properties */
+        OT_NCP_GET_HANDLER_ENTRY(SPINEL_PROP_STREAM_FLOW_CONTROL),
     };
 
 #undef OT_NCP_GET_HANDLER_ENTRY
@@ -179,6 +186,10 @@ NcpBase::PropertyHandler NcpBase::FindSetPropertyHandler(spinel_prop_key_t aKey)
 #endif
         /* Tech specific: NET Extended properties */
         OT_NCP_SET_HANDLER_ENTRY(SPINEL_PROP_REVOKE_GTK_HWADDR),
+        OT_NCP_SET_HANDLER_ENTRY(SPINEL_PROP_ROUTING_TABLE_RESYNC),
+        OT_NCP_SET_HANDLER_ENTRY(SPINEL_PROP_ROUTING_TABLE_UPDATE_WINDOW),
+        /* Stream Extended properties */
+        OT_NCP_SET_HANDLER_ENTRY(SPINEL_PROP_STREAM_NET_MULTI),
     };
 
 #undef OT_NCP_SET_HANDLER_ENTRY
@@ -76,9 +76,14 @@
 #include "ti_drivers_config.h"
 //Additional header files for integrating with nanostack
 #include "nsconfig.h"
+// ns_buffer.h has no C++ guards of its own, and NCP calls buffer_free().
+extern "C" {
 #include "Core/include/ns_buffer.h"
+}
 #include "ns_trace.h"
 #include "nsdynmemLIB.h"
+#include "Core/include/ns_monitor.h"
+#include "eventOS_event_timer.h"
 #include <openthread/message.h>
 #include "ncp_interface/src/core/common/message.hpp"
 #include "common/locator.hpp"
@@ -128,7 +133,6 @@
 
 #define PROTOCOL_NAME "Wi-SUNFAN"
 #define PROTOCOL_VERSION "1.0"
-#define CONNECTED_DEVICES_BLOCK_SIZE 1
 
 #ifdef WISUN_FAN_DEBUG
 volatile uint32_t num_drop_frame_from_host = 0;
@@ -141,9 +145,9 @@ namespace Ncp {
 #ifdef WISUN_NCP_ENABLE
 
 // Used by CONNECTED_DEVICES property
-uint16_t num_dao_targets = 0;
+bool connected_devices_in_progress = false;
+uint8_t connected_devices_cursor[16]; // Last address sent
 uint8_t block_index = 0;
-uint8_t *connected_device_ipv6_addrs;
 
 // Used by DODAG_ROUTE property
 uint8_t dodag_route_dest_addr[16] = {0};
@@ -154,6 +158,11 @@ extern "C" configurable_props_t cfg_props;
 extern "C" uint32_t g_switchNcp2Trace;
 #endif //SWITCH_NCP_TO_TRACE
 
+#ifdef NS_TRACE_DEFERRED
+extern "C" uint16_t ns_trace_deferred_peek(uint8_t *buf, uint16_t len);
+extern "C" void     ns_trace_deferred_commit(void);
+#endif
+
 #ifdef WISUN_TEST_MPL_EMBEDDED
 extern "C" bool udpSocketSetup(void);
 extern "C" void ns_trace_printf(uint8_t dlevel, const char *grp, const char *fmt, ...);
@@ -278,6 +287,92 @@ template <> otError NcpBase::HandlePropertyGet<SPINEL_PROP_TRX_FW_VERSION>(void)
         return(error);
 }
 
+#define HEAP_ALLOCATORS_MAX 8
+
+template <> otError NcpBase::HandlePropertyGet<SPINEL_PROP_HEAP_STATS>(void)
+{
+    otError error = OT_ERROR_NONE;
+    ns_monitor_heap_stat_t stat;
+
+    if (ns_monitor_heap_stat_get(&stat) != 0)
+    {
+        error = OT_ERROR_INVALID_STATE;
+    }
+    SuccessOrExit(error);
+
+    SuccessOrExit(error = mEncoder.OpenStruct());
+    SuccessOrExit(error = mEncoder.WriteUint32(stat.mem_stat.heap_sector_size));
+    SuccessOrExit(error = mEncoder.WriteUint32(stat.mem_stat.heap_sector_allocated_bytes));
+    SuccessOrExit(error = mEncoder.WriteUint32(stat.mem_stat.heap_sector_allocated_bytes_max));
+    SuccessOrExit(error = mEncoder.WriteUint32(stat.mem_stat.heap_alloc_fail_cnt));
+    SuccessOrExit(error = mEncoder.WriteUint32(stat.mem_stat.heap_alloc_fail_frag_cnt));
+    SuccessOrExit(error = mEncoder.WriteUint32(stat.mem_stat.heap_alloc_walk_max));
+    SuccessOrExit(error = mEncoder.CloseStruct());
+
+    SuccessOrExit(error = mEncoder.OpenStruct());
+    SuccessOrExit(error = mEncoder.WriteUint32(stat.hole_stat.hole_cnt));
+    SuccessOrExit(error = mEncoder.WriteUint32(stat.hole_cnt_max));
+    SuccessOrExit(error = mEncoder.WriteUint32(stat.hole_stat.free_bytes));
+    SuccessOrExit(error = mEncoder.WriteUint32(stat.hole_stat.largest_free_block));
+    SuccessOrExit(error = mEncoder.WriteUint32(stat.largest_free_block_min));
+    SuccessOrExit(error = mEncoder.CloseStruct());
+
+    SuccessOrExit(error = mEncoder.OpenStruct());
+    for (uint8_t i = 0; i < NS_MEM_HOLE_HISTOGRAM_SIZE; i++)
+    {
+        SuccessOrExit(error = mEncoder.WriteUint16(stat.hole_stat.hole_size_histogram[i]));
+    }
+    SuccessOrExit(error = mEncoder.CloseStruct());
+
+#if NS_MEM_SLAB_CLASS_COUNT > 0
+    for (uint8_t i = 0; i < NS_MEM_SLAB_CLASS_COUNT; i++)
+    {
+        const mem_slab_stat_t *slab = &stat.mem_stat.slab_stat[i];
+        if (slab->block_size == 0)
+        {
+            break;
+        }
+        SuccessOrExit(error = mEncoder.OpenStruct());
+        SuccessOrExit(error = mEncoder.WriteUint16(slab->block_size));
+        SuccessOrExit(error = mEncoder.WriteUint16(slab->block_count));
+        SuccessOrExit(error = mEncoder.WriteUint16(slab->blocks_in_use));
+        SuccessOrExit(error = mEncoder.WriteUint16(slab->blocks_in_use_max));
+        SuccessOrExit(error = mEncoder.WriteUint32(slab->alloc_cnt));
+        SuccessOrExit(error = mEncoder.WriteUint32(slab->overflow_cnt));
+        SuccessOrExit(error = mEncoder.CloseStruct());
+    }
+#endif
+
+    exit:
+        return error;
+}
+
+template <> otError NcpBase::HandlePropertyGet<SPINEL_PROP_HEAP_ALLOCATORS>(void)
+{
+    otError error = OT_ERROR_NONE;
+    ns_monitor_heap_allocator_t allocators[HEAP_ALLOCATORS_MAX];
+    int count = ns_monitor_heap_allocators_get(allocators, HEAP_ALLOCATORS_MAX);
+
+    if (count < 0)
+    {
+        error = OT_ERROR_NOT_IMPLEMENTED;
+    }
+    SuccessOrExit(error);
+
+    for (int i = 0; i < count; i++)
+    {
+        SuccessOrExit(error = mEncoder.OpenStruct());
+        SuccessOrExit(error = mEncoder.WriteUtf8(allocators[i].function ? allocators[i].function : ""));
+        SuccessOrExit(error = mEncoder.WriteUint16(allocators[i].line));
+        SuccessOrExit(error = mEncoder.WriteUint32(allocators[i].alloc_count));
+        SuccessOrExit(error = mEncoder.WriteUint32(allocators[i].total_memory));
+        SuccessOrExit(error = mEncoder.CloseStruct());
+    }
+
+    exit:
+        return error;
+}
+
 
 /* PHY properties */
 
@@ -856,9 +951,7 @@ extern "C" void nanostack_process_routing_table_update_from_stack(uint8_t change
     bitcopy(addr_self, prefix, len_prefix);
 
     ot::Ncp::NcpBase *ncp = ot::Ncp::NcpBase::GetNcpInstance();
-    ncp->SendRouteTableUpdate(changed_info, addr_self, len_prefix, addr_nexthop, lifetime);
-
-    //what if an error occurs? when does the ncp try to send the failed update? How is the malformed spinel frame removed
+    ncp->HandleRouteTableUpdate(changed_info, addr_self, len_prefix, addr_nexthop, lifetime);
 }
 
 otError NcpBase::SendRouteTableUpdate(uint8_t changed_info, uint8_t* addr_self, uint8_t len_prefix, uint8_t* addr_nexthop, uint32_t lifetime)
@@ -868,7 +961,8 @@ otError NcpBase::SendRouteTableUpdate(uint8_t changed_info, uint8_t* addr_self,
     spinel_prop_key_t propKey  = SPINEL_PROP_ROUTING_TABLE_UPDATE;
 
     // begin spinel encoding
-    SuccessOrExit(error = mEncoder.BeginFrame(header, SPINEL_CMD_PROP_VALUE_IS, propKey));
+    SuccessOrExit(error = mEncoder.BeginFrame(static_cast<Spinel::Buffer::Priority>(CONFIG_NCP_ROUTE_UPDATE_PRIORITY),
+                                              header, SPINEL_CMD_PROP_VALUE_IS, propKey));
     SuccessOrExit(error = mEncoder.OpenStruct());
     SuccessOrExit(error = mEncoder.WriteUint8(changed_info));
     SuccessOrExit(error = mEncoder.WriteIp6Address(addr_self));
@@ -882,24 +976,292 @@ exit:
     return error;
 }
 
+void NcpBase::HandleRouteTableUpdate(uint8_t        aChangedInfo,
+                                     const uint8_t *aPrefix,
+                                     uint8_t        aPrefixLen,
+                                     const uint8_t *aNextHop,
+                                     uint32_t       aLifetime)
+{
+    RouteUpdate *entry = NULL;
+
+    if ((mRouteUpdateWindow == 0) && (mRouteUpdateCount == 0))
+    {
+        // Not batching, and no change from before batching was turned off is still waiting to go first.
+        IgnoreReturnValue(SendRouteTableUpdate(aChangedInfo, const_cast<uint8_t *>(aPrefix), aPrefixLen,
+                                               const_cast<uint8_t *>(aNextHop), aLifetime));
+        ExitNow();
+    }
+
+    for (uint8_t i = 0; i < mRouteUpdateCount; i++)
+    {
+        if ((mRouteUpdates[i].mPrefixLen == aPrefixLen) &&
+            (memcmp(mRouteUpdates[i].mPrefix, aPrefix, sizeof(mRouteUpdates[i].mPrefix)) == 0) &&
+            (memcmp(mRouteUpdates[i].mNextHop, aNextHop, sizeof(mRouteUpdates[i].mNextHop)) == 0))
+        {
+            entry = &mRouteUpdates[i];
+            break;
+        }
+    }
+
+    if (entry != NULL)
+    {
+        // Merge with the change already waiting, host only needs the net effect of the window.
+
+        if (aChangedInfo == DELETED)
+        {
+            if (entry->mChangedInfo == NEW)
+            {
+                // Added and deleted within the window, host never sees the route.
+                mRouteUpdateCount--;
+                memmove(entry, entry + 1,
+                        static_cast<size_t>(&mRouteUpdates[mRouteUpdateCount] - entry) * sizeof(*entry));
+                ExitNow();
+            }
+
+            entry->mChangedInfo = DELETED;
+        }
+        else if (entry->mChangedInfo != NEW)
+        {
+            // Host already has the route (a deleted and re-added route included), so it has only changed.
+            entry->mChangedInfo = UPDATED;
+        }
+
+        entry->mLifetime = aLifetime;
+        ExitNow();
+    }
+
+    if (mRouteUpdateCount == kRouteUpdateBatchSize)
+    {
+        // Batch is full before the window ends, send it early. If NCP buffer has no room either, the change is
+        // dropped and its sequence number skipped so that host sees the gap and asks for a resync.
+
+        if (SendRouteUpdateBatch() != OT_ERROR_NONE)
+        {
+            mRouteUpdateSequence++;
+            ExitNow();
+        }
+    }
+
+    entry               = &mRouteUpdates[mRouteUpdateCount++];
+    entry->mChangedInfo = aChangedInfo;
+    entry->mPrefixLen   = aPrefixLen;
+    memcpy(entry->mPrefix, aPrefix, sizeof(entry->mPrefix));
+    memcpy(entry->mNextHop, aNextHop, sizeof(entry->mNextHop));
+    entry->mLifetime = aLifetime;
+
+    if (mRouteUpdateTimer == NULL)
+    {
+        if (mRouteUpdateWindow != 0)
+        {
+            mRouteUpdateTimer = eventOS_timeout_ms(&NcpBase::HandleRouteUpdateTimer, mRouteUpdateWindow, this);
+        }
+
+        if (mRouteUpdateTimer == NULL)
+        {
+            IgnoreReturnValue(SendQueuedRouteUpdates());
+        }
+    }
+
+exit:
+    return;
+}
+
+void NcpBase::HandleRouteUpdateTimer(void *aContext)
+{
+    NcpBase *ncp = static_cast<NcpBase *>(aContext);
+
+    ncp->mRouteUpdateTimer = NULL;
+
+    // If NCP buffer is full, the batch is sent from `HandleFrameRemovedFromNcpBuffer()` instead.
+    IgnoreReturnValue(ncp->SendQueuedRouteUpdates());
+}
+
+otError NcpBase::SendQueuedRouteUpdates(void)
+{
+    otError error = OT_ERROR_NONE;
+
+    // One snapshot frame at a time, so a resync does not take over the NCP buffer.
+
+    if (mRouteSnapshotActive)
+    {
+        SuccessOrExit(error = SendRouteSnapshotPage());
+    }
+
+    if ((mRouteUpdateCount > 0) && (mRouteUpdateTimer == NULL))
+    {
+        SuccessOrExit(error = SendRouteUpdateBatch());
+    }
+
+exit:
+    return error;
+}
+
+void NcpBase::RemoveRouteUpdate(const uint8_t *aPrefix, uint8_t aPrefixLen, const uint8_t *aNextHop)
+{
+    uint8_t count = 0;
+
+    for (uint8_t i = 0; i < mRouteUpdateCount; i++)
+    {
+        // Deletions are kept: host may have learned of the route from a batch sent after the snapshot started.
+
+        if ((mRouteUpdates[i].mChangedInfo == DELETED) || (mRouteUpdates[i].mPrefixLen != aPrefixLen) ||
+            (memcmp(mRouteUpdates[i].mPrefix, aPrefix, sizeof(mRouteUpdates[i].mPrefix)) != 0) ||
+            (memcmp(mRouteUpdates[i].mNextHop, aNextHop, sizeof(mRouteUpdates[i].mNextHop)) != 0))
+        {
+            mRouteUpdates[count++] = mRouteUpdates[i];
+        }
+    }
+
+    mRouteUpdateCount = count;
+}
+
+otError NcpBase::WriteRouteUpdate(uint8_t        aChangedInfo,
+                                  const uint8_t *aPrefix,
+                                  uint8_t        aPrefixLen,
+                                  const uint8_t *aNextHop,
+                                  uint32_t       aLifetime)
+{
+    otError error = OT_ERROR_NONE;
+
+    SuccessOrExit(error = mEncoder.OpenStruct());
+    SuccessOrExit(error = mEncoder.WriteUint8(aChangedInfo));
+    SuccessOrExit(error = mEncoder.WriteIp6Address(aPrefix));
+    SuccessOrExit(error = mEncoder.WriteUint8(aPrefixLen));
+    SuccessOrExit(error = mEncoder.WriteIp6Address(aNextHop));
+    SuccessOrExit(error = mEncoder.WriteUint32(aLifetime));
+    SuccessOrExit(error = mEncoder.CloseStruct());
+
+exit:
+    return error;
+}
+
+otError NcpBase::SendRouteUpdateBatch(void)
+{
+    otError error  = OT_ERROR_NONE;
+    uint8_t header = SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0;
+
+    SuccessOrExit(error = mEncoder.BeginFrame(static_cast<Spinel::Buffer::Priority>(CONFIG_NCP_ROUTE_UPDATE_PRIORITY),
+                                              header, SPINEL_CMD_PROP_VALUE_IS,
+                                              SPINEL_PROP_ROUTING_TABLE_UPDATE_BATCH));
+    SuccessOrExit(error = mEncoder.WriteUint16(mRouteUpdateSequence));
+    SuccessOrExit(error = mEncoder.WriteUint8(0));
+
+    for (uint8_t i = 0; i < mRouteUpdateCount; i++)
+    {
+        const RouteUpdate &update = mRouteUpdates[i];
+
+        SuccessOrExit(error = WriteRouteUpdate(update.mChangedInfo, update.mPrefix, update.mPrefixLen,
+                                               update.mNextHop, update.mLifetime));
+    }
+
+    SuccessOrExit(error = mEncoder.EndFrame());
+
+    mRouteUpdateSequence++;
+    mRouteUpdateCount = 0;
+
+exit:
+    return error;
+}
+
+otError NcpBase::SendRouteSnapshotPage(void)
+{
+    otError                error  = OT_ERROR_NONE;
+    uint8_t                header = SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0;
+    uint8_t                flags  = SPINEL_ROUTING_TABLE_BATCH_FLAG_SNAPSHOT;
+    ipv6_route_host_info_t routes[kRouteUpdateBatchSize];
+    uint16_t               count;
+
+    // The routing table keeps the snapshot position, and only moves it once a page is in NCP buffer, so a page that
+    // did not fit is read again. Routes added after the start are reported as regular batches instead.
+
+    if (!mRouteSnapshotStarted)
+    {
+        flags |= SPINEL_ROUTING_TABLE_BATCH_FLAG_SNAPSHOT_START;
+        ipv6_route_table_host_snapshot_start();
+    }
+
+    count = ipv6_route_table_get_host_routes(routes, kRouteUpdateBatchSize);
+
+    if (count < kRouteUpdateBatchSize)
+    {
+        flags |= SPINEL_ROUTING_TABLE_BATCH_FLAG_SNAPSHOT_END;
+    }
+
+    SuccessOrExit(error = mEncoder.BeginFrame(static_cast<Spinel::Buffer::Priority>(CONFIG_NCP_ROUTE_UPDATE_PRIORITY),
+                                              header, SPINEL_CMD_PROP_VALUE_IS,
+                                              SPINEL_PROP_ROUTING_TABLE_UPDATE_BATCH));
+    SuccessOrExit(error = mEncoder.WriteUint16(mRouteUpdateSequence));
+    SuccessOrExit(error = mEncoder.WriteUint8(flags));
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        SuccessOrExit(error = WriteRouteUpdate(NEW, routes[i].prefix, routes[i].prefix_len, routes[i].next_hop,
+                                               routes[i].lifetime));
+    }
+
+    SuccessOrExit(error = mEncoder.EndFrame());
+
+    ipv6_route_table_host_routes_sent(count);
+    mRouteUpdateSequence++;
+
+    // The frame has the current state of the routes it covers, so additions and updates to them still waiting
+    // are stale.
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        RemoveRouteUpdate(routes[i].prefix, routes[i].prefix_len, routes[i].next_hop);
+    }
+
+    if (flags & SPINEL_ROUTING_TABLE_BATCH_FLAG_SNAPSHOT_END)
+    {
+        mRouteSnapshotActive = false;
+    }
+
+    mRouteSnapshotStarted = true;
+
+exit:
+    return error;
+}
+
 
 extern "C" otError nanostack_process_stream_net_from_host(uint8_t* framePtr, uint16_t length);
 
+otError NcpBase::HandleDatagramFromHost(const uint8_t *aFrame, uint16_t aLength)
+{
+    otError error = nanostack_process_stream_net_from_host(const_cast<uint8_t *>(aFrame), aLength);
+
+    if (error == OT_ERROR_NONE)
+    {
+        mInboundSecureIpFrameCounter++;
+    }
+    else
+    {
+        mDroppedInboundIpFrameCounter++;
+#ifdef WISUN_FAN_DEBUG
+        num_drop_frame_from_host++;
+#endif
+    }
+
+    return error;
+}
+
 template <> otError NcpBase::HandlePropertySet<SPINEL_PROP_STREAM_NET>(void)
 {
     const uint8_t *framePtr = NULL;
     uint16_t       frameLen = 0;
     const uint8_t *metaPtr  = NULL;
     uint16_t       metaLen  = 0;
-    otMessage *    message  = NULL;
     otError        error    = OT_ERROR_NONE;
 
     SuccessOrExit(error = mDecoder.ReadDataWithLen(framePtr, frameLen));
     SuccessOrExit(error = mDecoder.ReadData(metaPtr, metaLen));
 
-    nanostack_process_stream_net_from_host((uint8_t*) framePtr, frameLen);
+    // The stack's error is reported back to host, and the packet is
+    // counted as received or dropped by HandleDatagramFromHost().
+    return HandleDatagramFromHost(framePtr, frameLen);
 
 exit:
+    // Malformed frame, nothing was handed to the stack.
     mDroppedInboundIpFrameCounter++;
 #ifdef WISUN_FAN_DEBUG
     num_drop_frame_from_host++;
@@ -908,6 +1270,58 @@ exit:
     return error;
 }
 
+template <> otError NcpBase::HandlePropertySet<SPINEL_PROP_STREAM_NET_MULTI>(void)
+{
+    const uint8_t *framePtr = NULL;
+    uint16_t       frameLen = 0;
+    otError        error    = OT_ERROR_NONE;
+    otError        result   = OT_ERROR_NONE;
+    otError        status;
+
+    // Each packet is handed to the stack on its own, a packet that is
+    // dropped does not prevent the following ones from being sent. The
+    // last error (if any) is reported back to host.
+
+    while (!mDecoder.IsAllRead())
+    {
+        SuccessOrExit(error = mDecoder.ReadDataWithLen(framePtr, frameLen));
+
+        status = HandleDatagramFromHost(framePtr, frameLen);
+
+        if (status != OT_ERROR_NONE)
+        {
+            result = status;
+        }
+    }
+
+    return result;
+
+exit:
+    // The rest of the value can not be split into packets, so it is counted
+    // as one dropped packet. Packets before it have been counted already.
+    mDroppedInboundIpFrameCounter++;
+#ifdef WISUN_FAN_DEBUG
+    num_drop_frame_from_host++;
+#endif
+
+    return error;
+}
+
+template <> otError NcpBase::HandlePropertyGet<SPINEL_PROP_STREAM_FLOW_CONTROL>(void)
+{
+    otError error = OT_ERROR_NONE;
+
+    // Free space of each NCP TX buffer priority level, lowest first.
+    for (uint8_t priority = 0; priority < Spinel::Buffer::GetNumPriorities(); priority++)
+    {
+        SuccessOrExit(error = mEncoder.WriteUint16(
+                          mTxFrameBuffer.GetFreeSpace(static_cast<Spinel::Buffer::Priority>(priority))));
+    }
+
+exit:
+    return error;
+}
+
 void NcpBase::HandleDatagramFromStack(otMessage *aMessage)
 {
     VerifyOrExit(aMessage != NULL, OT_NOOP);
@@ -931,43 +1345,152 @@ exit:
 }
 
 
-extern "C" void nanostack_process_stream_net_from_stack(buffer_t *buf)
+extern "C" buffer_t *nanostack_process_stream_net_from_stack(buffer_t *buf)
 {
     ot::Ncp::NcpBase *ncp = ot::Ncp::NcpBase::GetNcpInstance();
-    otMessageSettings settings = {true, OT_MESSAGE_PRIORITY_NORMAL};
-    Message* message  = NULL;
-    uint8_t* aData = buffer_ipv6_pointer(buf);
-    uint16_t aDataLength = buffer_ipv6_length(buf);
 
 #ifdef WISUN_FAN_DEBUG
     num_ip_packet_to_host++;
 #endif
-    
+
     if (ncp == NULL || buf->ipv6_buf_ptr == 0xFFFF)
     {
        // tr_debug("\n NCP Instance is empty or IPv6 Buf Ptr is invalid!!!");
-        goto exit;
+        return buffer_free(buf);
     }
 
-    VerifyOrExit((message = ncp->GetOtInstance()->mMessagePool.New(Message::kTypeIp6, 0, &settings)) != NULL, OT_NOOP);
+    // The datagram is sent to host straight from the stack buffer, which
+    // NCP frees once it has been sent.
+    ncp->HandleDatagramFromStack(buf);
+
+    return NULL;
+}
 
-    if (message->Append(aData, aDataLength) != OT_ERROR_NONE)
+void NcpBase::HandleDatagramFromStack(buffer_t *aBuffer)
+{
+    if (mStackDatagramQueueCount >= kStackDatagramQueueSize)
     {
-        message->Free();
-        message = NULL;
+        // Out of queue entries, the datagram gets dropped.
+        mDroppedOutboundIpFrameCounter++;
+        buffer_free(aBuffer);
+        ExitNow();
     }
 
-    ncp->HandleDatagramFromStack((otMessage*) message);
+    mStackDatagramQueue[(mStackDatagramQueueHead + mStackDatagramQueueCount) % kStackDatagramQueueSize] = aBuffer;
+    mStackDatagramQueueCount++;
+
+    // If there is no queued spinel command response, try to send the
+    // datagram immediately. Otherwise it will be sent from
+    // `HandleFrameRemovedFromNcpBuffer()` when buffer space becomes
+    // available and after any pending spinel command response.
+
+    if (IsResponseQueueEmpty())
+    {
+        IgnoreReturnValue(SendQueuedStackDatagrams());
+    }
 
 exit:
-    //buffer_free(buf);
-    /* Received Packet gets dropped due to mismatch priority or non availability
-     * of message buffers
-     */
-   // tr_debug("\n Received Packet is dropped due to non-availability of buffers");
     return;
 }
 
+otError NcpBase::SendQueuedStackDatagrams(void)
+{
+    otError error = OT_ERROR_NONE;
+
+    while (mStackDatagramQueueCount > 0)
+    {
+        SuccessOrExit(error = SendStackDatagram(mStackDatagramQueue[mStackDatagramQueueHead]));
+
+        // The buffer is now owned by the spinel frame carrying it.
+        mStackDatagramQueueHead = (mStackDatagramQueueHead + 1) % kStackDatagramQueueSize;
+        mStackDatagramQueueCount--;
+    }
+
+exit:
+    return error;
+}
+
+otError NcpBase::SendStackDatagram(buffer_t *aBuffer)
+{
+    otError  error  = OT_ERROR_NONE;
+    uint8_t  header = SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0;
+    uint16_t length = buffer_ipv6_length(aBuffer);
+
+    SuccessOrExit(error = mEncoder.BeginFrame(static_cast<Spinel::Buffer::Priority>(CONFIG_NCP_STREAM_NET_PRIORITY),
+                                              header, SPINEL_CMD_PROP_VALUE_IS, SPINEL_PROP_STREAM_NET));
+    SuccessOrExit(error = mEncoder.WriteUint16(length));
+
+    // The datagram is referenced from the stack buffer rather than copied
+    // into the NCP buffer, the stack buffer is freed when the frame is
+    // removed from the NCP buffer.
+    SuccessOrExit(error = mEncoder.WriteExternalData(buffer_ipv6_pointer(aBuffer), length,
+                                                     &NcpBase::HandleStackDatagramRemoved, aBuffer));
+
+    // Append metadata (rssi, etc)
+    SuccessOrExit(error = mEncoder.WriteInt8(aBuffer->options.dbm)); // RSSI
+    SuccessOrExit(error = mEncoder.WriteInt8(-128));                 // Noise Floor (Currently unused)
+    SuccessOrExit(error = mEncoder.WriteUint16(0));                  // Flags
+
+    SuccessOrExit(error = mEncoder.OpenStruct());                      // PHY-data
+    SuccessOrExit(error = mEncoder.WriteUint8(aBuffer->options.channel)); // 802.15.4 channel (Receive channel)
+    SuccessOrExit(error = mEncoder.WriteUint8(aBuffer->options.lqi));     // 802.15.4 LQI
+    SuccessOrExit(error = mEncoder.CloseStruct());
+
+    SuccessOrExit(error = mEncoder.EndFrame());
+    mOutboundSecureIpFrameCounter++;
+
+exit:
+    return error;
+}
+
+void NcpBase::HandleStackDatagramRemoved(void *aContext)
+{
+    buffer_free(static_cast<buffer_t *>(aContext));
+}
+
+#ifdef NS_TRACE_DEFERRED
+void NcpBase::HandleTraceDrainTimer(void *aContext)
+{
+    IgnoreReturnValue(static_cast<NcpBase *>(aContext)->SendQueuedTraceRecords());
+}
+
+otError NcpBase::SendQueuedTraceRecords(void)
+{
+    otError  error  = OT_ERROR_NONE;
+    uint8_t  header = SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0;
+    uint8_t  records[CONFIG_NCP_TRACE_FRAME_SIZE];
+    uint16_t length;
+
+    VerifyOrExit(!mDisableStreamWrite, error = OT_ERROR_INVALID_STATE);
+    VerifyOrExit(!mChangedPropsSet.IsPropertyFiltered(SPINEL_PROP_STREAM_LOG_BINARY), OT_NOOP);
+
+    // Same as `StreamWrite()`, traces must not hold up command responses. They are
+    // also kept to half of the NCP buffer, so they can not crowd out IPv6 traffic.
+
+    VerifyOrExit(IsResponseQueueEmpty(), error = OT_ERROR_NO_BUFS);
+
+    while (mTxFrameBuffer.GetFreeSpace(static_cast<Spinel::Buffer::Priority>(CONFIG_NCP_STREAM_LOG_PRIORITY)) >=
+           kTxBufferSize / 2 + sizeof(records))
+    {
+        // Records are left in the trace ring until the frame has been
+        // written, so they are sent on the next attempt if it fails.
+        length = ns_trace_deferred_peek(records, sizeof(records));
+        VerifyOrExit(length > 0, OT_NOOP);
+
+        SuccessOrExit(error = mEncoder.BeginFrame(static_cast<Spinel::Buffer::Priority>(CONFIG_NCP_STREAM_LOG_PRIORITY),
+                                                  header, SPINEL_CMD_PROP_VALUE_IS, SPINEL_PROP_STREAM_LOG_BINARY));
+        SuccessOrExit(error = mEncoder.WriteData(records, length));
+        SuccessOrExit(error = mEncoder.EndFrame());
+
+        ns_trace_deferred_commit();
+    }
+
+    error = OT_ERROR_NO_BUFS;
+
+exit:
+    return error;
+}
+#endif // NS_TRACE_DEFERRED
 
 otError NcpBase::SendQueuedDatagramMessages(void)
 {
@@ -1010,7 +1533,8 @@ otError NcpBase::SendDatagramMessage(otMessage *aMessage)
       //  tr_debug("\n Error: Attempting to send an un secure IPv6 frame to host");
     }
 
-    SuccessOrExit(error = mEncoder.BeginFrame(header, SPINEL_CMD_PROP_VALUE_IS, propKey));
+    SuccessOrExit(error = mEncoder.BeginFrame(static_cast<Spinel::Buffer::Priority>(CONFIG_NCP_STREAM_NET_PRIORITY),
+                                              header, SPINEL_CMD_PROP_VALUE_IS, propKey));
     SuccessOrExit(error = mEncoder.WriteUint16(otMessageGetLength(aMessage)));
     SuccessOrExit(error = mEncoder.WriteMessage(aMessage));
 
@@ -1313,132 +1837,84 @@ template <> otError NcpBase::HandlePropertyGet<SPINEL_PROP_CONNECTED_DEVICES>(vo
 #ifdef HAVE_RPL_ROOT
     otError error = OT_ERROR_NONE;
     rpl_instance_t *instance;
-    rpl_dao_target_list_t *dao_targets;
-    int i;
+    const rpl_dao_target_t *block[CONFIG_NCP_CONNECTED_DEVICES_BLOCK_SIZE];
+    uint16_t devices_in_block = 0;
+    bool last_block = true;
+    uint16_t i;
 
-    // New call to property get, retrieve all connected devices and set num_dao_targets
-    if (num_dao_targets == 0)
+    if (get_current_net_state() != 5 ||
+        cfg_props.wisun_device_type != MESH_DEVICE_TYPE_WISUN_BORDER_ROUTER)
     {
-        /* Not expected to have a valid pointer here. Added as a safety check to prevent memory leak */
-        if(connected_device_ipv6_addrs)
-        {
-            ns_dyn_mem_free(connected_device_ipv6_addrs);
-            connected_device_ipv6_addrs = NULL;
-        }
-
-        if (get_current_net_state() != 5 ||
-            cfg_props.wisun_device_type != MESH_DEVICE_TYPE_WISUN_BORDER_ROUTER)
-        {
-            error = OT_ERROR_INVALID_STATE;
-        }
-        SuccessOrExit(error);
-
-        instance = get_rpl_instance();
-        if (instance == NULL)
-        {
-            SuccessOrExit(error = mEncoder.WriteUint8(1<<7));
-            return error;
-        }
-
-        dao_targets = &instance->dao_targets;
-        if (dao_targets == NULL)
-        {
-            SuccessOrExit(error = mEncoder.WriteUint8(1<<7));
-            return error;
-        }
-
-        platform_enter_critical();
-        num_dao_targets = ns_list_count(dao_targets); // Max possible number of dao targets
-        platform_exit_critical();
-        if (num_dao_targets == 0)
-        {
-            SuccessOrExit(error = mEncoder.WriteUint8(1<<7));
-            return error;
-        }
-
-        connected_device_ipv6_addrs = (uint8_t *) ns_dyn_mem_alloc(sizeof(uint8_t) * 16 * num_dao_targets);
-        if (!connected_device_ipv6_addrs)
-        {
-            error = OT_ERROR_FAILED;
-        }
-        SuccessOrExit(error);
+        error = OT_ERROR_INVALID_STATE;
+    }
+    SuccessOrExit(error);
 
-        num_dao_targets = 0; // Reuse for calculating actual number of dao targets stored
+    // New call to property get, start from the lowest address
+    if (!connected_devices_in_progress)
+    {
         block_index = 0;
-        platform_enter_critical();
-        ns_list_foreach(rpl_dao_target_t, target, dao_targets) {
-            if (target->root)
-            {
-                memcpy(&connected_device_ipv6_addrs[16*num_dao_targets], target->prefix, 16);
-                num_dao_targets++;
-            }
-        }
-        platform_exit_critical();
-
-        if (num_dao_targets == 0)
-        {
-            SuccessOrExit(error = mEncoder.WriteUint8(1<<7));
-            return error;
-        }
     }
 
-    // Send block of ipv6 addresses if addresses remain
-    if (num_dao_targets > 0)
+    instance = get_rpl_instance();
+    if (instance != NULL)
     {
-        if (connected_device_ipv6_addrs)
-        {
-            uint16_t devices_in_block;
-            if (num_dao_targets >= CONNECTED_DEVICES_BLOCK_SIZE)
-            {
-                devices_in_block = CONNECTED_DEVICES_BLOCK_SIZE;
-                num_dao_targets -= CONNECTED_DEVICES_BLOCK_SIZE;
-            }
-            else
+        // Devices are sent in ascending address order: each block takes the lowest addresses after the last one
+        // sent, straight from the DAO target list. The list is reordered as the DODAG changes, so a position in it
+        // would not hold from one block to the next.
+        ns_list_foreach(rpl_dao_target_t, target, &instance->dao_targets) {
+            if (!target->root ||
+                (connected_devices_in_progress && memcmp(target->prefix, connected_devices_cursor, 16) <= 0))
             {
-                devices_in_block = num_dao_targets;
-                num_dao_targets = 0;
+                continue;
             }
 
-            // Write connected devices block header (1 byte):
-            // 1 for last block, 0 for blocks remaining
-            if (num_dao_targets == 0)
+            if (devices_in_block == CONFIG_NCP_CONNECTED_DEVICES_BLOCK_SIZE)
             {
-                SuccessOrExit(error = mEncoder.WriteUint8((1<<7) + block_index));
+                last_block = false;
+                if (memcmp(target->prefix, block[devices_in_block - 1]->prefix, 16) >= 0)
+                {
+                    continue;
+                }
+                i = devices_in_block - 1;
             }
             else
             {
-                SuccessOrExit(error = mEncoder.WriteUint8(block_index));
+                i = devices_in_block++;
             }
 
-            // Write all IPv6 addresses in block
-            for (i = 0; i < devices_in_block; i++)
+            while (i > 0 && memcmp(target->prefix, block[i - 1]->prefix, 16) < 0)
             {
-                SuccessOrExit(error = mEncoder.WriteIp6Address(
-                        &connected_device_ipv6_addrs[16 * (num_dao_targets + i)]));
+                block[i] = block[i - 1];
+                i--;
             }
-            block_index++;
-        }
-        else
-        {
-            error = OT_ERROR_FAILED;
+            block[i] = target;
         }
-        SuccessOrExit(error);
+    }
 
-        if (connected_device_ipv6_addrs && num_dao_targets == 0)
-        {
-            ns_dyn_mem_free(connected_device_ipv6_addrs);
-            connected_device_ipv6_addrs = NULL;
-        }
+    // Write connected devices block header (1 byte):
+    // 1 in bit 7 for last block, 0 for blocks remaining, block index in the rest
+    SuccessOrExit(error = mEncoder.WriteUint8((last_block ? (1<<7) : 0) | (block_index & 0x7F)));
+
+    // Write all IPv6 addresses in block
+    for (i = 0; i < devices_in_block; i++)
+    {
+        SuccessOrExit(error = mEncoder.WriteIp6Address(block[i]->prefix));
+    }
+
+    if (last_block)
+    {
+        connected_devices_in_progress = false;
+    }
+    else
+    {
+        memcpy(connected_devices_cursor, block[devices_in_block - 1]->prefix, 16);
+        connected_devices_in_progress = true;
+        block_index++;
     }
 exit:
     if (error != OT_ERROR_NONE)
     {
-        num_dao_targets = 0;
-        if (connected_device_ipv6_addrs)
-        {
-            ns_dyn_mem_free(connected_device_ipv6_addrs);
-            connected_device_ipv6_addrs = NULL;
-        }
+        connected_devices_in_progress = false;
     }
     return error;
 #else
@@ -1446,6 +1922,17 @@ exit:
 #endif
 }
 
+template <> otError NcpBase::HandlePropertyGet<SPINEL_PROP_CONNECTED_DEVICES_GENERATION>(void)
+{
+#ifdef HAVE_RPL_ROOT
+    rpl_instance_t *instance = get_rpl_instance();
+
+    return mEncoder.WriteUint16((instance != NULL) ? instance->dao_target_generation : 0);
+#else
+    return OT_ERROR_NOT_IMPLEMENTED;
+#endif
+}
+
 template <> otError NcpBase::HandlePropertyGet<SPINEL_PROP_DODAG_ROUTE_DEST>(void)
 {
 #ifdef HAVE_RPL_ROOT
@@ -1495,6 +1982,41 @@ template <> otError NcpBase::HandlePropertySet<SPINEL_PROP_REVOKE_GTK_HWADDR>(vo
 #endif
 }
 
+template <> otError NcpBase::HandlePropertySet<SPINEL_PROP_ROUTING_TABLE_RESYNC>(void)
+{
+    // Additions and updates still waiting are dropped as the snapshot frames covering their routes are sent.
+    mRouteSnapshotActive  = true;
+    mRouteSnapshotStarted = false;
+
+    // First frame goes out now, the rest from `HandleFrameRemovedFromNcpBuffer()` as NCP buffer space frees up.
+    IgnoreReturnValue(SendQueuedRouteUpdates());
+
+    return OT_ERROR_NONE;
+}
+
+template <> otError NcpBase::HandlePropertyGet<SPINEL_PROP_ROUTING_TABLE_UPDATE_WINDOW>(void)
+{
+    return mEncoder.WriteUint16(mRouteUpdateWindow);
+}
+
+template <> otError NcpBase::HandlePropertySet<SPINEL_PROP_ROUTING_TABLE_UPDATE_WINDOW>(void)
+{
+    otError error = OT_ERROR_NONE;
+
+    SuccessOrExit(error = mDecoder.ReadUint16(mRouteUpdateWindow));
+
+    if ((mRouteUpdateWindow == 0) && (mRouteUpdateTimer != NULL))
+    {
+        // Changes waiting for the window go out now, later ones in frames of their own.
+        eventOS_timeout_cancel(mRouteUpdateTimer);
+        mRouteUpdateTimer = NULL;
+        IgnoreReturnValue(SendQueuedRouteUpdates());
+    }
+
+exit:
+    return error;
+}
+
 extern "C" rpl_dao_target_t *get_dao_target_from_addr(rpl_instance_t *instance, const uint8_t *addr);
 // Destination IPv6 address used by GET DODAG_ROUTE is determined by SET DODAG_ROUTE_DEST
 template <> otError NcpBase::HandlePropertyGet<SPINEL_PROP_DODAG_ROUTE>(void)
@@ -1503,11 +2025,11 @@ template <> otError NcpBase::HandlePropertyGet<SPINEL_PROP_DODAG_ROUTE>(void)
     otError error = OT_ERROR_NONE;
     struct rpl_instance *instance;
     bool connected = false;
-    uint8_t *route_list;
+    rpl_dao_target_t *dest_target;
     rpl_dao_target_t *dao_target;
-    uint16_t max_targets;
+    rpl_dao_root_transit_t *transit;
+    uint16_t hops = 0;
     uint8_t path_cost = 0;
-    uint16_t curr_target_index = 0;
 
     if (get_current_net_state() != 5 ||
         cfg_props.wisun_device_type != MESH_DEVICE_TYPE_WISUN_BORDER_ROUTER)
@@ -1523,48 +2045,36 @@ template <> otError NcpBase::HandlePropertyGet<SPINEL_PROP_DODAG_ROUTE>(void)
     }
     SuccessOrExit(error);
 
-    platform_enter_critical();
-    dao_target = get_dao_target_from_addr(instance, dodag_route_dest_addr);
-    if (dao_target == NULL)
-    {
-        error = OT_ERROR_NO_ROUTE;
-    }
-    SuccessOrExit(error);
-
-    max_targets = ns_list_count(&instance->dao_targets); // Max possible number of dao targets
-    if (max_targets == 0)
+    dest_target = get_dao_target_from_addr(instance, dodag_route_dest_addr);
+    if (dest_target == NULL)
     {
         error = OT_ERROR_NO_ROUTE;
     }
     SuccessOrExit(error);
 
-    route_list = (uint8_t *) ns_dyn_mem_alloc(sizeof(uint8_t) * 16 * max_targets);
-    if (!route_list)
+    // Walk up to the root to check the path and add up its cost. A path can not have more hops than there are
+    // targets, which also stops the walk on a parent loop.
+    dao_target = dest_target;
+    while (hops < instance->dao_target_count)
     {
-        error = OT_ERROR_FAILED;
-    }
-    SuccessOrExit(error);
-
-    while (1)
-    {
-        rpl_dao_root_transit_t *transit = ns_list_get_first(&dao_target->info.root.transits);
-        rpl_dao_target_t *parent = transit->parent;
-        memcpy(&route_list[16*curr_target_index], transit->transit, 16);
-        curr_target_index++;
+        transit = ns_list_get_first(&dao_target->info.root.transits);
+        if (transit == NULL)
+        {
+            break;
+        }
+        hops++;
         path_cost += transit->cost;
 
         // Finished if we hit NULL - ourselves
-        if (parent == NULL) {
+        if (transit->parent == NULL) {
             connected = true;
             break;
         }
-        if (!parent->connected) {
-            connected = false;
+        if (!transit->parent->connected) {
             break;
         }
-        dao_target = parent;
+        dao_target = transit->parent;
     }
-    platform_exit_critical();
 
     if (!connected)
     {
@@ -1572,17 +2082,21 @@ template <> otError NcpBase::HandlePropertyGet<SPINEL_PROP_DODAG_ROUTE>(void)
     }
     SuccessOrExit(error);
 
+    // Hops are written from the root down. Rather than keeping a copy of the path, walk up again from the
+    // destination for each one; paths are short.
     SuccessOrExit(error = mEncoder.WriteUint8(path_cost)); // Path cost
-    for (int i = curr_target_index - 1; i >= 0; i--)
+    for (uint16_t i = hops; i > 0; i--)
     {
-        SuccessOrExit(error = mEncoder.WriteIp6Address(&route_list[16 * i]));
+        dao_target = dest_target;
+        for (uint16_t j = 1; j < i; j++)
+        {
+            dao_target = ns_list_get_first(&dao_target->info.root.transits)->parent;
+        }
+        transit = ns_list_get_first(&dao_target->info.root.transits);
+        SuccessOrExit(error = mEncoder.WriteIp6Address(transit->transit));
     }
     SuccessOrExit(error = mEncoder.WriteIp6Address(dodag_route_dest_addr));
 exit:
-    if (route_list)
-    {
-        ns_dyn_mem_free(route_list);
-    }
     if (error == OT_ERROR_NO_ROUTE)
     {
         mEncoder.WriteUint8(0); // Path cost 0
@@ -1602,10 +2116,10 @@ extern "C" void nanostack_process_routing_table_update_from_stack(uint8_t change
     return;
 }
 
-extern "C" void nanostack_process_stream_net_from_stack(buffer_t *buf)
+extern "C" buffer_t *nanostack_process_stream_net_from_stack(buffer_t *buf)
 {
     // Stub function
-    return;
+    return buffer_free(buf);
 }
 
 
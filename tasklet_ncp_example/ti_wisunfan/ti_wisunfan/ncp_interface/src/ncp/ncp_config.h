@@ -116,4 +116,113 @@
 #define CONFIG_NCP_SPINEL_RESPONSE_QUEUE_SIZE 15
 #endif
 
+/**
+ * @def CONFIG_NCP_STACK_DATAGRAM_QUEUE_SIZE
+ *
+ * Number of IPv6 datagrams from the Wi-SUN stack that NCP can hold while waiting for space in the NCP TX buffer.
+ *
+ * The datagrams are kept in the stack buffers they were received in and are sent to host without being copied. When
+ * the queue is full, further datagrams are dropped.
+ *
+ */
+#ifndef CONFIG_NCP_STACK_DATAGRAM_QUEUE_SIZE
+#define CONFIG_NCP_STACK_DATAGRAM_QUEUE_SIZE 8
+#endif
+
+/**
+ * @def CONFIG_NCP_STREAM_NET_PRIORITY
+ *
+ * The NCP TX buffer priority level used for IPv6 datagrams (`SPINEL_PROP_STREAM_NET`) sent to host.
+ *
+ * Must be less than `OPENTHREAD_SPINEL_CONFIG_BUFFER_NUM_PRIORITIES`. Responses to host commands always use
+ * `Spinel::Buffer::kPriorityHigh` and other unsolicited frames use `Spinel::Buffer::kPriorityLow`.
+ *
+ */
+#ifndef CONFIG_NCP_STREAM_NET_PRIORITY
+#define CONFIG_NCP_STREAM_NET_PRIORITY 0
+#endif
+
+/**
+ * @def CONFIG_NCP_STREAM_LOG_PRIORITY
+ *
+ * The NCP TX buffer priority level used for log and debug stream frames sent to host.
+ *
+ * Must be less than `OPENTHREAD_SPINEL_CONFIG_BUFFER_NUM_PRIORITIES`.
+ *
+ */
+#ifndef CONFIG_NCP_STREAM_LOG_PRIORITY
+#define CONFIG_NCP_STREAM_LOG_PRIORITY 0
+#endif
+
+/**
+ * @def CONFIG_NCP_TRACE_DRAIN_INTERVAL_MS
+ *
+ * Interval in milliseconds at which NCP sends deferred trace records (`NS_TRACE_DEFERRED`) to host as
+ * `SPINEL_PROP_STREAM_LOG_BINARY`, when no other frame leaving the NCP TX buffer has already done so.
+ *
+ */
+#ifndef CONFIG_NCP_TRACE_DRAIN_INTERVAL_MS
+#define CONFIG_NCP_TRACE_DRAIN_INTERVAL_MS 100
+#endif
+
+/**
+ * @def CONFIG_NCP_TRACE_FRAME_SIZE
+ *
+ * Maximum size in bytes of deferred trace records carried in one `SPINEL_PROP_STREAM_LOG_BINARY` frame. Must be at
+ * least the largest trace record (`NS_TRACE_DEFERRED_RECORD_WORDS` * 4), and is taken from the stack when sending.
+ *
+ */
+#ifndef CONFIG_NCP_TRACE_FRAME_SIZE
+#define CONFIG_NCP_TRACE_FRAME_SIZE 128
+#endif
+
+/**
+ * @def CONFIG_NCP_ROUTE_UPDATE_PRIORITY
+ *
+ * The NCP TX buffer priority level used for routing table updates (`SPINEL_PROP_ROUTING_TABLE_UPDATE`) sent to host.
+ *
+ * Must be less than `OPENTHREAD_SPINEL_CONFIG_BUFFER_NUM_PRIORITIES`.
+ *
+ */
+#ifndef CONFIG_NCP_ROUTE_UPDATE_PRIORITY
+#define CONFIG_NCP_ROUTE_UPDATE_PRIORITY 0
+#endif
+
+/**
+ * @def CONFIG_NCP_ROUTE_UPDATE_WINDOW_MS
+ *
+ * Time in milliseconds NCP collects routing table changes before reporting them to host in one
+ * `SPINEL_PROP_ROUTING_TABLE_UPDATE_BATCH` frame, until host writes `SPINEL_PROP_ROUTING_TABLE_UPDATE_WINDOW`.
+ *
+ * Zero sends every change right away in its own `SPINEL_PROP_ROUTING_TABLE_UPDATE` frame, as hosts that do not
+ * know the batch frame expect.
+ *
+ */
+#ifndef CONFIG_NCP_ROUTE_UPDATE_WINDOW_MS
+#define CONFIG_NCP_ROUTE_UPDATE_WINDOW_MS 0
+#endif
+
+/**
+ * @def CONFIG_NCP_ROUTE_UPDATE_BATCH_SIZE
+ *
+ * Maximum number of routing table changes NCP holds and reports in one `SPINEL_PROP_ROUTING_TABLE_UPDATE_BATCH` frame.
+ *
+ * A frame takes about 40 bytes per change, so it has to fit in the NCP TX buffer. When the batch fills up before the
+ * window ends it is sent early.
+ *
+ */
+#ifndef CONFIG_NCP_ROUTE_UPDATE_BATCH_SIZE
+#define CONFIG_NCP_ROUTE_UPDATE_BATCH_SIZE 8
+#endif
+
+/**
+ * @def CONFIG_NCP_CONNECTED_DEVICES_BLOCK_SIZE
+ *
+ * Maximum number of device addresses NCP returns for one `SPINEL_PROP_CONNECTED_DEVICES` get.
+ *
+ */
+#ifndef CONFIG_NCP_CONNECTED_DEVICES_BLOCK_SIZE
+#define CONFIG_NCP_CONNECTED_DEVICES_BLOCK_SIZE 1
+#endif
+
 #endif // CONFIG_NCP_H_
@@ -93,7 +93,8 @@ NcpUart::NcpUart(Instance *aInstance)
     , mFrameDecoder(mRxBuffer, &NcpUart::HandleFrame, this)
     , mUartBuffer()
     , mState(kStartingFrame)
-    , mByte(0)
+    , mTxChunkLength(0)
+    , mTxChunkOffset(0)
     , mRxBuffer()
     , mUartSendImmediate(false)
     //mv , mUartSendTask(*aInstance, EncodeAndSendToUart, this)
@@ -167,15 +168,28 @@ void NcpUart::EncodeAndSendToUart(void)
 
             txFrameBuffer.OutFrameBegin();
 
-            mState = kEncodingFrame;
+            mState         = kEncodingFrame;
+            mTxChunkLength = 0;
+            mTxChunkOffset = 0;
 
-            while (!txFrameBuffer.OutFrameHasEnded())
+            while (!txFrameBuffer.OutFrameHasEnded() || (mTxChunkOffset < mTxChunkLength))
             {
-                mByte = txFrameBuffer.OutFrameReadByte();
+                if (mTxChunkOffset == mTxChunkLength)
+                {
+                    mTxChunkLength = static_cast<uint8_t>(txFrameBuffer.OutFrameRead(sizeof(mTxChunk), mTxChunk));
+                    mTxChunkOffset = 0;
+                }
 
             case kEncodingFrame:
+            {
+                uint16_t encodedLength;
+                otError  error;
 
-                SuccessOrExit(mFrameEncoder.Encode(mByte));
+                // Encode what fits into the uart buffer, the rest of the chunk is encoded after it has been sent.
+                error = mFrameEncoder.Encode(&mTxChunk[mTxChunkOffset], mTxChunkLength - mTxChunkOffset, encodedLength);
+                mTxChunkOffset += encodedLength;
+                SuccessOrExit(error);
+            }
             }
 
             // track the change of mHostPowerStateInProgress by the
@@ -385,6 +399,21 @@ uint8_t NcpUart::Spinel::BufferEncrypterReader::OutFrameReadByte(void)
     return mDataBuffer[mDataBufferReadIndex++];
 }
 
+uint16_t NcpUart::Spinel::BufferEncrypterReader::OutFrameRead(uint16_t aReadLength, uint8_t *aDataBuffer)
+{
+    uint16_t length = static_cast<uint16_t>(mOutputDataLength - mDataBufferReadIndex);
+
+    if (aReadLength < length)
+    {
+        length = aReadLength;
+    }
+
+    memcpy(aDataBuffer, &mDataBuffer[mDataBufferReadIndex], length);
+    mDataBufferReadIndex += length;
+
+    return length;
+}
+
 otError NcpUart::Spinel::BufferEncrypterReader::OutFrameRemove(void)
 {
     return mTxFrameBuffer.OutFrameRemove();
@@ -0,0 +1,61 @@
+#!/bin/sh
+#
+# Builds and runs the host test of the HDLC encoder and decoder, and the
+# benchmark of the NCP UART path.
+#
+#   build.sh [git revision]
+#
+# With a git revision, the benchmark is also built against the NCP sources of
+# that revision, e.g. the byte at a time encoder and decoder before the run
+# based ones. Set CXX and OUT to change the compiler and the build directory.
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+NCP=$(cd "$HERE/../../.." && pwd)
+OUT=${OUT:-${TMPDIR:-/tmp}/hdlc_test}
+CXX=${CXX:-c++}
+
+# Include paths and sources of an NCP tree
+tree_flags()
+{
+    INC="-I$1/src -I$1/src/core -I$1/src/lib/spinel -I$1/include -I$1/config"
+    SRC="$1/src/lib/hdlc/hdlc.cpp $1/src/lib/spinel/spinel_buffer.cpp"
+    if grep -q aEncodedLength "$1/src/lib/hdlc/hdlc.hpp"; then
+        DEF=""
+    else
+        DEF="-DHDLC_BENCH_PARTIAL_ENCODE=0"
+    fi
+}
+
+# Builds the benchmark against an NCP tree and runs it
+run_bench()
+{
+    $CXX -std=c++11 -O2 -DOPENTHREAD_SPINEL_CONFIG_OPENTHREAD_MESSAGE_ENABLE=0 $DEF $INC -o "$OUT/hdlc_bench$1" \
+        "$HERE/hdlc_bench.cpp" $SRC
+    "$OUT/hdlc_bench$1" 96 1000000
+    "$OUT/hdlc_bench$1" 1280
+}
+
+mkdir -p "$OUT"
+tree_flags "$NCP"
+
+$CXX -std=c++11 -O1 -g -fsanitize=address,undefined -DOPENTHREAD_CONFIG_ASSERT_ENABLE=1 -DOPENTHREAD_TARGET_LINUX \
+    $INC -o "$OUT/hdlc_test" "$HERE/hdlc_test.cpp" "$NCP/src/lib/hdlc/hdlc.cpp"
+for seed in 1 2 3; do
+    "$OUT/hdlc_test" $seed
+done
+
+echo "this tree:"
+run_bench
+
+if [ -n "$1" ]; then
+    TOP=$(git -C "$HERE" rev-parse --show-toplevel)
+    BASE=$OUT/$1
+    rm -rf "$BASE"
+    mkdir -p "$BASE"
+    git -C "$TOP" archive "$1" "$(git -C "$NCP" rev-parse --show-prefix)" | tar -x -C "$BASE"
+    tree_flags "$BASE/$(git -C "$NCP" rev-parse --show-prefix)"
+    echo "$1:"
+    run_bench "_$1"
+fi
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   Host benchmark of the NCP UART path.
+ *
+ *   Times moving a STREAM_NET frame out of Spinel::Buffer into a 128 byte
+ *   UART buffer through the HDLC encoder, a byte at a time as NcpUart used
+ *   to, and in 64 byte chunks through the partial encoder as it does now.
+ *   Also times decoding the encoded frame fed in 64 byte chunks.
+ *
+ *   hdlc_bench [frame length] [frames]
+ *
+ *   Build with HDLC_BENCH_PARTIAL_ENCODE=0 for sources without the partial
+ *   encoder. Build and run with build.sh.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "lib/hdlc/hdlc.hpp"
+#include "lib/spinel/spinel_buffer.hpp"
+
+#ifndef HDLC_BENCH_PARTIAL_ENCODE
+#define HDLC_BENCH_PARTIAL_ENCODE 1
+#endif
+
+using namespace ot;
+
+enum
+{
+    kUartBufferSize = 128,
+    kReadChunkSize  = 64,
+    kFrameMaxLength = 1280,
+};
+
+static uint8_t  sPayload[kFrameMaxLength];
+static uint32_t sSentBytes;
+
+static uint64_t BenchNowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000u + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+static void WriteFrame(Spinel::Buffer &aBuffer, uint16_t aLength)
+{
+    // Spinel header and command, then the datagram
+    aBuffer.InFrameBegin(Spinel::Buffer::kPriorityLow);
+    aBuffer.InFrameFeedData(sPayload, 8);
+    aBuffer.InFrameFeedData(sPayload + 8, aLength - 8);
+    aBuffer.InFrameEnd();
+}
+
+static void Flush(Hdlc::FrameBuffer<kUartBufferSize> &aUartBuffer)
+{
+    sSentBytes += aUartBuffer.GetLength();
+    aUartBuffer.Clear();
+}
+
+static void SendByteWise(Spinel::Buffer &aBuffer, Hdlc::FrameBuffer<kUartBufferSize> &aUartBuffer)
+{
+    Hdlc::Encoder encoder(aUartBuffer);
+
+    encoder.BeginFrame();
+    aBuffer.OutFrameBegin();
+
+    while (!aBuffer.OutFrameHasEnded())
+    {
+        uint8_t byte = aBuffer.OutFrameReadByte();
+
+        while (encoder.Encode(byte) != OT_ERROR_NONE)
+        {
+            Flush(aUartBuffer);
+        }
+    }
+
+    while (encoder.EndFrame() != OT_ERROR_NONE)
+    {
+        Flush(aUartBuffer);
+    }
+
+    Flush(aUartBuffer);
+    aBuffer.OutFrameRemove();
+}
+
+#if HDLC_BENCH_PARTIAL_ENCODE
+static void SendChunked(Spinel::Buffer &aBuffer, Hdlc::FrameBuffer<kUartBufferSize> &aUartBuffer)
+{
+    Hdlc::Encoder encoder(aUartBuffer);
+    uint8_t       chunk[kReadChunkSize];
+    uint16_t      chunkLength = 0;
+    uint16_t      chunkOffset = 0;
+
+    encoder.BeginFrame();
+    aBuffer.OutFrameBegin();
+
+    while (!aBuffer.OutFrameHasEnded() || chunkOffset < chunkLength)
+    {
+        uint16_t encodedLength;
+
+        if (chunkOffset == chunkLength)
+        {
+            chunkLength = aBuffer.OutFrameRead(sizeof(chunk), chunk);
+            chunkOffset = 0;
+        }
+
+        if (encoder.Encode(chunk + chunkOffset, chunkLength - chunkOffset, encodedLength) != OT_ERROR_NONE)
+        {
+            Flush(aUartBuffer);
+        }
+
+        chunkOffset += encodedLength;
+    }
+
+    while (encoder.EndFrame() != OT_ERROR_NONE)
+    {
+        Flush(aUartBuffer);
+    }
+
+    Flush(aUartBuffer);
+    aBuffer.OutFrameRemove();
+}
+#endif
+
+static void HandleFrame(void *aContext, otError aError)
+{
+    Hdlc::FrameBuffer<kFrameMaxLength + 2> *frame = static_cast<Hdlc::FrameBuffer<kFrameMaxLength + 2> *>(aContext);
+
+    if (aError != OT_ERROR_NONE)
+    {
+        printf("FAIL: decode error %d\n", aError);
+        exit(1);
+    }
+
+    frame->Clear();
+}
+
+int main(int argc, char *argv[])
+{
+    static uint8_t                                buffer[4096];
+    static Hdlc::FrameBuffer<2 * kFrameMaxLength> encoded;
+    static Hdlc::FrameBuffer<kFrameMaxLength + 2> decoded;
+    uint16_t length = (argc > 1) ? static_cast<uint16_t>(atoi(argv[1])) : kFrameMaxLength;
+    unsigned long                       frames = (argc > 2) ? static_cast<unsigned long>(atol(argv[2])) : 100000;
+    Spinel::Buffer                      spinelBuffer(buffer, sizeof(buffer));
+    Hdlc::FrameBuffer<kUartBufferSize>  uartBuffer;
+    Hdlc::Encoder                       encoder(encoded);
+    Hdlc::Decoder                       decoder(decoded, HandleFrame, &decoded);
+    uint64_t                            start;
+
+    if (length < 8 || length > kFrameMaxLength)
+    {
+        printf("FAIL: frame length %u\n", length);
+        return 1;
+    }
+
+    srand(1);
+    for (uint16_t i = 0; i < sizeof(sPayload); i++)
+    {
+        sPayload[i] = static_cast<uint8_t>(rand());
+    }
+
+    sSentBytes = 0;
+    start      = BenchNowNs();
+    for (unsigned long i = 0; i < frames; i++)
+    {
+        WriteFrame(spinelBuffer, length);
+        SendByteWise(spinelBuffer, uartBuffer);
+    }
+    printf("%u byte frame, byte-wise: %8.2f us/frame (%lu bytes sent)\n", length,
+           (BenchNowNs() - start) / 1e3 / frames, static_cast<unsigned long>(sSentBytes));
+
+#if HDLC_BENCH_PARTIAL_ENCODE
+    sSentBytes = 0;
+    start      = BenchNowNs();
+    for (unsigned long i = 0; i < frames; i++)
+    {
+        WriteFrame(spinelBuffer, length);
+        SendChunked(spinelBuffer, uartBuffer);
+    }
+    printf("%u byte frame, chunked:   %8.2f us/frame (%lu bytes sent)\n", length,
+           (BenchNowNs() - start) / 1e3 / frames, static_cast<unsigned long>(sSentBytes));
+#endif
+
+    encoder.BeginFrame();
+    for (uint16_t i = 0; i < length; i++)
+    {
+        encoder.Encode(sPayload[i]);
+    }
+    encoder.EndFrame();
+
+    start = BenchNowNs();
+    for (unsigned long i = 0; i < frames; i++)
+    {
+        for (uint16_t offset = 0; offset < encoded.GetLength(); offset += kReadChunkSize)
+        {
+            uint16_t chunk = encoded.GetLength() - offset;
+
+            decoder.Decode(encoded.GetFrame() + offset, chunk < kReadChunkSize ? chunk : kReadChunkSize);
+        }
+    }
+    printf("%u byte frame, decode:    %8.2f us/frame\n", length, (BenchNowNs() - start) / 1e3 / frames);
+
+    return 0;
+}
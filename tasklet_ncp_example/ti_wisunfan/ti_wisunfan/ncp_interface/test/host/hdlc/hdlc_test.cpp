@@ -0,0 +1,448 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   Host test of the HDLC encoder and decoder against a reference.
+ *
+ *   The reference encodes and decodes a byte at a time, with the FCS
+ *   computed bit by bit, the way RFC 1662 describes it. Random frames, rich
+ *   in bytes that need escaping, are encoded whole into buffers of random
+ *   capacity, where each call must either fit or leave the buffer as it was,
+ *   and encoded piecewise with the partial Encode(), which must keep what
+ *   fits and continue where it stopped. Streams of valid, corrupt, truncated
+ *   and oversized frames with junk in between are decoded in random chunks
+ *   into buffers of random capacity, and must give the same frames and
+ *   errors as the reference.
+ *
+ *   hdlc_test [seed] [rounds]
+ *
+ *   Build and run with build.sh.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "lib/hdlc/hdlc.hpp"
+
+using namespace ot;
+
+enum
+{
+    kBufferSize = 4096,
+    kFlag       = 0x7e,
+    kEscape     = 0x7d,
+};
+
+static const uint8_t sSpecialBytes[] = {0x11, 0x13, 0x7d, 0x7e, 0xf8};
+
+static void TestFail(const char *aWhat, unsigned long aRound)
+{
+    printf("FAIL: %s in round %lu\n", aWhat, aRound);
+    exit(1);
+}
+
+// MARK: Reference
+
+static bool RefNeedsEscape(uint8_t aByte)
+{
+    return memchr(sSpecialBytes, aByte, sizeof(sSpecialBytes)) != NULL;
+}
+
+static uint16_t RefFcs(uint16_t aFcs, uint8_t aByte)
+{
+    aFcs ^= aByte;
+
+    for (int bit = 0; bit < 8; bit++)
+    {
+        aFcs = (aFcs & 1) ? static_cast<uint16_t>((aFcs >> 1) ^ 0x8408) : static_cast<uint16_t>(aFcs >> 1);
+    }
+
+    return aFcs;
+}
+
+static void RefEncodeByte(std::vector<uint8_t> &aOut, uint8_t aByte)
+{
+    if (RefNeedsEscape(aByte))
+    {
+        aOut.push_back(kEscape);
+        aOut.push_back(aByte ^ 0x20);
+    }
+    else
+    {
+        aOut.push_back(aByte);
+    }
+}
+
+static std::vector<uint8_t> RefEncode(const uint8_t *aData, uint16_t aLength)
+{
+    std::vector<uint8_t> out;
+
+    for (uint16_t i = 0; i < aLength; i++)
+    {
+        RefEncodeByte(out, aData[i]);
+    }
+
+    return out;
+}
+
+static std::vector<uint8_t> RefEncodeFrame(const uint8_t *aData, uint16_t aLength)
+{
+    std::vector<uint8_t> out(1, kFlag);
+    std::vector<uint8_t> data = RefEncode(aData, aLength);
+    uint16_t             fcs  = 0xffff;
+
+    out.insert(out.end(), data.begin(), data.end());
+
+    for (uint16_t i = 0; i < aLength; i++)
+    {
+        fcs = RefFcs(fcs, aData[i]);
+    }
+
+    fcs ^= 0xffff;
+    RefEncodeByte(out, fcs & 0xff);
+    RefEncodeByte(out, fcs >> 8);
+    out.push_back(kFlag);
+
+    return out;
+}
+
+struct DecodedFrame
+{
+    otError              mError;
+    std::vector<uint8_t> mFrame;
+
+    bool operator==(const DecodedFrame &aOther) const
+    {
+        return mError == aOther.mError && (mError != OT_ERROR_NONE || mFrame == aOther.mFrame);
+    }
+};
+
+// Decodes a byte at a time into a buffer of aCapacity bytes
+static std::vector<DecodedFrame> RefDecode(const std::vector<uint8_t> &aStream, uint16_t aCapacity)
+{
+    std::vector<DecodedFrame> frames;
+    std::vector<uint8_t>      frame;
+    enum
+    {
+        kNoSync,
+        kSync,
+        kEscaped,
+    } state     = kNoSync;
+    uint16_t fcs = 0xffff;
+
+    for (uint8_t byte : aStream)
+    {
+        switch (state)
+        {
+        case kNoSync:
+            if (byte == kFlag)
+            {
+                state = kSync;
+                frame.clear();
+                fcs = 0xffff;
+            }
+            break;
+
+        case kSync:
+        case kEscaped:
+            if (state == kSync && byte == kFlag)
+            {
+                if (!frame.empty())
+                {
+                    DecodedFrame decoded = {OT_ERROR_PARSE, frame};
+
+                    if (frame.size() >= 2 && fcs == 0xf0b8)
+                    {
+                        decoded.mError = OT_ERROR_NONE;
+                        decoded.mFrame.resize(frame.size() - 2);
+                    }
+                    frames.push_back(decoded);
+                }
+                frame.clear();
+                fcs = 0xffff;
+            }
+            else if (state == kSync && byte == kEscape)
+            {
+                state = kEscaped;
+            }
+            else if (frame.size() < aCapacity)
+            {
+                byte = (state == kEscaped) ? byte ^ 0x20 : byte;
+                fcs  = RefFcs(fcs, byte);
+                frame.push_back(byte);
+                state = kSync;
+            }
+            else
+            {
+                frames.push_back(DecodedFrame{OT_ERROR_NO_BUFS, frame});
+                state = kNoSync;
+            }
+            break;
+        }
+    }
+
+    return frames;
+}
+
+// MARK: Encoder and decoder under test
+
+// A frame buffer of kBufferSize bytes with only aCapacity bytes left to write
+static void PrepareBuffer(Hdlc::FrameBuffer<kBufferSize> &aBuffer, uint16_t aCapacity)
+{
+    static const uint8_t sZeros[kBufferSize] = {0};
+
+    aBuffer.Clear();
+    aBuffer.WriteBytes(sZeros, kBufferSize - aCapacity);
+}
+
+static std::vector<uint8_t> Written(Hdlc::FrameBuffer<kBufferSize> &aBuffer, uint16_t aCapacity)
+{
+    return std::vector<uint8_t>(aBuffer.GetFrame() + kBufferSize - aCapacity, aBuffer.GetFrame() + aBuffer.GetLength());
+}
+
+struct DecoderContext
+{
+    Hdlc::FrameBuffer<kBufferSize> *mBuffer;
+    uint16_t                        mCapacity;
+    std::vector<DecodedFrame>       mFrames;
+};
+
+static void HandleFrame(void *aContext, otError aError)
+{
+    DecoderContext *context = static_cast<DecoderContext *>(aContext);
+
+    context->mFrames.push_back(DecodedFrame{aError, Written(*context->mBuffer, context->mCapacity)});
+    PrepareBuffer(*context->mBuffer, context->mCapacity);
+}
+
+static void FillFrame(uint8_t *aData, uint16_t aLength, int aMode)
+{
+    for (uint16_t i = 0; i < aLength; i++)
+    {
+        int r = rand();
+
+        // Plain, some special bytes, only special bytes
+        aData[i] = (aMode == 2 || (aMode == 1 && r % 4 == 0)) ? sSpecialBytes[(r >> 8) % sizeof(sSpecialBytes)]
+                                                               : static_cast<uint8_t>(r);
+    }
+}
+
+static uint16_t RandomLength(unsigned long aRound)
+{
+    return static_cast<uint16_t>(rand() % ((aRound % 8) ? 96 : 1400));
+}
+
+// MARK: Tests
+
+static void TestWholeEncode(unsigned long aRound)
+{
+    static Hdlc::FrameBuffer<kBufferSize> buffer;
+    uint8_t                               data[1400];
+    uint16_t                              length   = RandomLength(aRound);
+    int                                   mode     = rand() % 3;
+    uint16_t                              capacity = static_cast<uint16_t>(rand() % (2 * length + 8));
+    Hdlc::Encoder                         encoder(buffer);
+    std::vector<uint8_t>                  expected;
+    otError                               error;
+
+    FillFrame(data, length, mode);
+    PrepareBuffer(buffer, capacity);
+
+    // Each call writes all of its bytes or none
+    std::vector<uint8_t> encoded = RefEncode(data, length);
+    if ((encoder.BeginFrame() == OT_ERROR_NONE) != (capacity >= 1))
+    {
+        TestFail("begin frame", aRound);
+    }
+    expected.assign(capacity >= 1 ? 1 : 0, kFlag);
+
+    error = encoder.Encode(data, length);
+    if ((error == OT_ERROR_NONE) != (expected.size() + encoded.size() <= capacity))
+    {
+        TestFail("encode result", aRound);
+    }
+    if (error == OT_ERROR_NONE)
+    {
+        expected.insert(expected.end(), encoded.begin(), encoded.end());
+    }
+
+    std::vector<uint8_t> frame = RefEncodeFrame(data, error == OT_ERROR_NONE ? length : 0);
+    std::vector<uint8_t> end(frame.end() - (frame.size() - 1 - (error == OT_ERROR_NONE ? encoded.size() : 0)),
+                             frame.end());
+    error = encoder.EndFrame();
+    if ((error == OT_ERROR_NONE) != (expected.size() + end.size() <= capacity))
+    {
+        TestFail("end frame result", aRound);
+    }
+    if (error == OT_ERROR_NONE)
+    {
+        expected.insert(expected.end(), end.begin(), end.end());
+    }
+
+    if (Written(buffer, capacity) != expected)
+    {
+        TestFail("encoded frame", aRound);
+    }
+}
+
+static void TestPartialEncode(unsigned long aRound)
+{
+    static Hdlc::FrameBuffer<kBufferSize> buffer;
+    uint8_t                               data[1400];
+    uint16_t                              length = RandomLength(aRound);
+    Hdlc::Encoder                         encoder(buffer);
+    std::vector<uint8_t>                  out;
+    uint16_t                              offset = 0;
+
+    FillFrame(data, length, rand() % 3);
+
+    PrepareBuffer(buffer, 1);
+    encoder.BeginFrame();
+    out = Written(buffer, 1);
+
+    // Drain a small UART buffer after each call, as NcpUart does
+    while (offset < length)
+    {
+        uint16_t             capacity = static_cast<uint16_t>(rand() % 40);
+        uint16_t             encodedLength;
+        otError              error;
+        std::vector<uint8_t> chunk;
+
+        PrepareBuffer(buffer, capacity);
+        error = encoder.Encode(data + offset, length - offset, encodedLength);
+        chunk = Written(buffer, capacity);
+
+        // Keeps whatever fits
+        std::vector<uint8_t> fits = RefEncode(data + offset, encodedLength);
+        if (chunk != fits || (encodedLength < length - offset &&
+                              chunk.size() + (RefNeedsEscape(data[offset + encodedLength]) ? 2 : 1) <= capacity))
+        {
+            TestFail("partial encode", aRound);
+        }
+        if ((error == OT_ERROR_NONE) != (encodedLength == length - offset))
+        {
+            TestFail("partial encode result", aRound);
+        }
+
+        out.insert(out.end(), chunk.begin(), chunk.end());
+        offset += encodedLength;
+    }
+
+    PrepareBuffer(buffer, 8);
+    if (encoder.EndFrame() != OT_ERROR_NONE)
+    {
+        TestFail("end frame", aRound);
+    }
+    std::vector<uint8_t> end = Written(buffer, 8);
+    out.insert(out.end(), end.begin(), end.end());
+
+    if (out != RefEncodeFrame(data, length))
+    {
+        TestFail("frame encoded in pieces", aRound);
+    }
+}
+
+static void TestDecode(unsigned long aRound)
+{
+    static Hdlc::FrameBuffer<kBufferSize> buffer;
+    std::vector<uint8_t>                  stream;
+    uint16_t       capacity = static_cast<uint16_t>((aRound % 3) ? kBufferSize : rand() % 300);
+    DecoderContext context  = {&buffer, capacity, std::vector<DecodedFrame>()};
+    Hdlc::Decoder  decoder(buffer, HandleFrame, &context);
+    int            frames = 1 + rand() % 12;
+
+    for (int i = 0; i < frames; i++)
+    {
+        uint8_t              data[1400];
+        uint16_t             length = RandomLength(aRound);
+        std::vector<uint8_t> frame;
+
+        FillFrame(data, length, rand() % 3);
+        frame = RefEncodeFrame(data, length);
+
+        if (rand() % 6 == 0)
+        {
+            // Corrupt a byte between the flags
+            frame[1 + rand() % (frame.size() - 2)] ^= static_cast<uint8_t>(1 << (rand() % 8));
+        }
+        if (rand() % 8 == 0)
+        {
+            frame.resize(rand() % frame.size());
+        }
+        stream.insert(stream.end(), frame.begin(), frame.end());
+
+        if (rand() % 10 == 0)
+        {
+            uint8_t junk[20];
+            int     junkLength = rand() % 20;
+
+            FillFrame(junk, static_cast<uint16_t>(junkLength), 1);
+            stream.insert(stream.end(), junk, junk + junkLength);
+        }
+    }
+
+    PrepareBuffer(buffer, capacity);
+    for (size_t offset = 0; offset < stream.size();)
+    {
+        size_t chunk = 1 + rand() % ((aRound % 2) ? 8 : 300);
+
+        chunk = (chunk < stream.size() - offset) ? chunk : stream.size() - offset;
+        decoder.Decode(&stream[offset], static_cast<uint16_t>(chunk));
+        offset += chunk;
+    }
+
+    if (context.mFrames != RefDecode(stream, capacity))
+    {
+        TestFail("decoded frames", aRound);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned      seed   = (argc > 1) ? static_cast<unsigned>(atoi(argv[1])) : 1;
+    unsigned long rounds = (argc > 2) ? static_cast<unsigned long>(atol(argv[2])) : 20000;
+
+    srand(seed);
+
+    for (unsigned long round = 0; round < rounds; round++)
+    {
+        TestWholeEncode(round);
+        TestPartialEncode(round);
+        TestDecode(round);
+    }
+
+    printf("OK: seed %u, %lu rounds\n", seed, rounds);
+    return 0;
+}
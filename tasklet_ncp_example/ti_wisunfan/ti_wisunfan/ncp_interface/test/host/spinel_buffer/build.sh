@@ -0,0 +1,38 @@
+#!/bin/sh
+#
+# Builds and runs the host test of Spinel::Buffer, with the default external
+# data queue, with a queue of one block, and with four weighted priority
+# levels in two regions of unequal shares.
+#
+#   build.sh
+#
+# Set CXX and OUT to change the compiler and the build directory.
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+NCP=$(cd "$HERE/../../.." && pwd)
+OUT=${OUT:-${TMPDIR:-/tmp}/spinel_buffer_test}
+CXX=${CXX:-c++}
+
+INC="-I$HERE -I$NCP/src -I$NCP/src/core -I$NCP/src/lib/spinel -I$NCP/include -I$NCP/config"
+DEF="-DOPENTHREAD_CONFIG_ASSERT_ENABLE=1 -DOPENTHREAD_TARGET_LINUX"
+SRC="$HERE/spinel_buffer_test.cpp $HERE/host_stubs.cpp $NCP/src/lib/spinel/spinel_buffer.cpp"
+
+mkdir -p "$OUT"
+
+$CXX -std=c++11 -O1 -g -fsanitize=address,undefined $DEF $INC -o "$OUT/spinel_buffer_test" $SRC
+for seed in 1 2 3; do
+    "$OUT/spinel_buffer_test" $seed
+done
+
+$CXX -std=c++11 -O1 -g -fsanitize=address,undefined $DEF -DOPENTHREAD_SPINEL_CONFIG_EXTERNAL_DATA_QUEUE_SIZE=1 $INC \
+    -o "$OUT/spinel_buffer_test_queue_1" $SRC
+"$OUT/spinel_buffer_test_queue_1"
+
+$CXX -std=c++11 -O1 -g -fsanitize=address,undefined $DEF -DOPENTHREAD_SPINEL_CONFIG_BUFFER_NUM_PRIORITIES=4 \
+    '-DOPENTHREAD_SPINEL_CONFIG_BUFFER_PRIORITY_WEIGHTS={1, 2, 4, 8}' \
+    '-DOPENTHREAD_SPINEL_CONFIG_BUFFER_REGION_SHARES={1, 2}' $INC -o "$OUT/spinel_buffer_test_priorities_4" $SRC
+for seed in 1 2 3; do
+    "$OUT/spinel_buffer_test_priorities_4" $seed
+done
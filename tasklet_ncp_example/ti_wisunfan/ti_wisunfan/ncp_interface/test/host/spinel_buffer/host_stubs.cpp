@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <string.h>
+#include <vector>
+
+#include "host_stubs.hpp"
+
+struct TestMessage
+{
+    otMessage            mBase;
+    TestMessage *        mQueueNext;
+    unsigned             mFreeCount;
+    std::vector<uint8_t> mData;
+};
+
+static TestMessage *AsTestMessage(const otMessage *aMessage)
+{
+    return reinterpret_cast<TestMessage *>(const_cast<otMessage *>(aMessage));
+}
+
+otMessage *TestMessageNew(const uint8_t *aData, uint16_t aLength)
+{
+    TestMessage *message = new TestMessage();
+
+    message->mData.assign(aData, aData + aLength);
+    return &message->mBase;
+}
+
+unsigned TestMessageFreeCount(const otMessage *aMessage)
+{
+    return AsTestMessage(aMessage)->mFreeCount;
+}
+
+void TestMessageDelete(otMessage *aMessage)
+{
+    delete AsTestMessage(aMessage);
+}
+
+extern "C" {
+
+void otMessageFree(otMessage *aMessage)
+{
+    TestMessage *message = AsTestMessage(aMessage);
+
+    // Reading a freed message gives garbage
+    std::fill(message->mData.begin(), message->mData.end(), 0xdd);
+    message->mFreeCount++;
+}
+
+uint16_t otMessageGetLength(const otMessage *aMessage)
+{
+    return static_cast<uint16_t>(AsTestMessage(aMessage)->mData.size());
+}
+
+uint16_t otMessageRead(const otMessage *aMessage, uint16_t aOffset, void *aBuf, uint16_t aLength)
+{
+    const std::vector<uint8_t> &data = AsTestMessage(aMessage)->mData;
+
+    if (aOffset >= data.size())
+    {
+        return 0;
+    }
+    if (aLength > data.size() - aOffset)
+    {
+        aLength = static_cast<uint16_t>(data.size() - aOffset);
+    }
+    memcpy(aBuf, &data[aOffset], aLength);
+    return aLength;
+}
+
+void otMessageQueueInit(otMessageQueue *aQueue)
+{
+    aQueue->mData = NULL;
+}
+
+otError otMessageQueueEnqueue(otMessageQueue *aQueue, otMessage *aMessage)
+{
+    TestMessage **tail = reinterpret_cast<TestMessage **>(&aQueue->mData);
+
+    while (*tail != NULL)
+    {
+        tail = &(*tail)->mQueueNext;
+    }
+    *tail                = AsTestMessage(aMessage);
+    (*tail)->mQueueNext = NULL;
+    return OT_ERROR_NONE;
+}
+
+otError otMessageQueueDequeue(otMessageQueue *aQueue, otMessage *aMessage)
+{
+    TestMessage **entry = reinterpret_cast<TestMessage **>(&aQueue->mData);
+
+    while (*entry != NULL && *entry != AsTestMessage(aMessage))
+    {
+        entry = &(*entry)->mQueueNext;
+    }
+    if (*entry == NULL)
+    {
+        return OT_ERROR_NOT_FOUND;
+    }
+    *entry = (*entry)->mQueueNext;
+    return OT_ERROR_NONE;
+}
+
+otMessage *otMessageQueueGetHead(otMessageQueue *aQueue)
+{
+    return static_cast<otMessage *>(aQueue->mData);
+}
+
+otMessage *otMessageQueueGetNext(otMessageQueue *aQueue, const otMessage *aMessage)
+{
+    (void)aQueue;
+    TestMessage *next = AsTestMessage(aMessage)->mQueueNext;
+
+    return next ? &next->mBase : NULL;
+}
+
+} // extern "C"
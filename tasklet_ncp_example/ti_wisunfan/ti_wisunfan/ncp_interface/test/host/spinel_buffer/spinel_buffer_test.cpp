@@ -0,0 +1,511 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   Host test of Spinel::Buffer.
+ *
+ *   Random frames of data, messages and external data blocks are written at
+ *   random priority levels, and read back with a mix of OutFrameReadByte()
+ *   and OutFrameRead(), sometimes partly and then again from the start. Each
+ *   frame read must be the oldest one of its priority level and come back
+ *   byte for byte with the right length. The buffer must free the messages
+ *   and external blocks of a frame exactly once when the frame is removed or
+ *   the buffer cleared, and never those of a frame that was discarded. The
+ *   two levels sharing a region of the buffer must report the same free
+ *   space.
+ *
+ *   With every level backlogged, each level must get a share of the bytes
+ *   read in proportion to its weight.
+ *
+ *   spinel_buffer_test [seed] [rounds]
+ *
+ *   Build and run with build.sh.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <deque>
+#include <vector>
+
+#include "host_stubs.hpp"
+#include "spinel_buffer.hpp"
+
+using namespace ot;
+
+enum
+{
+    kOperations        = 2000,
+    kMaxPriorities     = 8,
+    kMaxBacklogFrame   = 64,
+    kBacklogBufferSize = 60000,
+};
+
+static const uint8_t sWeights[] = OPENTHREAD_SPINEL_CONFIG_BUFFER_PRIORITY_WEIGHTS;
+
+struct ExternalBlock
+{
+    std::vector<uint8_t> mData;
+    unsigned             mFreeCount;
+};
+
+struct Frame
+{
+    Spinel::Buffer::FrameTag     mTag;
+    std::vector<uint8_t>         mBytes;
+    std::vector<ExternalBlock *> mBlocks;
+    std::vector<otMessage *>     mMessages;
+};
+
+static std::deque<Frame> sQueued[kMaxPriorities];
+static unsigned long     sFramesRead;
+static unsigned long     sFramesDiscarded;
+
+static void TestFail(const char *aWhat, unsigned long aRound)
+{
+    printf("FAIL: %s in round %lu\n", aWhat, aRound);
+    exit(1);
+}
+
+static void HandleExternalDataFree(void *aContext)
+{
+    ExternalBlock *block = static_cast<ExternalBlock *>(aContext);
+
+    // Reading a freed block gives garbage
+    memset(&block->mData[0], 0xdd, block->mData.size());
+    block->mFreeCount++;
+}
+
+static void RandomBytes(std::vector<uint8_t> &aBytes, size_t aLength)
+{
+    aBytes.resize(aLength);
+    for (size_t i = 0; i < aLength; i++)
+    {
+        aBytes[i] = static_cast<uint8_t>(rand());
+    }
+}
+
+// Releases the blocks and messages of a frame, which the buffer must have freed aFreeCount times
+static void ReleaseFrame(Frame &aFrame, unsigned aFreeCount, unsigned long aRound)
+{
+    for (ExternalBlock *block : aFrame.mBlocks)
+    {
+        if (block->mFreeCount != aFreeCount)
+        {
+            TestFail("external block free count", aRound);
+        }
+        delete block;
+    }
+    for (otMessage *message : aFrame.mMessages)
+    {
+        if (TestMessageFreeCount(message) != aFreeCount)
+        {
+            TestFail("message free count", aRound);
+        }
+        TestMessageDelete(message);
+    }
+    aFrame.mBlocks.clear();
+    aFrame.mMessages.clear();
+}
+
+// Writes a random frame, returns false if the buffer discarded it
+static bool WriteFrame(Spinel::Buffer &aBuffer, uint8_t aPriority, Frame &aFrame, bool &aOpen)
+{
+    int segments = 1 + rand() % 4;
+
+    aBuffer.InFrameBegin(static_cast<Spinel::Buffer::Priority>(aPriority));
+    aOpen = true;
+
+    for (int i = 0; i < segments; i++)
+    {
+        std::vector<uint8_t> data;
+        otError              error;
+
+        RandomBytes(data, static_cast<size_t>(rand() % ((rand() % 8) ? 60 : 300)));
+
+        switch (rand() % 4)
+        {
+        case 0:
+        {
+            otMessage *message = TestMessageNew(data.data(), static_cast<uint16_t>(data.size()));
+
+            aFrame.mMessages.push_back(message);
+            error = aBuffer.InFrameFeedMessage(message);
+            break;
+        }
+
+        case 1:
+        {
+            ExternalBlock *block = new ExternalBlock();
+
+            block->mData = data;
+            block->mFreeCount = 0;
+            if (data.empty())
+            {
+                // The block must be non-NULL
+                block->mData.push_back(0);
+                data.push_back(0);
+            }
+            aFrame.mBlocks.push_back(block);
+            error = aBuffer.InFrameFeedExternalData(&block->mData[0], static_cast<uint16_t>(block->mData.size()),
+                                                    HandleExternalDataFree, block);
+            break;
+        }
+
+        default:
+            error = aBuffer.InFrameFeedData(data.data(), static_cast<uint16_t>(data.size()));
+            break;
+        }
+
+        if (error != OT_ERROR_NONE)
+        {
+            aOpen = false;
+            return false;
+        }
+        aFrame.mBytes.insert(aFrame.mBytes.end(), data.begin(), data.end());
+    }
+
+    // Spinel frames have at least a header byte, the buffer reads nothing from an empty one
+    if (aFrame.mBytes.empty())
+    {
+        uint8_t header = 0x80;
+
+        if (aBuffer.InFrameFeedData(&header, sizeof(header)) != OT_ERROR_NONE)
+        {
+            aOpen = false;
+            return false;
+        }
+        aFrame.mBytes.push_back(header);
+    }
+
+    return true;
+}
+
+static void ReadFrame(Spinel::Buffer &aBuffer, unsigned long aRound)
+{
+    size_t total = 0;
+
+    for (int priority = 0; priority < Spinel::Buffer::GetNumPriorities(); priority++)
+    {
+        total += sQueued[priority].size();
+    }
+
+    if (aBuffer.OutFrameBegin() != OT_ERROR_NONE)
+    {
+        if (total != 0 || !aBuffer.IsEmpty())
+        {
+            TestFail("no frame to read", aRound);
+        }
+        return;
+    }
+
+    Spinel::Buffer::FrameTag tag      = aBuffer.OutFrameGetTag();
+    int                      priority = 0;
+
+    while (priority < Spinel::Buffer::GetNumPriorities() &&
+           (sQueued[priority].empty() || sQueued[priority].front().mTag != tag))
+    {
+        priority++;
+    }
+    if (priority == Spinel::Buffer::GetNumPriorities())
+    {
+        TestFail("frame read out of order", aRound);
+    }
+
+    Frame &              frame = sQueued[priority].front();
+    std::vector<uint8_t> bytes;
+
+    if (aBuffer.OutFrameGetLength() != frame.mBytes.size())
+    {
+        TestFail("frame length", aRound);
+    }
+
+    // Sometimes read part of the frame, then begin it again
+    for (int pass = (rand() % 8 == 0) ? 0 : 1; pass < 2; pass++)
+    {
+        size_t limit = pass ? frame.mBytes.size() : static_cast<size_t>(rand()) % (frame.mBytes.size() + 1);
+
+        bytes.clear();
+        while (!aBuffer.OutFrameHasEnded() && bytes.size() < limit)
+        {
+            if (rand() % 2)
+            {
+                bytes.push_back(aBuffer.OutFrameReadByte());
+            }
+            else
+            {
+                uint8_t  chunk[80];
+                uint16_t length = aBuffer.OutFrameRead(static_cast<uint16_t>(1 + rand() % sizeof(chunk)), chunk);
+
+                bytes.insert(bytes.end(), chunk, chunk + length);
+            }
+        }
+        if (pass == 0)
+        {
+            aBuffer.OutFrameBegin();
+            if (aBuffer.OutFrameGetTag() != tag)
+            {
+                TestFail("frame changed on begin", aRound);
+            }
+        }
+    }
+
+    uint8_t byte;
+    if (bytes != frame.mBytes || !aBuffer.OutFrameHasEnded() || aBuffer.OutFrameRead(1, &byte) != 0)
+    {
+        TestFail("frame content", aRound);
+    }
+    sFramesRead++;
+
+    // Sometimes leave the frame to be read again
+    if (rand() % 5 == 0)
+    {
+        return;
+    }
+
+    for (ExternalBlock *block : frame.mBlocks)
+    {
+        if (block->mFreeCount != 0)
+        {
+            TestFail("external block freed before the frame was removed", aRound);
+        }
+    }
+    aBuffer.OutFrameRemove();
+    ReleaseFrame(frame, 1, aRound);
+    sQueued[priority].pop_front();
+}
+
+static void TestRound(unsigned long aRound)
+{
+    static const uint16_t sSizes[] = {256, 1000, 4096};
+    static uint8_t        storage[4096];
+    uint16_t              size = sSizes[rand() % 3];
+    Spinel::Buffer        buffer(storage, size);
+    Frame                 discarded;
+    bool                  open = false;
+
+    for (int op = 0; op < kOperations; op++)
+    {
+        int choice = rand() % 16;
+
+        // A new frame discards an unfinished one, whose blocks and messages stay with the writer
+        if (open || choice < 8)
+        {
+            uint8_t priority = static_cast<uint8_t>(rand() % Spinel::Buffer::GetNumPriorities());
+            Frame   frame;
+
+            open = false;
+            if (WriteFrame(buffer, priority, frame, open))
+            {
+                if (rand() % 10 == 0 || buffer.InFrameEnd() != OT_ERROR_NONE)
+                {
+                    // Left unfinished or no room to end it
+                    ReleaseFrame(discarded, 0, aRound);
+                    discarded = frame;
+                    sFramesDiscarded++;
+                    continue;
+                }
+                open      = false;
+                frame.mTag = buffer.InFrameGetLastTag();
+                sQueued[priority].push_back(frame);
+            }
+            else
+            {
+                ReleaseFrame(frame, 0, aRound);
+                sFramesDiscarded++;
+            }
+            ReleaseFrame(discarded, 0, aRound);
+        }
+        else if (choice < 15)
+        {
+            ReadFrame(buffer, aRound);
+        }
+        else if (rand() % 16 == 0)
+        {
+            buffer.Clear();
+            for (int priority = 0; priority < Spinel::Buffer::GetNumPriorities(); priority++)
+            {
+                for (Frame &frame : sQueued[priority])
+                {
+                    ReleaseFrame(frame, 1, aRound);
+                }
+                sQueued[priority].clear();
+            }
+        }
+
+        for (uint8_t priority = 0; priority < Spinel::Buffer::GetNumPriorities(); priority++)
+        {
+            Spinel::Buffer::Priority level = static_cast<Spinel::Buffer::Priority>(priority);
+            Spinel::Buffer::Priority other = static_cast<Spinel::Buffer::Priority>(priority ^ 1);
+
+            if (buffer.GetFreeSpace(level) != buffer.GetFreeSpace(other) || buffer.GetFreeSpace(level) > size)
+            {
+                TestFail("free space", aRound);
+            }
+        }
+        if (buffer.GetFreeSpace(static_cast<Spinel::Buffer::Priority>(Spinel::Buffer::GetNumPriorities())) != 0)
+        {
+            TestFail("free space of an invalid level", aRound);
+        }
+    }
+
+    // Drain what is left
+    while (!buffer.IsEmpty())
+    {
+        if (buffer.OutFrameBegin() != OT_ERROR_NONE)
+        {
+            TestFail("begin on a non-empty buffer", aRound);
+        }
+        ReadFrame(buffer, aRound);
+    }
+    ReleaseFrame(discarded, 0, aRound);
+    for (int priority = 0; priority < Spinel::Buffer::GetNumPriorities(); priority++)
+    {
+        if (!sQueued[priority].empty())
+        {
+            TestFail("frames left over", aRound);
+        }
+    }
+}
+
+// Writes one frame of the given length to the level
+static void WriteBacklogFrame(Spinel::Buffer &                      aBuffer,
+                              uint8_t                               aPriority,
+                              uint16_t                              aLength,
+                              std::deque<Spinel::Buffer::FrameTag> &aTags)
+{
+    static const uint8_t frame[kMaxBacklogFrame] = {0x42};
+
+    aBuffer.InFrameBegin(static_cast<Spinel::Buffer::Priority>(aPriority));
+    aBuffer.InFrameFeedData(frame, aLength);
+    if (aBuffer.InFrameEnd() != OT_ERROR_NONE)
+    {
+        TestFail("backlog frame", aPriority);
+    }
+    aTags.push_back(aBuffer.InFrameGetLastTag());
+}
+
+// Fills every level and counts the bytes read from each until one of them runs out of frames. Space freed by reading
+// only comes back once a level is empty, so the levels are backlogged by filling a large buffer up front.
+static void TestWeights(void)
+{
+    static uint8_t                       storage[kBacklogBufferSize];
+    Spinel::Buffer                       buffer(storage, sizeof(storage));
+    std::deque<Spinel::Buffer::FrameTag> tags[kMaxPriorities];
+    unsigned long                        bytes[kMaxPriorities] = {0};
+    unsigned long                        total                 = 0;
+    unsigned                             weights               = 0;
+
+    // The two levels of a pair share a region, so fill them a frame at a time
+    for (bool written = true; written;)
+    {
+        written = false;
+        for (uint8_t priority = 0; priority < Spinel::Buffer::GetNumPriorities(); priority++)
+        {
+            if (buffer.GetFreeSpace(static_cast<Spinel::Buffer::Priority>(priority)) > 2 * kMaxBacklogFrame)
+            {
+                WriteBacklogFrame(buffer, priority, static_cast<uint16_t>(16 + rand() % (kMaxBacklogFrame - 16)),
+                                  tags[priority]);
+                written = true;
+            }
+        }
+    }
+
+    for (bool backlogged = true; backlogged;)
+    {
+        uint8_t  priority = 0;
+        uint16_t length;
+
+        if (buffer.OutFrameBegin() != OT_ERROR_NONE)
+        {
+            TestFail("no backlog frame to read", total);
+        }
+
+        while (priority < Spinel::Buffer::GetNumPriorities() &&
+               (tags[priority].empty() || tags[priority].front() != buffer.OutFrameGetTag()))
+        {
+            priority++;
+        }
+        if (priority == Spinel::Buffer::GetNumPriorities())
+        {
+            TestFail("backlog frame read out of order", total);
+        }
+
+        length = buffer.OutFrameGetLength();
+        bytes[priority] += length;
+        total += length;
+        tags[priority].pop_front();
+        buffer.OutFrameRemove();
+        backlogged = !tags[priority].empty();
+    }
+
+    for (uint8_t priority = 0; priority < Spinel::Buffer::GetNumPriorities(); priority++)
+    {
+        weights += sWeights[priority];
+    }
+
+    for (uint8_t priority = 0; priority < Spinel::Buffer::GetNumPriorities(); priority++)
+    {
+        double share    = static_cast<double>(bytes[priority]) / total;
+        double expected = static_cast<double>(sWeights[priority]) / weights;
+
+        printf("level %u: weight %u, %.3f of the bytes read\n", priority, sWeights[priority], share);
+        if (share < expected * 0.95 || share > expected * 1.05)
+        {
+            TestFail("weighted share", priority);
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned      seed   = (argc > 1) ? static_cast<unsigned>(atoi(argv[1])) : 1;
+    unsigned long rounds = (argc > 2) ? static_cast<unsigned long>(atol(argv[2])) : 200;
+
+    if (Spinel::Buffer::GetNumPriorities() > kMaxPriorities)
+    {
+        printf("FAIL: more than %d priority levels\n", kMaxPriorities);
+        return 1;
+    }
+
+    srand(seed);
+    for (unsigned long round = 0; round < rounds; round++)
+    {
+        TestRound(round);
+    }
+    TestWeights();
+
+    printf("OK: seed %u, %d priority levels, %lu frames read, %lu discarded\n", seed,
+           Spinel::Buffer::GetNumPriorities(), sFramesRead, sFramesDiscarded);
+    return 0;
+}
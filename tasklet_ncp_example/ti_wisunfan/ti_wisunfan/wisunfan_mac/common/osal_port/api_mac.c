@@ -165,6 +165,28 @@ extern struct osal_debug osalDbg;
 #define MAC_UNDEFINED_TASKID    0xFF
 
 #define IE_HDR_LEN          2
+
+/*!
+ Compile-time trace level of the per-frame MCPS data request, confirm and
+ indication prints. Their arguments (e.g. trace_array()) are formatted for
+ every frame even when the runtime trace level drops the print, so they are
+ left out of the data path unless this is raised.
+ */
+#ifndef TIMAC_DATA_TRACE_LEVEL
+#define TIMAC_DATA_TRACE_LEVEL  TRACE_LEVEL_WARN
+#endif
+
+#if TIMAC_DATA_TRACE_LEVEL >= TRACE_LEVEL_DEBUG
+#define tr_data_debug(...)      tr_debug(__VA_ARGS__)
+#else
+#define tr_data_debug(...)
+#endif
+
+#if TIMAC_DATA_TRACE_LEVEL >= TRACE_LEVEL_INFO
+#define tr_data_info(...)       tr_info(__VA_ARGS__)
+#else
+#define tr_data_info(...)
+#endif
 /******************************************************************************
  Structures
  *****************************************************************************/
@@ -205,6 +227,7 @@ extern sem_t event_thread_sem_handle;
 
 extern configurable_props_t cfg_props;
 extern int8_t eventOS_event_timer_request(uint8_t event_id, uint8_t event_type, int8_t tasklet_id, uint32_t time);
+extern uint32_t ns_sw_mac_read_current_timestamp(struct mac_api_s *mac_api);
 
 /******************************************************************************
  Local variables
@@ -1092,6 +1115,8 @@ void timacConvertDataInd(mcps_data_ind_t *mdataInd, macMcpsDataInd_t *tdataInd)
 
     mdataInd->mpduLinkQuality = tdataInd->mac.mpduLinkQuality;
     mdataInd->signal_dbm = tdataInd->mac.rssi;
+    /* the MAC does not report the receive channel, and the radio may have hopped by now */
+    mdataInd->channel = MCPS_CHANNEL_UNKNOWN;
     mdataInd->timestamp = tdataInd->mac.timestamp;
     /* currently seq no of 0 is used to represent seqNoSuppression */
     mdataInd->DSN_suppressed = (tdataInd->mac.dsn == 0 ? true : false);
@@ -1734,6 +1759,9 @@ uint8_t mcps_req_ext(const mac_api_t *api, void *data, ns_ie_iovec_t *iovec, wh_
     else
     {
         mcps_data_req_t *data_req = (mcps_data_req_t *)data;
+#ifdef WISUN_TEST_METRICS
+        uint32_t reqStartTime = ns_sw_mac_read_current_timestamp(NULL);
+#endif
 #ifdef DBG_APP
         mcpsDbg.data[0]++;
 #endif
@@ -1746,15 +1774,18 @@ uint8_t mcps_req_ext(const mac_api_t *api, void *data, ns_ie_iovec_t *iovec, wh_
         tx_packet_num++;
         status = MAC_McpsDataReq(&timacDataReq);
 
+#ifdef WISUN_TEST_METRICS
+        MacPerfData.num_tx_data_req++;
+        MacPerfData.tx_data_req_time += ns_sw_mac_read_current_timestamp(NULL) - reqStartTime;
+#endif
+
         if(timacDataReq.txOptions.ack)
         {
-            uint8_t macAddr[8];
-            memcpy(macAddr,timacDataReq.dstAddr.addr.extAddr,8);
-            tr_debug("\n MAC MCPs Data Req : unicast to Dst %s TxPkt(0x%x), st(%d)",trace_array(macAddr, 8),tx_packet_num,status);
+            tr_data_debug("\n MAC MCPs Data Req : unicast to Dst %s TxPkt(0x%x), st(%d)",trace_array(timacDataReq.dstAddr.addr.extAddr, 8),tx_packet_num,status);
         }
         else
         {
-            tr_debug("\n MAC MCPs Data Req : broadcast TxPkt(0x%x), st(%d)",tx_packet_num,status);
+            tr_data_debug("\n MAC MCPs Data Req : broadcast TxPkt(0x%x), st(%d)",tx_packet_num,status);
             /*
              * toggle the GPIO to high
              */
@@ -2045,7 +2076,7 @@ static uint16_t processIncomingICallMsg(macCbackEvent_t *pMsg)
 #endif
                 if (pMsg->ackCnf.ackOption == 0)
                 {
-                    tr_info("\n MAC MCPs Data Cnf status broadcast %u TxPkt(0x%x): ",pMsg->hdr.status,tx_packet_num);
+                    tr_data_info("\n MAC MCPs Data Cnf status broadcast %u TxPkt(0x%x): ",pMsg->hdr.status,tx_packet_num);
                     /*
                      * set GPIO to zero
                      */
@@ -2053,7 +2084,7 @@ static uint16_t processIncomingICallMsg(macCbackEvent_t *pMsg)
                 }
                 else
                 {
-                    tr_info("\n MAC MCPs Data Cnf status Unicast %u TxPkt(0x%x): ",pMsg->hdr.status,tx_packet_num);
+                    tr_data_info("\n MAC MCPs Data Cnf status Unicast %u TxPkt(0x%x): ",pMsg->hdr.status,tx_packet_num);
                 }
                 memset(&data_conf, 0, sizeof(mcps_data_conf_t));
                 memset(&data_conf_ie, 0, sizeof(mcps_data_conf_payload_t));
@@ -2115,7 +2146,7 @@ static uint16_t processIncomingICallMsg(macCbackEvent_t *pMsg)
                     data_ind.DstPANId = data_ind.SrcPANId;
                 }
 
-                tr_info("\n MAC MCPs Data Ind Src %s srcPanID %u:", trace_array(data_ind.SrcAddr, 8), data_ind.SrcPANId);
+                tr_data_info("\n MAC MCPs Data Ind Src %s srcPanID %u:", trace_array(data_ind.SrcAddr, 8), data_ind.SrcPANId);
 
                 vpIEStatus = timacDataInd_CheckVPIE(&data_ind,&pMsg->dataInd,&vpIEType,&vpIELen);
                 /* check if the srcPanID match the MACPib pan ID */
@@ -2551,6 +2551,10 @@ typedef struct __MAC_performance
     uint32_t  num_asynchReq[4];
     uint32_t  num_tx_broadcast;
     uint32_t  num_tx_unicast;
+    // Data requests handed to MAC_McpsDataReq() and the total time spent
+    // building and handing them over, in microseconds
+    uint32_t  num_tx_data_req;
+    uint32_t  tx_data_req_time;
 
     // TX data confirm
     uint32_t    num_tx_conf_ok;
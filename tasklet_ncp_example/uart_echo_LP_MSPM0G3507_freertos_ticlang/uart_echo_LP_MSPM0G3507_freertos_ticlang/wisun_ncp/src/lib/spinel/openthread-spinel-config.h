@@ -44,4 +44,64 @@
 #define OPENTHREAD_SPINEL_CONFIG_OPENTHREAD_MESSAGE_ENABLE 1
 #endif
 
+/**
+ * @def OPENTHREAD_SPINEL_CONFIG_EXTERNAL_DATA_QUEUE_SIZE
+ *
+ * The number of externally owned data blocks (added by reference using `InFrameFeedExternalData()`) that can be
+ * queued per frame priority in a `Spinel::Buffer`. Define as 0 to disable the feature.
+ *
+ */
+#ifndef OPENTHREAD_SPINEL_CONFIG_EXTERNAL_DATA_QUEUE_SIZE
+#define OPENTHREAD_SPINEL_CONFIG_EXTERNAL_DATA_QUEUE_SIZE 4
+#endif
+
+/**
+ * @def OPENTHREAD_SPINEL_CONFIG_BUFFER_NUM_PRIORITIES
+ *
+ * The number of frame priority levels in a `Spinel::Buffer`. Must be even, priority levels `2n` and `2n + 1` share
+ * one region of the buffer (see `OPENTHREAD_SPINEL_CONFIG_BUFFER_REGION_SHARES`).
+ *
+ */
+#ifndef OPENTHREAD_SPINEL_CONFIG_BUFFER_NUM_PRIORITIES
+#define OPENTHREAD_SPINEL_CONFIG_BUFFER_NUM_PRIORITIES 2
+#endif
+
+/**
+ * @def OPENTHREAD_SPINEL_CONFIG_BUFFER_PRIORITY_WEIGHTS
+ *
+ * The weight of each frame priority level (lowest first) when draining a `Spinel::Buffer`. Frames are read using
+ * deficit round robin, when all priority levels have frames queued each one gets a share of the output bytes in
+ * proportion to its weight.
+ *
+ */
+#ifndef OPENTHREAD_SPINEL_CONFIG_BUFFER_PRIORITY_WEIGHTS
+#define OPENTHREAD_SPINEL_CONFIG_BUFFER_PRIORITY_WEIGHTS \
+    {                                                    \
+        1, 4                                             \
+    }
+#endif
+
+/**
+ * @def OPENTHREAD_SPINEL_CONFIG_BUFFER_REGION_SHARES
+ *
+ * The relative size of each region of a `Spinel::Buffer`, one non-zero entry per pair of frame priority levels.
+ *
+ */
+#ifndef OPENTHREAD_SPINEL_CONFIG_BUFFER_REGION_SHARES
+#define OPENTHREAD_SPINEL_CONFIG_BUFFER_REGION_SHARES \
+    {                                                 \
+        1                                             \
+    }
+#endif
+
+/**
+ * @def OPENTHREAD_SPINEL_CONFIG_BUFFER_QUANTUM
+ *
+ * The number of bytes a frame priority level of weight 1 may read per deficit round robin round.
+ *
+ */
+#ifndef OPENTHREAD_SPINEL_CONFIG_BUFFER_QUANTUM
+#define OPENTHREAD_SPINEL_CONFIG_BUFFER_QUANTUM 64
+#endif
+
 #endif // OPENTHREAD_SPINEL_CONFIG_H_
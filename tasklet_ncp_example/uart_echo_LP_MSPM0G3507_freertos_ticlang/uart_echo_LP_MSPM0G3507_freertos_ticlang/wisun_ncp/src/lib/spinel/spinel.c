@@ -1223,6 +1223,14 @@ const char *spinel_prop_key_to_cstr(spinel_prop_key_t prop_key)
             ret = "HWADDR";
             break;
 
+        case SPINEL_PROP_HEAP_STATS:
+            ret = "HEAP_STATS";
+            break;
+
+        case SPINEL_PROP_HEAP_ALLOCATORS:
+            ret = "HEAP_ALLOCATORS";
+            break;
+
         case SPINEL_PROP_PHY_CCA_THRESHOLD:
             ret = "PHY_CCA_THRESHOLD";
             break;
@@ -1255,6 +1263,22 @@ const char *spinel_prop_key_to_cstr(spinel_prop_key_t prop_key)
             ret = "DODAG_ROUTE";
             break;
 
+        case SPINEL_PROP_ROUTING_TABLE_UPDATE_BATCH:
+            ret = "ROUTING_TABLE_UPDATE_BATCH";
+            break;
+
+        case SPINEL_PROP_ROUTING_TABLE_RESYNC:
+            ret = "ROUTING_TABLE_RESYNC";
+            break;
+
+        case SPINEL_PROP_CONNECTED_DEVICES_GENERATION:
+            ret = "CONNECTED_DEVICES_GENERATION";
+            break;
+
+        case SPINEL_PROP_ROUTING_TABLE_UPDATE_WINDOW:
+            ret = "ROUTING_TABLE_UPDATE_WINDOW";
+            break;
+
         case SPINEL_PROP_IPV6_ADDRESS_TABLE:
             ret = "IPV6_ADDRESS_TABLE";
             break;
@@ -1275,6 +1299,18 @@ const char *spinel_prop_key_to_cstr(spinel_prop_key_t prop_key)
             ret = "STREAM_NET";
             break;
 
+        case SPINEL_PROP_STREAM_NET_MULTI:
+            ret = "STREAM_NET_MULTI";
+            break;
+
+        case SPINEL_PROP_STREAM_FLOW_CONTROL:
+            ret = "STREAM_FLOW_CONTROL";
+            break;
+
+        case SPINEL_PROP_STREAM_LOG_BINARY:
+            ret = "STREAM_LOG_BINARY";
+            break;
+
         default:
             break;
     }
@@ -32,6 +32,8 @@
 
 #include "spinel_buffer.hpp"
 
+#include <string.h>
+
 #include "common/code_utils.hpp"
 #include "common/debug.hpp"
 
@@ -40,11 +42,35 @@ namespace Spinel {
 
 const Buffer::FrameTag Buffer::kInvalidTag = NULL;
 
+static const uint8_t kPriorityWeights[] = OPENTHREAD_SPINEL_CONFIG_BUFFER_PRIORITY_WEIGHTS;
+static const uint8_t kRegionShares[]    = OPENTHREAD_SPINEL_CONFIG_BUFFER_REGION_SHARES;
+
 Buffer::Buffer(uint8_t *aBuffer, uint16_t aBufferLength)
     : mBuffer(aBuffer)
     , mBufferEnd(aBuffer + aBufferLength)
     , mBufferLength(aBufferLength)
 {
+    uint16_t totalShares = 0;
+    uint16_t shares      = 0;
+
+    static_assert((kNumPrios >= 2) && (kNumPrios % 2 == 0), "Number of priority levels must be even");
+    static_assert(sizeof(kPriorityWeights) == kNumPrios, "Need a weight for each priority level");
+    static_assert(sizeof(kRegionShares) == kNumRegions, "Need a share for each pair of priority levels");
+
+    // Split the buffer into regions, one for each pair of priority levels.
+    for (uint8_t region = 0; region < kNumRegions; region++)
+    {
+        totalShares += kRegionShares[region];
+    }
+
+    for (uint8_t region = 0; region < kNumRegions; region++)
+    {
+        mRegionStart[region] = mBuffer + static_cast<uint32_t>(aBufferLength) * shares / totalShares;
+        shares += kRegionShares[region];
+    }
+
+    mRegionStart[kNumRegions] = mBufferEnd;
+
 #if OPENTHREAD_SPINEL_CONFIG_OPENTHREAD_MESSAGE_ENABLE
     for (uint8_t priority = 0; priority < kNumPrios; priority++)
     {
@@ -54,6 +80,14 @@ Buffer::Buffer(uint8_t *aBuffer, uint16_t aBufferLength)
     otMessageQueueInit(&mWriteFrameMessageQueue);
 #endif
 
+#if OPENTHREAD_SPINEL_CONFIG_EXTERNAL_DATA_QUEUE_SIZE
+    for (uint8_t priority = 0; priority < kNumPrios; priority++)
+    {
+        mExternalDataHead[priority]  = 0;
+        mExternalDataCount[priority] = 0;
+    }
+#endif
+
     SetFrameAddedCallback(NULL, NULL);
     SetFrameRemovedCallback(NULL, NULL);
     Clear();
@@ -66,23 +100,35 @@ void Buffer::Clear(void)
 #endif
 
     // Write (InFrame) related variables
-    mWriteFrameStart[kPriorityLow]  = mBuffer;
-    mWriteFrameStart[kPriorityHigh] = GetUpdatedBufPtr(mBuffer, 1, kBackward);
-    mWriteDirection                 = kUnknown;
-    mWriteSegmentHead               = mBuffer;
-    mWriteSegmentTail               = mBuffer;
-    mWriteFrameTag                  = kInvalidTag;
+    for (uint8_t priority = 0; priority < kNumPrios; priority++)
+    {
+        // Forward (even) priority levels start at the beginning of their region, backward (odd) ones right behind it.
+        mWriteFrameStart[priority] = IsBackward(priority) ? GetUpdatedBufPtr(GetRegionStart(priority), 1, priority)
+                                                          : GetRegionStart(priority);
+    }
+
+    mWritePriority    = kUnknownPriority;
+    mWriteSegmentHead = mBuffer;
+    mWriteSegmentTail = mBuffer;
+    mWriteFrameTag    = kInvalidTag;
 
     // Read (OutFrame) related variables
-    mReadDirection   = kForward;
+    mReadPriority    = kPriorityLow;
     mReadState       = kReadStateNotActive;
     mReadFrameLength = kUnknownFrameLength;
 
-    mReadFrameStart[kPriorityLow]  = mBuffer;
-    mReadFrameStart[kPriorityHigh] = GetUpdatedBufPtr(mBuffer, 1, kBackward);
-    mReadSegmentHead               = mBuffer;
-    mReadSegmentTail               = mBuffer;
-    mReadPointer                   = mBuffer;
+    for (uint8_t priority = 0; priority < kNumPrios; priority++)
+    {
+        mReadFrameStart[priority] = mWriteFrameStart[priority];
+        mDeficit[priority]        = 0;
+    }
+
+    mReadSegmentHead = mBuffer;
+    mReadSegmentTail = mBuffer;
+    mReadPointer     = mBuffer;
+
+    mScheduledPriority = kPriorityLow;
+    mScheduledCredited = false;
 
 #if OPENTHREAD_SPINEL_CONFIG_OPENTHREAD_MESSAGE_ENABLE
     mReadMessage       = NULL;
@@ -109,6 +155,23 @@ void Buffer::Clear(void)
         }
     }
 #endif
+
+#if OPENTHREAD_SPINEL_CONFIG_EXTERNAL_DATA_QUEUE_SIZE
+    mReadExternalDataIndex = 0;
+    mReadExternalDataTail  = NULL;
+
+    // External data blocks of the current (unfinished) input frame are not yet owned by the `Buffer`.
+    mWriteFrameExternalDataCount = 0;
+
+    // Release all external data blocks of finished frames.
+    for (uint8_t priority = 0; priority < kNumPrios; priority++)
+    {
+        while (mExternalDataCount[priority] > 0)
+        {
+            FreeExternalData(priority);
+        }
+    }
+#endif
 }
 
 void Buffer::SetFrameAddedCallback(BufferCallback aFrameAddedCallback, void *aFrameAddedContext)
@@ -123,99 +186,88 @@ void Buffer::SetFrameRemovedCallback(BufferCallback aFrameRemovedCallback, void
     mFrameRemovedContext  = aFrameRemovedContext;
 }
 
-// Returns an updated buffer pointer by moving forward/backward (based on `aDirection`) from `aBufPtr` by a given
-// offset. The resulting buffer pointer is ensured to stay within the `mBuffer` boundaries.
-uint8_t *Buffer::GetUpdatedBufPtr(uint8_t *aBufPtr, uint16_t aOffset, Direction aDirection) const
+// Returns an updated buffer pointer by moving forward/backward (based on `aPriority`) from `aBufPtr` by a given
+// offset. The resulting buffer pointer is ensured to stay within the boundaries of the region used by `aPriority`.
+uint8_t *Buffer::GetUpdatedBufPtr(uint8_t *aBufPtr, uint16_t aOffset, uint8_t aPriority) const
 {
-    uint8_t *ptr = aBufPtr;
+    uint8_t *ptr         = aBufPtr;
+    uint8_t *regionStart = GetRegionStart(aPriority);
+    uint8_t *regionEnd   = GetRegionEnd(aPriority);
 
-    switch (aDirection)
+    OT_ASSERT(aPriority < kNumPrios);
+
+    if (!IsBackward(aPriority))
     {
-    case kForward:
         ptr += aOffset;
 
-        while (ptr >= mBufferEnd)
+        while (ptr >= regionEnd)
         {
-            ptr -= mBufferLength;
+            ptr -= (regionEnd - regionStart);
         }
-
-        break;
-
-    case kBackward:
+    }
+    else
+    {
         ptr -= aOffset;
 
-        while (ptr < mBuffer)
+        while (ptr < regionStart)
         {
-            ptr += mBufferLength;
+            ptr += (regionEnd - regionStart);
         }
-
-        break;
-
-    case kUnknown:
-        OT_ASSERT(false);
-        OT_UNREACHABLE_CODE(break);
     }
 
     return ptr;
 }
 
-// Gets the distance between two buffer pointers (adjusts for the wrap-around) given a direction (forward or backward).
-uint16_t Buffer::GetDistance(const uint8_t *aStartPtr, const uint8_t *aEndPtr, Direction aDirection) const
+// Gets the distance between two buffer pointers (adjusts for the wrap-around within the region) given a priority level
+// (which determines the direction, forward or backward).
+uint16_t Buffer::GetDistance(const uint8_t *aStartPtr, const uint8_t *aEndPtr, uint8_t aPriority) const
 {
     size_t distance = 0;
 
-    switch (aDirection)
-    {
-    case kForward:
+    OT_ASSERT(aPriority < kNumPrios);
 
+    if (!IsBackward(aPriority))
+    {
         if (aEndPtr >= aStartPtr)
         {
             distance = static_cast<size_t>(aEndPtr - aStartPtr);
         }
         else
         {
-            distance = static_cast<size_t>(mBufferEnd - aStartPtr);
-            distance += static_cast<size_t>(aEndPtr - mBuffer);
+            distance = static_cast<size_t>(GetRegionEnd(aPriority) - aStartPtr);
+            distance += static_cast<size_t>(aEndPtr - GetRegionStart(aPriority));
         }
-
-        break;
-
-    case kBackward:
-
+    }
+    else
+    {
         if (aEndPtr <= aStartPtr)
         {
             distance = static_cast<size_t>(aStartPtr - aEndPtr);
         }
         else
         {
-            distance = static_cast<size_t>(mBufferEnd - aEndPtr);
-            distance += static_cast<size_t>(aStartPtr - mBuffer);
+            distance = static_cast<size_t>(GetRegionEnd(aPriority) - aEndPtr);
+            distance += static_cast<size_t>(aStartPtr - GetRegionStart(aPriority));
         }
-
-        break;
-
-    case kUnknown:
-        OT_ASSERT(false);
-        OT_UNREACHABLE_CODE(break);
     }
 
     return static_cast<uint16_t>(distance);
 }
 
 // Writes a uint16 value at the given buffer pointer (big-endian style).
-void Buffer::WriteUint16At(uint8_t *aBufPtr, uint16_t aValue, Direction aDirection)
+void Buffer::WriteUint16At(uint8_t *aBufPtr, uint16_t aValue, uint8_t aPriority)
 {
-    *aBufPtr                                  = (aValue >> 8);
-    *GetUpdatedBufPtr(aBufPtr, 1, aDirection) = (aValue & 0xff);
+    *aBufPtr                                 = (aValue >> 8);
+    *GetUpdatedBufPtr(aBufPtr, 1, aPriority) = (aValue & 0xff);
 }
 
 // Reads a uint16 value at the given buffer pointer (big-endian style).
-uint16_t Buffer::ReadUint16At(uint8_t *aBufPtr, Direction aDirection)
+uint16_t Buffer::ReadUint16At(uint8_t *aBufPtr, uint8_t aPriority)
 {
     uint16_t value;
 
     value = static_cast<uint16_t>((*aBufPtr) << 8);
-    value += *GetUpdatedBufPtr(aBufPtr, 1, aDirection);
+    value += *GetUpdatedBufPtr(aBufPtr, 1, aPriority);
 
     return value;
 }
@@ -226,12 +278,12 @@ otError Buffer::InFrameAppend(uint8_t aByte)
     otError  error = OT_ERROR_NONE;
     uint8_t *newTail;
 
-    OT_ASSERT(mWriteDirection != kUnknown);
+    OT_ASSERT(mWritePriority != kUnknownPriority);
 
-    newTail = GetUpdatedBufPtr(mWriteSegmentTail, 1, mWriteDirection);
+    newTail = GetUpdatedBufPtr(mWriteSegmentTail, 1, mWritePriority);
 
-    // Ensure the `newTail` has not reached the `mWriteFrameStart` for other direction (other priority level).
-    if (newTail != mWriteFrameStart[(mWriteDirection == kForward) ? kBackward : kForward])
+    // Ensure the `newTail` has not reached the `mWriteFrameStart` of the other priority level sharing the region.
+    if (newTail != mWriteFrameStart[GetSharingPriority(mWritePriority)])
     {
         *mWriteSegmentTail = aByte;
         mWriteSegmentTail  = newTail;
@@ -255,7 +307,7 @@ otError Buffer::InFrameBeginSegment(void)
     VerifyOrExit(mWriteSegmentHead == mWriteSegmentTail, OT_NOOP);
 
     // Check if this is the start of a new frame (i.e., frame start is same as segment head).
-    if (mWriteFrameStart[mWriteDirection] == mWriteSegmentHead)
+    if (mWriteFrameStart[mWritePriority] == mWriteSegmentHead)
     {
         headerFlags |= kSegmentHeaderNewFrameFlag;
     }
@@ -267,7 +319,7 @@ otError Buffer::InFrameBeginSegment(void)
     }
 
     // Write the flags at the segment head.
-    WriteUint16At(mWriteSegmentHead, headerFlags, mWriteDirection);
+    WriteUint16At(mWriteSegmentHead, headerFlags, mWritePriority);
 
 exit:
     return error;
@@ -279,7 +331,7 @@ void Buffer::InFrameEndSegment(uint16_t aSegmentHeaderFlags)
     uint16_t segmentLength;
     uint16_t header;
 
-    segmentLength = GetDistance(mWriteSegmentHead, mWriteSegmentTail, mWriteDirection);
+    segmentLength = GetDistance(mWriteSegmentHead, mWriteSegmentTail, mWritePriority);
 
     if (segmentLength >= kSegmentHeaderSize)
     {
@@ -287,10 +339,10 @@ void Buffer::InFrameEndSegment(uint16_t aSegmentHeaderFlags)
         segmentLength -= kSegmentHeaderSize;
 
         // Update the length and the flags in segment header (at segment head pointer).
-        header = ReadUint16At(mWriteSegmentHead, mWriteDirection);
+        header = ReadUint16At(mWriteSegmentHead, mWritePriority);
         header |= (segmentLength & kSegmentHeaderLengthMask);
         header |= aSegmentHeaderFlags;
-        WriteUint16At(mWriteSegmentHead, header, mWriteDirection);
+        WriteUint16At(mWriteSegmentHead, header, mWritePriority);
 
         // Move the segment head to current tail (to be ready for a possible next segment).
         mWriteSegmentHead = mWriteSegmentTail;
@@ -309,10 +361,10 @@ void Buffer::InFrameDiscard(void)
     otMessage *message;
 #endif
 
-    VerifyOrExit(mWriteDirection != kUnknown, OT_NOOP);
+    VerifyOrExit(mWritePriority != kUnknownPriority, OT_NOOP);
 
     // Move the write segment head and tail pointers back to frame start.
-    mWriteSegmentHead = mWriteSegmentTail = mWriteFrameStart[mWriteDirection];
+    mWriteSegmentHead = mWriteSegmentTail = mWriteFrameStart[mWritePriority];
 
 #if OPENTHREAD_SPINEL_CONFIG_OPENTHREAD_MESSAGE_ENABLE
     while ((message = otMessageQueueGetHead(&mWriteFrameMessageQueue)) != NULL)
@@ -325,16 +377,21 @@ void Buffer::InFrameDiscard(void)
     }
 #endif
 
-    mWriteDirection = kUnknown;
+#if OPENTHREAD_SPINEL_CONFIG_EXTERNAL_DATA_QUEUE_SIZE
+    // Same for the external data blocks, they are dropped from the queue without being released.
+    mWriteFrameExternalDataCount = 0;
+#endif
+
+    mWritePriority = kUnknownPriority;
 
 exit:
     UpdateReadWriteStartPointers();
 }
 
 // Returns `true` if in middle of writing a frame with given priority.
-bool Buffer::InFrameIsWriting(Priority aPriority) const
+bool Buffer::InFrameIsWriting(uint8_t aPriority) const
 {
-    return (mWriteDirection == static_cast<Direction>(aPriority));
+    return (mWritePriority == aPriority);
 }
 
 void Buffer::InFrameBegin(Priority aPriority)
@@ -342,26 +399,19 @@ void Buffer::InFrameBegin(Priority aPriority)
     // Discard any previous unfinished frame.
     InFrameDiscard();
 
-    switch (aPriority)
-    {
-    case kPriorityHigh:
-        mWriteDirection = kBackward;
-        break;
+    OT_ASSERT(static_cast<uint8_t>(aPriority) < kNumPrios);
 
-    case kPriorityLow:
-        mWriteDirection = kForward;
-        break;
-    }
+    mWritePriority = static_cast<uint8_t>(aPriority);
 
     // Set up the segment head and tail
-    mWriteSegmentHead = mWriteSegmentTail = mWriteFrameStart[mWriteDirection];
+    mWriteSegmentHead = mWriteSegmentTail = mWriteFrameStart[mWritePriority];
 }
 
 otError Buffer::InFrameFeedByte(uint8_t aByte)
 {
     otError error = OT_ERROR_NONE;
 
-    VerifyOrExit(mWriteDirection != kUnknown, error = OT_ERROR_INVALID_STATE);
+    VerifyOrExit(mWritePriority != kUnknownPriority, error = OT_ERROR_INVALID_STATE);
 
     // Begin a new segment (if we are not in middle of segment already).
     SuccessOrExit(error = InFrameBeginSegment());
@@ -376,7 +426,7 @@ otError Buffer::InFrameFeedData(const uint8_t *aDataBuffer, uint16_t aDataBuffer
 {
     otError error = OT_ERROR_NONE;
 
-    VerifyOrExit(mWriteDirection != kUnknown, error = OT_ERROR_INVALID_STATE);
+    VerifyOrExit(mWritePriority != kUnknownPriority, error = OT_ERROR_INVALID_STATE);
 
     // Begin a new segment (if we are not in middle of segment already).
     SuccessOrExit(error = InFrameBeginSegment());
@@ -397,7 +447,7 @@ otError Buffer::InFrameFeedMessage(otMessage *aMessage)
     otError error = OT_ERROR_NONE;
 
     VerifyOrExit(aMessage != NULL, error = OT_ERROR_INVALID_ARGS);
-    VerifyOrExit(mWriteDirection != kUnknown, error = OT_ERROR_INVALID_STATE);
+    VerifyOrExit(mWritePriority != kUnknownPriority, error = OT_ERROR_INVALID_STATE);
 
     // Begin a new segment (if we are not in middle of segment already).
     SuccessOrExit(error = InFrameBeginSegment());
@@ -413,11 +463,76 @@ exit:
 }
 #endif
 
+#if OPENTHREAD_SPINEL_CONFIG_EXTERNAL_DATA_QUEUE_SIZE
+otError Buffer::InFrameFeedExternalData(const uint8_t *          aData,
+                                        uint16_t                 aLength,
+                                        ExternalDataFreeCallback aFreeCallback,
+                                        void *                   aContext)
+{
+    otError       error = OT_ERROR_NONE;
+    ExternalData *external;
+
+    VerifyOrExit((aData != NULL) && (aFreeCallback != NULL), error = OT_ERROR_INVALID_ARGS);
+    VerifyOrExit(mWritePriority != kUnknownPriority, error = OT_ERROR_INVALID_STATE);
+
+    // Ensure there is a free entry in the external data queue of this priority, discard the frame otherwise.
+    if (mExternalDataCount[mWritePriority] + mWriteFrameExternalDataCount >= kExternalDataQueueSize)
+    {
+        InFrameDiscard();
+        ExitNow(error = OT_ERROR_NO_BUFS);
+    }
+
+    // Begin a new segment (if we are not in middle of segment already).
+    SuccessOrExit(error = InFrameBeginSegment());
+
+    // Add the data block after the ones already queued, it is owned by `Buffer` once the frame is finished.
+    external = &GetExternalData(mWritePriority, mExternalDataCount[mWritePriority] + mWriteFrameExternalDataCount);
+
+    external->mData         = aData;
+    external->mLength       = aLength;
+    external->mFreeCallback = aFreeCallback;
+    external->mContext      = aContext;
+    mWriteFrameExternalDataCount++;
+
+    // End/Close the current segment marking the flag that it contains an associated external data block.
+    InFrameEndSegment(kSegmentHeaderExternalDataIndicatorFlag);
+
+exit:
+    return error;
+}
+
+Buffer::ExternalData &Buffer::GetExternalData(uint8_t aPriority, uint8_t aIndex)
+{
+    return mExternalData[aPriority][(mExternalDataHead[aPriority] + aIndex) % kExternalDataQueueSize];
+}
+
+// Removes the first external data block from the queue of a given priority level and releases it.
+void Buffer::FreeExternalData(uint8_t aPriority)
+{
+    ExternalDataFreeCallback freeCallback;
+    void *                   context;
+
+    VerifyOrExit(mExternalDataCount[aPriority] > 0, OT_NOOP);
+
+    freeCallback = GetExternalData(aPriority, 0).mFreeCallback;
+    context      = GetExternalData(aPriority, 0).mContext;
+
+    // Update the queue before invoking the callback, which may add a new frame.
+    mExternalDataHead[aPriority] = (mExternalDataHead[aPriority] + 1) % kExternalDataQueueSize;
+    mExternalDataCount[aPriority]--;
+
+    freeCallback(context);
+
+exit:
+    return;
+}
+#endif // OPENTHREAD_SPINEL_CONFIG_EXTERNAL_DATA_QUEUE_SIZE
+
 otError Buffer::InFrameGetPosition(WritePosition &aPosition)
 {
     otError error = OT_ERROR_NONE;
 
-    VerifyOrExit(mWriteDirection != kUnknown, error = OT_ERROR_INVALID_STATE);
+    VerifyOrExit(mWritePriority != kUnknownPriority, error = OT_ERROR_INVALID_STATE);
 
     // Begin a new segment (if we are not in middle of segment already).
     SuccessOrExit(error = InFrameBeginSegment());
@@ -436,13 +551,13 @@ otError Buffer::InFrameOverwrite(const WritePosition &aPosition, const uint8_t *
     uint16_t segmentLength;
     uint16_t distance;
 
-    VerifyOrExit(mWriteDirection != kUnknown, error = OT_ERROR_INVALID_STATE);
+    VerifyOrExit(mWritePriority != kUnknownPriority, error = OT_ERROR_INVALID_STATE);
 
     VerifyOrExit(aPosition.mSegmentHead == mWriteSegmentHead, error = OT_ERROR_INVALID_ARGS);
 
     // Ensure the overwrite does not go beyond current segment tail.
-    segmentLength = GetDistance(mWriteSegmentHead, mWriteSegmentTail, mWriteDirection);
-    distance      = GetDistance(mWriteSegmentHead, aPosition.mPosition, mWriteDirection);
+    segmentLength = GetDistance(mWriteSegmentHead, mWriteSegmentTail, mWritePriority);
+    distance      = GetDistance(mWriteSegmentHead, aPosition.mPosition, mWritePriority);
     VerifyOrExit(distance + aDataBufferLength <= segmentLength, error = OT_ERROR_INVALID_ARGS);
 
     bufPtr = aPosition.mPosition;
@@ -453,7 +568,7 @@ otError Buffer::InFrameOverwrite(const WritePosition &aPosition, const uint8_t *
         aDataBuffer++;
         aDataBufferLength--;
 
-        bufPtr = GetUpdatedBufPtr(bufPtr, 1, mWriteDirection);
+        bufPtr = GetUpdatedBufPtr(bufPtr, 1, mWritePriority);
     }
 
 exit:
@@ -466,14 +581,14 @@ uint16_t Buffer::InFrameGetDistance(const WritePosition &aPosition) const
     uint16_t segmentLength;
     uint16_t offset;
 
-    VerifyOrExit(mWriteDirection != kUnknown, OT_NOOP);
+    VerifyOrExit(mWritePriority != kUnknownPriority, OT_NOOP);
     VerifyOrExit(aPosition.mSegmentHead == mWriteSegmentHead, OT_NOOP);
 
-    segmentLength = GetDistance(mWriteSegmentHead, mWriteSegmentTail, mWriteDirection);
-    offset        = GetDistance(mWriteSegmentHead, aPosition.mPosition, mWriteDirection);
+    segmentLength = GetDistance(mWriteSegmentHead, mWriteSegmentTail, mWritePriority);
+    offset        = GetDistance(mWriteSegmentHead, aPosition.mPosition, mWritePriority);
     VerifyOrExit(offset < segmentLength, OT_NOOP);
 
-    distance = GetDistance(aPosition.mPosition, mWriteSegmentTail, mWriteDirection);
+    distance = GetDistance(aPosition.mPosition, mWriteSegmentTail, mWritePriority);
 
 exit:
     return distance;
@@ -485,11 +600,11 @@ otError Buffer::InFrameReset(const WritePosition &aPosition)
     uint16_t segmentLength;
     uint16_t offset;
 
-    VerifyOrExit(mWriteDirection != kUnknown, error = OT_ERROR_INVALID_STATE);
+    VerifyOrExit(mWritePriority != kUnknownPriority, error = OT_ERROR_INVALID_STATE);
     VerifyOrExit(aPosition.mSegmentHead == mWriteSegmentHead, error = OT_ERROR_INVALID_ARGS);
 
-    segmentLength = GetDistance(mWriteSegmentHead, mWriteSegmentTail, mWriteDirection);
-    offset        = GetDistance(mWriteSegmentHead, aPosition.mPosition, mWriteDirection);
+    segmentLength = GetDistance(mWriteSegmentHead, mWriteSegmentTail, mWritePriority);
+    offset        = GetDistance(mWriteSegmentHead, aPosition.mPosition, mWritePriority);
     VerifyOrExit(offset < segmentLength, error = OT_ERROR_INVALID_ARGS);
 
     mWriteSegmentTail = aPosition.mPosition;
@@ -505,32 +620,38 @@ otError Buffer::InFrameEnd(void)
 #endif
     otError error = OT_ERROR_NONE;
 
-    VerifyOrExit(mWriteDirection != kUnknown, error = OT_ERROR_INVALID_STATE);
+    VerifyOrExit(mWritePriority != kUnknownPriority, error = OT_ERROR_INVALID_STATE);
 
     // End/Close the current segment (if any).
     InFrameEndSegment(kSegmentHeaderNoFlag);
 
     // Save and use the frame start pointer as the tag associated with the frame.
-    mWriteFrameTag = mWriteFrameStart[mWriteDirection];
+    mWriteFrameTag = mWriteFrameStart[mWritePriority];
 
     // Update the frame start pointer to current segment head to be ready for next frame.
-    mWriteFrameStart[mWriteDirection] = mWriteSegmentHead;
+    mWriteFrameStart[mWritePriority] = mWriteSegmentHead;
 
 #if OPENTHREAD_SPINEL_CONFIG_OPENTHREAD_MESSAGE_ENABLE
     // Move all the messages from the frame queue to the main queue.
     while ((message = otMessageQueueGetHead(&mWriteFrameMessageQueue)) != NULL)
     {
         otMessageQueueDequeue(&mWriteFrameMessageQueue, message);
-        otMessageQueueEnqueue(&mMessageQueue[mWriteDirection], message);
+        otMessageQueueEnqueue(&mMessageQueue[mWritePriority], message);
     }
 #endif
 
+#if OPENTHREAD_SPINEL_CONFIG_EXTERNAL_DATA_QUEUE_SIZE
+    // The external data blocks of the frame are now owned by the `Buffer`.
+    mExternalDataCount[mWritePriority] += mWriteFrameExternalDataCount;
+    mWriteFrameExternalDataCount = 0;
+#endif
+
     if (mFrameAddedCallback != NULL)
     {
-        mFrameAddedCallback(mFrameAddedContext, mWriteFrameTag, static_cast<Priority>(mWriteDirection), this);
+        mFrameAddedCallback(mFrameAddedContext, mWriteFrameTag, static_cast<Priority>(mWritePriority), this);
     }
 
-    mWriteDirection = kUnknown;
+    mWritePriority = kUnknownPriority;
 
 exit:
     return error;
@@ -541,22 +662,78 @@ Buffer::FrameTag Buffer::InFrameGetLastTag(void) const
     return mWriteFrameTag;
 }
 
-bool Buffer::HasFrame(Priority aPriority) const
+bool Buffer::HasFrame(uint8_t aPriority) const
 {
     return mReadFrameStart[aPriority] != mWriteFrameStart[aPriority];
 }
 
 bool Buffer::IsEmpty(void) const
 {
-    return !HasFrame(kPriorityHigh) && !HasFrame(kPriorityLow);
+    bool isEmpty = true;
+
+    for (uint8_t priority = 0; priority < kNumPrios; priority++)
+    {
+        if (HasFrame(priority))
+        {
+            isEmpty = false;
+            break;
+        }
+    }
+
+    return isEmpty;
+}
+
+uint16_t Buffer::GetFreeSpace(Priority aPriority) const
+{
+    uint16_t freeSpace = 0;
+
+    VerifyOrExit(static_cast<uint8_t>(aPriority) < kNumPrios, OT_NOOP);
+
+    // A new frame can grow up to the start of the frame being written by the other priority level sharing the region.
+    freeSpace = GetDistance(mWriteFrameStart[aPriority], mWriteFrameStart[GetSharingPriority(aPriority)], aPriority);
+
+exit:
+    return freeSpace;
 }
 
-void Buffer::OutFrameSelectReadDirection(void)
+// Selects the priority level to read the next frame from (unless in middle of reading a frame) using deficit round
+// robin.
+void Buffer::OutFrameSelectReadPriority(void)
 {
-    if (mReadState == kReadStateNotActive)
+    VerifyOrExit(mReadState == kReadStateNotActive, OT_NOOP);
+    VerifyOrExit(!IsEmpty(), OT_NOOP);
+
+    while (true)
     {
-        mReadDirection = HasFrame(kPriorityHigh) ? kBackward : kForward;
+        uint8_t priority = mScheduledPriority;
+
+        if (HasFrame(priority))
+        {
+            // Give the priority level its credit once per visit.
+            if (!mScheduledCredited)
+            {
+                mDeficit[priority] += static_cast<uint32_t>(kPriorityWeights[priority]) * kQuantum;
+                mScheduledCredited = true;
+            }
+
+            if (mDeficit[priority] >= OutFrameGetLength(priority))
+            {
+                mReadPriority = priority;
+                break;
+            }
+        }
+        else
+        {
+            // A priority level with nothing to send does not keep its credit.
+            mDeficit[priority] = 0;
+        }
+
+        mScheduledPriority = (priority + 1 < kNumPrios) ? priority + 1 : 0;
+        mScheduledCredited = false;
     }
+
+exit:
+    return;
 }
 
 // Start/Prepare a new segment for reading.
@@ -571,24 +748,24 @@ otError Buffer::OutFramePrepareSegment(void)
         mReadSegmentHead = mReadSegmentTail;
 
         // Ensure there is something to read (i.e. segment head is not at start of frame being written).
-        VerifyOrExit(mReadSegmentHead != mWriteFrameStart[mReadDirection], error = OT_ERROR_NOT_FOUND);
+        VerifyOrExit(mReadSegmentHead != mWriteFrameStart[mReadPriority], error = OT_ERROR_NOT_FOUND);
 
         // Read the segment header.
-        header = ReadUint16At(mReadSegmentHead, mReadDirection);
+        header = ReadUint16At(mReadSegmentHead, mReadPriority);
 
         // Check if this segment is the start of a frame.
         if (header & kSegmentHeaderNewFrameFlag)
         {
             // Ensure that this segment is start of current frame, otherwise the current frame is finished.
-            VerifyOrExit(mReadSegmentHead == mReadFrameStart[mReadDirection], error = OT_ERROR_NOT_FOUND);
+            VerifyOrExit(mReadSegmentHead == mReadFrameStart[mReadPriority], error = OT_ERROR_NOT_FOUND);
         }
 
         // Find tail/end of current segment.
         mReadSegmentTail = GetUpdatedBufPtr(mReadSegmentHead, kSegmentHeaderSize + (header & kSegmentHeaderLengthMask),
-                                            mReadDirection);
+                                            mReadPriority);
 
         // Update the current read pointer to skip the segment header.
-        mReadPointer = GetUpdatedBufPtr(mReadSegmentHead, kSegmentHeaderSize, mReadDirection);
+        mReadPointer = GetUpdatedBufPtr(mReadSegmentHead, kSegmentHeaderSize, mReadPriority);
 
         // Check if there are data bytes to be read in this segment (i.e. read pointer not at the tail).
         if (mReadPointer != mReadSegmentTail)
@@ -599,15 +776,13 @@ otError Buffer::OutFramePrepareSegment(void)
             ExitNow();
         }
 
-#if OPENTHREAD_SPINEL_CONFIG_OPENTHREAD_MESSAGE_ENABLE
-        // No data in this segment,  prepare any appended/associated message of this segment.
-        if (OutFramePrepareMessage() == OT_ERROR_NONE)
+        // No data in this segment, prepare any appended/associated message or external data of this segment.
+        if (OutFramePrepareAppended() == OT_ERROR_NONE)
         {
             ExitNow();
         }
 
-        // If there is no message (`PrepareMessage()` returned an error), loop back to prepare the next segment.
-#endif
+        // If there is nothing appended (`PrepareAppended()` returned an error), loop back to prepare the next segment.
     }
 
 exit:
@@ -620,6 +795,26 @@ exit:
     return error;
 }
 
+// This method prepares the message or external data block associated with current segment. It returns
+// OT_ERROR_NOT_FOUND if there is none or if it has no content.
+otError Buffer::OutFramePrepareAppended(void)
+{
+    otError error = OT_ERROR_NOT_FOUND;
+
+#if OPENTHREAD_SPINEL_CONFIG_OPENTHREAD_MESSAGE_ENABLE
+    error = OutFramePrepareMessage();
+#endif
+
+#if OPENTHREAD_SPINEL_CONFIG_EXTERNAL_DATA_QUEUE_SIZE
+    if (error != OT_ERROR_NONE)
+    {
+        error = OutFramePrepareExternalData();
+    }
+#endif
+
+    return error;
+}
+
 #if OPENTHREAD_SPINEL_CONFIG_OPENTHREAD_MESSAGE_ENABLE
 // This method prepares an associated message in current segment and fills the message buffer. It returns
 // ThreadError_NotFound if there is no message or if the message has no content.
@@ -629,14 +824,14 @@ otError Buffer::OutFramePrepareMessage(void)
     uint16_t header;
 
     // Read the segment header
-    header = ReadUint16At(mReadSegmentHead, mReadDirection);
+    header = ReadUint16At(mReadSegmentHead, mReadPriority);
 
     // Ensure that the segment header indicates that there is an associated message or return `NotFound` error.
     VerifyOrExit((header & kSegmentHeaderMessageIndicatorFlag) != 0, error = OT_ERROR_NOT_FOUND);
 
     // Update the current message from the queue.
-    mReadMessage = (mReadMessage == NULL) ? otMessageQueueGetHead(&mMessageQueue[mReadDirection])
-                                          : otMessageQueueGetNext(&mMessageQueue[mReadDirection], mReadMessage);
+    mReadMessage = (mReadMessage == NULL) ? otMessageQueueGetHead(&mMessageQueue[mReadPriority])
+                                          : otMessageQueueGetNext(&mMessageQueue[mReadPriority], mReadMessage);
 
     VerifyOrExit(mReadMessage != NULL, error = OT_ERROR_NOT_FOUND);
 
@@ -682,21 +877,58 @@ exit:
 }
 #endif // #if OPENTHREAD_SPINEL_CONFIG_OPENTHREAD_MESSAGE_ENABLE
 
+#if OPENTHREAD_SPINEL_CONFIG_EXTERNAL_DATA_QUEUE_SIZE
+// This method prepares an associated external data block in current segment for reading. It returns
+// OT_ERROR_NOT_FOUND if there is no external data block or if it is empty.
+otError Buffer::OutFramePrepareExternalData(void)
+{
+    otError       error = OT_ERROR_NONE;
+    ExternalData *external;
+    uint16_t      header;
+
+    // Read the segment header
+    header = ReadUint16At(mReadSegmentHead, mReadPriority);
+
+    // Ensure that the segment header indicates that there is an associated external data block.
+    VerifyOrExit((header & kSegmentHeaderExternalDataIndicatorFlag) != 0, error = OT_ERROR_NOT_FOUND);
+
+    VerifyOrExit(mReadExternalDataIndex < mExternalDataCount[mReadPriority], error = OT_ERROR_NOT_FOUND);
+
+    // Move to the next external data block of the frame.
+    external = &GetExternalData(mReadPriority, mReadExternalDataIndex++);
+
+    VerifyOrExit(external->mLength > 0, error = OT_ERROR_NOT_FOUND);
+
+    // The block is read in place, `mReadPointer` is only used for reading.
+    mReadPointer          = const_cast<uint8_t *>(external->mData);
+    mReadExternalDataTail = external->mData + external->mLength;
+
+    mReadState = kReadStateInExternal;
+
+exit:
+    return error;
+}
+#endif // OPENTHREAD_SPINEL_CONFIG_EXTERNAL_DATA_QUEUE_SIZE
+
 otError Buffer::OutFrameBegin(void)
 {
     otError error = OT_ERROR_NONE;
 
     VerifyOrExit(!IsEmpty(), error = OT_ERROR_NOT_FOUND);
 
-    OutFrameSelectReadDirection();
+    OutFrameSelectReadPriority();
 
     // Move the segment head and tail to start of frame.
-    mReadSegmentHead = mReadSegmentTail = mReadFrameStart[mReadDirection];
+    mReadSegmentHead = mReadSegmentTail = mReadFrameStart[mReadPriority];
 
 #if OPENTHREAD_SPINEL_CONFIG_OPENTHREAD_MESSAGE_ENABLE
     mReadMessage = NULL;
 #endif
 
+#if OPENTHREAD_SPINEL_CONFIG_EXTERNAL_DATA_QUEUE_SIZE
+    mReadExternalDataIndex = 0;
+#endif
+
     // Prepare the current segment for reading.
     error = OutFramePrepareSegment();
 
@@ -730,19 +962,15 @@ uint8_t Buffer::OutFrameReadByte(void)
 
         // Read a byte from current read pointer and move the read pointer by 1 byte in the read direction.
         retval       = *mReadPointer;
-        mReadPointer = GetUpdatedBufPtr(mReadPointer, 1, mReadDirection);
+        mReadPointer = GetUpdatedBufPtr(mReadPointer, 1, mReadPriority);
 
         // Check if at end of current segment.
         if (mReadPointer == mReadSegmentTail)
         {
-#if OPENTHREAD_SPINEL_CONFIG_OPENTHREAD_MESSAGE_ENABLE
-            // Prepare any message associated with this segment.
-            error = OutFramePrepareMessage();
-#else
-            error = OT_ERROR_NOT_FOUND;
-#endif
+            // Prepare any message or external data associated with this segment.
+            error = OutFramePrepareAppended();
 
-            // If there is no message, move to next segment (if any).
+            // If there is nothing appended, move to next segment (if any).
             if (error != OT_ERROR_NONE)
             {
                 OutFramePrepareSegment();
@@ -769,6 +997,20 @@ uint8_t Buffer::OutFrameReadByte(void)
                 OutFramePrepareSegment();
             }
         }
+#endif
+        break;
+
+    case kReadStateInExternal:
+#if OPENTHREAD_SPINEL_CONFIG_EXTERNAL_DATA_QUEUE_SIZE
+        // Read a byte from current read pointer and move the read pointer by 1 byte.
+        retval = *mReadPointer;
+        mReadPointer++;
+
+        // If at the end of the external data block, move to next segment (if any).
+        if (mReadPointer == mReadExternalDataTail)
+        {
+            OutFramePrepareSegment();
+        }
 #endif
         break;
     }
@@ -780,9 +1022,71 @@ uint16_t Buffer::OutFrameRead(uint16_t aReadLength, uint8_t *aDataBuffer)
 {
     uint16_t bytesRead = 0;
 
-    for (bytesRead = 0; (bytesRead < aReadLength) && !OutFrameHasEnded(); bytesRead++)
+    while ((bytesRead < aReadLength) && !OutFrameHasEnded())
     {
+        uint16_t count     = aReadLength - bytesRead;
+        uint16_t available = 0;
+        bool     backward  = false;
+
+        // Copy in bulk all but the last byte of the contiguous run up to the end of the current segment or message
+        // buffer, then let `OutFrameReadByte()` read the last byte and move to the next segment if needed.
+
+        switch (mReadState)
+        {
+        case kReadStateInSegment:
+            available = GetDistance(mReadPointer, mReadSegmentTail, mReadPriority);
+            backward  = IsBackward(mReadPriority);
+
+            if (!backward && (available > GetRegionEnd(mReadPriority) - mReadPointer))
+            {
+                available = static_cast<uint16_t>(GetRegionEnd(mReadPriority) - mReadPointer);
+            }
+            else if (backward && (available > mReadPointer - GetRegionStart(mReadPriority) + 1))
+            {
+                available = static_cast<uint16_t>(mReadPointer - GetRegionStart(mReadPriority) + 1);
+            }
+
+            break;
+
+#if OPENTHREAD_SPINEL_CONFIG_OPENTHREAD_MESSAGE_ENABLE
+        case kReadStateInMessage:
+            available = static_cast<uint16_t>(mReadMessageTail - mReadPointer);
+            break;
+#endif
+
+#if OPENTHREAD_SPINEL_CONFIG_EXTERNAL_DATA_QUEUE_SIZE
+        case kReadStateInExternal:
+            available = static_cast<uint16_t>(mReadExternalDataTail - mReadPointer);
+            break;
+#endif
+
+        default:
+            break;
+        }
+
+        if (count > available)
+        {
+            count = available;
+        }
+
+        count = (count > 0) ? count - 1 : 0;
+
+        if (!backward)
+        {
+            memcpy(aDataBuffer, mReadPointer, count);
+            mReadPointer += count;
+            aDataBuffer += count;
+        }
+        else
+        {
+            for (uint16_t i = 0; i < count; i++)
+            {
+                *aDataBuffer++ = *mReadPointer--;
+            }
+        }
+
         *aDataBuffer++ = OutFrameReadByte();
+        bytesRead += count + 1;
     }
 
     return bytesRead;
@@ -794,30 +1098,31 @@ otError Buffer::OutFrameRemove(void)
     uint8_t *bufPtr;
     uint16_t header;
     uint8_t  numSegments;
+    uint16_t frameLength = 0;
     FrameTag tag;
 
     VerifyOrExit(!IsEmpty(), error = OT_ERROR_NOT_FOUND);
 
-    OutFrameSelectReadDirection();
+    OutFrameSelectReadPriority();
 
     // Save the frame start pointer as the tag associated with the frame being removed.
-    tag = mReadFrameStart[mReadDirection];
+    tag = mReadFrameStart[mReadPriority];
 
     // Begin at the start of current frame and move through all segments.
 
-    bufPtr      = mReadFrameStart[mReadDirection];
+    bufPtr      = mReadFrameStart[mReadPriority];
     numSegments = 0;
 
-    while (bufPtr != mWriteFrameStart[mReadDirection])
+    while (bufPtr != mWriteFrameStart[mReadPriority])
     {
         // Read the segment header
-        header = ReadUint16At(bufPtr, mReadDirection);
+        header = ReadUint16At(bufPtr, mReadPriority);
 
         // If the current segment defines a new frame, and it is not the start of current frame, then we have reached
         // end of current frame.
         if (header & kSegmentHeaderNewFrameFlag)
         {
-            if (bufPtr != mReadFrameStart[mReadDirection])
+            if (bufPtr != mReadFrameStart[mReadPriority])
             {
                 break;
             }
@@ -829,16 +1134,28 @@ otError Buffer::OutFrameRemove(void)
         {
             otMessage *message;
 
-            if ((message = otMessageQueueGetHead(&mMessageQueue[mReadDirection])) != NULL)
+            if ((message = otMessageQueueGetHead(&mMessageQueue[mReadPriority])) != NULL)
             {
-                otMessageQueueDequeue(&mMessageQueue[mReadDirection], message);
+                frameLength += otMessageGetLength(message);
+                otMessageQueueDequeue(&mMessageQueue[mReadPriority], message);
                 otMessageFree(message);
             }
         }
 #endif
 
+#if OPENTHREAD_SPINEL_CONFIG_EXTERNAL_DATA_QUEUE_SIZE
+        // If current segment has an appended external data block, remove it from the queue and release it.
+        if ((header & kSegmentHeaderExternalDataIndicatorFlag) && (mExternalDataCount[mReadPriority] > 0))
+        {
+            frameLength += GetExternalData(mReadPriority, 0).mLength;
+            FreeExternalData(mReadPriority);
+        }
+#endif
+
+        frameLength += (header & kSegmentHeaderLengthMask);
+
         // Move the pointer to next segment.
-        bufPtr = GetUpdatedBufPtr(bufPtr, kSegmentHeaderSize + (header & kSegmentHeaderLengthMask), mReadDirection);
+        bufPtr = GetUpdatedBufPtr(bufPtr, kSegmentHeaderSize + (header & kSegmentHeaderLengthMask), mReadPriority);
 
         numSegments++;
 
@@ -847,7 +1164,10 @@ otError Buffer::OutFrameRemove(void)
         OT_ASSERT(numSegments <= kMaxSegments);
     }
 
-    mReadFrameStart[mReadDirection] = bufPtr;
+    mReadFrameStart[mReadPriority] = bufPtr;
+
+    // Charge the removed frame to the deficit of its priority level.
+    mDeficit[mReadPriority] = (mDeficit[mReadPriority] > frameLength) ? mDeficit[mReadPriority] - frameLength : 0;
 
     UpdateReadWriteStartPointers();
 
@@ -856,7 +1176,7 @@ otError Buffer::OutFrameRemove(void)
 
     if (mFrameRemovedCallback != NULL)
     {
-        mFrameRemovedCallback(mFrameRemovedContext, tag, static_cast<Priority>(mReadDirection), this);
+        mFrameRemovedCallback(mFrameRemovedContext, tag, static_cast<Priority>(mReadPriority), this);
     }
 
 exit:
@@ -865,28 +1185,56 @@ exit:
 
 void Buffer::UpdateReadWriteStartPointers(void)
 {
-    // If there is no fully written high priority frame, and not in middle of writing a new frame either.
-    if (!HasFrame(kPriorityHigh) && !InFrameIsWriting(kPriorityHigh))
+    // Each region is shared by a forward (even) and a backward (odd) priority level.
+    for (uint8_t forward = 0; forward < kNumPrios; forward += 2)
     {
-        // Move the high priority pointers to be right behind the low priority start.
-        mWriteFrameStart[kPriorityHigh] = GetUpdatedBufPtr(mReadFrameStart[kPriorityLow], 1, kBackward);
-        mReadFrameStart[kPriorityHigh]  = mWriteFrameStart[kPriorityHigh];
-        ExitNow();
+        uint8_t backward = forward + 1;
+
+        // If there is no fully written backward frame, and not in middle of writing a new frame either.
+        if (!HasFrame(backward) && !InFrameIsWriting(backward))
+        {
+            // Move the backward pointers to be right behind the forward start.
+            mWriteFrameStart[backward] = GetUpdatedBufPtr(mReadFrameStart[forward], 1, backward);
+            mReadFrameStart[backward]  = mWriteFrameStart[backward];
+            continue;
+        }
+
+        // If there is no fully written forward frame, and not in middle of writing a new frame either.
+        if (!HasFrame(forward) && !InFrameIsWriting(forward))
+        {
+            // Move the forward pointers to be 1 byte after the backward start.
+            mWriteFrameStart[forward] = GetUpdatedBufPtr(mReadFrameStart[backward], 1, forward);
+            mReadFrameStart[forward]  = mWriteFrameStart[forward];
+        }
     }
+}
+
+uint16_t Buffer::OutFrameGetLength(void)
+{
+    uint16_t frameLength = 0;
+
+    // If the frame length was calculated before, return the previously calculated length.
+    VerifyOrExit(mReadFrameLength == kUnknownFrameLength, frameLength = mReadFrameLength);
+
+    VerifyOrExit(!IsEmpty(), frameLength = 0);
 
-    // If there is no fully written low priority frame, and not in middle of writing a new frame either.
-    if (!HasFrame(kPriorityLow) && !InFrameIsWriting(kPriorityLow))
+    OutFrameSelectReadPriority();
+
+    frameLength = OutFrameGetLength(mReadPriority);
+
+    // Remember the calculated frame length for current active frame.
+    if (mReadState != kReadStateNotActive)
     {
-        // Move the low priority pointers to be 1 byte after the high priority start.
-        mWriteFrameStart[kPriorityLow] = GetUpdatedBufPtr(mReadFrameStart[kPriorityHigh], 1, kForward);
-        mReadFrameStart[kPriorityLow]  = mWriteFrameStart[kPriorityLow];
+        mReadFrameLength = frameLength;
     }
 
 exit:
-    return;
+    return frameLength;
 }
 
-uint16_t Buffer::OutFrameGetLength(void)
+// Calculates the length of the first frame of the given priority level by adding length of all segments and messages
+// within the frame.
+uint16_t Buffer::OutFrameGetLength(uint8_t aPriority)
 {
     uint16_t frameLength = 0;
     uint16_t header;
@@ -895,29 +1243,23 @@ uint16_t Buffer::OutFrameGetLength(void)
 #if OPENTHREAD_SPINEL_CONFIG_OPENTHREAD_MESSAGE_ENABLE
     otMessage *message = NULL;
 #endif
+#if OPENTHREAD_SPINEL_CONFIG_EXTERNAL_DATA_QUEUE_SIZE
+    uint8_t externalIndex = 0;
+#endif
 
-    // If the frame length was calculated before, return the previously calculated length.
-    VerifyOrExit(mReadFrameLength == kUnknownFrameLength, frameLength = mReadFrameLength);
-
-    VerifyOrExit(!IsEmpty(), frameLength = 0);
-
-    OutFrameSelectReadDirection();
-
-    // Calculate frame length by adding length of all segments and messages within the current frame.
-
-    bufPtr      = mReadFrameStart[mReadDirection];
+    bufPtr      = mReadFrameStart[aPriority];
     numSegments = 0;
 
-    while (bufPtr != mWriteFrameStart[mReadDirection])
+    while (bufPtr != mWriteFrameStart[aPriority])
     {
         // Read the segment header
-        header = ReadUint16At(bufPtr, mReadDirection);
+        header = ReadUint16At(bufPtr, aPriority);
 
         // If the current segment defines a new frame, and it is not the start of current frame, then we have reached
         // end of current frame.
         if (header & kSegmentHeaderNewFrameFlag)
         {
-            if (bufPtr != mReadFrameStart[mReadDirection])
+            if (bufPtr != mReadFrameStart[aPriority])
             {
                 break;
             }
@@ -927,8 +1269,8 @@ uint16_t Buffer::OutFrameGetLength(void)
         // If current segment has an associated message, add its length to frame length.
         if (header & kSegmentHeaderMessageIndicatorFlag)
         {
-            message = (message == NULL) ? otMessageQueueGetHead(&mMessageQueue[mReadDirection])
-                                        : otMessageQueueGetNext(&mMessageQueue[mReadDirection], message);
+            message = (message == NULL) ? otMessageQueueGetHead(&mMessageQueue[aPriority])
+                                        : otMessageQueueGetNext(&mMessageQueue[aPriority], message);
 
             if (message != NULL)
             {
@@ -937,11 +1279,19 @@ uint16_t Buffer::OutFrameGetLength(void)
         }
 #endif
 
+#if OPENTHREAD_SPINEL_CONFIG_EXTERNAL_DATA_QUEUE_SIZE
+        // If current segment has an associated external data block, add its length to frame length.
+        if ((header & kSegmentHeaderExternalDataIndicatorFlag) && (externalIndex < mExternalDataCount[aPriority]))
+        {
+            frameLength += GetExternalData(aPriority, externalIndex++).mLength;
+        }
+#endif
+
         // Add the length of current segment to the frame length.
         frameLength += (header & kSegmentHeaderLengthMask);
 
         // Move the pointer to next segment.
-        bufPtr = GetUpdatedBufPtr(bufPtr, kSegmentHeaderSize + (header & kSegmentHeaderLengthMask), mReadDirection);
+        bufPtr = GetUpdatedBufPtr(bufPtr, kSegmentHeaderSize + (header & kSegmentHeaderLengthMask), aPriority);
 
         numSegments++;
 
@@ -950,24 +1300,17 @@ uint16_t Buffer::OutFrameGetLength(void)
         OT_ASSERT(numSegments <= kMaxSegments);
     }
 
-    // Remember the calculated frame length for current active frame.
-    if (mReadState != kReadStateNotActive)
-    {
-        mReadFrameLength = frameLength;
-    }
-
-exit:
     return frameLength;
 }
 
 Buffer::FrameTag Buffer::OutFrameGetTag(void)
 {
-    OutFrameSelectReadDirection();
+    OutFrameSelectReadPriority();
 
     // If buffer is empty use `kInvalidTag`, otherwise use the frame start pointer as the tag associated with
     // current out frame being read
 
-    return IsEmpty() ? kInvalidTag : mReadFrameStart[mReadDirection];
+    return IsEmpty() ? kInvalidTag : mReadFrameStart[mReadPriority];
 }
 
 } // namespace Spinel
@@ -44,9 +44,10 @@ namespace Spinel {
  * This class implements a buffer/queue for storing Ncp frames.
  *
  * A frame can consist of a sequence of data bytes and/or the content of an `otMessage` or a combination of the two.
- * `Buffer` implements priority FIFO logic for storing and reading frames. Two priority levels of high and low
- * are supported. Within same priority level first-in-first-out order is preserved. High priority frames are read
- * ahead of any low priority ones.
+ * `Buffer` implements priority FIFO logic for storing and reading frames. The number of priority levels is set by
+ * `OPENTHREAD_SPINEL_CONFIG_BUFFER_NUM_PRIORITIES` (two by default, high and low). Within same priority level
+ * first-in-first-out order is preserved. Frames of different priority levels are read using weighted deficit round
+ * robin, so that a priority level with a higher weight gets a larger share of the output but none is starved.
  *
  */
 class Buffer
@@ -55,8 +56,10 @@ class Buffer
 
 public:
     /**
-     * Defines the priority of a frame. High priority frames are read before low priority frames. Within same priority
-     * level FIFO order is preserved.
+     * Defines the priority of a frame. Within same priority level FIFO order is preserved.
+     *
+     * When more than two priority levels are configured, the levels above `kPriorityHigh` are used by casting their
+     * number (up to `OPENTHREAD_SPINEL_CONFIG_BUFFER_NUM_PRIORITIES - 1`) to `Priority`.
      *
      */
     enum Priority
@@ -116,6 +119,15 @@ public:
      */
     typedef void (*BufferCallback)(void *aContext, FrameTag aTag, Priority aPriority, Buffer *aBuffer);
 
+    /**
+     * Defines a function pointer callback which is invoked to release an external data block (added using
+     * `InFrameFeedExternalData()`) once the frame containing it is removed from `Buffer`.
+     *
+     * @param[in] aContext              A pointer to arbitrary context information given with the data block.
+     *
+     */
+    typedef void (*ExternalDataFreeCallback)(void *aContext);
+
     /**
      * This constructor initializes an NCP frame buffer.
      *
@@ -228,6 +240,39 @@ public:
     otError InFrameFeedMessage(otMessage *aMessage);
 #endif
 
+#if OPENTHREAD_SPINEL_CONFIG_EXTERNAL_DATA_QUEUE_SIZE
+    /**
+     * This method adds an external data block to the current input frame by reference (without copying it).
+     *
+     * Before using this method `InFrameBegin()` must be called to start and prepare a new input frame. Otherwise, this
+     * method does nothing and returns error status `OT_ERROR_INVALID_STATE`.
+     *
+     * If no buffer space is available or the external data queue is full, this method will discard and clear the frame
+     * and return error status `OT_ERROR_NO_BUFS`.
+     *
+     * The data block must stay valid and unchanged while it is in the `Buffer`. Similar to `InFrameFeedMessage()`, the
+     * ownership of the data block changes to `Buffer` ONLY when the entire frame is successfully finished (i.e., with
+     * a successful call to `InFrameEnd()`), and in this case @p aFreeCallback is invoked with @p aContext once the
+     * frame is removed (using `OutFrameRemove()` or `Clear()`) from the buffer. However, if the input frame gets
+     * discarded before it is finished, the callback is not invoked and the data block remains owned by the caller.
+     *
+     * @param[in] aData                 A pointer to the data block.
+     * @param[in] aLength               The length of the data block.
+     * @param[in] aFreeCallback         Callback invoked to release the data block.
+     * @param[in] aContext              A pointer to arbitrary context passed to @p aFreeCallback.
+     *
+     * @retval OT_ERROR_NONE            Successfully added the data block to the frame.
+     * @retval OT_ERROR_NO_BUFS         Insufficient buffer space available to add the data block.
+     * @retval OT_ERROR_INVALID_STATE   `InFrameBegin()` has not been called earlier to start the frame.
+     * @retval OT_ERROR_INVALID_ARGS    If @p aData or @p aFreeCallback is NULL.
+     *
+     */
+    otError InFrameFeedExternalData(const uint8_t *          aData,
+                                    uint16_t                 aLength,
+                                    ExternalDataFreeCallback aFreeCallback,
+                                    void *                   aContext);
+#endif
+
     /**
      * This method gets the current write position in the input frame.
      *
@@ -334,6 +379,28 @@ public:
      */
     bool IsEmpty(void) const;
 
+    /**
+     * This method returns the number of bytes available for writing new frames of a given priority level.
+     *
+     * The two priority levels sharing a region of the buffer (e.g., `kPriorityLow` and `kPriorityHigh`) share the same
+     * free space. Note that the content of messages and external data blocks is not stored in the buffer and only
+     * uses a segment header.
+     *
+     * @param[in] aPriority             The priority level.
+     *
+     * @returns The number of free bytes for frames of @p aPriority, or zero for an invalid priority level.
+     *
+     */
+    uint16_t GetFreeSpace(Priority aPriority) const;
+
+    /**
+     * This method returns the number of frame priority levels.
+     *
+     * @returns The number of frame priority levels.
+     *
+     */
+    static uint8_t GetNumPriorities(void) { return kNumPrios; }
+
     /**
      * This method begins/prepares an output frame to be read from the frame buffer if there is no current active output
      * frame, or resets the read offset if there is a current active output frame.
@@ -452,19 +519,22 @@ private:
      * frame. The data segments are stored in the main buffer `mBuffer`. `mBuffer` is utilized as a circular buffer.
 
      * The content of messages (which are added using `InFrameFeedMessage()`) are not directly copied in the `mBuffer`
-     * but instead they are enqueued in a message queue `mMessageQueue`.
+     * but instead they are enqueued in a message queue `mMessageQueue`. Similarly, external data blocks (which are
+     * added using `InFrameFeedExternalData()`) are referenced from the external data queue `mExternalData`.
      *
      * Every data segments starts with a header before the data portion. The header is 2 bytes long with the following
      * format:
      *
-     *    Bit 0-13: Give the length of the data segment (max segment len is 2^14 = 16,384 bytes).
+     *    Bit 0-12: Give the length of the data segment (max segment len is 2^13 = 8,192 bytes).
+     *    Bit 13:   Flag bit set to indicate that this segment has an associated external data block (appended to its
+     *              end).
      *    Bit 14:   Flag bit set to indicate that this segment has an associated `Message` (appended to its end).
      *    Bit 15:   Flag bit set to indicate that this segment defines the start of a new frame.
      *
-     *        Bit  15         Bit 14                     Bits: 0 - 13
-     *    +--------------+--------------+--------------------------------------------------------+
-     *    |   New Frame  |  Has Message |  Length of segment (excluding the header)              |
-     *    +--------------+--------------+--------------------------------------------------------+
+     *        Bit  15         Bit 14         Bit 13                    Bits: 0 - 12
+     *    +--------------+--------------+--------------+-----------------------------------------+
+     *    |   New Frame  |  Has Message | Has Ext Data |  Length of segment (excluding the header) |
+     *    +--------------+--------------+--------------+-----------------------------------------+
      *
      * The header is encoded in big-endian (msb first) style.
 
@@ -496,6 +566,11 @@ private:
      * backward direction while the low-priority frames use the buffer in forward direction. This model ensures the
      * available buffer space is utilized efficiently between all frame types.
      *
+     * With more than two priority levels, `mBuffer` is split into regions (sized by
+     * `OPENTHREAD_SPINEL_CONFIG_BUFFER_REGION_SHARES`), each one a separate circular buffer shared by a pair of
+     * priority levels as below: even priority levels (e.g. `kPriorityLow`) use it in forward direction and odd ones
+     * (e.g. `kPriorityHigh`) in backward direction.
+     *
      *                                       mReadFrameStart[kPriorityLow]
      *                                                 |
      *                                                 |                   mWriteFrameStart[kPriorityLow]
@@ -515,6 +590,11 @@ private:
      * When frames are removed, if possible, the `mReadFrameStart` and `mWriteFrameStart` pointers of the two priority
      * levels are moved closer to avoid gaps.
      *
+     * The next output frame is picked using deficit round robin: `mScheduledPriority` visits the priority levels in
+     * turn, and on each visit the deficit of a priority level with frames is credited with its weight times
+     * `OPENTHREAD_SPINEL_CONFIG_BUFFER_QUANTUM`. Frames of the visited priority level are read while its deficit
+     * covers their length, the length of each removed frame being taken off the deficit.
+     *
      * For an output frame (frame being read), Buffer maintains a `ReadState` along with a set of pointers
      * into the buffer:
      *
@@ -571,74 +651,100 @@ private:
         kMessageReadBufferSize      = 16,     // Size of message buffer array `mMessageBuffer`.
         kUnknownFrameLength         = 0xffff, // Value used when frame length is unknown.
         kSegmentHeaderSize          = 2,      // Length of the segment header.
-        kSegmentHeaderLengthMask    = 0x3fff, // Bit mask to get the length from the segment header
+        kSegmentHeaderLengthMask    = 0x1fff, // Bit mask to get the length from the segment header
         kMaxSegments                = 10,     // Max number of segments allowed in a frame
 
-        kSegmentHeaderNoFlag               = 0,         // No flags are set.
-        kSegmentHeaderNewFrameFlag         = (1 << 15), // Indicates that this segment starts a new frame.
-        kSegmentHeaderMessageIndicatorFlag = (1 << 14), // Indicates this segment ends with a Message.
+        kSegmentHeaderNoFlag                    = 0,         // No flags are set.
+        kSegmentHeaderNewFrameFlag              = (1 << 15), // Indicates that this segment starts a new frame.
+        kSegmentHeaderMessageIndicatorFlag      = (1 << 14), // Indicates this segment ends with a Message.
+        kSegmentHeaderExternalDataIndicatorFlag = (1 << 13), // Indicates this segment ends with an external data block.
 
-        kNumPrios = (kPriorityHigh + 1), // Number of priorities.
+        kExternalDataQueueSize = OPENTHREAD_SPINEL_CONFIG_EXTERNAL_DATA_QUEUE_SIZE, // Size of an external data queue.
+
+        kNumPrios        = OPENTHREAD_SPINEL_CONFIG_BUFFER_NUM_PRIORITIES, // Number of priorities.
+        kNumRegions      = (kNumPrios / 2),                                // Number of buffer regions.
+        kUnknownPriority = 0xff,                                           // No priority (no frame being written).
+        kQuantum         = OPENTHREAD_SPINEL_CONFIG_BUFFER_QUANTUM,        // Deficit round robin quantum (in bytes).
     };
 
     enum ReadState
     {
-        kReadStateNotActive, // No current prepared output frame.
-        kReadStateInSegment, // In middle of a data segment while reading current frame.
-        kReadStateInMessage, // In middle of a message while reading current frame.
-        kReadStateDone,      // Current output frame is read fully.
+        kReadStateNotActive,  // No current prepared output frame.
+        kReadStateInSegment,  // In middle of a data segment while reading current frame.
+        kReadStateInMessage,  // In middle of a message while reading current frame.
+        kReadStateInExternal, // In middle of an external data block while reading current frame.
+        kReadStateDone,       // Current output frame is read fully.
     };
 
-    enum Direction
-    {
-        kForward  = kPriorityLow,
-        kBackward = kPriorityHigh,
-        kUnknown,
-    };
+    static bool    IsBackward(uint8_t aPriority) { return (aPriority & 1) != 0; }
+    static uint8_t GetSharingPriority(uint8_t aPriority) { return aPriority ^ 1; }
+    uint8_t *      GetRegionStart(uint8_t aPriority) const { return mRegionStart[aPriority / 2]; }
+    uint8_t *      GetRegionEnd(uint8_t aPriority) const { return mRegionStart[aPriority / 2 + 1]; }
 
-    uint8_t *GetUpdatedBufPtr(uint8_t *aBufPtr, uint16_t aOffset, Direction aDirection) const;
-    uint16_t GetDistance(const uint8_t *aStartPtr, const uint8_t *aEndPtr, Direction aDirection) const;
+    uint8_t *GetUpdatedBufPtr(uint8_t *aBufPtr, uint16_t aOffset, uint8_t aPriority) const;
+    uint16_t GetDistance(const uint8_t *aStartPtr, const uint8_t *aEndPtr, uint8_t aPriority) const;
 
-    uint16_t ReadUint16At(uint8_t *aBufPtr, Direction aDirection);
-    void     WriteUint16At(uint8_t *aBufPtr, uint16_t aValue, Direction aDirection);
+    uint16_t ReadUint16At(uint8_t *aBufPtr, uint8_t aPriority);
+    void     WriteUint16At(uint8_t *aBufPtr, uint16_t aValue, uint8_t aPriority);
 
-    bool HasFrame(Priority aPriority) const;
+    bool HasFrame(uint8_t aPriority) const;
     void UpdateReadWriteStartPointers(void);
 
     otError InFrameAppend(uint8_t aByte);
     otError InFrameBeginSegment(void);
     void    InFrameEndSegment(uint16_t aSegmentHeaderFlags);
     void    InFrameDiscard(void);
-    bool    InFrameIsWriting(Priority aPriority) const;
+    bool    InFrameIsWriting(uint8_t aPriority) const;
 
-    void    OutFrameSelectReadDirection(void);
-    otError OutFramePrepareSegment(void);
-    void    OutFrameMoveToNextSegment(void);
+    void     OutFrameSelectReadPriority(void);
+    uint16_t OutFrameGetLength(uint8_t aPriority);
+    otError  OutFramePrepareSegment(void);
+    void     OutFrameMoveToNextSegment(void);
+    otError  OutFramePrepareAppended(void);
 
 #if OPENTHREAD_SPINEL_CONFIG_OPENTHREAD_MESSAGE_ENABLE
     otError OutFramePrepareMessage(void);
     otError OutFrameFillMessageBuffer(void);
 #endif
 
-    uint8_t *const mBuffer;       // Pointer to the buffer used to store the data.
-    uint8_t *const mBufferEnd;    // Points to after the end of buffer.
-    const uint16_t mBufferLength; // Length of the buffer.
+#if OPENTHREAD_SPINEL_CONFIG_EXTERNAL_DATA_QUEUE_SIZE
+    struct ExternalData
+    {
+        const uint8_t *          mData;         // Pointer to the data block.
+        uint16_t                 mLength;       // Length of the data block.
+        ExternalDataFreeCallback mFreeCallback; // Callback to release the data block.
+        void *                   mContext;      // Context passed to `mFreeCallback`.
+    };
+
+    ExternalData &GetExternalData(uint8_t aPriority, uint8_t aIndex);
+    void          FreeExternalData(uint8_t aPriority);
+    otError       OutFramePrepareExternalData(void);
+#endif
+
+    uint8_t *const mBuffer;                       // Pointer to the buffer used to store the data.
+    uint8_t *const mBufferEnd;                    // Points to after the end of buffer.
+    const uint16_t mBufferLength;                 // Length of the buffer.
+    uint8_t *      mRegionStart[kNumRegions + 1]; // Start of each region (followed by end of last region).
 
     BufferCallback mFrameAddedCallback;   // Callback to signal when a new frame is added
     void *         mFrameAddedContext;    // Context passed to `mFrameAddedCallback`.
     BufferCallback mFrameRemovedCallback; // Callback to signal when a frame is removed.
     void *         mFrameRemovedContext;  // Context passed to `mFrameRemovedCallback`.
 
-    Direction mWriteDirection;             // Direction (priority) for current frame being read.
+    uint8_t   mWritePriority;              // Priority for current frame being written.
     uint8_t * mWriteFrameStart[kNumPrios]; // Pointer to start of current frame being written.
     uint8_t * mWriteSegmentHead;           // Pointer to start of current segment in the frame being written.
     uint8_t * mWriteSegmentTail;           // Pointer to end of current segment in the frame being written.
     FrameTag  mWriteFrameTag;              // Tag associated with last successfully written frame.
 
-    Direction mReadDirection;   // Direction (priority) for current frame being read.
+    uint8_t   mReadPriority;    // Priority for current frame being read.
     ReadState mReadState;       // Read state.
     uint16_t  mReadFrameLength; // Length of current frame being read.
 
+    uint8_t  mScheduledPriority;  // Priority level currently visited by deficit round robin.
+    bool     mScheduledCredited;  // Whether the visited priority level got its credit for this visit.
+    uint32_t mDeficit[kNumPrios]; // Deficit round robin counters (in bytes).
+
     uint8_t *mReadFrameStart[kNumPrios]; // Pointer to start of current frame being read.
     uint8_t *mReadSegmentHead;           // Pointer to start of current segment in the frame being read.
     uint8_t *mReadSegmentTail;           // Pointer to end of current segment in the frame being read.
@@ -652,6 +758,15 @@ private:
     uint8_t        mMessageBuffer[kMessageReadBufferSize]; // Buffer to hold part of current message being read.
     uint8_t *      mReadMessageTail;                       // Pointer to end of current part in mMessageBuffer.
 #endif
+
+#if OPENTHREAD_SPINEL_CONFIG_EXTERNAL_DATA_QUEUE_SIZE
+    ExternalData   mExternalData[kNumPrios][kExternalDataQueueSize]; // Circular external data queues.
+    uint8_t        mExternalDataHead[kNumPrios];  // Index of first entry in each external data queue.
+    uint8_t        mExternalDataCount[kNumPrios]; // Number of entries owned by finished frames in each queue.
+    uint8_t        mWriteFrameExternalDataCount;  // Number of entries added by the current frame being written.
+    uint8_t        mReadExternalDataIndex;        // Number of entries reached in the current frame being read.
+    const uint8_t *mReadExternalDataTail;         // Pointer to end of current external data block being read.
+#endif
 };
 
 } // namespace Spinel
@@ -121,6 +121,44 @@ public:
      */
     otError BeginFrame(uint8_t aHeader, unsigned int aCommand, spinel_prop_key_t aKey);
 
+    /**
+     * This method begins a new spinel command frame with a given priority level to be added/written to the frame
+     * buffer.
+     *
+     * If there is a previous frame being written (for which `EndFrame()` has not yet been called), calling
+     * `BeginFrame()` will discard and clear the previous unfinished frame.
+     *
+     * @param[in] aPriority             Priority level of the new input frame.
+     * @param[in] aHeader               Spinel header for new the command frame.
+     * @param[in] aCommand              Spinel command.
+     *
+     * @retval OT_ERROR_NONE            Successfully started a new frame.
+     * @retval OT_ERROR_NO_BUFS         Insufficient buffer space available to start a new frame.
+     *
+     */
+    otError BeginFrame(Spinel::Buffer::Priority aPriority, uint8_t aHeader, unsigned int aCommand);
+
+    /**
+     * This method begins a new spinel property update command frame with a given priority level to be added/written
+     * to the frame buffer.
+     *
+     * This method behaves as `BeginFrame(aHeader, aCommand, aKey)` except that the priority level of the frame is
+     * given instead of being determined from the spinel transaction ID.
+     *
+     * @param[in] aPriority             Priority level of the new input frame.
+     * @param[in] aHeader               Spinel header for new the command frame.
+     * @param[in] aCommand              Spinel command.
+     * @param[in] aKey                  Spinel property key
+     *
+     * @retval OT_ERROR_NONE            Successfully started a new frame.
+     * @retval OT_ERROR_NO_BUFS         Insufficient buffer space available to start a new frame.
+     *
+     */
+    otError BeginFrame(Spinel::Buffer::Priority aPriority,
+                       uint8_t                  aHeader,
+                       unsigned int             aCommand,
+                       spinel_prop_key_t        aKey);
+
     /**
      * This method overwrites the property key with `LAST_STATUS` in a property update command frame.
      *
@@ -567,6 +605,42 @@ public:
     otError WriteMessage(otMessage *aMessage) { return mNcpBuffer.InFrameFeedMessage(aMessage); }
 #endif
 
+#if OPENTHREAD_SPINEL_CONFIG_EXTERNAL_DATA_QUEUE_SIZE
+    /**
+     * This method adds an external data block to the current input frame by reference (without copying it).
+     *
+     * Before using this method `BeginFrame()` must be called to start and prepare a new input frame. Otherwise, this
+     * method does nothing and returns error status `OT_ERROR_INVALID_STATE`.
+     *
+     * If no buffer space is available, this method will discard and clear the frame and return error status
+     * `OT_ERROR_NO_BUFS`.
+     *
+     * The data block must stay valid and unchanged until it is released. The ownership of the data block changes to
+     * underlying `Spinel::Buffer` ONLY when the entire frame is successfully finished (i.e., with a successful call to
+     * `EndFrame()` for the current frame being written), and in this case @p aFreeCallback is invoked once the frame
+     * is removed from the `Spinel::Buffer`. However, if the frame gets discarded before it is finished, the data block
+     * remains owned by the caller.
+     *
+     * @param[in] aData                 A pointer to the data block.
+     * @param[in] aLength               The length of the data block.
+     * @param[in] aFreeCallback         Callback invoked to release the data block.
+     * @param[in] aContext              A pointer to arbitrary context passed to @p aFreeCallback.
+     *
+     * @retval OT_ERROR_NONE            Successfully added the data block to the frame.
+     * @retval OT_ERROR_NO_BUFS         Insufficient buffer space available to add the data block.
+     * @retval OT_ERROR_INVALID_STATE   `BeginFrame()` has not been called earlier to start the frame.
+     * @retval OT_ERROR_INVALID_ARGS    If @p aData or @p aFreeCallback is NULL.
+     *
+     */
+    otError WriteExternalData(const uint8_t *                  aData,
+                              uint16_t                         aLength,
+                              Buffer::ExternalDataFreeCallback aFreeCallback,
+                              void *                           aContext)
+    {
+        return mNcpBuffer.InFrameFeedExternalData(aData, aLength, aFreeCallback, aContext);
+    }
+#endif
+
     /**
      * This method encodes and writes a set of variables to the current input frame using a given spinel packing format
      * string.
@@ -80,6 +80,7 @@ private:
     enum
     {
         kUartTxBufferSize = CONFIG_NCP_UART_TX_CHUNK_SIZE,   // Uart tx buffer size.
+        kTxReadChunkSize  = 64,                              // Bytes read at a time from tx frame buffer.
         kRxBufferSize     = CONFIG_NCP_UART_RX_BUFFER_SIZE + // Rx buffer size (should be large enough to fit
                         CONFIG_NCP_SPINEL_ENCRYPTER_EXTRA_DATA_SIZE, // one whole (decoded) received frame).
     };
@@ -107,8 +108,9 @@ private:
         bool    IsEmpty(void) const;
         otError OutFrameBegin(void);
         bool    OutFrameHasEnded(void);
-        uint8_t OutFrameReadByte(void);
-        otError OutFrameRemove(void);
+        uint8_t  OutFrameReadByte(void);
+        uint16_t OutFrameRead(uint16_t aReadLength, uint8_t *aDataBuffer);
+        otError  OutFrameRemove(void);
 
     private:
         void Reset(void);
@@ -137,7 +139,9 @@ private:
     Hdlc::Decoder                        mFrameDecoder;
     Hdlc::FrameBuffer<kUartTxBufferSize> mUartBuffer;
     UartTxState                          mState;
-    uint8_t                              mByte;
+    uint8_t                              mTxChunk[kTxReadChunkSize];
+    uint8_t                              mTxChunkLength;
+    uint8_t                              mTxChunkOffset;
     Hdlc::FrameBuffer<kRxBufferSize>     mRxBuffer;
     bool                                 mUartSendImmediate;
     //mv Tasklet                              mUartSendTask;
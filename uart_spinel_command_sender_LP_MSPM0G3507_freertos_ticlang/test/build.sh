@@ -0,0 +1,41 @@
+#!/bin/sh
+#
+# Builds the host tests of the NCP sources of this app and runs them.
+#
+#   test/build.sh [build directory]
+#
+# Headers that are not part of this app are taken from the ti_wisunfan and
+# mbed copies in tasklet_ncp_example.
+
+set -e
+
+APP=$(cd "$(dirname "$0")/.." && pwd)
+OUT=${1:-$APP/test/build}
+TI=$APP/../tasklet_ncp_example/ti_wisunfan/ti_wisunfan
+MBED=$APP/../tasklet_ncp_example/mbed/mbed
+
+INC="-I$APP/wisun_ncp/src -I$APP/wisun_ncp/src/core -I$APP/wisun_ncp/src/ncp -I$APP/wisun_ncp/src/lib/spinel
+     -I$MBED/nanostack/sal-stack-nanostack-eventloop/nanostack-event-loop
+     -I$TI/ncp_interface/src/core -I$TI/ncp_interface/src -I$TI/ncp_interface/include -I$TI/ncp_interface/config -I$TI/ncp_interface/examples/ncp_ftd
+     -I$TI/ncp_interface -I$TI -I$TI/application -I$TI/apps/common/include
+     -I$TI/wisunfan_mac/high_level -I$TI/wisunfan_mac/services/saddr -I$TI/wisunfan_mac/common/osal_port
+     -I$MBED/nanostack/mbed-mesh-api -I$MBED/frameworks/nanostack-libservice/mbed-client-libservice
+     -I$MBED/nanostack/sal-stack-nanostack/nanostack"
+DEFS="-DMCU_HOST -DEXCLUDE_TRACE -DWISUN_NCP_ENABLE -DOPENTHREAD_CONFIG_NCP_UART_ENABLE=1"
+
+mkdir -p "$OUT"
+
+for src in ncp/ncp_base.cpp ncp/ncp_base_dispatcher.cpp ncp/changed_props_set.cpp lib/spinel/spinel_buffer.cpp \
+           lib/spinel/spinel_encoder.cpp lib/spinel/spinel_decoder.cpp core/common/string.cpp
+do
+    g++ -std=c++11 -g -O1 -w $DEFS $INC -c "$APP/wisun_ncp/src/$src" -o "$OUT/$(basename "$src").o"
+done
+
+gcc -g -O1 -w $DEFS $INC -c "$APP/wisun_ncp/src/lib/spinel/spinel.c" -o "$OUT/spinel.o"
+g++ -std=c++11 -g -O1 -Wall $DEFS $INC -c "$APP/test/ncp_host_request_test.cpp" -o "$OUT/ncp_host_request_test.o"
+g++ -o "$OUT/ncp_host_request_test" "$OUT"/*.o
+
+for seed in 1 2 3 4 5
+do
+    "$OUT/ncp_host_request_test" $seed
+done
@@ -0,0 +1,463 @@
+/*
+ * Copyright (c) 2026, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   Host test of the MCU_HOST command pipelining in NcpBase.
+ *
+ *   The real ncp_base.cpp is linked against a simulated event timer and a
+ *   simulated NWP. The NWP answers each copy of a command with
+ *   PROP_VALUE_IS on the same TID after a random delay, and drops some
+ *   answers or delays them past the command timeout, so commands are sent
+ *   again and answered twice. The test checks that every command completes
+ *   exactly once, and never with the answer to another command. Some of the
+ *   commands set SPINEL_PROP_STREAM_NET, which must never be sent twice.
+ *
+ *   ncp_host_request_test [seed] [ticks] [percent of late answers]
+ *
+ *   Build and run with test/build.sh.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <deque>
+#include <vector>
+
+#include "ncp/ncp_base.hpp"
+#include "eventOS_event_timer.h"
+#include "openthread/message.h"
+#include "openthread/instance.h"
+#include "openthread/platform/alarm-milli.h"
+#include "openthread/platform/misc.h"
+
+using namespace ot;
+using namespace ot::Ncp;
+
+enum
+{
+    kTimeoutTicks = (CONFIG_NCP_HOST_REQUEST_TIMEOUT_MS + 9) / 10,
+    kPropBase     = 0x3c00, // Spinel vendor range, the simulated NWP answers any property.
+    kPropSpan     = 1024,
+};
+
+// MARK: Simulated event timer
+
+static uint32_t sNow;
+
+struct TestTimeout
+{
+    void (*mCallback)(void *);
+    void *   mArg;
+    uint32_t mAt;
+    bool     mActive;
+};
+
+static TestTimeout sTimeouts[4];
+
+extern "C" uint32_t eventOS_event_timer_ticks(void)
+{
+    return sNow;
+}
+
+extern "C" timeout_t *eventOS_timeout_ms(void (*callback)(void *), uint32_t ms, void *arg)
+{
+    for (TestTimeout &t : sTimeouts)
+    {
+        if (!t.mActive)
+        {
+            t.mCallback = callback;
+            t.mArg      = arg;
+            t.mAt       = sNow + eventOS_event_timer_ms_to_ticks(ms);
+            t.mActive   = true;
+            return reinterpret_cast<timeout_t *>(&t);
+        }
+    }
+
+    fprintf(stderr, "out of timeouts\n");
+    exit(2);
+}
+
+static void RunTimeouts(void)
+{
+    for (TestTimeout &t : sTimeouts)
+    {
+        if (t.mActive && TICKS_BEFORE_OR_AT(t.mAt, sNow))
+        {
+            t.mActive = false;
+            t.mCallback(t.mArg);
+        }
+    }
+}
+
+// MARK: Unused platform
+
+extern "C" void platformNcpSendAsyncRspSignal(void) {}
+extern "C" uint32_t otPlatAlarmMilliGetNow(void)
+{
+    return sNow * 10;
+}
+extern "C" otPlatResetReason otPlatGetResetReason(otInstance *)
+{
+    return OT_PLAT_RESET_REASON_POWER_ON;
+}
+extern "C" void     otInstanceReset(otInstance *) {}
+extern "C" void     otMessageFree(otMessage *) {}
+extern "C" uint16_t otMessageGetLength(const otMessage *)
+{
+    return 0;
+}
+extern "C" uint16_t otMessageRead(const otMessage *, uint16_t, void *, uint16_t)
+{
+    return 0;
+}
+extern "C" void    otMessageQueueInit(otMessageQueue *) {}
+extern "C" otError otMessageQueueEnqueue(otMessageQueue *, otMessage *)
+{
+    return OT_ERROR_NONE;
+}
+extern "C" otError otMessageQueueDequeue(otMessageQueue *, otMessage *)
+{
+    return OT_ERROR_NONE;
+}
+extern "C" otMessage *otMessageQueueGetHead(otMessageQueue *)
+{
+    return NULL;
+}
+extern "C" otMessage *otMessageQueueGetNext(otMessageQueue *, const otMessage *)
+{
+    return NULL;
+}
+
+// MARK: Simulated NWP
+
+struct NwpResponse
+{
+    uint32_t mAt;
+    uint8_t  mTid;
+    uint32_t mPropKey;
+};
+
+static std::vector<NwpResponse> sNwpResponses;
+static uint32_t                 sNwpPropOnTid[16]; // Property of the last command on each TID.
+static unsigned long            sNwpCommands;
+static unsigned long            sNwpRetries;
+static unsigned long            sNwpLateResponses;  // Answers after the command completed.
+static unsigned long            sNwpStaleResponses; // Answers after a newer command was sent on the TID.
+static std::vector<uint8_t>     sNwpFrameCopies;    // Copies of each STREAM_NET command, by request id.
+static unsigned long            sNwpResentFrames;
+static unsigned                 sDropPercent = 3;
+static unsigned                 sLatePercent = 5;
+
+static uint32_t NwpDelay(void)
+{
+    unsigned r = rand() % 100;
+
+    if (r < sLatePercent)
+    {
+        // Past the timeout. Together with the time in the NCP buffer this stays under two timeouts,
+        // later answers are not covered by the TID quarantine.
+        return kTimeoutTicks + 1 + rand() % (kTimeoutTicks * 3 / 4);
+    }
+
+    if (r < sLatePercent + 15)
+    {
+        return 5 + rand() % kTimeoutTicks;
+    }
+
+    return 1 + rand() % 5;
+}
+
+static void NwpReceive(const uint8_t *aFrame, uint16_t aLength)
+{
+    uint8_t      header;
+    unsigned int command;
+    unsigned int propKey;
+    uint8_t      tid;
+    const void * data;
+    unsigned int dataLen;
+    uint32_t     id;
+
+    if (spinel_datatype_unpack(aFrame, aLength, "Cii", &header, &command, &propKey) <= 0)
+    {
+        return;
+    }
+
+    if (command == SPINEL_CMD_PROP_VALUE_SET && propKey == SPINEL_PROP_STREAM_NET)
+    {
+        if (spinel_datatype_unpack(aFrame, aLength, "Ciid", &header, &command, &propKey, &data, &dataLen) <= 0 ||
+            dataLen != sizeof(id))
+        {
+            fprintf(stderr, "bad STREAM_NET frame\n");
+            exit(2);
+        }
+
+        memcpy(&id, data, sizeof(id));
+
+        if (sNwpFrameCopies[id]++ != 0)
+        {
+            sNwpResentFrames++;
+        }
+    }
+    else if (command != SPINEL_CMD_PROP_VALUE_GET)
+    {
+        return;
+    }
+
+    tid = SPINEL_HEADER_GET_TID(header);
+
+    if (tid == 0)
+    {
+        fprintf(stderr, "command sent with TID 0\n");
+        exit(2);
+    }
+
+    sNwpCommands++;
+
+    if (sNwpPropOnTid[tid] == propKey)
+    {
+        sNwpRetries++;
+    }
+
+    sNwpPropOnTid[tid] = propKey;
+
+    if (static_cast<unsigned>(rand() % 100) >= sDropPercent)
+    {
+        sNwpResponses.push_back({sNow + NwpDelay(), tid, propKey});
+    }
+}
+
+// MARK: NCP under test
+
+class TestNcp : public NcpBase
+{
+public:
+    explicit TestNcp(Instance *aInstance)
+        : NcpBase(aInstance)
+    {
+    }
+
+    // Moves up to `aMaxFrames` frames from the NCP buffer to the NWP, like a slow UART.
+    void DrainTx(unsigned aMaxFrames)
+    {
+        uint8_t  frame[CONFIG_NCP_TX_BUFFER_SIZE];
+        uint16_t length;
+
+        while (aMaxFrames-- > 0 && !mTxFrameBuffer.IsEmpty())
+        {
+            mTxFrameBuffer.OutFrameBegin();
+            length = mTxFrameBuffer.OutFrameRead(sizeof(frame), frame);
+            mTxFrameBuffer.OutFrameRemove();
+            NwpReceive(frame, length);
+        }
+    }
+
+    void DeliverNwpResponses(void)
+    {
+        uint8_t frame[16];
+        int     length;
+
+        for (size_t i = 0; i < sNwpResponses.size();)
+        {
+            NwpResponse response = sNwpResponses[i];
+
+            if (TICKS_AFTER(response.mAt, sNow))
+            {
+                i++;
+                continue;
+            }
+
+            sNwpResponses.erase(sNwpResponses.begin() + i);
+
+            if (!mHostRequests[response.mTid - 1].mIsInUse)
+            {
+                sNwpLateResponses++;
+            }
+            else if (sNwpPropOnTid[response.mTid] != response.mPropKey)
+            {
+                sNwpStaleResponses++;
+            }
+
+            length = spinel_datatype_pack(frame, sizeof(frame), "Cii", SPINEL_HEADER_FLAG | response.mTid,
+                                          SPINEL_CMD_PROP_VALUE_IS, response.mPropKey);
+            HandleReceive(frame, static_cast<uint16_t>(length));
+        }
+    }
+};
+
+// MARK: Host application
+
+enum RequestState
+{
+    kUnused,
+    kPending,
+    kDone,
+};
+
+// The value of a STREAM_NET set, laid out as `WriteHostRequestValue()` expects.
+struct TestFrame
+{
+    uint16_t mLength;
+    uint8_t  mData[4];
+};
+
+static std::vector<uint8_t> sRequests;
+static std::deque<TestFrame> sFrames; // Does not move its elements, the NCP holds pointers to them.
+static unsigned long        sCompleted;
+static unsigned long        sTimedOut;
+static unsigned long        sRejected;
+static unsigned long        sMisdelivered;
+static unsigned long        sDoubleCompleted;
+
+static bool IsFrameRequest(size_t aId)
+{
+    return (aId % 5) == 0;
+}
+
+static spinel_prop_key_t RequestPropKey(size_t aId)
+{
+    return IsFrameRequest(aId) ? SPINEL_PROP_STREAM_NET : static_cast<spinel_prop_key_t>(kPropBase + aId % kPropSpan);
+}
+
+static void HandleRequestDone(void *            aContext,
+                              otError           aError,
+                              spinel_prop_key_t aPropKey,
+                              const uint8_t *   aValuePtr,
+                              uint16_t          aValueLen)
+{
+    size_t id = reinterpret_cast<size_t>(aContext);
+
+    OT_UNUSED_VARIABLE(aValuePtr);
+    OT_UNUSED_VARIABLE(aValueLen);
+
+    if (sRequests[id] != kPending)
+    {
+        sDoubleCompleted++;
+        return;
+    }
+
+    sRequests[id] = kDone;
+    sCompleted++;
+
+    if (aError == OT_ERROR_RESPONSE_TIMEOUT)
+    {
+        sTimedOut++;
+    }
+    else if (aError != OT_ERROR_NONE || aPropKey != RequestPropKey(id))
+    {
+        sMisdelivered++;
+    }
+}
+
+static void SendRequest(TestNcp &aNcp)
+{
+    size_t       id      = sRequests.size();
+    unsigned int command = SPINEL_CMD_PROP_VALUE_GET;
+    const void * value   = NULL;
+
+    sRequests.push_back(kPending);
+    sNwpFrameCopies.push_back(0);
+
+    if (IsFrameRequest(id))
+    {
+        uint32_t data = static_cast<uint32_t>(id);
+
+        sFrames.push_back(TestFrame());
+        sFrames.back().mLength = sizeof(data);
+        memcpy(sFrames.back().mData, &data, sizeof(data));
+
+        command = SPINEL_CMD_PROP_VALUE_SET;
+        value   = &sFrames.back();
+    }
+
+    if (aNcp.SendHostRequest(command, RequestPropKey(id), value, &HandleRequestDone, reinterpret_cast<void *>(id)) !=
+        OT_ERROR_NONE)
+    {
+        sRequests[id] = kUnused;
+        sRejected++;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    static uint64_t instanceStorage[8];
+    unsigned        seed  = (argc > 1) ? static_cast<unsigned>(atoi(argv[1])) : 1;
+    uint32_t        ticks = (argc > 2) ? static_cast<uint32_t>(atoi(argv[2])) : 200000;
+    unsigned long   pending;
+
+    if (argc > 3)
+    {
+        sLatePercent = static_cast<unsigned>(atoi(argv[3]));
+    }
+
+    srand(seed);
+
+    // The NCP does not touch the instance in MCU_HOST builds.
+    TestNcp ncp(reinterpret_cast<Instance *>(instanceStorage));
+
+    // Start the clock near the wrap of the tick counter.
+    sNow = 0xffffffffu - 1000;
+
+    for (uint32_t i = 0; i < ticks + 20 * kTimeoutTicks; i++)
+    {
+        sNow++;
+        RunTimeouts();
+        ncp.DeliverNwpResponses();
+
+        // Bursts of commands, often more than fit in flight or in the queue.
+        if (i < ticks && rand() % 8 == 0)
+        {
+            for (int n = rand() % 12; n > 0; n--)
+            {
+                SendRequest(ncp);
+            }
+        }
+
+        ncp.DrainTx(static_cast<unsigned>(rand() % 8));
+    }
+
+    pending = 0;
+
+    for (uint8_t state : sRequests)
+    {
+        pending += (state == kPending);
+    }
+
+    printf("seed %u: %lu commands, %lu sent (%lu again), %lu answers after completion, %lu on a reused TID\n", seed,
+           static_cast<unsigned long>(sRequests.size()), sNwpCommands, sNwpRetries, sNwpLateResponses,
+           sNwpStaleResponses);
+    printf("completed %lu, timed out %lu, rejected %lu, pending %lu, misdelivered %lu, completed twice %lu, "
+           "STREAM_NET sent twice %lu\n",
+           sCompleted, sTimedOut, sRejected, pending, sMisdelivered, sDoubleCompleted, sNwpResentFrames);
+
+    return (pending != 0 || sMisdelivered != 0 || sDoubleCompleted != 0 || sNwpResentFrames != 0) ? 1 : 0;
+}
@@ -184,7 +184,10 @@ void platformUartSignal(uintptr_t arg)
  */
 void mainThread(void *arg0)
 {
-    bool up = 1;
+    /* The NET_IF_UP command may be sent again if the NWP does not respond,
+     * so the value must outlive this thread. NET_STACK_UP is not sent again,
+     * give the NWP time to bring the interface up first. */
+    static bool up = 1;
     mesh_system_init();
     eventOS_event_handler_create(
     &ncp_tasklet,
@@ -51,6 +51,10 @@
 #include "nvocmp.h"
 #endif
 
+#ifdef MCU_HOST
+#include "eventOS_event_timer.h"
+#endif
+
 #define GET_NWP_PROP 0
 #define SET_NWP_PROP 1
 
@@ -208,6 +212,14 @@ NcpBase::NcpBase(Instance *aInstance)
     , mNextExpectedTid(0)
     , mResponseQueueHead(0)
     , mResponseQueueTail(0)
+#ifdef MCU_HOST
+    , mHostRequestQueueHead(0)
+    , mHostRequestQueueCount(0)
+    , mHostInFlightCount(0)
+    , mHostLastTid(0)
+    , mHostQuarantinedTids(0)
+    , mHostRequestTimer(NULL)
+#endif
     , mAllowLocalNetworkDataChange(false)
     , mRequireJoinExistingNetwork(false)
     , mIsRawStreamEnabled(false)
@@ -242,6 +254,11 @@ NcpBase::NcpBase(Instance *aInstance)
     mTxFrameBuffer.SetFrameRemovedCallback(&NcpBase::HandleFrameRemovedFromNcpBuffer, this);
 
     memset(&mResponseQueue, 0, sizeof(mResponseQueue));
+#ifdef MCU_HOST
+    memset(&mHostRequests, 0, sizeof(mHostRequests));
+    memset(&mHostRequestQueue, 0, sizeof(mHostRequestQueue));
+    memset(&mHostTidIdleUntil, 0, sizeof(mHostTidIdleUntil));
+#endif
 
     otMessageQueueInit(&mMessageQueue);
 
@@ -401,6 +418,10 @@ void NcpBase::HandleFrameRemovedFromNcpBuffer(Spinel::Buffer::FrameTag aFrameTag
 
     SuccessOrExit(SendQueuedResponses());
 
+#ifdef MCU_HOST
+    SuccessOrExit(SendQueuedHostRequests());
+#endif
+
     // Check if `HOST_POWER_STATE` property update is required.
 
     if (mHostPowerStateHeader)
@@ -836,22 +857,37 @@ extern "C" void platformNcpSendAsyncProcess()
 
 #ifdef MCU_HOST
 
-// Right now the NCP_PREP_CMD_EVENT just gets the selected property
-// This function is currently called by the application layer
-extern "C" void platformNcpPrepCmdProcess(uint8_t commandType, spinel_prop_key_t commandProp, void* newValue)
+// Sends a get or set property command to the nwp, the callback is called with the response.
+// This function is called by the application layer from the NCP tasklet
+extern "C" otError platformNcpSendCmd(uint8_t                      commandType,
+                                      spinel_prop_key_t            commandProp,
+                                      void *                       newValue,
+                                      NcpBase::HostRequestCallback callback,
+                                      void *                       context)
 {
     NcpBase *ncp = NcpBase::GetNcpInstance();
+    otError  error;
+
     switch(commandType)
     {
         case GET_NWP_PROP:
-            ncp->WriteCommandGetProperty(commandProp);
+            error = ncp->SendHostRequest(SPINEL_CMD_PROP_VALUE_GET, commandProp, NULL, callback, context);
             break;
         case SET_NWP_PROP:
-            ncp->WriteCommandSetProperty(commandProp, newValue);
+            error = ncp->SendHostRequest(SPINEL_CMD_PROP_VALUE_SET, commandProp, newValue, callback, context);
             break;
         default:
+            error = OT_ERROR_INVALID_ARGS;
             break;
     }
+
+    return error;
+}
+
+// Handles the NCP_PREP_CMD_EVENT, which gets or sets the selected property without waiting for the response
+extern "C" void platformNcpPrepCmdProcess(uint8_t commandType, spinel_prop_key_t commandProp, void* newValue)
+{
+    IgnoreReturnValue(platformNcpSendCmd(commandType, commandProp, newValue, NULL, NULL));
 }
 #endif
 
@@ -883,6 +919,15 @@ otError NcpBase::HandleCommand(uint8_t aHeader)
         error = CommandHandler_PROP_VALUE_update(aHeader, command);
         break;
 
+#ifdef MCU_HOST
+    case SPINEL_CMD_PROP_VALUE_IS:
+    case SPINEL_CMD_PROP_VALUE_INSERTED:
+    case SPINEL_CMD_PROP_VALUE_REMOVED:
+        // Responses and updates from the nwp are never answered.
+        HandleHostResponse(aHeader);
+        break;
+#endif
+
 #if CONFIG_NCP_ENABLE_PEEK_POKE
     case SPINEL_CMD_PEEK:
         error = CommandHandler_PEEK(aHeader);
@@ -1065,68 +1110,353 @@ otError NcpBase::CommandHandler_NV_ERASE(uint8_t aHeader)
 // MARK: Outbound Frame Methods
 // ----------------------------------------------------------------------------
 #ifdef MCU_HOST
-uint8_t mcu_host_tid = 0;
 
-// Prepares the outbound buffer with a Get Prop command to send to the nwp
-otError NcpBase::WriteCommandGetProperty(spinel_prop_key_t prop_key)
+OT_STATIC_ASSERT(CONFIG_NCP_HOST_MAX_IN_FLIGHT >= 1 && CONFIG_NCP_HOST_MAX_IN_FLIGHT <= 15,
+                 "CONFIG_NCP_HOST_MAX_IN_FLIGHT must be between 1 and 15");
+
+otError NcpBase::SendHostRequest(unsigned int        aCommand,
+                                 spinel_prop_key_t   aPropKey,
+                                 const void *        aValue,
+                                 HostRequestCallback aCallback,
+                                 void *              aContext)
+{
+    otError      error = OT_ERROR_NONE;
+    HostRequest *request;
+
+    VerifyOrExit(mHostRequestQueueCount < kHostRequestQueueSize, error = OT_ERROR_NO_BUFS);
+
+    request = &mHostRequestQueue[(mHostRequestQueueHead + mHostRequestQueueCount) % kHostRequestQueueSize];
+
+    request->mValue       = aValue;
+    request->mCallback    = aCallback;
+    request->mContext     = aContext;
+    request->mDeadline    = 0;
+    request->mPropKey     = aPropKey;
+    request->mCommand     = static_cast<uint8_t>(aCommand);
+    request->mRetriesLeft = IsHostRequestIdempotent(request->mCommand, aPropKey) ? CONFIG_NCP_HOST_REQUEST_RETRIES : 0;
+    request->mIsResent    = false;
+    request->mIsInUse     = true;
+
+    mHostRequestQueueCount++;
+
+    // If NCP buffer is full, the request is sent from `HandleFrameRemovedFromNcpBuffer()` instead.
+    IgnoreReturnValue(SendQueuedHostRequests());
+
+exit:
+    return error;
+}
+
+otError NcpBase::SendQueuedHostRequests(void)
+{
+    otError      error = OT_ERROR_NONE;
+    uint32_t     now   = eventOS_event_timer_ticks();
+    spinel_tid_t tid;
+    uint8_t      i;
+
+    while ((mHostRequestQueueCount > 0) && (mHostInFlightCount < kHostMaxInFlight))
+    {
+        HostRequest &request = mHostRequestQueue[mHostRequestQueueHead];
+
+        // Take the TIDs in turn rather than the lowest free one, and skip quarantined ones, so that a
+        // late response to an earlier request is not taken for the response to a new one.
+
+        tid = mHostLastTid;
+
+        for (i = 0; i < kHostMaxTid; i++)
+        {
+            tid = SPINEL_GET_NEXT_TID(tid);
+
+            if (IsHostTidFree(tid, now))
+            {
+                break;
+            }
+        }
+
+        // All free TIDs are quarantined, the timer sends the request once one of them is free.
+        VerifyOrExit(i < kHostMaxTid, OT_NOOP);
+
+        SuccessOrExit(error = WriteHostRequestFrame(tid, request));
+
+        request.mDeadline = now + eventOS_event_timer_ms_to_ticks(CONFIG_NCP_HOST_REQUEST_TIMEOUT_MS);
+
+        mHostRequests[tid - 1] = request;
+        mHostLastTid           = tid;
+        mHostInFlightCount++;
+
+        request.mIsInUse      = false;
+        mHostRequestQueueHead = (mHostRequestQueueHead + 1) % kHostRequestQueueSize;
+        mHostRequestQueueCount--;
+    }
+
+exit:
+    StartHostRequestTimer();
+    return error;
+}
+
+// Only commands that leave the nwp in the same state when it handles them twice are sent again. A frame, a state
+// change or a stack start that was handled but not answered must not be repeated.
+bool NcpBase::IsHostRequestIdempotent(uint8_t aCommand, spinel_prop_key_t aPropKey)
+{
+    bool isIdempotent = (aCommand == SPINEL_CMD_PROP_VALUE_GET);
+
+    if (aCommand == SPINEL_CMD_PROP_VALUE_SET)
+    {
+        switch (aPropKey)
+        {
+        case SPINEL_PROP_NET_IF_UP:
+        case SPINEL_PROP_NET_NETWORK_NAME:
+        case SPINEL_PROP_HWADDR:
+        case SPINEL_PROP_PHY_CCA_THRESHOLD:
+        case SPINEL_PROP_PHY_TX_POWER:
+        case SPINEL_PROP_NET_ROLE:
+            isIdempotent = true;
+            break;
+        default:
+            break;
+        }
+    }
+
+    return isIdempotent;
+}
+
+bool NcpBase::IsHostTidFree(uint8_t aTid, uint32_t aNow)
+{
+    uint16_t mask   = static_cast<uint16_t>(1U << (aTid - 1));
+    bool     isFree = !mHostRequests[aTid - 1].mIsInUse;
+
+    if (isFree && (mHostQuarantinedTids & mask))
+    {
+        isFree = !TICKS_BEFORE(aNow, mHostTidIdleUntil[aTid - 1]);
+
+        if (isFree)
+        {
+            mHostQuarantinedTids &= ~mask;
+        }
+    }
+
+    return isFree;
+}
+
+// Keeps a TID out of use until a full timeout after `aDeadline`, or after now if that is later.
+void NcpBase::QuarantineHostTid(uint8_t aTid, uint32_t aDeadline)
+{
+    uint16_t mask = static_cast<uint16_t>(1U << (aTid - 1));
+    uint32_t now  = eventOS_event_timer_ticks();
+    uint32_t idleUntil;
+
+    if (TICKS_BEFORE(aDeadline, now))
+    {
+        aDeadline = now;
+    }
+
+    idleUntil = aDeadline + eventOS_event_timer_ms_to_ticks(CONFIG_NCP_HOST_REQUEST_TIMEOUT_MS);
+
+    if (!(mHostQuarantinedTids & mask) || TICKS_AFTER(idleUntil, mHostTidIdleUntil[aTid - 1]))
+    {
+        mHostTidIdleUntil[aTid - 1] = idleUntil;
+    }
+
+    mHostQuarantinedTids |= mask;
+}
+
+otError NcpBase::WriteHostRequestFrame(uint8_t aTid, const HostRequest &aRequest)
 {
     otError error = OT_ERROR_NONE;
-    mcu_host_tid = SPINEL_GET_NEXT_TID(mcu_host_tid);
-    uint8_t header = SPINEL_HEADER_FLAG | mcu_host_tid;
 
-    SuccessOrExit(error = mEncoder.BeginFrame(header, SPINEL_CMD_PROP_VALUE_GET, prop_key));
+    SuccessOrExit(error = mEncoder.BeginFrame(SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0 | aTid, aRequest.mCommand,
+                                              aRequest.mPropKey));
+
+    if (aRequest.mCommand == SPINEL_CMD_PROP_VALUE_SET)
+    {
+        SuccessOrExit(error = WriteHostRequestValue(aRequest.mPropKey, aRequest.mValue));
+    }
+
     SuccessOrExit(error = mEncoder.EndFrame());
 
-    exit:
-        return error;
+exit:
+    return error;
 }
 
-// Prepares the outbound buffer with a Set Prop command to send to the nwp
-otError NcpBase::WriteCommandSetProperty(spinel_prop_key_t prop_key, void* newValue)
+// Writes the value of a Set Prop command to send to the nwp
+otError NcpBase::WriteHostRequestValue(spinel_prop_key_t aPropKey, const void *aValue)
 {
     otError error = OT_ERROR_NONE;
-    mcu_host_tid = SPINEL_GET_NEXT_TID(mcu_host_tid);
-    uint8_t header = SPINEL_HEADER_FLAG | mcu_host_tid;
-
-    error = mEncoder.BeginFrame(header, SPINEL_CMD_PROP_VALUE_SET, prop_key);
-    if (error != OT_ERROR_NONE)
-        return error;
 
-    switch(prop_key)
+    switch(aPropKey)
     {
         case SPINEL_PROP_STREAM_NET:
-            SuccessOrExit(error = mEncoder.WriteDataWithLen(((uint8_t*)newValue)+2, *((uint16_t*)newValue)));
+            SuccessOrExit(error = mEncoder.WriteDataWithLen(((const uint8_t*)aValue)+2, *((const uint16_t*)aValue)));
             break;
         case SPINEL_PROP_PROTOCOL_VERSION:
         case SPINEL_PROP_NCP_VERSION:
         case SPINEL_PROP_NET_NETWORK_NAME:
-            SuccessOrExit(error = mEncoder.WriteUtf8((const char*) newValue));
+            SuccessOrExit(error = mEncoder.WriteUtf8((const char*) aValue));
             break;
         case SPINEL_PROP_HWADDR:
-            SuccessOrExit(error = mEncoder.WriteEui64(((const uint8_t*)newValue)));
+            SuccessOrExit(error = mEncoder.WriteEui64(((const uint8_t*)aValue)));
             break;
         case SPINEL_PROP_PHY_CCA_THRESHOLD:
         case SPINEL_PROP_PHY_TX_POWER:
-            SuccessOrExit(error = mEncoder.WriteInt8(*((int8_t*)newValue)));
+            SuccessOrExit(error = mEncoder.WriteInt8(*((const int8_t*)aValue)));
             break;
         case SPINEL_PROP_NET_STATE:
-            SuccessOrExit(error = mEncoder.WriteUint8(*((uint8_t*)newValue)));
+            SuccessOrExit(error = mEncoder.WriteUint8(*((const uint8_t*)aValue)));
             break;
         case SPINEL_PROP_NET_IF_UP:
         case SPINEL_PROP_NET_STACK_UP:
         case SPINEL_PROP_NET_ROLE:
-            SuccessOrExit(error = mEncoder.WriteBool(*((bool*)newValue)));
+            SuccessOrExit(error = mEncoder.WriteBool(*((const bool*)aValue)));
             break;
         default:
             break;
-        exit:
-            return error;
-   }
+    }
 
-    SuccessOrExit(error = mEncoder.EndFrame());
+exit:
     return error;
 }
 
+void NcpBase::HandleHostResponse(uint8_t aHeader)
+{
+    spinel_tid_t   tid      = SPINEL_HEADER_GET_TID(aHeader);
+    unsigned int   propKey;
+    const uint8_t *valuePtr = NULL;
+    uint16_t       valueLen = 0;
+
+    // TID zero is used by the nwp for unsolicited updates.
+
+    VerifyOrExit(tid != 0, OT_NOOP);
+
+    if (!mHostRequests[tid - 1].mIsInUse)
+    {
+        // The second response to a command that was sent again, or a response after the timeout.
+        // Keep the TID quarantined until it has been quiet for a full timeout.
+
+        if (mHostQuarantinedTids & (1U << (tid - 1)))
+        {
+            QuarantineHostTid(tid, eventOS_event_timer_ticks());
+        }
+
+        ExitNow();
+    }
+
+    SuccessOrExit(mDecoder.ReadUintPacked(propKey));
+    SuccessOrExit(mDecoder.ReadData(valuePtr, valueLen));
+
+    CompleteHostRequest(tid, OT_ERROR_NONE, static_cast<spinel_prop_key_t>(propKey), valuePtr, valueLen);
+
+exit:
+    return;
+}
+
+void NcpBase::CompleteHostRequest(uint8_t           aTid,
+                                  otError           aError,
+                                  spinel_prop_key_t aPropKey,
+                                  const uint8_t *   aValuePtr,
+                                  uint16_t          aValueLen)
+{
+    HostRequest &       request  = mHostRequests[aTid - 1];
+    HostRequestCallback callback = request.mCallback;
+    void *              context  = request.mContext;
+
+    // Free the TID before calling back, the callback may send the next command. The nwp may still
+    // answer a command that timed out or was sent more than once, so its TID is quarantined for a
+    // full timeout after the last copy of the command would have timed out.
+
+    request.mIsInUse = false;
+    mHostInFlightCount--;
+
+    if ((aError != OT_ERROR_NONE) || request.mIsResent)
+    {
+        QuarantineHostTid(aTid, request.mDeadline);
+    }
+
+    if (callback != NULL)
+    {
+        callback(context, aError, aPropKey, aValuePtr, aValueLen);
+    }
+
+    IgnoreReturnValue(SendQueuedHostRequests());
+}
+
+void NcpBase::StartHostRequestTimer(void)
+{
+    uint32_t now      = eventOS_event_timer_ticks();
+    uint32_t deadline = 0;
+    bool     found    = false;
+
+    VerifyOrExit((mHostRequestTimer == NULL) && ((mHostInFlightCount > 0) || (mHostRequestQueueCount > 0)), OT_NOOP);
+
+    for (uint8_t i = 0; i < kHostMaxTid; i++)
+    {
+        if (mHostRequests[i].mIsInUse && (!found || TICKS_BEFORE(mHostRequests[i].mDeadline, deadline)))
+        {
+            deadline = mHostRequests[i].mDeadline;
+            found    = true;
+        }
+
+        // Queued requests may be waiting for a quarantined TID.
+
+        if ((mHostRequestQueueCount > 0) && (mHostQuarantinedTids & (1U << i)) &&
+            TICKS_AFTER(mHostTidIdleUntil[i], now) && (!found || TICKS_BEFORE(mHostTidIdleUntil[i], deadline)))
+        {
+            deadline = mHostTidIdleUntil[i];
+            found    = true;
+        }
+    }
+
+    VerifyOrExit(found, OT_NOOP);
+
+    // A deadline that has passed belongs to a retry that did not fit in NCP buffer, try again on the next tick.
+
+    deadline = TICKS_AFTER(deadline, now) ? deadline - now : 1;
+
+    mHostRequestTimer =
+        eventOS_timeout_ms(&NcpBase::HandleHostRequestTimer, eventOS_event_timer_ticks_to_ms(deadline), this);
+
+exit:
+    return;
+}
+
+void NcpBase::HandleHostRequestTimer(void *aContext)
+{
+    static_cast<NcpBase *>(aContext)->HandleHostRequestTimer();
+}
+
+void NcpBase::HandleHostRequestTimer(void)
+{
+    uint32_t now = eventOS_event_timer_ticks();
+
+    mHostRequestTimer = NULL;
+
+    for (uint8_t tid = 1; tid <= kHostMaxTid; tid++)
+    {
+        HostRequest &request = mHostRequests[tid - 1];
+
+        if (!request.mIsInUse || TICKS_BEFORE(now, request.mDeadline))
+        {
+            continue;
+        }
+
+        if (request.mRetriesLeft == 0)
+        {
+            CompleteHostRequest(tid, OT_ERROR_RESPONSE_TIMEOUT, request.mPropKey, NULL, 0);
+            continue;
+        }
+
+        // Send again with the same TID, so that a late response to the first one still completes the request.
+
+        if (WriteHostRequestFrame(tid, request) == OT_ERROR_NONE)
+        {
+            request.mRetriesLeft--;
+            request.mIsResent = true;
+            request.mDeadline = now + eventOS_event_timer_ms_to_ticks(CONFIG_NCP_HOST_REQUEST_TIMEOUT_MS);
+        }
+    }
+
+    // Also sends requests that were waiting for a quarantined TID, and restarts the timer.
+    IgnoreReturnValue(SendQueuedHostRequests());
+}
+
 #endif
 
 otError NcpBase::WriteLastStatusFrame(uint8_t aHeader, spinel_status_t aLastStatus)
@@ -58,6 +58,10 @@
 #include "lib/spinel/spinel_encoder.hpp"
 #include "utils/static_assert.hpp"
 
+#ifdef MCU_HOST
+struct timeout_entry_t; // Event loop timeout (`timeout_t`).
+#endif
+
 namespace ot {
 namespace Ncp {
 
@@ -145,10 +149,51 @@ public:
      */
     void HandleReceive(const uint8_t *aBuf, uint16_t aBufLength);
 #ifdef MCU_HOST
-    // Called externally to send out a spinel CMD GET Prop to NWP
-    otError WriteCommandGetProperty(uint32_t prop_key);
-    // Called externally to send out a spinel CMD SET Prop on NWP
-    otError WriteCommandSetProperty(spinel_prop_key_t prop_key, void* newValue);
+    /**
+     * This function pointer is called when a command sent to the NWP with `SendHostRequest()` completes.
+     *
+     * @param[in]  aContext   The context given to `SendHostRequest()`.
+     * @param[in]  aError     OT_ERROR_NONE if the NWP responded, OT_ERROR_RESPONSE_TIMEOUT if it did not respond
+     *                        after all retries. Commands that are not idempotent are not retried, so their effect is
+     *                        unknown after a timeout.
+     * @param[in]  aPropKey   The property in the response. `SPINEL_PROP_LAST_STATUS` if the NWP responded with a
+     *                        status, in which case the value holds the packed `spinel_status_t`.
+     * @param[in]  aValuePtr  The property value in the response, or NULL.
+     * @param[in]  aValueLen  The length of the property value.
+     *
+     */
+    typedef void (*HostRequestCallback)(void *            aContext,
+                                        otError           aError,
+                                        spinel_prop_key_t aPropKey,
+                                        const uint8_t *   aValuePtr,
+                                        uint16_t          aValueLen);
+
+    /**
+     * This method sends a property command to the NWP.
+     *
+     * Up to `CONFIG_NCP_HOST_MAX_IN_FLIGHT` commands are in flight at once, each with its own spinel TID. Further
+     * commands are queued and sent as responses come back. Must be called from the NCP tasklet.
+     *
+     * Gets, and sets of properties that hold a plain value, are sent again when the NWP does not respond. Other
+     * commands, such as `SPINEL_PROP_STREAM_NET`, `SPINEL_PROP_NET_STATE` and `SPINEL_PROP_NET_STACK_UP`, are sent
+     * once and complete with OT_ERROR_RESPONSE_TIMEOUT if the NWP does not respond.
+     *
+     * @param[in]  aCommand   `SPINEL_CMD_PROP_VALUE_GET` or `SPINEL_CMD_PROP_VALUE_SET`.
+     * @param[in]  aPropKey   The property to get or set.
+     * @param[in]  aValue     The value to set. It may be encoded again on a retry, so it MUST stay valid until
+     *                        @p aCallback is called.
+     * @param[in]  aCallback  The callback to call when the command completes, or NULL.
+     * @param[in]  aContext   A context passed to @p aCallback.
+     *
+     * @retval OT_ERROR_NONE     The command was sent or queued.
+     * @retval OT_ERROR_NO_BUFS  The request queue is full.
+     *
+     */
+    otError SendHostRequest(unsigned int        aCommand,
+                            spinel_prop_key_t   aPropKey,
+                            const void *        aValue,
+                            HostRequestCallback aCallback,
+                            void *              aContext);
 #endif
 
     /**
@@ -429,6 +474,37 @@ protected:
 #endif // OPENTHREAD_FTD
 
 
+#ifdef MCU_HOST
+    struct HostRequest
+    {
+        const void *        mValue;       // Value to set, owned by the caller.
+        HostRequestCallback mCallback;
+        void *              mContext;
+        uint32_t            mDeadline;    // Event timer ticks when the response is due.
+        spinel_prop_key_t   mPropKey;
+        uint8_t             mCommand;
+        uint8_t             mRetriesLeft; // Zero for commands that are not idempotent.
+        bool                mIsResent;
+        bool                mIsInUse;
+    };
+
+    otError     SendQueuedHostRequests(void);
+    static bool IsHostRequestIdempotent(uint8_t aCommand, spinel_prop_key_t aPropKey);
+    bool        IsHostTidFree(uint8_t aTid, uint32_t aNow);
+    void        QuarantineHostTid(uint8_t aTid, uint32_t aDeadline);
+    otError     WriteHostRequestFrame(uint8_t aTid, const HostRequest &aRequest);
+    otError     WriteHostRequestValue(spinel_prop_key_t aPropKey, const void *aValue);
+    void        HandleHostResponse(uint8_t aHeader);
+    void        CompleteHostRequest(uint8_t           aTid,
+                                    otError           aError,
+                                    spinel_prop_key_t aPropKey,
+                                    const uint8_t *   aValuePtr,
+                                    uint16_t          aValueLen);
+    void        StartHostRequestTimer(void);
+    static void HandleHostRequestTimer(void *aContext);
+    void        HandleHostRequestTimer(void);
+#endif
+
     void ResetCounters(void);
 
     void StartLegacy(void) {}
@@ -456,6 +532,11 @@ protected:
         kTxBufferSize       = CONFIG_NCP_TX_BUFFER_SIZE, // Tx Buffer size (used by mTxFrameBuffer).
         kResponseQueueSize  = CONFIG_NCP_SPINEL_RESPONSE_QUEUE_SIZE,
         kInvalidScanChannel = -1, // Invalid scan channel.
+#ifdef MCU_HOST
+        kHostMaxTid           = 15, // Spinel TIDs 1-15 need a response, TID 0 does not.
+        kHostMaxInFlight      = CONFIG_NCP_HOST_MAX_IN_FLIGHT,
+        kHostRequestQueueSize = CONFIG_NCP_HOST_REQUEST_QUEUE_SIZE,
+#endif
     };
 
     spinel_status_t mLastStatus;
@@ -486,6 +567,18 @@ protected:
     uint8_t       mResponseQueueTail;
     ResponseEntry mResponseQueue[kResponseQueueSize];
 
+#ifdef MCU_HOST
+    HostRequest             mHostRequests[kHostMaxTid];              // Requests in flight, indexed by TID - 1.
+    HostRequest             mHostRequestQueue[kHostRequestQueueSize]; // Requests waiting for a free TID.
+    uint8_t                 mHostRequestQueueHead;
+    uint8_t                 mHostRequestQueueCount;
+    uint8_t                 mHostInFlightCount;
+    spinel_tid_t            mHostLastTid;
+    uint16_t                mHostQuarantinedTids; // Bit `TID - 1` set while the TID may get late responses.
+    uint32_t                mHostTidIdleUntil[kHostMaxTid]; // Event timer ticks when a quarantined TID is free.
+    struct timeout_entry_t *mHostRequestTimer; // Running response timeout, or NULL.
+#endif
+
     bool mAllowLocalNetworkDataChange;
     bool mRequireJoinExistingNetwork;
     bool mIsRawStreamEnabled;
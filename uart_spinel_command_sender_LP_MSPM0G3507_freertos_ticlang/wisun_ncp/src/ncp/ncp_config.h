@@ -116,4 +116,52 @@
 #define CONFIG_NCP_SPINEL_RESPONSE_QUEUE_SIZE 15
 #endif
 
+/**
+ * @def CONFIG_NCP_HOST_MAX_IN_FLIGHT
+ *
+ * Maximum number of spinel commands an `MCU_HOST` build has sent to the NWP and not yet seen a response to.
+ *
+ * Each command in flight takes one spinel TID, so this can be at most 15. It should not be more than the
+ * `CONFIG_NCP_SPINEL_RESPONSE_QUEUE_SIZE` of the NWP, or the NWP drops responses.
+ *
+ */
+#ifndef CONFIG_NCP_HOST_MAX_IN_FLIGHT
+#define CONFIG_NCP_HOST_MAX_IN_FLIGHT 15
+#endif
+
+/**
+ * @def CONFIG_NCP_HOST_REQUEST_QUEUE_SIZE
+ *
+ * Number of spinel commands an `MCU_HOST` build can hold while all `CONFIG_NCP_HOST_MAX_IN_FLIGHT` TIDs are in use.
+ *
+ */
+#ifndef CONFIG_NCP_HOST_REQUEST_QUEUE_SIZE
+#define CONFIG_NCP_HOST_REQUEST_QUEUE_SIZE 16
+#endif
+
+/**
+ * @def CONFIG_NCP_HOST_REQUEST_TIMEOUT_MS
+ *
+ * Time in milliseconds an `MCU_HOST` build waits for the NWP to respond to a spinel command before sending it again.
+ *
+ * The TID of a command that timed out or was sent more than once is not used again until this long after its last
+ * copy timed out, and until no response has arrived on it for this long. A late response to it is dropped instead
+ * of completing a newer command. A response that comes later still is not caught.
+ *
+ */
+#ifndef CONFIG_NCP_HOST_REQUEST_TIMEOUT_MS
+#define CONFIG_NCP_HOST_REQUEST_TIMEOUT_MS 500
+#endif
+
+/**
+ * @def CONFIG_NCP_HOST_REQUEST_RETRIES
+ *
+ * Number of times an `MCU_HOST` build sends a spinel command again when the NWP does not respond to it. Only gets
+ * and idempotent sets are sent again, other commands complete with OT_ERROR_RESPONSE_TIMEOUT after the first timeout.
+ *
+ */
+#ifndef CONFIG_NCP_HOST_REQUEST_RETRIES
+#define CONFIG_NCP_HOST_REQUEST_RETRIES 2
+#endif
+
 #endif // CONFIG_NCP_H_